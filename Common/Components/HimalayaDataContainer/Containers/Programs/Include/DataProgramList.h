@@ -28,6 +28,7 @@
 #include "DataManager/Containers/ContainerBase/Include/DataContainerBase.h"
 #include "DataManager/Containers/ContainerBase/Include/VerifierInterface.h"
 #include "HimalayaDataContainer/Helper/Include/HimalayaDataManagerEventCodes.h"
+#include "HimalayaDataContainer/Helper/Include/SnapshotHash.h"
 
 //lint -sem(DataManager::CDataProgramList::AddProgram, custodial(1))
 //lint -sem(DataManager::CDataProgramList::UpdateProgram, custodial(2))
@@ -35,8 +36,8 @@
 
 namespace DataManager {
 
-//!< Hash table for list of programs
-typedef QHash<QString, CProgram*> ListOfPrograms_t;
+//!< Hash table for list of programs, programs are shared between copies of the list
+typedef CSnapshotHash<CProgram> ListOfPrograms_t;
 
 /****************************************************************************/
 /*!
@@ -144,7 +145,7 @@ public:
      *  \return Number of programs
      */
     /****************************************************************************/
-    int  GetNumberOfPrograms() const {return m_ProgramList.count();}
+    int  GetNumberOfPrograms() const {return m_ProgramList.Count();}
 
     // the CreateProgram functions won't add the created program to the internal program list! This is the job of AddProgramm.
     /****************************************************************************/
@@ -171,7 +172,7 @@ public:
      *  \return Pointer to Program
      */
     /****************************************************************************/
-    CProgram const * GetProgram(const QString ProgramID) {return m_ProgramList.value(ProgramID, NULL);}  // uses unique program ID
+    CProgram const * GetProgram(const QString ProgramID) {return m_ProgramList.Value(ProgramID);}  // uses unique program ID
     /****************************************************************************/
     /*!
      *  \brief Retrieve a program with the given index
@@ -182,9 +183,9 @@ public:
     /*!
      *  \brief  GetProgram
      *  \iparam Index Index
-     *  \return return CProgram
+     *  \return return CProgram, shared with copies of the list => don't modify!
      */
-    CProgram* GetProgram(const unsigned int Index) const; // uses order index
+    CProgram const * GetProgram(const unsigned int Index) const; // uses order index
 
     /*!
      *  \brief  GetProgram
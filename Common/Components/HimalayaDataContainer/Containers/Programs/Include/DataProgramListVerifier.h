@@ -109,7 +109,7 @@ private:
     * \iparam p_Program program
     * \iparam VerifiedData VerifiedData
     */
-    void CheckProgramStep(CProgram* p_Program,bool &VerifiedData);
+    void CheckProgramStep(CProgram const* p_Program,bool &VerifiedData);
 
     /**
     * \brief CheckDurationFormat
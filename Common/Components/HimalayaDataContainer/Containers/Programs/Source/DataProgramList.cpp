@@ -216,12 +216,10 @@ bool CDataProgramList::Read(QString Filename)
  *  \return Program associated with the index
  */
 /****************************************************************************/
-CProgram* CDataProgramList::GetProgram(const unsigned int Index) const
+CProgram const * CDataProgramList::GetProgram(const unsigned int Index) const
 {
     if (Index < (unsigned int)m_OrderedListOfProgramIDs.count()) {
-        QString Key = m_OrderedListOfProgramIDs.value(Index);
-        CProgram* p_Prog = m_ProgramList.value(Key, NULL);
-        return p_Prog;
+        return m_ProgramList.Value(m_OrderedListOfProgramIDs.at(Index));
     }
     return NULL;
 }
@@ -244,8 +242,8 @@ bool CDataProgramList::GetProgram(const unsigned int Index, CProgram& Program)
     bool Result = true;
     if (Index < (unsigned int)m_OrderedListOfProgramIDs.count()) {
         QString ProgramID = m_OrderedListOfProgramIDs.value(Index);
-        if (m_ProgramList.contains(ProgramID)) {
-            DataManager::CProgram *p_ProgTemp = m_ProgramList.value(ProgramID, NULL);
+        if (m_ProgramList.Contains(ProgramID)) {
+            const DataManager::CProgram *p_ProgTemp = m_ProgramList.Value(ProgramID);
             if (p_ProgTemp != NULL) {
                 Program = *p_ProgTemp;
             } else {
@@ -275,8 +273,8 @@ bool CDataProgramList::GetProgram(const QString ProgramID, CProgram& Program)
 {
     QReadLocker locker(mp_ReadWriteLock);
 
-    if (m_ProgramList.contains(ProgramID)) {
-        Program = *(m_ProgramList.value(ProgramID));
+    if (m_ProgramList.Contains(ProgramID)) {
+        Program = *(m_ProgramList.Value(ProgramID));
         return true;
     } else {
         return false;
@@ -293,8 +291,8 @@ QStringList CDataProgramList::GetFavoriteProgramIDs()
 {
     QStringList ids;
     int count  = 0;
-    for (qint32 I = 0; I < m_ProgramList.count() && count < 5; I++) {
-        CProgram *p_Program = GetProgram(I);
+    for (qint32 I = 0; I < m_ProgramList.Count() && count < 5; I++) {
+        CProgram const *p_Program = GetProgram(I);
         if (p_Program && p_Program->IsFavorite()) {
             ids.append(p_Program->GetID());
             count++;
@@ -313,7 +311,7 @@ QStringList CDataProgramList::GetFavoriteProgramIDs()
 /****************************************************************************/
 
 bool CDataProgramList::ProgramExists(const QString ProgramID) {
-    return m_ProgramList.contains(ProgramID);
+    return m_ProgramList.Contains(ProgramID);
 }
 
 /****************************************************************************/
@@ -334,11 +332,6 @@ bool CDataProgramList::AddProgram(const CProgram* p_Program)
         return false;
     }
 
-    CProgram *p_TempProgram = new CProgram();
-    *p_TempProgram = *p_Program;
-
-
-
     bool Result = true;
     bool LocalVerify = true;
     bool GroupVerify = true;
@@ -349,14 +342,14 @@ bool CDataProgramList::AddProgram(const CProgram* p_Program)
         {   // code block defined for QReadLocker.
             QReadLocker locker(mp_ReadWriteLock);
 
-            // create clone from current state
+            // create clone from current state, the programs are shared with the clone
             *p_DPL_Verification = *this;
 
             // disable verification in clone
             p_DPL_Verification->SetDataVerificationMode(false);
 
             // execute required action (AddProgram) in clone
-            Result = p_DPL_Verification->AddProgram(p_TempProgram);
+            Result = p_DPL_Verification->AddProgram(p_Program);
 
             if (Result) {
                 // now check new content => call all active verifiers
@@ -371,19 +364,18 @@ bool CDataProgramList::AddProgram(const CProgram* p_Program)
         else {
             Result = false;
         }
-        delete p_TempProgram;
         // delete test clone
         delete p_DPL_Verification;
 
     } else {
         QWriteLocker locker(mp_ReadWriteLock);
         QString ID = p_Program->GetID();
-        m_ProgramList.insert(ID, p_TempProgram);
+        m_ProgramList.Insert(ID, *p_Program);
         m_OrderedListOfProgramIDs.append(ID);
         // White space at begining , end are removed from names. If continuous
         // White space exits between a name, they are replaced by a single white
         //space
-        m_ProgramListNames.append(p_TempProgram->GetName().simplified());
+        m_ProgramListNames.append(p_Program->GetName().simplified());
         Result = true;
     }
 
@@ -428,7 +420,7 @@ bool CDataProgramList::UpdateProgram(const CProgram* p_Program)
 
         {   // code block defined for QReadLocker.
             QReadLocker locker(mp_ReadWriteLock);
-            // create clone from current state
+            // create clone from current state, only the updated program is copied
             *p_DPL_Verification = *this;
             // disable verification in clone
             p_DPL_Verification->SetDataVerificationMode(false);
@@ -471,8 +463,8 @@ bool CDataProgramList::UpdateProgram(const CProgram* p_Program)
                 Result = false;
             }
         }
-        // do a deep copy
-        *m_ProgramList.value(ID) = *p_Program;
+        // do a deep copy, copies of the list still see the previous program
+        (void)m_ProgramList.Replace(ID, *p_Program);
          Result = true;
     }
     if (!UpdateReagentIDList()) {
@@ -490,15 +482,12 @@ bool CDataProgramList::UpdateProgram(const CProgram* p_Program)
 /****************************************************************************/
 bool CDataProgramList::DeleteProgram(const QString ProgramID)
 {
-    if (m_ProgramList.contains(ProgramID)) {
-        CProgram *p_Program = m_ProgramList.value(ProgramID);
+    if (m_ProgramList.Contains(ProgramID)) {
         /* We store Program Name so that we can use it later on for Error reporting */
-        QString ProgramName = p_Program->GetName();
-        //get Program from ProgramList and free memory
-        delete p_Program;
+        QString ProgramName = m_ProgramList.Value(ProgramID)->GetName();
 
-        //remove pointer to Program from ProgramList
-        m_ProgramList.remove(ProgramID);
+        //remove Program from ProgramList, it is freed when no copy of the list uses it
+        (void)m_ProgramList.Remove(ProgramID);
 
         //remove ProgramID from ID list
         int MatchIndex = -1;
@@ -570,13 +559,7 @@ bool CDataProgramList::DeleteAllPrograms()
 {
     bool Result = true;
 
-    while (m_ProgramList.size() > 0) {
-        if (DeleteProgram(0) == false) {
-            Result = false;
-        }
-    }
-
-    m_ProgramList.clear();
+    m_ProgramList.Clear();
     m_OrderedListOfProgramIDs.clear();
     m_ProgramListNames.clear();
     m_ReagentIDList.clear();
@@ -733,7 +716,7 @@ bool CDataProgramList::SerializeContent(QIODevice& IODevice, bool CompleteData)
 
     // write all programs
     for (int i = 0; i < GetNumberOfPrograms(); i++) {
-        CProgram *p_Prog = GetProgram(i);
+        CProgram *p_Prog = const_cast<CProgram*>(GetProgram(i));
         if (p_Prog != NULL) {
             if (!p_Prog->SerializeContent(XmlStreamWriter, CompleteData)) {
                 qDebug("DataManager::CProgram SerializeContent failed ");
@@ -800,26 +783,16 @@ QDataStream& operator >> (QDataStream& InDataStream, CDataProgramList& ProgramLi
 /****************************************************************************/
 CDataProgramList& CDataProgramList::operator = (const CDataProgramList& SourceProgramList) {
 
-    //Read should be blocked since internally Serialization takes place
-    //QReadLocker Locker(mp_ReadWriteLock);
     // make sure not same object
     if (this != &SourceProgramList)
     {
-        QByteArray TempByteArray;
-        QDataStream DataStream(&TempByteArray, QIODevice::ReadWrite);
-        DataStream.setVersion(static_cast<int>(QDataStream::Qt_4_0));
-        TempByteArray.clear();
-        //Serialize
-        DataStream << SourceProgramList;
-        (void)DataStream.device()->reset();
-        //Deserialize
-        bool VerificationModeLocal = GetDataVerificationMode();
-        if (VerificationModeLocal) {
-            SetDataVerificationMode(false);
-        }
-        DataStream >> *this;
-        //Set back verification mode to original state
-        SetDataVerificationMode(VerificationModeLocal);
+        // the programs are shared, a program is copied when one of the lists changes it
+        m_Version = SourceProgramList.m_Version;
+        m_NextProgramID = SourceProgramList.m_NextProgramID;
+        m_ProgramList = SourceProgramList.m_ProgramList;
+        m_OrderedListOfProgramIDs = SourceProgramList.m_OrderedListOfProgramIDs;
+        m_ProgramListNames = SourceProgramList.m_ProgramListNames;
+        m_ReagentIDList = SourceProgramList.m_ReagentIDList;
     }
     return *this;
 }
@@ -837,18 +810,11 @@ CDataProgramList& CDataProgramList::operator = (const CDataProgramList& SourcePr
 bool CDataProgramList::CheckForUniquePropeties(const CProgram* p_Program, bool excludeSeft)
 {
     bool Result = true;
-    QString ID = const_cast<CProgram*>(p_Program)->GetID();
-    //CProgram* oldProgram = m_ProgramList.value(ID);
+    QString ID = p_Program->GetID();
     bool isHave = false;
-    if (excludeSeft)
-    {
-        ListOfPrograms_t tempProgramList = m_ProgramList;
-        tempProgramList.remove(ID);
-        isHave = tempProgramList.contains(ID);
-    }
-    else
+    if (!excludeSeft)
     {
-        isHave = m_ProgramList.contains(ID);
+        isHave = m_ProgramList.Contains(ID);
     }
 
     if (isHave) {
@@ -892,8 +858,9 @@ bool CDataProgramList::CheckForUniquePropeties(const CProgram* p_Program, bool e
                     NewProName = Global::UITranslator::TranslatorInstance().TranslateToLanguage(lan, strid);
                 }
             }
-            foreach(CProgram* pPro, m_ProgramList)
+            for (qint32 I = 0; I < m_ProgramList.Count(); I++)
             {
+                CProgram const *pPro = GetProgram(I);
                 QString ProName = pPro->GetName().simplified();
                 if(!pPro->GetNameID().isEmpty())
                 {
@@ -937,7 +904,7 @@ bool CDataProgramList::UpdateReagentIDList()
 {
 
     m_ReagentIDList.clear();
-    for (qint32 I = 0; I < m_ProgramList.count(); I++) {
+    for (qint32 I = 0; I < m_ProgramList.Count(); I++) {
         CProgram const *p_Program = GetProgram(I);
         if (p_Program) {
             m_ReagentIDList.append(p_Program->GetReagentIDList());
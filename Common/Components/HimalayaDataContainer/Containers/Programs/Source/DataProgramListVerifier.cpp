@@ -84,7 +84,7 @@ bool CDataProgramListVerifier::VerifyData(CDataContainerBase* p_DataProgramList)
 //    QString NextStepID = mp_DPL->GetNextFreeProgID(false).mid(1);
 
     // check content of each program
-    CProgram *p_Program;
+    CProgram const *p_Program;
     // empty the string
     m_LeicaReagentIDList.clear();
     for (qint32 I = 0; I < mp_DPL->GetNumberOfPrograms(); I++) {
@@ -184,7 +184,7 @@ bool CDataProgramListVerifier::VerifyData(CDataContainerBase* p_DataProgramList)
  *
  */
 /****************************************************************************/
-void CDataProgramListVerifier::CheckProgramStep(CProgram* p_Program, bool &VerifiedData)
+void CDataProgramListVerifier::CheckProgramStep(CProgram const* p_Program, bool &VerifiedData)
 {
     CProgramStep p_ProgramStep;
     QStringList ReagentIDList;
@@ -82,6 +82,13 @@ private slots:
     /****************************************************************************/
     void utTestDataProgramList();
 
+    /****************************************************************************/
+    /**
+     * \brief Test that copies of CDataProgramList share unchanged programs.
+     */
+    /****************************************************************************/
+    void utTestProgramListSnapshot();
+
     /****************************************************************************/
     /**
      * \brief Test data of CDataProgramListVerifier.
@@ -327,6 +334,47 @@ void TestDataProgramList::utTestDataProgramList() {
     delete p_ProgramList;
 }
 
+/****************************************************************************/
+void TestDataProgramList::utTestProgramListSnapshot() {
+    CDataProgramList ProgramList;
+    ProgramList.SetDataVerificationMode(false);
+    QVERIFY(ProgramList.Read(":/Xml/Programs.xml"));
+    ProgramList.SetDataVerificationMode(true);
+
+    // a copy shares all programs
+    CDataProgramList Snapshot(ProgramList);
+    QCOMPARE(Snapshot.GetNumberOfPrograms(), ProgramList.GetNumberOfPrograms());
+    for (qint32 I = 0; I < ProgramList.GetNumberOfPrograms(); I++) {
+        QVERIFY(Snapshot.GetProgram(I) == ProgramList.GetProgram(I));
+    }
+    QCOMPARE(Snapshot.GetReagentIDList(), ProgramList.GetReagentIDList());
+
+    // an update clones the updated program only
+    CProgram Program;
+    QVERIFY(ProgramList.GetProgram(QString("U2"), Program));
+    QString LongName = Program.GetLongName();
+    Program.SetLongName("Snapshot test");
+    QVERIFY(ProgramList.UpdateProgram(&Program));
+
+    QCOMPARE(ProgramList.GetProgram(QString("U2"))->GetLongName(), QString("Snapshot test"));
+    QCOMPARE(Snapshot.GetProgram(QString("U2"))->GetLongName(), LongName);
+    QVERIFY(Snapshot.GetProgram(QString("U2")) != ProgramList.GetProgram(QString("U2")));
+    QVERIFY(Snapshot.GetProgram(QString("U3")) == ProgramList.GetProgram(QString("U3")));
+
+    // a deleted program stays valid in the snapshot
+    const CProgram *p_Deleted = Snapshot.GetProgram(QString("U3"));
+    QVERIFY(ProgramList.DeleteProgram(QString("U3")));
+    QVERIFY(!ProgramList.ProgramExists("U3"));
+    QCOMPARE(Snapshot.GetProgram(QString("U3")), p_Deleted);
+    QCOMPARE(p_Deleted->GetID(), QString("U3"));
+    QCOMPARE(Snapshot.GetNumberOfPrograms(), ProgramList.GetNumberOfPrograms() + 1);
+
+    // assigning back restores the snapshot without copying programs
+    ProgramList = Snapshot;
+    QVERIFY(ProgramList.GetProgram(QString("U3")) == p_Deleted);
+    QCOMPARE(ProgramList.GetProgram(QString("U2"))->GetLongName(), LongName);
+}
+
 void TestDataProgramList::utTestDataProgramListVerifier() {
     CDataProgramList *p_ProgramList = new CDataProgramList();
     CDataProgramListVerifier *p_ProgramListVerifier = new CDataProgramListVerifier();
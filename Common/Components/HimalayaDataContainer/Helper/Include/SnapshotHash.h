@@ -0,0 +1,182 @@
+/****************************************************************************/
+/*! \file HimalayaDataContainer/Helper/Include/SnapshotHash.h
+ *
+ *  \brief Definition file for class CSnapshotHash.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DATAMANAGER_SNAPSHOTHASH_H
+#define DATAMANAGER_SNAPSHOTHASH_H
+
+#include <QHash>
+#include <QString>
+#include <QSharedData>
+#include <QExplicitlySharedDataPointer>
+
+namespace DataManager {
+
+/****************************************************************************/
+/*!
+ *  \brief  Hash of reference counted items, keyed by item ID
+ *
+ *      Copying the hash shares all items with the copy, so a container can be
+ *      cloned for verification without copying its items. An item is cloned
+ *      with its copy constructor only when it is changed while shared, all
+ *      other items stay shared between the copies. The items therefore have
+ *      to be treated as immutable when read through Value().
+ *
+ *      T needs a copy constructor and an assignment operator.
+ */
+/****************************************************************************/
+template <typename T>
+class CSnapshotHash
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief Returns the number of items
+     *  \return Number of items
+     */
+    /****************************************************************************/
+    int Count() const { return m_Items.count(); }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Checks if an item exists
+     *  \iparam ID = Item ID
+     *  \return true - item exists
+     */
+    /****************************************************************************/
+    bool Contains(const QString &ID) const { return m_Items.contains(ID); }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Retrieves an item for reading, the item may be shared
+     *  \iparam ID = Item ID
+     *  \return Pointer to the item or NULL
+     */
+    /****************************************************************************/
+    const T *Value(const QString &ID) const
+    {
+        typename ItemHash_t::const_iterator Iterator = m_Items.constFind(ID);
+        return (Iterator == m_Items.constEnd()) ? NULL : &(*Iterator)->Item;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Retrieves an item for writing, the item is cloned if shared
+     *  \iparam ID = Item ID
+     *  \return Pointer to the item owned by this hash only or NULL
+     */
+    /****************************************************************************/
+    T *Detach(const QString &ID)
+    {
+        typename ItemHash_t::iterator Iterator = m_Items.find(ID);
+        if (Iterator == m_Items.end()) {
+            return NULL;
+        }
+        Iterator->detach();
+        return &(*Iterator)->Item;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Adds a copy of an item or replaces the item with the same ID
+     *  \iparam ID = Item ID
+     *  \iparam Item = Item to copy
+     */
+    /****************************************************************************/
+    void Insert(const QString &ID, const T &Item)
+    {
+        (void)m_Items.insert(ID, QExplicitlySharedDataPointer<Node>(new Node(Item)));
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Overwrites an item, only this hash sees the new content
+     *  \iparam ID = Item ID
+     *  \iparam Item = New content
+     *  \return false if the item does not exist
+     */
+    /****************************************************************************/
+    bool Replace(const QString &ID, const T &Item)
+    {
+        typename ItemHash_t::iterator Iterator = m_Items.find(ID);
+        if (Iterator == m_Items.end()) {
+            return false;
+        }
+        if ((*Iterator)->ref.load() > 1) {
+            // shared with a snapshot, no need to copy the old content first
+            *Iterator = QExplicitlySharedDataPointer<Node>(new Node(Item));
+        }
+        else {
+            (*Iterator)->Item = Item;
+        }
+        return true;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Removes an item, the item is deleted when no snapshot uses it
+     *  \iparam ID = Item ID
+     *  \return false if the item does not exist
+     */
+    /****************************************************************************/
+    bool Remove(const QString &ID) { return m_Items.remove(ID) > 0; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief Removes all items
+     */
+    /****************************************************************************/
+    void Clear() { m_Items.clear(); }
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief  Reference counted holder of one item
+     */
+    /****************************************************************************/
+    struct Node : public QSharedData
+    {
+        /****************************************************************************/
+        /*!
+         *  \brief Constructor
+         *  \iparam Source = Item to copy
+         */
+        /****************************************************************************/
+        explicit Node(const T &Source) : QSharedData(), Item(Source) {}
+
+        /****************************************************************************/
+        /*!
+         *  \brief Copy constructor, used by detach()
+         *  \iparam Other = Node to copy
+         */
+        /****************************************************************************/
+        Node(const Node &Other) : QSharedData(Other), Item(Other.Item) {}
+
+        T Item; //!< The item
+    private:
+        Node &operator=(const Node &);  //!< Not implemented
+    };
+
+    typedef QHash<QString, QExplicitlySharedDataPointer<Node> > ItemHash_t; //!< Hash of shared items
+
+    ItemHash_t m_Items; //!< Items by ID
+};
+
+} // namespace DataManager
+
+#endif // DATAMANAGER_SNAPSHOTHASH_H
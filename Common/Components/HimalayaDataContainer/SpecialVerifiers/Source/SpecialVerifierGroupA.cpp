@@ -169,7 +169,7 @@ bool CSpecialVerifierGroupA::CheckData()
                 break;
             }
         }
-        CProgram* p_Program = NULL;
+        CProgram const* p_Program = NULL;
         CProgramStep Previous_ProgramStep;
         QString Previous_ReagentGroupID;
         QString Previous_ReagentID;
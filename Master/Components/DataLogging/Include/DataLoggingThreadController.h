@@ -62,6 +62,7 @@ private:
     DayEventLogger              *mp_DayEventLogger;               ///< Day operation logger.
     EventFilterNetworkServer    *m_pEventFilterNetworkServer;       ///< Socket server for EventFilter.
     bool                        m_ImmediateLog;                     ///< Flag for immediate logging
+    bool                        m_TextView;                         ///< Flag for writing the text log file along with the records
     /****************************************************************************/
     /****************************************************************************/
     /**
@@ -198,6 +199,20 @@ public:
         m_ImmediateLog = Enable;
     }
 
+    /****************************************************************************/
+    /**
+     * \brief Enables writing the text log file along with the binary records.
+     *        If disabled, events are only stored as binary records and the
+     *        text log files are rendered when run logs are requested or
+     *        exported. By default this option is enabled.
+     *
+     * \iparam   Enable   Enables the flag.
+     */
+    /****************************************************************************/
+    inline void EnableTextView(bool Enable = true) {
+        m_TextView = Enable;
+    }
+
     /****************************************************************************/
     /**
      * \brief Set base of file name for even logging.
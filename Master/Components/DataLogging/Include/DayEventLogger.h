@@ -24,6 +24,7 @@
 #include <DataLogging/Include/DayEventEntry.h>
 #include <DataLogging/Include/BaseLoggerReusable.h>
 #include <DataLogging/Include/DayEventLoggerConfig.h>
+#include <QTimer>
 
 namespace DataLogging {
 
@@ -31,13 +32,15 @@ namespace DataLogging {
 /**
  * \brief Class used to log day operation data to file.
  *
- * Day operation data is translated into the right language (depending on the
- * operating mode) and written to file.\n
+ * Day operation data is stored as binary records (see DayEventRecord) which
+ * are committed to disk in groups. The translated text log file is either
+ * written along with the records or rendered from them when it is requested.\n
  * <b>This class should be used only with the signal / slot mechanism.</b>
  * \warning This class is not thread safe!
  */
 /****************************************************************************/
 class DayEventLogger : public BaseLoggerReusable {
+    Q_OBJECT
 
 private:
     QDate   m_LastLogDate;      ///< Date when last logging was done.
@@ -45,6 +48,13 @@ private:
     int     m_MaxFileCount;     ///< Maximal file count. 0 means no maximal file count monitoring!
     QString m_FileNamePrefix;   ///< Prefix of the file name
     bool m_FlushImmediately;           ///< Flush the data to disk as soon as it receives the data
+    bool    m_TextView;         ///< Write the text log file along with the binary records
+    QFile   m_RecordFile;       ///< Binary record file of the current day
+    QByteArray m_RecordBuffer;  ///< Records not yet written to m_RecordFile
+    QList<int> m_TailOffsets;   ///< Offsets of the records in m_RecordBuffer staged as power fail log tail
+    QByteArray m_TailRecord;    ///< Power fail log tail: record file name, '\0' and the records not yet on disk
+    int     m_TailPrefixSize;   ///< Size of the record file name and '\0' in m_TailRecord
+    QTimer  m_CommitTimer;      ///< Group commit of the buffered records
     /****************************************************************************/
     /****************************************************************************/
     /**
@@ -79,6 +89,89 @@ private:
     /****************************************************************************/
     QString ComputeFileNameRegExp() const;
 
+    /****************************************************************************/
+    /**
+     * \brief Compute the record file name belonging to a text log file name.
+     *
+     * \iparam      FileName    Text log file name.
+     *
+     * \return      Record file name.
+     */
+    /****************************************************************************/
+    static QString ComputeRecordFileName(const QString &FileName);
+
+    /****************************************************************************/
+    /**
+     * \brief Open the record file of the current day.
+     *
+     * An existing file is checked and truncated behind the last complete
+     * record, so a record torn by a power fail does not hide later ones.
+     *
+     * \iparam      FileName    Record file name without path.
+     *
+     * \return      true if the file is open for appending.
+     */
+    /****************************************************************************/
+    bool SwitchToRecordFile(const QString &FileName);
+
+    /****************************************************************************/
+    /**
+     * \brief Compute the size of the complete records in a record file.
+     *
+     * \iparam      Content     Content of the record file.
+     *
+     * \return      Offset behind the last complete record, -1 if the file
+     *              header is invalid or belongs to another format or device.
+     */
+    /****************************************************************************/
+    int ComputeCompleteSize(const QByteArray &Content) const;
+
+    /****************************************************************************/
+    /**
+     * \brief Compose the text log line of an entry.
+     *
+     * \iparam      Entry       Event entry.
+     * \oparam      Message     Translated event message.
+     *
+     * \return      Text log line.
+     */
+    /****************************************************************************/
+    QString ComposeLine(const DataLogging::DayEventEntry &Entry, QString &Message) const;
+
+    /****************************************************************************/
+    /**
+     * \brief Stage the records not yet on disk in the power fail journal.
+     *
+     * Only the latest records fitting into a journal record are staged. They
+     * are written to disk by the power fail handler, if the power fails before
+     * the next commit.
+     *
+     * \iparam      Offset      Offset of the new record in m_RecordBuffer.
+     */
+    /****************************************************************************/
+    void StageLogTail(int Offset);
+
+    /****************************************************************************/
+    /**
+     * \brief Append the log tail of a power fail to its record file.
+     *
+     * The records staged before the power failed are appended to the record
+     * file they belong to, unless they were committed to it just before. The
+     * log tail is cleared afterwards, so it is recovered only once.
+     */
+    /****************************************************************************/
+    void RecoverLogTail();
+
+    /****************************************************************************/
+    /**
+     * \brief Render a text log file from a record file.
+     *
+     * \iparam      RecordFileName  Complete record file name.
+     * \iparam      TextFileName    Complete text log file name.
+     */
+    /****************************************************************************/
+    void RenderTextView(const QString &RecordFileName, const QString &TextFileName) const;
+
     /****************************************************************************/
     /**
      * \brief Switch to new file.
@@ -119,6 +212,10 @@ public:
      */
     /****************************************************************************/
     virtual ~DayEventLogger() {
+        try {
+            CloseFiles();
+        } catch(...) {
+        }
     }
 
     /****************************************************************************/
@@ -141,19 +238,48 @@ public:
     /****************************************************************************/
     void FlushDataToFile(bool Enable);
 
+    /****************************************************************************/
+    /**
+     * \brief Enable or disable writing the text log file along with the records.
+     *
+     * If disabled, the text log file is rendered by UpdateTextViews. Has to be
+     * called before Configure.
+     *
+     * \iparam   Enable      Write the text log file.
+     */
+    /****************************************************************************/
+    void SetTextViewEnabled(bool Enable);
+
+    /****************************************************************************/
+    /**
+     * \brief Render all text log files which are missing or outdated.
+     *
+     * Buffered records are committed first.
+     */
+    /****************************************************************************/
+    void UpdateTextViews();
+
+    /****************************************************************************/
+    /**
+     * \brief Commit and close the record file and the text log file.
+     */
+    /****************************************************************************/
+    void CloseFiles();
 
     /****************************************************************************/
     /**
      * \brief Log an event entry.
      *
-     * The string to log is created depending on Entry data and appended to the
-     * log file. If date changed it will be switched to a new log file.
+     * The entry is appended to the record buffer. Errors are committed to disk
+     * within DAYEVENTLOGGER_COMMIT_DELAY, fatal errors and immediate logging
+     * at once. If date changed it will be switched to a new log file.
      *
      * \iparam   Entry   Event entry to log.
      * \iparam   TrEventMessage   return event message.
+     * \iparam   ComposeMessage   false if the caller does not need TrEventMessage.
      */
     /****************************************************************************/
-    void Log(const DataLogging::DayEventEntry &Entry, QString &TrEventMessage);
+    void Log(const DataLogging::DayEventEntry &Entry, QString &TrEventMessage, bool ComposeMessage = true);
 
     /****************************************************************************/
     /**
@@ -183,6 +309,14 @@ public:
     /****************************************************************************/
     static void RemoveOutdatedFiles(QString Prefix, quint8 DaysBack);
 
+public slots:
+    /****************************************************************************/
+    /**
+     * \brief Write the buffered records and flush them to disk.
+     */
+    /****************************************************************************/
+    void CommitRecords();
+
 }; // end class DayEventLogger
 
 } // end namespace DataLogging
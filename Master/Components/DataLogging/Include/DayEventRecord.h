@@ -0,0 +1,119 @@
+/****************************************************************************/
+/*! \file DataLogging/Include/DayEventRecord.h
+ *
+ *  \brief Definition file for class DayEventRecord.
+ *
+ *  $Version:   $ 1.0
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DATALOGGING_DAYEVENTRECORD_H
+#define DATALOGGING_DAYEVENTRECORD_H
+
+#include <DataLogging/Include/DayEventEntry.h>
+#include <QByteArray>
+
+namespace DataLogging {
+
+/****************************************************************************/
+/**
+ * \brief Header information of a binary day event file.
+ */
+/****************************************************************************/
+struct DayEventRecordHeader {
+    quint16 FormatVersion;      ///< Format version of the text file rendered from the records.
+    QString FileName;           ///< Complete base file name of the text file.
+    QString TimeStamp;          ///< Creation time stamp.
+    QString OperatingMode;      ///< Operating mode.
+    QString SerialNumber;       ///< Serial number.
+    QString SWVersion;          ///< SW version.
+};
+
+/****************************************************************************/
+/**
+ * \brief Binary encoding of day event entries.
+ *
+ * A record holds only the untranslated event data: codes, time stamp, string
+ * ID and arguments. Translation and formatting are done when the text view of
+ * the file is rendered. Each record starts with its length and a CRC-16 of
+ * the payload, so a record torn by a power fail is detected and skipped.
+ * All numbers are stored little endian.
+ */
+/****************************************************************************/
+class DayEventRecord {
+public:
+    static const quint32 FILE_MAGIC;            ///< First four bytes of a record file.
+    static const int RECORD_PREFIX_SIZE = 4;    ///< Size of length and checksum.
+    static const int MAX_RECORD_SIZE = 0xFFFF;  ///< Maximal payload size of a record.
+
+    /****************************************************************************/
+    /**
+     * \brief Append the encoded file header to a buffer.
+     *
+     * \iparam   Header  Header information.
+     * \oparam   Buffer  Buffer to append to.
+     */
+    /****************************************************************************/
+    static void EncodeHeader(const DayEventRecordHeader &Header, QByteArray &Buffer);
+
+    /****************************************************************************/
+    /**
+     * \brief Decode the file header.
+     *
+     * \iparam   Data    File content.
+     * \oparam   Offset  Offset of the first record on success.
+     * \oparam   Header  Decoded header information.
+     *
+     * \return  true if the header is valid.
+     */
+    /****************************************************************************/
+    static bool DecodeHeader(const QByteArray &Data, int &Offset, DayEventRecordHeader &Header);
+
+    /****************************************************************************/
+    /**
+     * \brief Append an encoded entry to a buffer.
+     *
+     * \iparam   Entry   Entry to encode.
+     * \oparam   Buffer  Buffer to append to.
+     *
+     * \return  false if the entry exceeds the maximal record size.
+     */
+    /****************************************************************************/
+    static bool Encode(const DayEventEntry &Entry, QByteArray &Buffer);
+
+    /****************************************************************************/
+    /**
+     * \brief Decode the record at Offset.
+     *
+     * \iparam   Data    File content.
+     * \ioparam  Offset  Offset of the record, moved behind it on success.
+     * \oparam   Entry   Decoded entry.
+     *
+     * \return  false at the end of the data or for a damaged record.
+     */
+    /****************************************************************************/
+    static bool Decode(const QByteArray &Data, int &Offset, DayEventEntry &Entry);
+
+private:
+    static void AppendString(const QString &String, QByteArray &Buffer);
+    static bool ReadString(const char *pData, int Size, int &Offset, QString &String);
+    static void AppendArguments(const Global::tTranslatableStringList &Arguments, QByteArray &Buffer);
+    static bool ReadArguments(const char *pData, int Size, int &Offset, int Depth,
+                              Global::tTranslatableStringList &Arguments);
+
+    DayEventRecord();   ///< Not implemented.
+}; // end class DayEventRecord
+
+} // end namespace DataLogging
+
+#endif // DATALOGGING_DAYEVENTRECORD_H
@@ -36,6 +36,13 @@ namespace DataLogging {
  *
  * This class creates the daily run log files and file names in the file system
  * depending on the request given by DataLoggingThreadController class
+ *
+ * The event log files are scanned once, line by line, and each line is split
+ * once. The rendering of a log file is cached in DailyRunCache below the log
+ * file folder, together with the scanned length of the log file. A closed day
+ * is answered from its cache, the current day is scanned from the cached
+ * length on. A cache is discarded if the log file was rewritten or the
+ * language changed.
  * \warning This class is not thread safe!
  */
 /****************************************************************************/
@@ -48,6 +55,10 @@ private:
     QList<quint32>              m_ListOfEventIds;                  ///< To store common string event Ids e.g. Resolved, Acknowledged by user
     QList<quint32>              m_ListOfBtnEventIds;               ///< To store button string event Ids e.g. OK, Cancel etc.
     QList<quint32>              m_EventIDs;                         ///< Store the event ids
+    QStringList                 m_EventTypeNames;                   ///< English names of the event types
+    QList<quint32>              m_EventTypeIDs;                     ///< String ids of the event types
+    QStringList                 m_NonActiveTexts;                   ///< English texts of m_ListOfEventIds
+    QStringList                 m_BtnNames;                         ///< English names of m_ListOfBtnEventIds
 
 
     /****************************************************************************/
@@ -72,6 +83,57 @@ private:
     /****************************************************************************/
     void ReadAndTranslateTheFile(const QString &FileName, const QByteArray &ByteArray);
 
+    /****************************************************************************/
+    /**
+     * \brief Translates one line of an event log file.
+     *
+     * User log entries and header lines are appended to the output, other
+     * entries are skipped.
+     *
+     * \iparam    p_Line      The line, including the line feed if any.
+     * \iparam    Length      Length of the line in bytes.
+     * \oparam    Output      Daily run log data.
+     */
+    /****************************************************************************/
+    void TranslateLine(const char *p_Line, int Length, QByteArray &Output);
+
+    /****************************************************************************/
+    /**
+     * \brief Loads the cached rendering of a log file.
+     *
+     * \iparam    CacheFileName   Path of the cache file.
+     * \iparam    p_LogData       Content of the log file.
+     * \iparam    LogSize         Size of the log file.
+     * \oparam    Rendering       Daily run log data of the cached part.
+     *
+     * \return    Length of the log file covered by the cache, 0 if none.
+     */
+    /****************************************************************************/
+    qint64 LoadCache(const QString &CacheFileName, const char *p_LogData, qint64 LogSize, QByteArray &Rendering);
+
+    /****************************************************************************/
+    /**
+     * \brief Saves the rendering of a log file in the cache.
+     *
+     * \iparam    CacheFileName   Path of the cache file.
+     * \iparam    p_LogData       Content of the log file.
+     * \iparam    Offset          Length of the log file covered by the rendering.
+     * \iparam    Rendering       Daily run log data up to Offset.
+     */
+    /****************************************************************************/
+    void SaveCache(const QString &CacheFileName, const char *p_LogData, qint64 Offset, const QByteArray &Rendering);
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the path of the cache file of a log file.
+     *
+     * \iparam    FileName    Path of the log file.
+     *
+     * \return    Path of the cache file.
+     */
+    /****************************************************************************/
+    QString CacheFileName(const QString &FileName) const;
+
     /****************************************************************************/
     /**
      * \brief Translates the event type
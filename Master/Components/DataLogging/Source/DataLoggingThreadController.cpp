@@ -26,6 +26,7 @@
 #include <DataLogging/Include/DataLoggingThreadController.h>
 #include <DataLogging/Include/EventFilterNetworkServer.h>
 #include <Global/Include/SystemPaths.h>
+#include <Global/Include/PowerFailJournal.h>
 #include <Global/Include/Utils.h>
 #include <Global/Include/GlobalDefines.h>
 #include <DataLogging/Include/DataLoggingEventCodes.h>
@@ -58,6 +59,7 @@ DataLoggingThreadController::DataLoggingThreadController(quint32 ThreadID,
     mp_DayEventLogger = new DayEventLogger(this, "DataLogging",FileNamePrefix);
     qRegisterMetaType<DataLogging::DayEventEntry>("DataLogging::DayEventEntry");
     m_ImmediateLog = false;
+    m_TextView = true;
 
 }
 
@@ -91,6 +93,13 @@ void DataLoggingThreadController::CreateAndInitializeObjects() {
         }
     }
 
+    // the day event logger recovers the log tail of a power fail while it is configured
+    QString JournalFileName = Global::SystemPaths::Instance().GetSettingsPath() + "/PowerFail.journal";
+    if (!Global::PowerFailJournal::Instance().IsOpen() && !Global::PowerFailJournal::Instance().Open(JournalFileName)) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_CREATE,
+                                                   Global::FmtArgs() << JournalFileName, true);
+    }
+    mp_DayEventLogger->SetTextViewEnabled(m_TextView);
     mp_DayEventLogger->Configure(DayEventLoggerConfig(m_OperatingMode,
                                                     m_SerialNumber,
                                                     m_SWVersion,
@@ -122,14 +131,14 @@ void DataLoggingThreadController::OnGoReceived() {
 
 /****************************************************************************/
 void DataLoggingThreadController::OnStopReceived() {
-    mp_DayEventLogger->CloseFile();
+    mp_DayEventLogger->CloseFiles();
 }
 
 /****************************************************************************/
 void DataLoggingThreadController::OnPowerFail(const Global::PowerFailStages PowerFailStage) {
     // switch to state power fail
     if (PowerFailStage == Global::POWER_FAIL_STAGE_2) {
-        mp_DayEventLogger->CloseFile();
+        mp_DayEventLogger->CloseFiles();
         m_oPowerFail = true;
     }
 }
@@ -146,9 +155,10 @@ void DataLoggingThreadController::SendToDayEventLogger(const DayEventEntry &Entr
     // silently discard entry if power fails
     if(!m_oPowerFail) {
         QString TrEventMessage;
-        mp_DayEventLogger->Log(Entry, TrEventMessage);
-        // check signal connection
-        if (receivers(SIGNAL(ForwardEventToRemoteCare(const DataLogging::DayEventEntry&, const QString &))) == 0)
+        // the translated message is only needed if somebody is connected
+        bool Forward = (receivers(SIGNAL(ForwardEventToRemoteCare(const DataLogging::DayEventEntry&, const QString &))) > 0);
+        mp_DayEventLogger->Log(Entry, TrEventMessage, Forward);
+        if (!Forward)
             return;
 
         emit ForwardEventToRemoteCare(Entry, TrEventMessage);
@@ -168,6 +178,8 @@ void DataLoggingThreadController::OnRunLogRequest(Global::tRefType Ref,
     Q_UNUSED(Cmd);
     // send the acknowledgement
     SendAcknowledgeOK(Ref);
+    // render the text log files of the binary records
+    mp_DayEventLogger->UpdateTextViews();
 
     QStringList FileNames;
     QDir LogDirectory(Global::SystemPaths::Instance().GetLogfilesPath());
@@ -210,8 +222,8 @@ void DataLoggingThreadController::OnRunLogRequestFile(Global::tRefType Ref,
     QByteArray FileContent;
 
     QFile File;
-    // first flush the data to disk then do further processing
-    mp_DayEventLogger->FlushToDisk();
+    // first commit the data to disk and render the text log files then do further processing
+    mp_DayEventLogger->UpdateTextViews();
     // check the user level - for service user raw data (event log) shall be displayed
     switch(Cmd.GetUserLevel()) {
         case Global::SERVICE:
@@ -248,8 +260,8 @@ void DataLoggingThreadController::OnExportDayRunLogRequest(Global::tRefType Ref,
     Q_UNUSED(Cmd);
     // send the acknowledgement
     SendAcknowledgeOK(Ref);
-    // first flush the data to disk then do further processing
-    mp_DayEventLogger->FlushToDisk();
+    // first commit the data to disk and render the text log files then do further processing
+    mp_DayEventLogger->UpdateTextViews();
     // create object to create the file
     DayLogFileInformation DayRunFilesInformation(Global::SystemPaths::Instance().GetLogfilesPath(),
                                                  Cmd.GetFolderPath(), m_EventLoggerBaseFileName + m_SerialNumber + STRINGUNDERSCORE);
@@ -4,8 +4,9 @@
  *  \brief Implementation file for class DayEventLogger.
  *
  *\b Description:
- *      Day operation data is translated into the right language (depending on the
- *      operating mode) and written to file.
+ *      Day operation data is stored as binary records and committed to disk
+ *      in groups. The translated text log file is written along with the
+ *      records or rendered from them on request.
  *
  *  $Version:   $ 1.0
  *  $Date:      $ 2013-10-16
@@ -23,26 +24,40 @@
 /****************************************************************************/
 
 #include <DataLogging/Include/DayEventLogger.h>
+#include <DataLogging/Include/DayEventRecord.h>
 #include <DataLogging/Include/DataLoggingEventCodes.h>
 #include <Global/Include/EventTranslator.h>
 #include <Global/Include/Utils.h>
 #include <Global/Include/EventObject.h>
+#include <Global/Include/PowerFailJournal.h>
 
 #include <QDirIterator>
 #include <QDebug>
+#include <unistd.h>
 
 namespace DataLogging {
 
 static const int DAYEVENTLOGGER_FORMAT_VERSION = 1;     ///< Format version.
+static const int DAYEVENTLOGGER_COMMIT_DELAY = 200;     ///< Maximal delay until an entry is on disk [ms].
+static const int DAYEVENTLOGGER_BUFFER_SIZE = 16384;    ///< Buffered record bytes which cause a commit.
+static const QString RECORD_FILE_EXTENSION = ".evb";    ///< Extension of the record files.
+static const QString TEXT_FILE_EXTENSION = ".log";      ///< Extension of the text log files.
 
 /****************************************************************************/
 DayEventLogger::DayEventLogger(QObject *pParent, const QString & TheLoggingSource,
                                const QString& FileNamePrefix)
     : BaseLoggerReusable(pParent, TheLoggingSource, DAYEVENTLOGGER_FORMAT_VERSION)
     , m_MaxFileCount(0)
-    , m_FileNamePrefix(FileNamePrefix)  /*e.g. 'Leica_ST_'*/ {
+    , m_FileNamePrefix(FileNamePrefix)  /*e.g. 'Leica_ST_'*/
+    , m_TextView(true)
+    , m_TailPrefixSize(0)
+    , m_CommitTimer(this) {
     m_FlushImmediately = false;
-
+    m_RecordBuffer.reserve(DAYEVENTLOGGER_BUFFER_SIZE + DayEventRecord::MAX_RECORD_SIZE);
+    m_TailRecord.reserve(Global::PowerFailJournal::PFJ_PAYLOAD_SIZE);
+    m_CommitTimer.setSingleShot(true);
+    m_CommitTimer.setInterval(DAYEVENTLOGGER_COMMIT_DELAY);
+    CONNECTSIGNALSLOT(&m_CommitTimer, timeout(), this, CommitRecords());
 }
 
 /****************************************************************************/
@@ -55,6 +70,13 @@ QString DayEventLogger::ComputeFileNameRegExp() const {
     return m_FileNamePrefix + GetSerialNumber() + "_\?\?\?\?\?\?\?\?.log";
 }
 
+/****************************************************************************/
+QString DayEventLogger::ComputeRecordFileName(const QString &FileName) {
+    QString RecordFileName = FileName;
+    return RecordFileName.replace(RecordFileName.length() - TEXT_FILE_EXTENSION.length(),
+                                  TEXT_FILE_EXTENSION.length(), RECORD_FILE_EXTENSION);
+}
+
 /****************************************************************************/
 void DayEventLogger::SwitchToNewFile() {
     // check if old files exits and have to be deleted
@@ -71,9 +93,80 @@ void DayEventLogger::SwitchToNewFile() {
         if (!FileNames.contains(FileName) && (m_MaxFileCount <= FileNames.size())) {
             RemoveFile(Dir.absoluteFilePath(FileNames[m_MaxFileCount -1]));
         }
+        Dir.setNameFilters(QStringList() << ComputeRecordFileName(FileRegExp));
+        FileNames = Dir.entryList();
+        if (!FileNames.contains(ComputeRecordFileName(FileName)) && (m_MaxFileCount <= FileNames.size())) {
+            RemoveFile(Dir.absoluteFilePath(FileNames[m_MaxFileCount -1]));
+        }
+    }
+    // OK, now switch to new file. The text file is needed as fallback if the
+    // record file cannot be used.
+    bool RecordFileOpen = SwitchToRecordFile(ComputeRecordFileName(FileName));
+    if (m_TextView || !RecordFileOpen) {
+        SwitchToFile(FileName);
+    }
+    else {
+        CloseFile();
+    }
+}
+
+/****************************************************************************/
+bool DayEventLogger::SwitchToRecordFile(const QString &FileName) {
+    CommitRecords();
+    if (m_RecordFile.isOpen()) {
+        m_RecordFile.close();
+    }
+    m_RecordFile.setFileName(QDir::cleanPath(QDir(GetPath()).absoluteFilePath(FileName)));
+
+    if (!m_RecordFile.open(QIODevice::ReadWrite)) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_CREATE,
+                                                   Global::FmtArgs() << m_RecordFile.fileName(), true);
+        return false;
+    }
+
+    // keep all complete records of an existing file
+    int Offset = ComputeCompleteSize(m_RecordFile.readAll());
+    if (Offset < 0) {
+        DayEventRecordHeader Header;
+        Header.FormatVersion = static_cast<quint16>(GetFormatVersion());
+        Header.FileName = QFileInfo(FileName).completeBaseName();
+        Header.TimeStamp = GetTimeStampHeader();
+        Header.OperatingMode = GetOperatingMode();
+        Header.SerialNumber = GetSerialNumber();
+        Header.SWVersion = GetSWVersion();
+        Offset = 0;
+        DayEventRecord::EncodeHeader(Header, m_RecordBuffer);
+    }
+
+    if (!m_RecordFile.resize(Offset) || !m_RecordFile.seek(Offset)) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_WRITE,
+                                                   Global::FmtArgs() << m_RecordFile.fileName(), true);
+        m_RecordFile.close();
+        m_RecordBuffer.truncate(0);
+        m_TailOffsets.clear();
+        return false;
     }
-    // OK, now switch to new file
-    SwitchToFile(FileName);
+    CommitRecords();
+    // the log tail names the record file it belongs to
+    m_TailRecord.truncate(0);
+    m_TailRecord.append(QFileInfo(m_RecordFile.fileName()).fileName().toUtf8());
+    m_TailRecord.append('\0');
+    m_TailPrefixSize = m_TailRecord.size();
+    return true;
+}
+
+/****************************************************************************/
+int DayEventLogger::ComputeCompleteSize(const QByteArray &Content) const {
+    DayEventRecordHeader Header;
+    int Offset = 0;
+    if (!DayEventRecord::DecodeHeader(Content, Offset, Header) ||
+        (Header.FormatVersion != GetFormatVersion()) || (Header.SerialNumber != GetSerialNumber())) {
+        return -1;
+    }
+    DayEventEntry Entry;
+    while (DayEventRecord::Decode(Content, Offset, Entry)) {
+    }
+    return Offset;
 }
 
 /****************************************************************************/
@@ -99,7 +192,7 @@ void DayEventLogger::RemoveOutdatedFiles(QString Prefix, quint8 DaysBack)
 }
 
 /****************************************************************************/
-void DayEventLogger::Log(const DayEventEntry &Entry, QString &message) {
+QString DayEventLogger::ComposeLine(const DayEventEntry &Entry, QString &message) const {
 
     // translate event type
     quint32 IDStrEvtType = Global::EVENT_GLOBAL_UNKNOWN_STRING_ID;
@@ -236,6 +329,11 @@ void DayEventLogger::Log(const DayEventEntry &Entry, QString &message) {
                         TrEventMessage;
     }
 
+    return LoggingString;
+}
+
+/****************************************************************************/
+void DayEventLogger::Log(const DayEventEntry &Entry, QString &message, bool ComposeMessage) {
 
     // check if we must printout to console (because we sent it to the data logger
     // and we have to avoid a ping pong of error messages)
@@ -244,11 +342,25 @@ void DayEventLogger::Log(const DayEventEntry &Entry, QString &message) {
         ((Entry.GetEventType() == Global::EVTTYPE_FATAL_ERROR) || (Entry.GetEventType() == Global::EVTTYPE_ERROR)))
     {
         // Put it to console since we could not write at that time.
-        Global::ToConsole(LoggingString);
+        Global::ToConsole(ComposeLine(Entry, message));
+        return;
     }
-    else
-    {
-        (void)CheckNewFile();
+
+    (void)CheckNewFile();
+
+    if (m_RecordFile.isOpen()) {
+        int Offset = m_RecordBuffer.size();
+        if (!DayEventRecord::Encode(Entry, m_RecordBuffer)) {
+            Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_WRITE,
+                                                       Global::FmtArgs() << m_RecordFile.fileName(), true);
+        }
+        else {
+            StageLogTail(Offset);
+        }
+    }
+
+    if (m_TextView || !m_RecordFile.isOpen()) {
+        QString LoggingString = ComposeLine(Entry, message);
 
         /// check if file ready for logging - usually log file opens at the
         /// start of the Data Logging component. Suppose if the system unable to write
@@ -258,18 +370,173 @@ void DayEventLogger::Log(const DayEventEntry &Entry, QString &message) {
         {
             CreateTemporaryLogFile();
         }
-        /// m_FlushImmediately flag sets true then thread (Means who uses data logging)
-        /// wants to flush the data immediately, so need not require to change the data
-        bool FlushData = m_FlushImmediately;
-        if (!FlushData) {
-            FlushData = (EventType != Global::EVTTYPE_INFO ? true : false);
+        // append data to file, flushing is done by the commit
+        AppendLine(LoggingString, false);
+    }
+    else if (ComposeMessage) {
+        (void)ComposeLine(Entry, message);
+    }
+
+    /// m_FlushImmediately flag sets true then thread (Means who uses data logging)
+    /// wants to flush the data immediately. Fatal errors are committed at once,
+    /// all other entries within DAYEVENTLOGGER_COMMIT_DELAY.
+    if (m_FlushImmediately || (Entry.GetEventType() == Global::EVTTYPE_FATAL_ERROR) ||
+        (m_RecordBuffer.size() >= DAYEVENTLOGGER_BUFFER_SIZE)) {
+        CommitRecords();
+    }
+    else if (!m_CommitTimer.isActive()) {
+        m_CommitTimer.start();
+    }
+}
+
+/****************************************************************************/
+void DayEventLogger::CommitRecords() {
+    m_CommitTimer.stop();
+    if (m_RecordFile.isOpen() && (m_RecordBuffer.size() > 0)) {
+        if (m_RecordFile.write(m_RecordBuffer) != m_RecordBuffer.size()) {
+            Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_WRITE,
+                                                       Global::FmtArgs() << m_RecordFile.fileName(), true);
+        }
+        else if (!m_RecordFile.flush() || fdatasync(m_RecordFile.handle()) == -1) {
+            Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_FLUSH,
+                                                       Global::FmtArgs() << m_RecordFile.fileName(), true);
+        }
+    }
+    m_RecordBuffer.truncate(0);
+    if (!m_TailOffsets.isEmpty()) {
+        // the tail is on disk now
+        m_TailOffsets.clear();
+        (void)Global::PowerFailJournal::Instance().Stage(Global::PFJ_SLOT_LOG_TAIL, QByteArray());
+    }
+    // flush the text file in the same group
+    FlushToDisk();
+}
+
+/****************************************************************************/
+void DayEventLogger::StageLogTail(int Offset) {
+    const int MaxSize = Global::PowerFailJournal::PFJ_PAYLOAD_SIZE - m_TailPrefixSize;
+    m_TailOffsets.append(Offset);
+    while ((m_TailOffsets.count() > 1) && (m_RecordBuffer.size() - m_TailOffsets.first() > MaxSize)) {
+        m_TailOffsets.removeFirst();
+    }
+    int Start = m_TailOffsets.first();
+    if (m_RecordBuffer.size() - Start <= MaxSize) {
+        m_TailRecord.resize(m_TailPrefixSize);
+        m_TailRecord.append(m_RecordBuffer.constData() + Start, m_RecordBuffer.size() - Start);
+        (void)Global::PowerFailJournal::Instance().Stage(Global::PFJ_SLOT_LOG_TAIL, m_TailRecord);
+    }
+}
+
+/****************************************************************************/
+void DayEventLogger::RecoverLogTail() {
+    QByteArray Tail;
+    if (!Global::PowerFailJournal::Instance().Load(Global::PFJ_SLOT_LOG_TAIL, Tail) || Tail.isEmpty()) {
+        return;
+    }
+    int Separator = Tail.indexOf('\0');
+    if (Separator > 0) {
+        QFile RecordFile(QDir(GetPath()).absoluteFilePath(QString::fromUtf8(Tail.constData(), Separator)));
+        QByteArray Records = Tail.mid(Separator + 1);
+        if (RecordFile.open(QIODevice::ReadWrite)) {
+            QByteArray Content = RecordFile.readAll();
+            int Size = ComputeCompleteSize(Content);
+            // the tail is already on disk, if the power failed right after a commit
+            if ((Size > 0) && !Content.left(Size).endsWith(Records)) {
+                if (!RecordFile.resize(Size) || !RecordFile.seek(Size) ||
+                    (RecordFile.write(Records) != Records.size()) || !RecordFile.flush() ||
+                    (fdatasync(RecordFile.handle()) == -1)) {
+                    Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_WRITE,
+                                                               Global::FmtArgs() << RecordFile.fileName(), true);
+                }
+                else if (m_TextView) {
+                    QFileInfo RecordInfo(RecordFile.fileName());
+                    RenderTextView(RecordInfo.absoluteFilePath(), RecordInfo.absolutePath() + QDir::separator() +
+                                   RecordInfo.completeBaseName() + TEXT_FILE_EXTENSION);
+                }
+            }
+            RecordFile.close();
+        }
+    }
+    (void)Global::PowerFailJournal::Instance().Stage(Global::PFJ_SLOT_LOG_TAIL, QByteArray());
+}
+
+/****************************************************************************/
+void DayEventLogger::CloseFiles() {
+    CommitRecords();
+    if (m_RecordFile.isOpen()) {
+        m_RecordFile.close();
+    }
+    CloseFile();
+}
+
+/****************************************************************************/
+void DayEventLogger::SetTextViewEnabled(bool Enable) {
+    m_TextView = Enable;
+}
+
+/****************************************************************************/
+void DayEventLogger::UpdateTextViews() {
+    CommitRecords();
+
+    QDir Dir(GetPath(), ComputeRecordFileName(ComputeFileNameRegExp()), QDir::Name, QDir::Files | QDir::CaseSensitive);
+    foreach (const QString &RecordFileName, Dir.entryList()) {
+        QFileInfo RecordInfo(Dir.absoluteFilePath(RecordFileName));
+        QString TextFileName = RecordInfo.absolutePath() + QDir::separator() + RecordInfo.completeBaseName() +
+                               TEXT_FILE_EXTENSION;
+        QFileInfo TextInfo(TextFileName);
+        // a text file which is written along with the records is always up to date
+        if (!TextInfo.exists() || (!m_TextView && (TextInfo.lastModified() < RecordInfo.lastModified()))) {
+            RenderTextView(RecordInfo.absoluteFilePath(), TextFileName);
         }
+    }
+}
 
-        // append data to file and flush
-        //qDebug() << "DayEventLogger::Log" << LoggingString;
-        AppendLine(LoggingString, FlushData);
+/****************************************************************************/
+void DayEventLogger::RenderTextView(const QString &RecordFileName, const QString &TextFileName) const {
+    QFile RecordFile(RecordFileName);
+    if (!RecordFile.open(QIODevice::ReadOnly)) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_NOT_OPEN,
+                                                   Global::FmtArgs() << RecordFileName, true);
+        return;
     }
+    QByteArray Content = RecordFile.readAll();
+    RecordFile.close();
 
+    DayEventRecordHeader Header;
+    int Offset = 0;
+    if (!DayEventRecord::DecodeHeader(Content, Offset, Header)) {
+        return;
+    }
+
+    QString Text = "Format Version: " + QString::number(Header.FormatVersion, 10) + "\n\n" +
+                   "FileName: " + Header.FileName + "\n\n" +
+                   "TimeStamp: " + Header.TimeStamp + "\n\n" +
+                   "OperatingMode: " + Header.OperatingMode + "\n\n" +
+                   "Serial Number: " + Header.SerialNumber + "\n\n" +
+                   "SW Version: " + Header.SWVersion + "\n\n" + "\n";
+    DayEventEntry Entry;
+    QString Message;
+    while (DayEventRecord::Decode(Content, Offset, Entry)) {
+        Text += ComposeLine(Entry, Message) + "\n";
+    }
+
+    // render into a temporary file, readers never see a partial text file
+    QString TempFileName = TextFileName + ".tmp";
+    QFile TextFile(TempFileName);
+    if (!TextFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text) ||
+        (TextFile.write(Text.toUtf8()) == -1) || !TextFile.flush()) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_WRITE,
+                                                   Global::FmtArgs() << TextFileName, true);
+        TextFile.close();
+        (void)QFile::remove(TempFileName);
+        return;
+    }
+    TextFile.close();
+    (void)QFile::remove(TextFileName);
+    if (!QFile::rename(TempFileName, TextFileName)) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_DATALOGGING_ERROR_FILE_WRITE,
+                                                   Global::FmtArgs() << TextFileName, true);
+    }
 }
 
 /****************************************************************************/
@@ -284,6 +551,10 @@ void DayEventLogger::Configure(const DayEventLoggerConfig &Config) {
     m_LastLogDate = Global::AdjustedTime::Instance().GetCurrentDate();
     m_LastLogDateBackUp = m_LastLogDate;
     m_FileNamePrefix = Config.GetBaseFileName();
+    // at startup, the records of a power fail go to their file before it is reopened
+    if (!m_RecordFile.isOpen()) {
+        RecoverLogTail();
+    }
     // switch to new file
     SwitchToNewFile();
 
@@ -0,0 +1,274 @@
+/****************************************************************************/
+/*! \file DataLogging/Source/DayEventRecord.cpp
+ *
+ *  \brief Implementation file for class DayEventRecord.
+ *
+ *\b Description:
+ *      Binary encoding of day event entries. The records are written by the
+ *      DayEventLogger and rendered to the text log file on demand.
+ *
+ *  $Version:   $ 1.0
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <DataLogging/Include/DayEventRecord.h>
+
+#include <QtEndian>
+
+namespace DataLogging {
+
+const quint32 DayEventRecord::FILE_MAGIC = 0x5645424C;  // "LBEV"
+
+static const quint16 RECORD_FILE_VERSION    = 1;        ///< Version of the binary layout.
+static const quint8  ARGUMENT_PLAIN_STRING  = 0;        ///< Argument is a plain string.
+static const quint8  ARGUMENT_STRING_ID     = 1;        ///< Argument is a string ID with arguments.
+static const int     MAX_ARGUMENT_DEPTH     = 4;        ///< Nesting limit of decoded arguments.
+static const quint8  FLAG_EVENT_ACTIVE      = 0x01;     ///< Entry flag: event is active.
+static const quint8  FLAG_SHOW_IN_RUN_LOG   = 0x02;     ///< Entry flag: show in run log.
+
+/****************************************************************************/
+/**
+ * \brief Append a number in little endian byte order.
+ *
+ * \iparam   Value   Number.
+ * \oparam   Buffer  Buffer to append to.
+ */
+/****************************************************************************/
+template<typename T>
+static inline void AppendNumber(T Value, QByteArray &Buffer) {
+    uchar Raw[sizeof(T)];
+    qToLittleEndian<T>(Value, Raw);
+    (void)Buffer.append(reinterpret_cast<const char *>(Raw), sizeof(T));
+}
+
+/****************************************************************************/
+/**
+ * \brief Read a number in little endian byte order.
+ *
+ * \iparam   pData   Data.
+ * \iparam   Size    Size of the data.
+ * \ioparam  Offset  Read position, moved behind the number on success.
+ * \oparam   Value   Number.
+ *
+ * \return  false if the data is too short.
+ */
+/****************************************************************************/
+template<typename T>
+static inline bool ReadNumber(const char *pData, int Size, int &Offset, T &Value) {
+    if (Size - Offset < static_cast<int>(sizeof(T))) {
+        return false;
+    }
+    Value = qFromLittleEndian<T>(reinterpret_cast<const uchar *>(pData + Offset));
+    Offset += static_cast<int>(sizeof(T));
+    return true;
+}
+
+/****************************************************************************/
+void DayEventRecord::AppendString(const QString &String, QByteArray &Buffer) {
+    QByteArray Utf8 = String.toUtf8();
+    AppendNumber<quint16>(static_cast<quint16>(qMin(Utf8.size(), 0xFFFF)), Buffer);
+    (void)Buffer.append(Utf8.constData(), qMin(Utf8.size(), 0xFFFF));
+}
+
+/****************************************************************************/
+bool DayEventRecord::ReadString(const char *pData, int Size, int &Offset, QString &String) {
+    quint16 Length = 0;
+    if (!ReadNumber<quint16>(pData, Size, Offset, Length) || (Size - Offset < Length)) {
+        return false;
+    }
+    String = QString::fromUtf8(pData + Offset, Length);
+    Offset += Length;
+    return true;
+}
+
+/****************************************************************************/
+void DayEventRecord::AppendArguments(const Global::tTranslatableStringList &Arguments, QByteArray &Buffer) {
+    int Count = qMin(Arguments.count(), 0xFF);
+    AppendNumber<quint8>(static_cast<quint8>(Count), Buffer);
+    for (int i = 0; i < Count; i++) {
+        const Global::TranslatableString &Argument = Arguments.at(i);
+        if (Argument.IsString()) {
+            AppendNumber<quint8>(ARGUMENT_PLAIN_STRING, Buffer);
+            AppendString(Argument.GetString(), Buffer);
+        }
+        else {
+            AppendNumber<quint8>(ARGUMENT_STRING_ID, Buffer);
+            AppendNumber<quint32>(Argument.GetStringID(), Buffer);
+            AppendArguments(Argument.GetArgumentList(), Buffer);
+        }
+    }
+}
+
+/****************************************************************************/
+bool DayEventRecord::ReadArguments(const char *pData, int Size, int &Offset, int Depth,
+                                   Global::tTranslatableStringList &Arguments) {
+    quint8 Count = 0;
+    if ((Depth > MAX_ARGUMENT_DEPTH) || !ReadNumber<quint8>(pData, Size, Offset, Count)) {
+        return false;
+    }
+    for (int i = 0; i < Count; i++) {
+        quint8 Tag = 0;
+        if (!ReadNumber<quint8>(pData, Size, Offset, Tag)) {
+            return false;
+        }
+        if (Tag == ARGUMENT_PLAIN_STRING) {
+            QString String;
+            if (!ReadString(pData, Size, Offset, String)) {
+                return false;
+            }
+            Arguments.append(Global::TranslatableString(String));
+        }
+        else if (Tag == ARGUMENT_STRING_ID) {
+            quint32 StringID = 0;
+            Global::tTranslatableStringList SubArguments;
+            if (!ReadNumber<quint32>(pData, Size, Offset, StringID) ||
+                !ReadArguments(pData, Size, Offset, Depth + 1, SubArguments)) {
+                return false;
+            }
+            Arguments.append(Global::TranslatableString(StringID, SubArguments));
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************************/
+void DayEventRecord::EncodeHeader(const DayEventRecordHeader &Header, QByteArray &Buffer) {
+    AppendNumber<quint32>(FILE_MAGIC, Buffer);
+    AppendNumber<quint16>(RECORD_FILE_VERSION, Buffer);
+    AppendNumber<quint16>(Header.FormatVersion, Buffer);
+    AppendString(Header.FileName, Buffer);
+    AppendString(Header.TimeStamp, Buffer);
+    AppendString(Header.OperatingMode, Buffer);
+    AppendString(Header.SerialNumber, Buffer);
+    AppendString(Header.SWVersion, Buffer);
+}
+
+/****************************************************************************/
+bool DayEventRecord::DecodeHeader(const QByteArray &Data, int &Offset, DayEventRecordHeader &Header) {
+    const char *pData = Data.constData();
+    int Size = Data.size();
+    int Position = 0;
+    quint32 Magic = 0;
+    quint16 Version = 0;
+
+    if (!ReadNumber<quint32>(pData, Size, Position, Magic) || (Magic != FILE_MAGIC) ||
+        !ReadNumber<quint16>(pData, Size, Position, Version) || (Version != RECORD_FILE_VERSION)) {
+        return false;
+    }
+    if (!ReadNumber<quint16>(pData, Size, Position, Header.FormatVersion) ||
+        !ReadString(pData, Size, Position, Header.FileName) ||
+        !ReadString(pData, Size, Position, Header.TimeStamp) ||
+        !ReadString(pData, Size, Position, Header.OperatingMode) ||
+        !ReadString(pData, Size, Position, Header.SerialNumber) ||
+        !ReadString(pData, Size, Position, Header.SWVersion)) {
+        return false;
+    }
+    Offset = Position;
+    return true;
+}
+
+/****************************************************************************/
+bool DayEventRecord::Encode(const DayEventEntry &Entry, QByteArray &Buffer) {
+    int Start = Buffer.size();
+    // length and checksum are filled in when the payload is complete
+    AppendNumber<quint32>(0, Buffer);
+
+    quint8 Flags = 0;
+    if (Entry.IsEventActive()) {
+        Flags |= FLAG_EVENT_ACTIVE;
+    }
+    if (Entry.GetShowInRunLogStatus()) {
+        Flags |= FLAG_SHOW_IN_RUN_LOG;
+    }
+    AppendNumber<quint32>(Entry.GetEventCode(), Buffer);
+    AppendNumber<quint32>(Entry.GetEventKey(), Buffer);
+    AppendNumber<qint64>(Entry.GetTimeStamp().toMSecsSinceEpoch(), Buffer);
+    AppendNumber<quint32>(Entry.GetStringID(), Buffer);
+    AppendNumber<quint8>(static_cast<quint8>(Entry.GetEventType()), Buffer);
+    AppendNumber<quint8>(static_cast<quint8>(Entry.GetAltStringUsageType()), Buffer);
+    AppendNumber<quint8>(static_cast<quint8>(Entry.GetAckValue()), Buffer);
+    AppendNumber<quint8>(Flags, Buffer);
+    AppendString(Entry.GetEventName(), Buffer);
+    AppendArguments(Entry.GetString(), Buffer);
+
+    int Length = Buffer.size() - Start - RECORD_PREFIX_SIZE;
+    if (Length > MAX_RECORD_SIZE) {
+        Buffer.truncate(Start);
+        return false;
+    }
+    uchar *pPrefix = reinterpret_cast<uchar *>(Buffer.data() + Start);
+    qToLittleEndian<quint16>(static_cast<quint16>(Length), pPrefix);
+    qToLittleEndian<quint16>(qChecksum(Buffer.constData() + Start + RECORD_PREFIX_SIZE, static_cast<uint>(Length)),
+                             pPrefix + 2);
+    return true;
+}
+
+/****************************************************************************/
+bool DayEventRecord::Decode(const QByteArray &Data, int &Offset, DayEventEntry &Entry) {
+    const char *pData = Data.constData();
+    int Position = Offset;
+    quint16 Length = 0;
+    quint16 Checksum = 0;
+
+    if (!ReadNumber<quint16>(pData, Data.size(), Position, Length) ||
+        !ReadNumber<quint16>(pData, Data.size(), Position, Checksum) ||
+        (Data.size() - Position < Length) ||
+        (qChecksum(pData + Position, Length) != Checksum)) {
+        return false;
+    }
+
+    int End = Position + Length;
+    quint32 EventCode = 0;
+    quint32 EventKey = 0;
+    qint64 TimeStamp = 0;
+    quint32 StringID = 0;
+    quint8 EventType = 0;
+    quint8 AltStringUsage = 0;
+    quint8 AckValue = 0;
+    quint8 Flags = 0;
+    QString EventName;
+    Global::tTranslatableStringList Arguments;
+
+    if (!ReadNumber<quint32>(pData, End, Position, EventCode) ||
+        !ReadNumber<quint32>(pData, End, Position, EventKey) ||
+        !ReadNumber<qint64>(pData, End, Position, TimeStamp) ||
+        !ReadNumber<quint32>(pData, End, Position, StringID) ||
+        !ReadNumber<quint8>(pData, End, Position, EventType) ||
+        !ReadNumber<quint8>(pData, End, Position, AltStringUsage) ||
+        !ReadNumber<quint8>(pData, End, Position, AckValue) ||
+        !ReadNumber<quint8>(pData, End, Position, Flags) ||
+        !ReadString(pData, End, Position, EventName) ||
+        !ReadArguments(pData, End, Position, 0, Arguments)) {
+        return false;
+    }
+
+    Entry.SetEventCode(static_cast<qint32>(EventCode));
+    Entry.SetEventKey(EventKey);
+    Entry.SetDateTime(QDateTime::fromMSecsSinceEpoch(TimeStamp));
+    Entry.SetStringID(static_cast<qint32>(StringID));
+    Entry.SetEventType(static_cast<Global::EventType>(EventType));
+    Entry.SetAltStringUsage(static_cast<Global::AlternateEventStringUsage>(AltStringUsage));
+    Entry.SetAckValue(static_cast<NetCommands::ClickedButton_t>(AckValue));
+    Entry.SetEventStatus((Flags & FLAG_EVENT_ACTIVE) != 0);
+    Entry.SetShowInRunLogStatus((Flags & FLAG_SHOW_IN_RUN_LOG) != 0);
+    Entry.SetEventName(EventName);
+    Entry.SetString(Arguments);
+
+    Offset = End;
+    return true;
+}
+
+} // end namespace DataLogging
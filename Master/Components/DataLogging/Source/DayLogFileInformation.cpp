@@ -25,6 +25,9 @@
 
 #include <QFile>
 #include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QVarLengthArray>
 #include <QXmlStreamReader>
 #include <QDebug>
 #include <QProcess>
@@ -34,6 +37,8 @@
 #include "QCoreApplication"
 #include "QEventLoop"
 
+#include <string.h>
+
 namespace DataLogging {
 
 const char DELIMITER_SEMICOLON              = ';';///< Delimiter for semicolon
@@ -53,6 +58,13 @@ const QString COMMAND_RMDIR                 = "rmdir "; ///< constant string for
 const QString COMMAND_ARGUMENT_C            = "-c"; ///< constant string for the command argument for shell '-c'
 const QString COMMAND_ARGUMENT_R            = "-rf"; ///< constant string for the command argument for recursive files '-r'
 const QString COMMAND_RM                    = "rm "; ///< constant string for the command 'rm'
+const QString DAILYRUNLOG_CACHE_DIRECTORY   = "DailyRunCache"; ///< folder of the cached renderings below the log files
+const QString FILEEXTENSION_CACHE           = ".cache"; ///< extension of the cache files
+const QString MULTIPLECACHEFILES            = "*.cache"; ///< multiple cache files string
+const quint32 CACHE_MAGIC                   = 0x4352444C; ///< "LDRC", identifies a cache file
+const quint32 CACHE_VERSION                 = 1; ///< version of the cache file format
+const int CACHE_HEADER_SIZE                 = 28; ///< size of the cache file header
+const qint64 CACHE_CHECK_SIZE               = 256; ///< bytes at the start and the end of the cached part which are checked
 
 // event type translations
 const QString STRING_RESOLVED               = "Resolved:"; ///< string for resolved
@@ -70,6 +82,43 @@ const qint32 EVENTSTRING_EVENTSTRING        = 4; ///< event log event string num
 const qint32 EVENTSTRING_USERLOG            = 5; ///< event log user log flag number if the event is splitted
 const qint32 EVENTSTRING_ALTERNATETEXT      = 6; ///< event log alternate text flag number if the event is splitted
 const qint32 EVENTSTRING_PARAMETERS         = 7; ///< event log parameters number if the event is splitted
+const int EVENTSTRING_MAX_FIELDS            = 32; ///< fields of a line split without allocation
+
+/****************************************************************************/
+/*!
+ *  \brief  Splits a line of an event log file at the semicolons.
+ *
+ *  \iparam p_Line = The line
+ *  \iparam Length = Length of the line
+ *  \oparam Starts = Start of each field, followed by Length + 1
+ */
+/****************************************************************************/
+static void SplitLine(const char *p_Line, int Length, QVarLengthArray<int, EVENTSTRING_MAX_FIELDS> &Starts) {
+    Starts.clear();
+    Starts.append(0);
+    for (int Index = 0; Index < Length; Index++) {
+        if (p_Line[Index] == DELIMITER_SEMICOLON) {
+            Starts.append(Index + 1);
+        }
+    }
+    Starts.append(Length + 1);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Computes a checksum of the start and the end of a part of a file.
+ *
+ *  \iparam p_Data = Content of the file
+ *  \iparam Size = Size of the part
+ *
+ *  \return The checksum
+ */
+/****************************************************************************/
+static quint32 CacheChecksum(const char *p_Data, qint64 Size) {
+    uint CheckSize = static_cast<uint>(qMin(Size, CACHE_CHECK_SIZE));
+    return (static_cast<quint32>(qChecksum(p_Data, CheckSize)) << 16) |
+            qChecksum(p_Data + Size - CheckSize, CheckSize);
+}
 
 
 /****************************************************************************/
@@ -104,6 +153,23 @@ DayLogFileInformation::DayLogFileInformation(QString FilePath, QString DailyRunL
                << Global::EVENT_GLOBAL_USER_ACTIVITY_REAGENT_HC_MODE
                << Global::EVENT_GLOBAL_USER_ACTIVITY_REAGENT_HC_TEMPERATURE
                << Global::EVENT_GLOBAL_USER_ACTIVITY_REAGENT_HC;
+
+    // the english texts are looked up once and not for every line
+    m_EventTypeIDs << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_UNDEFINED
+                   << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_FATAL_ERROR
+                   << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_ERROR
+                   << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_WARNING
+                   << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_INFO
+                   << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_DEBUG;
+    foreach (quint32 EventTypeID, m_EventTypeIDs) {
+        m_EventTypeNames << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English, EventTypeID);
+    }
+    foreach (quint32 EventIdValue, m_ListOfEventIds) {
+        m_NonActiveTexts << Global::EventTranslator::TranslatorInstance().Translate(EventIdValue);
+    }
+    foreach (quint32 BtnEventIdValue, m_ListOfBtnEventIds) {
+        m_BtnNames << Global::EventTranslator::TranslatorInstance().Translate(BtnEventIdValue);
+    }
 }
 
 /****************************************************************************/
@@ -115,100 +181,193 @@ void DayLogFileInformation::ReadAndTranslateTheFile(const QString &FileName, con
     if (!LogFile.open(QIODevice::ReadOnly)) {
         return;
     }
-    // read entire file
-    while (!LogFile.atEnd()) {
-        QString ReadData = QString::fromUtf8(LogFile.readLine());
-        if (ReadData.contains(STRING_SEMICOLON)) {
-            if (ReadData.split(DELIMITER_SEMICOLON).count() > EVENTSTRING_USERLOG) {
-                if (QString(ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_USERLOG)).compare(FLAG_VALUE) == 0) {
-
-                    Global::tTranslatableStringList TranslateStringList;
-                    // read all the parameters
-                    for (int Counter = EVENTSTRING_PARAMETERS; Counter < ReadData.split(DELIMITER_SEMICOLON).count();
-                         Counter++) {
-                        if (QString(ReadData.split(DELIMITER_SEMICOLON).value(Counter)).
-                                compare(STRING_NEWLINE) != 0) {
-                            QString StrPar = ReadData.split(DELIMITER_SEMICOLON).value(Counter);
-                            if(!StrPar.startsWith("##"))// plain string
-                            {
-                                TranslateStringList << Global::TranslatableString(StrPar);
-                            }
-                            else //need to be translated
-                            {
-                                TranslateStringList << Global::TranslatableString(StrPar.mid(2).toUInt());//chop out ##
-                            }
-                        }
-                    }
-                    // used for alternate text
-                    bool UseAlternateText = false;
-                    if (QString(ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_ALTERNATETEXT)).
-                            compare(FLAG_VALUE) == 0) {
-                        UseAlternateText = true;
-                    }
-                    // translate the parameters
-//                    if (m_EventIDs.contains(QString(ReadData.split(DELIMITER_SEMICOLON).
-//                                                    value(EVENTSTRING_EVENTID)).toUInt())) {
-//                        TranslateTheParameters(QString(ReadData.split(DELIMITER_SEMICOLON).
-//                                                       value(EVENTSTRING_EVENTID)).toUInt(), TranslateStringList);
-//                    }
-
-                    // translate the data
-                    QString EventData = Global::EventTranslator::TranslatorInstance().Translate
-                            (Global::TranslatableString(QString(ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_STRINGID)).toInt(),
-                                                        TranslateStringList), UseAlternateText);
-
-                    if (EventData.isEmpty() || EventData.contains(TRANSLATE_RETURN_VALUE_1) ||
-                          EventData.compare("\"" + QString(ReadData.split(DELIMITER_SEMICOLON).
-                                                           value(EVENTSTRING_EVENTID)) +"\":") == 0 ||
-                          EventData.compare(QString(ReadData.split(DELIMITER_SEMICOLON).
-                                                             value(EVENTSTRING_EVENTID))) == 0) {
-
-                        // get the event string from the file
-                        EventData = ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_EVENTSTRING);
-
-                        // raise the event if the event id does not exist in the event string file
-                        Global::EventObject::Instance().RaiseEvent
-                                (EVENT_DATALOGGING_ERROR_EVENT_ID_NOT_EXISTS,
-                                 Global::FmtArgs() << ReadData.split(DELIMITER_SEMICOLON).value
-                                 (EVENTSTRING_EVENTID), true);
-                    }
+    qint64 Size = LogFile.size();
+    QByteArray Content;
+    const char *p_LogData = NULL;
+    if (Size > 0) {
+        p_LogData = reinterpret_cast<const char *>(LogFile.map(0, Size));
+    }
+    if (p_LogData == NULL) {
+        // the file system does not support mapping
+        Content = LogFile.readAll();
+        Size = Content.size();
+        p_LogData = Content.constData();
+    }
 
-                    // check for the non active text
-                    QString NonActiveEventText = ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_EVENTSTRING);
-                    if (FindAndTranslateNonActiveText(NonActiveEventText)) {
-                        // append the translated non active text
-                        EventData = NonActiveEventText + EventData;
-                    }
+    // the cached part is not scanned again
+    QString CacheFile = CacheFileName(FileName);
+    QByteArray Rendering;
+    qint64 CachedOffset = LoadCache(CacheFile, p_LogData, Size, Rendering);
+    qint64 Offset = CachedOffset;
+    while (Offset < Size) {
+        const char *p_Line = p_LogData + Offset;
+        const char *p_End = static_cast<const char *>(memchr(p_Line, '\n', static_cast<size_t>(Size - Offset)));
+        if (p_End == NULL) {
+            break;
+        }
+        int Length = static_cast<int>(p_End - p_Line) + 1;
+        TranslateLine(p_Line, Length, Rendering);
+        Offset += Length;
+    }
+    if (Offset != CachedOffset) {
+        SaveCache(CacheFile, p_LogData, Offset, Rendering);
+    }
+    FileData.append(Rendering);
+    // a line still being written is shown but not cached
+    if (Offset < Size) {
+        TranslateLine(p_LogData + Offset, static_cast<int>(Size - Offset), FileData);
+    }
+    LogFile.close();
+}
 
-                    // translate the event type
-                    QString EventType = ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_EVENTTYPE);
-                    TranslateEventType(EventType);
-
-                    // join the required data
-                    ReadData = QString(ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_TIMESTAMP))
-                               + STRING_SEMICOLON +
-                               QString(ReadData.split(DELIMITER_SEMICOLON).value(EVENTSTRING_EVENTID))
-                               + STRING_SEMICOLON + EventType + STRING_SEMICOLON + EventData + STRING_NEWLINE;
-                    FileData.append(ReadData.toUtf8());
-                    FileData.append(STRING_NEWLINE.toUtf8());
-                }
+/****************************************************************************/
+void DayLogFileInformation::TranslateLine(const char *p_Line, int Length, QByteArray &Output) {
+
+    QVarLengthArray<int, EVENTSTRING_MAX_FIELDS> Starts;
+    SplitLine(p_Line, Length, Starts);
+    int FieldCount = Starts.count() - 1;
+    if (FieldCount == 1) {
+        QString ReadData = QString::fromUtf8(p_Line, Length);
+        if (ReadData != STRING_NEWLINE) {
+            if (ReadData.contains(m_FileNamePrefix)) {
+                ReadData = DAILYRUNLOG_FILE_FIRSTLINE +
+                        ReadData.split(DELIMITER_UNDERSCORE).value(2) + STRING_NEWLINE;
             }
+            // append the data
+            Output.append(ReadData.toUtf8());
+            Output.append(STRING_NEWLINE.toUtf8());
         }
-        else {
-            if (ReadData != STRING_NEWLINE) {
-                if (ReadData.contains(m_FileNamePrefix)) {
-                    ReadData = DAILYRUNLOG_FILE_FIRSTLINE +
-                            ReadData.split(DELIMITER_UNDERSCORE).value(2) + STRING_NEWLINE;
-                }
-                // append the data
-                FileData.append(ReadData.toUtf8());
-                FileData.append(STRING_NEWLINE.toUtf8());
+        return;
+    }
+    // only the entries of the user log are shown, checked before any field is converted
+    if ((FieldCount <= EVENTSTRING_USERLOG) ||
+        (Starts[EVENTSTRING_USERLOG + 1] - Starts[EVENTSTRING_USERLOG] - 1 != FLAG_VALUE.length()) ||
+        (qstrncmp(p_Line + Starts[EVENTSTRING_USERLOG], "true", 4) != 0)) {
+        return;
+    }
+    QStringList Fields;
+    for (int Counter = 0; Counter < FieldCount; Counter++) {
+        Fields << QString::fromUtf8(p_Line + Starts[Counter], Starts[Counter + 1] - Starts[Counter] - 1);
+    }
+
+    Global::tTranslatableStringList TranslateStringList;
+    // read all the parameters
+    for (int Counter = EVENTSTRING_PARAMETERS; Counter < FieldCount; Counter++) {
+        const QString &StrPar = Fields.at(Counter);
+        if (StrPar.compare(STRING_NEWLINE) != 0) {
+            if(!StrPar.startsWith("##"))// plain string
+            {
+                TranslateStringList << Global::TranslatableString(StrPar);
+            }
+            else //need to be translated
+            {
+                TranslateStringList << Global::TranslatableString(StrPar.mid(2).toUInt());//chop out ##
             }
         }
     }
-    LogFile.close();
+    // used for alternate text
+    bool UseAlternateText = (Fields.value(EVENTSTRING_ALTERNATETEXT).compare(FLAG_VALUE) == 0);
+
+    const QString &EventID = Fields.at(EVENTSTRING_EVENTID);
+    // translate the data
+    QString EventData = Global::EventTranslator::TranslatorInstance().Translate
+            (Global::TranslatableString(Fields.at(EVENTSTRING_STRINGID).toInt(), TranslateStringList), UseAlternateText);
+
+    if (EventData.isEmpty() || EventData.contains(TRANSLATE_RETURN_VALUE_1) ||
+          EventData.compare("\"" + EventID +"\":") == 0 || EventData.compare(EventID) == 0) {
+
+        // get the event string from the file
+        EventData = Fields.at(EVENTSTRING_EVENTSTRING);
+
+        // raise the event if the event id does not exist in the event string file
+        Global::EventObject::Instance().RaiseEvent
+                (EVENT_DATALOGGING_ERROR_EVENT_ID_NOT_EXISTS, Global::FmtArgs() << EventID, true);
+    }
+
+    // check for the non active text
+    QString NonActiveEventText = Fields.at(EVENTSTRING_EVENTSTRING);
+    if (FindAndTranslateNonActiveText(NonActiveEventText)) {
+        // append the translated non active text
+        EventData = NonActiveEventText + EventData;
+    }
+
+    // translate the event type
+    QString EventType = Fields.at(EVENTSTRING_EVENTTYPE);
+    TranslateEventType(EventType);
+
+    // join the required data
+    QString ReadData = Fields.at(EVENTSTRING_TIMESTAMP) + STRING_SEMICOLON + EventID
+                       + STRING_SEMICOLON + EventType + STRING_SEMICOLON + EventData + STRING_NEWLINE;
+    Output.append(ReadData.toUtf8());
+    Output.append(STRING_NEWLINE.toUtf8());
+}
+
+/****************************************************************************/
+QString DayLogFileInformation::CacheFileName(const QString &FileName) const {
+    return m_LogFilePath + QDir::separator() + DAILYRUNLOG_CACHE_DIRECTORY + QDir::separator()
+            + QFileInfo(FileName).completeBaseName() + FILEEXTENSION_CACHE;
 }
 
+/****************************************************************************/
+qint64 DayLogFileInformation::LoadCache(const QString &CacheFileName, const char *p_LogData, qint64 LogSize,
+                                        QByteArray &Rendering) {
+    Rendering.clear();
+    QFile CacheFile(CacheFileName);
+    if (!CacheFile.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QByteArray Cache = CacheFile.readAll();
+    CacheFile.close();
+    if (Cache.size() < CACHE_HEADER_SIZE) {
+        return 0;
+    }
+    QDataStream Stream(Cache);
+    Stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 Magic = 0;
+    quint32 Version = 0;
+    quint32 UILanguage = 0;
+    quint32 EventLanguage = 0;
+    qint64 Offset = 0;
+    quint32 Checksum = 0;
+    Stream >> Magic >> Version >> UILanguage >> EventLanguage >> Offset >> Checksum;
+    // the log file must still start with the cached part, the translation must not have changed
+    if ((Magic != CACHE_MAGIC) || (Version != CACHE_VERSION) ||
+        (UILanguage != static_cast<quint32>(Global::UITranslator::TranslatorInstance().GetDefaultLanguage())) ||
+        (EventLanguage != static_cast<quint32>(Global::EventTranslator::TranslatorInstance().GetDefaultLanguage())) ||
+        (Offset <= 0) || (Offset > LogSize) || (Checksum != CacheChecksum(p_LogData, Offset))) {
+        return 0;
+    }
+    Rendering = Cache.mid(CACHE_HEADER_SIZE);
+    return Offset;
+}
+
+/****************************************************************************/
+void DayLogFileInformation::SaveCache(const QString &CacheFileName, const char *p_LogData, qint64 Offset,
+                                      const QByteArray &Rendering) {
+    if (!QDir().mkpath(QFileInfo(CacheFileName).absolutePath())) {
+        return;
+    }
+    QByteArray Cache;
+    QDataStream Stream(&Cache, QIODevice::WriteOnly);
+    Stream.setByteOrder(QDataStream::LittleEndian);
+    Stream << CACHE_MAGIC << CACHE_VERSION
+           << static_cast<quint32>(Global::UITranslator::TranslatorInstance().GetDefaultLanguage())
+           << static_cast<quint32>(Global::EventTranslator::TranslatorInstance().GetDefaultLanguage())
+           << Offset << CacheChecksum(p_LogData, Offset);
+    Cache.append(Rendering);
+
+    // a reader never sees a partial cache, a lost cache is only rendered again
+    QString TempFileName = CacheFileName + ".tmp";
+    QFile CacheFile(TempFileName);
+    if (!CacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || (CacheFile.write(Cache) != Cache.size())) {
+        CacheFile.close();
+        (void)QFile::remove(TempFileName);
+        return;
+    }
+    CacheFile.close();
+    (void)QFile::remove(CacheFileName);
+    (void)QFile::rename(TempFileName, CacheFileName);
+}
 
 /****************************************************************************/
 void DayLogFileInformation::TranslateTheParameters(const quint32 EventID,
@@ -305,38 +464,20 @@ bool DayLogFileInformation::CheckAndTranslateTheEventID(const QString &Translate
 
 /****************************************************************************/
 void DayLogFileInformation::TranslateEventType(const QString &TranslatedString) {
-    // translate the event type also
-    QStringList EventTypeList;
-    QList<quint32> EventTypeIDList;
     QString EventType;
 
-    // first store all the events in the string list
-    EventTypeList << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English,Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_UNDEFINED)
-                  << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English,Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_FATAL_ERROR)
-                  << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English,Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_ERROR)
-                  << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English,Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_WARNING)
-                  << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English,Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_INFO)
-                  << Global::EventTranslator::TranslatorInstance().TranslateToLanguage(QLocale::English,Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_DEBUG);
-    // store all the event Ids in the list
-    EventTypeIDList << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_UNDEFINED
-                    << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_FATAL_ERROR
-                    << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_ERROR
-                    << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_WARNING
-                    << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_INFO
-                    << Global::EVENT_GLOBAL_STRING_ID_EVTTYPE_DEBUG;
-
     // check the event type exist in the list- if it available then translate it
-    if (EventTypeList.contains(TranslatedString)) {
-        qint32 Index = EventTypeList.indexOf(TranslatedString);
-        EventType = Global::EventTranslator::TranslatorInstance().Translate(EventTypeIDList.value(Index));
-        QString Value = "\"" + QString::number(EventTypeIDList.value(Index)) +"\":";
+    qint32 Index = m_EventTypeNames.indexOf(TranslatedString);
+    if (Index >= 0) {
+        EventType = Global::EventTranslator::TranslatorInstance().Translate(m_EventTypeIDs.value(Index));
+        QString Value = "\"" + QString::number(m_EventTypeIDs.value(Index)) +"\":";
         // did not find the event type in the translator
         if (EventType.isEmpty() || EventType.contains(TRANSLATE_RETURN_VALUE_1) ||
               EventType.compare(Value) == 0 ||
-              EventType.compare(QString::number(EventTypeIDList.value(Index))) == 0) {
+              EventType.compare(QString::number(m_EventTypeIDs.value(Index))) == 0) {
             Global::EventObject::Instance().RaiseEvent
                     (EVENT_DATALOGGING_ERROR_EVENT_ID_NOT_EXISTS,
-                     Global::FmtArgs() << EventTypeIDList.value(Index), true);
+                     Global::FmtArgs() << m_EventTypeIDs.value(Index), true);
             // event ID does not exist, so we will keep the same string
             return;
         }
@@ -354,11 +495,12 @@ void DayLogFileInformation::TranslateEventType(const QString &TranslatedString)
 bool DayLogFileInformation::FindAndTranslateNonActiveText(const QString &TranslatedString) {
 
     // check the starting value
-    foreach (quint32 EventIdValue, m_ListOfEventIds) {
+    for (int Counter = 0; Counter < m_ListOfEventIds.count(); Counter++) {
+        quint32 EventIdValue = m_ListOfEventIds.at(Counter);
         QString Value = "\"" + QString::number(EventIdValue) +"\":";
 
         // get the english text
-        QString NonActiveEventText = Global::EventTranslator::TranslatorInstance().Translate(EventIdValue);
+        const QString &NonActiveEventText = m_NonActiveTexts.at(Counter);
 
         if (!NonActiveEventText.isEmpty() && TranslatedString.startsWith(NonActiveEventText)) {
             // get the tranlsated text for the current language
@@ -377,13 +519,13 @@ bool DayLogFileInformation::FindAndTranslateNonActiveText(const QString &Transla
 
             // if the string consists of "User acknowleged by pressing button" then string needs to append the
             // button value to the string
-            if (Global::EventTranslator::TranslatorInstance().Translate(
-                        Global::EVENT_GLOBAL_STRING_ID_ACKNOWLEDGED).compare(NonActiveEventText) == 0) {
+            if (EventIdValue == Global::EVENT_GLOBAL_STRING_ID_ACKNOWLEDGED) {
                 QString ButtonValue = TranslatedString.mid(NonActiveEventText.length()).trimmed().split(DELIMITER_COLON).value(0);
                 // check the starting value
-                foreach (quint32 BtnEventIdValue, m_ListOfBtnEventIds) {
+                for (int BtnCounter = 0; BtnCounter < m_ListOfBtnEventIds.count(); BtnCounter++) {
+                    quint32 BtnEventIdValue = m_ListOfBtnEventIds.at(BtnCounter);
                     // get the english string for the button value
-                    QString BtnName = Global::EventTranslator::TranslatorInstance().Translate(BtnEventIdValue);
+                    const QString &BtnName = m_BtnNames.at(BtnCounter);
                     if (BtnName.compare(ButtonValue) == 0) {
                         QString Value = "\"" + QString::number(EventIdValue) +"\":";
                         QString TranlatedButtonText = Global::UITranslator::TranslatorInstance().
@@ -437,6 +579,14 @@ void DayLogFileInformation::CreateAndListDailyRunLogFileName(const QStringList &
 
 
     qSort(ListOfFile.begin(), ListOfFile.end(), qGreater<QString>());
+
+    // remove the caches of the log files which were removed
+    QDir CacheDirectory(m_LogFilePath + QDir::separator() + DAILYRUNLOG_CACHE_DIRECTORY);
+    foreach (const QString &CacheName, CacheDirectory.entryList(QStringList() << (m_FileNamePrefix + MULTIPLECACHEFILES))) {
+        if (!LogDirectory.exists(QFileInfo(CacheName).completeBaseName() + FILEEXTENSION_LOG)) {
+            (void)CacheDirectory.remove(CacheName);
+        }
+    }
 }
 
 
@@ -8,6 +8,7 @@ SUBDIRS     =   TestBaseLogger.pro
 SUBDIRS  +=   TestBaseLoggerReusable.pro
 SUBDIRS  +=   TestDayOperationLoggerConfig.pro
 SUBDIRS  +=   TestDayOperationEntry.pro
+SUBDIRS  +=   TestDayEventRecord.pro
 SUBDIRS  +=   TestEventFilter.pro
 SUBDIRS  +=   TestDayLogFileInformation.pro
 SUBDIRS  +=   TestEventFilterNetworkServer.pro
@@ -0,0 +1,172 @@
+/****************************************************************************/
+/*! \file TestDayEventRecord.cpp
+ *
+ *  \brief Implementation file for class TestDayEventRecord.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <DataLogging/Include/DayEventRecord.h>
+#include <Global/Include/AdjustedTime.h>
+
+namespace DataLogging {
+
+/****************************************************************************/
+/**
+ * \brief Test class for DayEventRecord class.
+ */
+/****************************************************************************/
+class TestDayEventRecord : public QObject {
+    Q_OBJECT
+private:
+    /****************************************************************************/
+    /**
+     * \brief Create an entry with all encoded fields set.
+     *
+     * \return  Entry.
+     */
+    /****************************************************************************/
+    DayEventEntry CreateEntry() const;
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Test encoding and decoding of the file header.
+     */
+    /****************************************************************************/
+    void utHeader();
+    /****************************************************************************/
+    /**
+     * \brief Test encoding and decoding of an entry.
+     */
+    /****************************************************************************/
+    void utRoundTrip();
+    /****************************************************************************/
+    /**
+     * \brief Test that truncated and damaged records are rejected.
+     */
+    /****************************************************************************/
+    void utDamagedRecord();
+}; // end class TestDayEventRecord
+
+/****************************************************************************/
+DayEventEntry TestDayEventRecord::CreateEntry() const {
+    Global::tTranslatableStringList Arguments;
+    Arguments << "Plain" << Global::TranslatableString(42, Global::tTranslatableStringList() << "Nested" << 7u);
+
+    DayEventEntry Entry;
+    Entry.SetDateTime(QDateTime(QDate(2026, 10, 17), QTime(12, 34, 56, 789)));
+    Entry.SetEventCode(0x01020304);
+    Entry.SetEventKey(1234);
+    Entry.SetStringID(5678);
+    Entry.SetEventType(Global::EVTTYPE_ERROR);
+    Entry.SetAltStringUsage(Global::LOGGING);
+    Entry.SetAckValue(NetCommands::CANCEL_BUTTON);
+    Entry.SetEventStatus(true);
+    Entry.SetShowInRunLogStatus(true);
+    Entry.SetEventName("Event_Name_\xc3\xa4");
+    Entry.SetString(Arguments);
+    return Entry;
+}
+
+/****************************************************************************/
+void TestDayEventRecord::utHeader() {
+    DayEventRecordHeader Header;
+    Header.FormatVersion = 1;
+    Header.FileName = "Leica_ST_1234_20261017";
+    Header.TimeStamp = "2026-10-17 12:00:00.000";
+    Header.OperatingMode = "production";
+    Header.SerialNumber = "1234";
+    Header.SWVersion = "1.0";
+
+    QByteArray Data;
+    DayEventRecord::EncodeHeader(Header, Data);
+
+    DayEventRecordHeader Decoded;
+    int Offset = -1;
+    QVERIFY(DayEventRecord::DecodeHeader(Data, Offset, Decoded));
+    QCOMPARE(Offset, Data.size());
+    QCOMPARE(Decoded.FormatVersion, Header.FormatVersion);
+    QCOMPARE(Decoded.FileName, Header.FileName);
+    QCOMPARE(Decoded.TimeStamp, Header.TimeStamp);
+    QCOMPARE(Decoded.OperatingMode, Header.OperatingMode);
+    QCOMPARE(Decoded.SerialNumber, Header.SerialNumber);
+    QCOMPARE(Decoded.SWVersion, Header.SWVersion);
+
+    // text log files are no record files
+    QVERIFY(!DayEventRecord::DecodeHeader(QByteArray("Format Version: 1\n\n"), Offset, Decoded));
+}
+
+/****************************************************************************/
+void TestDayEventRecord::utRoundTrip() {
+    DayEventEntry Entry = CreateEntry();
+    QByteArray Data;
+    QVERIFY(DayEventRecord::Encode(Entry, Data));
+    QVERIFY(DayEventRecord::Encode(Entry, Data));
+
+    int Offset = 0;
+    DayEventEntry Decoded;
+    QVERIFY(DayEventRecord::Decode(Data, Offset, Decoded));
+    QCOMPARE(Offset, Data.size() / 2);
+    QVERIFY(DayEventRecord::Decode(Data, Offset, Decoded));
+    QCOMPARE(Offset, Data.size());
+    QVERIFY(!DayEventRecord::Decode(Data, Offset, Decoded));
+
+    QCOMPARE(Decoded.GetTimeStamp(), Entry.GetTimeStamp());
+    QCOMPARE(Decoded.GetEventCode(), Entry.GetEventCode());
+    QCOMPARE(Decoded.GetEventKey(), Entry.GetEventKey());
+    QCOMPARE(Decoded.GetStringID(), Entry.GetStringID());
+    QCOMPARE(Decoded.GetEventType(), Entry.GetEventType());
+    QCOMPARE(Decoded.GetAltStringUsageType(), Entry.GetAltStringUsageType());
+    QCOMPARE(Decoded.GetAckValue(), Entry.GetAckValue());
+    QCOMPARE(Decoded.IsEventActive(), true);
+    QCOMPARE(Decoded.GetShowInRunLogStatus(), true);
+    QCOMPARE(Decoded.GetEventName(), Entry.GetEventName());
+
+    const Global::tTranslatableStringList &Arguments = Decoded.GetString();
+    QCOMPARE(Arguments.count(), 2);
+    QVERIFY(Arguments.at(0).IsString());
+    QCOMPARE(Arguments.at(0).GetString(), QString("Plain"));
+    QVERIFY(!Arguments.at(1).IsString());
+    QCOMPARE(Arguments.at(1).GetStringID(), 42u);
+    QCOMPARE(Arguments.at(1).GetArgumentList().count(), 2);
+    QCOMPARE(Arguments.at(1).GetArgumentList().at(0).GetString(), QString("Nested"));
+    QCOMPARE(Arguments.at(1).GetArgumentList().at(1).GetStringID(), 7u);
+}
+
+/****************************************************************************/
+void TestDayEventRecord::utDamagedRecord() {
+    QByteArray Data;
+    QVERIFY(DayEventRecord::Encode(CreateEntry(), Data));
+    DayEventEntry Decoded;
+
+    // record torn by a power fail
+    for (int Size = 0; Size < Data.size(); Size++) {
+        int Offset = 0;
+        QVERIFY(!DayEventRecord::Decode(Data.left(Size), Offset, Decoded));
+        QCOMPARE(Offset, 0);
+    }
+
+    // damaged payload
+    QByteArray Damaged = Data;
+    Damaged[Damaged.size() - 1] = Damaged.at(Damaged.size() - 1) ^ 0x55;
+    int Offset = 0;
+    QVERIFY(!DayEventRecord::Decode(Damaged, Offset, Decoded));
+}
+
+} // end namespace DataLogging
+
+QTEST_MAIN(DataLogging::TestDayEventRecord)
+
+#include "TestDayEventRecord.moc"
@@ -0,0 +1,18 @@
+!include("DataLogging.pri") {
+    error("DataLogging.pri not found")
+}
+
+# we create applications
+TEMPLATE = app
+TARGET = utTestDayEventRecord
+
+SOURCES += TestDayEventRecord.cpp
+
+
+UseLibs(DataLogging EventHandler Global)
+
+# include pri file from Master/Test
+
+!include("../../../Test/Platform.pri") {
+    error("../../../Test/Platform.pri not found")
+}
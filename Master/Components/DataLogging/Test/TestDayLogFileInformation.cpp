@@ -95,6 +95,13 @@ private slots:
      */
     /****************************************************************************/
     void utCheckTranslations();
+
+    /****************************************************************************/
+    /**
+     * \brief Test the cached rendering of the log files.
+     */
+    /****************************************************************************/
+    void utCachedRendering();
 }; // end class TestDayLogFileInformation
 
 /****************************************************************************/
@@ -113,6 +120,9 @@ void TestDayLogFileInformation::cleanup() {
 
 /****************************************************************************/
 void TestDayLogFileInformation::cleanupTestCase() {
+    // the caches created by the tests
+    QDir("../Logfiles/DailyRunCache").removeRecursively();
+    QDir(QDir::tempPath() + "/utTestDayLogFileInformation").removeRecursively();
 }
 
 /****************************************************************************/
@@ -198,6 +208,69 @@ void TestDayLogFileInformation::utCheckTranslations() {
     QCOMPARE(TestString, QString("UndefinedType"));
 }
 
+/****************************************************************************/
+void TestDayLogFileInformation::utCachedRendering() {
+    QString Path = QDir::tempPath() + "/utTestDayLogFileInformation";
+    QString LogFileName = Path + "/ColoradoEvents_1234_20120812.log";
+    QDir(Path).removeRecursively();
+    QVERIFY(QDir().mkpath(Path));
+    QVERIFY(QFile::copy("../Logfiles/ColoradoEvents_1234_20120812.log", LogFileName));
+    DayLogFileInformation DayLogFileData(Path, Path, "ColoradoEvents_");
+    QString CacheFileName = DayLogFileData.CacheFileName(LogFileName);
+
+    // the first rendering creates the cache, the second one uses it
+    QByteArray First;
+    DayLogFileData.ReadAndTranslateTheFile(LogFileName, First);
+    QVERIFY(First.startsWith("Format Version: 1"));
+    QVERIFY(First.contains("FileName: DailyRunLog_20120812"));
+    QVERIFY(QFile::exists(CacheFileName));
+    QByteArray Cached;
+    DayLogFileData.ReadAndTranslateTheFile(LogFileName, Cached);
+    QCOMPARE(Cached, First);
+
+    // the current day is scanned from the end of the cached part on, a line still being written is shown
+    QFile LogFile(LogFileName);
+    QVERIFY(LogFile.open(QIODevice::Append));
+    QVERIFY(LogFile.write("2012-08-12 23:00:00.000;16908303;Info;Starting master state machine.;;true;Colorado master thread\n\n"
+                          "2012-08-12 23:00:01.000;16908303;Info;Not logged for the user.;;false;Colorado master thread\n\n"
+                          "2012-08-12 23:00:02.000;16908303;Info;Starting master state machine.;;true;Colorado") > 0);
+    LogFile.close();
+    QByteArray Incremental;
+    DayLogFileData.ReadAndTranslateTheFile(LogFileName, Incremental);
+    QVERIFY(Incremental.startsWith(First));
+    QVERIFY(Incremental.contains("2012-08-12 23:00:00.000;16908303;"));
+    QVERIFY(!Incremental.contains("2012-08-12 23:00:01.000"));
+    QVERIFY(Incremental.contains("2012-08-12 23:00:02.000;16908303;"));
+    QVERIFY(QFile::remove(CacheFileName));
+    QByteArray Full;
+    DayLogFileData.ReadAndTranslateTheFile(LogFileName, Full);
+    QCOMPARE(Incremental, Full);
+
+    // a rewritten log file is scanned again
+    QVERIFY(LogFile.open(QIODevice::ReadOnly));
+    QByteArray Start = LogFile.read(First.size() / 2);
+    LogFile.close();
+    Start.truncate(Start.lastIndexOf('\n') + 1);
+    QVERIFY(LogFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(LogFile.write(Start), static_cast<qint64>(Start.size()));
+    LogFile.close();
+    QByteArray Rewritten;
+    DayLogFileData.ReadAndTranslateTheFile(LogFileName, Rewritten);
+    QVERIFY(Rewritten.size() < Full.size());
+    QVERIFY(QFile::remove(CacheFileName));
+    QByteArray Uncached;
+    DayLogFileData.ReadAndTranslateTheFile(LogFileName, Uncached);
+    QCOMPARE(Rewritten, Uncached);
+
+    // the cache of a removed log file is removed
+    QVERIFY(QFile::exists(CacheFileName));
+    QVERIFY(QFile::remove(LogFileName));
+    QStringList FileNames;
+    DayLogFileData.CreateAndListDailyRunLogFileName(FileNames);
+    QCOMPARE(FileNames.count(), 0);
+    QVERIFY(!QFile::exists(CacheFileName));
+}
+
 } // end namespace DataLogging
 
 QTEST_MAIN(DataLogging::TestDayLogFileInformation)
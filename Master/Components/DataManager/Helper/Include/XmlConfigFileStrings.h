@@ -112,6 +112,23 @@ public:
      */
     /****************************************************************************/
     void ReadStrings(const QString &FileName, QSet<QLocale::Language> &rLanguageList);
+    /****************************************************************************/
+    /**
+     * \brief Read the strings of one language as string catalog.
+     *
+     * Maps the catalog compiled from the file. If there is none or the file
+     * changed, the strings are read from the file and compiled into a new
+     * catalog. If the catalog cannot be written, false is returned and the
+     * strings read are available by Data().
+     *
+     * \iparam       FileName    File from which configuration is to be read.
+     * \iparam       Language    Language to read.
+     * \oparam       rCatalog    Catalog, open on success.
+     *
+     * \return  True if rCatalog is open.
+     */
+    /****************************************************************************/
+    bool ReadStringCatalog(const QString &FileName, QLocale::Language Language, Global::BinaryCatalog &rCatalog);
 }; // end class XmlConfigFileStrings
 
 } // end namespace DataManager
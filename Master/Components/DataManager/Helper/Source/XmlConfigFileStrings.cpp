@@ -114,4 +114,25 @@ void XmlConfigFileStrings::ReadStrings(const QString &FileName, QSet<QLocale::La
 
 }
 
+/****************************************************************************/
+bool XmlConfigFileStrings::ReadStringCatalog(const QString &FileName, QLocale::Language Language,
+                                             Global::BinaryCatalog &rCatalog) {
+    QString CatalogFileName = Global::BinaryCatalog::CatalogFileName(FileName);
+    if (rCatalog.Open(CatalogFileName, Global::BinaryCatalog::FORMAT_STRINGS, FileName)) {
+        return true;
+    }
+    // no catalog yet or an outdated one: compile a new one
+    QSet<QLocale::Language> LanguageList;
+    LanguageList << Language;
+    ReadStrings(FileName, LanguageList);
+    const Global::tLanguageData LanguageData = m_Data.value(Language);
+    QHash<quint32, QByteArray> Records;
+    for (Global::tLanguageData::const_iterator it = LanguageData.constBegin(); it != LanguageData.constEnd(); ++it) {
+        Records.insert(it.key(), Global::BinaryCatalog::EncodeStrings(it.value()));
+    }
+    return m_Data.contains(Language) &&
+           Global::BinaryCatalog::Compile(CatalogFileName, Global::BinaryCatalog::FORMAT_STRINGS, FileName, Records) &&
+           rCatalog.Open(CatalogFileName, Global::BinaryCatalog::FORMAT_STRINGS, FileName);
+}
+
 } // end namespace DataManager
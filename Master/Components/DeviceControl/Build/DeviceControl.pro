@@ -30,6 +30,7 @@ SOURCES +=  ../Source/CanCommunication/*.cpp \
             ../Source/Devices/*.cpp \
             ../Source/Interface/*.cpp \
             ../Source/Simulation/*.cpp \
+            ../Source/Global/*.cpp \
             ../hwconfig/*.cpp \
 
 #    DeviceModuleModel.cpp
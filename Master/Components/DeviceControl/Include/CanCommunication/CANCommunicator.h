@@ -25,8 +25,6 @@
 #ifndef CANCOMMUNICATOR_H
 #define CANCOMMUNICATOR_H
 
-#include <map>
-#include <deque>
 #include <QMutex>
 #include <QObject>
 #include <QDateTime>
@@ -36,20 +34,17 @@
 #include <linux/can/raw.h>
 
 #include "DeviceControl/Include/CanCommunication/CANInterface.h"
+#include "DeviceControl/Include/CanCommunication/CANThreads.h"
+#include "DeviceControl/Include/CanCommunication/COBDispatchTable.h"
+#include "DeviceControl/Include/CanCommunication/CANTransmitRing.h"
 #include "DeviceControl/Include/Global/DeviceControlGlobal.h"
 #include "Global/Include/AdjustedTime.h"
 
 namespace DeviceControl
 {
 
-class CANReceiveThread;
-class CANTransmitThread;
 class CModule;
-
-//! Type definition of a map containing the CAN-message receiving objects
-typedef std::map <__u32, CModule*> COBConsumerMap;
-//! CAN message queue type definition, used as receive and transmit queue (double ended queue)
-typedef std::deque <can_frame> COBDeque;
+class CTaskScheduler;
 
 /****************************************************************************/
 /*!
@@ -81,6 +76,37 @@ public:
     ReturnCode_t StartComm(const char* Interface);
     void StopComm();
 
+    /****************************************************************************/
+    /*!
+     *  \brief  Set the maximum number of frames read by one receive call
+     *
+     *      Must be called before StartComm. 1 selects the frame by frame
+     *      receive mode.
+     *
+     *  \iparam BatchSize = Frames per read, 1 .. CAN_RX_BATCH_SIZE
+     */
+    /****************************************************************************/
+    void SetReceiveBatchSize(int BatchSize) { m_RxBatchSize = BatchSize; }
+
+    CANReceiveStatistics_t GetReceiveStatistics();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Sets the scheduler woken up by received CAN messages
+     *
+     *  \iparam p_Scheduler = Task scheduler of the device processing
+     */
+    /****************************************************************************/
+    void SetScheduler(CTaskScheduler *p_Scheduler) { mp_Scheduler = p_Scheduler; }
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the scheduler woken up by received CAN messages
+     *
+     *  \return Task scheduler of the device processing or NULL
+     */
+    /****************************************************************************/
+    CTaskScheduler *GetScheduler() const { return mp_Scheduler; }
+
     /****************************************************************************/
     /*!
      *  \brief  Report CAN error
@@ -114,11 +140,12 @@ public:
      *  \brief  Definition/Declaration of function SendCOB
      *
      *  \param canmsg = can_frame type parameter
+     *  \param Priority = transmit lane, CAN_TX_PRIO_HIGH is sent ahead of all other messages
      *
      *  \return from SendCOB
      */
     /****************************************************************************/
-    ReturnCode_t SendCOB(can_frame& canmsg);
+    ReturnCode_t SendCOB(can_frame& canmsg, CANTxPriority_t Priority = CAN_TX_PRIO_NORMAL);
 	
     /****************************************************************************/
     /*!
@@ -130,12 +157,25 @@ public:
     bool IsOutMessagePending();
     /****************************************************************************/
     /*!
-     *  \brief  Definition/Declaration of function PopPendingOutMessage
+     *  \brief  Definition/Declaration of function PopPendingOutMessages
+     *
+     *  \param pFrames = buffer for the popped messages
+     *  \param MaxFrames = maximum number of messages to pop
+     *
+     *  \return number of popped messages
+     */
+    /****************************************************************************/
+    int PopPendingOutMessages(can_frame* pFrames, int MaxFrames);
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the maximum depth the transmit queue has reached
+     *
+     *  \param Priority = transmit lane
      *
-     *  \return from PopPendingOutMessage
+     *  \return high water mark of the lane
      */
     /****************************************************************************/
-    can_frame PopPendingOutMessage();
+    int GetTransmitHighWaterMark(CANTxPriority_t Priority) const { return m_SendQueue.GetHighWaterMark(Priority); }
     /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function DispatchMessage
@@ -180,9 +220,12 @@ private:
 
     CANInterface m_CANInterface;    //!< CAN interface class
 
-    COBConsumerMap m_cobMap;    //!< map containing the registered CAN-message IDs of receivable messages
+    COBDispatchTable m_cobTable;    //!< table containing the registered CAN-message IDs of receivable messages
+    int m_RxBatchSize;              //!< maximum number of frames read at once
+    CTaskScheduler *mp_Scheduler;   //!< scheduler woken up by received messages
 
-    COBDeque m_SendQueue;   //!< the send queue for outgoing CAN messages, type tCanMsgStruct
+    CANTransmitRing m_SendQueue;    //!< the send queue for outgoing CAN messages
+    int m_ReportedHighWaterMark;    //!< high water mark last written to the log
 
     //internal error situation
     quint16 m_nErrorState;          ///< error state (new, transmitted, changed,...
@@ -191,8 +234,6 @@ private:
 
     quint8 m_errorUntransmitted;  ///< flag for error forwarding
 
-    QMutex m_mutexCOB;  ///< Access serialisation object
-
 };
 
 } //namespace
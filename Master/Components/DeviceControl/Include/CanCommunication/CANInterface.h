@@ -32,6 +32,9 @@
 namespace DeviceControl
 {
 
+#define CAN_RX_BATCH_SIZE   32  //!< Maximum number of CAN frames read with one system call
+#define CAN_TX_BATCH_SIZE   16  //!< Maximum number of CAN frames written with one system call
+
 /****************************************************************************/
 /*!
  *  \brief CAN interface class
@@ -50,13 +53,19 @@ public:
     void Close();
     //! Write can message to device
     int Write(can_frame &CanMsg);
+    //! Write several can messages to device
+    int WriteBatch(can_frame* pCanMsgs, int Count);
     //! check if msg is ready for reading
     int Ready();
     //! Read can message from device
     int Read(can_frame* canmsg);
+    //! Read all pending can messages from device, up to MaxFrames
+    int ReadBatch(can_frame* pCanMsgs, int MaxFrames);
 
 private:
-    int m_sockCan;  //!< Communication socket
+    int m_sockCan;          //!< Communication socket
+    bool m_MultiMsgRead;    //!< recvmmsg is supported by the kernel
+    bool m_MultiMsgWrite;   //!< sendmmsg is supported by the kernel
 
     /****************************************************************************/
     /*!
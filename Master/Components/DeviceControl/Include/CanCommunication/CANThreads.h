@@ -29,10 +29,13 @@
 #include <linux/can.h>
 
 #include <QMutex>
+#include <QtGlobal>
 #include <QSemaphore>
 #include <QThread>
 #include <QWaitCondition>
 
+#include "DeviceControl/Include/CanCommunication/CANInterface.h"
+
 namespace DeviceControl
 {
 
@@ -40,6 +43,23 @@ namespace DeviceControl
 class CANCommunicator;
 class CANInterface;
 
+#define CAN_RX_STATISTICS_INTERVAL_MS   10000   //!< Interval for logging the receive statistics
+#define CAN_TX_RETRY_DELAY_MS          1       //!< Delay before frames the socket did not accept are written again
+
+/****************************************************************************/
+/*!
+ *  \brief  Receive statistics of the last completed measurement interval
+ */
+/****************************************************************************/
+typedef struct {
+    quint64 FramesTotal;        //!< Frames received since start of the thread
+    quint32 FramesPerSecond;    //!< Received frames per second
+    quint32 ReadsPerSecond;     //!< Read system calls per second
+    quint32 MaxBatchSize;       //!< Maximum number of frames read at once
+    quint32 DispatchAvgUs;      //!< Average time from read to end of dispatch in microseconds
+    quint32 DispatchMaxUs;      //!< Maximum time from read to end of dispatch in microseconds
+} CANReceiveStatistics_t;
+
 /****************************************************************************/
 /*!
  *  \brief  This class implements the CAN receive thread
@@ -59,10 +79,12 @@ private:
     Q_DISABLE_COPY(CANReceiveThread)
 
 public:
-    CANReceiveThread(CANCommunicator* pCANCommunicator, CANInterface & rCANInterface);
+    CANReceiveThread(CANCommunicator* pCANCommunicator, CANInterface & rCANInterface, int BatchSize);
 
     void SetBreak();
 
+    CANReceiveStatistics_t GetStatistics();
+
 signals:
     /****************************************************************************/
     /*!
@@ -77,6 +99,9 @@ signals:
 private:
     void run();
     void LogErrorFrame(can_frame &Frame);
+    void ProcessFrame(can_frame &Frame);
+    void UpdateStatistics(quint64 Now);
+    static quint64 GetTimeNs();
 
 private:
     CANCommunicator*    m_pCANCommunicator;     //!< Communicator object
@@ -84,6 +109,19 @@ private:
     QMutex              m_BreakLock;            //!< Break synchronization
     bool                m_bBreak;               //!< break condition
     can_frame           m_lastErrorFrame;       //!< last received error frame
+    int                 m_BatchSize;            //!< Frames per read, 1 reads frame by frame
+
+    can_frame           m_Frames[CAN_RX_BATCH_SIZE];    //!< Receive buffer
+
+    quint64             m_IntervalStart;        //!< Start of the current measurement interval (ns)
+    quint64             m_FramesTotal;          //!< Frames received since start
+    quint32             m_IntervalFrames;       //!< Frames received in the current interval
+    quint32             m_IntervalReads;        //!< Reads done in the current interval
+    quint32             m_IntervalMaxBatch;     //!< Largest batch in the current interval
+    quint64             m_IntervalDispatchNs;   //!< Accumulated dispatch latency in the current interval
+    quint64             m_IntervalDispatchMaxNs;//!< Maximum dispatch latency in the current interval
+    QMutex              m_StatisticsLock;       //!< Protects m_Statistics
+    CANReceiveStatistics_t m_Statistics;        //!< Statistics of the last interval
 };
 
 
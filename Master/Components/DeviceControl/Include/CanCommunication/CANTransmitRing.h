@@ -0,0 +1,105 @@
+/****************************************************************************/
+/*! \file CANTransmitRing.h
+ *
+ *  \brief
+ *
+ *   Version: $ 0.1
+ *   Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class CANTransmitRing
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef CANTRANSMITRING_H
+#define CANTRANSMITRING_H
+
+#include <QAtomicInt>
+
+#include <linux/can.h>
+
+namespace DeviceControl
+{
+
+#define CAN_TX_RING_SIZE    512     //!< Frames per priority lane, must be a power of two
+
+/****************************************************************************/
+/*!
+ *  \brief  Transmit priority of a CAN message
+ */
+/****************************************************************************/
+typedef enum {
+    CAN_TX_PRIO_HIGH   = 0,     //!< Emergency stop, heartbeat, sent ahead of all other messages
+    CAN_TX_PRIO_NORMAL = 1,     //!< Commands and configuration data
+    CAN_TX_PRIO_COUNT  = 2      //!< Number of priority lanes
+} CANTxPriority_t;
+
+/****************************************************************************/
+/*!
+ *  \brief  Bounded lock-free transmit queue with priority lanes
+ *
+ *      Each lane is a ring of cells carrying a sequence number. Producers
+ *      claim a cell with a single compare-and-swap, so SendCOB stays safe
+ *      when called from more than one thread. The transmit thread is the
+ *      only consumer and drains the lanes in priority order. The order of
+ *      messages within a lane is preserved.
+ */
+/****************************************************************************/
+class CANTransmitRing
+{
+public:
+    CANTransmitRing();
+
+    bool Push(const can_frame &Frame, CANTxPriority_t Priority);
+    int PopBatch(can_frame *pFrames, int MaxFrames);
+    bool IsEmpty() const;
+    int GetDepth(CANTxPriority_t Priority) const;
+    int GetHighWaterMark(CANTxPriority_t Priority) const;
+    quint32 GetRejectedCount() const;
+    void Clear();
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief  Ring cell
+     */
+    /****************************************************************************/
+    struct Cell_t {
+        QAtomicInt Sequence;    //!< Position the cell is ready for
+        can_frame  Frame;       //!< Queued CAN message
+    };
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Priority lane
+     */
+    /****************************************************************************/
+    struct Lane_t {
+        Cell_t      Cells[CAN_TX_RING_SIZE];    //!< Ring storage
+        QAtomicInt  EnqueuePos;                 //!< Next position to write, shared by producers
+        QAtomicInt  DequeuePos;                 //!< Next position to read, consumer only
+        QAtomicInt  HighWaterMark;              //!< Maximum observed depth
+    };
+
+    bool PopLane(Lane_t &rLane, can_frame &rFrame);
+    void UpdateHighWaterMark(Lane_t &rLane, int Depth);
+
+    Lane_t      m_Lanes[CAN_TX_PRIO_COUNT]; //!< Priority lanes, index 0 is drained first
+    QAtomicInt  m_Rejected;                 //!< Messages refused because a lane was full
+
+    Q_DISABLE_COPY(CANTransmitRing)
+};
+
+} //namespace
+
+#endif /* CANTRANSMITRING_H */
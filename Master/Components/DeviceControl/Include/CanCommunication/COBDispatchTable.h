@@ -0,0 +1,109 @@
+/****************************************************************************/
+/*! \file COBDispatchTable.h
+ *
+ *  \brief
+ *
+ *   Version: $ 0.1
+ *   Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class COBDispatchTable
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef COBDISPATCHTABLE_H
+#define COBDISPATCHTABLE_H
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QMutex>
+
+#include <linux/can.h>
+
+#include "DeviceControl/Include/Global/DeviceControlGlobal.h"
+
+namespace DeviceControl
+{
+
+class CModule;
+
+#define COB_DISPATCH_TABLE_SIZE     4096    //!< Number of slots, must be a power of two
+#define COB_DISPATCH_TABLE_MAX_LOAD 3072    //!< Maximum number of registered CAN IDs (75% load)
+
+/****************************************************************************/
+/*!
+ *  \brief  Flat open addressing table mapping CAN IDs to modules
+ *
+ *      The table replaces the std::map lookup on the CAN receive path. It
+ *      uses linear probing over a fixed array, so a lookup normally touches
+ *      a single slot. Slots are never removed, therefore the receive thread
+ *      can read the table without locking while modules register their
+ *      CAN IDs during configuration.
+ */
+/****************************************************************************/
+class COBDispatchTable
+{
+public:
+    COBDispatchTable();
+
+    ReturnCode_t Insert(quint32 CanID, CModule* pModule);
+    CModule* Find(quint32 CanID) const;
+    void Clear();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the number of registered CAN IDs
+     *
+     *  \return Number of registered CAN IDs
+     */
+    /****************************************************************************/
+    int Count() const { return m_Count; }
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief  Slot index of a CAN ID (Fibonacci hashing)
+     *
+     *  \iparam CanID = CAN ID without flags
+     *
+     *  \return First slot to probe
+     */
+    /****************************************************************************/
+    static inline quint32 Hash(quint32 CanID)
+    {
+        return (CanID * 2654435761U) >> 20;
+    }
+
+    //! Marks an unused slot, CAN IDs are masked with CAN_EFF_MASK
+    static const int EMPTY_SLOT = -1;
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Table slot
+     */
+    /****************************************************************************/
+    struct Slot_t {
+        QAtomicInt              Key;        //!< CAN ID, or EMPTY_SLOT
+        QAtomicPointer<CModule> pModule;    //!< Module receiving the CAN message
+    };
+
+    Slot_t  m_Slots[COB_DISPATCH_TABLE_SIZE];   //!< Slot array
+    int     m_Count;                            //!< Number of used slots
+    QMutex  m_InsertLock;                       //!< Serializes writers
+
+    Q_DISABLE_COPY(COBDispatchTable)
+};
+
+} //namespace
+
+#endif /* COBDISPATCHTABLE_H */
@@ -0,0 +1,160 @@
+/****************************************************************************/
+/*! \file ConfigurationSnapshot.h
+ *
+ *  \brief  Definition file for class ConfigurationSnapshot.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class ConfigurationSnapshot
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_CONFIGURATIONSNAPSHOT_H
+#define DEVICECONTROL_CONFIGURATIONSNAPSHOT_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QString>
+
+namespace DeviceControl
+{
+
+class CModuleConfig;
+class BaseDeviceConfiguration;
+
+/****************************************************************************/
+/*!
+ *  \brief  Binary snapshot of a parsed xml configuration file
+ *
+ *      The snapshot is stored next to the xml file. It contains the SHA-1
+ *      hash of the xml file it was made from and a hash of its own data.
+ *      Read fails if the xml file changed, if the snapshot is damaged or if
+ *      it was written in another format, the caller then parses the xml
+ *      file and writes a new snapshot.
+ *
+ *      Increase SNAPSHOT_VERSION whenever a serialized configuration class
+ *      changes.
+ */
+/****************************************************************************/
+class ConfigurationSnapshot
+{
+public:
+    static const quint32 SNAPSHOT_MAGIC = 0x4443534E;      //!< Identifies a snapshot file
+    static const quint32 SNAPSHOT_VERSION = 1;             //!< Version of the serialized data
+    static const int STREAM_VERSION = QDataStream::Qt_4_8; //!< Version of the data streams
+
+    //! Content of a snapshot file
+    typedef enum {
+        FORMAT_HARDWARE     = 1,    //!< HardwareConfiguration
+        FORMAT_CAN_MESSAGES = 2     //!< CANMessageConfiguration
+    } Format_t;
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam SourceFileName = Path of the xml file
+     *  \iparam Format = Content of the snapshot
+     */
+    /****************************************************************************/
+    ConfigurationSnapshot(const QString &SourceFileName, Format_t Format);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Reads the snapshot if it matches the xml file
+     *
+     *  \oparam Data = Serialized configuration
+     *
+     *  \return true if the snapshot is valid
+     */
+    /****************************************************************************/
+    bool Read(QByteArray &Data);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Writes the snapshot of the xml file
+     *
+     *  \iparam Data = Serialized configuration
+     *
+     *  \return true if successful
+     */
+    /****************************************************************************/
+    bool Write(const QByteArray &Data);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the path of the snapshot belonging to an xml file
+     *
+     *  \iparam SourceFileName = Path of the xml file
+     *
+     *  \return Path of the snapshot
+     */
+    /****************************************************************************/
+    static QString SnapshotFileName(const QString &SourceFileName);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Serializes a CAN object configuration
+     *
+     *      The parent is stored by its key.
+     *
+     *  \iparam Stream = Destination
+     *  \iparam Config = CAN node or function module configuration
+     */
+    /****************************************************************************/
+    static void WriteModuleConfig(QDataStream &Stream, const CModuleConfig &Config);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Creates a CAN object configuration from its serialized data
+     *
+     *  \iparam Stream = Source
+     *  \oparam ParentKey = Key of the parent, empty for a CAN node
+     *
+     *  \return The configuration, NULL if the data is invalid
+     */
+    /****************************************************************************/
+    static CModuleConfig *ReadModuleConfig(QDataStream &Stream, QString &ParentKey);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Serializes a device configuration
+     *
+     *  \iparam Stream = Destination
+     *  \iparam Config = Device configuration
+     */
+    /****************************************************************************/
+    static void WriteDeviceConfig(QDataStream &Stream, const BaseDeviceConfiguration &Config);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Creates a device configuration from its serialized data
+     *
+     *  \iparam Stream = Source
+     *
+     *  \return The configuration, NULL if the data is invalid
+     */
+    /****************************************************************************/
+    static BaseDeviceConfiguration *ReadDeviceConfig(QDataStream &Stream);
+
+private:
+    QString  m_SourceFileName;  //!< Path of the xml file
+    Format_t m_Format;          //!< Content of the snapshot
+    QByteArray m_SourceHash;    //!< Hash of the xml file, empty until read
+};
+
+} //namespace
+
+#endif /* DEVICECONTROL_CONFIGURATIONSNAPSHOT_H */
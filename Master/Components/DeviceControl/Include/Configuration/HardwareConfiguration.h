@@ -35,6 +35,8 @@ class QDomElement;
 namespace DeviceControl
 {
 
+class ConfigurationSnapshot;
+
 //! Type definition of list of object configuration objects (data container)
 typedef QMap<QString, CModuleConfig*> CANObjectCfgList;
 
@@ -110,6 +112,25 @@ public:
     void GetLastError(quint16& usErrorID, QString& strErrorInfo);
 
 private:
+    /****************************************************************************/
+    /*!
+     *  \brief  Reads the configuration from the snapshot of the xml file
+     *
+     *  \iparam Snapshot = Snapshot of the hardware specification file
+     *
+     *  \return true if the snapshot was valid and is read
+     */
+    /****************************************************************************/
+    bool ReadSnapshot(ConfigurationSnapshot &Snapshot);
+    /****************************************************************************/
+    /*!
+     *  \brief  Writes the parsed configuration to the snapshot of the xml file
+     *
+     *  \iparam Snapshot = Snapshot of the hardware specification file
+     */
+    /****************************************************************************/
+    void WriteSnapshot(ConfigurationSnapshot &Snapshot) const;
+
     /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function ParseSlaveElement
@@ -0,0 +1,121 @@
+/****************************************************************************/
+/*! \file BootTimeline.h
+ *
+ *  \brief  Definition file for class CBootTimeline.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class CBootTimeline
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_BOOTTIMELINE_H
+#define DEVICECONTROL_BOOTTIMELINE_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Records the time line of the device control start up
+ *
+ *      The device processing starts the time line before it reads the
+ *      configuration and finishes it when all devices are configured. In
+ *      between, the phases of the configuration and the steps of each CAN
+ *      node are marked. Finish writes all marks to the log at once, with the
+ *      time since the start and since the previous mark of the same phase or
+ *      node, so the slowest node and step can be read off directly.
+ *
+ *      Marks outside of a running time line are ignored. All functions are
+ *      called from the device processing thread only.
+ */
+/****************************************************************************/
+class CBootTimeline
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the time line of the device control
+     *
+     *  \return The time line
+     */
+    /****************************************************************************/
+    static CBootTimeline &Instance();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Starts a new time line, discards the marks of a previous one
+     */
+    /****************************************************************************/
+    void Start();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Marks the end of a phase of the device processing
+     *
+     *  \iparam Phase = Name of the phase
+     */
+    /****************************************************************************/
+    void Mark(const QString &Phase);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Marks a configuration step of a CAN node
+     *
+     *  \iparam NodeKey = Key of the CAN node
+     *  \iparam Step = Name of the step
+     */
+    /****************************************************************************/
+    void MarkNode(const QString &NodeKey, const QString &Step);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Writes the time line to the log and stops it
+     */
+    /****************************************************************************/
+    void Finish();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns if the time line is running
+     *
+     *  \return true between Start and Finish
+     */
+    /****************************************************************************/
+    bool IsRunning() const { return m_Running; }
+
+private:
+    //! A mark of the time line
+    typedef struct {
+        QString Source;     //!< Empty for a phase, otherwise the node key
+        QString Step;       //!< Phase or configuration step
+        qint64 Time;        //!< Time since the start [ms]
+    } Entry_t;
+
+    CBootTimeline();
+    void Add(const QString &Source, const QString &Step);
+
+    QElapsedTimer m_Clock;      //!< Clock since the start
+    QList<Entry_t> m_Entries;   //!< Marks in the order they were made
+    bool m_Running;             //!< Between Start and Finish
+};
+
+} //namespace
+
+#endif /* DEVICECONTROL_BOOTTIMELINE_H */
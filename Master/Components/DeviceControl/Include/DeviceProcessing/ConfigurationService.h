@@ -89,7 +89,7 @@ public:
      *  \brief  Restarts the configuration service
      */
     /****************************************************************************/
-    void Restart() { m_MainState = CS_MAIN_STATE_CONFIG_WAIT_CANOBJECTS; }
+    void Restart() { m_MainState = CS_MAIN_STATE_CONFIG_WAIT_CANOBJECTS; m_stateTimer.Trigger(); }
 
     /// Configuration service main state definitions
     typedef enum  {
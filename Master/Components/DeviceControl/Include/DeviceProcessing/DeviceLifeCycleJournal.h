@@ -0,0 +1,168 @@
+/****************************************************************************/
+/*! \file DeviceLifeCycleJournal.h
+ *
+ *  \brief  Definition file for class DeviceLifeCycleJournal.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class DeviceLifeCycleJournal
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_DEVICELIFECYCLEJOURNAL_H
+#define DEVICECONTROL_DEVICELIFECYCLEJOURNAL_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Append-only journal of the life cycle counters
+ *
+ *      The journal starts with a header, followed by records. A DEFINE record
+ *      assigns the next counter ID to a device, part and parameter key, a SET
+ *      record stores the new value of a counter. Each record carries a CRC32
+ *      checksum. Replay stops at the first damaged record, which is what a
+ *      power loss during an append leaves behind, and cuts the file there.
+ *
+ *      Records are collected by AppendDefine and AppendSet and written with a
+ *      single write and fsync by Commit. Compact replaces the journal by one
+ *      holding a DEFINE and a SET record per counter only.
+ */
+/****************************************************************************/
+class DeviceLifeCycleJournal
+{
+public:
+    static const quint32 JOURNAL_MAGIC = 0x444C434A;    //!< Identifies a journal file
+    static const quint32 JOURNAL_VERSION = 1;           //!< Version of the record format
+    static const qint64 COMPACT_SIZE = 64 * 1024;       //!< Size to compact the journal at [bytes]
+
+    //! Keys of a counter
+    typedef struct {
+        QString Device;     //!< Key of the device
+        QString Part;       //!< Key of the part (function module)
+        QString Param;      //!< Key of the parameter
+    } CounterKey_t;
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam FileName = Path of the journal file
+     */
+    /****************************************************************************/
+    explicit DeviceLifeCycleJournal(const QString &FileName);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Reads all counters from the journal
+     *
+     *      A damaged tail is cut off, the counters keep the values of the
+     *      last intact records.
+     *
+     *  \oparam Keys = Keys of the counters, by counter ID
+     *  \oparam Values = Values of the counters, by counter ID
+     *
+     *  \return false if there is no journal or its header is invalid
+     */
+    /****************************************************************************/
+    bool Replay(QList<CounterKey_t> &Keys, QList<quint32> &Values);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Adds a DEFINE record to the next commit
+     *
+     *  \iparam ID = Counter ID, the number of counters defined before
+     *  \iparam Key = Keys of the counter
+     */
+    /****************************************************************************/
+    void AppendDefine(quint16 ID, const CounterKey_t &Key);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Adds a SET record to the next commit
+     *
+     *  \iparam ID = Counter ID
+     *  \iparam Value = New value of the counter
+     */
+    /****************************************************************************/
+    void AppendSet(quint16 ID, quint32 Value);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Appends the pending records to the journal file
+     *
+     *      Returns once the records are on the disk. The pending records are
+     *      discarded in any case; after a failure, the journal has to be
+     *      compacted.
+     *
+     *  \return true if successful
+     */
+    /****************************************************************************/
+    bool Commit();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Replaces the journal by the current values of all counters
+     *
+     *      The new journal is written to a temporary file first and renamed,
+     *      so either the old or the new journal survives a power loss.
+     *      Pending records are discarded.
+     *
+     *  \iparam Keys = Keys of the counters, by counter ID
+     *  \iparam Values = Values of the counters, by counter ID
+     *
+     *  \return true if successful
+     */
+    /****************************************************************************/
+    bool Compact(const QList<CounterKey_t> &Keys, const QList<quint32> &Values);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the size of the journal file
+     *
+     *  \return Size [bytes], 0 if the journal is not written yet
+     */
+    /****************************************************************************/
+    qint64 GetSize() const { return m_Size; }
+
+private:
+    static const int HEADER_SIZE = 8;       //!< Magic and version [bytes]
+    static const int RECORD_OVERHEAD = 7;   //!< Type, length and checksum of a record [bytes]
+
+    //! Type of a record
+    typedef enum {
+        RECORD_DEFINE = 1,  //!< Defines a counter
+        RECORD_SET    = 2   //!< Sets the value of a counter
+    } RecordType_t;
+
+    static QByteArray Header();
+    static void AddRecord(QByteArray &Buffer, RecordType_t Type, const QByteArray &Payload);
+    static QByteArray DefinePayload(quint16 ID, const CounterKey_t &Key);
+    static QByteArray SetPayload(quint16 ID, quint32 Value);
+    static int ReadRecord(const QByteArray &Data, int Position, QList<CounterKey_t> &Keys, QList<quint32> &Values);
+
+    QString m_FileName;     //!< Path of the journal file
+    QByteArray m_Pending;   //!< Records of the next commit
+    qint64 m_Size;          //!< Size of the journal file [bytes]
+};
+
+} //namespace
+
+#endif /* DEVICECONTROL_DEVICELIFECYCLEJOURNAL_H */
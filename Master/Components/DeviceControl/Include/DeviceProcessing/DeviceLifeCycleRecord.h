@@ -25,18 +25,80 @@
 #ifndef DEVICELIFECYCLERECORD_H
 #define DEVICELIFECYCLERECORD_H
 
+#include <QAtomicInt>
+#include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QString>
+#include "DeviceControl/Include/DeviceProcessing/DeviceLifeCycleJournal.h"
 
 namespace DeviceControl
 {
+    class DeviceLifeCycleRecord;
+
     /**
       * \brief PartLifeCycleRecord
+      *
+      * The counters of a part. The values are kept in the counter registry of
+      * the DeviceLifeCycleRecord, the part maps the parameter keys to counter IDs.
+      * Parameters are added from the device processing thread only.
     */
     class PartLifeCycleRecord
     {
     public:
-        QMap<QString, QString> m_ParamMap; //!< param map
+        /**
+         * \brief constructor
+         * \iparam pRecord = record holding the counters
+         * \iparam DeviceKey = key of the device
+         * \iparam PartKey = key of the part
+        */
+        PartLifeCycleRecord(DeviceLifeCycleRecord* pRecord, const QString& DeviceKey, const QString& PartKey);
+
+        /**
+         * \brief Returns if the part has a parameter
+         * \iparam ParamKey = key of the parameter
+         * \return true if the parameter exists
+        */
+        bool Contains(const QString& ParamKey) const { return m_ParamMap.contains(ParamKey); }
+        /**
+         * \brief Returns the value of a parameter
+         * \iparam ParamKey = key of the parameter
+         * \return value, 0 if the parameter does not exist
+        */
+        quint32 GetValue(const QString& ParamKey) const;
+        /**
+         * \brief Sets the value of a parameter, adds the parameter if needed
+         * \iparam ParamKey = key of the parameter
+         * \iparam Value = new value
+        */
+        void SetValue(const QString& ParamKey, quint32 Value);
+        /**
+         * \brief Adds to the value of a parameter, adds the parameter if needed
+         * \iparam ParamKey = key of the parameter
+         * \iparam Delta = amount to add
+         * \return new value
+        */
+        quint32 Increment(const QString& ParamKey, quint32 Delta);
+        /**
+         * \brief Returns the counter ID of a parameter
+         * \iparam ParamKey = key of the parameter
+         * \return counter ID, -1 if the parameter does not exist
+        */
+        int GetCounterID(const QString& ParamKey) const { return m_ParamMap.value(ParamKey, -1); }
+
+        QMap<QString, int> m_ParamMap; //!< counter IDs by parameter key
+
+    private:
+        /**
+         * \brief Returns the counter ID of a parameter, adds the parameter if needed
+         * \iparam ParamKey = key of the parameter
+         * \return counter ID, -1 if the registry is full
+        */
+        int AddParam(const QString& ParamKey);
+
+        DeviceLifeCycleRecord* mp_Record; //!< record holding the counters
+        QString m_DeviceKey; //!< key of the device
+        QString m_PartKey; //!< key of the part
     };
 
     /**
@@ -51,36 +113,118 @@ namespace DeviceControl
 
     /**
       * \brief DeviceLifeCycleRecord
+      *
+      * Registry of the life cycle counters. Each counter has an integer ID, its
+      * value can be read, set and incremented from any thread without locking.
+      * WriteRecord appends the counters changed since the last call to an
+      * append-only journal and compacts the journal when it gets too large.
+      * The XML file is only read if there is no journal yet and is written as
+      * an export when the journal is compacted.
     */
     class DeviceLifeCycleRecord
     {
     public:
+        static const int MAX_COUNTERS = 512; //!< capacity of the counter registry
+
         /**
          * \brief constructor
+         * \iparam Path = directory of the record, the settings directory by default
         */
-        DeviceLifeCycleRecord();
+        explicit DeviceLifeCycleRecord(const QString& Path = QString());
         /**
-         * \brief destructor
+         * \brief destructor, writes the changed counters
         */
         ~DeviceLifeCycleRecord();
 
         /**
-         * \brief ReadRecord
+         * \brief ReadRecord, from the journal or, if there is none, from the XML file
+         * \return true if successful
         */
         bool ReadRecord();
         /**
-         * \brief WriteRecord
+         * \brief WriteRecord, appends the changed counters to the journal
+         * \return true if successful
         */
         bool WriteRecord();
+        /**
+         * \brief Writes all counters to the XML file
+         * \return true if successful
+        */
+        bool ExportXml();
+
+        /**
+         * \brief Returns the ID of a counter, adds the counter if needed
+         * \iparam DeviceKey = key of the device
+         * \iparam PartKey = key of the part
+         * \iparam ParamKey = key of the parameter
+         * \return counter ID, -1 if the registry is full
+        */
+        int RegisterCounter(const QString& DeviceKey, const QString& PartKey, const QString& ParamKey);
+        /**
+         * \brief Returns the value of a counter
+         * \iparam ID = counter ID
+         * \return value, 0 for an invalid ID
+        */
+        quint32 GetValue(int ID) const;
+        /**
+         * \brief Sets the value of a counter
+         * \iparam ID = counter ID
+         * \iparam Value = new value
+        */
+        void SetValue(int ID, quint32 Value);
+        /**
+         * \brief Adds to the value of a counter
+         * \iparam ID = counter ID
+         * \iparam Delta = amount to add
+         * \return new value
+        */
+        quint32 Increment(int ID, quint32 Delta);
+        /**
+         * \brief Returns the number of counters
+         * \return number of counters
+        */
+        int GetCounterCount() const { return m_Count.loadAcquire(); }
 
         QMap<QString, ModuleLifeCycleRecord*> m_ModuleLifeCycleMap; //!< life cycle map
 
     private:
+        /**
+         * \brief Reads the counters from the XML file
+         * \return true if successful
+        */
+        bool ImportXml();
+        /**
+         * \brief Returns a part, creates it if needed
+         * \iparam DeviceKey = key of the device
+         * \iparam PartKey = key of the part
+         * \return the part
+        */
+        PartLifeCycleRecord* GetPart(const QString& DeviceKey, const QString& PartKey);
+        /**
+         * \brief Adds a counter, the caller holds m_Mutex
+         * \iparam Key = keys of the counter
+         * \return counter ID, -1 if the registry is full
+        */
+        int AddCounter(const DeviceLifeCycleJournal::CounterKey_t& Key);
+        /**
+         * \brief Replaces the journal by the values of all counters
+         * \return true if successful
+        */
+        bool Compact();
         /**
          * \brief free object
         */
         void FreeObjects();
+
         QString m_DeviceLifeCycleRecordFileName; //!< life cycle file name
+        DeviceLifeCycleJournal m_Journal; //!< journal of the counters
+        QList<DeviceLifeCycleJournal::CounterKey_t> m_Keys; //!< keys of the counters, by ID
+        QAtomicInt m_Values[MAX_COUNTERS]; //!< values of the counters, by ID
+        QAtomicInt m_Dirty[MAX_COUNTERS]; //!< 1 if the value is not in the journal yet, by ID
+        QAtomicInt m_Count; //!< number of counters
+        int m_Defined; //!< number of counters defined in the journal
+        bool m_CompactPending; //!< the journal has to be rewritten
+        QMutex m_Mutex; //!< serializes adding and writing the counters
     };
 }
 #endif // DEVICELIFECYCLERECORD_H
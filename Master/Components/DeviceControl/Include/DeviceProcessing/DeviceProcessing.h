@@ -39,6 +39,7 @@
 
 #include "DeviceControl/Include/CanCommunication/CANCommunicator.h"
 #include "DeviceControl/Include/DeviceProcessing/DeviceProcTask.h"
+#include "DeviceControl/Include/DeviceProcessing/TaskScheduler.h"
 #include "DeviceControl/Include/Global/DeviceControlGlobal.h"
 #include "DeviceControl/Include/SlaveModules/BaseModule.h"
 #include <QEventLoop>
@@ -320,6 +321,20 @@ public:
     //! Task handling
     void HandleTasks();
 
+    //! Selects polling or event driven scheduling of the modules
+    void SetSchedulerMode(CTaskScheduler::SchedulerMode_t Mode);
+    //! Returns the time until the next call of HandleTasks, -1 for the fixed interval
+    qint64 GetNextTaskInterval() const;
+
+    /*****************************************************************************/
+    /*!
+     *  \brief  Returns the task scheduler
+     *
+     *  \return Scheduler of the modules
+     */
+    /*****************************************************************************/
+    CTaskScheduler &GetScheduler() { return m_Scheduler; }
+
     //! Access to CAN nodes stored at the object tree
     CBaseModule* GetCANNodeFromObjectTree(bool First);
     //! Insert a CANNode into the object tree
@@ -579,7 +594,10 @@ private:
     /****************************************************************************/
     ReturnCode_t ReadProcessSettings();
 
+    CTaskScheduler m_Scheduler;         //!< Decides which modules are run, outlives the CAN threads
     CANCommunicator m_canCommunicator;  //!< CAN bus communication class
+    bool m_SchedulerActive;             //!< The event driven scheduler handled the last pass
+    qint64 m_SchedulerLogTime;          //!< Time the scheduler statistics were logged last
 
     DeviceProcessingMainState_t m_MainState;    //!< The main state of the state machine
 
@@ -770,6 +788,10 @@ private:
      */
     /****************************************************************************/
     void HandleDevicesTask();
+    //! Calls the HandleTasks function of the ready modules and all devices
+    void HandleReadyModulesTask();
+    //! Wakes up all modules, so they are run once by the event driven scheduler
+    void WakeAllModules();
 
     //! CAN message handling
     void HandleCanMessage(can_frame* pCANframe);
@@ -0,0 +1,183 @@
+/****************************************************************************/
+/*! \file TaskScheduler.h
+ *
+ *  \brief  Definition file for class CTaskScheduler.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class CTaskScheduler
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_TASKSCHEDULER_H
+#define DEVICECONTROL_TASKSCHEDULER_H
+
+#include "Global/Include/LatencyHistogram.h"
+#include "Global/Include/TimerWheel.h"
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+
+namespace DeviceControl
+{
+
+class CModule;
+
+/****************************************************************************/
+/*!
+ *  \brief  Decides which modules the device processing thread has to run
+ *
+ *      In polling mode, the device processing runs the HandleTasks function
+ *      of all modules at a fixed interval, as it always did. In event mode,
+ *      a module is only run when it is woken up: by a CAN message received
+ *      for it, by a command requested from it or by a deadline it asked for.
+ *      The deadlines are kept in a timer wheel, so the device processing
+ *      thread sleeps until the next deadline or wake up.
+ *
+ *      In both modes, the time from waking up a module until it is run is
+ *      recorded, to compare the latency of the two modes.
+ *
+ *      Wake may be called from any thread, all other functions only from
+ *      the device processing thread.
+ */
+/****************************************************************************/
+class CTaskScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! Scheduler modes
+    typedef enum {
+        SCHEDULER_POLLING = 0,  //!< All modules are run at a fixed interval
+        SCHEDULER_EVENT   = 1   //!< Only modules woken up are run
+    } SchedulerMode_t;
+
+    //! Reasons to wake up a module
+    typedef enum {
+        WAKE_CAN_RECEIVE = 0,   //!< A CAN message was received for the module
+        WAKE_COMMAND     = 1,   //!< A command was requested from the module
+        WAKE_TIMER       = 2    //!< A deadline expired, the latency is not recorded
+    } WakeReason_t;
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor of the class CTaskScheduler
+     *
+     *  \iparam p_Parent = Parent object
+     */
+    /****************************************************************************/
+    explicit CTaskScheduler(QObject *p_Parent = NULL);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Selects the scheduler mode
+     *
+     *  \iparam Mode = Polling or event mode
+     */
+    /****************************************************************************/
+    void SetMode(SchedulerMode_t Mode);
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the scheduler mode
+     *
+     *  \return Polling or event mode
+     */
+    /****************************************************************************/
+    SchedulerMode_t GetMode() const { return static_cast<SchedulerMode_t>(m_Mode.loadAcquire()); }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the time of the scheduler clock
+     *
+     *  \return Time in ms
+     */
+    /****************************************************************************/
+    qint64 Now() const { return m_Clock.elapsed(); }
+
+    void Wake(CModule *p_Module, WakeReason_t Reason);
+    void WakeAt(CModule *p_Module, qint64 Deadline);
+    void TakeReady(QSet<CModule *> &Ready);
+    void Handled(CModule *p_Module);
+    qint64 NextTimeout(qint64 MaxTimeout) const;
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Marks that the ready modules are dispatched
+     *
+     *      While set, the base modules do not run their function modules,
+     *      because the device processing runs the ready ones itself.
+     *
+     *  \iparam Dispatching = Dispatch running (true) or finished (false)
+     */
+    /****************************************************************************/
+    void SetDispatching(bool Dispatching) { m_Dispatching = Dispatching; }
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns if the ready modules are dispatched
+     *
+     *  \return Dispatch running (true) or not (false)
+     */
+    /****************************************************************************/
+    bool IsDispatching() const { return m_Dispatching; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the wake up latency histogram
+     *
+     *  \iparam Reason = WAKE_CAN_RECEIVE or WAKE_COMMAND
+     *
+     *  \return Histogram of the time from waking up until running a module
+     */
+    /****************************************************************************/
+    const Global::LatencyHistogram &GetLatency(WakeReason_t Reason) const { return m_Latency[Reason == WAKE_COMMAND ? 1 : 0]; }
+    QString GetStatistics() const;
+    void ResetStatistics();
+
+signals:
+    /****************************************************************************/
+    /*!
+     *  \brief  This signal is emitted when a module was woken up in event mode
+     *
+     *      It is emitted once until the ready modules are taken.
+     */
+    /****************************************************************************/
+    void ReportReady();
+
+private:
+    Q_DISABLE_COPY(CTaskScheduler)
+
+    //! Wake up of a module not yet handled
+    typedef struct {
+        qint64 Time;            //!< Time of the first wake up in us
+        WakeReason_t Reason;    //!< Reason of the first wake up
+    } PendingWake_t;
+
+    QElapsedTimer m_Clock;                          //!< Scheduler clock
+    QAtomicInt m_Mode;                              //!< Scheduler mode
+    QAtomicInt m_Signalled;                         //!< ReportReady was emitted, but the modules were not taken
+    bool m_Dispatching;                             //!< The ready modules are dispatched
+    QMutex m_Mutex;                                 //!< Protects the pending wake ups
+    QHash<CModule *, PendingWake_t> m_Pending;      //!< Modules woken up, but not yet handled
+    QHash<CModule *, qint64> m_Deadlines;           //!< Earliest deadline of each module in ms
+    Global::TimerWheel<CModule *> m_Wheel;          //!< Deadlines, obsolete ones are skipped
+    Global::LatencyHistogram m_Latency[2];          //!< Wake up latency for CAN messages and commands
+};
+
+} //namespace DeviceControl
+
+#endif // DEVICECONTROL_TASKSCHEDULER_H
@@ -3,6 +3,7 @@
 
 #include "DeviceControl/Include/DeviceProcessing/DeviceProcessing.h"
 #include "DeviceControl/Include/Devices/BaseDevice.h"
+#include "DeviceControl/Include/Devices/TelemetrySlot.h"
 #include "DeviceControl/Include/Devices/FunctionModuleTaskManager.h"
 
 
@@ -628,7 +629,7 @@ private:
     qint64 m_LastGetPressureTime;                        //!< Last time of getting pressure
     QList<qreal> m_PIDDataList;                          //!< PID parameters list
 
-    qreal m_CurrentTemperatures[AL_TEMP_CTRL_NUM][MAX_SENSOR_PER_TEMP_CTRL];   //!< Current temperature
+    CTelemetrySlot<qreal> m_CurrentTemperatures[AL_TEMP_CTRL_NUM][MAX_SENSOR_PER_TEMP_CTRL];   //!< Latest temperature samples
     qreal m_TargetTemperatures[AL_TEMP_CTRL_NUM];                     //!< Current temperature
     TempCtrlStatus_t m_TargetTempCtrlStatus[AL_TEMP_CTRL_NUM];        //!< Target temperature control status; for verification of action result.
     TempCtrlStatus_t m_CurrentTempCtrlStatus[AL_TEMP_CTRL_NUM];       //!< Current temperature control status
@@ -32,6 +32,7 @@
 #include <Global/Include/Commands/Command.h>
 #include "DeviceControl/Include/SlaveModules/ModuleConfig.h"
 #include <QStateMachine>
+#include <QAtomicInt>
 
 namespace DataManager
 {
@@ -150,6 +151,29 @@ public:
     /*****************************************************************************/
     DeviceProcessing* GetDeviceProcessing() const { return m_pDevProc; }
 
+    /*****************************************************************************/
+    /*!
+     *  \brief  Set the interval of the sensor telemetry sent by the Slaves
+     *
+     *      Takes effect when the device is configured.
+     *
+     *  \iparam Interval = Telemetry interval in ms, 0 = no telemetry
+     */
+    /*****************************************************************************/
+    void SetTelemetryInterval(quint16 Interval) { m_TelemetryInterval = Interval; }
+
+    /*****************************************************************************/
+    /*!
+     *  \brief  Set the max. age of a sensor value returned by the getters
+     *
+     *      If the latest sample of a sensor is older, the getter requests a
+     *      new one from the Slave and waits for it.
+     *
+     *  \iparam MaxAge = Max. age in ms
+     */
+    /*****************************************************************************/
+    void SetTelemetryMaxAge(qint64 MaxAge) { m_TelemetryMaxAge = MaxAge; }
+
     /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function GetFctModInstanceFromKey
@@ -536,6 +560,9 @@ protected:
     PowerState_t m_BaseModuleCurrentState;  ///< The base module's actual current state
     quint16 m_BaseModuleCurrent;            ///< The base module's actual current
     qint64 m_LastSensorCheckTime;           ///< The last check sensor's time(in sec since Epoch)
+    quint16 m_TelemetryInterval;            ///< Interval of the sensor telemetry in ms, 0 = off
+    qint64 m_TelemetryMaxAge;               ///< Max. age of a sensor value before it is requested
+    QAtomicInt m_PendingGetTemp;            ///< Sensor a synchronous temperature request waits for + 1, 0 = none
 
     CServiceState *mp_Service;      //!< Service functionality of the base device
     QMap<QString, CModule *> m_ModuleMap;   //!< Maps keys to Slave module pointers
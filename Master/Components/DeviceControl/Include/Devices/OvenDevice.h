@@ -4,6 +4,7 @@
 
 #include "DeviceControl/Include/DeviceProcessing/DeviceProcessing.h"
 #include "DeviceControl/Include/Devices/BaseDevice.h"
+#include "DeviceControl/Include/Devices/TelemetrySlot.h"
 
 
 namespace DeviceControl
@@ -314,7 +315,7 @@ private:
     CTemperatureControl* m_pTempCtrls[OVEN_TEMP_CTRL_NUM];              //!< Temperature control modules of the device
     CDigitalInput* m_pLidDigitalInput;                                  //!< Digital input function module for the lid
 
-    qreal m_CurrentTemperatures[OVEN_TEMP_CTRL_NUM][MAX_SENSOR_PER_TEMP_CTRL];                    //!< Current temperature
+    CTelemetrySlot<qreal> m_CurrentTemperatures[OVEN_TEMP_CTRL_NUM][MAX_SENSOR_PER_TEMP_CTRL];    //!< Latest temperature samples
     qreal m_TargetTemperatures[OVEN_TEMP_CTRL_NUM];                     //!< Current temperature
     TempCtrlStatus_t m_TargetTempCtrlStatus[OVEN_TEMP_CTRL_NUM];        //!< Target temperature control status; for verification of action result.
     TempCtrlStatus_t m_CurrentTempCtrlStatus[OVEN_TEMP_CTRL_NUM];       //!< Current temperature control status
@@ -3,6 +3,7 @@
 
 #include "DeviceControl/Include/DeviceProcessing/DeviceProcessing.h"
 #include "DeviceControl/Include/Devices/BaseDevice.h"
+#include "DeviceControl/Include/Devices/TelemetrySlot.h"
 #include "DeviceControl/Include/Devices/FunctionModuleTaskManager.h"
 
 
@@ -345,7 +346,7 @@ private:
     CDigitalInput* m_pLockDigitalInput;                               //!< Digital input for lock
     TempCtrlHardwareStatus_t m_HardwareStatus[RT_TEMP_CTRL_NUM];      //!< Hardware status for temperature control modules
 
-    qreal m_CurrentTemperatures[RT_TEMP_CTRL_NUM][MAX_SENSOR_PER_TEMP_CTRL];                  //!< Current temperature
+    CTelemetrySlot<qreal> m_CurrentTemperatures[RT_TEMP_CTRL_NUM][MAX_SENSOR_PER_TEMP_CTRL];  //!< Latest temperature samples
     qreal m_TargetTemperatures[RT_TEMP_CTRL_NUM];                     //!< Current temperature
     TempCtrlStatus_t m_TargetTempCtrlStatus[RT_TEMP_CTRL_NUM];        //!< Target temperature control status; for verification of action result.
     TempCtrlStatus_t m_CurrentTempCtrlStatus[RT_TEMP_CTRL_NUM];       //!< Current temperature control status
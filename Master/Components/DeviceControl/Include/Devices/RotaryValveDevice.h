@@ -3,6 +3,7 @@
 
 #include "DeviceControl/Include/DeviceProcessing/DeviceProcessing.h"
 #include "DeviceControl/Include/Devices/BaseDevice.h"
+#include "DeviceControl/Include/Devices/TelemetrySlot.h"
 #include "DeviceControl/Include/Devices/FunctionModuleTaskManager.h"
 #include <QEventLoop>
 
@@ -646,7 +647,7 @@ private:
     RVPosition_t m_RVCurrentPosition;               //!< Current rotary valve postion
     RVPosition_t m_RVPrevPosition;                  //!< Privious rotary valve postion
     qint32 m_CurrentPosition;                       //!< Current position (stored by asynchronous call)
-    qreal m_CurrentTemperature[MAX_SENSOR_PER_TEMP_CTRL];                     //!< Current temperature
+    CTelemetrySlot<qreal> m_CurrentTemperature[MAX_SENSOR_PER_TEMP_CTRL];     //!< Latest temperature samples
     qreal m_TargetTemperature;                      //!< Current temperature
     TempCtrlStatus_t m_TargetTempCtrlStatus;        //!< Target temperature control status; for verification of action result.
     TempCtrlStatus_t m_CurrentTempCtrlStatus;       //!< Current temperature control status
@@ -0,0 +1,145 @@
+/****************************************************************************/
+/*! \file TelemetrySlot.h
+ *
+ *  \brief  Definition file for class CTelemetrySlot.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class CTelemetrySlot
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_TELEMETRYSLOT_H
+#define DEVICECONTROL_TELEMETRYSLOT_H
+
+#include <QAtomicInt>
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Latest value of a sensor with the time it was received
+ *
+ *      The slot is written by the device processing thread, when a sample
+ *      of the sensor arrives from the Slave, and read by the threads calling
+ *      the getter functions of the devices. It is a sequence lock: the
+ *      writer makes the sequence number odd while it updates the value, a
+ *      reader retries until it copied the value with the same even sequence
+ *      number before and after. Readers never block the writer and never
+ *      wait for a CAN message.
+ *
+ *      There must be only one writer at a time. The value type has to be a
+ *      plain value like qreal or quint16.
+ */
+/****************************************************************************/
+template <typename T>
+class CTelemetrySlot
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor of the class CTelemetrySlot
+     */
+    /****************************************************************************/
+    CTelemetrySlot() : m_Sequence(0), m_Value(T()), m_TimeStamp(0) {}
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Stores a new sample
+     *
+     *  \iparam Value = Sample value
+     *  \iparam TimeStamp = Time the sample was received in ms since Epoch
+     */
+    /****************************************************************************/
+    void Store(T Value, qint64 TimeStamp)
+    {
+        (void)m_Sequence.fetchAndAddOrdered(1);
+        m_Value = Value;
+        m_TimeStamp = TimeStamp;
+        (void)m_Sequence.fetchAndAddOrdered(1);
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Reads the latest sample
+     *
+     *  \oparam Value = Sample value
+     *  \oparam TimeStamp = Time the sample was received in ms since Epoch,
+     *                      0 if there was no sample yet
+     */
+    /****************************************************************************/
+    void Load(T &Value, qint64 &TimeStamp) const
+    {
+        int Sequence;
+        do {
+            // the acquire load keeps the value reads after it, the ordered
+            // read-modify-write keeps them before the second sequence read
+            Sequence = m_Sequence.loadAcquire();
+            Value = m_Value;
+            TimeStamp = m_TimeStamp;
+        } while ((Sequence & 1) != 0 || Sequence != m_Sequence.fetchAndAddOrdered(0));
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Reads the value of the latest sample
+     *
+     *  \return Sample value
+     */
+    /****************************************************************************/
+    T Value() const
+    {
+        T Value;
+        qint64 TimeStamp;
+        Load(Value, TimeStamp);
+        return Value;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the age of the latest sample
+     *
+     *  \iparam Now = Current time in ms since Epoch
+     *
+     *  \return Age in ms, very large if there was no sample yet
+     */
+    /****************************************************************************/
+    qint64 Age(qint64 Now) const
+    {
+        T Value;
+        qint64 TimeStamp;
+        Load(Value, TimeStamp);
+        return Now - TimeStamp;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Discards the latest sample
+     */
+    /****************************************************************************/
+    void Clear() { Store(T(), 0); }
+
+private:
+    Q_DISABLE_COPY(CTelemetrySlot)
+
+    mutable QAtomicInt m_Sequence;  //!< Sequence number, odd while the sample is written
+    volatile T m_Value;             //!< Sample value
+    volatile qint64 m_TimeStamp;    //!< Time the sample was received in ms since Epoch
+};
+
+} //namespace DeviceControl
+
+#endif // DEVICECONTROL_TELEMETRYSLOT_H
@@ -75,6 +75,7 @@ namespace DeviceControl
 #define CAN_NODE_TIMEOUT_INIT                   3000  //!< Timeout initialisation procedure
 #define CAN_NODE_TIMEOUT_CONFIG_RECEIVE         3000  //!< Timeout configuration procedure
 #define CAN_NODE_TIMEOUT_CONFIG_FCT_MODULES     5000  //!< Timeout function module configuration procedure
+#define CAN_NODE_TIMEOUT_CONFIG_IDLE           10000  //!< Timeout until all CAN nodes finished their configuration
 #define CAN_NODE_TIMEOUT_HEARTBEAT_FAILURE      5000  //!< Timeout heartbeat failure
 #define CAN_NODE_TIMEOUT_HEARTBEAT_FAILURE_DBG  60*60*1000  //!< Timeout heartbeat failure (for debug build)
 #define CAN_NODE_TIMEOUT_SETINITOPDATA           500  //!< Timeout setting initial operation data
@@ -71,6 +71,7 @@ typedef enum {
 	ERROR_DCL_PER_DEV_INIT_FCT_ALLOC_FAILED         = 0x004E,  //!< function module allocation failed
 	ERROR_DCL_PER_DEV_CONFIG_CONNECT_FAILED         = 0x004F,  //!< signal slot connect failed
     ERROR_DCL_FORCE_DRAINING_TIMEOUT_BULIDPRESSURE  = 0x0050,
+	DCL_ERR_CANBUS_TX_QUEUE_FULL                    = 0x0051,  //!< A CAN-message was not sent because the transmit queue is full
 	DCL_ERR_DEV_RETORT_TSENSOR1_TEMPERATURE_OVERRANGE          	= 500010201,
 	DCL_ERR_DEV_RETORT_TSENSOR2_TEMPERATURE_OVERRANGE          	= 500010221,
 	DCL_ERR_DEV_RETORT_TSENSOR3_TEMPERATURE_OVERRANGE          	= 500010241,
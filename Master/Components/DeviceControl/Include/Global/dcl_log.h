@@ -51,6 +51,14 @@
  See TLogArea and TLogLevel for defines, you can easily expand them.
   Have fun, Norbert Wiedmann
 
+ Logging is active while the file ./DEBUG exists. The state is cached per
+ area, so a disabled log command costs a single compare. After
+
+   Output2FILE::StartWriter();
+
+ the state follows the ./DEBUG file (inotify), and log entries are queued in
+ a per-thread buffer which is written to the stream by a background thread.
+
  -----------------------------------------------------------*/
 
 
@@ -298,6 +306,10 @@ TLogLevel_t Log<T>::FromString(const std::string& level)
     return llINFO;
 }
 
+#define LOG_AREA_COUNT      16      //!< Size of the area level table, larger than the highest TLogArea_t
+#define LOG_LEVEL_DISABLED  (-1)    //!< Area level if logging is inactive, lower than every TLogLevel_t
+#define LOG_LEVEL_UNKNOWN   (0x7F)  //!< Area level before the logging state was checked the first time
+
 /****************************************************************************/
 /*! \brief This class implements the logging functionality
 */
@@ -307,6 +319,45 @@ class Output2FILE
 public:
     static FILE*& Stream();
     static void Output(const std::string& msg);
+    static void RefreshEnableState();
+    static void StartWriter();
+    static void StopWriter();
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Returns the active logging level of an area
+     *
+     *  \iparam  area = Logging area
+     *
+     *  \return  Highest level written, LOG_LEVEL_DISABLED if logging is inactive
+     *
+     ****************************************************************************/
+    static inline int ActiveLevel(TLogArea_t area)
+    {
+        return AreaLevels()[((unsigned int)area) & (LOG_AREA_COUNT - 1)];
+    }
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief   Returns the cached level table
+     *
+     *      The table is filled by RefreshEnableState(). It is constant
+     *      initialized, so reading it needs no guard.
+     *
+     *  \return  Level per logging area
+     *
+     ****************************************************************************/
+    static inline volatile int* AreaLevels()
+    {
+        static volatile int Levels[LOG_AREA_COUNT] = {
+            LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN,
+            LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN,
+            LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN,
+            LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN, LOG_LEVEL_UNKNOWN
+        };
+        return Levels;
+    }
 };
 
 /****************************************************************************/
@@ -322,41 +373,6 @@ inline FILE*& Output2FILE::Stream()
     return pStream;
 }
 
-/****************************************************************************/
-/*!
- *  \brief   Outputs the string to the logging stream
- *
- *  \param    msg = Logging message string
- *
- ****************************************************************************/
-inline void Output2FILE::Output(const std::string& msg)
-{
-    bool device_log = false;
-    FILE *fp = NULL;
-    if((fp = fopen("./DEBUG", "r")) != NULL)
-    {
-        device_log = true;
-        fclose(fp);
-    }
-
-    if(device_log)
-    {
-        FILE* pStream = Stream();
-        if (!pStream)
-            return;
-        fprintf(pStream, "%s", msg.c_str());
-    /*lint -save -e534 */
-    //ignoring return value of fflush
-        fflush(pStream);
-    }
-/*lint -restore */
-//#else
-//   QString s =  QString(msg.c_str());
-//   //LOG() << s; //disbale the log now, or will get too much information on debug output
-//#endif
-}
-
-
 #define FILELOG_DECLSPEC  //!< obsolete?
 
 //! File logging class instance
@@ -377,7 +393,8 @@ class FILELOG_DECLSPEC FILELog : public Log<Output2FILE> {};
  */
 /****************************************************************************/
 #define FILE_LOG_L(area, level) \
-    if (level > FILELog::ReportingLevel(area) || !Output2FILE::Stream()) ; \
+    if (level > FILELOG_MAX_LEVEL) ;\
+    else if ((int)(level) > Output2FILE::ActiveLevel(area)) ; \
     else FILELog().Get(area, level, "", __FUNCTION__)
 /****************************************************************************/
 /*!
@@ -390,7 +407,7 @@ class FILELOG_DECLSPEC FILELog : public Log<Output2FILE> {};
 /****************************************************************************/
 #define FILE_LOG_L1(area, level, classname) \
     if (level > FILELOG_MAX_LEVEL) ;\
-    else if (level > FILELog::ReportingLevel(area) || !Output2FILE::Stream()) ; \
+    else if ((int)(level) > Output2FILE::ActiveLevel(area)) ; \
     else FILELog().Get(area, level, classname, __FUNCTION__)
 
 #include <sys/time.h>
@@ -108,6 +108,11 @@ public:
     CBaseDevice* GetDevice(quint32 InstanceID);
     //! Return the pointer to the CBaseModule which is next in list
     CBaseModule* GetNode(bool First);
+
+    //! Select polling or event driven scheduling of the modules
+    void SetSchedulerMode(CTaskScheduler::SchedulerMode_t Mode);
+    //! Returns the wake up latency statistics of the scheduler
+    QString GetSchedulerStatistics();
     //Air liquid device funcs
     /****************************************************************************/
     /*!
@@ -266,6 +266,9 @@ public:
     ReturnCode_t SetModuleSerialNumber(quint64 ModuleSerialNumber) const;
 
     static QMap<quint32, std::string> m_EventString;    //!< list with info strings for CAN events
+
+    //! Takes one configuration message from the node's send budget
+    bool TakeConfigMessage();
     /**
       * \brief function is virtual
       * \return bool
@@ -717,6 +720,9 @@ private:
     QByteArray m_UniqueNumber;  //!< Unique number of the slave
     bool m_IsVirtual;
     qint64 m_LastCheckTime;     //!< Last check time
+
+    Global::MonotonicTime m_ConfigBurstTime;    //!< Start of the current configuration burst interval
+    int m_ConfigBurstMessages;                  //!< Configuration messages sent in the current interval
 };
 
 QTextStream& operator<< (QTextStream& s, const NodeState_t &NodeState); //!< convert NodeState_t to string
@@ -27,6 +27,7 @@
 
 #include "DeviceControl/Include/CanCommunication/CANCommunicator.h"
 #include "DeviceControl/Include/Global/DeviceControlGlobal.h"
+#include "DeviceControl/Include/SlaveModules/FirmwareTransfer.h"
 #include <QFile>
 #include <QThread>
 #include <QTimer>
@@ -77,6 +78,16 @@ public:
     /****************************************************************************/
     ReturnCode_t UpdateFirmware(const QString &FirmwarePath);
     /****************************************************************************/
+    /*!
+     *  \brief  Definition/Declaration of function UpdateFirmware
+     *
+     *  \param Image = Firmware image, shared when several nodes are updated
+     *
+     *  \return from UpdateFirmware
+     */
+    /****************************************************************************/
+    ReturnCode_t UpdateFirmware(const QByteArray &Image);
+    /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function UpdateInfo
      *
@@ -215,15 +226,12 @@ private:
     ReturnCode_t SendHeader();
     /****************************************************************************/
     /*!
-     *  \brief  Definition/Declaration of function CalculateCrc
-     *
-     *  \param p_Data =  quint8 type parameter
-     *  \param DataSize =  quint32 type parameter
+     *  \brief  Definition/Declaration of function SendTrailer
      *
-     *  \return from CalculateCrc
+     *  \return from SendTrailer
      */
     /****************************************************************************/
-    quint32 CalculateCrc(const quint8 *p_Data, quint32 DataSize);
+    ReturnCode_t SendTrailer();
     /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function HandleCanMsgUpdateRequired
@@ -313,7 +321,7 @@ private:
 
     DeviceControl::CANCommunicator *mp_CanCommunicator; //!< Communicator object
     CBaseModule *mp_BaseModule;  //!< Base module assigned to the boot loader
-    QFile m_FirmwareImage;  //!< Firmware image file to be programmed
+    CFirmwareTransfer m_Transfer;   //!< Flow control of the image to be programmed
     bool m_UpdateRequired;  //!< Indicates if an update is required or not
     static bool m_WaitForUpdate;   //!< Set to wait for an update
     quint8 m_UpdateType;    //!< Type of updated info (BoardInfo/BootInfo/BoardOptions)
@@ -325,8 +333,6 @@ private:
     QMutex m_Mutex;         //!< Protects handle CAN message function
 
     static const qint32 m_Timeout;              //!< Transaction timeout
-    static const quint32 m_Crc32Polynomial;     //!< CRC32 polynomial
-    static const quint32 m_Crc32InitialValue;   //!< CRC32 start value
 
 private slots:
     /****************************************************************************/
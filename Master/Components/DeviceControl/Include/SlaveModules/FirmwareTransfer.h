@@ -0,0 +1,180 @@
+/****************************************************************************/
+/*! \file FirmwareTransfer.h
+ *
+ *  \brief  Definition file for class CFirmwareTransfer.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class CFirmwareTransfer
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_FIRMWARETRANSFER_H
+#define DEVICECONTROL_FIRMWARETRANSFER_H
+
+#include <QByteArray>
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Flow control of a firmware image download to a Slave
+ *
+ *      The image is split into data frames of up to eight bytes. Without a
+ *      window, two frames are in flight and each frame is acknowledged by
+ *      the Slave. With a window, up to Window frames are in flight. The Slave
+ *      acknowledges blocks of frames with the number of bytes received and
+ *      the CRC over these bytes, which is checked against the CRC calculated
+ *      here while sending. The CRC of the complete image is therefore known
+ *      at the end of the transfer without reading the image again.
+ *
+ *      The class does not send CAN messages itself, so it can be used in
+ *      host based tests.
+ */
+/****************************************************************************/
+class CFirmwareTransfer
+{
+public:
+    static const quint8 m_FrameSize = 8;    //!< Image bytes per data frame
+    static const quint8 m_MaxWindow = 16;   //!< Max. window size supported by the Slaves
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor of the class CFirmwareTransfer
+     */
+    /****************************************************************************/
+    CFirmwareTransfer();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Starts a new transfer
+     *
+     *  \iparam Image = Firmware image
+     *  \iparam Window = Window size in frames, 0 = acknowledge each frame
+     */
+    /****************************************************************************/
+    void Start(const QByteArray &Image, quint8 Window);
+    /****************************************************************************/
+    /*!
+     *  \brief  Sets the window size granted by the Slave, before the first frame is sent
+     *
+     *  \iparam Window = Window size in frames, 0 = acknowledge each frame
+     */
+    /****************************************************************************/
+    void SetWindow(quint8 Window);
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the window size
+     *
+     *  \return Window size in frames, 0 = acknowledge each frame
+     */
+    /****************************************************************************/
+    quint8 GetWindow() const { return m_Window; }
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the size of the image
+     *
+     *  \return Image size in bytes
+     */
+    /****************************************************************************/
+    quint32 GetSize() const { return m_Image.size(); }
+    /****************************************************************************/
+    /*!
+     *  \brief  Fetches the next data frame, if the window allows to send it
+     *
+     *  \oparam p_Data = Buffer of at least m_FrameSize bytes
+     *  \oparam Length = Number of data bytes in the frame
+     *  \oparam Odd = Flow control count of the frame (Data0 or Data1)
+     *
+     *  \return true if a frame is to be sent
+     */
+    /****************************************************************************/
+    bool NextFrame(quint8 *p_Data, quint8 &Length, bool &Odd);
+    /****************************************************************************/
+    /*!
+     *  \brief  Handles the acknowledge of a single frame (no window)
+     *
+     *  \return false if no frame is outstanding
+     */
+    /****************************************************************************/
+    bool Acknowledge();
+    /****************************************************************************/
+    /*!
+     *  \brief  Handles the acknowledge of a block of frames (window)
+     *
+     *  \iparam Count = Number of bytes received by the Slave
+     *  \iparam Crc = CRC of the bytes received by the Slave
+     *
+     *  \return false if the count or the CRC does not match the sent data
+     */
+    /****************************************************************************/
+    bool Acknowledge(quint32 Count, quint32 Crc);
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns if the complete image was acknowledged
+     *
+     *  \return Finished (true) or not (false)
+     */
+    /****************************************************************************/
+    bool Finished() const { return m_Acked == GetSize(); }
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the CRC of the data sent so far
+     *
+     *  \return CRC32 checksum, the image CRC when all frames are sent
+     */
+    /****************************************************************************/
+    quint32 GetCrc() const { return m_Crc ^ m_Crc32InitialValue; }
+    /****************************************************************************/
+    /*!
+     *  \brief  Calculates a CRC32 checksum
+     *
+     *  \iparam p_Data = Data block to be checked
+     *  \iparam DataSize = Size of the data block
+     *
+     *  \return CRC32 checksum
+     */
+    /****************************************************************************/
+    static quint32 CalculateCrc(const quint8 *p_Data, quint32 DataSize);
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief  Adds a data block to a CRC32 remainder
+     *
+     *  \iparam Crc = CRC32 remainder
+     *  \iparam p_Data = Data block
+     *  \iparam DataSize = Size of the data block
+     *
+     *  \return New CRC32 remainder
+     */
+    /****************************************************************************/
+    static quint32 UpdateCrc(quint32 Crc, const quint8 *p_Data, quint32 DataSize);
+
+    QByteArray m_Image;     //!< Firmware image
+    quint8 m_Window;        //!< Window size in frames, 0 = acknowledge each frame
+    quint32 m_Sent;         //!< Number of bytes sent
+    quint32 m_Acked;        //!< Number of bytes acknowledged
+    quint32 m_Crc;          //!< CRC32 remainder of the bytes sent
+    quint32 m_FrameCrc[m_MaxWindow];    //!< CRC after each frame in flight, by frame number
+
+    static const quint32 m_Crc32Polynomial;     //!< CRC32 polynomial
+    static const quint32 m_Crc32InitialValue;   //!< CRC32 start value
+};
+
+} //namespace DeviceControl
+
+#endif // DEVICECONTROL_FIRMWARETRANSFER_H
@@ -0,0 +1,127 @@
+/****************************************************************************/
+/*! \file FirmwareUpdateGroup.h
+ *
+ *  \brief  Definition file for class CFirmwareUpdateGroup.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the declaration of the class
+ *       CFirmwareUpdateGroup
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef DEVICECONTROL_FIRMWAREUPDATEGROUP_H
+#define DEVICECONTROL_FIRMWAREUPDATEGROUP_H
+
+#include "DeviceControl/Include/Global/DeviceControlGlobal.h"
+#include <QList>
+#include <QObject>
+
+namespace DeviceControl
+{
+
+class CBootLoader;
+
+/****************************************************************************/
+/*!
+ *  \brief  Updates the firmware of several Slaves in parallel
+ *
+ *      The firmware image is read once and downloaded to all boot loaders of
+ *      the group at the same time. While one node writes its flash memory,
+ *      the CAN bus is used by the other nodes, so the update of the group
+ *      takes about as long as the update of the slowest node.
+ */
+/****************************************************************************/
+class CFirmwareUpdateGroup : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor of the class CFirmwareUpdateGroup
+     *
+     *  \iparam p_Parent = Parent object
+     */
+    /****************************************************************************/
+    explicit CFirmwareUpdateGroup(QObject *p_Parent = NULL);
+    /****************************************************************************/
+    /*!
+     *  \brief  Adds the boot loader of a node to the group
+     *
+     *  \iparam p_BootLoader = Boot loader of the node
+     */
+    /****************************************************************************/
+    void AddBootLoader(CBootLoader *p_BootLoader);
+    /****************************************************************************/
+    /*!
+     *  \brief  Starts the firmware update of all nodes of the group
+     *
+     *  \iparam FirmwarePath = The path to the firmware image file
+     *
+     *  \return DCL_ERR_FCT_CALL_SUCCESS or the error of the first node failing
+     */
+    /****************************************************************************/
+    ReturnCode_t UpdateFirmware(const QString &FirmwarePath);
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns if an update of the group is running
+     *
+     *  \return Active (true) or not (false)
+     */
+    /****************************************************************************/
+    bool Active() const { return m_Pending > 0; }
+
+signals:
+    /****************************************************************************/
+    /*!
+     *  \brief  This signal is emitted to report the end of the update of a node
+     *
+     *  \iparam InstanceID = Instance identifier of the base module
+     *  \iparam HdlInfo = Return code, DCL_ERR_FCT_CALL_SUCCESS, otherwise the
+     *                    error code
+     */
+    /****************************************************************************/
+    void ReportUpdateFirmware(quint32 InstanceID, ReturnCode_t HdlInfo);
+    /****************************************************************************/
+    /*!
+     *  \brief  This signal is emitted when the update of all nodes has ended
+     *
+     *  \iparam HdlInfo = DCL_ERR_FCT_CALL_SUCCESS, otherwise the error code of
+     *                    the first node failing
+     */
+    /****************************************************************************/
+    void ReportUpdateFinished(ReturnCode_t HdlInfo);
+
+private slots:
+    /****************************************************************************/
+    /*!
+     *  \brief  Collects the end of the update of a node
+     *
+     *  \iparam InstanceID = Instance identifier of the base module
+     *  \iparam HdlInfo = Return code of the node
+     */
+    /****************************************************************************/
+    void OnUpdateFirmware(quint32 InstanceID, ReturnCode_t HdlInfo);
+
+private:
+    QList<CBootLoader *> m_BootLoaders; //!< Boot loaders of the group
+    qint32 m_Pending;       //!< Number of nodes still updating
+    ReturnCode_t m_Result;  //!< Result of the group update
+};
+
+} //namespace DeviceControl
+
+#endif // DEVICECONTROL_FIRMWAREUPDATEGROUP_H
@@ -38,6 +38,7 @@ namespace DeviceControl
 
 class CANCommunicator;
 class CANMessageConfiguration;
+class CTaskScheduler;
 /****************************************************************************/
 /*!
  *  \brief  Definition/Declaration of macro MODULE_CMD_MAX_RESEND_TIME
@@ -174,6 +175,15 @@ public:
     /****************************************************************************/
     CModuleConfig::CANObjectType_t GetType() const { return m_eObjectType; }
 
+    /****************************************************************************/
+    /**
+     * \brief  Returns if the module has a task to handle
+     *
+     * \return Task pending (true) or module free (false)
+     */
+    /****************************************************************************/
+    bool IsTaskPending() const { return m_TaskID != MODULE_TASKID_FREE; }
+
     /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function StartTimeDelay
@@ -243,6 +253,23 @@ protected:
     /****************************************************************************/
     virtual quint32 GetNodeID() const = 0;
 
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the scheduler of the device processing
+     *
+     *  \return Task scheduler or NULL
+     */
+    /****************************************************************************/
+    CTaskScheduler *GetScheduler() const;
+    /****************************************************************************/
+    /*!
+     *  \brief  Wakes up the device processing to run the module's tasks
+     *
+     *      Called after a command was requested from the module.
+     */
+    /****************************************************************************/
+    void Wake();
+
     /****************************************************************************/
     /*!
      *  \brief  Definition/Declaration of function SendCANMsgReqDataReset
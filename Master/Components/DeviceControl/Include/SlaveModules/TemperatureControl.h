@@ -89,6 +89,19 @@ class CTemperatureControl : public CFunctionModule
     /****************************************************************************/
     ReturnCode_t ReqActTemperature(quint8 Index);
     /****************************************************************************/
+    /*!
+     *  \brief Subscribe to the actual temperatures of all sensors
+     *
+     *      The Slave then reports the temperatures periodically, each by the
+     *      signal ReportActTemperature, without a request.
+     *
+     *  \param Interval = Report interval in ms, 0 ends the subscription
+     *
+     *  \return DCL_ERR_FCT_CALL_SUCCESS if successfull, otherwise an error code
+     */
+    /****************************************************************************/
+    ReturnCode_t SubscribeActTemperature(quint16 Interval);
+    /****************************************************************************/
     /*!
      *  \brief Set temperature ctrl. status
      *
@@ -421,6 +434,8 @@ signals:
     ReturnCode_t SendCANMsgTemperatureRequest();
     //! sends the can request message 'ServiceSensor'
     ReturnCode_t SendCANMsgServiceSensorRequest(quint8 Index);
+    //! sends the can request message 'ServiceSensor' with the telemetry interval
+    ReturnCode_t SendCANMsgServiceSensorSubscribe(quint16 Interval);
     //! sends the can request message 'HeaterTimeSet'
     ReturnCode_t SendCANMsgHeaterTimeSet(quint8 Index);
     //! sends the can request message 'HeaterTimeReq'
@@ -483,7 +498,8 @@ signals:
         FM_TEMP_CMD_TYPE_REQ_FANSPEED  = 9, //!< request fan speed
         FM_TEMP_CMD_TYPE_REQ_HARDWARE  = 10,//!< request hardware status
         FM_TEMP_CMD_TYPE_SET_PID       = 11,//!< set PID parameters
-        FM_TEMP_CMD_TYPE_SET_SWITCH_STATE = 12 //!< set PID parameters
+        FM_TEMP_CMD_TYPE_SET_SWITCH_STATE = 12, //!< set PID parameters
+        FM_TEMP_CMD_TYPE_SUBSCRIBE_ACTTEMP = 13 //!< subscribe to actual temperatures
     } CANTempCtrlCmdType_t;
 
     /*! motor command data, used for internal data transfer*/
@@ -505,6 +521,7 @@ signals:
         quint16 DerivativeTime;       ///<  Definition/Declaration of variable DerivativeTime
         qint8 SwitchState;       ///<  Definition/Declaration of variable SwitchState
         qint8 AutoSwitch;       ///<  Definition/Declaration of variable AutoSwitch
+        quint16 Interval;                       //!< telemetry interval in ms
     } TempCtrlCommand_t;
 
     TempCtrlCommand_t m_ModuleCommand[MAX_TEMP_MODULE_CMD_IDX]; //!< module command array for simultaneously command execution
@@ -513,6 +530,8 @@ signals:
     bool SetModuleTask(CANTempCtrlCmdType_t CommandType, quint8* pCmdIndex = 0);
     //! clears all entrys with the specified module command type to free
     void ResetModuleCommand(CANTempCtrlCmdType_t);
+    //! clears the pending actual temperature request of a sensor
+    void ResetActTempCommand(quint8 Index);
 
     quint32 m_unCanIDError;                 //!< CAN message 'Error'
     quint32 m_unCanIDErrorReq;              //!< CAN message 'Request error'
@@ -24,6 +24,8 @@
 
 #include <QString>
 
+#include <string.h>
+
 #include <sys/time.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
@@ -34,6 +36,7 @@
 
 #include "DeviceControl/Include/CanCommunication/CANThreads.h"
 #include "DeviceControl/Include/CanCommunication/CANCommunicator.h"
+#include "DeviceControl/Include/DeviceProcessing/TaskScheduler.h"
 #include "DeviceControl/Include/SlaveModules/Module.h"
 #include "DeviceControl/Include/Global/dcl_log.h"
 #include "DeviceControl/Include/Global/DeviceControlGlobal.h"
@@ -57,6 +60,9 @@ CANCommunicator::CANCommunicator(QObject * pParent)
     : QObject(pParent)
     , m_pCANReceiveThread(0)
     , m_pCANTransmitThread(0)
+    , m_RxBatchSize(CAN_RX_BATCH_SIZE)
+    , mp_Scheduler(NULL)
+    , m_ReportedHighWaterMark(0)
 {
     // initialize and increment instance ids
     m_nErrorCode = ERR_COMM_NONE;
@@ -108,7 +114,7 @@ ReturnCode_t CANCommunicator::StartComm(const char *Interface)
                       this, OnReportEvent(quint32, quint16));
 
     FILE_LOG_L(laINIT, llDEBUG) << " create receive thread";
-    m_pCANReceiveThread = new CANReceiveThread(this, m_CANInterface);
+    m_pCANReceiveThread = new CANReceiveThread(this, m_CANInterface, m_RxBatchSize);
     if (!m_pCANReceiveThread) {
         StopComm();
         return DCL_ERR_FCT_CALL_FAILED;
@@ -187,9 +193,12 @@ void CANCommunicator::StopComm()
     m_CANInterface.Close();
 
     // Purge queues of pending messages
-    m_mutexCOB.lock();
-    m_SendQueue.clear();
-    m_mutexCOB.unlock();
+    FILE_LOG_L(laINIT, llINFO) << " transmit queue high water mark: " << std::dec
+                               << m_SendQueue.GetHighWaterMark(CAN_TX_PRIO_HIGH) << "/"
+                               << m_SendQueue.GetHighWaterMark(CAN_TX_PRIO_NORMAL)
+                               << ", rejected: " << m_SendQueue.GetRejectedCount();
+    m_SendQueue.Clear();
+    m_ReportedHighWaterMark = 0;
 }
 
 void CANCommunicator::ReportCANError(quint32 ErrorID)
@@ -213,6 +222,24 @@ const CANInterface &CANCommunicator::GetCANInterface()
     return m_CANInterface;
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Returns the statistics of the receive thread
+ *
+ *  \return Statistics of the last measurement interval, all zero if not started
+ */
+/****************************************************************************/
+CANReceiveStatistics_t CANCommunicator::GetReceiveStatistics()
+{
+    CANReceiveStatistics_t Statistics;
+
+    if (m_pCANReceiveThread) {
+        return m_pCANReceiveThread->GetStatistics();
+    }
+    memset(&Statistics, 0, sizeof(Statistics));
+    return Statistics;
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Register a CAN message ID
@@ -228,7 +255,7 @@ ReturnCode_t CANCommunicator::RegisterCOB(unsigned int unCanID, CModule* pCallba
     ReturnCode_t retval = DCL_ERR_FCT_CALL_SUCCESS;
     FILE_LOG_L(laINIT, llDEBUG)  << "CanID: " << std::hex << unCanID;
 
-    m_cobMap[unCanID] = pCallbackModule;
+    retval = m_cobTable.Insert(unCanID, pCallbackModule);
 
     return retval;
 }
@@ -238,13 +265,14 @@ ReturnCode_t CANCommunicator::RegisterCOB(unsigned int unCanID, CModule* pCallba
  *  \brief  Copy a CAN message to the transmit queue
  *
  *  \iparam canmsg = The CAN message to be sent
+ *  \iparam Priority = Transmit lane of the message
  *
  *  \return DCL_ERR_FCT_CALL_SUCCESS if successful copied to transmit queue (but still not sent!)
  *          DCL_ERR_CANBUS_NOT_READY it the CAN bus is not ready
- *          DCL_ERR_CANBUS_ERROR if an error exists
+ *          DCL_ERR_CANBUS_TX_QUEUE_FULL if the transmit queue is full
  */
 /****************************************************************************/
-ReturnCode_t CANCommunicator::SendCOB(can_frame& canmsg)
+ReturnCode_t CANCommunicator::SendCOB(can_frame& canmsg, CANTxPriority_t Priority)
 {
     if (!m_pCANTransmitThread) {
         return DCL_ERR_CANBUS_NOT_READY;
@@ -252,9 +280,12 @@ ReturnCode_t CANCommunicator::SendCOB(can_frame& canmsg)
 
     FILE_LOG_L(laCOMM, llDEBUG3)  << "wake up transmit thread for CAN-ID: " << std::hex << canmsg.can_id;
 
-    m_mutexCOB.lock();
-    m_SendQueue.push_back(canmsg);      // copy the message to the send queue
-    m_mutexCOB.unlock();
+    if (!m_SendQueue.Push(canmsg, Priority)) {
+        // let the transmit thread drain the queue, the caller may retry later
+        m_pCANTransmitThread->WakeUp();
+        FILE_LOG_L(laCOMM, llWARNING) << " transmit queue full, CAN-ID: " << std::hex << canmsg.can_id;
+        return DCL_ERR_CANBUS_TX_QUEUE_FULL;
+    }
 
     m_pCANTransmitThread->WakeUp();
 
@@ -273,13 +304,10 @@ ReturnCode_t CANCommunicator::SendCOB(can_frame& canmsg)
 /****************************************************************************/
 void CANCommunicator::DispatchMessage(can_frame& canmsg)
 {
-    CModule *pCANObjectBase;
-    std::map<__u32, CModule*>::iterator iterCOBAssign;
+    CModule *pCANObjectBase = m_cobTable.Find(canmsg.can_id);
 
-    iterCOBAssign = m_cobMap.find(canmsg.can_id);
-    if(iterCOBAssign != m_cobMap.end())
+    if(pCANObjectBase != NULL)
     {
-        pCANObjectBase = iterCOBAssign->second;
         FILE_LOG_L(laCAN, llDEBUG2) << " HandleMsg " << std::hex << canmsg.can_id << std::hex << (int)canmsg.data[0] <<
                                                                            " "  << std::hex << (int)canmsg.data[1] <<
                                                                            " "  << std::hex << (int)canmsg.data[2] <<
@@ -289,6 +317,9 @@ void CANCommunicator::DispatchMessage(can_frame& canmsg)
                                                                            " "  << std::hex << (int)canmsg.data[6] <<
                                                                            " "  << std::hex << (int)canmsg.data[7];
         pCANObjectBase->HandleCanMessage(&canmsg);
+        if (mp_Scheduler != NULL) {
+            mp_Scheduler->Wake(pCANObjectBase, CTaskScheduler::WAKE_CAN_RECEIVE);
+        }
     }
     else
     {
@@ -305,36 +336,33 @@ void CANCommunicator::DispatchMessage(can_frame& canmsg)
 /****************************************************************************/
 bool CANCommunicator::IsOutMessagePending()
 {
-    int nSize = 0;
-
-    m_mutexCOB.lock();
-    nSize = m_SendQueue.size();
-    m_mutexCOB.unlock();
-
-    return (nSize > 0);
+    return !m_SendQueue.IsEmpty();
 }
 
 /****************************************************************************/
 /*!
- *  \brief  Pop a pending CAN message from send queue.
+ *  \brief  Pop pending CAN messages from send queue.
+ *
+ *      High priority messages are returned first. Called by the transmit
+ *      thread only. A new high water mark of the normal lane is written to
+ *      the log whenever it grew by a quarter of the lane size.
  *
- *  \return The popped CAN message.
+ *  \oparam pFrames = Buffer for the popped messages
+ *  \iparam MaxFrames = Maximum number of messages to pop
+ *
+ *  \return Number of popped messages
  */
 /****************************************************************************/
-can_frame CANCommunicator::PopPendingOutMessage()
+int CANCommunicator::PopPendingOutMessages(can_frame* pFrames, int MaxFrames)
 {
-    can_frame canmsg;
-
-    m_mutexCOB.lock();
-
-    std::deque<can_frame>::iterator iterSendQueue;
-    iterSendQueue = m_SendQueue.begin();
-    canmsg = *iterSendQueue;
-    m_SendQueue.pop_front();
-
-    m_mutexCOB.unlock();
+    int HighWaterMark = m_SendQueue.GetHighWaterMark(CAN_TX_PRIO_NORMAL);
+    if (HighWaterMark >= m_ReportedHighWaterMark + (CAN_TX_RING_SIZE / 4)) {
+        m_ReportedHighWaterMark = HighWaterMark;
+        FILE_LOG_L(laCOMM, llINFO) << " transmit queue high water mark: " << std::dec << HighWaterMark
+                                   << " of " << CAN_TX_RING_SIZE;
+    }
 
-    return canmsg;
+    return m_SendQueue.PopBatch(pFrames, MaxFrames);
 }
 
 } //namespace
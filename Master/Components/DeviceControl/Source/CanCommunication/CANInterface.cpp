@@ -64,7 +64,7 @@ namespace DeviceControl
  *  \brief  Constructor for the CANInterface class
  */
 /****************************************************************************/
-CANInterface::CANInterface() : m_sockCan(0)
+CANInterface::CANInterface() : m_sockCan(0), m_MultiMsgRead(true), m_MultiMsgWrite(true)
 {
 }
 
@@ -187,6 +187,61 @@ int CANInterface::Write(can_frame & CanMsg)
     return write(m_sockCan, &CanMsg, sizeof(can_frame));
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Writes several can messages to the can socket
+ *
+ *      The messages are passed to the kernel with a single sendmmsg call.
+ *      If the kernel does not provide sendmmsg, they are written one by one.
+ *
+ *  \iparam pCanMsgs = The CAN messages to send
+ *  \iparam Count = Number of messages, 1 .. CAN_TX_BATCH_SIZE
+ *
+ *  \return Number of messages written, negative value in case of an error
+ *           before the first message
+ */
+/****************************************************************************/
+int CANInterface::WriteBatch(can_frame* pCanMsgs, int Count)
+{
+    if (Count > CAN_TX_BATCH_SIZE) {
+        Count = CAN_TX_BATCH_SIZE;
+    }
+
+    for (int Index = 0; Index < Count; Index++) {
+        pCanMsgs[Index].can_id |= CAN_EFF_FLAG;
+        pCanMsgs[Index].can_id &= ~CAN_RTR_FLAG;
+    }
+
+    if (m_MultiMsgWrite && (Count > 1)) {
+        struct mmsghdr Messages[CAN_TX_BATCH_SIZE];
+        struct iovec IoVectors[CAN_TX_BATCH_SIZE];
+
+        memset(Messages, 0, sizeof(Messages));
+        for (int Index = 0; Index < Count; Index++) {
+            IoVectors[Index].iov_base = &pCanMsgs[Index];
+            IoVectors[Index].iov_len = sizeof(can_frame);
+            Messages[Index].msg_hdr.msg_iov = &IoVectors[Index];
+            Messages[Index].msg_hdr.msg_iovlen = 1;
+        }
+
+        int Written = sendmmsg(m_sockCan, Messages, Count, 0);
+        if (Written >= 0 || errno != ENOSYS) {
+            return Written;
+        }
+        FILE_LOG_L(laINIT, llWARNING) << " sendmmsg not supported, falling back to single frame write";
+        m_MultiMsgWrite = false;
+    }
+
+    int Written = 0;
+    while (Written < Count) {
+        if (write(m_sockCan, &pCanMsgs[Written], sizeof(can_frame)) != sizeof(can_frame)) {
+            return (Written > 0) ? Written : ERROR_CANINTERFACE_WRITE;
+        }
+        Written++;
+    }
+    return Written;
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Check if can message is ready for reading from the CAN socket interface
@@ -235,4 +290,63 @@ int CANInterface::Read(can_frame* pCanMsg)
     return read(m_sockCan, pCanMsg, sizeof(can_frame));
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Read all pending can messages from the CAN socket interface
+ *
+ *      Drains up to MaxFrames frames with a single recvmmsg call. The socket
+ *      is non-blocking, so the call returns as soon as the socket queue is
+ *      empty. If the kernel does not provide recvmmsg, a single frame is
+ *      read instead.
+ *
+ *  \iparam pCanMsgs = Array of MaxFrames CAN messages, will be filled
+ *  \iparam MaxFrames = Maximum number of messages to read
+ *
+ *  \return Number of messages read, negative value in case of an error
+ */
+/****************************************************************************/
+int CANInterface::ReadBatch(can_frame* pCanMsgs, int MaxFrames)
+{
+    if (MaxFrames > CAN_RX_BATCH_SIZE) {
+        MaxFrames = CAN_RX_BATCH_SIZE;
+    }
+
+    if (m_MultiMsgRead && (MaxFrames > 1)) {
+        struct mmsghdr Messages[CAN_RX_BATCH_SIZE];
+        struct iovec IoVectors[CAN_RX_BATCH_SIZE];
+
+        memset(Messages, 0, sizeof(Messages));
+        for (int Index = 0; Index < MaxFrames; Index++) {
+            IoVectors[Index].iov_base = &pCanMsgs[Index];
+            IoVectors[Index].iov_len = sizeof(can_frame);
+            Messages[Index].msg_hdr.msg_iov = &IoVectors[Index];
+            Messages[Index].msg_hdr.msg_iovlen = 1;
+        }
+
+        int Count = recvmmsg(m_sockCan, Messages, MaxFrames, MSG_DONTWAIT, NULL);
+        if (Count >= 0) {
+            for (int Index = 0; Index < Count; Index++) {
+                if (Messages[Index].msg_len != sizeof(can_frame)) {
+                    return ERROR_CANINTERFACE_UNDEF;
+                }
+            }
+            return Count;
+        }
+        if (errno != ENOSYS) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : Count;
+        }
+        FILE_LOG_L(laINIT, llWARNING) << " recvmmsg not supported, falling back to single frame read";
+        m_MultiMsgRead = false;
+    }
+
+    int nReadResult = Read(pCanMsgs);
+    if (nReadResult == sizeof(can_frame)) {
+        return 1;
+    }
+    if (nReadResult < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    return ERROR_CANINTERFACE_UNDEF;
+}
+
 } //namespace
@@ -28,6 +28,8 @@
 #include <sys/syscall.h>
 #include <unistd.h>
 #include <errno.h>
+#include <string.h>
+#include <time.h>
 
 #include "DeviceControl/Include/CanCommunication/CANThreads.h"
 #include "DeviceControl/Include/CanCommunication/CANInterface.h"
@@ -43,28 +45,40 @@ namespace DeviceControl
  *
  *  \iparam pCANCommunicator = Class for receive queue access
  *  \iparam rCANInterface = Class for can interface
+ *  \iparam BatchSize = Maximum number of frames read at once, 1 reads frame by frame
  */
 /****************************************************************************/
-CANReceiveThread::CANReceiveThread(CANCommunicator* pCANCommunicator, CANInterface & rCANInterface)
+CANReceiveThread::CANReceiveThread(CANCommunicator* pCANCommunicator, CANInterface & rCANInterface, int BatchSize)
     : QThread(pCANCommunicator)
     , m_pCANCommunicator(pCANCommunicator)
     , m_rCANInterface(rCANInterface)
     , m_bBreak(false)
+    , m_BatchSize(qBound(1, BatchSize, CAN_RX_BATCH_SIZE))
+    , m_IntervalStart(0)
+    , m_FramesTotal(0)
+    , m_IntervalFrames(0)
+    , m_IntervalReads(0)
+    , m_IntervalMaxBatch(0)
+    , m_IntervalDispatchNs(0)
+    , m_IntervalDispatchMaxNs(0)
 {
     m_lastErrorFrame.can_id = 0;
+    memset(&m_Statistics, 0, sizeof(m_Statistics));
 }
 
 /****************************************************************************/
 /*!
  *  \brief  The receive thread's execution function
  *
- *      The function calls a blocking read and waits until new CAN message
- *      data were received. The new CAN message will be added to the receive
- *      queue and the blocking read will be called again.
+ *      The function waits until new CAN message data were received. All
+ *      frames pending at the socket are read at once and dispatched to the
+ *      registered modules, then the thread waits again.
  */
 /****************************************************************************/
 void CANReceiveThread::run()
 {
+    m_IntervalStart = GetTimeNs();
+
     forever
     {
         if(m_pCANCommunicator != NULL) {
@@ -75,42 +89,42 @@ void CANReceiveThread::run()
             else {
                 // new msg available
                 if (ReturnValue > 0) {
-                    // read message from CAN bus (blocking call to socket)
-                    struct can_frame frame;
-                    int nReadResult = m_rCANInterface.Read(&frame);
-                    if (nReadResult != sizeof(frame)) {
+                    int FrameCount;
+                    if (m_BatchSize > 1) {
+                        FrameCount = m_rCANInterface.ReadBatch(m_Frames, m_BatchSize);
+                    }
+                    else {
+                        FrameCount = (m_rCANInterface.Read(&m_Frames[0]) == sizeof(can_frame)) ? 1 : -1;
+                    }
+
+                    if (FrameCount < 0) {
                         m_pCANCommunicator->ReportCANError();
                     }
                     else {
-#if defined(__arm__) //Target
-                        if (0 == (frame.can_id & 0x01)) {   // process only slave messages
-#endif
-                            //m_pCANCommunicator->DispatchMessage(frame);
-                            if (0 == (frame.can_id & CAN_ERR_FLAG)) {
-                                // only support EFF
-                                if (CAN_EFF_FLAG == (frame.can_id & (CAN_EFF_FLAG | CAN_RTR_FLAG) )) {
-                                    // forward message to module
-                                    frame.can_id = frame.can_id & CAN_EFF_MASK;
-                                    m_pCANCommunicator->DispatchMessage(frame);
-                                    if (m_lastErrorFrame.can_id & CAN_ERR_MASK) {
-                                        frame.can_id = 0;               // log as resolved
-                                        m_lastErrorFrame.can_id = 0;    // reset error frame
-                                    }
-                                }
-                                else {
-                                    m_pCANCommunicator->ReportCANError();
-                                }
-                            }
-                            else {
-                                // error frame received
-                                FILE_LOG_L(laCAN, llWARNING) << " Error-CanID: " << std::hex << (frame.can_id & CAN_ERR_MASK);
-                                m_lastErrorFrame = frame;
+                        quint64 ReadTime = GetTimeNs();
+                        quint64 DoneTime = ReadTime;
+
+                        for (int Index = 0; Index < FrameCount; Index++) {
+                            ProcessFrame(m_Frames[Index]);
+                            DoneTime = GetTimeNs();
+                            quint64 Latency = DoneTime - ReadTime;
+                            m_IntervalDispatchNs += Latency;
+                            if (Latency > m_IntervalDispatchMaxNs) {
+                                m_IntervalDispatchMaxNs = Latency;
                             }
-#if defined(__arm__) //Target
                         }
-#endif
+
+                        m_IntervalReads++;
+                        m_IntervalFrames += FrameCount;
+                        if (static_cast<quint32>(FrameCount) > m_IntervalMaxBatch) {
+                            m_IntervalMaxBatch = FrameCount;
+                        }
+                        UpdateStatistics(DoneTime);
                     }
                 }
+                else {
+                    UpdateStatistics(GetTimeNs());
+                }
             }
         }
 
@@ -126,6 +140,114 @@ void CANReceiveThread::run()
     }
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Checks a received frame and forwards it to the communicator
+ *
+ *  \iparam Frame = Received CAN frame
+ */
+/****************************************************************************/
+void CANReceiveThread::ProcessFrame(can_frame &Frame)
+{
+#if defined(__arm__) //Target
+    if (0 != (Frame.can_id & 0x01)) {   // process only slave messages
+        return;
+    }
+#endif
+    if (0 == (Frame.can_id & CAN_ERR_FLAG)) {
+        // only support EFF
+        if (CAN_EFF_FLAG == (Frame.can_id & (CAN_EFF_FLAG | CAN_RTR_FLAG) )) {
+            // forward message to module
+            Frame.can_id = Frame.can_id & CAN_EFF_MASK;
+            m_pCANCommunicator->DispatchMessage(Frame);
+            if (m_lastErrorFrame.can_id & CAN_ERR_MASK) {
+                Frame.can_id = 0;               // log as resolved
+                m_lastErrorFrame.can_id = 0;    // reset error frame
+            }
+        }
+        else {
+            m_pCANCommunicator->ReportCANError();
+        }
+    }
+    else {
+        // error frame received
+        FILE_LOG_L(laCAN, llWARNING) << " Error-CanID: " << std::hex << (Frame.can_id & CAN_ERR_MASK);
+        m_lastErrorFrame = Frame;
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Closes the measurement interval if it is expired
+ *
+ *      The statistics of the closed interval are stored for GetStatistics()
+ *      and written to the log.
+ *
+ *  \iparam Now = Current monotonic time in nanoseconds
+ */
+/****************************************************************************/
+void CANReceiveThread::UpdateStatistics(quint64 Now)
+{
+    quint64 Elapsed = Now - m_IntervalStart;
+    if (Elapsed < (quint64)CAN_RX_STATISTICS_INTERVAL_MS * 1000000ULL) {
+        return;
+    }
+
+    CANReceiveStatistics_t Statistics;
+    m_FramesTotal += m_IntervalFrames;
+    Statistics.FramesTotal = m_FramesTotal;
+    Statistics.FramesPerSecond = (quint32)(((quint64)m_IntervalFrames * 1000000000ULL) / Elapsed);
+    Statistics.ReadsPerSecond = (quint32)(((quint64)m_IntervalReads * 1000000000ULL) / Elapsed);
+    Statistics.MaxBatchSize = m_IntervalMaxBatch;
+    Statistics.DispatchAvgUs = (m_IntervalFrames > 0) ? (quint32)(m_IntervalDispatchNs / m_IntervalFrames / 1000) : 0;
+    Statistics.DispatchMaxUs = (quint32)(m_IntervalDispatchMaxNs / 1000);
+
+    m_StatisticsLock.lock();
+    m_Statistics = Statistics;
+    m_StatisticsLock.unlock();
+
+    if (Statistics.FramesPerSecond > 0) {
+        FILE_LOG_L(laCAN, llINFO) << " frames/s: " << std::dec << Statistics.FramesPerSecond
+                                  << " reads/s: " << Statistics.ReadsPerSecond
+                                  << " max batch: " << Statistics.MaxBatchSize
+                                  << " dispatch avg/max us: " << Statistics.DispatchAvgUs << "/" << Statistics.DispatchMaxUs;
+    }
+
+    m_IntervalStart = Now;
+    m_IntervalFrames = 0;
+    m_IntervalReads = 0;
+    m_IntervalMaxBatch = 0;
+    m_IntervalDispatchNs = 0;
+    m_IntervalDispatchMaxNs = 0;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the statistics of the last measurement interval
+ *
+ *  \return Receive statistics
+ */
+/****************************************************************************/
+CANReceiveStatistics_t CANReceiveThread::GetStatistics()
+{
+    QMutexLocker Locker(&m_StatisticsLock);
+    return m_Statistics;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the monotonic time
+ *
+ *  \return Time in nanoseconds
+ */
+/****************************************************************************/
+quint64 CANReceiveThread::GetTimeNs()
+{
+    struct timespec Time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &Time);
+    return ((quint64)Time.tv_sec * 1000000000ULL) + (quint64)Time.tv_nsec;
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Set break condition for exit
@@ -161,8 +283,10 @@ CANTransmitThread::CANTransmitThread(CANCommunicator* pCANCommunicator, CANInter
 /**
  *  \brief  The transmit thread's execution function
  *
- *      The function checks for pending CAN messages to be sent. If any, the
- *      CAN message will be taken from the send queue and sent via CAN bus.
+ *      The function checks for pending CAN messages to be sent. If any, up to
+ *      CAN_TX_BATCH_SIZE CAN messages will be taken from the send queue and
+ *      sent via CAN bus with a single write call. Messages the socket does not
+ *      accept are kept at the front of the batch and written again.
  *
  *      If no further CAN messages are left for sending, the thread will block
  *      until the wait condition wakes them up again.
@@ -173,7 +297,7 @@ CANTransmitThread::CANTransmitThread(CANCommunicator* pCANCommunicator, CANInter
 /****************************************************************************/
 void CANTransmitThread::run()
 {
-    struct can_frame canframeToSend;
+    can_frame Frames[CAN_TX_BATCH_SIZE];
     int nWriteResult;
     forever
     {
@@ -191,28 +315,46 @@ void CANTransmitThread::run()
         }
         m_BreakLock.unlock();
 
-        // transmit data from send buffer
-        while (m_pCANCommunicator->IsOutMessagePending())
+        // transmit data from send buffer, several messages per system call
+        int FrameCount = 0;
+        forever
         {
-            // pop message from send queue
-            canframeToSend = m_pCANCommunicator->PopPendingOutMessage();
+            // fill up the batch behind the frames not accepted by the last write
+            FrameCount += m_pCANCommunicator->PopPendingOutMessages(&Frames[FrameCount], CAN_TX_BATCH_SIZE - FrameCount);
+            if (FrameCount == 0) {
+                break;
+            }
+
+            // write them to the CAN bus socket layer
+            nWriteResult = m_rCANInterface.WriteBatch(Frames, FrameCount);
+            if (nWriteResult == FrameCount) {
+                m_lastErrno = 0;
+                FrameCount = 0;
+                continue;
+            }
+
+            // keep the unsent frames in order at the front of the batch
+            if (nWriteResult > 0) {
+                FrameCount -= nWriteResult;
+                memmove(Frames, &Frames[nWriteResult], FrameCount * sizeof(can_frame));
+                continue;
+            }
 
-            // write it to the CAN bus socket layer
-            nWriteResult = m_rCANInterface.Write(canframeToSend);
-            if (nWriteResult != sizeof(canframeToSend)) {
+            // the socket queue is full (ENOBUFS) or the bus is down, retry after a short delay
+            if (m_lastErrno != errno) {
+                m_lastErrno = errno;
+                FILE_LOG_L(laCOMM, llWARNING) << "  CANTransmitThread::run() write failed: " << strerror(m_lastErrno);
                 m_pCANCommunicator->ReportCANError();
             }
-//                if (m_lastErrno != errno) {
-//                    m_pCANCommunicator->ReportCANError();
-//                    m_lastErrno = errno;
-//                }
-//            }
-//            else {
-//                if (m_lastErrno != errno) {
-//                    m_pCANCommunicator->ReportCANError();
-//                    m_lastErrno = errno;
-//                }
-//            }
+            msleep(CAN_TX_RETRY_DELAY_MS);
+
+            m_BreakLock.lock();
+            if (m_bBreak == true) {
+                m_BreakLock.unlock();
+                FILE_LOG_L(laCONFIG, llDEBUG) << "  CANTransmitThread::run() -> break, " << FrameCount << " frames not sent";
+                return;
+            }
+            m_BreakLock.unlock();
         }
     }
 }
@@ -0,0 +1,243 @@
+/****************************************************************************/
+/*! \file CANTransmitRing.cpp
+ *
+ *  \brief
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class CANTransmitRing
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/CanCommunication/CANTransmitRing.h"
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Distance between two ring positions, robust against wrap around
+ *
+ *  \iparam First = Position
+ *  \iparam Second = Position subtracted from First
+ *
+ *  \return First - Second
+ */
+/****************************************************************************/
+static inline int PositionDiff(int First, int Second)
+{
+    return static_cast<int>(static_cast<quint32>(First) - static_cast<quint32>(Second));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the CANTransmitRing class
+ */
+/****************************************************************************/
+CANTransmitRing::CANTransmitRing()
+{
+    Clear();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Queue a CAN message for transmission
+ *
+ *  \iparam Frame = CAN message
+ *  \iparam Priority = Lane the message is queued to
+ *
+ *  \return true if queued, false if the lane is full
+ */
+/****************************************************************************/
+bool CANTransmitRing::Push(const can_frame &Frame, CANTxPriority_t Priority)
+{
+    Lane_t &rLane = m_Lanes[(Priority == CAN_TX_PRIO_HIGH) ? CAN_TX_PRIO_HIGH : CAN_TX_PRIO_NORMAL];
+    int Position = rLane.EnqueuePos.loadAcquire();
+    Cell_t *pCell;
+
+    forever {
+        pCell = &rLane.Cells[static_cast<quint32>(Position) & (CAN_TX_RING_SIZE - 1)];
+        int Diff = PositionDiff(pCell->Sequence.loadAcquire(), Position);
+
+        if (Diff == 0) {
+            if (rLane.EnqueuePos.testAndSetOrdered(Position, Position + 1)) {
+                break;
+            }
+            Position = rLane.EnqueuePos.loadAcquire();
+        }
+        else if (Diff < 0) {
+            // the consumer has not freed this cell yet, the lane is full
+            m_Rejected.fetchAndAddRelaxed(1);
+            return false;
+        }
+        else {
+            Position = rLane.EnqueuePos.loadAcquire();
+        }
+    }
+
+    pCell->Frame = Frame;
+    pCell->Sequence.storeRelease(Position + 1);
+
+    UpdateHighWaterMark(rLane, PositionDiff(Position + 1, rLane.DequeuePos.loadAcquire()));
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Take queued CAN messages, high priority lane first
+ *
+ *      Must only be called by the transmit thread.
+ *
+ *  \iparam pFrames = Buffer for MaxFrames messages
+ *  \iparam MaxFrames = Maximum number of messages to take
+ *
+ *  \return Number of messages taken
+ */
+/****************************************************************************/
+int CANTransmitRing::PopBatch(can_frame *pFrames, int MaxFrames)
+{
+    int Count = 0;
+
+    for (int Lane = 0; Lane < CAN_TX_PRIO_COUNT; Lane++) {
+        while (Count < MaxFrames && PopLane(m_Lanes[Lane], pFrames[Count])) {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Take one message from a lane
+ *
+ *  \iparam rLane = Lane
+ *  \oparam rFrame = Taken message
+ *
+ *  \return true if a message was taken, false if the lane is empty
+ */
+/****************************************************************************/
+bool CANTransmitRing::PopLane(Lane_t &rLane, can_frame &rFrame)
+{
+    int Position = rLane.DequeuePos.loadAcquire();
+    Cell_t *pCell = &rLane.Cells[static_cast<quint32>(Position) & (CAN_TX_RING_SIZE - 1)];
+
+    if (PositionDiff(pCell->Sequence.loadAcquire(), Position + 1) != 0) {
+        return false;
+    }
+
+    rFrame = pCell->Frame;
+    rLane.DequeuePos.storeRelease(Position + 1);
+    pCell->Sequence.storeRelease(Position + CAN_TX_RING_SIZE);
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Raise the high water mark of a lane
+ *
+ *  \iparam rLane = Lane
+ *  \iparam Depth = Observed depth
+ */
+/****************************************************************************/
+void CANTransmitRing::UpdateHighWaterMark(Lane_t &rLane, int Depth)
+{
+    int Current = rLane.HighWaterMark.loadAcquire();
+    while (Depth > Current) {
+        if (rLane.HighWaterMark.testAndSetOrdered(Current, Depth)) {
+            break;
+        }
+        Current = rLane.HighWaterMark.loadAcquire();
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Checks whether all lanes are empty
+ *
+ *  \return true if no message is queued
+ */
+/****************************************************************************/
+bool CANTransmitRing::IsEmpty() const
+{
+    for (int Lane = 0; Lane < CAN_TX_PRIO_COUNT; Lane++) {
+        if (GetDepth(static_cast<CANTxPriority_t>(Lane)) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the number of queued messages of a lane
+ *
+ *  \iparam Priority = Lane
+ *
+ *  \return Number of queued messages
+ */
+/****************************************************************************/
+int CANTransmitRing::GetDepth(CANTxPriority_t Priority) const
+{
+    const Lane_t &rLane = m_Lanes[Priority];
+    return PositionDiff(rLane.EnqueuePos.loadAcquire(), rLane.DequeuePos.loadAcquire());
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the maximum depth a lane has reached
+ *
+ *  \iparam Priority = Lane
+ *
+ *  \return High water mark
+ */
+/****************************************************************************/
+int CANTransmitRing::GetHighWaterMark(CANTxPriority_t Priority) const
+{
+    return m_Lanes[Priority].HighWaterMark.loadAcquire();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the number of messages refused because of a full lane
+ *
+ *  \return Rejected message count
+ */
+/****************************************************************************/
+quint32 CANTransmitRing::GetRejectedCount() const
+{
+    return static_cast<quint32>(m_Rejected.loadAcquire());
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Remove all queued messages and reset the statistics
+ *
+ *      Must not be called while producers or the transmit thread are active.
+ */
+/****************************************************************************/
+void CANTransmitRing::Clear()
+{
+    for (int Lane = 0; Lane < CAN_TX_PRIO_COUNT; Lane++) {
+        for (int Index = 0; Index < CAN_TX_RING_SIZE; Index++) {
+            m_Lanes[Lane].Cells[Index].Sequence.storeRelease(Index);
+        }
+        m_Lanes[Lane].EnqueuePos.storeRelease(0);
+        m_Lanes[Lane].DequeuePos.storeRelease(0);
+        m_Lanes[Lane].HighWaterMark.storeRelease(0);
+    }
+    m_Rejected.storeRelease(0);
+}
+
+} //namespace
@@ -0,0 +1,133 @@
+/****************************************************************************/
+/*! \file COBDispatchTable.cpp
+ *
+ *  \brief
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class COBDispatchTable
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/CanCommunication/COBDispatchTable.h"
+#include "DeviceControl/Include/Global/dcl_log.h"
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the COBDispatchTable class
+ */
+/****************************************************************************/
+COBDispatchTable::COBDispatchTable() : m_Count(0)
+{
+    Clear();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Register a module for a CAN ID
+ *
+ *      An already registered CAN ID is assigned to the new module. The
+ *      module pointer is published before the key, so a concurrent Find()
+ *      never sees a key without its module.
+ *
+ *  \iparam CanID = CAN ID without flags
+ *  \iparam pModule = Module receiving the CAN message
+ *
+ *  \return DCL_ERR_FCT_CALL_SUCCESS or DCL_ERR_FCT_CALL_FAILED if the table is full
+ */
+/****************************************************************************/
+ReturnCode_t COBDispatchTable::Insert(quint32 CanID, CModule* pModule)
+{
+    QMutexLocker Locker(&m_InsertLock);
+
+    CanID &= CAN_EFF_MASK;
+    quint32 Index = Hash(CanID);
+
+    for (int Probe = 0; Probe < COB_DISPATCH_TABLE_SIZE; Probe++) {
+        Slot_t &rSlot = m_Slots[Index];
+        int Key = rSlot.Key.loadAcquire();
+
+        if (Key == static_cast<int>(CanID)) {
+            rSlot.pModule.storeRelease(pModule);
+            return DCL_ERR_FCT_CALL_SUCCESS;
+        }
+        if (Key == EMPTY_SLOT) {
+            if (m_Count >= COB_DISPATCH_TABLE_MAX_LOAD) {
+                break;
+            }
+            rSlot.pModule.storeRelease(pModule);
+            rSlot.Key.storeRelease(static_cast<int>(CanID));
+            m_Count++;
+            return DCL_ERR_FCT_CALL_SUCCESS;
+        }
+        Index = (Index + 1) & (COB_DISPATCH_TABLE_SIZE - 1);
+    }
+
+    FILE_LOG_L(laINIT, llERROR) << " dispatch table full, CAN ID not registered: " << std::hex << CanID;
+    return DCL_ERR_FCT_CALL_FAILED;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Look up the module registered for a CAN ID
+ *
+ *      This function does not lock and is called by the receive thread.
+ *
+ *  \iparam CanID = CAN ID without flags
+ *
+ *  \return Registered module or NULL
+ */
+/****************************************************************************/
+CModule* COBDispatchTable::Find(quint32 CanID) const
+{
+    quint32 Index = Hash(CanID);
+
+    for (int Probe = 0; Probe < COB_DISPATCH_TABLE_SIZE; Probe++) {
+        const Slot_t &rSlot = m_Slots[Index];
+        int Key = rSlot.Key.loadAcquire();
+
+        if (Key == static_cast<int>(CanID)) {
+            return rSlot.pModule.loadAcquire();
+        }
+        if (Key == EMPTY_SLOT) {
+            return NULL;
+        }
+        Index = (Index + 1) & (COB_DISPATCH_TABLE_SIZE - 1);
+    }
+    return NULL;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Remove all registrations
+ *
+ *      Must not be called while the receive thread is running.
+ */
+/****************************************************************************/
+void COBDispatchTable::Clear()
+{
+    QMutexLocker Locker(&m_InsertLock);
+
+    for (int Index = 0; Index < COB_DISPATCH_TABLE_SIZE; Index++) {
+        m_Slots[Index].pModule.storeRelease(NULL);
+        m_Slots[Index].Key.storeRelease(EMPTY_SLOT);
+    }
+    m_Count = 0;
+}
+
+} //namespace
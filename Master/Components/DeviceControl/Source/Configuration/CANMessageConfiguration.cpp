@@ -23,6 +23,7 @@
 /****************************************************************************/
 
 #include "DeviceControl/Include/Configuration/CANMessageConfiguration.h"
+#include "DeviceControl/Include/Configuration/ConfigurationSnapshot.h"
 #include "DeviceControl/Include/Global/dcl_log.h"
 #include "DeviceControl/Include/Global/DeviceControlGlobal.h"
 #include "Global/Include/SystemPaths.h"
@@ -79,6 +80,23 @@ ReturnCode_t CANMessageConfiguration::ReadCANMessageConfigurationFile()
     QString fileName = Global::SystemPaths::Instance().GetSettingsPath() + "/fctmodule_spec.xml";
     FILE_LOG_L(laCONFIG_FILE, llINFO) <<  "  read configuration from '" << fileName.toStdString() << "'";
 
+    // the snapshot is valid as long as the xml file is unchanged
+    ConfigurationSnapshot Snapshot(fileName, ConfigurationSnapshot::FORMAT_CAN_MESSAGES);
+    QByteArray SnapshotData;
+    if (Snapshot.Read(SnapshotData))
+    {
+        CANMessageList MessageList;
+        QDataStream SnapshotStream(SnapshotData);
+        SnapshotStream.setVersion(ConfigurationSnapshot::STREAM_VERSION);
+        SnapshotStream >> MessageList;
+        if ((SnapshotStream.status() == QDataStream::Ok) && SnapshotStream.atEnd())
+        {
+            m_CANMessageList = MessageList;
+            FILE_LOG_L(laCONFIG_FILE, llINFO) <<  " read configuration from snapshot... success.";
+            return DCL_ERR_FCT_CALL_SUCCESS;
+        }
+    }
+
     QFile file(fileName);
     if (!file.open(QFile::ReadOnly | QFile::Text))
     {
@@ -246,6 +264,14 @@ ReturnCode_t CANMessageConfiguration::ReadCANMessageConfigurationFile()
         }
     }
 
+    QDataStream SnapshotStream(&SnapshotData, QIODevice::WriteOnly);
+    SnapshotStream.setVersion(ConfigurationSnapshot::STREAM_VERSION);
+    SnapshotStream << m_CANMessageList;
+    if (!Snapshot.Write(SnapshotData))
+    {
+        FILE_LOG_L(laCONFIG_FILE, llWARNING) <<  " cannot write snapshot of the configuration.";
+    }
+
     FILE_LOG_L(laCONFIG_FILE, llINFO) <<  " read configuration... success.";
 
     return retCode;
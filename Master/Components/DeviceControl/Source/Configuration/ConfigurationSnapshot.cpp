@@ -0,0 +1,701 @@
+/****************************************************************************/
+/*! \file ConfigurationSnapshot.cpp
+ *
+ *  \brief  Implementation file for class ConfigurationSnapshot.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class ConfigurationSnapshot
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/Configuration/ConfigurationSnapshot.h"
+#include "DeviceControl/Include/SlaveModules/ModuleConfig.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+
+namespace DeviceControl
+{
+
+const quint32 ConfigurationSnapshot::SNAPSHOT_MAGIC;
+const quint32 ConfigurationSnapshot::SNAPSHOT_VERSION;
+const int ConfigurationSnapshot::STREAM_VERSION;
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the SHA-1 hash of a file
+ *
+ *  \iparam FileName = Path of the file
+ *
+ *  \return The hash, empty if the file cannot be read
+ */
+/****************************************************************************/
+static QByteArray HashFile(const QString &FileName)
+{
+    QFile File(FileName);
+    if (!File.open(QIODevice::ReadOnly))
+    {
+        return QByteArray();
+    }
+    return QCryptographicHash::hash(File.readAll(), QCryptographicHash::Sha1);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads an enumeration stored as 32 bit value
+ *
+ *  \iparam Stream = Source
+ *  \oparam Value = The enumeration
+ */
+/****************************************************************************/
+template <typename TEnum>
+static void ReadEnum(QDataStream &Stream, TEnum &Value)
+{
+    qint32 Raw = 0;
+    Stream >> Raw;
+    Value = static_cast<TEnum>(Raw);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes a limit switch configuration
+ *
+ *  \iparam Stream = Destination
+ *  \iparam LimitSwitch = Limit switch configuration
+ */
+/****************************************************************************/
+static void WriteLimitSwitch(QDataStream &Stream, const CANFctModuleLimitSwitch &LimitSwitch)
+{
+    Stream << LimitSwitch.bIndex << LimitSwitch.bExists << LimitSwitch.bOrientation
+           << LimitSwitch.bPolarity << LimitSwitch.bSampleRate << LimitSwitch.bDebounce;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads a limit switch configuration
+ *
+ *  \iparam Stream = Source
+ *  \oparam LimitSwitch = Limit switch configuration
+ */
+/****************************************************************************/
+static void ReadLimitSwitch(QDataStream &Stream, CANFctModuleLimitSwitch &LimitSwitch)
+{
+    Stream >> LimitSwitch.bIndex >> LimitSwitch.bExists >> LimitSwitch.bOrientation
+           >> LimitSwitch.bPolarity >> LimitSwitch.bSampleRate >> LimitSwitch.bDebounce;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes a limit switch position code configuration
+ *
+ *  \iparam Stream = Destination
+ *  \iparam PosCode = Position code configuration
+ */
+/****************************************************************************/
+static void WritePosCode(QDataStream &Stream, const CANFctModulePosCode &PosCode)
+{
+    Stream << PosCode.bValid << PosCode.bStop << PosCode.bStopDir << PosCode.position
+           << PosCode.width << PosCode.deviation << PosCode.bRotDirCheck << PosCode.hitSkip;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads a limit switch position code configuration
+ *
+ *  \iparam Stream = Source
+ *  \oparam PosCode = Position code configuration
+ */
+/****************************************************************************/
+static void ReadPosCode(QDataStream &Stream, CANFctModulePosCode &PosCode)
+{
+    Stream >> PosCode.bValid >> PosCode.bStop >> PosCode.bStopDir >> PosCode.position
+           >> PosCode.width >> PosCode.deviation >> PosCode.bRotDirCheck >> PosCode.hitSkip;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes the fields of a stepper motor configuration
+ *
+ *  \iparam Stream = Destination
+ *  \iparam Motor = Stepper motor configuration
+ */
+/****************************************************************************/
+static void WriteStepperMotor(QDataStream &Stream, const CANFctModuleStepperMotor &Motor)
+{
+    Stream << static_cast<qint32>(Motor.rotationType) << Motor.sResolution << Motor.sResetPosition
+           << static_cast<qint32>(Motor.bDirection) << Motor.bEncoderType << Motor.sEncoderResolution
+           << static_cast<qint32>(Motor.bEncoderDir);
+    WriteLimitSwitch(Stream, Motor.LimitSwitch1);
+    WriteLimitSwitch(Stream, Motor.LimitSwitch2);
+    WritePosCode(Stream, Motor.PosCode1);
+    WritePosCode(Stream, Motor.PosCode2);
+    WritePosCode(Stream, Motor.PosCode3);
+    Stream << Motor.lMinPosition << Motor.lMaxPosition << Motor.sMinSpeed << Motor.sMaxSpeed
+           << Motor.refRunRefPos << Motor.lRefRunMaxDistance << Motor.sRefRunTimeout
+           << Motor.lRefRunReverseDistance << Motor.lRefPosOffset
+           << Motor.sRefRunSlowSpeed << Motor.sRefRunHighSpeed;
+
+    Stream << static_cast<qint32>(Motor.listMotionProfiles.count());
+    MotionProfileMap::const_iterator iter = Motor.listMotionProfiles.constBegin();
+    for (; iter != Motor.listMotionProfiles.constEnd(); ++iter)
+    {
+        const CANFctModuleMotionProfile &Profile = iter.value();
+        Stream << iter.key() << Profile.sSpeedMin << Profile.sSpeedMax << Profile.sAcc << Profile.sDec
+               << Profile.sAccTime << Profile.sDecTime << Profile.bMicroSteps << Profile.bRampType << Profile.bIndex;
+    }
+
+    Stream << Motor.sStepLossWarnLimit << Motor.sStepLossErrorLimit << Motor.sCurrentLimit
+           << Motor.runCurrentScale << Motor.stopCurrentScale << Motor.stopCurrentDelay
+           << static_cast<qint32>(Motor.driverType) << Motor.tmc26x.drvConf << Motor.tmc26x.sgcsConf
+           << Motor.tmc26x.smartEn << Motor.tmc26x.chopConf;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads the fields of a stepper motor configuration
+ *
+ *  \iparam Stream = Source
+ *  \oparam Motor = Stepper motor configuration
+ */
+/****************************************************************************/
+static void ReadStepperMotor(QDataStream &Stream, CANFctModuleStepperMotor &Motor)
+{
+    qint32 Count = 0;
+
+    ReadEnum(Stream, Motor.rotationType);
+    Stream >> Motor.sResolution >> Motor.sResetPosition;
+    ReadEnum(Stream, Motor.bDirection);
+    Stream >> Motor.bEncoderType >> Motor.sEncoderResolution;
+    ReadEnum(Stream, Motor.bEncoderDir);
+    ReadLimitSwitch(Stream, Motor.LimitSwitch1);
+    ReadLimitSwitch(Stream, Motor.LimitSwitch2);
+    ReadPosCode(Stream, Motor.PosCode1);
+    ReadPosCode(Stream, Motor.PosCode2);
+    ReadPosCode(Stream, Motor.PosCode3);
+    Stream >> Motor.lMinPosition >> Motor.lMaxPosition >> Motor.sMinSpeed >> Motor.sMaxSpeed
+           >> Motor.refRunRefPos >> Motor.lRefRunMaxDistance >> Motor.sRefRunTimeout
+           >> Motor.lRefRunReverseDistance >> Motor.lRefPosOffset
+           >> Motor.sRefRunSlowSpeed >> Motor.sRefRunHighSpeed;
+
+    Stream >> Count;
+    for (qint32 i = 0; (i < Count) && (Stream.status() == QDataStream::Ok); i++)
+    {
+        short Key = 0;
+        CANFctModuleMotionProfile Profile;
+        Stream >> Key >> Profile.sSpeedMin >> Profile.sSpeedMax >> Profile.sAcc >> Profile.sDec
+               >> Profile.sAccTime >> Profile.sDecTime >> Profile.bMicroSteps >> Profile.bRampType >> Profile.bIndex;
+        Motor.listMotionProfiles.insert(Key, Profile);
+    }
+
+    Stream >> Motor.sStepLossWarnLimit >> Motor.sStepLossErrorLimit >> Motor.sCurrentLimit
+           >> Motor.runCurrentScale >> Motor.stopCurrentScale >> Motor.stopCurrentDelay;
+    ReadEnum(Stream, Motor.driverType);
+    Stream >> Motor.tmc26x.drvConf >> Motor.tmc26x.sgcsConf >> Motor.tmc26x.smartEn >> Motor.tmc26x.chopConf;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes the fields of a temperature control configuration
+ *
+ *  \iparam Stream = Destination
+ *  \iparam TempCtrl = Temperature control configuration
+ */
+/****************************************************************************/
+static void WriteTempCtrl(QDataStream &Stream, const CANFctModuleTempCtrl &TempCtrl)
+{
+    Stream << TempCtrl.bTempTolerance << TempCtrl.sSamplingPeriod << TempCtrl.sFanSpeed << TempCtrl.sFanThreshold
+           << TempCtrl.sCurrentGain << TempCtrl.sHeaterCurrent << TempCtrl.sHeaterThreshold << TempCtrl.sCurrentDeviation
+           << TempCtrl.sCurrentMin230_Serial << TempCtrl.sCurrentMax230_Serial
+           << TempCtrl.sCurrentMin100_Serial << TempCtrl.sCurrentMax100_Serial
+           << TempCtrl.sCurrentMin100_Parallel << TempCtrl.sCurrentMax100_Parallel;
+
+    Stream << static_cast<qint32>(TempCtrl.listPidControllers.count());
+    for (int i = 0; i < TempCtrl.listPidControllers.count(); i++)
+    {
+        const CANFctPidController &Pid = TempCtrl.listPidControllers.at(i);
+        Stream << Pid.sMaxTemperature << Pid.sControllerGain << Pid.sResetTime << Pid.sDerivativeTime;
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads the fields of a temperature control configuration
+ *
+ *  \iparam Stream = Source
+ *  \oparam TempCtrl = Temperature control configuration
+ */
+/****************************************************************************/
+static void ReadTempCtrl(QDataStream &Stream, CANFctModuleTempCtrl &TempCtrl)
+{
+    qint32 Count = 0;
+
+    Stream >> TempCtrl.bTempTolerance >> TempCtrl.sSamplingPeriod >> TempCtrl.sFanSpeed >> TempCtrl.sFanThreshold
+           >> TempCtrl.sCurrentGain >> TempCtrl.sHeaterCurrent >> TempCtrl.sHeaterThreshold >> TempCtrl.sCurrentDeviation
+           >> TempCtrl.sCurrentMin230_Serial >> TempCtrl.sCurrentMax230_Serial
+           >> TempCtrl.sCurrentMin100_Serial >> TempCtrl.sCurrentMax100_Serial
+           >> TempCtrl.sCurrentMin100_Parallel >> TempCtrl.sCurrentMax100_Parallel;
+
+    Stream >> Count;
+    for (qint32 i = 0; (i < Count) && (Stream.status() == QDataStream::Ok); i++)
+    {
+        CANFctPidController Pid;
+        Stream >> Pid.sMaxTemperature >> Pid.sControllerGain >> Pid.sResetTime >> Pid.sDerivativeTime;
+        TempCtrl.listPidControllers.append(Pid);
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes the fields of a pressure control configuration
+ *
+ *  \iparam Stream = Destination
+ *  \iparam PressureCtrl = Pressure control configuration
+ */
+/****************************************************************************/
+static void WritePressureCtrl(QDataStream &Stream, const CANFctModulePressureCtrl &PressureCtrl)
+{
+    Stream << PressureCtrl.bPressureTolerance << PressureCtrl.sSamplingPeriod << PressureCtrl.sFanCurrent
+           << PressureCtrl.sFanCurrentGain << PressureCtrl.sFanThreshold << PressureCtrl.sCurrentGain
+           << PressureCtrl.sPumpCurrent << PressureCtrl.sPumpThreshold;
+
+    Stream << static_cast<qint32>(PressureCtrl.listPidControllers.count());
+    for (int i = 0; i < PressureCtrl.listPidControllers.count(); i++)
+    {
+        const CANPressureFctPidController &Pid = PressureCtrl.listPidControllers.at(i);
+        Stream << Pid.sMaxPressure << Pid.sMinPressure << Pid.sControllerGain << Pid.sResetTime << Pid.sDerivativeTime;
+    }
+
+    Stream << PressureCtrl.pwmController.sMaxActuatingValue << PressureCtrl.pwmController.sMinActuatingValue
+           << PressureCtrl.pwmController.sMaxPwmDuty << PressureCtrl.pwmController.sMinPwmDuty;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads the fields of a pressure control configuration
+ *
+ *  \iparam Stream = Source
+ *  \oparam PressureCtrl = Pressure control configuration
+ */
+/****************************************************************************/
+static void ReadPressureCtrl(QDataStream &Stream, CANFctModulePressureCtrl &PressureCtrl)
+{
+    qint32 Count = 0;
+
+    Stream >> PressureCtrl.bPressureTolerance >> PressureCtrl.sSamplingPeriod >> PressureCtrl.sFanCurrent
+           >> PressureCtrl.sFanCurrentGain >> PressureCtrl.sFanThreshold >> PressureCtrl.sCurrentGain
+           >> PressureCtrl.sPumpCurrent >> PressureCtrl.sPumpThreshold;
+
+    Stream >> Count;
+    for (qint32 i = 0; (i < Count) && (Stream.status() == QDataStream::Ok); i++)
+    {
+        CANPressureFctPidController Pid;
+        Stream >> Pid.sMaxPressure >> Pid.sMinPressure >> Pid.sControllerGain >> Pid.sResetTime >> Pid.sDerivativeTime;
+        PressureCtrl.listPidControllers.append(Pid);
+    }
+
+    Stream >> PressureCtrl.pwmController.sMaxActuatingValue >> PressureCtrl.pwmController.sMinActuatingValue
+           >> PressureCtrl.pwmController.sMaxPwmDuty >> PressureCtrl.pwmController.sMinPwmDuty;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor
+ *
+ *  \iparam SourceFileName = Path of the xml file
+ *  \iparam Format = Content of the snapshot
+ */
+/****************************************************************************/
+ConfigurationSnapshot::ConfigurationSnapshot(const QString &SourceFileName, Format_t Format) :
+    m_SourceFileName(SourceFileName),
+    m_Format(Format)
+{
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the path of the snapshot belonging to an xml file
+ *
+ *  \iparam SourceFileName = Path of the xml file
+ *
+ *  \return Path of the snapshot
+ */
+/****************************************************************************/
+QString ConfigurationSnapshot::SnapshotFileName(const QString &SourceFileName)
+{
+    QFileInfo Source(SourceFileName);
+    return Source.path() + "/" + Source.completeBaseName() + ".snapshot";
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads the snapshot if it matches the xml file
+ *
+ *  \oparam Data = Serialized configuration
+ *
+ *  \return true if the snapshot is valid
+ */
+/****************************************************************************/
+bool ConfigurationSnapshot::Read(QByteArray &Data)
+{
+    quint32 Magic = 0;
+    quint32 Version = 0;
+    quint32 Format = 0;
+    QByteArray SourceHash;
+    QByteArray DataHash;
+
+    Data.clear();
+
+    QFile File(SnapshotFileName(m_SourceFileName));
+    if (!File.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream Stream(&File);
+    Stream.setVersion(STREAM_VERSION);
+    Stream >> Magic >> Version >> Format;
+    if ((Magic != SNAPSHOT_MAGIC) || (Version != SNAPSHOT_VERSION) || (Format != static_cast<quint32>(m_Format)))
+    {
+        return false;
+    }
+    Stream >> SourceHash >> Data >> DataHash;
+    File.close();
+
+    if (m_SourceHash.isEmpty())
+    {
+        m_SourceHash = HashFile(m_SourceFileName);
+    }
+    if ((Stream.status() != QDataStream::Ok) || m_SourceHash.isEmpty() || (SourceHash != m_SourceHash) ||
+        (QCryptographicHash::hash(Data, QCryptographicHash::Sha1) != DataHash))
+    {
+        Data.clear();
+        return false;
+    }
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Writes the snapshot of the xml file
+ *
+ *      The snapshot is written to a temporary file which replaces the old
+ *      one, so a reader never sees a partly written snapshot.
+ *
+ *  \iparam Data = Serialized configuration
+ *
+ *  \return true if successful
+ */
+/****************************************************************************/
+bool ConfigurationSnapshot::Write(const QByteArray &Data)
+{
+    if (m_SourceHash.isEmpty())
+    {
+        m_SourceHash = HashFile(m_SourceFileName);
+        if (m_SourceHash.isEmpty())
+        {
+            return false;
+        }
+    }
+
+    QString FileName = SnapshotFileName(m_SourceFileName);
+    QString TempFileName = FileName + ".tmp";
+    QFile File(TempFileName);
+    if (!File.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    QDataStream Stream(&File);
+    Stream.setVersion(STREAM_VERSION);
+    Stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << static_cast<quint32>(m_Format)
+           << m_SourceHash << Data << QCryptographicHash::hash(Data, QCryptographicHash::Sha1);
+    File.close();
+
+    if ((Stream.status() != QDataStream::Ok) || (File.error() != QFile::NoError))
+    {
+        (void)QFile::remove(TempFileName);
+        return false;
+    }
+    (void)QFile::remove(FileName);
+    return QFile::rename(TempFileName, FileName);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes a CAN object configuration
+ *
+ *      The parent is stored by its key.
+ *
+ *  \iparam Stream = Destination
+ *  \iparam Config = CAN node or function module configuration
+ */
+/****************************************************************************/
+void ConfigurationSnapshot::WriteModuleConfig(QDataStream &Stream, const CModuleConfig &Config)
+{
+    Stream << static_cast<qint32>(Config.m_ObjectType) << Config.m_strKey << Config.m_strName << Config.m_IsVirtual
+           << Config.m_sCANNodeType << Config.m_sCANNodeIndex
+           << ((Config.pParent != 0) ? Config.pParent->m_strKey : QString())
+           << Config.m_sChannel << Config.m_sOrderNr;
+
+    switch (Config.m_ObjectType)
+    {
+        case CModuleConfig::CAN_OBJ_TYPE_DIGITAL_IN_PORT:
+        {
+            const CANFctModuleDigitInput &Input = static_cast<const CANFctModuleDigitInput &>(Config);
+            Stream << Input.m_bEnabled << Input.m_bTimeStamp << Input.m_sPolarity << Input.m_sThreshold
+                   << Input.m_bInterval << Input.m_bDebounce;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_DIGITAL_OUT_PORT:
+        {
+            const CANFctModuleDigitOutput &Output = static_cast<const CANFctModuleDigitOutput &>(Config);
+            Stream << Output.m_bEnabled << Output.m_bInaktivAtShutdown << Output.m_bInaktivAtEmgyStop
+                   << Output.m_sPolarity << Output.m_sOutvalInactiv << Output.m_sLivetimeLimit;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_ANALOG_IN_PORT:
+        {
+            const CANFctModuleAnalogInput &Input = static_cast<const CANFctModuleAnalogInput &>(Config);
+            Stream << Input.m_bEnabled << Input.m_bTimeStamp << Input.m_bFastSampling << Input.m_sLimitAutoSend
+                   << Input.m_sInterval << Input.m_sDebounce
+                   << Input.m_bLimitValue1SendExceed << Input.m_bLimitValue1SendBelow
+                   << Input.m_bLimitValue1SendWarnMsg << Input.m_bLimitValue1SendDataMsg << Input.m_sLimitValue1
+                   << Input.m_bLimitValue2SendExceed << Input.m_bLimitValue2SendBelow
+                   << Input.m_bLimitValue2SendWarnMsg << Input.m_bLimitValue2SendDataMsg << Input.m_sLimitValue2
+                   << Input.m_sHysteresis;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_ANALOG_OUT_PORT:
+        {
+            const CANFctModuleAnalogOutput &Output = static_cast<const CANFctModuleAnalogOutput &>(Config);
+            Stream << Output.m_bEnabled << Output.m_bInaktivAtShutdown << Output.m_bInaktivAtEmgyStop
+                   << Output.m_sMode << Output.m_sBitCount << Output.m_sOutvalInactiv << Output.m_sLivetimeLimit;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_STEPPERMOTOR:
+            WriteStepperMotor(Stream, static_cast<const CANFctModuleStepperMotor &>(Config));
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_RFID15693:
+        {
+            const CANFctModuleRFID15693 &Rfid = static_cast<const CANFctModuleRFID15693 &>(Config);
+            Stream << Rfid.m_bType << Rfid.m_bProtocol << Rfid.m_DataRate;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_TEMPERATURE_CTL:
+            WriteTempCtrl(Stream, static_cast<const CANFctModuleTempCtrl &>(Config));
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_PRESSURE_CTL:
+            WritePressureCtrl(Stream, static_cast<const CANFctModulePressureCtrl &>(Config));
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_JOYSTICK:
+        {
+            const CANFctModuleJoystick &Joystick = static_cast<const CANFctModuleJoystick &>(Config);
+            Stream << Joystick.m_bCommModeThresHold << Joystick.m_sSampleRate
+                   << Joystick.m_sUpperThreshold << Joystick.m_sLowerThreshold;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_UART:
+        {
+            const CANFctModuleUART &Uart = static_cast<const CANFctModuleUART &>(Config);
+            Stream << Uart.m_bEnabled << Uart.m_bReadCommunicationMode << Uart.m_bStopBits
+                   << Uart.m_bParityEnabled << Uart.m_bParity << Uart.m_sBaudrate;
+            break;
+        }
+        default:
+            // CAN nodes, RFID11785 and other modules have no further fields
+            break;
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Creates a CAN object configuration from its serialized data
+ *
+ *  \iparam Stream = Source
+ *  \oparam ParentKey = Key of the parent, empty for a CAN node
+ *
+ *  \return The configuration, NULL if the data is invalid
+ */
+/****************************************************************************/
+CModuleConfig *ConfigurationSnapshot::ReadModuleConfig(QDataStream &Stream, QString &ParentKey)
+{
+    CModuleConfig::CANObjectType_t ObjectType = CModuleConfig::CAN_OBJ_TYPE_UNDEF;
+    CModuleConfig *pConfig = 0;
+
+    ReadEnum(Stream, ObjectType);
+
+    // the classes are the ones created by HardwareConfiguration::ParseFunctionModule
+    switch (ObjectType)
+    {
+        case CModuleConfig::CAN_OBJ_TYPE_NODE:
+        case CModuleConfig::CAN_OBJ_TYPE_OTHER:
+            pConfig = new CModuleConfig();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_DIGITAL_IN_PORT:
+            pConfig = new CANFctModuleDigitInput();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_DIGITAL_OUT_PORT:
+            pConfig = new CANFctModuleDigitOutput();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_ANALOG_IN_PORT:
+            pConfig = new CANFctModuleAnalogInput();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_ANALOG_OUT_PORT:
+            pConfig = new CANFctModuleAnalogOutput();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_STEPPERMOTOR:
+            pConfig = new CANFctModuleStepperMotor();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_RFID11785:
+            pConfig = new CANFctModuleRFID11785();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_RFID15693:
+            pConfig = new CANFctModuleRFID15693();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_TEMPERATURE_CTL:
+            pConfig = new CANFctModuleTempCtrl();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_PRESSURE_CTL:
+            pConfig = new CANFctModulePressureCtrl();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_JOYSTICK:
+            pConfig = new CANFctModuleJoystick();
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_UART:
+            pConfig = new CANFctModuleUART();
+            break;
+        default:
+            return 0;
+    }
+
+    pConfig->m_ObjectType = ObjectType;
+    Stream >> pConfig->m_strKey >> pConfig->m_strName >> pConfig->m_IsVirtual
+           >> pConfig->m_sCANNodeType >> pConfig->m_sCANNodeIndex >> ParentKey
+           >> pConfig->m_sChannel >> pConfig->m_sOrderNr;
+
+    switch (ObjectType)
+    {
+        case CModuleConfig::CAN_OBJ_TYPE_DIGITAL_IN_PORT:
+        {
+            CANFctModuleDigitInput &Input = static_cast<CANFctModuleDigitInput &>(*pConfig);
+            Stream >> Input.m_bEnabled >> Input.m_bTimeStamp >> Input.m_sPolarity >> Input.m_sThreshold
+                   >> Input.m_bInterval >> Input.m_bDebounce;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_DIGITAL_OUT_PORT:
+        {
+            CANFctModuleDigitOutput &Output = static_cast<CANFctModuleDigitOutput &>(*pConfig);
+            Stream >> Output.m_bEnabled >> Output.m_bInaktivAtShutdown >> Output.m_bInaktivAtEmgyStop
+                   >> Output.m_sPolarity >> Output.m_sOutvalInactiv >> Output.m_sLivetimeLimit;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_ANALOG_IN_PORT:
+        {
+            CANFctModuleAnalogInput &Input = static_cast<CANFctModuleAnalogInput &>(*pConfig);
+            Stream >> Input.m_bEnabled >> Input.m_bTimeStamp >> Input.m_bFastSampling >> Input.m_sLimitAutoSend
+                   >> Input.m_sInterval >> Input.m_sDebounce
+                   >> Input.m_bLimitValue1SendExceed >> Input.m_bLimitValue1SendBelow
+                   >> Input.m_bLimitValue1SendWarnMsg >> Input.m_bLimitValue1SendDataMsg >> Input.m_sLimitValue1
+                   >> Input.m_bLimitValue2SendExceed >> Input.m_bLimitValue2SendBelow
+                   >> Input.m_bLimitValue2SendWarnMsg >> Input.m_bLimitValue2SendDataMsg >> Input.m_sLimitValue2
+                   >> Input.m_sHysteresis;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_ANALOG_OUT_PORT:
+        {
+            CANFctModuleAnalogOutput &Output = static_cast<CANFctModuleAnalogOutput &>(*pConfig);
+            Stream >> Output.m_bEnabled >> Output.m_bInaktivAtShutdown >> Output.m_bInaktivAtEmgyStop
+                   >> Output.m_sMode >> Output.m_sBitCount >> Output.m_sOutvalInactiv >> Output.m_sLivetimeLimit;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_STEPPERMOTOR:
+            ReadStepperMotor(Stream, static_cast<CANFctModuleStepperMotor &>(*pConfig));
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_RFID15693:
+        {
+            CANFctModuleRFID15693 &Rfid = static_cast<CANFctModuleRFID15693 &>(*pConfig);
+            Stream >> Rfid.m_bType >> Rfid.m_bProtocol >> Rfid.m_DataRate;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_TEMPERATURE_CTL:
+            ReadTempCtrl(Stream, static_cast<CANFctModuleTempCtrl &>(*pConfig));
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_PRESSURE_CTL:
+            ReadPressureCtrl(Stream, static_cast<CANFctModulePressureCtrl &>(*pConfig));
+            break;
+        case CModuleConfig::CAN_OBJ_TYPE_JOYSTICK:
+        {
+            CANFctModuleJoystick &Joystick = static_cast<CANFctModuleJoystick &>(*pConfig);
+            Stream >> Joystick.m_bCommModeThresHold >> Joystick.m_sSampleRate
+                   >> Joystick.m_sUpperThreshold >> Joystick.m_sLowerThreshold;
+            break;
+        }
+        case CModuleConfig::CAN_OBJ_TYPE_UART:
+        {
+            CANFctModuleUART &Uart = static_cast<CANFctModuleUART &>(*pConfig);
+            Stream >> Uart.m_bEnabled >> Uart.m_bReadCommunicationMode >> Uart.m_bStopBits
+                   >> Uart.m_bParityEnabled >> Uart.m_bParity >> Uart.m_sBaudrate;
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (Stream.status() != QDataStream::Ok)
+    {
+        delete pConfig;
+        return 0;
+    }
+    return pConfig;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes a device configuration
+ *
+ *  \iparam Stream = Destination
+ *  \iparam Config = Device configuration
+ */
+/****************************************************************************/
+void ConfigurationSnapshot::WriteDeviceConfig(QDataStream &Stream, const BaseDeviceConfiguration &Config)
+{
+    Stream << Config.m_Type << Config.m_InstanceID << Config.m_Optional << Config.m_OrderNr << Config.m_ModuleList;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Creates a device configuration from its serialized data
+ *
+ *  \iparam Stream = Source
+ *
+ *  \return The configuration, NULL if the data is invalid
+ */
+/****************************************************************************/
+BaseDeviceConfiguration *ConfigurationSnapshot::ReadDeviceConfig(QDataStream &Stream)
+{
+    BaseDeviceConfiguration *pConfig = new BaseDeviceConfiguration();
+
+    Stream >> pConfig->m_Type >> pConfig->m_InstanceID >> pConfig->m_Optional >> pConfig->m_OrderNr >> pConfig->m_ModuleList;
+    if (Stream.status() != QDataStream::Ok)
+    {
+        delete pConfig;
+        return 0;
+    }
+    return pConfig;
+}
+
+} //namespace
@@ -23,6 +23,7 @@
 /****************************************************************************/
 
 #include "DeviceControl/Include/Configuration/HardwareConfiguration.h"
+#include "DeviceControl/Include/Configuration/ConfigurationSnapshot.h"
 #include "DeviceControl/Include/Devices/BaseDevice.h"
 #include "DeviceControl/Include/Global/dcl_log.h"
 #include "Global/Include/SystemPaths.h"
@@ -107,6 +108,14 @@ ReturnCode_t HardwareConfiguration::ReadHWSpecification(QString HWConfigFileName
     FILE_LOG_L(laINIT, llDEBUG2) << "*******************************************";
     FILE_LOG_L(laINIT, llINFO) << " HardwareConfiguration: ReadHWSpecification";
 
+    // the snapshot is valid as long as the xml file is unchanged
+    ConfigurationSnapshot Snapshot(HWConfigFileName, ConfigurationSnapshot::FORMAT_HARDWARE);
+    if (ReadSnapshot(Snapshot))
+    {
+        FILE_LOG_L(laINIT, llINFO) << " HardwareConfiguration: read from snapshot";
+        return DCL_ERR_FCT_CALL_SUCCESS;
+    }
+
     if (!file.open(QFile::ReadOnly | QFile::Text))
     {
         m_strErrorInfo = QObject::tr("Cannot read file %1:\n%2.")
@@ -197,12 +206,143 @@ ReturnCode_t HardwareConfiguration::ReadHWSpecification(QString HWConfigFileName
         child = child.nextSiblingElement("device");
     }
 
+    if (retval == DCL_ERR_FCT_CALL_SUCCESS)
+    {
+        WriteSnapshot(Snapshot);
+    }
+
     FILE_LOG_L(laINIT, llDEBUG2) << " HardwareConfiguration: ReadHWSpecification finished.";
     FILE_LOG_L(laINIT, llDEBUG2) << "*****************************************************";
 
     return retval;
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Reads the configuration from the snapshot of the xml file
+ *
+ *      The configuration is taken over only if the whole snapshot is valid.
+ *      The parents of the function modules are stored by their keys and
+ *      resolved when all objects are read.
+ *
+ *  \iparam Snapshot = Snapshot of the hardware specification file
+ *
+ *  \return true if the snapshot was valid and is read
+ */
+/****************************************************************************/
+bool HardwareConfiguration::ReadSnapshot(ConfigurationSnapshot &Snapshot)
+{
+    QByteArray Data;
+    qint32 Count = 0;
+    CANObjectCfgList ObjectList;
+    QHash<QString, QString> ParentKeys;
+    DeviceCfgList DeviceList;
+
+    if (!m_CANObjectCfgList.isEmpty() || !m_DeviceCfgList.isEmpty() || !Snapshot.Read(Data))
+    {
+        return false;
+    }
+
+    QDataStream Stream(Data);
+    Stream.setVersion(ConfigurationSnapshot::STREAM_VERSION);
+    bool Valid = true;
+
+    Stream >> Count;
+    for (qint32 i = 0; Valid && (i < Count) && (Stream.status() == QDataStream::Ok); i++)
+    {
+        QString ParentKey;
+        CModuleConfig* pConfig = ConfigurationSnapshot::ReadModuleConfig(Stream, ParentKey);
+        if ((pConfig == 0) || ObjectList.contains(pConfig->m_strKey))
+        {
+            delete pConfig;
+            Valid = false;
+        }
+        else
+        {
+            ObjectList.insert(pConfig->m_strKey, pConfig);
+            if (!ParentKey.isEmpty())
+            {
+                ParentKeys.insert(pConfig->m_strKey, ParentKey);
+            }
+        }
+    }
+
+    QHash<QString, QString>::const_iterator iterParent = ParentKeys.constBegin();
+    for (; Valid && (iterParent != ParentKeys.constEnd()); ++iterParent)
+    {
+        CModuleConfig* pParent = ObjectList.value(iterParent.value(), 0);
+        if (pParent == 0)
+        {
+            Valid = false;
+        }
+        else
+        {
+            ObjectList.value(iterParent.key())->pParent = pParent;
+        }
+    }
+
+    if (Valid)
+    {
+        Stream >> Count;
+    }
+    for (qint32 i = 0; Valid && (i < Count) && (Stream.status() == QDataStream::Ok); i++)
+    {
+        BaseDeviceConfiguration* pDevConfig = ConfigurationSnapshot::ReadDeviceConfig(Stream);
+        if (pDevConfig == 0)
+        {
+            Valid = false;
+        }
+        else
+        {
+            DeviceList.append(pDevConfig);
+        }
+    }
+
+    if (!Valid || (Stream.status() != QDataStream::Ok) || !Stream.atEnd())
+    {
+        FILE_LOG_L(laINIT, llWARNING) << " HardwareConfiguration: snapshot invalid, read xml file";
+        qDeleteAll(ObjectList);
+        qDeleteAll(DeviceList);
+        return false;
+    }
+
+    m_CANObjectCfgList = ObjectList;
+    m_DeviceCfgList = DeviceList;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Writes the parsed configuration to the snapshot of the xml file
+ *
+ *  \iparam Snapshot = Snapshot of the hardware specification file
+ */
+/****************************************************************************/
+void HardwareConfiguration::WriteSnapshot(ConfigurationSnapshot &Snapshot) const
+{
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(ConfigurationSnapshot::STREAM_VERSION);
+
+    Stream << static_cast<qint32>(m_CANObjectCfgList.count());
+    CANObjectCfgList::const_iterator iter = m_CANObjectCfgList.constBegin();
+    for (; iter != m_CANObjectCfgList.constEnd(); ++iter)
+    {
+        ConfigurationSnapshot::WriteModuleConfig(Stream, *iter.value());
+    }
+
+    Stream << static_cast<qint32>(m_DeviceCfgList.count());
+    for (int i = 0; i < m_DeviceCfgList.count(); i++)
+    {
+        ConfigurationSnapshot::WriteDeviceConfig(Stream, *m_DeviceCfgList.at(i));
+    }
+
+    if (!Snapshot.Write(Data))
+    {
+        FILE_LOG_L(laINIT, llWARNING) << " HardwareConfiguration: cannot write snapshot";
+    }
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Parse device element from xml
@@ -0,0 +1,154 @@
+/****************************************************************************/
+/*! \file BootTimeline.cpp
+ *
+ *  \brief  Implementation file for class CBootTimeline.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class CBootTimeline
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/DeviceProcessing/BootTimeline.h"
+#include "DeviceControl/Include/Global/dcl_log.h"
+
+#include <QHash>
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the class CBootTimeline
+ */
+/****************************************************************************/
+CBootTimeline::CBootTimeline() : m_Running(false)
+{
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the time line of the device control
+ *
+ *  \return The time line
+ */
+/****************************************************************************/
+CBootTimeline &CBootTimeline::Instance()
+{
+    static CBootTimeline Timeline;
+    return Timeline;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Starts a new time line, discards the marks of a previous one
+ */
+/****************************************************************************/
+void CBootTimeline::Start()
+{
+    m_Entries.clear();
+    m_Clock.start();
+    m_Running = true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Marks the end of a phase of the device processing
+ *
+ *  \iparam Phase = Name of the phase
+ */
+/****************************************************************************/
+void CBootTimeline::Mark(const QString &Phase)
+{
+    Add(QString(), Phase);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Marks a configuration step of a CAN node
+ *
+ *  \iparam NodeKey = Key of the CAN node
+ *  \iparam Step = Name of the step
+ */
+/****************************************************************************/
+void CBootTimeline::MarkNode(const QString &NodeKey, const QString &Step)
+{
+    Add(NodeKey, Step);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds a mark if the time line is running
+ *
+ *  \iparam Source = Empty for a phase, otherwise the node key
+ *  \iparam Step = Phase or configuration step
+ */
+/****************************************************************************/
+void CBootTimeline::Add(const QString &Source, const QString &Step)
+{
+    if (!m_Running)
+    {
+        return;
+    }
+
+    Entry_t Entry;
+    Entry.Source = Source;
+    Entry.Step = Step;
+    Entry.Time = m_Clock.elapsed();
+    m_Entries.append(Entry);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Writes the time line to the log and stops it
+ *
+ *      Each line shows the time since the start and, in brackets, the time
+ *      since the previous mark of the same source.
+ */
+/****************************************************************************/
+void CBootTimeline::Finish()
+{
+    if (!m_Running)
+    {
+        return;
+    }
+    m_Running = false;
+
+    QHash<QString, qint64> LastTime;
+
+    FILE_LOG_L(laINIT, llINFO) << " Boot time line:";
+    for (int i = 0; i < m_Entries.count(); i++)
+    {
+        const Entry_t &Entry = m_Entries.at(i);
+        qint64 Delta = Entry.Time - LastTime.value(Entry.Source, 0);
+        LastTime.insert(Entry.Source, Entry.Time);
+
+        if (Entry.Source.isEmpty())
+        {
+            FILE_LOG_L(laINIT, llINFO) << "  " << Entry.Time << " ms (+" << Delta << "): "
+                                       << Entry.Step.toStdString();
+        }
+        else
+        {
+            FILE_LOG_L(laINIT, llINFO) << "  " << Entry.Time << " ms (+" << Delta << "): node "
+                                       << Entry.Source.toStdString() << " " << Entry.Step.toStdString();
+        }
+    }
+    FILE_LOG_L(laINIT, llINFO) << " Boot time line: total " << m_Clock.elapsed() << " ms";
+
+    m_Entries.clear();
+}
+
+} //namespace
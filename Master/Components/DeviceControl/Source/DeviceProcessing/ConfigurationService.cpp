@@ -28,6 +28,7 @@
 #include <QtDebug>
 
 #include "DeviceControl/Include/DeviceProcessing/ConfigurationService.h"
+#include "DeviceControl/Include/DeviceProcessing/BootTimeline.h"
 #include "DeviceControl/Include/Interface/IDeviceProcessing.h"
 #include "DeviceControl/Include/Devices/BaseDevice.h"
 #include "DeviceControl/Include/Devices/RotaryValveDevice.h"
@@ -118,11 +119,15 @@ void CConfigurationService::ThrowErrorSignal(quint16 usNodeID, quint32 ulModulIn
 /****************************************************************************/
 void CConfigurationService::HandleTasks()
 {
+    // States which do not wait for anything fall through to the next one
+    // within the same call, so the configuration is not delayed by a
+    // device processing cycle per state.
     if(m_MainState == CS_MAIN_STATE_INIT)
     {
         m_MainState = CS_MAIN_STATE_CREATE_CANOBJECTS;
     }
-    else if(m_MainState == CS_MAIN_STATE_CREATE_CANOBJECTS)
+
+    if(m_MainState == CS_MAIN_STATE_CREATE_CANOBJECTS)
     {
         ReturnCode_t RetVal;
 
@@ -132,6 +137,7 @@ void CConfigurationService::HandleTasks()
         {
             m_pDeviceProcessing->LogObjectTree(0);
             m_MainState = CS_MAIN_STATE_CONFIG_WAIT_CANOBJECTS;
+            m_stateTimer.Trigger();
         }
         else
         {
@@ -147,10 +153,12 @@ void CConfigurationService::HandleTasks()
         // Check if all CAN nodes already have switched to IDLE state
         ReturnCode_t RetVal = IsCANNodesStateIdle();
         if (RetVal == DCL_ERR_FCT_CALL_SUCCESS) {
+            CBootTimeline::Instance().Mark("CAN nodes configured");
             m_MainState = CS_MAIN_STATE_CREATE_DEVICES;
             m_ConfigurationComplete = true;
         }
         else if (RetVal == DCL_ERR_TIMEOUT) {
+            CBootTimeline::Instance().Mark("CAN nodes configuration timed out");
             m_MainState = CS_MAIN_STATE_CREATE_DEVICES;
             m_ConfigurationComplete = false;
         }
@@ -163,11 +171,13 @@ void CConfigurationService::HandleTasks()
             m_ConfigurationComplete = false;
         }
     }
-    else if(m_MainState == CS_MAIN_STATE_CREATE_DEVICES)
+
+    if(m_MainState == CS_MAIN_STATE_CREATE_DEVICES)
     {
         m_MainState = CS_MAIN_STATE_FORWARD_CONFIGURATION;
     }
-    else if(m_MainState == CS_MAIN_STATE_FORWARD_CONFIGURATION)
+
+    if(m_MainState == CS_MAIN_STATE_FORWARD_CONFIGURATION)
     {
         ReturnCode_t rcHWConfig;
 
@@ -238,6 +248,7 @@ ReturnCode_t CConfigurationService::CreateDeviceComponents()
     // The configuration information is stored inside the HardwareConfiguration class
     HardwareConfiguration Configuration;
     ReturnCode_t RetVal = Configuration.ReadHWSpecification(DeviceProcessing::GetHWConfigFile());
+    CBootTimeline::Instance().Mark("hardware configuration read");
 
     if (RetVal != DCL_ERR_FCT_CALL_SUCCESS) {
         QString strErrorInfo;
@@ -251,8 +262,10 @@ ReturnCode_t CConfigurationService::CreateDeviceComponents()
     }
     else {
         RetVal = CreateObjectTree(&Configuration);
+        CBootTimeline::Instance().Mark("object tree created");
         if(RetVal == DCL_ERR_FCT_CALL_SUCCESS) {
             RetVal = CreateDevices(&Configuration);
+            CBootTimeline::Instance().Mark("devices created");
         }
     }
 
@@ -692,7 +705,6 @@ ReturnCode_t CConfigurationService::CreateDiscoveredHWConfiguration()
 /****************************************************************************/
 ReturnCode_t CConfigurationService::IsCANNodesStateIdle()
 {
-    static unsigned int counter = 0;
     ReturnCode_t retCode = DCL_ERR_FCT_CALL_SUCCESS;
     CBaseModule* pCANNode;
 
@@ -724,9 +736,9 @@ ReturnCode_t CConfigurationService::IsCANNodesStateIdle()
         pCANNode = m_pDeviceProcessing->GetCANNodeFromObjectTree(false);
     }
 
-    counter++;
-    if (counter > 1000) {
-        counter = 0;
+    // the device processing runs more often while CAN messages arrive, so
+    // the timeout is measured in time, not in calls
+    if ((retCode == DCL_ERR_INVALID_STATE) && (m_stateTimer.Elapsed() > CAN_NODE_TIMEOUT_CONFIG_IDLE)) {
         pCANNode = m_pDeviceProcessing->GetCANNodeFromObjectTree(true);
         while(pCANNode) {
             if (pCANNode->GetMainState() != CBaseModule::CN_MAIN_STATE_IDLE &&
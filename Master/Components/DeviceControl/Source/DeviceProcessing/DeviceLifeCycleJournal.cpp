@@ -0,0 +1,372 @@
+/****************************************************************************/
+/*! \file DeviceLifeCycleJournal.cpp
+ *
+ *  \brief  Implementation file for class DeviceLifeCycleJournal.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class DeviceLifeCycleJournal
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/DeviceProcessing/DeviceLifeCycleJournal.h"
+#include "DeviceControl/Include/SlaveModules/FirmwareTransfer.h"
+#include "DeviceControl/Include/Global/dcl_log.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QtEndian>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace DeviceControl
+{
+
+const quint32 DeviceLifeCycleJournal::JOURNAL_MAGIC;
+const quint32 DeviceLifeCycleJournal::JOURNAL_VERSION;
+const qint64 DeviceLifeCycleJournal::COMPACT_SIZE;
+const int DeviceLifeCycleJournal::HEADER_SIZE;
+const int DeviceLifeCycleJournal::RECORD_OVERHEAD;
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the class DeviceLifeCycleJournal
+ *
+ *  \iparam FileName = Path of the journal file
+ */
+/****************************************************************************/
+DeviceLifeCycleJournal::DeviceLifeCycleJournal(const QString &FileName) :
+    m_FileName(FileName), m_Size(0)
+{
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads all counters from the journal
+ *
+ *  \oparam Keys = Keys of the counters, by counter ID
+ *  \oparam Values = Values of the counters, by counter ID
+ *
+ *  \return false if there is no journal or its header is invalid
+ */
+/****************************************************************************/
+bool DeviceLifeCycleJournal::Replay(QList<CounterKey_t> &Keys, QList<quint32> &Values)
+{
+    Keys.clear();
+    Values.clear();
+    m_Pending.clear();
+    m_Size = 0;
+
+    QFile File(m_FileName);
+    if (!File.open(QIODevice::ReadWrite))
+    {
+        return false;
+    }
+
+    QByteArray Data = File.readAll();
+    const uchar *p_Data = reinterpret_cast<const uchar *>(Data.constData());
+    if ((Data.size() < HEADER_SIZE) || (qFromBigEndian<quint32>(p_Data) != JOURNAL_MAGIC) ||
+        (qFromBigEndian<quint32>(p_Data + 4) != JOURNAL_VERSION))
+    {
+        FILE_LOG_L(laDEVPROC, llWARNING) << " Life cycle journal " << m_FileName.toStdString() << " has no valid header";
+        return false;
+    }
+
+    int Position = HEADER_SIZE;
+    while (Position < Data.size())
+    {
+        int Length = ReadRecord(Data, Position, Keys, Values);
+        if (Length <= 0)
+        {
+            break;
+        }
+        Position += Length;
+    }
+
+    if (Position < Data.size())
+    {
+        FILE_LOG_L(laDEVPROC, llWARNING) << " Life cycle journal: discarding " << (Data.size() - Position)
+                                         << " bytes after offset " << Position;
+        if (!File.resize(Position))
+        {
+            return false;
+        }
+        (void)fsync(File.handle());
+    }
+
+    m_Size = Position;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds a DEFINE record to the next commit
+ *
+ *  \iparam ID = Counter ID, the number of counters defined before
+ *  \iparam Key = Keys of the counter
+ */
+/****************************************************************************/
+void DeviceLifeCycleJournal::AppendDefine(quint16 ID, const CounterKey_t &Key)
+{
+    AddRecord(m_Pending, RECORD_DEFINE, DefinePayload(ID, Key));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds a SET record to the next commit
+ *
+ *  \iparam ID = Counter ID
+ *  \iparam Value = New value of the counter
+ */
+/****************************************************************************/
+void DeviceLifeCycleJournal::AppendSet(quint16 ID, quint32 Value)
+{
+    AddRecord(m_Pending, RECORD_SET, SetPayload(ID, Value));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Appends the pending records to the journal file
+ *
+ *  \return true if successful
+ */
+/****************************************************************************/
+bool DeviceLifeCycleJournal::Commit()
+{
+    if (m_Pending.isEmpty())
+    {
+        return true;
+    }
+
+    QByteArray Data;
+    if (m_Size == 0)
+    {
+        Data = Header();
+    }
+    Data.append(m_Pending);
+    m_Pending.clear();
+
+    QFile File(m_FileName);
+    if (!File.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        return false;
+    }
+    if ((File.write(Data) != Data.size()) || !File.flush() || (fsync(File.handle()) != 0))
+    {
+        FILE_LOG_L(laDEVPROC, llERROR) << " Life cycle journal: append to " << m_FileName.toStdString() << " failed";
+        return false;
+    }
+    m_Size += Data.size();
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Replaces the journal by the current values of all counters
+ *
+ *  \iparam Keys = Keys of the counters, by counter ID
+ *  \iparam Values = Values of the counters, by counter ID
+ *
+ *  \return true if successful
+ */
+/****************************************************************************/
+bool DeviceLifeCycleJournal::Compact(const QList<CounterKey_t> &Keys, const QList<quint32> &Values)
+{
+    m_Pending.clear();
+
+    QByteArray Data = Header();
+    for (int ID = 0; ID < Keys.count(); ID++)
+    {
+        AddRecord(Data, RECORD_DEFINE, DefinePayload(ID, Keys.at(ID)));
+    }
+    for (int ID = 0; ID < Values.count(); ID++)
+    {
+        // a defined counter starts at 0
+        if (Values.at(ID) != 0)
+        {
+            AddRecord(Data, RECORD_SET, SetPayload(ID, Values.at(ID)));
+        }
+    }
+
+    const QString TempFileName = m_FileName + ".tmp";
+    QFile File(TempFileName);
+    if (!File.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+    if ((File.write(Data) != Data.size()) || !File.flush() || (fsync(File.handle()) != 0))
+    {
+        File.close();
+        (void)QFile::remove(TempFileName);
+        return false;
+    }
+    File.close();
+
+    // rename replaces the journal atomically, QFile::rename does not overwrite
+    if (::rename(TempFileName.toLocal8Bit().constData(), m_FileName.toLocal8Bit().constData()) != 0)
+    {
+        (void)QFile::remove(TempFileName);
+        return false;
+    }
+    m_Size = Data.size();
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the header of a journal file
+ *
+ *  \return Magic and version
+ */
+/****************************************************************************/
+QByteArray DeviceLifeCycleJournal::Header()
+{
+    QByteArray Data(HEADER_SIZE, 0);
+    uchar *p_Data = reinterpret_cast<uchar *>(Data.data());
+    qToBigEndian<quint32>(JOURNAL_MAGIC, p_Data);
+    qToBigEndian<quint32>(JOURNAL_VERSION, p_Data + 4);
+    return Data;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds a record to a buffer
+ *
+ *      A record consists of its type (1 byte), the payload length (2 bytes),
+ *      the payload and the CRC32 of all of this (4 bytes).
+ *
+ *  \iparam Buffer = Destination
+ *  \iparam Type = Type of the record
+ *  \iparam Payload = Payload of the record
+ */
+/****************************************************************************/
+void DeviceLifeCycleJournal::AddRecord(QByteArray &Buffer, RecordType_t Type, const QByteArray &Payload)
+{
+    QByteArray Record(3, 0);
+    uchar *p_Record = reinterpret_cast<uchar *>(Record.data());
+    p_Record[0] = static_cast<uchar>(Type);
+    qToBigEndian<quint16>(Payload.size(), p_Record + 1);
+    Record.append(Payload);
+
+    uchar Crc[4];
+    qToBigEndian<quint32>(CFirmwareTransfer::CalculateCrc(reinterpret_cast<const quint8 *>(Record.constData()),
+                                                          Record.size()), Crc);
+    Record.append(reinterpret_cast<const char *>(Crc), sizeof(Crc));
+    Buffer.append(Record);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes the payload of a DEFINE record
+ *
+ *  \iparam ID = Counter ID
+ *  \iparam Key = Keys of the counter
+ *
+ *  \return Payload
+ */
+/****************************************************************************/
+QByteArray DeviceLifeCycleJournal::DefinePayload(quint16 ID, const CounterKey_t &Key)
+{
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(QDataStream::Qt_4_8);
+    Stream << ID << Key.Device << Key.Part << Key.Param;
+    return Payload;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Serializes the payload of a SET record
+ *
+ *  \iparam ID = Counter ID
+ *  \iparam Value = Value of the counter
+ *
+ *  \return Payload
+ */
+/****************************************************************************/
+QByteArray DeviceLifeCycleJournal::SetPayload(quint16 ID, quint32 Value)
+{
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(QDataStream::Qt_4_8);
+    Stream << ID << Value;
+    return Payload;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Applies a record of the journal to the counters
+ *
+ *  \iparam Data = Journal file
+ *  \iparam Position = Offset of the record
+ *  \oparam Keys = Keys of the counters, by counter ID
+ *  \oparam Values = Values of the counters, by counter ID
+ *
+ *  \return Length of the record, 0 if it is incomplete or invalid
+ */
+/****************************************************************************/
+int DeviceLifeCycleJournal::ReadRecord(const QByteArray &Data, int Position, QList<CounterKey_t> &Keys,
+                                       QList<quint32> &Values)
+{
+    if (Data.size() - Position < RECORD_OVERHEAD)
+    {
+        return 0;
+    }
+
+    const uchar *p_Record = reinterpret_cast<const uchar *>(Data.constData()) + Position;
+    int Length = qFromBigEndian<quint16>(p_Record + 1);
+    if (Data.size() - Position < RECORD_OVERHEAD + Length)
+    {
+        return 0;
+    }
+    if (CFirmwareTransfer::CalculateCrc(p_Record, 3 + Length) != qFromBigEndian<quint32>(p_Record + 3 + Length))
+    {
+        return 0;
+    }
+
+    QDataStream Stream(Data.mid(Position + 3, Length));
+    Stream.setVersion(QDataStream::Qt_4_8);
+    quint16 ID = 0;
+    Stream >> ID;
+
+    if (p_Record[0] == RECORD_DEFINE)
+    {
+        CounterKey_t Key;
+        Stream >> Key.Device >> Key.Part >> Key.Param;
+        if ((Stream.status() != QDataStream::Ok) || (ID != Keys.count()))
+        {
+            return 0;
+        }
+        Keys.append(Key);
+        Values.append(0);
+    }
+    else if (p_Record[0] == RECORD_SET)
+    {
+        quint32 Value = 0;
+        Stream >> Value;
+        if ((Stream.status() != QDataStream::Ok) || (ID >= Keys.count()))
+        {
+            return 0;
+        }
+        Values[ID] = Value;
+    }
+    else
+    {
+        return 0;
+    }
+    return RECORD_OVERHEAD + Length;
+}
+
+} //namespace
@@ -19,26 +19,109 @@
 /****************************************************************************/
 
 #include "DeviceControl/Include/DeviceProcessing/DeviceLifeCycleRecord.h"
+#include "DeviceControl/Include/Global/dcl_log.h"
 #include <QTextStream>
 #include <QDomDocument>
 #include <QDomElement>
 #include <QFile>
+#include <QMutexLocker>
 #include <Global/Include/SystemPaths.h>
 #include <unistd.h>
 
 using namespace DeviceControl;
 
-DeviceLifeCycleRecord::DeviceLifeCycleRecord()
+const int DeviceLifeCycleRecord::MAX_COUNTERS;
+
+/**
+ * \brief Returns the directory of the record
+ * \iparam Path = directory given to the constructor
+ * \return directory
+*/
+static QString RecordDirectory(const QString& Path)
+{
+    return Path.isEmpty() ? Global::SystemPaths::Instance().GetSettingsPath() : Path;
+}
+
+PartLifeCycleRecord::PartLifeCycleRecord(DeviceLifeCycleRecord* pRecord, const QString& DeviceKey, const QString& PartKey)
+    : mp_Record(pRecord)
+    , m_DeviceKey(DeviceKey)
+    , m_PartKey(PartKey)
+{
+}
+
+quint32 PartLifeCycleRecord::GetValue(const QString& ParamKey) const
+{
+    int ID = GetCounterID(ParamKey);
+    return (ID < 0) ? 0 : mp_Record->GetValue(ID);
+}
+
+void PartLifeCycleRecord::SetValue(const QString& ParamKey, quint32 Value)
+{
+    int ID = AddParam(ParamKey);
+    if (ID >= 0)
+        mp_Record->SetValue(ID, Value);
+}
+
+quint32 PartLifeCycleRecord::Increment(const QString& ParamKey, quint32 Delta)
+{
+    int ID = AddParam(ParamKey);
+    return (ID < 0) ? 0 : mp_Record->Increment(ID, Delta);
+}
+
+int PartLifeCycleRecord::AddParam(const QString& ParamKey)
+{
+    int ID = GetCounterID(ParamKey);
+    if (ID < 0)
+        ID = mp_Record->RegisterCounter(m_DeviceKey, m_PartKey, ParamKey);
+    return ID;
+}
+
+DeviceLifeCycleRecord::DeviceLifeCycleRecord(const QString& Path)
+    : m_DeviceLifeCycleRecordFileName(RecordDirectory(Path) + "/" + "DeviceLifeCycleRecord.xml")
+    , m_Journal(RecordDirectory(Path) + "/" + "DeviceLifeCycleRecord.journal")
+    , m_Count(0)
+    , m_Defined(0)
+    , m_CompactPending(false)
 {
-     m_DeviceLifeCycleRecordFileName = Global::SystemPaths::Instance().GetSettingsPath() + "/" + "DeviceLifeCycleRecord.xml";
 }
 
 DeviceLifeCycleRecord::~DeviceLifeCycleRecord()
 {
+    (void)WriteRecord();
     FreeObjects();
 }
 
 bool DeviceLifeCycleRecord::ReadRecord()
+{
+    QMutexLocker Locker(&m_Mutex);
+    FreeObjects();
+
+    QList<DeviceLifeCycleJournal::CounterKey_t> Keys;
+    QList<quint32> Values;
+    if (m_Journal.Replay(Keys, Values))
+    {
+        for (int i = 0; i < Keys.count(); i++)
+        {
+            int ID = AddCounter(Keys.at(i));
+            if (ID < 0)
+                return false;
+            m_Values[ID].storeRelease(static_cast<int>(Values.at(i)));
+        }
+        m_Defined = m_Count.loadAcquire();
+        return true;
+    }
+
+    // no journal yet, take over the counters of the XML file
+    if (!ImportXml())
+    {
+        // replace the unreadable journal with the next write
+        m_CompactPending = true;
+        return false;
+    }
+    return Compact();
+}
+
+bool DeviceLifeCycleRecord::ImportXml()
 {
     QDomDocument domDocument;
     QDomElement root;
@@ -79,29 +162,27 @@ bool DeviceLifeCycleRecord::ReadRecord()
     QDomElement childDevice = child.firstChildElement("Device");
     while (!childDevice.isNull())
     {
-       QString keyDevice = childDevice.attribute("Key");
-       ModuleLifeCycleRecord* pModuleLifeCycleRecord = new ModuleLifeCycleRecord();
+       DeviceLifeCycleJournal::CounterKey_t Key;
+       Key.Device = childDevice.attribute("Key");
 
        QDomElement childFuncModule = childDevice.firstChildElement("Functionmodules").firstChildElement("Functionmodule");
        while (!childFuncModule.isNull())
        {
-            QString KeyFuncModule = childFuncModule.attribute("Key");
-            PartLifeCycleRecord* pPartRecord = new PartLifeCycleRecord();
+            Key.Part = childFuncModule.attribute("Key");
+            (void)GetPart(Key.Device, Key.Part);
             QDomElement childParameter = childFuncModule.firstChildElement("Parameter");
             while (!childParameter.isNull())
             {
-                QString KeyParam = childParameter.attribute("Key");
-                QString ValueParam = childParameter.attribute("Value");
-
-                pPartRecord->m_ParamMap.insert(KeyParam, ValueParam);
+                Key.Param = childParameter.attribute("Key");
+                int ID = AddCounter(Key);
+                if (ID >= 0)
+                    m_Values[ID].storeRelease(static_cast<int>(childParameter.attribute("Value").toUInt()));
                 childParameter = childParameter.nextSiblingElement("Parameter");
             }
 
-          pModuleLifeCycleRecord->m_PartLifeCycleMap.insert(KeyFuncModule, pPartRecord);
           childFuncModule = childFuncModule.nextSiblingElement("Functionmodule");
        }
 
-       m_ModuleLifeCycleMap.insert(keyDevice, pModuleLifeCycleRecord);
        childDevice = childDevice.nextSiblingElement("Device");
     }
     file.close();
@@ -109,6 +190,59 @@ bool DeviceLifeCycleRecord::ReadRecord()
 }
 
 bool DeviceLifeCycleRecord::WriteRecord()
+{
+    QMutexLocker Locker(&m_Mutex);
+    if (m_CompactPending || (m_Journal.GetSize() >= DeviceLifeCycleJournal::COMPACT_SIZE))
+    {
+        return Compact();
+    }
+
+    int Count = m_Count.loadAcquire();
+    for (int ID = m_Defined; ID < Count; ID++)
+    {
+        m_Journal.AppendDefine(ID, m_Keys.at(ID));
+    }
+    for (int ID = 0; ID < Count; ID++)
+    {
+        // clear the flag first, a change in between is written next time
+        if (m_Dirty[ID].fetchAndStoreOrdered(0) != 0)
+            m_Journal.AppendSet(ID, GetValue(ID));
+    }
+    m_Defined = Count;
+
+    if (!m_Journal.Commit())
+    {
+        // the tail of the journal may be torn, rewrite it
+        m_CompactPending = true;
+        return false;
+    }
+    return true;
+}
+
+bool DeviceLifeCycleRecord::Compact()
+{
+    int Count = m_Count.loadAcquire();
+    QList<quint32> Values;
+    for (int ID = 0; ID < Count; ID++)
+    {
+        m_Dirty[ID].storeRelease(0);
+        Values.append(GetValue(ID));
+    }
+
+    if (!m_Journal.Compact(m_Keys.mid(0, Count), Values))
+    {
+        FILE_LOG_L(laDEVPROC, llERROR) << " DeviceLifeCycleRecord: compacting the journal failed";
+        m_CompactPending = true;
+        return false;
+    }
+    m_Defined = Count;
+    m_CompactPending = false;
+
+    (void)ExportXml();
+    return true;
+}
+
+bool DeviceLifeCycleRecord::ExportXml()
 {
     QDomDocument domDocument;
     QDomElement root;
@@ -144,12 +278,12 @@ bool DeviceLifeCycleRecord::WriteRecord()
             PartLifeCycleRecord* partLifeCycleRecord = iterPart.value();
 
 
-                    QMapIterator<QString, QString> iterParam(partLifeCycleRecord->m_ParamMap);
+                    QMapIterator<QString, int> iterParam(partLifeCycleRecord->m_ParamMap);
                     while (iterParam.hasNext()) {
                         iterParam.next();
                         QDomElement parameterElement = domDocument.createElement("Parameter");
                         parameterElement.setAttribute("Key", iterParam.key());
-                        parameterElement.setAttribute("Value", iterParam.value());
+                        parameterElement.setAttribute("Value", QString::number(GetValue(iterParam.value())));
                         functionmoduleElement.appendChild(parameterElement);
                     }
 
@@ -171,6 +305,79 @@ bool DeviceLifeCycleRecord::WriteRecord()
     return true;
 }
 
+int DeviceLifeCycleRecord::RegisterCounter(const QString& DeviceKey, const QString& PartKey, const QString& ParamKey)
+{
+    QMutexLocker Locker(&m_Mutex);
+    DeviceLifeCycleJournal::CounterKey_t Key;
+    Key.Device = DeviceKey;
+    Key.Part = PartKey;
+    Key.Param = ParamKey;
+    return AddCounter(Key);
+}
+
+quint32 DeviceLifeCycleRecord::GetValue(int ID) const
+{
+    if ((ID < 0) || (ID >= m_Count.loadAcquire()))
+        return 0;
+    return static_cast<quint32>(m_Values[ID].loadAcquire());
+}
+
+void DeviceLifeCycleRecord::SetValue(int ID, quint32 Value)
+{
+    if ((ID < 0) || (ID >= m_Count.loadAcquire()))
+        return;
+    if (m_Values[ID].fetchAndStoreOrdered(static_cast<int>(Value)) != static_cast<int>(Value))
+        m_Dirty[ID].storeRelease(1);
+}
+
+quint32 DeviceLifeCycleRecord::Increment(int ID, quint32 Delta)
+{
+    if ((ID < 0) || (ID >= m_Count.loadAcquire()))
+        return 0;
+    quint32 Value = static_cast<quint32>(m_Values[ID].fetchAndAddOrdered(static_cast<int>(Delta))) + Delta;
+    m_Dirty[ID].storeRelease(1);
+    return Value;
+}
+
+PartLifeCycleRecord* DeviceLifeCycleRecord::GetPart(const QString& DeviceKey, const QString& PartKey)
+{
+    ModuleLifeCycleRecord* pModuleLifeCycleRecord = m_ModuleLifeCycleMap.value(DeviceKey);
+    if (!pModuleLifeCycleRecord)
+    {
+        pModuleLifeCycleRecord = new ModuleLifeCycleRecord();
+        m_ModuleLifeCycleMap.insert(DeviceKey, pModuleLifeCycleRecord);
+    }
+    PartLifeCycleRecord* pPartRecord = pModuleLifeCycleRecord->m_PartLifeCycleMap.value(PartKey);
+    if (!pPartRecord)
+    {
+        pPartRecord = new PartLifeCycleRecord(this, DeviceKey, PartKey);
+        pModuleLifeCycleRecord->m_PartLifeCycleMap.insert(PartKey, pPartRecord);
+    }
+    return pPartRecord;
+}
+
+int DeviceLifeCycleRecord::AddCounter(const DeviceLifeCycleJournal::CounterKey_t& Key)
+{
+    PartLifeCycleRecord* pPartRecord = GetPart(Key.Device, Key.Part);
+    int ID = pPartRecord->GetCounterID(Key.Param);
+    if (ID >= 0)
+        return ID;
+
+    ID = m_Count.loadAcquire();
+    if (ID >= MAX_COUNTERS)
+    {
+        FILE_LOG_L(laDEVPROC, llERROR) << " DeviceLifeCycleRecord: no room for counter " << Key.Device.toStdString()
+                                       << "/" << Key.Part.toStdString() << "/" << Key.Param.toStdString();
+        return -1;
+    }
+    m_Keys.append(Key);
+    m_Values[ID].storeRelease(0);
+    m_Dirty[ID].storeRelease(0);
+    pPartRecord->m_ParamMap.insert(Key.Param, ID);
+    m_Count.storeRelease(ID + 1);
+    return ID;
+}
+
 void DeviceLifeCycleRecord::FreeObjects()
 {
     QMapIterator<QString, ModuleLifeCycleRecord*> iter(m_ModuleLifeCycleMap);
@@ -187,6 +394,7 @@ void DeviceLifeCycleRecord::FreeObjects()
         delete pModuleLifeCycleRecord;
     }
     m_ModuleLifeCycleMap.clear();
+    m_Keys.clear();
+    m_Count.storeRelease(0);
+    m_Defined = 0;
 }
-
-
@@ -24,6 +24,7 @@
 #include "DeviceControl/Include/CanCommunication/CANCommunicator.h"
 #include "DeviceControl/Include/Configuration/CANMessageConfiguration.h"
 #include "DeviceControl/Include/DeviceProcessing/DeviceProcessing.h"
+#include "DeviceControl/Include/DeviceProcessing/BootTimeline.h"
 #include "DeviceControl/Include/DeviceProcessing/ConfigurationService.h"
 #include "DeviceControl/Include/DeviceProcessing/DiagnosticService.h"
 #include "DeviceControl/Include/DeviceProcessing/AdjustmentService.h"
@@ -78,6 +79,10 @@ QString DeviceProcessing::m_HWConfigFileName = "hw_specification.xml";
 
 QString DeviceProcessing::m_SerialNo = "";
 
+#define SCHEDULER_TICK_INTERVAL 10                  //!< Interval in ms a busy module is run in event mode
+#define SCHEDULER_NODE_INTERVAL 50                  //!< Interval in ms the nodes and devices are run in event mode
+#define SCHEDULER_LOG_INTERVAL  (10 * 60 * 1000)    //!< Interval in ms the scheduler statistics are logged
+
 /********************************************************************************/
 /*!
  *  \brief  Constructor of the class
@@ -88,7 +93,8 @@ QString DeviceProcessing::m_SerialNo = "";
  *  \iparam p_Parent = The parent object of this class.
  */
 /********************************************************************************/
-DeviceProcessing::DeviceProcessing(QObject *p_Parent) : QObject(p_Parent),m_canCommunicator(this),
+DeviceProcessing::DeviceProcessing(QObject *p_Parent) : QObject(p_Parent),m_Scheduler(this),m_canCommunicator(this),
+    m_SchedulerActive(false), m_SchedulerLogTime(0),
     m_pTaskConfig(0), m_pTaskNormalOperation(0), m_pTaskShutdown(0), m_pTaskDestroy(0),
     m_pTaskDiagnostic(0), m_pTaskAdjustment(0), m_pTaskFirmwareUpdate(0)
 {
@@ -109,6 +115,7 @@ DeviceProcessing::DeviceProcessing(QObject *p_Parent) : QObject(p_Parent),m_canC
     m_pShutdownService = 0;
 
     m_pFunctionModuleTaskManager = new CFunctionModuleTaskManager();
+    m_canCommunicator.SetScheduler(&m_Scheduler);
 
     m_ulCanIDMasterHeartbeat = 0;
     m_ulCANNodeIDMaster = 0;
@@ -860,6 +867,9 @@ void DeviceProcessing::HandleTasks()
     static DeviceProcTask* pActiveTask = NULL;
     static DeviceProcTask::TaskID_t stTaskID = DeviceProcTask::TASK_ID_DP_UNDEF;
 
+    // set again, if the event driven scheduler handles this pass
+    m_SchedulerActive = false;
+
 /*
     //Performance check initialisation
     if (PerformanceCheck)
@@ -889,7 +899,9 @@ void DeviceProcessing::HandleTasks()
 
             RegisterMetaTypes();
 
+            CBootTimeline::Instance().Start();
             retCodeCfg = ReadConfiguration();
+            CBootTimeline::Instance().Mark("CAN message configuration read");
             if(retCodeCfg == DCL_ERR_FCT_CALL_SUCCESS)
             {
                 FILE_LOG_L(laDEVPROC, llINFO) << "DeviceProcessing: DP_MAIN_STATE_INTERNAL_CONFIG finished -> change to DP_MAIN_STATE_WAIT_FOR_CONFIG";
@@ -901,6 +913,7 @@ void DeviceProcessing::HandleTasks()
             else
             {
                 // it doesn't make sense to work without can message configuration
+                CBootTimeline::Instance().Finish();
                 m_MainState = DP_MAIN_STATE_ERROR;
                 emit ReportInitializationFinished(retCodeCfg);
             }
@@ -1061,6 +1074,7 @@ void DeviceProcessing::HandleTaskConfig(DeviceProcTask* pActiveTask)
                 //create configuration service
                 m_pConfigurationService = new CConfigurationService(this, &m_canCommunicator);
             }
+            CBootTimeline::Instance().Mark("configuration started");
             m_SubStateConfig = DP_SUB_STATE_CONFIG_CONFIG;
             break;
         case (DP_SUB_STATE_CONFIG_CONFIG):
@@ -1120,12 +1134,14 @@ void DeviceProcessing::HandleTaskConfig(DeviceProcTask* pActiveTask)
                 }
                 if(NonIdleFound == false)
                 {
+                    CBootTimeline::Instance().Mark("devices configured");
                     m_SubStateConfig = DP_SUB_STATE_CONFIG_FINISHED;
                 }
             }
             break;
         case (DP_SUB_STATE_CONFIG_FINISHED):
             FILE_LOG_L(laDEVPROC, llINFO) << "DeviceProcessing: DP_MAIN_STATE_CONFIG finished";
+            CBootTimeline::Instance().Finish();
             if(m_pConfigurationService != NULL)
             {
                 m_MainState = DP_MAIN_STATE_IDLE; //merged on 2014.2.17
@@ -1144,6 +1160,7 @@ void DeviceProcessing::HandleTaskConfig(DeviceProcTask* pActiveTask)
             break;
         case (DP_SUB_STATE_CONFIG_ERROR):
             FILE_LOG_L(laDEVPROC, llINFO) << "DeviceProcessing: DP_MAIN_STATE_CONFIG finished with error";
+            CBootTimeline::Instance().Finish();
             emit ReportConfigurationFinished(DCL_ERR_FCT_CALL_FAILED);
             m_SubStateConfig = DP_SUB_STATE_CONFIG_FINISHED;
             TaskFinished(pActiveTask);
@@ -1178,8 +1195,23 @@ void DeviceProcessing::HandleTaskNormalOperation(DeviceProcTask* pActiveTask)
 
     if(m_SubStateNormalOp == DP_SUB_STATE_NORMAL_OP_RUN)
     {
-        HandleCANNodesTask();
-        HandleDevicesTask();
+        if(m_Scheduler.GetMode() == CTaskScheduler::SCHEDULER_EVENT)
+        {
+            HandleReadyModulesTask();
+            m_SchedulerActive = true;
+        }
+        else
+        {
+            HandleCANNodesTask();
+            HandleDevicesTask();
+        }
+
+        qint64 Now = m_Scheduler.Now();
+        if(Now - m_SchedulerLogTime >= SCHEDULER_LOG_INTERVAL)
+        {
+            FILE_LOG_L(laDEVPROC, llINFO) << " Scheduler latency: " << m_Scheduler.GetStatistics().toStdString();
+            m_SchedulerLogTime = Now;
+        }
     }
     else if(m_SubStateNormalOp == DP_SUB_STATE_NORMAL_OP_START)
     {
@@ -1190,6 +1222,8 @@ void DeviceProcessing::HandleTaskNormalOperation(DeviceProcTask* pActiveTask)
     {
         HandleCANNodesTask();
         HandleDevicesTask();
+        WakeAllModules();
+        m_SchedulerLogTime = m_Scheduler.Now();
         m_SubStateNormalOp = DP_SUB_STATE_NORMAL_OP_RUN;
         emit ReportStartNormalOperationMode(DCL_ERR_FCT_CALL_SUCCESS);
     }
@@ -1377,7 +1411,143 @@ void DeviceProcessing::HandleCANNodesTask()
     {
         pCANNode = iter.next();
         pCANNode->HandleTasks();
+        m_Scheduler.Handled(pCANNode);
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Calls the HandleTasks function of the ready modules and all devices
+ *
+ *      Used in normal operation by the event driven scheduler. Nodes which
+ *      are not idle, e.g. because they are reconfigured, are run every time.
+ *      Idle nodes are run when they are ready and at least every
+ *      SCHEDULER_NODE_INTERVAL, to supervise the heartbeat and the supply.
+ *      Function modules are run when they are ready and their node is idle.
+ *      Modules with a pending task are run again after
+ *      SCHEDULER_TICK_INTERVAL, like with polling. The devices are run with
+ *      every call.
+ */
+/****************************************************************************/
+void DeviceProcessing::HandleReadyModulesTask()
+{
+    QSet<CModule *> Ready;
+    m_Scheduler.TakeReady(Ready);
+    qint64 Now = m_Scheduler.Now();
+
+    m_Scheduler.SetDispatching(true);
+
+    QListIterator<CBaseModule *> iterNode(m_ObjectTree);
+    while (iterNode.hasNext())
+    {
+        CBaseModule* pCANNode = iterNode.next();
+        if((pCANNode->GetMainState() != CBaseModule::CN_MAIN_STATE_IDLE) || Ready.contains(pCANNode))
+        {
+            pCANNode->HandleTasks();
+            m_Scheduler.Handled(pCANNode);
+
+            if((pCANNode->GetMainState() != CBaseModule::CN_MAIN_STATE_IDLE) || pCANNode->IsTaskPending())
+            {
+                m_Scheduler.WakeAt(pCANNode, Now + SCHEDULER_TICK_INTERVAL);
+            }
+            else
+            {
+                m_Scheduler.WakeAt(pCANNode, Now + SCHEDULER_NODE_INTERVAL);
+            }
+        }
+    }
+
+    QSetIterator<CModule *> iterReady(Ready);
+    while (iterReady.hasNext())
+    {
+        CFunctionModule* pFctModule = qobject_cast<CFunctionModule *>(iterReady.next());
+        if(pFctModule == 0)
+        {
+            continue;
+        }
+        const CBaseModule* pCANNode = pFctModule->GetBaseModule();
+        if((pCANNode != 0) && (pCANNode->GetMainState() == CBaseModule::CN_MAIN_STATE_IDLE))
+        {
+            pFctModule->HandleTasks();
+            m_Scheduler.Handled(pFctModule);
+            if(pFctModule->IsTaskPending())
+            {
+                m_Scheduler.WakeAt(pFctModule, Now + SCHEDULER_TICK_INTERVAL);
+            }
+        }
+        else
+        {
+            // wait until the node is idle
+            m_Scheduler.WakeAt(pFctModule, Now + SCHEDULER_TICK_INTERVAL);
+        }
+    }
+
+    m_Scheduler.SetDispatching(false);
+
+    HandleDevicesTask();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Wakes up all nodes and function modules
+ *
+ *      Used when the event driven scheduler takes over, so every module is
+ *      run once and asks for its next deadline.
+ */
+/****************************************************************************/
+void DeviceProcessing::WakeAllModules()
+{
+    QListIterator<CBaseModule *> iter(m_ObjectTree);
+    while (iter.hasNext())
+    {
+        CBaseModule* pCANNode = iter.next();
+        m_Scheduler.Wake(pCANNode, CTaskScheduler::WAKE_TIMER);
+
+        CFunctionModule* pFctModule = pCANNode->GetFunctionModuleFromList(0);
+        while (pFctModule != 0)
+        {
+            m_Scheduler.Wake(pFctModule, CTaskScheduler::WAKE_TIMER);
+            pFctModule = pCANNode->GetFunctionModuleFromList(pFctModule);
+        }
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Selects polling or event driven scheduling of the modules
+ *
+ *      The mode can be changed at any time, the event driven scheduler is
+ *      used in normal operation only. The latency statistics are reset.
+ *
+ *  \iparam Mode = Polling or event mode
+ */
+/****************************************************************************/
+void DeviceProcessing::SetSchedulerMode(CTaskScheduler::SchedulerMode_t Mode)
+{
+    if(Mode == m_Scheduler.GetMode())
+    {
+        return;
+    }
+    FILE_LOG_L(laDEVPROC, llINFO) << " Scheduler latency: " << m_Scheduler.GetStatistics().toStdString();
+    m_Scheduler.SetMode(Mode);
+    m_SchedulerLogTime = m_Scheduler.Now();
+    WakeAllModules();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the time until the next call of HandleTasks
+ *
+ *  \return Time in ms, -1 if HandleTasks is called at the fixed interval
+ */
+/****************************************************************************/
+qint64 DeviceProcessing::GetNextTaskInterval() const
+{
+    if(!m_SchedulerActive || (m_Scheduler.GetMode() != CTaskScheduler::SCHEDULER_EVENT))
+    {
+        return -1;
     }
+    return m_Scheduler.NextTimeout(SCHEDULER_NODE_INTERVAL);
 }
 
 /****************************************************************************/
@@ -1451,7 +1621,7 @@ void DeviceProcessing::CheckMasterHeartbeat()
             can_frameHeartbeat.data[7] = 0x08;
 
             can_frameHeartbeat.can_dlc = 8;
-            retval = m_canCommunicator.SendCOB(can_frameHeartbeat);
+            retval = m_canCommunicator.SendCOB(can_frameHeartbeat, CAN_TX_PRIO_HIGH);
 
             if(ftime(&m_tbTimerHeartbeatTime) || retval != DCL_ERR_FCT_CALL_SUCCESS)
             {
@@ -0,0 +1,222 @@
+/****************************************************************************/
+/*! \file TaskScheduler.cpp
+ *
+ *  \brief Implementation file for class CTaskScheduler.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class CTaskScheduler
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/DeviceProcessing/TaskScheduler.h"
+#include <QList>
+
+namespace DeviceControl
+{
+
+//! Resolution of the deadlines in ms
+#define SCHEDULER_RESOLUTION    1
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the class CTaskScheduler
+ *
+ *  \iparam p_Parent = Parent object
+ */
+/****************************************************************************/
+CTaskScheduler::CTaskScheduler(QObject *p_Parent) :
+    QObject(p_Parent), m_Mode(SCHEDULER_POLLING), m_Signalled(0), m_Dispatching(false),
+    m_Wheel(SCHEDULER_RESOLUTION, 0)
+{
+    m_Clock.start();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Selects the scheduler mode
+ *
+ *      The statistics are reset, so they only contain the latencies of the
+ *      new mode.
+ *
+ *  \iparam Mode = Polling or event mode
+ */
+/****************************************************************************/
+void CTaskScheduler::SetMode(SchedulerMode_t Mode)
+{
+    (void)m_Mode.fetchAndStoreOrdered(Mode);
+    ResetStatistics();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Wakes up a module
+ *
+ *      The module is run with the next pass of the device processing. Only
+ *      the time of the first wake up before the module is run is recorded.
+ *
+ *  \iparam p_Module = Module to run
+ *  \iparam Reason = Reason of the wake up
+ */
+/****************************************************************************/
+void CTaskScheduler::Wake(CModule *p_Module, WakeReason_t Reason)
+{
+    qint64 Time = m_Clock.nsecsElapsed() / 1000;
+
+    m_Mutex.lock();
+    if (!m_Pending.contains(p_Module)) {
+        PendingWake_t &Wake = m_Pending[p_Module];
+        Wake.Time = Time;
+        Wake.Reason = Reason;
+    }
+    m_Mutex.unlock();
+
+    if (GetMode() == SCHEDULER_EVENT && m_Signalled.testAndSetOrdered(0, 1)) {
+        emit ReportReady();
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Wakes up a module at a deadline
+ *
+ *      Only the earliest deadline of a module is kept. After it expired, the
+ *      module has to ask for the next one.
+ *
+ *  \iparam p_Module = Module to run
+ *  \iparam Deadline = Time of the scheduler clock in ms
+ */
+/****************************************************************************/
+void CTaskScheduler::WakeAt(CModule *p_Module, qint64 Deadline)
+{
+    QHash<CModule *, qint64>::iterator Iterator = m_Deadlines.find(p_Module);
+    if (Iterator != m_Deadlines.end()) {
+        if (Iterator.value() <= Deadline) {
+            return;
+        }
+        Iterator.value() = Deadline;
+    }
+    else {
+        m_Deadlines.insert(p_Module, Deadline);
+    }
+    m_Wheel.Schedule(p_Module, Deadline);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the modules to run
+ *
+ *      These are the modules woken up and the modules with an expired
+ *      deadline. Woken up modules stay pending until they were handled.
+ *
+ *  \oparam Ready = The ready modules are added
+ */
+/****************************************************************************/
+void CTaskScheduler::TakeReady(QSet<CModule *> &Ready)
+{
+    (void)m_Signalled.fetchAndStoreOrdered(0);
+
+    m_Mutex.lock();
+    for (QHash<CModule *, PendingWake_t>::const_iterator Iterator = m_Pending.constBegin();
+         Iterator != m_Pending.constEnd(); ++Iterator) {
+        Ready.insert(Iterator.key());
+    }
+    m_Mutex.unlock();
+
+    qint64 Now = m_Clock.elapsed();
+    QList<CModule *> Expired;
+    m_Wheel.Advance(Now, Expired);
+    for (qint32 i = 0; i < Expired.count(); i++) {
+        // skip deadlines replaced by an earlier one, which already expired
+        QHash<CModule *, qint64>::iterator Iterator = m_Deadlines.find(Expired[i]);
+        if (Iterator != m_Deadlines.end() && Iterator.value() <= Now) {
+            m_Deadlines.erase(Iterator);
+            Ready.insert(Expired[i]);
+        }
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Records that a module was run
+ *
+ *      The latency of a pending wake up is recorded and the wake up is
+ *      removed. Called in both modes.
+ *
+ *  \iparam p_Module = Module that was run
+ */
+/****************************************************************************/
+void CTaskScheduler::Handled(CModule *p_Module)
+{
+    m_Mutex.lock();
+    QHash<CModule *, PendingWake_t>::iterator Iterator = m_Pending.find(p_Module);
+    if (Iterator == m_Pending.end()) {
+        m_Mutex.unlock();
+        return;
+    }
+    PendingWake_t Wake = Iterator.value();
+    m_Pending.erase(Iterator);
+    m_Mutex.unlock();
+
+    if (Wake.Reason != WAKE_TIMER) {
+        m_Latency[Wake.Reason == WAKE_COMMAND ? 1 : 0].Record(m_Clock.nsecsElapsed() / 1000 - Wake.Time);
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the time until the next deadline expires
+ *
+ *  \iparam MaxTimeout = Upper limit in ms
+ *
+ *  \return Time in ms, at most MaxTimeout
+ */
+/****************************************************************************/
+qint64 CTaskScheduler::NextTimeout(qint64 MaxTimeout) const
+{
+    qint64 Timeout = m_Wheel.NextTimeout(m_Clock.elapsed());
+    if (Timeout < 0 || Timeout > MaxTimeout) {
+        return MaxTimeout;
+    }
+    return Timeout;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Summarizes the wake up latencies for the log file
+ *
+ *  \return Statistics of both wake up reasons
+ */
+/****************************************************************************/
+QString CTaskScheduler::GetStatistics() const
+{
+    return QString("%1 mode, CAN receive: %2, command: %3")
+            .arg(GetMode() == SCHEDULER_EVENT ? "event" : "polling")
+            .arg(m_Latency[0].ToString())
+            .arg(m_Latency[1].ToString());
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Clears the wake up latency histograms
+ */
+/****************************************************************************/
+void CTaskScheduler::ResetStatistics()
+{
+    m_Latency[0].Reset();
+    m_Latency[1].Reset();
+}
+
+} //namespace DeviceControl
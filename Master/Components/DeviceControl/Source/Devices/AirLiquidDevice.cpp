@@ -11,7 +11,6 @@
 
 namespace DeviceControl
 {
-#define CHECK_SENSOR_TIME               (800) // in msecs
 #define CHECK_PRESSURE_SENSOR_TIME      (200) // in msecs
 #define CHECK_CURRENT_TIME              (900) // in msecs
 
@@ -95,7 +94,13 @@ void CAirLiquidDevice::Reset()
     memset( &m_SuckingTime, 0 , sizeof(m_SuckingTime)); //lint !e545
     memset( &m_TargetTempCtrlStatus, TEMPCTRL_STATUS_UNDEF , sizeof(m_TargetTempCtrlStatus));  //lint !e545 !e641
     memset( &m_CurrentTempCtrlStatus, TEMPCTRL_STATUS_UNDEF , sizeof(m_CurrentTempCtrlStatus)); //lint !e545 !e641
-    memset( &m_CurrentTemperatures, 0 , sizeof(m_CurrentTemperatures)); //lint !e545
+    for(quint8 i = 0; i < AL_TEMP_CTRL_NUM; i++)
+    {
+        for(quint8 j = 0; j < MAX_SENSOR_PER_TEMP_CTRL; j++)
+        {
+            m_CurrentTemperatures[i][j].Clear();
+        }
+    }
     memset( &m_TargetTemperatures, 0 , sizeof(m_TargetTemperatures)); //lint !e545
     memset( &m_MainsVoltageStatus, 0 , sizeof(m_MainsVoltageStatus)); //lint !e545
     memset( &m_pTempCtrls, 0 , sizeof(m_pTempCtrls)); //lint !e545
@@ -241,10 +246,10 @@ ReturnCode_t CAirLiquidDevice::HandleInitializationState()
             PartLifeCycleRecord* pPartLifeCycleRecord = m_ModuleLifeCycleRecord->m_PartLifeCycleMap.value("AL_pressure_ctrl");
             if (pPartLifeCycleRecord)
             {
-                quint32 valve1LifeCycle = pPartLifeCycleRecord->m_ParamMap.value("Valve1_LifeCycle").toUInt();
-                quint32 valve2LifeCycle = pPartLifeCycleRecord->m_ParamMap.value("Valve2_LifeCycle").toUInt();
-                quint32 activeCarbonFilterLifeTime = pPartLifeCycleRecord->m_ParamMap.value("ActiveCarbonFilter_LifeTime").toUInt();
-                quint32 exhaustFanLifeTime = pPartLifeCycleRecord->m_ParamMap.value("Exhaust_Fan_LifeTime").toUInt();
+                quint32 valve1LifeCycle = pPartLifeCycleRecord->GetValue("Valve1_LifeCycle");
+                quint32 valve2LifeCycle = pPartLifeCycleRecord->GetValue("Valve2_LifeCycle");
+                quint32 activeCarbonFilterLifeTime = pPartLifeCycleRecord->GetValue("ActiveCarbonFilter_LifeTime");
+                quint32 exhaustFanLifeTime = pPartLifeCycleRecord->GetValue("Exhaust_Fan_LifeTime");
 
                 m_pPressureCtrl->SetValveLifeCycle(valve1LifeCycle, valve2LifeCycle);
                 m_pPressureCtrl->SetActiveCarbonFilterLifeTime(activeCarbonFilterLifeTime);
@@ -279,7 +284,7 @@ ReturnCode_t CAirLiquidDevice::HandleInitializationState()
                 PartLifeCycleRecord* pPartLifeCycleRecord = m_ModuleLifeCycleRecord->m_PartLifeCycleMap.value("AL_level_sensor_temp_ctrl");
                 if (pPartLifeCycleRecord)
                 {
-                    quint32 levelSensorLifeCycle = pPartLifeCycleRecord->m_ParamMap.value(m_pTempCtrls[AL_LEVELSENSOR]->GetKey()+"_LifeCycle").toUInt();
+                    quint32 levelSensorLifeCycle = pPartLifeCycleRecord->GetValue(m_pTempCtrls[AL_LEVELSENSOR]->GetKey()+"_LifeCycle");
                     m_pTempCtrls[AL_LEVELSENSOR]->SetLifeCycle(levelSensorLifeCycle);
                     m_pTempCtrls[AL_LEVELSENSOR]->SetPartLifeCycleRecord(pPartLifeCycleRecord);
                 }
@@ -577,6 +582,19 @@ ReturnCode_t CAirLiquidDevice::HandleConfigurationState()
         return DCL_ERR_FCT_CALL_FAILED;
     }
 */
+    // let the Slaves send their temperatures periodically, so the getters do not
+    // have to request them
+    if(m_TelemetryInterval > 0)
+    {
+        for(quint8 idx = 0; idx < AL_TEMP_CTRL_NUM; idx++)
+        {
+            if(m_pTempCtrls[idx] && m_pTempCtrls[idx]->SubscribeActTemperature(m_TelemetryInterval) != DCL_ERR_FCT_CALL_SUCCESS)
+            {
+                FILE_LOG_L(laDEV, llWARNING) << "   Temperature telemetry not subscribed, index: " << (int) idx;
+            }
+        }
+    }
+
     return DCL_ERR_FCT_CALL_SUCCESS;
 
 }
@@ -1980,11 +1998,9 @@ qreal CAirLiquidDevice::GetRecentTemperature(ALTempCtrlType_t Type, quint8 Index
   //  QMutexLocker Locker(&m_Mutex);
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
     qreal RetValue;
-    if((Now - m_LastGetTempTime[Type][Index]) <= 1000) // check if 1000 msec has passed since last read
-    {
-        RetValue = m_CurrentTemperatures[Type][Index];
-    }
-    else
+    qint64 TimeStamp;
+    m_CurrentTemperatures[Type][Index].Load(RetValue, TimeStamp);
+    if((Now - TimeStamp) > 1000) // check if 1000 msec has passed since the last sample
     {
         //LogDebug(QString("In AirLiquid device, invalid temperature. Current state is: %1").arg(m_MainState));
         RetValue = UNDEFINED_4_BYTE;
@@ -2200,10 +2216,10 @@ bool CAirLiquidDevice::IsInsideRange(ALTempCtrlType_t Type, quint8 Index)
     if(!qFuzzyCompare(GetTemperature(Type, 0), UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperatures[Type],UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperatures[Type][Index] > m_TargetTemperatures[Type] - TOLERANCE)||
-                            (m_CurrentTemperatures[Type][Index] < m_TargetTemperatures[Type] + TOLERANCE))
+            if ((m_CurrentTemperatures[Type][Index].Value() > m_TargetTemperatures[Type] - TOLERANCE)||
+                            (m_CurrentTemperatures[Type][Index].Value() < m_TargetTemperatures[Type] + TOLERANCE))
             {
                 return true;
             }
@@ -2231,10 +2247,10 @@ bool CAirLiquidDevice::IsOutsideRange(ALTempCtrlType_t Type, quint8 Index)
     if(!qFuzzyCompare(GetTemperature(Type, 0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperatures[Type],UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperatures[Type][Index] < m_TargetTemperatures[Type] - TOLERANCE)||
-                            (m_CurrentTemperatures[Type][Index] > m_TargetTemperatures[Type] + TOLERANCE))
+            if ((m_CurrentTemperatures[Type][Index].Value() < m_TargetTemperatures[Type] - TOLERANCE)||
+                            (m_CurrentTemperatures[Type][Index].Value() > m_TargetTemperatures[Type] + TOLERANCE))
             {
                 return true;
             }
@@ -2349,9 +2365,14 @@ void CAirLiquidDevice::OnSetTemp(quint32 /*InstanceID*/, ReturnCode_t ReturnCode
 qreal CAirLiquidDevice::GetTemperature(ALTempCtrlType_t Type, quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    qreal RetValue = m_CurrentTemperatures[Type][Index];
-    if((Now - m_LastGetTempTime[Type][Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    qreal RetValue;
+    qint64 TimeStamp;
+    m_CurrentTemperatures[Type][Index].Load(RetValue, TimeStamp);
+    // the sample is kept recent by the telemetry, request it only if it is too old
+    if((Now - TimeStamp) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Type][Index]) >= m_TelemetryMaxAge)
     {
+        // tells OnGetTemp which sample answers this request
+        m_PendingGetTemp.storeRelease(((Type << 8) | Index) + 1);
         ReturnCode_t retCode = m_pTempCtrls[Type]->ReqActTemperature(Index);
         if (DCL_ERR_FCT_CALL_SUCCESS != retCode )
         {
@@ -2366,10 +2387,11 @@ qreal CAirLiquidDevice::GetTemperature(ALTempCtrlType_t Type, quint8 Index)
             }
             else
             {
-                RetValue = m_CurrentTemperatures[Type][Index];
+                RetValue = m_CurrentTemperatures[Type][Index].Value();
             }
             m_LastGetTempTime[Type][Index] = Now;
         }
+        m_PendingGetTemp.storeRelease(0);
     }
     return RetValue;
 }
@@ -2387,7 +2409,7 @@ qreal CAirLiquidDevice::GetTemperature(ALTempCtrlType_t Type, quint8 Index)
 ReturnCode_t CAirLiquidDevice::GetTemperatureAsync(ALTempCtrlType_t Type, quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    if((Now - m_LastGetTempTime[Type][Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    if(m_CurrentTemperatures[Type][Index].Age(Now) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Type][Index]) >= m_TelemetryMaxAge)
     {
         m_LastGetTempTime[Type][Index] = Now;
         return m_pTempCtrls[Type]->ReqActTemperature(Index);
@@ -2471,19 +2493,26 @@ ReturnCode_t CAirLiquidDevice::GetHeaterCurrentAsync(ALTempCtrlType_t Type)
 /****************************************************************************/
 void CAirLiquidDevice::OnGetTemp(quint32 InstanceID, ReturnCode_t ReturnCode, quint8 Index, qreal Temp)
 {
-    Q_UNUSED(Index)
+    if(Index >= MAX_SENSOR_PER_TEMP_CTRL)
+    {
+        return;
+    }
 
     if(DCL_ERR_FCT_CALL_SUCCESS == ReturnCode)
     {
         FILE_LOG_L(laDEVPROC, llINFO) << "INFO: AL Get temperature successful! ";
-        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index] = Temp;
+        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index].Store(Temp, QDateTime::currentMSecsSinceEpoch());
     }
     else
     {
         FILE_LOG_L(laDEVPROC, llWARNING) << "WARNING: AL get temperature failed! " << ReturnCode; //lint !e641
-        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index] = UNDEFINED_4_BYTE;
+        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index].Store(UNDEFINED_4_BYTE, QDateTime::currentMSecsSinceEpoch());
+    }
+    // a subscribed sample of another sensor must not resume a waiting call
+    if(m_PendingGetTemp.testAndSetOrdered(((m_InstTCTypeMap[InstanceID] << 8) | Index) + 1, 0))
+    {
+        m_pDevProc->ResumeFromSyncCall(SYNC_CMD_AL_GET_TEMP, ReturnCode);
     }
-    m_pDevProc->ResumeFromSyncCall(SYNC_CMD_AL_GET_TEMP, ReturnCode);
 }
 
 /****************************************************************************/
@@ -56,6 +56,9 @@ bool CBaseDevice::m_SensorsDataCheckFlag = true;
     m_instanceID(InstanceID),
     m_stateTimespan(0),
     m_LastSensorCheckTime(0),
+    m_TelemetryInterval(500),
+    m_TelemetryMaxAge(800),
+    m_PendingGetTemp(0),
     m_machine(this),
     m_ModuleLifeCycleRecord(0)
 {
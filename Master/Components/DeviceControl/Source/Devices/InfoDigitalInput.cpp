@@ -91,10 +91,8 @@ bool CInfoDigitalInput::Finished(QEvent *p_Event)
         return true;
 
     QString paramName = mp_SubModule->GetSubModuleName() + "_LifeCycle";
-    QString strLifeTimeNew = QString().setNum(mp_DigitalInput->GetLifeCycle() / 2);
-    QMap<QString, QString>::const_iterator iter = pPartLifeCycleRecord->m_ParamMap.find(paramName);
-    if (iter != pPartLifeCycleRecord->m_ParamMap.end())
-        pPartLifeCycleRecord->m_ParamMap[paramName] = strLifeTimeNew;
+    if (pPartLifeCycleRecord->Contains(paramName))
+        pPartLifeCycleRecord->SetValue(paramName, mp_DigitalInput->GetLifeCycle() / 2);
 
     return true;
 }
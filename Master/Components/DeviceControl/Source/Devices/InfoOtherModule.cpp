@@ -78,16 +78,14 @@ bool CInfoOtherModule::Finished(QEvent *p_Event)
         return false;
 
     const QString& paramName = mp_SubModule->GetSubModuleName() + "_LifeTime";
-    uint lifeTimeOld = pPartLifeCycleRecord->m_ParamMap[paramName].toUInt();
     quint32 elpaseSec = m_LastSaveTime.secsTo(QDateTime::currentDateTime());
-    quint32 lifeTimeNew = elpaseSec + lifeTimeOld;
-    QString strLifeTimeNew = QString().setNum(lifeTimeNew);
-    if (!mp_SubModule->UpdateParameterInfo("OperationTime", strLifeTimeNew)) {
+    quint32 lifeTimeNew = elpaseSec + pPartLifeCycleRecord->GetValue(paramName);
+    if (!mp_SubModule->UpdateParameterInfo("OperationTime", QString().setNum(lifeTimeNew))) {
         emit ReportError(DCL_ERR_INVALID_PARAM);
         return false;
     }
 
-    pPartLifeCycleRecord->m_ParamMap[paramName] = strLifeTimeNew;
+    pPartLifeCycleRecord->SetValue(paramName, lifeTimeNew);
     m_LastSaveTime = QDateTime::currentDateTime();
     return true;
 }
@@ -138,7 +138,7 @@ bool CInfoPressureControl::Finished(QEvent *p_Event)
     quint32 history_Pump_OperationTime = 0;
     PartLifeCycleRecord* pPartLifeCycleRecord = mp_PressureControl->GetPartLifeCycleRecord();
     if (pPartLifeCycleRecord)
-        history_Pump_OperationTime = pPartLifeCycleRecord->m_ParamMap.value("History_Pump_OperationTime").toUInt();
+        history_Pump_OperationTime = pPartLifeCycleRecord->GetValue("History_Pump_OperationTime");
 
     if (!mp_SubModule->UpdateParameterInfo("PumpOperationTime", QString().setNum(pumpOperationTime + history_Pump_OperationTime))) {
         //FILE_LOG_L(laFCT, llDEBUG) << " lifeCycle:CInfoPressureControl,E5";
@@ -190,30 +190,19 @@ bool CInfoPressureControl::Finished(QEvent *p_Event)
         return true;
     }
 
-    QString strLifeCycleNew = QString().setNum(mp_PressureControl->GetValveLifeCycle(0));
-    QMap<QString, QString>::const_iterator iter = pPartLifeCycleRecord->m_ParamMap.find("Valve1_LifeCycle");
-    if (iter != pPartLifeCycleRecord->m_ParamMap.end())
-        pPartLifeCycleRecord->m_ParamMap["Valve1_LifeCycle"] = strLifeCycleNew;
-
-    QString strLifeCycleNew2 = QString().setNum(mp_PressureControl->GetValveLifeCycle(1));
-    QMap<QString, QString>::const_iterator iter2 = pPartLifeCycleRecord->m_ParamMap.find("Valve2_LifeCycle");
-    if (iter2 != pPartLifeCycleRecord->m_ParamMap.end())
-        pPartLifeCycleRecord->m_ParamMap["Valve2_LifeCycle"] = strLifeCycleNew2;
-
-    QString strLifeTimeCarbonFilter = QString().setNum(mp_PressureControl->GetActiveCarbonFilterLifeTime());
-    QMap<QString, QString>::const_iterator iterFilter = pPartLifeCycleRecord->m_ParamMap.find("ActiveCarbonFilter_LifeTime");
-    if (iterFilter != pPartLifeCycleRecord->m_ParamMap.end())
-        pPartLifeCycleRecord->m_ParamMap["ActiveCarbonFilter_LifeTime"] = strLifeTimeCarbonFilter;
-
-    if (Global::GetMantainenceFirstRecordFlag())
-        pPartLifeCycleRecord->m_ParamMap["CarbonFilter_FirstRecord_Flag"] = "1";
-    else
-        pPartLifeCycleRecord->m_ParamMap["CarbonFilter_FirstRecord_Flag"] = "0";
-
-    QString strLifeTimeExhaustFan = QString().setNum(mp_PressureControl->GetExhaustFanLifeTime());
-    QMap<QString, QString>::const_iterator iterExhaustFan = pPartLifeCycleRecord->m_ParamMap.find("Exhaust_Fan_LifeTime");
-    if (iterExhaustFan != pPartLifeCycleRecord->m_ParamMap.end())
-        pPartLifeCycleRecord->m_ParamMap["Exhaust_Fan_LifeTime"] = strLifeTimeExhaustFan;
+    if (pPartLifeCycleRecord->Contains("Valve1_LifeCycle"))
+        pPartLifeCycleRecord->SetValue("Valve1_LifeCycle", mp_PressureControl->GetValveLifeCycle(0));
+
+    if (pPartLifeCycleRecord->Contains("Valve2_LifeCycle"))
+        pPartLifeCycleRecord->SetValue("Valve2_LifeCycle", mp_PressureControl->GetValveLifeCycle(1));
+
+    if (pPartLifeCycleRecord->Contains("ActiveCarbonFilter_LifeTime"))
+        pPartLifeCycleRecord->SetValue("ActiveCarbonFilter_LifeTime", mp_PressureControl->GetActiveCarbonFilterLifeTime());
+
+    pPartLifeCycleRecord->SetValue("CarbonFilter_FirstRecord_Flag", Global::GetMantainenceFirstRecordFlag() ? 1 : 0);
+
+    if (pPartLifeCycleRecord->Contains("Exhaust_Fan_LifeTime"))
+        pPartLifeCycleRecord->SetValue("Exhaust_Fan_LifeTime", mp_PressureControl->GetExhaustFanLifeTime());
     //FILE_LOG_L(laFCT, llDEBUG) << " lifeCycle:CInfoPressureControl,End";
     return true;
 }
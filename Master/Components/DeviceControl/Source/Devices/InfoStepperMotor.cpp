@@ -187,7 +187,7 @@ bool CInfoStepperMotor::Finished(QEvent *p_Event)
     quint32 history_motor_OperationTime = 0;
     PartLifeCycleRecord* pPartLifeCycleRecord = mp_StepperMotor->GetPartLifeCycleRecord();
     if (pPartLifeCycleRecord)
-        history_motor_OperationTime = pPartLifeCycleRecord->m_ParamMap.value("History_OperationTime").toUInt();
+        history_motor_OperationTime = pPartLifeCycleRecord->GetValue("History_OperationTime");
 
     if (!mp_SubModule->UpdateParameterInfo("OperationTime", QString().setNum(OperationTime + history_motor_OperationTime))) {
         emit ReportError(DCL_ERR_INVALID_PARAM);
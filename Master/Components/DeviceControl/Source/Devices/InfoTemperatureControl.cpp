@@ -130,7 +130,7 @@ bool CInfoTemperatureControl::Finished(QEvent *p_Event)
     PartLifeCycleRecord* pPartLifeCycleRecord = mp_TemperatureControl->GetPartLifeCycleRecord();
     if (pPartLifeCycleRecord)
     {
-        history_OperationTime = pPartLifeCycleRecord->m_ParamMap.value("History_OperationTime").toUInt();
+        history_OperationTime = pPartLifeCycleRecord->GetValue("History_OperationTime");
     }
 
     if (!mp_SubModule->UpdateParameterInfo("OperationTime", QString().setNum(OperatingTime + history_OperationTime))) {
@@ -154,10 +154,8 @@ bool CInfoTemperatureControl::Finished(QEvent *p_Event)
     }
 
     QString paramName = mp_SubModule->GetSubModuleName() + "_LifeCycle";
-    QString strLifeTimeNew = QString().setNum(mp_TemperatureControl->GetLifeCycle());
-    QMap<QString, QString>::const_iterator iter = pPartLifeCycleRecord->m_ParamMap.find(paramName);
-    if (iter != pPartLifeCycleRecord->m_ParamMap.end())
-        pPartLifeCycleRecord->m_ParamMap[paramName] = strLifeTimeNew;
+    if (pPartLifeCycleRecord->Contains(paramName))
+        pPartLifeCycleRecord->SetValue(paramName, mp_TemperatureControl->GetLifeCycle());
      //FILE_LOG_L(laFCT, llDEBUG) << "lifeCycle:CInfoTemperatureControl::Finished() end";
     return true;
 }
@@ -70,7 +70,13 @@ void COvenDevice::Reset()
     memset( &m_LastGetTempCtrlStatus, 0 , sizeof(m_LastGetTempCtrlStatus)); //lint !e545
     memset( &m_TargetTempCtrlStatus, TEMPCTRL_STATUS_UNDEF , sizeof(m_TargetTempCtrlStatus)); //lint !e545 !e641
     memset( &m_CurrentTempCtrlStatus, TEMPCTRL_STATUS_UNDEF , sizeof(m_CurrentTempCtrlStatus)); //lint !e545 !e641
-    memset( &m_CurrentTemperatures, 0 , sizeof(m_CurrentTemperatures)); //lint !e545 !e641
+    for(quint8 i = 0; i < OVEN_TEMP_CTRL_NUM; i++)
+    {
+        for(quint8 j = 0; j < MAX_SENSOR_PER_TEMP_CTRL; j++)
+        {
+            m_CurrentTemperatures[i][j].Clear();
+        }
+    }
     memset( &m_TargetTemperatures, 0 , sizeof(m_TargetTemperatures)); //lint !e545
     memset( &m_MainsVoltageStatus, 0 , sizeof(m_MainsVoltageStatus)); //lint !e545
     memset( &m_pTempCtrls, 0 , sizeof(m_pTempCtrls));  //lint !e545
@@ -275,7 +281,7 @@ ReturnCode_t COvenDevice::HandleInitializationState()
             PartLifeCycleRecord* pPartLifeCycleRecord = m_ModuleLifeCycleRecord->m_PartLifeCycleMap.value("Oven_Cover_Sensor");
             if (pPartLifeCycleRecord)
             {
-                quint32 lifeCycle = pPartLifeCycleRecord->m_ParamMap.value(m_pLidDigitalInput->GetKey() + "_LifeCycle").toUInt();
+                quint32 lifeCycle = pPartLifeCycleRecord->GetValue(m_pLidDigitalInput->GetKey() + "_LifeCycle");
                 m_pLidDigitalInput->SetLifeCycle(lifeCycle * 2);
                 m_pLidDigitalInput->SetPartLifeCycleRecord(pPartLifeCycleRecord);
             }
@@ -412,6 +418,19 @@ ReturnCode_t COvenDevice::HandleConfigurationState()
         FILE_LOG_L(laDEV, llERROR) << "   Connect digital input signal 'ReportError'failed.";
         return DCL_ERR_FCT_CALL_FAILED;
     }
+    // let the Slaves send their temperatures periodically, so the getters do not
+    // have to request them
+    if(m_TelemetryInterval > 0)
+    {
+        for(quint8 idx = 0; idx < OVEN_TEMP_CTRL_NUM; idx++)
+        {
+            if(m_pTempCtrls[idx] && m_pTempCtrls[idx]->SubscribeActTemperature(m_TelemetryInterval) != DCL_ERR_FCT_CALL_SUCCESS)
+            {
+                FILE_LOG_L(laDEV, llWARNING) << "   Temperature telemetry not subscribed, index: " << (int) idx;
+            }
+        }
+    }
+
     return DCL_ERR_FCT_CALL_SUCCESS;
 }
 
@@ -561,11 +580,9 @@ qreal COvenDevice::GetRecentTemperature(OVENTempCtrlType_t Type, quint8 Index)
    // QMutexLocker Locker(&m_Mutex);
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
     qreal RetValue;
-    if((Now - m_LastGetTempTime[Type][Index]) <= 1000) // check if 1000 msec has passed since last read
-    {
-        RetValue = m_CurrentTemperatures[Type][Index];
-    }
-    else
+    qint64 TimeStamp;
+    m_CurrentTemperatures[Type][Index].Load(RetValue, TimeStamp);
+    if((Now - TimeStamp) > 1000) // check if 1000 msec has passed since the last sample
     {
         //LogDebug(QString("In Oven device, invalid temperature. Current state is: %1").arg(m_MainState));
         RetValue = UNDEFINED_4_BYTE;
@@ -784,10 +801,10 @@ bool COvenDevice::IsInsideRange(OVENTempCtrlType_t Type, quint8 Index)
     if(!qFuzzyCompare(GetTemperature(Type, 0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperatures[Type],UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperatures[Type][Index] > m_TargetTemperatures[Type] - TOLERANCE)||
-                            (m_CurrentTemperatures[Type][Index] < m_TargetTemperatures[Type] + TOLERANCE))
+            if ((m_CurrentTemperatures[Type][Index].Value() > m_TargetTemperatures[Type] - TOLERANCE)||
+                            (m_CurrentTemperatures[Type][Index].Value() < m_TargetTemperatures[Type] + TOLERANCE))
             {
                 return true;
             }
@@ -815,10 +832,10 @@ bool COvenDevice::IsOutsideRange(OVENTempCtrlType_t Type, quint8 Index)
     if(!qFuzzyCompare(GetTemperature(Type, 0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperatures[Type],UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperatures[Type][Index] < m_TargetTemperatures[Type] - TOLERANCE)||
-                            (m_CurrentTemperatures[Type][Index] > m_TargetTemperatures[Type] + TOLERANCE))
+            if ((m_CurrentTemperatures[Type][Index].Value() < m_TargetTemperatures[Type] - TOLERANCE)||
+                            (m_CurrentTemperatures[Type][Index].Value() > m_TargetTemperatures[Type] + TOLERANCE))
             {
                 return true;
             }
@@ -938,9 +955,14 @@ void COvenDevice::OnSetTemp(quint32 /*InstanceID*/, ReturnCode_t ReturnCode, qre
 qreal COvenDevice::GetTemperature(OVENTempCtrlType_t Type, quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    qreal RetValue = m_CurrentTemperatures[Type][Index];
-    if((Now - m_LastGetTempTime[Type][Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    qreal RetValue;
+    qint64 TimeStamp;
+    m_CurrentTemperatures[Type][Index].Load(RetValue, TimeStamp);
+    // the sample is kept recent by the telemetry, request it only if it is too old
+    if((Now - TimeStamp) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Type][Index]) >= m_TelemetryMaxAge)
     {
+        // tells OnGetTemp which sample answers this request
+        m_PendingGetTemp.storeRelease(((Type << 8) | Index) + 1);
         ReturnCode_t retCode = m_pTempCtrls[Type]->ReqActTemperature(Index);
         if (DCL_ERR_FCT_CALL_SUCCESS != retCode )
         {
@@ -958,10 +980,11 @@ qreal COvenDevice::GetTemperature(OVENTempCtrlType_t Type, quint8 Index)
             }
             else
             {
-                RetValue = m_CurrentTemperatures[Type][Index];
+                RetValue = m_CurrentTemperatures[Type][Index].Value();
             }
             m_LastGetTempTime[Type][Index] = Now;
         }
+        m_PendingGetTemp.storeRelease(0);
     }
     return RetValue;
 }
@@ -979,7 +1002,7 @@ qreal COvenDevice::GetTemperature(OVENTempCtrlType_t Type, quint8 Index)
 ReturnCode_t COvenDevice::GetTemperatureAsync(OVENTempCtrlType_t Type, quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    if((Now - m_LastGetTempTime[Type][Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    if(m_CurrentTemperatures[Type][Index].Age(Now) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Type][Index]) >= m_TelemetryMaxAge)
     {
         m_LastGetTempTime[Type][Index] = Now;
         return   m_pTempCtrls[Type]->ReqActTemperature(Index);
@@ -1012,19 +1035,23 @@ ReturnCode_t COvenDevice::GetTemperatureControlStatusAsync(OVENTempCtrlType_t Ty
 /****************************************************************************/
 void COvenDevice::OnGetTemp(quint32 InstanceID, ReturnCode_t ReturnCode, quint8 Index, qreal Temp)
 {
-    Q_UNUSED(Index)
+    if(Index >= MAX_SENSOR_PER_TEMP_CTRL)
+    {
+        return;
+    }
 
     if(DCL_ERR_FCT_CALL_SUCCESS == ReturnCode)
     {
         FILE_LOG_L(laDEVPROC, llINFO) << "INFO: Oven Get temperature successful! ";
-        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index] = Temp;
+        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index].Store(Temp, QDateTime::currentMSecsSinceEpoch());
     }
     else
     {
         FILE_LOG_L(laDEVPROC, llWARNING) << "WARNING: Oven get temperature failed! " << ReturnCode; //lint !e641
-        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index] = UNDEFINED_4_BYTE;
+        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index].Store(UNDEFINED_4_BYTE, QDateTime::currentMSecsSinceEpoch());
     }
-    if(m_pDevProc)
+    // a subscribed sample of another sensor must not resume a waiting call
+    if(m_pDevProc && m_PendingGetTemp.testAndSetOrdered(((m_InstTCTypeMap[InstanceID] << 8) | Index) + 1, 0))
     {
         m_pDevProc->ResumeFromSyncCall(SYNC_CMD_OVEN_GET_TEMP, ReturnCode);
     }
@@ -11,7 +11,6 @@
 
 namespace DeviceControl
 {
-#define CHECK_SENSOR_TIME  (800) // in msecs
 #define CHECK_CURRENT_TIME (900) // in msecs
 #define CHECK_LOCKER_TIME  (700) // in msecs
 const qint32 TOLERANCE = 10; //!< tolerance value for calculating inside and outside range
@@ -70,7 +69,13 @@ void CRetortDevice::Reset()
     memset( &m_LastGetTempTime, 0 , sizeof(m_LastGetTempTime)); //lint !e545
     memset( &m_TargetTempCtrlStatus, TEMPCTRL_STATUS_UNDEF , sizeof(m_TargetTempCtrlStatus)); //lint !e545 !e641
     memset( &m_CurrentTempCtrlStatus, TEMPCTRL_STATUS_UNDEF , sizeof(m_CurrentTempCtrlStatus)); //lint !e545 !e641
-    memset( &m_CurrentTemperatures, 0 , sizeof(m_CurrentTemperatures)); //lint !e545
+    for(quint8 i = 0; i < RT_TEMP_CTRL_NUM; i++)
+    {
+        for(quint8 j = 0; j < MAX_SENSOR_PER_TEMP_CTRL; j++)
+        {
+            m_CurrentTemperatures[i][j].Clear();
+        }
+    }
     memset( &m_TargetTemperatures, 0 , sizeof(m_TargetTemperatures)); //lint !e545
     memset( &m_MainsVoltageStatus, 0 , sizeof(m_MainsVoltageStatus)); //lint !e545
     memset( &m_pTempCtrls, 0 , sizeof(m_pTempCtrls)); //lint !e545
@@ -289,7 +294,7 @@ ReturnCode_t CRetortDevice::HandleInitializationState()
             PartLifeCycleRecord* pPartLifeCycleRecord = m_ModuleLifeCycleRecord->m_PartLifeCycleMap.value("Retort_Lid_Lock");
             if (pPartLifeCycleRecord)
             {
-                quint32 lifeCycle = pPartLifeCycleRecord->m_ParamMap.value("lid_status_LifeCycle").toUInt();
+                quint32 lifeCycle = pPartLifeCycleRecord->GetValue("lid_status_LifeCycle");
                 m_pLockDigitalInput->SetLifeCycle(lifeCycle * 2);
                 m_pLockDigitalInput->SetPartLifeCycleRecord(pPartLifeCycleRecord);
             }
@@ -449,6 +454,19 @@ ReturnCode_t CRetortDevice::HandleConfigurationState()
         return DCL_ERR_FCT_CALL_FAILED;
     }
 
+    // let the Slaves send their temperatures periodically, so the getters do not
+    // have to request them
+    if(m_TelemetryInterval > 0)
+    {
+        for(quint8 idx = 0; idx < RT_TEMP_CTRL_NUM; idx++)
+        {
+            if(m_pTempCtrls[idx] && m_pTempCtrls[idx]->SubscribeActTemperature(m_TelemetryInterval) != DCL_ERR_FCT_CALL_SUCCESS)
+            {
+                FILE_LOG_L(laDEV, llWARNING) << "   Temperature telemetry not subscribed, index: " << (int) idx;
+            }
+        }
+    }
+
     return DCL_ERR_FCT_CALL_SUCCESS;
 
 }
@@ -593,11 +611,9 @@ qreal CRetortDevice::GetRecentTemperature(RTTempCtrlType_t Type, quint8 Index)
    // QMutexLocker Locker(&m_Mutex);
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
     qreal RetValue;
-    if((Now - m_LastGetTempTime[Type][Index]) <= 1000) // check if 1000 msec has passed since last read
-    {
-        RetValue = m_CurrentTemperatures[Type][Index];
-    }
-    else
+    qint64 TimeStamp;
+    m_CurrentTemperatures[Type][Index].Load(RetValue, TimeStamp);
+    if((Now - TimeStamp) > 1000) // check if 1000 msec has passed since the last sample
     {
         //LogDebug(QString("In Retort device, invalid temperature. Current state is: %1").arg(m_MainState));
         RetValue = UNDEFINED_4_BYTE;
@@ -829,10 +845,10 @@ bool CRetortDevice::IsInsideRange(RTTempCtrlType_t Type, quint8 Index)
     if(!qFuzzyCompare(GetTemperature(Type, 0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperatures[Type],UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperatures[Type][Index] > m_TargetTemperatures[Type] - TOLERANCE)||
-                            (m_CurrentTemperatures[Type][Index] < m_TargetTemperatures[Type] + TOLERANCE))
+            if ((m_CurrentTemperatures[Type][Index].Value() > m_TargetTemperatures[Type] - TOLERANCE)||
+                            (m_CurrentTemperatures[Type][Index].Value() < m_TargetTemperatures[Type] + TOLERANCE))
             {
                 return true;
             }
@@ -860,10 +876,10 @@ bool CRetortDevice::IsOutsideRange(RTTempCtrlType_t Type, quint8 Index)
     if(!qFuzzyCompare(GetTemperature(Type, 0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperatures[Type],UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperatures[Type][Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperatures[Type][Index] < m_TargetTemperatures[Type] - TOLERANCE)||
-                            (m_CurrentTemperatures[Type][Index] > m_TargetTemperatures[Type] + TOLERANCE))
+            if ((m_CurrentTemperatures[Type][Index].Value() < m_TargetTemperatures[Type] - TOLERANCE)||
+                            (m_CurrentTemperatures[Type][Index].Value() > m_TargetTemperatures[Type] + TOLERANCE))
             {
                 return true;
             }
@@ -987,9 +1003,14 @@ void CRetortDevice::OnSetTemp(quint32 /*InstanceID*/, ReturnCode_t ReturnCode, q
 qreal CRetortDevice::GetTemperature(RTTempCtrlType_t Type, quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    qreal RetValue = m_CurrentTemperatures[Type][Index];
-    if((Now - m_LastGetTempTime[Type][Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    qreal RetValue;
+    qint64 TimeStamp;
+    m_CurrentTemperatures[Type][Index].Load(RetValue, TimeStamp);
+    // the sample is kept recent by the telemetry, request it only if it is too old
+    if((Now - TimeStamp) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Type][Index]) >= m_TelemetryMaxAge)
     {
+        // tells OnGetTemp which sample answers this request
+        m_PendingGetTemp.storeRelease(((Type << 8) | Index) + 1);
         ReturnCode_t retCode = m_pTempCtrls[Type]->ReqActTemperature(Index);
         if (DCL_ERR_FCT_CALL_SUCCESS != retCode )
         {
@@ -1011,10 +1032,11 @@ qreal CRetortDevice::GetTemperature(RTTempCtrlType_t Type, quint8 Index)
             }
             else
             {
-                RetValue = m_CurrentTemperatures[Type][Index];
+                RetValue = m_CurrentTemperatures[Type][Index].Value();
             }
             m_LastGetTempTime[Type][Index] = Now;
         }
+        m_PendingGetTemp.storeRelease(0);
     }
     return RetValue;
 }
@@ -1032,7 +1054,7 @@ qreal CRetortDevice::GetTemperature(RTTempCtrlType_t Type, quint8 Index)
 ReturnCode_t CRetortDevice::GetTemperatureAsync(RTTempCtrlType_t Type, quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    if((Now - m_LastGetTempTime[Type][Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    if(m_CurrentTemperatures[Type][Index].Age(Now) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Type][Index]) >= m_TelemetryMaxAge)
     {
         m_LastGetTempTime[Type][Index] = Now;
         return m_pTempCtrls[Type]->ReqActTemperature(Index);
@@ -1055,19 +1077,23 @@ ReturnCode_t CRetortDevice::GetTemperatureAsync(RTTempCtrlType_t Type, quint8 In
 /****************************************************************************/
 void CRetortDevice::OnGetTemp(quint32 InstanceID, ReturnCode_t ReturnCode, quint8 Index, qreal Temp)
 {
-    Q_UNUSED(Index)
+    if(Index >= MAX_SENSOR_PER_TEMP_CTRL)
+    {
+        return;
+    }
 
     if(DCL_ERR_FCT_CALL_SUCCESS == ReturnCode)
     {
         FILE_LOG_L(laDEVPROC, llINFO) << "INFO: Retort Get temperature successful! ";
-        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index] = Temp;
+        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index].Store(Temp, QDateTime::currentMSecsSinceEpoch());
     }
     else
     {
         FILE_LOG_L(laDEVPROC, llWARNING) << "WARNING: Retort get temperature failed! " << ReturnCode; //lint !e641
-        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index] = UNDEFINED_4_BYTE;
+        m_CurrentTemperatures[m_InstTCTypeMap[InstanceID]][Index].Store(UNDEFINED_4_BYTE, QDateTime::currentMSecsSinceEpoch());
     }
-    if(m_pDevProc)
+    // a subscribed sample of another sensor must not resume a waiting call
+    if(m_pDevProc && m_PendingGetTemp.testAndSetOrdered(((m_InstTCTypeMap[InstanceID] << 8) | Index) + 1, 0))
     {
         m_pDevProc->ResumeFromSyncCall(SYNC_CMD_RT_GET_TEMP, ReturnCode);
     }
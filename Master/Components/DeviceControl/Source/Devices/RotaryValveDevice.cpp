@@ -345,6 +345,13 @@ ReturnCode_t CRotaryValveDevice::HandleConfigurationState()
     }
     Reset();
 
+    // let the Slave send its temperatures periodically, so the getters do not
+    // have to request them
+    if(m_TelemetryInterval > 0 && m_pTempCtrl && m_pTempCtrl->SubscribeActTemperature(m_TelemetryInterval) != DCL_ERR_FCT_CALL_SUCCESS)
+    {
+        FILE_LOG_L(laDEV, llWARNING) << "   Temperature telemetry not subscribed";
+    }
+
     return DCL_ERR_FCT_CALL_SUCCESS;
 
 }
@@ -597,9 +604,14 @@ void CRotaryValveDevice::OnSetTemp(quint32 /*InstanceID*/, ReturnCode_t ReturnCo
 qreal CRotaryValveDevice::GetTemperature(quint32 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
-    qreal RetValue = m_CurrentTemperature[Index];
-    if((Now - m_LastGetTempTime[Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
-    {
+    qreal RetValue;
+    qint64 TimeStamp;
+    m_CurrentTemperature[Index].Load(RetValue, TimeStamp);
+    // the sample is kept recent by the telemetry, request it only if it is too old
+    if((Now - TimeStamp) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Index]) >= m_TelemetryMaxAge)
+    {
+        // tells OnGetTemp which sample answers this request
+        m_PendingGetTemp.storeRelease(Index + 1);
         ReturnCode_t retCode;
         if(m_pTempCtrl)
         {
@@ -629,10 +641,11 @@ qreal CRotaryValveDevice::GetTemperature(quint32 Index)
             }
             else
             {
-                RetValue = m_CurrentTemperature[Index];
+                RetValue = m_CurrentTemperature[Index].Value();
             }
             m_LastGetTempTime[Index] = Now;
         }
+        m_PendingGetTemp.storeRelease(0);
     }
     return RetValue;
 }
@@ -650,7 +663,7 @@ ReturnCode_t CRotaryValveDevice::GetTemperatureAsync(quint8 Index)
 {
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
     ReturnCode_t retCode = DCL_ERR_FCT_CALL_SUCCESS;
-    if((Now - m_LastGetTempTime[Index]) >= CHECK_SENSOR_TIME) // check if 800 msec has passed since last read
+    if(m_CurrentTemperature[Index].Age(Now) >= m_TelemetryMaxAge && (Now - m_LastGetTempTime[Index]) >= m_TelemetryMaxAge)
     {
         m_LastGetTempTime[Index] = Now;
         if(m_pTempCtrl)
@@ -679,9 +692,12 @@ qreal CRotaryValveDevice::GetRecentTemperature(quint32 Index)
     //QMutexLocker Locker(&m_Mutex);
     qint64 Now = QDateTime::currentMSecsSinceEpoch();
     qreal RetValue = UNDEFINED_4_BYTE;
-    if((Now - m_LastGetTempTime[Index]) <= 1000) // check if 1000 msec has passed since last read
+    qreal Temperature;
+    qint64 TimeStamp;
+    m_CurrentTemperature[Index].Load(Temperature, TimeStamp);
+    if((Now - TimeStamp) <= 1000) // check if 1000 msec has passed since the last sample
     {
-        RetValue = m_CurrentTemperature[Index];
+        RetValue = Temperature;
     }
     else
     {
@@ -734,19 +750,23 @@ quint8 CRotaryValveDevice::GetRecentHeaterSwitchType()
 /****************************************************************************/
 void CRotaryValveDevice::OnGetTemp(quint32 /*InstanceID*/, ReturnCode_t ReturnCode, quint8 Index, qreal Temp)
 {
-    Q_UNUSED(Index)
+    if(Index >= MAX_SENSOR_PER_TEMP_CTRL)
+    {
+        return;
+    }
 
     if(DCL_ERR_FCT_CALL_SUCCESS == ReturnCode)
     {
         FILE_LOG_L(laDEVPROC, llINFO) << "INFO: RV Get temperature successful! ";
-        m_CurrentTemperature[Index] = Temp;
+        m_CurrentTemperature[Index].Store(Temp, QDateTime::currentMSecsSinceEpoch());
     }
     else
     {
         FILE_LOG_L(laDEVPROC, llWARNING) << "WARNING: AL get temperature failed! " << ReturnCode; //lint !e641
-        m_CurrentTemperature[Index] = UNDEFINED_4_BYTE;
+        m_CurrentTemperature[Index].Store(UNDEFINED_4_BYTE, QDateTime::currentMSecsSinceEpoch());
     }
-    if(m_pDevProc)
+    // a subscribed sample of another sensor must not resume a waiting call
+    if(m_pDevProc && m_PendingGetTemp.testAndSetOrdered(Index + 1, 0))
     {
         m_pDevProc->ResumeFromSyncCall(SYNC_CMD_RV_GET_TEMP, ReturnCode);
     }
@@ -1088,10 +1108,10 @@ bool CRotaryValveDevice::IsInsideRange(quint8 Index)
     if(!qFuzzyCompare(GetTemperature(0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperature,UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperature[Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperature[Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperature[Index] > m_TargetTemperature - TOLERANCE)||
-                            (m_CurrentTemperature[Index] < m_TargetTemperature + TOLERANCE))
+            if ((m_CurrentTemperature[Index].Value() > m_TargetTemperature - TOLERANCE)||
+                            (m_CurrentTemperature[Index].Value() < m_TargetTemperature + TOLERANCE))
             {
                 return true;
             }
@@ -1116,10 +1136,10 @@ bool CRotaryValveDevice::IsOutsideRange(quint8 Index)
     if(!qFuzzyCompare(GetTemperature(0),UNDEFINED_4_BYTE))
     {
         if(!qFuzzyCompare(m_TargetTemperature,UNDEFINED_4_BYTE)
-                || !qFuzzyCompare(m_CurrentTemperature[Index],UNDEFINED_4_BYTE))
+                || !qFuzzyCompare(m_CurrentTemperature[Index].Value(),UNDEFINED_4_BYTE))
         {
-            if ((m_CurrentTemperature[Index] < m_TargetTemperature - TOLERANCE)||
-                            (m_CurrentTemperature[Index] > m_TargetTemperature + TOLERANCE))
+            if ((m_CurrentTemperature[Index].Value() < m_TargetTemperature - TOLERANCE)||
+                            (m_CurrentTemperature[Index].Value() > m_TargetTemperature + TOLERANCE))
             {
                 return true;
             }
@@ -2314,7 +2334,10 @@ void CRotaryValveDevice::Reset()
     memset( &m_LastGetTempTime, 0 , sizeof(m_LastGetTempTime)); //lint !e545
     m_TargetTempCtrlStatus = TEMPCTRL_STATUS_UNDEF;
     m_CurrentTempCtrlStatus = TEMPCTRL_STATUS_UNDEF;
-    memset(&m_CurrentTemperature, 0, sizeof(m_CurrentTemperature)); //lint !e545
+    for(quint8 i = 0; i < MAX_SENSOR_PER_TEMP_CTRL; i++)
+    {
+        m_CurrentTemperature[i].Clear();
+    }
     m_TargetTemperature = 0;
     memset( &m_MainsVoltageStatus, 0 , sizeof(m_MainsVoltageStatus)); //lint !e545
     memset( &m_TCHardwareStatus, 0 , sizeof(m_TCHardwareStatus)); //lint !e545
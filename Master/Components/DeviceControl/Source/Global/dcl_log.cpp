@@ -0,0 +1,484 @@
+/****************************************************************************/
+/*! \file dcl_log.cpp
+ *
+ *  \brief
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the output side of the device control logging:
+ *       the cached enable state and the asynchronous writer
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QMutex>
+#include <QThread>
+#include <QThreadStorage>
+#include <QMessageLogger>
+
+#include "DeviceControl/Include/Global/dcl_log.h"
+
+#define LOG_ENABLE_FILE             "./DEBUG"   //!< Logging is active while this file exists
+#define LOG_THREAD_BUFFER_SIZE      (64 * 1024) //!< Per thread buffer size, must be a power of two
+#define LOG_WRITER_INTERVAL_MS      50          //!< Maximum delay until a log entry is written
+#define LOG_REFRESH_INTERVAL_MS     1000        //!< Enable state check without inotify event
+
+namespace {
+
+/****************************************************************************/
+/*!
+ *  \brief  Single producer, single consumer byte ring of one thread
+ *
+ *      The owning thread appends complete log lines, the writer thread
+ *      drains them. A line which does not fit is dropped and counted, the
+ *      logging thread never waits for the writer. When the owning thread
+ *      exits, the buffer is retired and freed after its last drain.
+ */
+/****************************************************************************/
+class LogThreadBuffer
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     */
+    /****************************************************************************/
+    LogThreadBuffer() : m_Head(0), m_Tail(0), m_Dropped(0), m_Retired(0), mp_Next(NULL)
+    {
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Append a log line, called by the owning thread
+     *
+     *  \iparam pData = Log line
+     *  \iparam Length = Length of the log line
+     */
+    /****************************************************************************/
+    void Append(const char *pData, quint32 Length)
+    {
+        quint32 Head = static_cast<quint32>(m_Head.loadAcquire());
+        quint32 Tail = static_cast<quint32>(m_Tail.loadAcquire());
+
+        if (Length > LOG_THREAD_BUFFER_SIZE - (Head - Tail)) {
+            m_Dropped.fetchAndAddRelaxed(1);
+            return;
+        }
+
+        quint32 Offset = Head & (LOG_THREAD_BUFFER_SIZE - 1);
+        quint32 First = qMin(Length, static_cast<quint32>(LOG_THREAD_BUFFER_SIZE) - Offset);
+        memcpy(&m_Data[Offset], pData, First);
+        memcpy(&m_Data[0], pData + First, Length - First);
+
+        // ordered, so the caller's next check of the writer is not done before
+        (void)m_Head.fetchAndStoreOrdered(static_cast<int>(Head + Length));
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Write the buffered lines to a stream, called by the writer
+     *
+     *  \iparam pStream = Output stream
+     *
+     *  \return Number of bytes written
+     */
+    /****************************************************************************/
+    quint32 Drain(FILE *pStream)
+    {
+        quint32 Head = static_cast<quint32>(m_Head.loadAcquire());
+        quint32 Tail = static_cast<quint32>(m_Tail.loadAcquire());
+        quint32 Length = Head - Tail;
+
+        if (Length > 0) {
+            quint32 Offset = Tail & (LOG_THREAD_BUFFER_SIZE - 1);
+            quint32 First = qMin(Length, static_cast<quint32>(LOG_THREAD_BUFFER_SIZE) - Offset);
+            /*lint -save -e534 */
+            fwrite(&m_Data[Offset], 1, First, pStream);
+            fwrite(&m_Data[0], 1, Length - First, pStream);
+            /*lint -restore */
+            m_Tail.storeRelease(static_cast<int>(Head));
+        }
+
+        int Dropped = m_Dropped.fetchAndStoreRelaxed(0);
+        if (Dropped > 0) {
+            fprintf(pStream, " %s log: %d entries dropped, buffer full\n", NowDateTime().c_str(), Dropped);
+        }
+        return Length;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Marks the buffer as unused, called by the owning thread on exit
+     */
+    /****************************************************************************/
+    void Retire() { (void)m_Retired.fetchAndStoreOrdered(1); }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns if the buffer is retired and all its lines are written
+     *
+     *  \return True if the buffer can be freed
+     */
+    /****************************************************************************/
+    bool IsFinished() const
+    {
+        return (m_Retired.loadAcquire() != 0) && (m_Head.loadAcquire() == m_Tail.loadAcquire());
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the next buffer of the buffer list
+     *
+     *  \return Next buffer or NULL
+     */
+    /****************************************************************************/
+    LogThreadBuffer *Next() const { return mp_Next; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Links the buffer into the buffer list
+     *
+     *  \iparam pNext = Current head of the list
+     */
+    /****************************************************************************/
+    void SetNext(LogThreadBuffer *pNext) { mp_Next = pNext; }
+
+private:
+    char m_Data[LOG_THREAD_BUFFER_SIZE];    //!< Ring storage
+    QAtomicInt m_Head;                      //!< Write position, owning thread
+    QAtomicInt m_Tail;                      //!< Read position, writer thread
+    QAtomicInt m_Dropped;                   //!< Lines dropped since last drain
+    QAtomicInt m_Retired;                   //!< Set when the owning thread exited
+    LogThreadBuffer *mp_Next;               //!< Next buffer in the list
+
+    Q_DISABLE_COPY(LogThreadBuffer)
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Background thread writing the per thread buffers to the stream
+ */
+/****************************************************************************/
+class LogWriterThread : public QThread
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     */
+    /****************************************************************************/
+    LogWriterThread() : m_Stop(0)
+    {
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Request the thread to drain all buffers and exit
+     */
+    /****************************************************************************/
+    void Stop()
+    {
+        m_Stop.storeRelease(1);
+    }
+
+private:
+    void run();
+
+    QAtomicInt m_Stop;  //!< Exit request
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Owner of a thread's buffer, deleted when the thread exits
+ */
+/****************************************************************************/
+class LogBufferHolder
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam pBuffer = Buffer of the calling thread
+     */
+    /****************************************************************************/
+    explicit LogBufferHolder(LogThreadBuffer *pBuffer) : mp_Buffer(pBuffer)
+    {
+    }
+
+    ~LogBufferHolder();
+
+private:
+    LogThreadBuffer *mp_Buffer; //!< Buffer of the thread
+
+    Q_DISABLE_COPY(LogBufferHolder)
+};
+
+//! List of all thread buffers, new buffers are added at the head
+QAtomicPointer<LogThreadBuffer> s_BufferList;
+//! Serializes buffer registration and draining
+QMutex s_BufferListLock;
+//! Retires the buffer of a thread when the thread exits
+QThreadStorage<LogBufferHolder *> s_BufferHolder;
+//! Serializes synchronous output and writer start/stop
+QMutex s_OutputLock;
+//! The running writer thread or NULL
+QAtomicPointer<LogWriterThread> s_pWriter;
+//! Buffer of the calling thread
+__thread LogThreadBuffer *t_pBuffer = NULL;
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the buffer of the calling thread, creates it on first use
+ *
+ *      The buffer is retired when the thread exits. It is freed after
+ *      its remaining log lines are written.
+ *
+ *  \return Buffer of the calling thread
+ */
+/****************************************************************************/
+LogThreadBuffer *ThreadBuffer()
+{
+    if (t_pBuffer == NULL) {
+        LogThreadBuffer *pBuffer = new LogThreadBuffer();
+        QMutexLocker Locker(&s_BufferListLock);
+        pBuffer->SetNext(s_BufferList.loadAcquire());
+        s_BufferList.storeRelease(pBuffer);
+        t_pBuffer = pBuffer;
+        s_BufferHolder.setLocalData(new LogBufferHolder(pBuffer));
+    }
+    return t_pBuffer;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Write all buffered lines to the stream and free retired buffers
+ *
+ *      Called by the writer thread, or with s_OutputLock held while the
+ *      writer is not running.
+ */
+/****************************************************************************/
+void DrainBuffers()
+{
+    QMutexLocker Locker(&s_BufferListLock);
+    FILE *pStream = Output2FILE::Stream();
+    quint32 Written = 0;
+    LogThreadBuffer *pPrevious = NULL;
+    LogThreadBuffer *pBuffer = s_BufferList.loadAcquire();
+
+    while (pBuffer != NULL) {
+        if (pStream != NULL) {
+            Written += pBuffer->Drain(pStream);
+        }
+        LogThreadBuffer *pNext = pBuffer->Next();
+        if (pBuffer->IsFinished()) {
+            if (pPrevious == NULL) {
+                s_BufferList.storeRelease(pNext);
+            }
+            else {
+                pPrevious->SetNext(pNext);
+            }
+            delete pBuffer;
+        }
+        else {
+            pPrevious = pBuffer;
+        }
+        pBuffer = pNext;
+    }
+    if (Written > 0) {
+        /*lint -save -e534 */
+        fflush(pStream);
+        /*lint -restore */
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  The writer thread's execution function
+ *
+ *      The function writes the buffered log lines every
+ *      LOG_WRITER_INTERVAL_MS. Creating or deleting files in the working
+ *      directory wakes it up to refresh the enable state at once.
+ */
+/****************************************************************************/
+void LogWriterThread::run()
+{
+    int Notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (Notify >= 0) {
+        if (inotify_add_watch(Notify, ".", IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM) < 0) {
+            close(Notify);
+            Notify = -1;
+        }
+    }
+
+    int SinceRefresh = 0;
+    while (m_Stop.loadAcquire() == 0) {
+        bool Refresh = (SinceRefresh >= LOG_REFRESH_INTERVAL_MS);
+
+        if (Notify >= 0) {
+            struct pollfd PollFd;
+            PollFd.fd = Notify;
+            PollFd.events = POLLIN;
+            PollFd.revents = 0;
+            if (poll(&PollFd, 1, LOG_WRITER_INTERVAL_MS) > 0) {
+                char Events[1024];
+                while (read(Notify, Events, sizeof(Events)) > 0) {
+                }
+                Refresh = true;
+            }
+        }
+        else {
+            QThread::msleep(LOG_WRITER_INTERVAL_MS);
+        }
+        SinceRefresh += LOG_WRITER_INTERVAL_MS;
+
+        if (Refresh) {
+            Output2FILE::RefreshEnableState();
+            SinceRefresh = 0;
+        }
+        DrainBuffers();
+    }
+
+    DrainBuffers();
+    if (Notify >= 0) {
+        close(Notify);
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Destructor, retires the buffer of the exiting thread
+ *
+ *      The writer frees the buffer after its last drain. Without a writer,
+ *      the buffer is drained and freed here.
+ */
+/****************************************************************************/
+LogBufferHolder::~LogBufferHolder()
+{
+    t_pBuffer = NULL;
+    mp_Buffer->Retire();
+    if (s_pWriter.loadAcquire() == NULL) {
+        QMutexLocker Locker(&s_OutputLock);
+        if (s_pWriter.loadAcquire() == NULL) {
+            DrainBuffers();
+        }
+    }
+}
+
+} // end namespace
+
+/****************************************************************************/
+/*!
+ *  \brief   Outputs the string to the logging stream
+ *
+ *      If the writer thread is running, the string is queued in the buffer
+ *      of the calling thread. Otherwise it is written at once. A string
+ *      queued while the writer stops is written by the calling thread.
+ *
+ *  \param    msg = Logging message string
+ *
+ ****************************************************************************/
+void Output2FILE::Output(const std::string& msg)
+{
+    if (ActiveLevel(laUNDEF) == LOG_LEVEL_UNKNOWN) {
+        RefreshEnableState();
+    }
+    if (ActiveLevel(laUNDEF) == LOG_LEVEL_DISABLED) {
+        return;
+    }
+
+    if (s_pWriter.loadAcquire() != NULL) {
+        ThreadBuffer()->Append(msg.data(), static_cast<quint32>(msg.size()));
+        if (s_pWriter.loadAcquire() != NULL) {
+            return;
+        }
+        // the writer stopped, its last drain may have missed the string
+        QMutexLocker Locker(&s_OutputLock);
+        if (s_pWriter.loadAcquire() == NULL) {
+            DrainBuffers();
+        }
+        return;
+    }
+
+    QMutexLocker Locker(&s_OutputLock);
+    FILE* pStream = Stream();
+    if (!pStream)
+        return;
+    fprintf(pStream, "%s", msg.c_str());
+    /*lint -save -e534 */
+    //ignoring return value of fflush
+    fflush(pStream);
+    /*lint -restore */
+}
+
+/****************************************************************************/
+/*!
+ *  \brief   Reads the logging state and updates the cached level table
+ *
+ *      Logging is active if an output stream is set and the file ./DEBUG
+ *      exists. The level of each area is then taken from ReportingLevel().
+ *
+ ****************************************************************************/
+void Output2FILE::RefreshEnableState()
+{
+    bool Enabled = (Stream() != NULL) && (access(LOG_ENABLE_FILE, F_OK) == 0);
+    volatile int *pLevels = AreaLevels();
+
+    for (int Area = 0; Area < LOG_AREA_COUNT; Area++) {
+        pLevels[Area] = Enabled ? (int)FILELog::ReportingLevel((TLogArea_t)Area) : LOG_LEVEL_DISABLED;
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief   Starts the asynchronous writer thread
+ *
+ *      Call this after the output stream was set.
+ *
+ ****************************************************************************/
+void Output2FILE::StartWriter()
+{
+    QMutexLocker Locker(&s_OutputLock);
+    RefreshEnableState();
+    if (s_pWriter.loadAcquire() == NULL) {
+        LogWriterThread *pWriter = new LogWriterThread();
+        pWriter->start(QThread::LowPriority);
+        s_pWriter.storeRelease(pWriter);
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief   Stops the writer thread after all buffered lines are written
+ *
+ ****************************************************************************/
+void Output2FILE::StopWriter()
+{
+    QMutexLocker Locker(&s_OutputLock);
+    LogWriterThread *pWriter = s_pWriter.fetchAndStoreOrdered(NULL);
+    if (pWriter != NULL) {
+        pWriter->Stop();
+        /*lint -save -e534 */
+        pWriter->wait();
+        /*lint -restore */
+        delete pWriter;
+    }
+}
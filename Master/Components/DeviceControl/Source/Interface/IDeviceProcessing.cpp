@@ -53,7 +53,7 @@ namespace DeviceControl
 {
 //2* 60 * 60 * 1000;
 const int INTERVAL_SAVE_SERVICE_LIFE_CYCLE = 2 * 60 * 60 * 1000;  //!< 2 hours
-const int INTERVAL_SAVE_LIFE_CYCLE_RECORD =  10 * 60 * 1000;  //!< 10 mintues
+const int INTERVAL_SAVE_LIFE_CYCLE_RECORD =  30 * 1000;  //!< 30 seconds, only the changed counters are appended to the journal
 
 /****************************************************************************/
 /*!
@@ -76,6 +76,7 @@ IDeviceProcessing::IDeviceProcessing(int DevProcTimerInterval) :
     /* activate the logging */
     FILE* pFile = fopen("device_control.log", "w");
     Output2FILE::Stream() = pFile;
+    Output2FILE::StartWriter();
 
     mp_DevProc = new DeviceProcessing(this);
     mp_DevProcThread = new QThread(); //!< Device processing thread
@@ -100,7 +101,6 @@ IDeviceProcessing::IDeviceProcessing(int DevProcTimerInterval) :
 
     CONNECTSIGNALSLOT(&m_SaveLifeCycleRecordTimer, timeout(),this, OnTimeOutSaveLifeCycleRecord());
     m_SaveLifeCycleRecordTimer.setInterval(INTERVAL_SAVE_LIFE_CYCLE_RECORD);
-    m_SaveLifeCycleRecordTimer.setSingleShot(true);
 
     // Shutdown signal to device threads
     CONNECTSIGNALSIGNAL(this, DeviceShutdown(), mp_DevProc, DeviceShutdown());
@@ -132,6 +132,7 @@ IDeviceProcessing::~IDeviceProcessing()
         delete mp_DevProcThread;
         delete mp_DevProc;
         delete m_pDeviceConfig;
+        Output2FILE::StopWriter();
 //        m_pRotaryValves.clear();
 //        m_pAirLiquids.clear();
 //        m_pRetorts.clear();
@@ -157,6 +158,9 @@ void IDeviceProcessing::ThreadStarted()
     mp_DevProcTimer = new QTimer(this);
     CONNECTSIGNALSLOT(mp_DevProcTimer, timeout(), this, HandleTasks());
     mp_DevProcTimer->start(m_DevProcTimerInterval);
+
+    // queued, the scheduler is woken up from the CAN thread and from within HandleTasks
+    CONNECTSIGNALSLOTQUEUED(&mp_DevProc->GetScheduler(), ReportReady(), this, HandleTasks());
 }
 
 /****************************************************************************/
@@ -225,7 +229,18 @@ void IDeviceProcessing::HandleTasks()
 
     m_Mutex.lock();
     mp_DevProc->HandleTasks();
+    qint64 Interval = mp_DevProc->GetNextTaskInterval();
     m_Mutex.unlock();
+
+    // the event driven scheduler sleeps until the next deadline
+    if (mp_DevProcTimer->isActive()) {
+        if (Interval >= 0) {
+            mp_DevProcTimer->start(static_cast<int>(Interval));
+        }
+        else if (mp_DevProcTimer->interval() != m_DevProcTimerInterval) {
+            mp_DevProcTimer->start(m_DevProcTimerInterval);
+        }
+    }
 }
 
 /****************************************************************************/
@@ -440,6 +455,7 @@ void IDeviceProcessing::InitArchiveServiceInforState()
     }
     p_LastState->addTransition(p_LastState, SIGNAL(finished()), p_Final);
     m_TimerSaveServiceInfor.start();
+    m_SaveLifeCycleRecordTimer.start();
     m_machine.start();
 }
 
@@ -609,6 +625,41 @@ CBaseModule* IDeviceProcessing::GetNode(bool First)
     return mp_DevProc->GetCANNodeFromObjectTree(First);
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Selects polling or event driven scheduling of the modules
+ *
+ *      With polling, all modules are run every DevProcTimerInterval. With
+ *      event driven scheduling, the modules are only run in normal operation
+ *      when a CAN message was received for them, a command was requested or
+ *      a deadline expired.
+ *
+ *  \iparam Mode = Polling or event mode
+ */
+/****************************************************************************/
+void IDeviceProcessing::SetSchedulerMode(CTaskScheduler::SchedulerMode_t Mode)
+{
+    QMutexLocker locker(&m_Mutex);
+    mp_DevProc->SetSchedulerMode(Mode);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the wake up latency statistics of the scheduler
+ *
+ *      The statistics are reset when the scheduler mode is changed.
+ *
+ *  \return Count, median, 99th percentile and maximum of the time from
+ *          receiving a CAN message or requesting a command until the module
+ *          is run
+ */
+/****************************************************************************/
+QString IDeviceProcessing::GetSchedulerStatistics()
+{
+    QMutexLocker locker(&m_Mutex);
+    return mp_DevProc->GetScheduler().GetStatistics();
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Send an emergency stop message to all nodes
@@ -614,6 +614,7 @@ bool CAnalogInput::SetModuleTask(CANAnalogInputModuleCmdType_t CommandType, quin
                 m_ModuleCommand[idx].Type = CommandType;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
@@ -686,6 +686,7 @@ bool CAnalogOutput::SetModuleTask(CANAnalogOutputModuleCmdType_t CommandType, qu
                 m_ModuleCommand[idx].m_Type = CommandType;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
@@ -33,6 +33,8 @@
 #include "DeviceControl/Include/SlaveModules/Rfid11785.h"
 #include "DeviceControl/Include/SlaveModules/Rfid15693.h"
 #include "DeviceControl/Include/SlaveModules/TemperatureControl.h"
+#include "DeviceControl/Include/DeviceProcessing/TaskScheduler.h"
+#include "DeviceControl/Include/DeviceProcessing/BootTimeline.h"
 #include "DeviceControl/Include/SlaveModules/BaseModule.h"
 #include "DeviceControl/Include/Global/dcl_log.h"
 #include "Global/Include/AdjustedTime.h"
@@ -49,6 +51,9 @@ namespace DeviceControl
 #define CANNODE_CANMSG_DCL_HARDWAREID       7   //!< Data code length of 'HardwareID' CAN-message
 #define CANNODE_CANMSG_DCL_CONFIGURATION    6   //!< Data code length of 'Configuration' CAN-message
 
+#define CANNODE_CONFIG_BURST_INTERVAL      10   //!< Time between two bursts of function module configuration messages [ms]
+#define CANNODE_CONFIG_BURST_MESSAGES       4   //!< Configuration messages sent to the node in one burst
+
 QMap<quint32, std::string> CBaseModule::m_EventString;  // static string list with info strings for CAN events
 
 /****************************************************************************/
@@ -103,6 +108,7 @@ CBaseModule::CBaseModule(const CANMessageConfiguration *p_MessageConfiguration,
     m_bHeartbeatActive = 0;
     m_bHBErrorState = 0;
     m_LastCheckTime = 0;
+    m_ConfigBurstMessages = 0;
 
     //Heartbeat timer initialization
     if(ftime(&m_tbHeartbeatTimeDelay) != 0)
@@ -550,12 +556,17 @@ void CBaseModule::CallHandleTaskFctModules()
 {
     CFunctionModule* pFctModule = 0;
     QListIterator<CFunctionModule*> iterFctMod(m_FunctionModuleList);
+    CTaskScheduler* pScheduler = GetScheduler();
 
     iterFctMod.toFront();
     while (iterFctMod.hasNext())
     {
         pFctModule = iterFctMod.next();
         pFctModule->HandleTasks();
+        if(pScheduler)
+        {
+            pScheduler->Handled(pFctModule);
+        }
     }
 }
 
@@ -629,6 +640,8 @@ void CBaseModule::HandleTaskInitialization(can_frame* pCANframe)
                     FILE_LOG_L(laINIT, llDEBUG) << "CANNode " << GetName().toStdString() << ": send initialization acknowledge: 0x"
                                                 << std::hex << m_unCanIDAcknHardwareID;
 
+                    CBootTimeline::Instance().MarkNode(GetKey(), "hardware ID acknowledged");
+
                     //after sending the 'HardwareIDAckn'-message, activate heartbeat supervision
                     SetHeartbeatSupervision(true);
 
@@ -714,6 +727,7 @@ void CBaseModule::HandleTaskConfiguration(can_frame* pCANframe)
             RetVal = SendConfigurationRequest();
             if(RetVal == DCL_ERR_FCT_CALL_SUCCESS)
             {
+                CBootTimeline::Instance().MarkNode(GetKey(), "configuration requested");
                 m_SubStateConfig = CN_SUB_STATE_CONFIG_REQ;
                 StartTimeDelay();
             }
@@ -950,6 +964,7 @@ void CBaseModule::HandleTaskConfiguration(can_frame* pCANframe)
             m_SubStateInitFct = CN_SUB_STATE_INIT_FCT_START;
             m_MainState = CN_MAIN_STATE_FCT_CONFIG;
             FILE_LOG_L(laCONFIG, llINFO) << "CANNode " << GetName().toStdString() << ": all fct modules confirmed.";
+            CBootTimeline::Instance().MarkNode(GetKey(), "function modules confirmed");
         }
         else
         {
@@ -960,6 +975,33 @@ void CBaseModule::HandleTaskConfiguration(can_frame* pCANframe)
     }
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Takes one configuration message from the node's send budget
+ *
+ *      The function modules of a node share one budget of configuration
+ *      messages per burst interval. The slave's CAN receive queue holds only
+ *      24 messages, so all modules of the node together must not send more
+ *      than a few messages per interval.
+ *
+ *  \return  true if the message may be sent now, otherwise false
+ */
+/****************************************************************************/
+bool CBaseModule::TakeConfigMessage()
+{
+    if(m_ConfigBurstTime.Elapsed() > CANNODE_CONFIG_BURST_INTERVAL)
+    {
+        m_ConfigBurstMessages = 0;
+        m_ConfigBurstTime.Trigger();
+    }
+    if(m_ConfigBurstMessages >= CANNODE_CONFIG_BURST_MESSAGES)
+    {
+        return false;
+    }
+    m_ConfigBurstMessages++;
+    return true;
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Handles the main state CN_MAIN_STATE_FCT_CONFIG.
@@ -1010,6 +1052,7 @@ void CBaseModule::HandleTaskFctConfiguration()
         m_TaskID = MODULE_TASKID_FREE;
         m_Mutex.unlock();
 
+        CBootTimeline::Instance().MarkNode(GetKey(), "function modules configured");
         FILE_LOG_L(laCONFIG, llDEBUG) << "CANNode " << GetName().toStdString() << ": all fct modules configured";
         FILE_LOG_L(laCONFIG, llDEBUG) << "            change to CN_MAIN_STATE_IDLE and set operation mode";
     }
@@ -1069,7 +1112,12 @@ void CBaseModule::HandleIdleState()
         m_LastCheckTime = now;
     }
 
-    CallHandleTaskFctModules();
+    // the event driven scheduler runs the function modules when they are ready
+    CTaskScheduler* pScheduler = GetScheduler();
+    if((pScheduler == 0) || !pScheduler->IsDispatching())
+    {
+        CallHandleTaskFctModules();
+    }
     m_Mutex.lock();
     if(m_TaskID == MODULE_TASKID_COMMAND_HDL)
     {
@@ -1691,7 +1739,7 @@ ReturnCode_t CBaseModule::SendCANMsgEmgcyStop(bool enter)
     canmsg.can_id &= 0x1ff80001;        // make it a broadcast msg by setting node type, node index and channel to zero
     canmsg.data[0] = (enter ? 1 : 0);
     canmsg.can_dlc = 1;
-    RetVal = m_pCANCommunicator->SendCOB(canmsg);
+    RetVal = m_pCANCommunicator->SendCOB(canmsg, CAN_TX_PRIO_HIGH);
 
     return RetVal;
 }
@@ -3680,6 +3728,7 @@ CBaseModule::ModuleCommand_t *CBaseModule::SetModuleTask(CANNodeModuleCmdType_t
         m_ModuleCommand.append(p_ModuleCommand);
 
         m_TaskID = MODULE_TASKID_COMMAND_HDL;
+        Wake();
 
         return p_ModuleCommand;
     }
@@ -34,8 +34,6 @@ namespace DeviceControl
 {
 
 const qint32 CBootLoader::m_Timeout = 5000;
-const quint32 CBootLoader::m_Crc32Polynomial = 0x04C11DB7;
-const quint32 CBootLoader::m_Crc32InitialValue = 0xFFFFFFFF;
 
 /****************************************************************************/
 /*!
@@ -125,21 +123,43 @@ CBootLoader::CBootLoader(const CANMessageConfiguration *p_CanMsgConfig, const qu
  */
 /****************************************************************************/
 ReturnCode_t CBootLoader::UpdateFirmware(const QString &FirmwarePath)
+{
+    if (FirmwarePath.isNull() || FirmwarePath.isEmpty()) {
+        return DCL_ERR_INVALID_PARAM;
+    }
+
+    QFile FirmwareImage(FirmwarePath);
+    if (FirmwareImage.open(QIODevice::ReadOnly) == false) {
+        return DCL_ERR_INVALID_PARAM;
+    }
+    return UpdateFirmware(FirmwareImage.readAll());
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  This initiates a firmware update
+ *
+ *      The image is held in memory during the update. The update requests a
+ *      window of CFirmwareTransfer::m_MaxWindow frames from the boot loader.
+ *
+ *  \iparam Image = The firmware image
+ *
+ *  \return DCL_ERR_FCT_CALL_SUCCESS if the CAN message was successful placed
+ *          in transmit queue, otherwise the return code from SendCOB(..)
+ */
+/****************************************************************************/
+ReturnCode_t CBootLoader::UpdateFirmware(const QByteArray &Image)
 {
     QMutexLocker Locker(&m_Mutex);
 
     if (m_State != BOOTLOADER_ACTIVE) {
         return DCL_ERR_INVALID_STATE;
     }
-    if (FirmwarePath.isNull() || FirmwarePath.isEmpty()) {
-        return DCL_ERR_INVALID_PARAM;
-    }
-
-    m_FirmwareImage.setFileName(FirmwarePath);
-    if (m_FirmwareImage.open(QIODevice::ReadOnly) == false) {
+    if (Image.isEmpty()) {
         return DCL_ERR_INVALID_PARAM;
     }
 
+    m_Transfer.Start(Image, CFirmwareTransfer::m_MaxWindow);
     m_WaitForUpdate = true;
     m_State = BOOTLOADER_FIRMWARE;
     m_Timer.start();
@@ -165,10 +185,11 @@ ReturnCode_t CBootLoader::UpdateBootLoader(const QString &BootLoaderPath)
         return DCL_ERR_INVALID_STATE;
     }
 
-    m_FirmwareImage.setFileName(BootLoaderPath);
-    if (m_FirmwareImage.open(QIODevice::ReadOnly) == false) {
+    QFile BootLoaderImage(BootLoaderPath);
+    if (BootLoaderImage.open(QIODevice::ReadOnly) == false) {
         return DCL_ERR_INVALID_PARAM;
     }
+    m_Transfer.Start(BootLoaderImage.readAll(), CFirmwareTransfer::m_MaxWindow);
 
     m_State = BOOTLOADER_BOOTLOADER;
     m_Timer.start();
@@ -227,27 +248,28 @@ bool CBootLoader::Active() const
 
 /****************************************************************************/
 /*!
- *  \brief  Sends a firmware data packet to the boot loader
+ *  \brief  Sends firmware data packets to the boot loader
  *
- *  \return DCL_ERR_FCT_CALL_SUCCESS if the CAN message was successful placed
+ *      Sends as many packets as the window of the transfer allows.
+ *
+ *  \return DCL_ERR_FCT_CALL_SUCCESS if the CAN messages were successful placed
  *          in transmit queue, otherwise the return code from SendCOB(..)
  */
 /****************************************************************************/
 ReturnCode_t CBootLoader::SendData()
 {
     can_frame CanMsg;
+    quint8 Length;
+    bool Odd;
 
-    if (((m_FirmwareImage.pos() / 8) % 2) == 0) {
-        CanMsg.can_id = m_CanIdUpdateData0;
-    }
-    else {
-        CanMsg.can_id = m_CanIdUpdateData1;
-    }
-
-    CanMsg.can_dlc = m_FirmwareImage.read(reinterpret_cast<char *>(CanMsg.data), 8);
+    while (m_Transfer.NextFrame(CanMsg.data, Length, Odd)) {
+        CanMsg.can_id = Odd ? m_CanIdUpdateData1 : m_CanIdUpdateData0;
+        CanMsg.can_dlc = Length;
 
-    if (CanMsg.can_dlc != 0) {
-        return mp_CanCommunicator->SendCOB(CanMsg);
+        ReturnCode_t ReturnCode = mp_CanCommunicator->SendCOB(CanMsg);
+        if (ReturnCode != DCL_ERR_FCT_CALL_SUCCESS) {
+            return ReturnCode;
+        }
     }
     return DCL_ERR_FCT_CALL_SUCCESS;
 }
@@ -287,7 +309,7 @@ ReturnCode_t CBootLoader::UpdateInfo(const quint8 *p_Info, quint32 Size, quint8
         m_UpdateType = UpdateType;
 
         // Calculate CRC and fill it into last 4 bytes of info block
-        quint32 Crc32 = CalculateCrc(mp_Info, Size-4);
+        quint32 Crc32 = CFirmwareTransfer::CalculateCrc(mp_Info, Size-4);
         *((quint32*)(mp_Info + Size - 4)) = Crc32;
 
         m_State = BOOTLOADER_INFO;
@@ -359,6 +381,10 @@ ReturnCode_t CBootLoader::SendModeRequest(bool StartUpdate)
 /*!
  *  \brief  Sends an update header message to the node
  *
+ *      Byte 4 of the header requests a window size from the node, the
+ *      remaining three bytes are the offset within the image area. Nodes not
+ *      supporting a window read a large offset and reject the header.
+ *
  *  \return DCL_ERR_FCT_CALL_SUCCESS if the CAN message was successful placed
  *          in transmit queue, otherwise the return code from SendCOB(..)
  */
@@ -366,7 +392,7 @@ ReturnCode_t CBootLoader::SendModeRequest(bool StartUpdate)
 ReturnCode_t CBootLoader::SendHeader()
 {
     can_frame CanMsg;
-    quint32 FirmwareSize = m_FirmwareImage.size();
+    quint32 FirmwareSize = m_Transfer.GetSize();
 
     CanMsg.can_id = m_CanIdUpdateHeader;
     CanMsg.can_dlc = 8;
@@ -374,7 +400,7 @@ ReturnCode_t CBootLoader::SendHeader()
     CanMsg.data[1] = FirmwareSize >> 16;
     CanMsg.data[2] = FirmwareSize >> 8;
     CanMsg.data[3] = FirmwareSize;
-    CanMsg.data[4] = 0;
+    CanMsg.data[4] = m_Transfer.GetWindow();
     CanMsg.data[5] = 0;
     CanMsg.data[6] = 0;
     CanMsg.data[7] = 0;
@@ -384,33 +410,28 @@ ReturnCode_t CBootLoader::SendHeader()
 
 /****************************************************************************/
 /*!
- *  \brief  Calculates the CRC checksum of the firmware.
+ *  \brief  Sends an update trailer message to the node
  *
- *  \iparam p_Data = Data block to be checked
- *  \iparam DataSize = Size of the data block
+ *      The trailer contains the CRC of the image, which was calculated while
+ *      the data was sent.
  *
- *  \return CRC32 checksum
+ *  \return DCL_ERR_FCT_CALL_SUCCESS if the CAN message was successful placed
+ *          in transmit queue, otherwise the return code from SendCOB(..)
  */
 /****************************************************************************/
-quint32 CBootLoader::CalculateCrc(const quint8 *p_Data, quint32 DataSize)
+ReturnCode_t CBootLoader::SendTrailer()
 {
-    quint32 Crc32 = m_Crc32InitialValue;
+    can_frame CanMsg;
+    quint32 Crc32 = m_Transfer.GetCrc();
 
-    // Perform modulo-2 division for each byte
-    for (quint32 i = 0; i < DataSize; i++) {
-        Crc32 ^= (*p_Data++) << (32 - 8);
+    CanMsg.can_id = m_CanIdUpdateTrailer;
+    CanMsg.data[0] = Crc32 >> 24;
+    CanMsg.data[1] = Crc32 >> 16;
+    CanMsg.data[2] = Crc32 >> 8;
+    CanMsg.data[3] = Crc32;
+    CanMsg.can_dlc = 4;
 
-        // Perform modulo-2 division for each bit in byte
-        for (quint8 k = 0; k < 8; k++) {
-            if (Crc32 & 0x80000000) {
-                Crc32 = (Crc32 << 1) ^ m_Crc32Polynomial;
-            }
-            else {
-                Crc32 = (Crc32 << 1);
-            }
-        }
-    }
-    return (Crc32 ^ m_Crc32InitialValue);
+    return mp_CanCommunicator->SendCOB(CanMsg);
 }
 
 /****************************************************************************/
@@ -453,7 +474,6 @@ void CBootLoader::HandleCanMessage(const can_frame *p_CanFrame)
         m_Timer.stop();
         if (m_State == BOOTLOADER_FIRMWARE) {
             m_State = BOOTLOADER_ACTIVE;
-            m_FirmwareImage.close();
             emit ReportUpdateFirmware(mp_BaseModule->GetModuleHandle(), ReturnCode);
         }
         else if (m_State == BOOTLOADER_INFO) {
@@ -462,7 +482,6 @@ void CBootLoader::HandleCanMessage(const can_frame *p_CanFrame)
         }
         else if (m_State == BOOTLOADER_BOOTLOADER) {
             m_State = BOOTLOADER_IDLE;
-            m_FirmwareImage.close();
             emit ReportUpdateBootLoader(mp_BaseModule->GetModuleHandle(), ReturnCode);
         }
     }
@@ -561,15 +580,16 @@ ReturnCode_t CBootLoader::HandleCanMsgUpdateHeaderAck(const can_frame *p_CanFram
 {
     ReturnCode_t ReturnCode = DCL_ERR_FCT_CALL_SUCCESS;
 
-    if (p_CanFrame->can_dlc == 1) {
+    if (p_CanFrame->can_dlc == 1 || p_CanFrame->can_dlc == 2) {
         if (p_CanFrame->data[0] == 0) {
-            // Reset the receive counter
-            m_Count = 0;
-            // Send two data packets, should be changed later to increase bandwidth utilization
+            // The node grants a window, if it supports one
+            m_Transfer.SetWindow((p_CanFrame->can_dlc == 2) ? p_CanFrame->data[1] : 0);
             ReturnCode = SendData();
-            if (ReturnCode == DCL_ERR_FCT_CALL_SUCCESS) {
-                ReturnCode = SendData();
-            }
+        }
+        else if (p_CanFrame->data[0] == 2 && p_CanFrame->can_dlc == 1 && m_Transfer.GetWindow() != 0) {
+            // The node took the window request for an offset, repeat without
+            m_Transfer.SetWindow(0);
+            ReturnCode = SendHeader();
         }
         else {
             ReturnCode = DCL_ERR_INTERNAL_ERR;
@@ -594,54 +614,32 @@ ReturnCode_t CBootLoader::HandleCanMsgUpdateHeaderAck(const can_frame *p_CanFram
 ReturnCode_t CBootLoader::HandleCanMsgUpdateAck(const can_frame *p_CanFrame)
 {
     ReturnCode_t ReturnCode = DCL_ERR_FCT_CALL_SUCCESS;
+    bool Acknowledged;
 
-    if (p_CanFrame->can_dlc == 0) {
-        // Increase the receive counter
-        if (m_FirmwareImage.size() - m_Count >= 8) {
-            m_Count += 8;
-        }
-        else {
-            m_Count += m_FirmwareImage.size() - m_Count;
-        }
-
-        // The data was successfully transmitted
-        if (m_Count == m_FirmwareImage.size()) {
-            can_frame CanMsg;
-            quint32 Crc32 = 0;
-
-            if (m_FirmwareImage.reset() == false) {
-                return DCL_ERR_INTERNAL_ERR;
-            }
-
-            quint8 *p_ImageData = new quint8[m_FirmwareImage.size()];
-            if (p_ImageData != NULL) {
-                quint32 ReadSize = m_FirmwareImage.read(reinterpret_cast<char *>(p_ImageData), m_FirmwareImage.size());
-                Crc32 = CalculateCrc(p_ImageData, ReadSize);
-            }
-            else {
-                return DCL_ERR_INTERNAL_ERR;
-            }
-            delete[] p_ImageData;
-            p_ImageData = NULL;
-
-            CanMsg.can_id = m_CanIdUpdateTrailer;
-            CanMsg.data[0] = Crc32 >> 24;
-            CanMsg.data[1] = Crc32 >> 16;
-            CanMsg.data[2] = Crc32 >> 8;
-            CanMsg.data[3] = Crc32;
-            CanMsg.can_dlc = 4;
-
-            // Close the firmware image file
-            m_FirmwareImage.close();
+    if (p_CanFrame->can_dlc == 0 && m_Transfer.GetWindow() == 0) {
+        Acknowledged = m_Transfer.Acknowledge();
+    }
+    else if (p_CanFrame->can_dlc == 8 && m_Transfer.GetWindow() != 0) {
+        // Number of bytes received and their CRC, checked against the sent data
+        quint32 Count = (quint32(p_CanFrame->data[0]) << 24) | (p_CanFrame->data[1] << 16) |
+                        (p_CanFrame->data[2] << 8) | p_CanFrame->data[3];
+        quint32 Crc32 = (quint32(p_CanFrame->data[4]) << 24) | (p_CanFrame->data[5] << 16) |
+                        (p_CanFrame->data[6] << 8) | p_CanFrame->data[7];
+        Acknowledged = m_Transfer.Acknowledge(Count, Crc32);
+    }
+    else {
+        return DCL_ERR_CANMSG_INVALID;
+    }
 
-            ReturnCode = mp_CanCommunicator->SendCOB(CanMsg);
-        }
-        else {
-            ReturnCode = SendData();
-        }
+    if (Acknowledged == false) {
+        ReturnCode = DCL_ERR_INTERNAL_ERR;
+    }
+    // The data was successfully transmitted
+    else if (m_Transfer.Finished()) {
+        ReturnCode = SendTrailer();
     }
     else {
-        ReturnCode = DCL_ERR_CANMSG_INVALID;
+        ReturnCode = SendData();
     }
 
     return ReturnCode;
@@ -696,7 +694,6 @@ void CBootLoader::TimeoutHandler()
     }
     if (m_State == BOOTLOADER_FIRMWARE) {
         m_State = BOOTLOADER_ACTIVE;
-        m_FirmwareImage.close();
         emit ReportUpdateFirmware(mp_BaseModule->GetModuleHandle(), DCL_ERR_TIMEOUT);
     }
     else if (m_State == BOOTLOADER_INFO) {
@@ -705,7 +702,6 @@ void CBootLoader::TimeoutHandler()
     }
     else if (m_State == BOOTLOADER_BOOTLOADER) {
         m_State = BOOTLOADER_IDLE;
-        m_FirmwareImage.close();
         emit ReportUpdateBootLoader(mp_BaseModule->GetModuleHandle(), DCL_ERR_TIMEOUT);
     }
 }
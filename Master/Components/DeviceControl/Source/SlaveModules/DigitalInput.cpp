@@ -532,6 +532,7 @@ bool CDigitalInput::SetModuleTask(CANDigitalInputModuleCmdType_t CommandType, qu
                 m_ModuleCommand[idx].m_TimeoutRetry = 0;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
@@ -764,6 +764,7 @@ bool CDigitalOutput::SetModuleTask(CANDigitalOutputModuleCmdType_t CommandType,
                 m_ModuleCommand[idx].m_Type = CommandType;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
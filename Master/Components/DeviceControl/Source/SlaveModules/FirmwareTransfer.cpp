@@ -0,0 +1,201 @@
+/****************************************************************************/
+/*! \file FirmwareTransfer.cpp
+ *
+ *  \brief Implementation file for class CFirmwareTransfer.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class CFirmwareTransfer
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/SlaveModules/FirmwareTransfer.h"
+#include <string.h>
+
+namespace DeviceControl
+{
+
+const quint8 CFirmwareTransfer::m_FrameSize;
+const quint8 CFirmwareTransfer::m_MaxWindow;
+const quint32 CFirmwareTransfer::m_Crc32Polynomial = 0x04C11DB7;
+const quint32 CFirmwareTransfer::m_Crc32InitialValue = 0xFFFFFFFF;
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the class CFirmwareTransfer
+ */
+/****************************************************************************/
+CFirmwareTransfer::CFirmwareTransfer() :
+    m_Window(0), m_Sent(0), m_Acked(0), m_Crc(m_Crc32InitialValue)
+{
+    memset(m_FrameCrc, 0, sizeof(m_FrameCrc));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Starts a new transfer
+ *
+ *  \iparam Image = Firmware image
+ *  \iparam Window = Window size in frames, 0 = acknowledge each frame
+ */
+/****************************************************************************/
+void CFirmwareTransfer::Start(const QByteArray &Image, quint8 Window)
+{
+    m_Image = Image;
+    m_Sent = 0;
+    m_Acked = 0;
+    m_Crc = m_Crc32InitialValue;
+    SetWindow(Window);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Sets the window size granted by the Slave
+ *
+ *      The window is limited to m_MaxWindow, since the CRCs of the frames in
+ *      flight are kept in a ring buffer of this size.
+ *
+ *  \iparam Window = Window size in frames, 0 = acknowledge each frame
+ */
+/****************************************************************************/
+void CFirmwareTransfer::SetWindow(quint8 Window)
+{
+    m_Window = qMin(Window, m_MaxWindow);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Fetches the next data frame, if the window allows to send it
+ *
+ *  \oparam p_Data = Buffer of at least m_FrameSize bytes
+ *  \oparam Length = Number of data bytes in the frame
+ *  \oparam Odd = Flow control count of the frame (Data0 or Data1)
+ *
+ *  \return true if a frame is to be sent
+ */
+/****************************************************************************/
+bool CFirmwareTransfer::NextFrame(quint8 *p_Data, quint8 &Length, bool &Odd)
+{
+    // Without a window, two frames are kept in flight
+    quint32 Limit = (m_Window == 0) ? 2 : m_Window;
+    quint32 InFlight = (m_Sent - m_Acked + m_FrameSize - 1) / m_FrameSize;
+
+    if (m_Sent == GetSize() || InFlight >= Limit) {
+        return false;
+    }
+
+    quint32 Frame = m_Sent / m_FrameSize;
+    Length = qMin<quint32>(GetSize() - m_Sent, m_FrameSize);
+    Odd = (Frame % 2) != 0;
+    memcpy(p_Data, m_Image.constData() + m_Sent, Length);
+
+    m_Crc = UpdateCrc(m_Crc, p_Data, Length);
+    m_FrameCrc[Frame % m_MaxWindow] = m_Crc;
+    m_Sent += Length;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Handles the acknowledge of a single frame (no window)
+ *
+ *  \return false if no frame is outstanding
+ */
+/****************************************************************************/
+bool CFirmwareTransfer::Acknowledge()
+{
+    if (m_Acked == m_Sent) {
+        return false;
+    }
+    m_Acked += qMin<quint32>(m_Sent - m_Acked, m_FrameSize);
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Handles the acknowledge of a block of frames (window)
+ *
+ *      The Slave acknowledges at frame boundaries only. The CRC reported by
+ *      the Slave has to match the CRC after the last acknowledged frame.
+ *
+ *  \iparam Count = Number of bytes received by the Slave
+ *  \iparam Crc = CRC of the bytes received by the Slave
+ *
+ *  \return false if the count or the CRC does not match the sent data
+ */
+/****************************************************************************/
+bool CFirmwareTransfer::Acknowledge(quint32 Count, quint32 Crc)
+{
+    if (Count <= m_Acked || Count > m_Sent) {
+        return false;
+    }
+    if (Count % m_FrameSize != 0 && Count != GetSize()) {
+        return false;
+    }
+    if ((m_FrameCrc[((Count - 1) / m_FrameSize) % m_MaxWindow] ^ m_Crc32InitialValue) != Crc) {
+        return false;
+    }
+    m_Acked = Count;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Calculates a CRC32 checksum
+ *
+ *      Uses the same algorithm as the Slaves to check their flash memory.
+ *
+ *  \iparam p_Data = Data block to be checked
+ *  \iparam DataSize = Size of the data block
+ *
+ *  \return CRC32 checksum
+ */
+/****************************************************************************/
+quint32 CFirmwareTransfer::CalculateCrc(const quint8 *p_Data, quint32 DataSize)
+{
+    return (UpdateCrc(m_Crc32InitialValue, p_Data, DataSize) ^ m_Crc32InitialValue);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds a data block to a CRC32 remainder
+ *
+ *  \iparam Crc = CRC32 remainder
+ *  \iparam p_Data = Data block
+ *  \iparam DataSize = Size of the data block
+ *
+ *  \return New CRC32 remainder
+ */
+/****************************************************************************/
+quint32 CFirmwareTransfer::UpdateCrc(quint32 Crc, const quint8 *p_Data, quint32 DataSize)
+{
+    // Perform modulo-2 division for each byte
+    for (quint32 i = 0; i < DataSize; i++) {
+        Crc ^= (*p_Data++) << (32 - 8);
+
+        // Perform modulo-2 division for each bit in byte
+        for (quint8 k = 0; k < 8; k++) {
+            if (Crc & 0x80000000) {
+                Crc = (Crc << 1) ^ m_Crc32Polynomial;
+            }
+            else {
+                Crc = (Crc << 1);
+            }
+        }
+    }
+    return Crc;
+}
+
+} //namespace DeviceControl
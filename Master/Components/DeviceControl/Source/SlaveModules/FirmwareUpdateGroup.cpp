@@ -0,0 +1,129 @@
+/****************************************************************************/
+/*! \file FirmwareUpdateGroup.cpp
+ *
+ *  \brief Implementation file for class CFirmwareUpdateGroup.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module contains the implementation of the class
+ *       CFirmwareUpdateGroup
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include "DeviceControl/Include/SlaveModules/FirmwareUpdateGroup.h"
+#include "DeviceControl/Include/SlaveModules/BootLoader.h"
+#include "Global/Include/Utils.h"
+#include <QFile>
+
+namespace DeviceControl
+{
+
+/****************************************************************************/
+/*!
+ *  \brief  Constructor of the class CFirmwareUpdateGroup
+ *
+ *  \iparam p_Parent = Parent object
+ */
+/****************************************************************************/
+CFirmwareUpdateGroup::CFirmwareUpdateGroup(QObject *p_Parent) :
+    QObject(p_Parent), m_Pending(0), m_Result(DCL_ERR_FCT_CALL_SUCCESS)
+{
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds the boot loader of a node to the group
+ *
+ *  \iparam p_BootLoader = Boot loader of the node
+ */
+/****************************************************************************/
+void CFirmwareUpdateGroup::AddBootLoader(CBootLoader *p_BootLoader)
+{
+    if (p_BootLoader == NULL || m_BootLoaders.contains(p_BootLoader)) {
+        return;
+    }
+    m_BootLoaders.append(p_BootLoader);
+    CONNECTSIGNALSLOT(p_BootLoader, ReportUpdateFirmware(quint32, ReturnCode_t),
+                      this, OnUpdateFirmware(quint32, ReturnCode_t));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Starts the firmware update of all nodes of the group
+ *
+ *      Nodes failing to start are reported at once, the update of the other
+ *      nodes continues.
+ *
+ *  \iparam FirmwarePath = The path to the firmware image file
+ *
+ *  \return DCL_ERR_FCT_CALL_SUCCESS or the error of the first node failing
+ */
+/****************************************************************************/
+ReturnCode_t CFirmwareUpdateGroup::UpdateFirmware(const QString &FirmwarePath)
+{
+    if (m_Pending > 0) {
+        return DCL_ERR_INVALID_STATE;
+    }
+    if (m_BootLoaders.isEmpty()) {
+        return DCL_ERR_INVALID_PARAM;
+    }
+
+    QFile FirmwareImage(FirmwarePath);
+    if (FirmwareImage.open(QIODevice::ReadOnly) == false) {
+        return DCL_ERR_INVALID_PARAM;
+    }
+    QByteArray Image = FirmwareImage.readAll();
+
+    m_Result = DCL_ERR_FCT_CALL_SUCCESS;
+    for (qint32 i = 0; i < m_BootLoaders.count(); i++) {
+        ReturnCode_t ReturnCode = m_BootLoaders[i]->UpdateFirmware(Image);
+        if (ReturnCode == DCL_ERR_FCT_CALL_SUCCESS) {
+            m_Pending++;
+        }
+        else if (m_Result == DCL_ERR_FCT_CALL_SUCCESS) {
+            m_Result = ReturnCode;
+        }
+    }
+
+    if (m_Pending == 0) {
+        return m_Result;
+    }
+    return DCL_ERR_FCT_CALL_SUCCESS;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Collects the end of the update of a node
+ *
+ *  \iparam InstanceID = Instance identifier of the base module
+ *  \iparam HdlInfo = Return code of the node
+ */
+/****************************************************************************/
+void CFirmwareUpdateGroup::OnUpdateFirmware(quint32 InstanceID, ReturnCode_t HdlInfo)
+{
+    if (m_Pending == 0) {
+        return;
+    }
+    if (HdlInfo != DCL_ERR_FCT_CALL_SUCCESS && m_Result == DCL_ERR_FCT_CALL_SUCCESS) {
+        m_Result = HdlInfo;
+    }
+    emit ReportUpdateFirmware(InstanceID, HdlInfo);
+
+    if (--m_Pending == 0) {
+        emit ReportUpdateFinished(m_Result);
+    }
+}
+
+} //namespace DeviceControl
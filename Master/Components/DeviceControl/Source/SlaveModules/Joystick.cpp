@@ -447,6 +447,7 @@ ReturnCode_t CJoystick::ReqActInputValue()
     if((m_TaskID == MODULE_TASKID_FREE) && (m_taskState == MODULE_CMD_STATE_FREE))
     {
         m_TaskID = MODULE_TASKID_COMMAND_HDL/*FM_MODULE_TASKID_REQ_ACTINP*/; //!< \todo
+        Wake();
         m_taskState = MODULE_CMD_STATE_REQ;
         m_timeAction.Trigger();
         FILE_LOG_L(laFCT, llINFO) << "   CANJoystick::ReqInputValue ";
@@ -468,6 +469,7 @@ ReturnCode_t CJoystick::SetContactLimitValue(quint16 contactLimit)
     if((m_TaskID == MODULE_TASKID_FREE) && (m_taskState == MODULE_CMD_STATE_FREE))
     {
         m_TaskID = MODULE_TASKID_COMMAND_HDL/*FM_MODULE_TASKID_SET_CONTACT_LIMIT*/; //!< \todo
+        Wake();
         m_taskState = MODULE_CMD_STATE_REQ;
         m_contactLimit = contactLimit;
         m_timeAction.Trigger();
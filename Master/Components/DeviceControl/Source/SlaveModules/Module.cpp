@@ -25,6 +25,8 @@
 #include "DeviceControl/Include/SlaveModules/Module.h"
 #include "DeviceControl/Include/SlaveModules/BaseModule.h"
 #include "DeviceControl/Include/Configuration/CANMessageConfiguration.h"
+#include "DeviceControl/Include/CanCommunication/CANCommunicator.h"
+#include "DeviceControl/Include/DeviceProcessing/TaskScheduler.h"
 #include "DeviceControl/Include/Global/dcl_log.h"
 #include "Global/Include/AdjustedTime.h"
 
@@ -241,6 +243,34 @@ quint32 CModule::GetModuleHandle()
     return moduleHandle;
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Returns the scheduler of the device processing
+ *
+ *  \return Task scheduler or NULL
+ */
+/****************************************************************************/
+CTaskScheduler *CModule::GetScheduler() const
+{
+    if (m_pCANCommunicator == NULL) {
+        return NULL;
+    }
+    return m_pCANCommunicator->GetScheduler();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Wakes up the device processing to run the module's tasks
+ */
+/****************************************************************************/
+void CModule::Wake()
+{
+    CTaskScheduler *p_Scheduler = GetScheduler();
+    if (p_Scheduler != NULL) {
+        p_Scheduler->Wake(this, CTaskScheduler::WAKE_COMMAND);
+    }
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Send the CAN message to request the data reset
@@ -1861,6 +1861,7 @@ bool CPressureControl::SetModuleTask(CANPressureCtrlCmdType_t CommandType, quint
                 m_ModuleCommand[idx].Type = CommandType;
                 m_ModuleCommand[idx].TimeoutRetry = 0;
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
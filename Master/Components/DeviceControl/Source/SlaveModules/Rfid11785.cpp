@@ -1165,6 +1165,7 @@ bool CRfid11785::SetModuleTask(CANRFIDModuleCmdType_t CommandType, quint8* pCmdI
                 m_ModuleCommand[idx].Type = CommandType;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
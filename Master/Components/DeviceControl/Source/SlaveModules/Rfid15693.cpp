@@ -923,6 +923,7 @@ bool CRfid15693::SetModuleTask(CANRFIDModuleCmdType_t CommandType, quint8* pCmdI
                 m_ModuleCommand[idx].m_Type = CommandType;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
@@ -421,16 +421,12 @@ void CStepperMotor::HandleTasks()
     }
     else if(m_mainState == FM_MAIN_STATE_CONFIG)
     {
-        // 50ms delay between each call of HandleConfigurationState()
-        // ensures a proper CAN-message intervall
-#if 0
-        if(m_timeAction.Elapsed() > 5)
-#else
-        if(m_timeAction.Elapsed() > 50)
-#endif
+        // The configuration messages are sent in small bursts, queued by the
+        // CAN transmit ring. The burst budget is shared by all modules of the
+        // node, to keep the slave's receive buffer from overflowing.
+        while((m_mainState == FM_MAIN_STATE_CONFIG) && m_pParent->TakeConfigMessage())
         {
             HandleConfigurationState();
-            m_timeAction.Trigger();
         }
     }
     else if(m_mainState == FM_MAIN_STATE_ERROR)
@@ -2726,6 +2722,7 @@ bool CStepperMotor::SetModuleTask(CANStepperMotorMotionCmdType_t CommandType, qu
                 m_ModuleCommand[idx].m_TimeoutRetry = 0;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
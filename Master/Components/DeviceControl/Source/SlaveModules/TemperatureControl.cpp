@@ -549,6 +549,20 @@ void CTemperatureControl::HandleCommandRequestTask()
                 emit ReportSetSwitchState(GetModuleHandle(), RetVal, m_ModuleCommand[idx].SwitchState, m_ModuleCommand[idx].AutoSwitch);
 
             }
+            else if(m_ModuleCommand[idx].Type == FM_TEMP_CMD_TYPE_SUBSCRIBE_ACTTEMP)
+            {
+                FILE_LOG_L(laFCT, llDEBUG1) << " CANTemperatureControl subscribe act. temperatures";
+
+                //send the telemetry interval to the slave, the temperatures are reported
+                // by the m_unCanIDServiceSensor CAN-message from now on
+                RetVal = SendCANMsgServiceSensorSubscribe(m_ModuleCommand[idx].Interval);
+
+                m_ModuleCommand[idx].State = MODULE_CMD_STATE_FREE;
+                if(RetVal != DCL_ERR_FCT_CALL_SUCCESS)
+                {
+                    FILE_LOG_L(laFCT, llWARNING) << " CANTemperatureControl subscription failed: " << (int) RetVal;
+                }
+            }
 
             //---------------------------
             //check for success
@@ -735,9 +749,10 @@ void CTemperatureControl::SetLifeCycle(quint32 times)
 /****************************************************************************/
 void CTemperatureControl::HandleCANMsgServiceSensor(can_frame* pCANframe)
 {
-    if(m_TaskID == MODULE_TASKID_COMMAND_HDL)
+    // subscribed samples arrive unrequested, they only answer a request of the same sensor
+    if((m_TaskID == MODULE_TASKID_COMMAND_HDL) && (pCANframe->can_dlc > 0))
     {
-        ResetModuleCommand(FM_TEMP_CMD_TYPE_REQ_ACTTEMP);
+        ResetActTempCommand(pCANframe->data[0]);
     }
 
     if(pCANframe->can_dlc == 3)
@@ -1283,6 +1298,37 @@ ReturnCode_t CTemperatureControl::SendCANMsgServiceSensorRequest(quint8 Index)
     return retval;
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Send the CAN message to subscribe to the sensor temperatures
+ *
+ *      The 'ServiceSensor' request with a telemetry interval makes the Slave
+ *      send the 'ServiceSensor' CAN-Message of all sensors periodically.
+ *      Slaves not supporting the subscription ignore it, their temperatures
+ *      are still requested on demand.
+ *
+ *  \iparam Interval = Telemetry interval in ms, 0 ends the subscription
+ *
+ *  \return The return value is set from SendCOB(can_frame)
+ */
+/****************************************************************************/
+ReturnCode_t CTemperatureControl::SendCANMsgServiceSensorSubscribe(quint16 Interval)
+{
+    ReturnCode_t retval = DCL_ERR_FCT_CALL_SUCCESS;
+    can_frame canmsg;
+
+    canmsg.can_id = m_unCanIDServiceSensorReq;
+    canmsg.data[0] = 0;
+    SetCANMsgDataU16(&canmsg, Interval, 1);
+    canmsg.can_dlc = 3;
+    retval = m_pCANCommunicator->SendCOB(canmsg);
+
+    FILE_LOG_L(laFCT, llDEBUG) << "   CTemperatureControl::SendCANMsgServiceSensorSubscribe canID: 0x"
+                               << std::hex << m_unCanIDServiceSensorReq;
+
+    return retval;
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Send the CAN message to reset the operating time of a heater
@@ -1473,6 +1519,36 @@ ReturnCode_t CTemperatureControl::ReqActTemperature(quint8 Index)
     return RetVal;
 }
 
+/****************************************************************************/
+/*!
+ *  \brief  Subscribe to the actual temperatures of all sensors
+ *
+ *  \iparam Interval = Report interval in ms, 0 ends the subscription
+ *
+ *  \return DCL_ERR_FCT_CALL_SUCCESS if the request was accepted
+ *          otherwise an error code
+ */
+/****************************************************************************/
+ReturnCode_t CTemperatureControl::SubscribeActTemperature(quint16 Interval)
+{
+    QMutexLocker Locker(&m_Mutex);
+    ReturnCode_t RetVal = DCL_ERR_FCT_CALL_SUCCESS;
+    quint8 CmdIndex;
+
+    if(SetModuleTask(FM_TEMP_CMD_TYPE_SUBSCRIBE_ACTTEMP, &CmdIndex))
+    {
+        m_ModuleCommand[CmdIndex].Interval = Interval;
+        FILE_LOG_L(laDEV, llINFO) << " CANTemperatureControl, Interval: " << Interval;
+    }
+    else
+    {
+        RetVal = DCL_ERR_INVALID_STATE;
+        FILE_LOG_L(laFCT, llERROR) << " CANTemperatureControl invalid state: " << m_TaskID; //lint !e641
+    }
+
+    return RetVal;
+}
+
 /****************************************************************************/
 /*!
  *  \brief  Set the temperature control's operation mode
@@ -1757,6 +1833,7 @@ bool CTemperatureControl::SetModuleTask(CANTempCtrlCmdType_t CommandType, quint8
                 m_ModuleCommand[idx].TimeoutRetry = 0;
 
                 m_TaskID = MODULE_TASKID_COMMAND_HDL;
+                Wake();
                 CommandAdded  = true;
                 if(pCmdIndex)
                 {
@@ -1772,6 +1849,38 @@ bool CTemperatureControl::SetModuleTask(CANTempCtrlCmdType_t CommandType, quint8
     return CommandAdded;
 }
 
+/****************************************************************************/
+/**
+ *  \brief  Set the pending actual temperature request of a sensor to 'FREE'
+ *
+ *  \iparam Index = Temperature sensor index
+ */
+/****************************************************************************/
+void CTemperatureControl::ResetActTempCommand(quint8 Index)
+{
+    bool ActiveCommandFound = false;
+
+    for(quint8 idx = 0; idx < MAX_TEMP_MODULE_CMD_IDX; idx++)
+    {
+        if((m_ModuleCommand[idx].Type == FM_TEMP_CMD_TYPE_REQ_ACTTEMP) &&
+           (m_ModuleCommand[idx].State == MODULE_CMD_STATE_REQ_SEND) &&
+           (m_ModuleCommand[idx].Index == Index))
+        {
+            m_ModuleCommand[idx].State = MODULE_CMD_STATE_FREE;
+        }
+
+        if(m_ModuleCommand[idx].State != MODULE_CMD_STATE_FREE)
+        {
+            ActiveCommandFound = true;
+        }
+    }
+
+    if(ActiveCommandFound == false)
+    {
+        m_TaskID = MODULE_TASKID_FREE;
+    }
+}
+
 /****************************************************************************/
 /**
  *  \brief  Set the ModuleCommands with the specified command type to 'FREE'
@@ -573,6 +573,7 @@ ReturnCode_t CUart::SendData(QByteArray OutData)
     if((m_TaskID == MODULE_TASKID_FREE) && (m_taskState == MODULE_CMD_STATE_FREE))
     {
         m_TaskID = MODULE_TASKID_COMMAND_HDL/*FM_UART_TASKID_SEND_DATA*/; //!< \todo
+        Wake();
         m_taskState = MODULE_CMD_STATE_REQ;
 
         /*m_rfidWriteDataMSB = rfidDataMSB;
@@ -613,6 +614,7 @@ ReturnCode_t CUart::ReqReceivedData()
     if((m_TaskID == MODULE_TASKID_FREE) && (m_taskState == MODULE_CMD_STATE_FREE))
     {
         m_TaskID = MODULE_TASKID_COMMAND_HDL/*FM_UART_TASKID_REQ_REC_DATA*/; //!< \todo
+        Wake();
         m_taskState = MODULE_CMD_STATE_REQ;
 
         FILE_LOG_L(laFCT, llINFO) << "   CANUART::ReqReceivedData()";
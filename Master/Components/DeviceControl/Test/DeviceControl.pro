@@ -5,7 +5,14 @@
 TEMPLATE = subdirs
 
 SUBDIRS += TestIDeviceProcessing.pro \
-           TestDeviceControlSim.pro
+           TestDeviceControlSim.pro \
+           TestDclLog.pro \
+           TestBootLoaderTransfer.pro \
+           TestTelemetrySlot.pro \
+           TestConfigurationSnapshot.pro \
+           TestDeviceLifeCycleRecord.pro \
+           TestStepperMotion.pro \
+           TestSensorLinearization.pro
 
 CONFIG += ordered
 
@@ -0,0 +1,514 @@
+/****************************************************************************/
+/*! \file TestBootLoaderTransfer.cpp
+ *
+ *  \brief Unit test and benchmark of the firmware download protocol
+ *
+ *      The master side (CFirmwareTransfer) and the slave side (bmTransfer.c)
+ *      of the protocol are connected through a simulated CAN bus. The Slave
+ *      programs the simulated flash memory of the host simulation HAL. The
+ *      time is simulated, so the measured throughput does not depend on the
+ *      host running the test.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QDebug>
+#include <QVector>
+#include <map>
+
+#include "DeviceControl/Include/SlaveModules/FirmwareTransfer.h"
+
+extern "C" {
+#include "Global.h"
+#include "bmError.h"
+#include "bmTransfer.h"
+#include "halHostSim.h"
+}
+
+namespace DeviceControl {
+
+static const quint32 IMAGE_SIZE = 64 * 1024 + 3;    //!< Size of the test image, odd on purpose
+static const quint64 MASTER_LATENCY = 1000000;      //!< Master reaction time on a CAN message (ns)
+static const quint64 SLAVE_LATENCY = 100000;        //!< Slave reaction time on a CAN message (ns)
+
+/****************************************************************************/
+/*!
+ *  \brief  CAN frame on the simulated bus
+ */
+/****************************************************************************/
+struct SimFrame {
+    qint32 Node;        //!< Index of the node sending or receiving the frame
+    bool ToSlave;       //!< Data frame (true) or acknowledge (false)
+    bool Odd;           //!< Data1/Ack1 (true) or Data0/Ack0 (false)
+    quint8 Length;      //!< Number of data bytes
+    quint8 Data[8];     //!< Data bytes
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Master and Slave of one node taking part in the update
+ */
+/****************************************************************************/
+struct SimNode {
+    CFirmwareTransfer Master;   //!< Master side of the transfer
+    bmTransfer_t Slave;         //!< Slave side of the transfer
+    Handle_t Flash;             //!< Simulated flash memory of the Slave
+    quint64 SlaveBusy;          //!< Time the Slave has processed all frames (ns)
+    quint64 Finished;           //!< Time the last acknowledge was processed (ns)
+    bool Failed;                //!< An acknowledge was rejected by the master
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Simulates the download of a firmware image to several nodes
+ *
+ *      Frames are transmitted on a single bus in the order they are queued.
+ *      The Slaves process the received frames one after the other, each
+ *      frame takes the Slave latency plus the flash programming time. The
+ *      master reacts on each acknowledge after the master latency.
+ */
+/****************************************************************************/
+class CSimUpdate
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam Image = Firmware image
+     *  \iparam Nodes = Number of nodes updated in parallel
+     *  \iparam Window = Window size requested by the master
+     */
+    /****************************************************************************/
+    CSimUpdate(const QByteArray &Image, qint32 Nodes, quint8 Window);
+    /****************************************************************************/
+    /*!
+     *  \brief  Destructor
+     */
+    /****************************************************************************/
+    ~CSimUpdate() { simFlashClose(); }
+    /****************************************************************************/
+    /*!
+     *  \brief  Runs the simulation until all transfers have ended
+     *
+     *  \return Simulated time (ns)
+     */
+    /****************************************************************************/
+    quint64 Run();
+    /****************************************************************************/
+    /*!
+     *  \brief  Delivers a frame to the Slave once more, like a double CAN frame
+     *
+     *  \iparam Count = Number of the data frame to repeat
+     */
+    /****************************************************************************/
+    void RepeatFrame(quint32 Count) { m_RepeatFrame = Count; }
+
+    QVector<SimNode> m_Nodes;   //!< Nodes taking part in the update
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief  Queues a frame for transmission on the bus
+     *
+     *  \iparam Ready = Time the frame is ready for transmission (ns)
+     *  \iparam Frame = The frame
+     */
+    /****************************************************************************/
+    void Transmit(quint64 Ready, const SimFrame &Frame);
+    /****************************************************************************/
+    /*!
+     *  \brief  Sends all data frames the window allows
+     *
+     *  \iparam Time = Current time (ns)
+     *  \iparam Node = Index of the node
+     */
+    /****************************************************************************/
+    void MasterSend(quint64 Time, qint32 Node);
+    /****************************************************************************/
+    /*!
+     *  \brief  Handles a data frame on the Slave, like blUpdateData()
+     *
+     *  \iparam Time = Time the frame was received (ns)
+     *  \iparam Frame = The frame
+     */
+    /****************************************************************************/
+    void SlaveReceive(quint64 Time, const SimFrame &Frame);
+    /****************************************************************************/
+    /*!
+     *  \brief  Handles an acknowledge on the master, like CBootLoader
+     *
+     *  \iparam Time = Time the frame was received (ns)
+     *  \iparam Frame = The frame
+     */
+    /****************************************************************************/
+    void MasterReceive(quint64 Time, const SimFrame &Frame);
+
+    std::multimap<quint64, SimFrame> m_Events;  //!< Frames by time of reception
+    quint64 m_BusFree;          //!< Time the bus has sent all queued frames (ns)
+    quint32 m_DataFrames;       //!< Number of data frames sent
+    quint32 m_RepeatFrame;      //!< Number of the data frame to deliver twice
+};
+
+/****************************************************************************/
+CSimUpdate::CSimUpdate(const QByteArray &Image, qint32 Nodes, quint8 Window) :
+    m_Nodes(Nodes), m_BusFree(0), m_DataFrames(0), m_RepeatFrame(0xFFFFFFFF)
+{
+    for (qint32 i = 0; i < Nodes; i++) {
+        SimNode &Node = m_Nodes[i];
+        // Header and header acknowledge, the Slave grants the window requested
+        Node.Master.Start(Image, Window);
+        bmTransferInit(&Node.Slave, Image.size(), Window);
+        Node.Master.SetWindow(Node.Slave.Window);
+        Node.Flash = simFlashOpen(Image.size() + 1);
+        Node.SlaveBusy = 0;
+        Node.Finished = 0;
+        Node.Failed = false;
+    }
+}
+
+/****************************************************************************/
+quint64 CSimUpdate::Run()
+{
+    quint64 Time = 0;
+
+    for (qint32 i = 0; i < m_Nodes.count(); i++) {
+        MasterSend(0, i);
+    }
+    while (!m_Events.empty()) {
+        Time = m_Events.begin()->first;
+        SimFrame Frame = m_Events.begin()->second;
+        m_Events.erase(m_Events.begin());
+
+        if (Frame.ToSlave) {
+            SlaveReceive(Time, Frame);
+        }
+        else {
+            MasterReceive(Time, Frame);
+        }
+    }
+
+    quint64 Finished = 0;
+    for (qint32 i = 0; i < m_Nodes.count(); i++) {
+        Finished = qMax(Finished, m_Nodes[i].Finished);
+    }
+    return Finished;
+}
+
+/****************************************************************************/
+void CSimUpdate::Transmit(quint64 Ready, const SimFrame &Frame)
+{
+    m_BusFree = qMax(m_BusFree, Ready) + simCanFrameTime(Frame.Length);
+    m_Events.insert(std::make_pair(m_BusFree, Frame));
+}
+
+/****************************************************************************/
+void CSimUpdate::MasterSend(quint64 Time, qint32 Node)
+{
+    SimFrame Frame;
+    Frame.Node = Node;
+    Frame.ToSlave = true;
+
+    while (m_Nodes[Node].Master.NextFrame(Frame.Data, Frame.Length, Frame.Odd)) {
+        Transmit(Time, Frame);
+        if (m_DataFrames++ == m_RepeatFrame) {
+            Transmit(Time, Frame);
+        }
+    }
+}
+
+/****************************************************************************/
+void CSimUpdate::SlaveReceive(quint64 Time, const SimFrame &Frame)
+{
+    SimNode &Node = m_Nodes[Frame.Node];
+    quint8 Data[TRANSFER_FRAME_SIZE + 1] = {0};
+    UInt32 Count = Node.Slave.Count;
+
+    Node.SlaveBusy = qMax(Node.SlaveBusy, Time) + SLAVE_LATENCY;
+    if (bmTransferAccept(&Node.Slave, Frame.Length, Frame.Odd) != 1) {
+        return;
+    }
+
+    // Flash memory is programmed in half words
+    memcpy(Data, Frame.Data, Frame.Length);
+    QCOMPARE(halStorageWrite(Node.Flash, Count, Data, (Frame.Length + 1) & ~1), NO_ERROR);
+    Node.SlaveBusy += simFlashTime(Node.Flash) * 1000;
+
+    if (bmTransferCommit(&Node.Slave, Frame.Data, Frame.Length)) {
+        SimFrame Ack;
+        Ack.Node = Frame.Node;
+        Ack.ToSlave = false;
+        Ack.Odd = Frame.Odd;
+        Ack.Length = 0;
+        if (Node.Slave.Window != 0) {
+            UInt32 Crc = bmTransferCrc(&Node.Slave);
+            for (int i = 0; i < 4; i++) {
+                Ack.Data[i] = Node.Slave.Count >> (24 - 8 * i);
+                Ack.Data[4 + i] = Crc >> (24 - 8 * i);
+            }
+            Ack.Length = 8;
+        }
+        Transmit(Node.SlaveBusy, Ack);
+    }
+}
+
+/****************************************************************************/
+void CSimUpdate::MasterReceive(quint64 Time, const SimFrame &Frame)
+{
+    SimNode &Node = m_Nodes[Frame.Node];
+    bool Acknowledged;
+
+    Time += MASTER_LATENCY;
+    if (Frame.Length == 0) {
+        Acknowledged = Node.Master.Acknowledge();
+    }
+    else {
+        quint32 Count = 0;
+        quint32 Crc = 0;
+        for (int i = 0; i < 4; i++) {
+            Count = (Count << 8) | Frame.Data[i];
+            Crc = (Crc << 8) | Frame.Data[4 + i];
+        }
+        Acknowledged = Node.Master.Acknowledge(Count, Crc);
+    }
+
+    if (!Acknowledged) {
+        Node.Failed = true;
+    }
+    else if (Node.Master.Finished()) {
+        Node.Finished = Time;
+    }
+    else {
+        MasterSend(Time, Frame.Node);
+    }
+}
+
+/****************************************************************************/
+/**
+ * \brief Test class for the firmware download protocol.
+ */
+/****************************************************************************/
+class TestBootLoaderTransfer : public QObject {
+    Q_OBJECT
+private:
+    /****************************************************************************/
+    /**
+     * \brief Creates a test image.
+     *
+     * \iparam Size = Image size in bytes
+     *
+     * \return  Image.
+     */
+    /****************************************************************************/
+    static QByteArray CreateImage(quint32 Size);
+    /****************************************************************************/
+    /**
+     * \brief Checks the flash memory and the CRCs of all nodes.
+     *
+     * \iparam Update = Finished simulation
+     * \iparam Image = Image downloaded
+     */
+    /****************************************************************************/
+    static void VerifyNodes(CSimUpdate &Update, const QByteArray &Image);
+    /****************************************************************************/
+    /**
+     * \brief Runs an update and reports the throughput.
+     *
+     * \iparam Nodes = Number of nodes updated in parallel
+     * \iparam Window = Window size
+     *
+     * \return  Throughput of all nodes in bytes per second.
+     */
+    /****************************************************************************/
+    static qreal Throughput(qint32 Nodes, quint8 Window);
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Test that master and Slave calculate the same CRC.
+     */
+    /****************************************************************************/
+    void utCrc();
+    /****************************************************************************/
+    /**
+     * \brief Test the download acknowledging each frame.
+     */
+    /****************************************************************************/
+    void utLegacyTransfer();
+    /****************************************************************************/
+    /**
+     * \brief Test the download with a window.
+     */
+    /****************************************************************************/
+    void utWindowedTransfer();
+    /****************************************************************************/
+    /**
+     * \brief Test that double CAN frames are dropped by the Slave.
+     */
+    /****************************************************************************/
+    void utDuplicateFrame();
+    /****************************************************************************/
+    /**
+     * \brief Test that the master rejects wrong acknowledges.
+     */
+    /****************************************************************************/
+    void utBadAcknowledge();
+    /****************************************************************************/
+    /**
+     * \brief Measure the throughput of the modes and of parallel updates.
+     */
+    /****************************************************************************/
+    void utThroughput();
+}; // end class TestBootLoaderTransfer
+
+/****************************************************************************/
+QByteArray TestBootLoaderTransfer::CreateImage(quint32 Size) {
+    QByteArray Image(Size, 0);
+    quint32 Value = 12345;
+    for (quint32 i = 0; i < Size; i++) {
+        Value = Value * 1103515245 + 12345;
+        Image[i] = Value >> 16;
+    }
+    return Image;
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::VerifyNodes(CSimUpdate &Update, const QByteArray &Image) {
+    for (qint32 i = 0; i < Update.m_Nodes.count(); i++) {
+        SimNode &Node = Update.m_Nodes[i];
+        QVERIFY(!Node.Failed);
+        QVERIFY(Node.Master.Finished());
+        QCOMPARE(quint32(Node.Slave.Count), quint32(Image.size()));
+        QVERIFY(memcmp(simFlashData(Node.Flash), Image.constData(), Image.size()) == 0);
+        // The trailer CRC of the master matches the running CRC of the Slave
+        QCOMPARE(Node.Master.GetCrc(), quint32(bmTransferCrc(&Node.Slave)));
+    }
+}
+
+/****************************************************************************/
+qreal TestBootLoaderTransfer::Throughput(qint32 Nodes, quint8 Window) {
+    QByteArray Image = CreateImage(IMAGE_SIZE);
+    CSimUpdate Update(Image, Nodes, Window);
+    quint64 Time = Update.Run();
+    VerifyNodes(Update, Image);
+
+    qreal BytesPerSecond = qreal(Image.size()) * Nodes * 1e9 / Time;
+    qDebug() << "Nodes" << Nodes << "window" << Window << ":" << Time / 1000000 << "ms,"
+             << qRound(BytesPerSecond) << "bytes/s";
+    return BytesPerSecond;
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::utCrc() {
+    QByteArray Check("123456789");
+    const quint8 *p_Check = reinterpret_cast<const quint8 *>(Check.constData());
+
+    // CRC-32/BZIP2 check value
+    QCOMPARE(CFirmwareTransfer::CalculateCrc(p_Check, Check.size()), 0xFC891918u);
+
+    bmTransfer_t Transfer;
+    bmTransferInit(&Transfer, Check.size(), 0);
+    QCOMPARE(bmTransferAccept(&Transfer, 8, 0), Error_t(1));
+    QVERIFY(bmTransferCommit(&Transfer, p_Check, 8) == TRUE);
+    QCOMPARE(bmTransferAccept(&Transfer, 1, 1), Error_t(1));
+    QVERIFY(bmTransferCommit(&Transfer, p_Check + 8, 1) == TRUE);
+    QCOMPARE(quint32(bmTransferCrc(&Transfer)), 0xFC891918u);
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::utLegacyTransfer() {
+    QByteArray Image = CreateImage(1001);
+    CSimUpdate Update(Image, 1, 0);
+    QVERIFY(Update.Run() > 0);
+    VerifyNodes(Update, Image);
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::utWindowedTransfer() {
+    QByteArray Image = CreateImage(1001);
+    CSimUpdate Update(Image, 1, CFirmwareTransfer::m_MaxWindow);
+    QCOMPARE(Update.m_Nodes[0].Master.GetWindow(), CFirmwareTransfer::m_MaxWindow);
+    QVERIFY(Update.Run() > 0);
+    VerifyNodes(Update, Image);
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::utDuplicateFrame() {
+    QByteArray Image = CreateImage(1001);
+    for (quint8 Window = 0; Window <= CFirmwareTransfer::m_MaxWindow; Window += 8) {
+        CSimUpdate Update(Image, 1, Window);
+        Update.RepeatFrame(5);
+        QVERIFY(Update.Run() > 0);
+        VerifyNodes(Update, Image);
+    }
+
+    // A frame out of sequence is rejected
+    bmTransfer_t Transfer;
+    bmTransferInit(&Transfer, 16, 0);
+    QCOMPARE(bmTransferAccept(&Transfer, 8, 1), Error_t(0));
+    QCOMPARE(bmTransferAccept(&Transfer, 9, 0), Error_t(1));
+    // Error codes are not negative with the 64 bit Int32 of a host
+    QCOMPARE(bmTransferAccept(&Transfer, 17, 0), Error_t(E_PARAMETER_OUT_OF_RANGE));
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::utBadAcknowledge() {
+    QByteArray Image = CreateImage(100);
+    quint8 Data[CFirmwareTransfer::m_FrameSize];
+    quint8 Length;
+    bool Odd;
+
+    CFirmwareTransfer Transfer;
+    Transfer.Start(Image, 4);
+    for (int i = 0; i < 4; i++) {
+        QVERIFY(Transfer.NextFrame(Data, Length, Odd));
+        QCOMPARE(Odd, i % 2 == 1);
+    }
+    // window full
+    QVERIFY(!Transfer.NextFrame(Data, Length, Odd));
+
+    quint32 Crc = CFirmwareTransfer::CalculateCrc(reinterpret_cast<const quint8 *>(Image.constData()), 16);
+    QVERIFY(!Transfer.Acknowledge(16, Crc ^ 1));
+    QVERIFY(!Transfer.Acknowledge(40, Crc));
+    QVERIFY(!Transfer.Acknowledge(12, Crc));
+    QVERIFY(Transfer.Acknowledge(16, Crc));
+    QVERIFY(!Transfer.Acknowledge(16, Crc));
+    QVERIFY(Transfer.NextFrame(Data, Length, Odd));
+    QVERIFY(!Transfer.Finished());
+
+    // without window, a single frame is acknowledged
+    Transfer.Start(Image, 0);
+    QVERIFY(!Transfer.Acknowledge());
+    QVERIFY(Transfer.NextFrame(Data, Length, Odd));
+    QVERIFY(Transfer.NextFrame(Data, Length, Odd));
+    QVERIFY(!Transfer.NextFrame(Data, Length, Odd));
+    QVERIFY(Transfer.Acknowledge());
+    QVERIFY(Transfer.NextFrame(Data, Length, Odd));
+}
+
+/****************************************************************************/
+void TestBootLoaderTransfer::utThroughput() {
+    qreal Legacy = Throughput(1, 0);
+    qreal Windowed = Throughput(1, CFirmwareTransfer::m_MaxWindow);
+    qreal Parallel = Throughput(4, CFirmwareTransfer::m_MaxWindow);
+
+    // The window removes the master latency from the transfer
+    QVERIFY(Windowed > 2 * Legacy);
+    // The Slaves program their flash memory while the bus is used by other nodes
+    QVERIFY(Parallel > 1.5 * Windowed);
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestBootLoaderTransfer)
+
+#include "TestBootLoaderTransfer.moc"
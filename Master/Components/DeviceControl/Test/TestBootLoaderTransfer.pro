@@ -0,0 +1,25 @@
+!include("DeviceControl.pri"):error("DeviceControl.pri not found")
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = utTestBootLoaderTransfer
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+SLAVEDIR = ../../../../Slave/Components
+
+INCLUDEPATH += ../..
+INCLUDEPATH += ../Include
+INCLUDEPATH += $$SLAVEDIR/HAL/STM32/Include
+INCLUDEPATH += $$SLAVEDIR/HAL/Simulation/Include
+INCLUDEPATH += $$SLAVEDIR/BaseModule/Include
+
+SOURCES += TestBootLoaderTransfer.cpp \
+           $$SLAVEDIR/BaseModule/Source/bmTransfer.c \
+           $$SLAVEDIR/HAL/Simulation/Source/halHostSim.c
+
+UseLibs(Global DeviceControl)
@@ -0,0 +1,295 @@
+/****************************************************************************/
+/*! \file TestConfigurationSnapshot.cpp
+ *
+ *  \brief Unit test of the binary snapshots of the configuration files
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "DeviceControl/Include/Configuration/CANMessageConfiguration.h"
+#include "DeviceControl/Include/Configuration/ConfigurationSnapshot.h"
+#include "DeviceControl/Include/Configuration/HardwareConfiguration.h"
+#include "Global/Include/SystemPaths.h"
+
+namespace DeviceControl {
+
+static const QString CONFIG_SOURCE_PATH = "../LocalConfig";     //!< Configuration files of the test
+static const QString HW_CONFIG_FILE = "hw_specification.xml";   //!< Hardware configuration file
+static const QString CAN_MESSAGE_FILE = "fctmodule_spec.xml";   //!< CAN message configuration file
+
+/****************************************************************************/
+/*!
+ *  \brief  Test class for ConfigurationSnapshot
+ */
+/****************************************************************************/
+class TestConfigurationSnapshot : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void utHardwareConfiguration();
+    void utCANMessageConfiguration();
+    void utChangedSource();
+    void utDamagedSnapshot();
+
+private:
+    QString FilePath(const QString &FileName) const;
+    static QByteArray Serialize(const CModuleConfig *pConfig);
+    static QByteArray Serialize(const BaseDeviceConfiguration *pConfig);
+
+    QTemporaryDir *mp_Dir;  //!< Settings directory of a test
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Copies the configuration files to an empty settings directory
+ */
+/****************************************************************************/
+void TestConfigurationSnapshot::init()
+{
+    mp_Dir = new QTemporaryDir();
+    QVERIFY(mp_Dir->isValid());
+    QVERIFY(QFile::copy(CONFIG_SOURCE_PATH + "/" + HW_CONFIG_FILE, FilePath(HW_CONFIG_FILE)));
+    QVERIFY(QFile::copy(CONFIG_SOURCE_PATH + "/" + CAN_MESSAGE_FILE, FilePath(CAN_MESSAGE_FILE)));
+    Global::SystemPaths::Instance().SetSettingsPath(mp_Dir->path());
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Removes the settings directory
+ */
+/****************************************************************************/
+void TestConfigurationSnapshot::cleanup()
+{
+    delete mp_Dir;
+    mp_Dir = NULL;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the path of a file in the settings directory
+ *
+ *  \iparam FileName = Name of the file
+ *
+ *  \return Path of the file
+ */
+/****************************************************************************/
+QString TestConfigurationSnapshot::FilePath(const QString &FileName) const
+{
+    return mp_Dir->path() + "/" + FileName;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the serialized form of a CAN object configuration
+ *
+ *  \iparam pConfig = The configuration
+ *
+ *  \return Serialized configuration
+ */
+/****************************************************************************/
+QByteArray TestConfigurationSnapshot::Serialize(const CModuleConfig *pConfig)
+{
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    ConfigurationSnapshot::WriteModuleConfig(Stream, *pConfig);
+    return Data;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the serialized form of a device configuration
+ *
+ *  \iparam pConfig = The configuration
+ *
+ *  \return Serialized configuration
+ */
+/****************************************************************************/
+QByteArray TestConfigurationSnapshot::Serialize(const BaseDeviceConfiguration *pConfig)
+{
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    ConfigurationSnapshot::WriteDeviceConfig(Stream, *pConfig);
+    return Data;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  The hardware configuration read from the snapshot equals the one
+ *          parsed from the xml file, including the parents of the modules
+ */
+/****************************************************************************/
+void TestConfigurationSnapshot::utHardwareConfiguration()
+{
+    HardwareConfiguration Parsed;
+    HardwareConfiguration Loaded;
+    QElapsedTimer Timer;
+
+    Timer.start();
+    QCOMPARE(Parsed.ReadHWSpecification(HW_CONFIG_FILE), DCL_ERR_FCT_CALL_SUCCESS);
+    qint64 ParseTime = Timer.nsecsElapsed();
+    QVERIFY(QFile::exists(ConfigurationSnapshot::SnapshotFileName(FilePath(HW_CONFIG_FILE))));
+
+    Timer.restart();
+    QCOMPARE(Loaded.ReadHWSpecification(HW_CONFIG_FILE), DCL_ERR_FCT_CALL_SUCCESS);
+    qint64 LoadTime = Timer.nsecsElapsed();
+    qDebug("xml file: %lld us, snapshot: %lld us", ParseTime / 1000, LoadTime / 1000);
+
+    int Nodes = 0;
+    int Modules = 0;
+    CModuleConfig *pParsedNode = Parsed.GetCANNode(0);
+    CModuleConfig *pLoadedNode = Loaded.GetCANNode(0);
+    while (pParsedNode != 0) {
+        QVERIFY(pLoadedNode != 0);
+        QCOMPARE(Serialize(pLoadedNode), Serialize(pParsedNode));
+        QVERIFY(pLoadedNode->pParent == 0);
+
+        // the modules are found by their parent pointer
+        CModuleConfig *pParsedModule = Parsed.GetCANFctModule(pParsedNode, 0);
+        CModuleConfig *pLoadedModule = Loaded.GetCANFctModule(pLoadedNode, 0);
+        while (pParsedModule != 0) {
+            QVERIFY(pLoadedModule != 0);
+            QCOMPARE(Serialize(pLoadedModule), Serialize(pParsedModule));
+            QVERIFY(pLoadedModule->pParent == pLoadedNode);
+            pParsedModule = Parsed.GetCANFctModule(pParsedNode, pParsedModule);
+            pLoadedModule = Loaded.GetCANFctModule(pLoadedNode, pLoadedModule);
+            Modules++;
+        }
+        QVERIFY(pLoadedModule == 0);
+
+        pParsedNode = Parsed.GetCANNode(pParsedNode);
+        pLoadedNode = Loaded.GetCANNode(pLoadedNode);
+        Nodes++;
+    }
+    QVERIFY(pLoadedNode == 0);
+    QVERIFY(Nodes > 0);
+    QVERIFY(Modules > 0);
+
+    BaseDeviceConfiguration *pParsedDevice = Parsed.GetDevice(0);
+    BaseDeviceConfiguration *pLoadedDevice = Loaded.GetDevice(0);
+    QVERIFY(pParsedDevice != 0);
+    while (pParsedDevice != 0) {
+        QVERIFY(pLoadedDevice != 0);
+        QCOMPARE(Serialize(pLoadedDevice), Serialize(pParsedDevice));
+        pParsedDevice = Parsed.GetDevice(pParsedDevice);
+        pLoadedDevice = Loaded.GetDevice(pLoadedDevice);
+    }
+    QVERIFY(pLoadedDevice == 0);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  The CAN message configuration is read from a valid snapshot
+ */
+/****************************************************************************/
+void TestConfigurationSnapshot::utCANMessageConfiguration()
+{
+    CANMessageConfiguration Parsed;
+    QCOMPARE(Parsed.ReadCANMessageConfigurationFile(), DCL_ERR_FCT_CALL_SUCCESS);
+    unsigned int HeartbeatID = Parsed.GetCANMessageID(0, "HeartbeatSlave", 0, 0);
+
+    CANMessageConfiguration Loaded;
+    QCOMPARE(Loaded.ReadCANMessageConfigurationFile(), DCL_ERR_FCT_CALL_SUCCESS);
+    QCOMPARE(Loaded.GetCANMessageID(0, "HeartbeatSlave", 0, 0), HeartbeatID);
+
+    // a snapshot with other content proves the xml file is not read
+    CANMessageList MessageList;
+    MessageList.insert("00_HeartbeatSlave", 0x1234);
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(ConfigurationSnapshot::STREAM_VERSION);
+    Stream << MessageList;
+    ConfigurationSnapshot Snapshot(FilePath(CAN_MESSAGE_FILE), ConfigurationSnapshot::FORMAT_CAN_MESSAGES);
+    QVERIFY(Snapshot.Write(Data));
+
+    CANMessageConfiguration Crafted;
+    QCOMPARE(Crafted.ReadCANMessageConfigurationFile(), DCL_ERR_FCT_CALL_SUCCESS);
+    QCOMPARE(Crafted.GetCANMessageID(0, "HeartbeatSlave", 0, 0), 0x1234u);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  A snapshot is not used after the xml file changed
+ */
+/****************************************************************************/
+void TestConfigurationSnapshot::utChangedSource()
+{
+    CANMessageList MessageList;
+    MessageList.insert("00_HeartbeatSlave", 0x1234);
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(ConfigurationSnapshot::STREAM_VERSION);
+    Stream << MessageList;
+    ConfigurationSnapshot Snapshot(FilePath(CAN_MESSAGE_FILE), ConfigurationSnapshot::FORMAT_CAN_MESSAGES);
+    QVERIFY(Snapshot.Write(Data));
+
+    QFile Source(FilePath(CAN_MESSAGE_FILE));
+    QVERIFY(Source.open(QIODevice::Append));
+    QVERIFY(Source.write("\n<!-- changed -->\n") > 0);
+    Source.close();
+
+    CANMessageConfiguration Configuration;
+    QCOMPARE(Configuration.ReadCANMessageConfigurationFile(), DCL_ERR_FCT_CALL_SUCCESS);
+    QVERIFY(Configuration.GetCANMessageID(0, "HeartbeatSlave", 0, 0) != 0x1234u);
+
+    // the new snapshot belongs to the changed file
+    ConfigurationSnapshot Changed(FilePath(CAN_MESSAGE_FILE), ConfigurationSnapshot::FORMAT_CAN_MESSAGES);
+    QVERIFY(Changed.Read(Data));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  A damaged snapshot is replaced by parsing the xml file
+ */
+/****************************************************************************/
+void TestConfigurationSnapshot::utDamagedSnapshot()
+{
+    HardwareConfiguration Parsed;
+    QCOMPARE(Parsed.ReadHWSpecification(HW_CONFIG_FILE), DCL_ERR_FCT_CALL_SUCCESS);
+
+    QFile File(ConfigurationSnapshot::SnapshotFileName(FilePath(HW_CONFIG_FILE)));
+    QVERIFY(File.open(QIODevice::ReadWrite));
+    qint64 Size = File.size();
+    QVERIFY(Size > 64);
+    QVERIFY(File.seek(Size / 2));
+    QByteArray Byte = File.read(1);
+    Byte[0] = static_cast<char>(Byte.at(0) ^ 0x5A);
+    QVERIFY(File.seek(Size / 2));
+    QCOMPARE(File.write(Byte), static_cast<qint64>(1));
+    File.close();
+
+    QByteArray Data;
+    ConfigurationSnapshot Snapshot(FilePath(HW_CONFIG_FILE), ConfigurationSnapshot::FORMAT_HARDWARE);
+    QVERIFY(!Snapshot.Read(Data));
+
+    HardwareConfiguration Loaded;
+    QCOMPARE(Loaded.ReadHWSpecification(HW_CONFIG_FILE), DCL_ERR_FCT_CALL_SUCCESS);
+    QVERIFY(Loaded.GetCANNode(0) != 0);
+    QCOMPARE(Serialize(Loaded.GetCANNode(0)), Serialize(Parsed.GetCANNode(0)));
+
+    // the snapshot was written again
+    ConfigurationSnapshot Rewritten(FilePath(HW_CONFIG_FILE), ConfigurationSnapshot::FORMAT_HARDWARE);
+    QVERIFY(Rewritten.Read(Data));
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestConfigurationSnapshot)
+
+#include "TestConfigurationSnapshot.moc"
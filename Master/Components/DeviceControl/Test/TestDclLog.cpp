@@ -0,0 +1,300 @@
+/****************************************************************************/
+/*! \file TestDclLog.cpp
+ *
+ *  \brief Unit test and benchmark of the device control logging
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QDebug>
+#include <QFile>
+#include <QTime>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QThread>
+
+#include <linux/can.h>
+#include <unistd.h>
+
+#include "DeviceControl/Include/Global/dcl_log.h"
+
+namespace DeviceControl {
+
+/****************************************************************************/
+/*!
+ *  \brief  Output policy of the former logging implementation
+ *
+ *      Checks for the ./DEBUG file on every log line, used as benchmark
+ *      reference only.
+ */
+/****************************************************************************/
+class LegacyOutput2FILE
+{
+public:
+    static void Output(const std::string& msg)
+    {
+        FILE *fp = fopen("./DEBUG", "r");
+        if (fp != NULL) {
+            fclose(fp);
+            fprintf(Output2FILE::Stream(), "%s", msg.c_str());
+            fflush(Output2FILE::Stream());
+        }
+    }
+};
+
+//! Former logging macro, used as benchmark reference only
+#define LEGACY_FILE_LOG_L(area, level) \
+    if (level > Log<LegacyOutput2FILE>::ReportingLevel(area) || !Output2FILE::Stream()) ; \
+    else Log<LegacyOutput2FILE>().Get(area, level, "", __FUNCTION__)
+
+static const int BENCH_FRAMES = 100000;  //!< Log lines per benchmark run
+
+/****************************************************************************/
+/*!
+ *  \brief  Thread logging one line and exiting
+ */
+/****************************************************************************/
+class LogLineThread : public QThread
+{
+protected:
+    //! Logs the line
+    void run()
+    {
+        FILE_LOG_L(laCAN, llERROR) << "written by an exited thread";
+    }
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Test class of the device control logging
+ */
+/****************************************************************************/
+class TestDclLog : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void utDisabledWithoutDebugFile();
+    void utEnabledWritesAsync();
+    void utThreadExitAndStop();
+    void utBenchPerFrameCost();
+    void cleanupTestCase();
+
+private:
+    void LogFrame(const can_frame &Frame);
+    void LegacyLogFrame(const can_frame &Frame);
+    int MeasureNs(bool Legacy);
+
+    QTemporaryDir m_Dir;        //!< Working directory of the test
+    QString m_OldDir;           //!< Working directory before the test
+    FILE *mp_Stream;            //!< Log output
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Log a CAN frame like CANCommunicator::DispatchMessage does
+ *
+ *  \iparam Frame = CAN frame
+ */
+/****************************************************************************/
+void TestDclLog::LogFrame(const can_frame &Frame)
+{
+    FILE_LOG_L(laCAN, llDEBUG) << " HandleMsg " << std::hex << Frame.can_id << " " << (int)Frame.data[0]
+                               << " " << (int)Frame.data[1] << " " << (int)Frame.data[2];
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Log a CAN frame with the former implementation
+ *
+ *  \iparam Frame = CAN frame
+ */
+/****************************************************************************/
+void TestDclLog::LegacyLogFrame(const can_frame &Frame)
+{
+    LEGACY_FILE_LOG_L(laCAN, llDEBUG) << " HandleMsg " << std::hex << Frame.can_id << " " << (int)Frame.data[0]
+                                      << " " << (int)Frame.data[1] << " " << (int)Frame.data[2];
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Measure the cost of logging one frame
+ *
+ *  \iparam Legacy = true for the former implementation
+ *
+ *  \return Nanoseconds per frame
+ */
+/****************************************************************************/
+int TestDclLog::MeasureNs(bool Legacy)
+{
+    can_frame Frame;
+    memset(&Frame, 0, sizeof(Frame));
+    Frame.can_id = 0x10A80;
+
+    QTime Timer;
+    Timer.start();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        Frame.data[0] = (quint8)i;
+        if (Legacy) {
+            LegacyLogFrame(Frame);
+        }
+        else {
+            LogFrame(Frame);
+        }
+    }
+    return (int)(((qint64)Timer.elapsed() * 1000000) / BENCH_FRAMES);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Switch to an empty working directory and set the log stream
+ */
+/****************************************************************************/
+void TestDclLog::initTestCase()
+{
+    QVERIFY(m_Dir.isValid());
+    m_OldDir = QDir::currentPath();
+    QVERIFY(QDir::setCurrent(m_Dir.path()));
+
+    mp_Stream = fopen("device_control.log", "w");
+    QVERIFY(mp_Stream != NULL);
+    Output2FILE::Stream() = mp_Stream;
+    Output2FILE::StartWriter();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Without ./DEBUG nothing is logged
+ */
+/****************************************************************************/
+void TestDclLog::utDisabledWithoutDebugFile()
+{
+    Output2FILE::RefreshEnableState();
+    QCOMPARE(Output2FILE::ActiveLevel(laCAN), LOG_LEVEL_DISABLED);
+
+    FILE_LOG_L(laCAN, llERROR) << "must not be written";
+    Output2FILE::StopWriter();
+    Output2FILE::StartWriter();
+
+    QCOMPARE(QFile("device_control.log").size(), (qint64)0);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Creating ./DEBUG enables the logging, lines reach the file
+ */
+/****************************************************************************/
+void TestDclLog::utEnabledWritesAsync()
+{
+    QFile DebugFile("DEBUG");
+    QVERIFY(DebugFile.open(QIODevice::WriteOnly));
+    DebugFile.close();
+
+    // the writer thread picks up the new file
+    for (int i = 0; i < 100 && Output2FILE::ActiveLevel(laCAN) == LOG_LEVEL_DISABLED; i++) {
+        QTest::qWait(20);
+    }
+    QCOMPARE(Output2FILE::ActiveLevel(laCAN), (int)FILELog::ReportingLevel(laCAN));
+
+    FILE_LOG_L(laCAN, llERROR) << "written asynchronously";
+    FILE_LOG_L(laCAN, llDEBUG4) << "level too high";
+    Output2FILE::StopWriter();
+
+    QFile LogFile("device_control.log");
+    QVERIFY(LogFile.open(QIODevice::ReadOnly));
+    QByteArray Content = LogFile.readAll();
+    QVERIFY(Content.contains("written asynchronously"));
+    QVERIFY(!Content.contains("level too high"));
+
+    Output2FILE::StartWriter();
+    QVERIFY(QFile::remove("DEBUG"));
+    Output2FILE::RefreshEnableState();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Lines of exited threads and lines after the writer stopped are written
+ */
+/****************************************************************************/
+void TestDclLog::utThreadExitAndStop()
+{
+    QFile DebugFile("DEBUG");
+    QVERIFY(DebugFile.open(QIODevice::WriteOnly));
+    DebugFile.close();
+    Output2FILE::RefreshEnableState();
+
+    // the buffer of the thread is retired when it exits, its line is still written
+    LogLineThread Thread;
+    Thread.start();
+    QVERIFY(Thread.wait(5000));
+    Output2FILE::StopWriter();
+
+    // without the writer the line is written at once
+    FILE_LOG_L(laCAN, llERROR) << "written after the writer stopped";
+
+    QFile LogFile("device_control.log");
+    QVERIFY(LogFile.open(QIODevice::ReadOnly));
+    QByteArray Content = LogFile.readAll();
+    QVERIFY(Content.contains("written by an exited thread"));
+    QVERIFY(Content.contains("written after the writer stopped"));
+
+    Output2FILE::StartWriter();
+    QVERIFY(QFile::remove("DEBUG"));
+    Output2FILE::RefreshEnableState();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Compare the per frame cost of the former and the new logging
+ */
+/****************************************************************************/
+void TestDclLog::utBenchPerFrameCost()
+{
+    Output2FILE::RefreshEnableState();
+    int LegacyDisabled = MeasureNs(true);
+    int Disabled = MeasureNs(false);
+
+    QFile DebugFile("DEBUG");
+    QVERIFY(DebugFile.open(QIODevice::WriteOnly));
+    DebugFile.close();
+    Output2FILE::RefreshEnableState();
+
+    int LegacyEnabled = MeasureNs(true);
+    int Enabled = MeasureNs(false);
+
+    QVERIFY(QFile::remove("DEBUG"));
+    Output2FILE::RefreshEnableState();
+
+    qDebug("per frame cost, logging disabled:\n\tbefore %d ns, after %d ns\n", LegacyDisabled, Disabled);
+    qDebug("per frame cost, logging enabled:\n\tbefore %d ns, after %d ns\n", LegacyEnabled, Enabled);
+    QVERIFY(Disabled <= LegacyDisabled);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Stop the writer and restore the working directory
+ */
+/****************************************************************************/
+void TestDclLog::cleanupTestCase()
+{
+    Output2FILE::StopWriter();
+    Output2FILE::Stream() = stderr;
+    fclose(mp_Stream);
+    QVERIFY(QDir::setCurrent(m_OldDir));
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestDclLog)
+
+#include "TestDclLog.moc"
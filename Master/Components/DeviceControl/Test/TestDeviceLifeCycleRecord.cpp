@@ -0,0 +1,261 @@
+/****************************************************************************/
+/*! \file TestDeviceLifeCycleRecord.cpp
+ *
+ *  \brief Unit test of the life cycle counters and their journal
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "DeviceControl/Include/DeviceProcessing/DeviceLifeCycleRecord.h"
+
+namespace DeviceControl {
+
+static const QString XML_FILE = "DeviceLifeCycleRecord.xml";           //!< Export file
+static const QString JOURNAL_FILE = "DeviceLifeCycleRecord.journal";   //!< Journal file
+
+//! Record of a device before the journal, as written by earlier versions
+static const char XML_RECORD[] =
+    "<DeviceLifeCycles Version=\"0\">\n"
+    "    <DeviceList>\n"
+    "        <Device Key=\"LA\">\n"
+    "            <Functionmodules>\n"
+    "                <Functionmodule Key=\"AL_pressure_ctrl\">\n"
+    "                    <Parameter Key=\"Valve1_LifeCycle\" Value=\"1200\"/>\n"
+    "                    <Parameter Key=\"Exhaust_Fan_LifeTime\" Value=\"86400\"/>\n"
+    "                </Functionmodule>\n"
+    "            </Functionmodules>\n"
+    "        </Device>\n"
+    "    </DeviceList>\n"
+    "</DeviceLifeCycles>\n";
+
+/****************************************************************************/
+/*!
+ *  \brief  Test class for DeviceLifeCycleRecord
+ */
+/****************************************************************************/
+class TestDeviceLifeCycleRecord : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void utImportXml();
+    void utReplay();
+    void utTornTail();
+    void utCompaction();
+
+private:
+    QString FilePath(const QString &FileName) const;
+    static PartLifeCycleRecord *Part(DeviceLifeCycleRecord &Record);
+
+    QTemporaryDir *mp_Dir;  //!< Settings directory of a test
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Creates a settings directory with the XML record
+ */
+/****************************************************************************/
+void TestDeviceLifeCycleRecord::init()
+{
+    mp_Dir = new QTemporaryDir();
+    QVERIFY(mp_Dir->isValid());
+    QFile File(FilePath(XML_FILE));
+    QVERIFY(File.open(QIODevice::WriteOnly));
+    QVERIFY(File.write(XML_RECORD) > 0);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Removes the settings directory
+ */
+/****************************************************************************/
+void TestDeviceLifeCycleRecord::cleanup()
+{
+    delete mp_Dir;
+    mp_Dir = NULL;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the path of a file in the settings directory
+ *
+ *  \iparam FileName = Name of the file
+ *
+ *  \return Path of the file
+ */
+/****************************************************************************/
+QString TestDeviceLifeCycleRecord::FilePath(const QString &FileName) const
+{
+    return mp_Dir->path() + "/" + FileName;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the pressure control part of a record
+ *
+ *  \iparam Record = The record
+ *
+ *  \return The part, NULL if missing
+ */
+/****************************************************************************/
+PartLifeCycleRecord *TestDeviceLifeCycleRecord::Part(DeviceLifeCycleRecord &Record)
+{
+    ModuleLifeCycleRecord *pModule = Record.m_ModuleLifeCycleMap.value("LA");
+    return pModule ? pModule->m_PartLifeCycleMap.value("AL_pressure_ctrl") : NULL;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Without a journal, the counters are taken from the XML file
+ */
+/****************************************************************************/
+void TestDeviceLifeCycleRecord::utImportXml()
+{
+    DeviceLifeCycleRecord Record(mp_Dir->path());
+    QVERIFY(Record.ReadRecord());
+    QVERIFY(QFile::exists(FilePath(JOURNAL_FILE)));
+
+    PartLifeCycleRecord *pPart = Part(Record);
+    QVERIFY(pPart != NULL);
+    QCOMPARE(Record.GetCounterCount(), 2);
+    QVERIFY(pPart->Contains("Valve1_LifeCycle"));
+    QVERIFY(!pPart->Contains("Valve2_LifeCycle"));
+    QCOMPARE(pPart->GetValue("Valve1_LifeCycle"), 1200u);
+    QCOMPARE(pPart->GetValue("Exhaust_Fan_LifeTime"), 86400u);
+    QCOMPARE(pPart->GetValue("Valve2_LifeCycle"), 0u);
+    QCOMPARE(Record.GetValue(pPart->GetCounterID("Valve1_LifeCycle")), 1200u);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Changed and added counters are restored from the journal
+ */
+/****************************************************************************/
+void TestDeviceLifeCycleRecord::utReplay()
+{
+    {
+        DeviceLifeCycleRecord Record(mp_Dir->path());
+        QVERIFY(Record.ReadRecord());
+        PartLifeCycleRecord *pPart = Part(Record);
+        QVERIFY(pPart != NULL);
+
+        pPart->SetValue("Valve1_LifeCycle", 1300);
+        QCOMPARE(pPart->Increment("Exhaust_Fan_LifeTime", 60), 86460u);
+        pPart->SetValue("CarbonFilter_FirstRecord_Flag", 1);
+        qint64 Size = QFile(FilePath(JOURNAL_FILE)).size();
+        QVERIFY(Record.WriteRecord());
+        QVERIFY(QFile(FilePath(JOURNAL_FILE)).size() > Size);
+
+        // nothing changed, nothing written
+        Size = QFile(FilePath(JOURNAL_FILE)).size();
+        QVERIFY(Record.WriteRecord());
+        QCOMPARE(QFile(FilePath(JOURNAL_FILE)).size(), Size);
+    }
+
+    // the journal takes precedence over the XML file
+    QVERIFY(QFile::remove(FilePath(XML_FILE)));
+
+    DeviceLifeCycleRecord Record(mp_Dir->path());
+    QVERIFY(Record.ReadRecord());
+    PartLifeCycleRecord *pPart = Part(Record);
+    QVERIFY(pPart != NULL);
+    QCOMPARE(Record.GetCounterCount(), 3);
+    QCOMPARE(pPart->GetValue("Valve1_LifeCycle"), 1300u);
+    QCOMPARE(pPart->GetValue("Exhaust_Fan_LifeTime"), 86460u);
+    QCOMPARE(pPart->GetValue("CarbonFilter_FirstRecord_Flag"), 1u);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  A torn record at the end of the journal is discarded
+ */
+/****************************************************************************/
+void TestDeviceLifeCycleRecord::utTornTail()
+{
+    qint64 Size = 0;
+    {
+        DeviceLifeCycleRecord Record(mp_Dir->path());
+        QVERIFY(Record.ReadRecord());
+        Part(Record)->SetValue("Valve1_LifeCycle", 1300);
+        QVERIFY(Record.WriteRecord());
+        Size = QFile(FilePath(JOURNAL_FILE)).size();
+        Part(Record)->SetValue("Valve1_LifeCycle", 1400);
+        QVERIFY(Record.WriteRecord());
+    }
+
+    // cut the last record in half
+    QFile File(FilePath(JOURNAL_FILE));
+    qint64 FullSize = File.size();
+    QVERIFY(FullSize > Size);
+    QVERIFY(File.resize(Size + (FullSize - Size) / 2));
+
+    {
+        DeviceLifeCycleRecord Record(mp_Dir->path());
+        QVERIFY(Record.ReadRecord());
+        QCOMPARE(Part(Record)->GetValue("Valve1_LifeCycle"), 1300u);
+        QCOMPARE(QFile(FilePath(JOURNAL_FILE)).size(), Size);
+
+        // appending continues after the last intact record
+        Part(Record)->SetValue("Valve1_LifeCycle", 1500);
+        QVERIFY(Record.WriteRecord());
+    }
+
+    DeviceLifeCycleRecord Record(mp_Dir->path());
+    QVERIFY(Record.ReadRecord());
+    QCOMPARE(Part(Record)->GetValue("Valve1_LifeCycle"), 1500u);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  A large journal is compacted to the current values
+ */
+/****************************************************************************/
+void TestDeviceLifeCycleRecord::utCompaction()
+{
+    DeviceLifeCycleRecord Record(mp_Dir->path());
+    QVERIFY(Record.ReadRecord());
+    PartLifeCycleRecord *pPart = Part(Record);
+    QVERIFY(pPart != NULL);
+    qint64 CompactSize = QFile(FilePath(JOURNAL_FILE)).size();
+
+    quint32 Value = 1200;
+    while (QFile(FilePath(JOURNAL_FILE)).size() < DeviceLifeCycleJournal::COMPACT_SIZE)
+    {
+        pPart->SetValue("Valve1_LifeCycle", ++Value);
+        QVERIFY(Record.WriteRecord());
+    }
+    pPart->SetValue("Valve1_LifeCycle", ++Value);
+    QVERIFY(Record.WriteRecord());
+    QCOMPARE(QFile(FilePath(JOURNAL_FILE)).size(), CompactSize);
+
+    // the export holds the current values as well
+    QFile Export(FilePath(XML_FILE));
+    QVERIFY(Export.open(QIODevice::ReadOnly));
+    QVERIFY(Export.readAll().contains(QString("Value=\"%1\"").arg(Value).toLatin1()));
+
+    DeviceLifeCycleRecord Loaded(mp_Dir->path());
+    QVERIFY(Loaded.ReadRecord());
+    QCOMPARE(Part(Loaded)->GetValue("Valve1_LifeCycle"), Value);
+    QCOMPARE(Part(Loaded)->GetValue("Exhaust_Fan_LifeTime"), 86400u);
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestDeviceLifeCycleRecord)
+
+#include "TestDeviceLifeCycleRecord.moc"
@@ -0,0 +1,315 @@
+/****************************************************************************/
+/*! \file TestSensorLinearization.cpp
+ *
+ *  \brief Unit test and benchmark of the sensor linearization of the Slave
+ *
+ *      The conversion of the temperature sensor readings (fmTemperatureConvert.c)
+ *      and the linearization and sample filter of the base module
+ *      (bmLinearize.c) are built for the host. The conversion is compared
+ *      with the former conversion, which searched the tables from their
+ *      start, for all values an analog input can deliver.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QVector>
+#include <algorithm>
+
+extern "C" {
+#include "Global.h"
+#include "bmError.h"
+#include "ModuleIDs.h"
+#include "bmLinearize.h"
+#include "fmTemperature.h"
+#include "fmTemperatureSensor.h"
+}
+
+namespace DeviceControl {
+
+static const Int32 NTC_VOLTAGE = 3000;      //!< ADC supply voltage of the NTC thermistors
+static const Int32 NTC_RESISTANCE = 2700;   //!< Pullup resistance of the NTC thermistors (ASB_VER_B)
+
+static const UInt16 COLD_JUNCTIONS[] = { 0, 2150, 9999, 19799 };  //!< Cold junction temperatures tested
+
+/****************************************************************************/
+/*!
+ *  \brief  Temperature conversion as done before the linearization tables
+ *
+ *      The table is searched from its start, the first segment containing
+ *      the input is interpolated.
+ */
+/****************************************************************************/
+class ReferenceConversion
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam Type = Type of the temperature sensor
+     */
+    /****************************************************************************/
+    explicit ReferenceConversion(TempSensorType_t Type) : m_Type(Type)
+    {
+        // the former tables had TEMP_SENSOR_MAX points, missing points were 0
+        const bmLinearTable_t *p_Table = tempSensorGetTable(Type);
+        m_Table.fill(0, TEMP_SENSOR_MAX);
+        for (int i = 0; i < p_Table->Count; i++) {
+            m_Table[i] = p_Table->Points[i];
+        }
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Converts the reading of a temperature sensor
+     *
+     *  \iparam AdcValue = Filtered value of the analog input
+     *  \iparam ColdJunction = Cold junction temperature
+     *  \oparam Temperature = Temperature in 0.01 degree Celsius steps
+     *
+     *  \return NO_ERROR or E_TEMP_SENSOR_OUT_OF_RANGE
+     */
+    /****************************************************************************/
+    Error_t Convert(Int32 AdcValue, UInt16 ColdJunction, UInt16 *Temperature) const
+    {
+        const Int16 *Table = m_Table.constData();
+
+        if (ColdJunction / 100 >= TEMP_SENSOR_MAX) {
+            return E_TEMP_SENSOR_OUT_OF_RANGE;
+        }
+        if (m_Type == TYPEK || m_Type == TYPET) {
+            AdcValue += Table[ColdJunction / 100] +
+                        ((ColdJunction % 100) * (Table[ColdJunction / 100 + 1] - Table[ColdJunction / 100])) / 100;
+        }
+        else if (m_Type == NTC10K3A1I || m_Type == NTCGT103F) {
+            // the Cortex-M3 returns 0 on a division by 0
+            AdcValue = (AdcValue == NTC_VOLTAGE) ? 0 : (NTC_RESISTANCE * AdcValue) / (NTC_VOLTAGE - AdcValue);
+        }
+
+        for (int i = 0; i < TEMP_SENSOR_MAX - 2; i++) {
+            if (AdcValue >= Table[i] && AdcValue <= Table[i + 1]) {
+                *Temperature = 100 * i + (100 * (AdcValue - Table[i])) / (Table[i + 1] - Table[i]);
+                return NO_ERROR;
+            }
+            else if (AdcValue <= Table[i] && AdcValue >= Table[i + 1]) {
+                *Temperature = 100 * i + (100 * (Table[i] - AdcValue)) / (Table[i] - Table[i + 1]);
+                return NO_ERROR;
+            }
+        }
+        return E_TEMP_SENSOR_OUT_OF_RANGE;
+    }
+
+private:
+    TempSensorType_t m_Type;    //!< Type of the temperature sensor
+    QVector<Int16> m_Table;     //!< Conversion table
+};
+
+//! Samples returned by ReadSample
+static QVector<Int16> s_Samples;
+
+/****************************************************************************/
+/*!
+ *  \brief  Reads a sample from s_Samples, fails if there is none left
+ *
+ *  \iparam Handle = Unused
+ *  \oparam Value = Sample
+ *
+ *  \return NO_ERROR or E_PARAMETER_OUT_OF_RANGE
+ */
+/****************************************************************************/
+static Error_t ReadSample(Handle_t Handle, Int16 *Value)
+{
+    Q_UNUSED(Handle);
+    if (s_Samples.isEmpty()) {
+        return E_PARAMETER_OUT_OF_RANGE;
+    }
+    *Value = s_Samples.takeFirst();
+    return NO_ERROR;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Test class for the sensor linearization
+ */
+/****************************************************************************/
+class TestSensorLinearization : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /****************************************************************************/
+    /*!
+     *  \brief  Temperature sensor types
+     */
+    /****************************************************************************/
+    void utTemperature_data();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Compares the conversion with the former one for all ADC values
+     */
+    /****************************************************************************/
+    void utTemperature();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Tests the median and mean filter and the read errors
+     */
+    /****************************************************************************/
+    void utFilter();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Measures the time of a conversion on the host
+     */
+    /****************************************************************************/
+    void utBenchmark();
+};
+
+/****/
+void TestSensorLinearization::utTemperature_data()
+{
+    QTest::addColumn<int>("Type");
+
+    QTest::newRow("type K") << static_cast<int>(TYPEK);
+    QTest::newRow("NTC 10K3A1I") << static_cast<int>(NTC10K3A1I);
+    QTest::newRow("AD595") << static_cast<int>(AD595);
+    QTest::newRow("type T") << static_cast<int>(TYPET);
+    QTest::newRow("PT1000") << static_cast<int>(PT1000);
+    QTest::newRow("NTC GT103F") << static_cast<int>(NTCGT103F);
+}
+
+/****/
+void TestSensorLinearization::utTemperature()
+{
+    QFETCH(int, Type);
+    TempSensorType_t SensorType = static_cast<TempSensorType_t>(Type);
+    ReferenceConversion Reference(SensorType);
+    bool Thermocouple = (SensorType == TYPEK || SensorType == TYPET);
+    int Converted = 0;
+
+    for (size_t k = 0; k < (Thermocouple ? sizeof(COLD_JUNCTIONS) / sizeof(COLD_JUNCTIONS[0]) : 1); k++) {
+        for (Int32 AdcValue = -32768; AdcValue <= 32767; AdcValue++) {
+            UInt16 Expected = 0xFFFF;
+            UInt16 Temperature = 0xFFFF;
+            Error_t ExpectedError = Reference.Convert(AdcValue, COLD_JUNCTIONS[k], &Expected);
+            Error_t Error = tempSensorConvert(SensorType, AdcValue, COLD_JUNCTIONS[k], &Temperature);
+
+            // the former search ran into the missing points of the AD595 table below 0 degree Celsius
+            if (SensorType == AD595 && AdcValue >= 0 && AdcValue < tempSensorGetTable(AD595)->Points[0]) {
+                QCOMPARE(ExpectedError, static_cast<Error_t>(NO_ERROR));
+                QCOMPARE(Error, static_cast<Error_t>(E_TEMP_SENSOR_OUT_OF_RANGE));
+                continue;
+            }
+            if (Error != ExpectedError || Temperature != Expected) {
+                QFAIL(qPrintable(QString("ADC value %1, cold junction %2: %3 instead of %4")
+                                 .arg(AdcValue).arg(COLD_JUNCTIONS[k]).arg(Temperature).arg(Expected)));
+            }
+            Converted += (Error == NO_ERROR);
+        }
+    }
+    QVERIFY(Converted > 0);
+
+    UInt16 Temperature;
+    QCOMPARE(tempSensorConvert(SensorType, 0, 100 * TEMP_SENSOR_MAX, &Temperature),
+             static_cast<Error_t>(E_TEMP_SENSOR_OUT_OF_RANGE));
+}
+
+/****/
+void TestSensorLinearization::utFilter()
+{
+    bmFilter_t Median = { 3, FILTER_MEDIAN };
+    Int16 Value;
+
+    // median of 3 as the former filter, for all orders of the samples
+    Int16 Values[] = { -5, 7, 7, 120 };
+    for (int a = 0; a < 4; a++) {
+        for (int b = 0; b < 4; b++) {
+            for (int c = 0; c < 4; c++) {
+                s_Samples = QVector<Int16>() << Values[a] << Values[b] << Values[c];
+                QCOMPARE(bmReadFiltered(ReadSample, 0, &Median, &Value), static_cast<Error_t>(NO_ERROR));
+                Int16 Sorted[] = { Values[a], Values[b], Values[c] };
+                std::sort(Sorted, Sorted + 3);
+                QCOMPARE(Value, Sorted[1]);
+                QVERIFY(s_Samples.isEmpty());
+            }
+        }
+    }
+
+    bmFilter_t Mean = { 8, FILTER_MEAN };
+    s_Samples = QVector<Int16>() << 100 << 101 << 102 << 103 << 104 << 105 << 106 << 107;
+    QCOMPARE(bmReadFiltered(ReadSample, 0, &Mean, &Value), static_cast<Error_t>(NO_ERROR));
+    QCOMPARE(Value, static_cast<Int16>(103));
+
+    bmFilter_t Single = { 1, FILTER_MEDIAN };
+    s_Samples = QVector<Int16>() << -42;
+    QCOMPARE(bmReadFiltered(ReadSample, 0, &Single, &Value), static_cast<Error_t>(NO_ERROR));
+    QCOMPARE(Value, static_cast<Int16>(-42));
+
+    // read errors are passed on
+    s_Samples = QVector<Int16>() << 1 << 2;
+    QCOMPARE(bmReadFiltered(ReadSample, 0, &Median, &Value), static_cast<Error_t>(E_PARAMETER_OUT_OF_RANGE));
+
+    bmFilter_t Invalid = { 0, FILTER_MEDIAN };
+    QCOMPARE(bmReadFiltered(ReadSample, 0, &Invalid, &Value), static_cast<Error_t>(E_PARAMETER_OUT_OF_RANGE));
+    Invalid.Samples = FILTER_MAX_SAMPLES + 1;
+    QCOMPARE(bmReadFiltered(ReadSample, 0, &Invalid, &Value), static_cast<Error_t>(E_PARAMETER_OUT_OF_RANGE));
+}
+
+/****/
+void TestSensorLinearization::utBenchmark()
+{
+    const TempSensorType_t Types[] = { TYPEK, NTC10K3A1I, PT1000 };
+    const char *Names[] = { "type K", "NTC 10K3A1I", "PT1000" };
+    const int Repeat = 20;
+
+    for (int k = 0; k < 3; k++) {
+        ReferenceConversion Reference(Types[k]);
+        UInt32 Sum = 0;
+        UInt16 Temperature = 0;
+        QElapsedTimer Timer;
+
+        // ADC values over the whole table, as read by the temperature module
+        Timer.start();
+        for (int r = 0; r < Repeat; r++) {
+            for (Int32 AdcValue = 0; AdcValue < 18000; AdcValue++) {
+                if (Reference.Convert(AdcValue, 2500, &Temperature) == NO_ERROR) {
+                    Sum += Temperature;
+                }
+            }
+        }
+        qint64 ReferenceTime = Timer.nsecsElapsed();
+
+        Timer.restart();
+        for (int r = 0; r < Repeat; r++) {
+            for (Int32 AdcValue = 0; AdcValue < 18000; AdcValue++) {
+                if (tempSensorConvert(Types[k], AdcValue, 2500, &Temperature) == NO_ERROR) {
+                    Sum -= Temperature;
+                }
+            }
+        }
+        qint64 Time = Timer.nsecsElapsed();
+
+        QVERIFY(Sum == 0);
+        qDebug() << Names[k] << ": linear search" << ReferenceTime / (Repeat * 18000)
+                 << "ns, binary search" << Time / (Repeat * 18000) << "ns per conversion on the host";
+    }
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestSensorLinearization)
+
+#include "TestSensorLinearization.moc"
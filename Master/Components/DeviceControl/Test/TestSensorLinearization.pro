@@ -0,0 +1,28 @@
+!include("DeviceControl.pri"):error("DeviceControl.pri not found")
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = utTestSensorLinearization
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+SLAVEDIR = ../../../../Slave/Components
+
+DEFINES += SIMULATION ASB_VER_B
+
+INCLUDEPATH += ../..
+INCLUDEPATH += ../Include
+INCLUDEPATH += $$SLAVEDIR/HAL/STM32/Include
+INCLUDEPATH += $$SLAVEDIR/HAL/Simulation/Include
+INCLUDEPATH += $$SLAVEDIR/BaseModule/Include
+INCLUDEPATH += $$SLAVEDIR/FunctionModules/Temperature/Include
+
+SOURCES += TestSensorLinearization.cpp \
+           $$SLAVEDIR/BaseModule/Source/bmLinearize.c \
+           $$SLAVEDIR/FunctionModules/Temperature/Source/fmTemperatureConvert.c
+
+UseLibs(Global DeviceControl)
@@ -0,0 +1,238 @@
+/****************************************************************************/
+/*! \file TestStepperMotion.cpp
+ *
+ *  \brief Unit test and benchmark of the step calculation of the stepper motor
+ *
+ *      The motion functions of the Slave (fmStepperMotorMotion*.c) are built
+ *      for the host simulation. A position request is executed once with the
+ *      division free step calculation of the ISR and once with the direct
+ *      calculation, which is used as the reference. Both have to produce the
+ *      same steps and phases, with velocities and step intervals differing
+ *      by rounding only.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QVector>
+#include <string.h>
+
+extern "C" {
+#include "Global.h"
+#include "fmStepperMotor.h"
+#include "fmStepperMotorMotionISR.h"
+#include "fmStepperMotorMotionProfile.h"
+
+smData_t *smDataTable;  //!< Data of the stepper motor instances, used by the motion functions
+}
+
+namespace DeviceControl {
+
+/****************************************************************************/
+/*!
+ *  \brief  State of the motion after a single step
+ */
+/****************************************************************************/
+struct StepState {
+    qint32 Interval;    //!< Interval to the next step (us)
+    qint32 Position;    //!< Actual position (half-steps)
+    qint32 Phase;       //!< Actual phase
+    qint64 Velocity;    //!< Nominal velocity (micro-steps/s)
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Test class for the step calculation of the stepper motor
+ */
+/****************************************************************************/
+class TestStepperMotion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /****************************************************************************/
+    /*!
+     *  \brief  Profiles and distances of the position requests
+     */
+    /****************************************************************************/
+    void utPositionRequest_data();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Compares the division free and the direct step calculation
+     */
+    /****************************************************************************/
+    void utPositionRequest();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Measures the time of the ISR on the host for both calculations
+     */
+    /****************************************************************************/
+    void utBenchmark();
+
+private:
+    bool Move(qint32 Distance, bool Direct, QVector<StepState> *p_Steps);
+    void SetProfile(qint32 vMin, qint32 vMax, qint32 Acc, qint32 JerkTime, qint32 MicroSteps);
+
+    smData_t m_Data;        //!< Stepper motor instance
+    smProfile_t m_Profile;  //!< Motion profile of the instance
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Configures the single motion profile of the motor
+ *
+ *  \iparam vMin = Start and end velocity (half-steps/s)
+ *  \iparam vMax = Target velocity (half-steps/s)
+ *  \iparam Acc = Acceleration and deceleration (half-steps/s^2)
+ *  \iparam JerkTime = Duration of the jerk phases (ms)
+ *  \iparam MicroSteps = Micro-steps per half-step
+ */
+/****************************************************************************/
+void TestStepperMotion::SetProfile(qint32 vMin, qint32 vMax, qint32 Acc, qint32 JerkTime, qint32 MicroSteps)
+{
+    memset(&m_Profile, 0, sizeof(m_Profile));
+    m_Profile.Config.vMin = vMin;
+    m_Profile.Config.vMax = vMax;
+    m_Profile.Config.acc = Acc;
+    m_Profile.Config.dec = Acc;
+    m_Profile.Config.accJUpT = JerkTime;
+    m_Profile.Config.accJDownT = JerkTime;
+    m_Profile.Config.decJUpT = JerkTime;
+    m_Profile.Config.decJDownT = JerkTime;
+    m_Profile.Config.MicroSteps = MicroSteps;
+    m_Profile.StepWidth = SM_MICROSTEPS_PER_FULLSTEP / MicroSteps;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Executes a position request from position 0
+ *
+ *  \iparam Distance = Target position (half-steps)
+ *  \iparam Direct = Use the direct step calculation of the ISR
+ *  \oparam p_Steps = State after each step, NULL if not needed
+ *
+ *  \return true if the request was accepted and the motor stopped
+ */
+/****************************************************************************/
+bool TestStepperMotion::Move(qint32 Distance, bool Direct, QVector<StepState> *p_Steps)
+{
+    memset(&m_Data, 0, sizeof(m_Data));
+    smDataTable = &m_Data;
+    if (!smEvalProfile(&m_Profile)) {
+        return false;
+    }
+    m_Data.Profiles.Count = 1;
+    m_Data.Profiles.Set = &m_Profile;
+
+    smInitMotion(&m_Data.Motion, 0);
+    // the simulation does not start the motion timer
+    m_Data.Motion.Stop = SM_SC_NONE;
+    if (smPositionRequest(0, Distance, 0) < 0) {
+        return false;
+    }
+    if (Direct) {
+        m_Data.Motion.Param[m_Data.Motion.ActSet].StepCalc.Enabled = FALSE;
+    }
+
+    for (qint32 Count = 0; m_Data.Motion.State != MS_STOP; Count++) {
+        if (Count > Distance * SM_MICROSTEPS_PER_HALFSTEP) {
+            return false;
+        }
+        smMotionISR(0, 0x2);
+        if (p_Steps) {
+            StepState State = { static_cast<qint32>(m_Data.Motion.dt), static_cast<qint32>(m_Data.Motion.Pos),
+                                static_cast<qint32>(m_Data.Motion.Phase), static_cast<qint64>(m_Data.Motion.Nominal.v) };
+            p_Steps->append(State);
+        }
+    }
+    return true;
+}
+
+/****/
+void TestStepperMotion::utPositionRequest_data()
+{
+    QTest::addColumn<qint32>("vMin");
+    QTest::addColumn<qint32>("vMax");
+    QTest::addColumn<qint32>("Acc");
+    QTest::addColumn<qint32>("JerkTime");
+    QTest::addColumn<qint32>("MicroSteps");
+    QTest::addColumn<qint32>("Distance");
+
+    QTest::newRow("standard") << 50 << 1000 << 2000 << 50 << 32 << 2000;
+    QTest::newRow("slow acceleration") << 50 << 150 << 20 << 50 << 32 << 300;
+    QTest::newRow("fast") << 50 << 3000 << 6000 << 50 << 16 << 5000;
+    QTest::newRow("long jerk") << 10 << 800 << 500 << 400 << 8 << 1000;
+    QTest::newRow("crawl") << 5 << 100 << 50 << 1000 << 64 << 500;
+}
+
+/****/
+void TestStepperMotion::utPositionRequest()
+{
+    QFETCH(qint32, vMin);
+    QFETCH(qint32, vMax);
+    QFETCH(qint32, Acc);
+    QFETCH(qint32, JerkTime);
+    QFETCH(qint32, MicroSteps);
+    QFETCH(qint32, Distance);
+
+    SetProfile(vMin, vMax, Acc, JerkTime, MicroSteps);
+    QVector<StepState> Reference;
+    QVector<StepState> Steps;
+    QVERIFY(Move(Distance, true, &Reference));
+    QVERIFY(Move(Distance, false, &Steps));
+    QVERIFY(m_Data.Motion.Param[0].StepCalc.Enabled);
+    QCOMPARE(m_Data.Motion.Pos, static_cast<Int32>(Distance));
+    QCOMPARE(Steps.count(), Reference.count());
+
+    qint64 Time = 0;
+    qint64 ReferenceTime = 0;
+    for (int i = 0; i < Steps.count(); i++) {
+        const StepState &Step = Steps.at(i);
+        const StepState &Expected = Reference.at(i);
+        QCOMPARE(Step.Position, Expected.Position);
+        QCOMPARE(Step.Phase, Expected.Phase);
+        QVERIFY2(qAbs(Step.Velocity - Expected.Velocity) <= 2, qPrintable(QString("step %1").arg(i)));
+        QVERIFY2(qAbs(Step.Interval - Expected.Interval) <= qMax(2, Expected.Interval / 50),
+                 qPrintable(QString("step %1").arg(i)));
+        Time += Step.Interval;
+        ReferenceTime += Expected.Interval;
+    }
+    // rounding errors must not add up over the movement
+    QVERIFY(qAbs(Time - ReferenceTime) * 1000 < ReferenceTime);
+}
+
+/****/
+void TestStepperMotion::utBenchmark()
+{
+    const qint32 Distance = 20000;
+    SetProfile(50, 3000, 6000, 50, 64);
+
+    for (int Direct = 0; Direct < 2; Direct++) {
+        QElapsedTimer Timer;
+        Timer.start();
+        QVERIFY(Move(Distance, Direct, NULL));
+        qint64 Elapsed = Timer.nsecsElapsed();
+        qint64 Steps = static_cast<qint64>(Distance) * SM_MICROSTEPS_PER_HALFSTEP / m_Profile.StepWidth;
+        qDebug() << (Direct ? "direct calculation:" : "division free calculation:")
+                 << Elapsed / Steps << "ns per step on the host";
+    }
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestStepperMotion)
+
+#include "TestStepperMotion.moc"
@@ -0,0 +1,31 @@
+!include("DeviceControl.pri"):error("DeviceControl.pri not found")
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = utTestStepperMotion
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+SLAVEDIR = ../../../../Slave/Components
+STEPPERDIR = $$SLAVEDIR/FunctionModules/Steppermotor
+
+DEFINES += SIMULATION
+
+INCLUDEPATH += ../..
+INCLUDEPATH += ../Include
+INCLUDEPATH += $$SLAVEDIR/HAL/STM32/Include
+INCLUDEPATH += $$SLAVEDIR/HAL/Simulation/Include
+INCLUDEPATH += $$SLAVEDIR/BaseModule/Include
+INCLUDEPATH += $$STEPPERDIR/Include
+
+SOURCES += TestStepperMotion.cpp \
+           $$STEPPERDIR/Source/fmStepperMotorMotion.c \
+           $$STEPPERDIR/Source/fmStepperMotorMotionCalc.c \
+           $$STEPPERDIR/Source/fmStepperMotorMotionISR.c \
+           $$STEPPERDIR/Source/fmStepperMotorMotionProfile.c
+
+UseLibs(Global DeviceControl)
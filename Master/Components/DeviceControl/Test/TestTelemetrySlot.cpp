@@ -0,0 +1,132 @@
+/****************************************************************************/
+/*! \file TestTelemetrySlot.cpp
+ *
+ *  \brief Unit test of the latest value slot of the sensor telemetry
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QObject>
+#include <QThread>
+
+#include "DeviceControl/Include/Devices/TelemetrySlot.h"
+
+namespace DeviceControl {
+
+static const qint32 SAMPLE_COUNT = 1000000;     //!< Number of samples written by the writer thread
+
+/****************************************************************************/
+/*!
+ *  \brief  Writes samples into a slot, the value is equal to the time stamp
+ */
+/****************************************************************************/
+class SampleWriter : public QThread
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam Slot = Slot written by the thread
+     */
+    /****************************************************************************/
+    explicit SampleWriter(CTelemetrySlot<qreal> &Slot) : m_Slot(Slot) {}
+
+protected:
+    /****************************************************************************/
+    /*!
+     *  \brief  Thread function
+     */
+    /****************************************************************************/
+    void run()
+    {
+        for (qint32 i = 1; i <= SAMPLE_COUNT; i++) {
+            m_Slot.Store(i, i);
+        }
+    }
+
+private:
+    CTelemetrySlot<qreal> &m_Slot;  //!< Slot written by the thread
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Test class for CTelemetrySlot
+ */
+/****************************************************************************/
+class TestTelemetrySlot : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void utStoreLoad();
+    void utConcurrentRead();
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  A stored sample is read back with its time stamp
+ */
+/****************************************************************************/
+void TestTelemetrySlot::utStoreLoad()
+{
+    CTelemetrySlot<qreal> Slot;
+    qreal Value;
+    qint64 TimeStamp;
+
+    Slot.Load(Value, TimeStamp);
+    QCOMPARE(TimeStamp, Q_INT64_C(0));
+
+    Slot.Store(37.25, 1000);
+    Slot.Load(Value, TimeStamp);
+    QCOMPARE(Value, 37.25);
+    QCOMPARE(TimeStamp, Q_INT64_C(1000));
+    QCOMPARE(Slot.Value(), 37.25);
+    QCOMPARE(Slot.Age(1800), Q_INT64_C(800));
+
+    Slot.Clear();
+    QCOMPARE(Slot.Value(), 0.0);
+    QCOMPARE(Slot.Age(1800), Q_INT64_C(1800));
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  A reader never sees a value of one sample with the time stamp of
+ *          another one, while a writer stores samples at full speed
+ */
+/****************************************************************************/
+void TestTelemetrySlot::utConcurrentRead()
+{
+    CTelemetrySlot<qreal> Slot;
+    SampleWriter Writer(Slot);
+    qint64 Last = 0;
+    qint32 Reads = 0;
+
+    Writer.start();
+    while (Last < SAMPLE_COUNT) {
+        qreal Value;
+        qint64 TimeStamp;
+        Slot.Load(Value, TimeStamp);
+        QCOMPARE(static_cast<qint64>(Value), TimeStamp);
+        QVERIFY(TimeStamp >= Last);
+        Last = TimeStamp;
+        Reads++;
+    }
+    QVERIFY(Writer.wait(10000));
+    qDebug("%d reads during %d writes", Reads, SAMPLE_COUNT);
+}
+
+} // end namespace DeviceControl
+
+QTEST_MAIN(DeviceControl::TestTelemetrySlot)
+
+#include "TestTelemetrySlot.moc"
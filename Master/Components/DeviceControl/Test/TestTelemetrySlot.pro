@@ -0,0 +1,18 @@
+!include("DeviceControl.pri"):error("DeviceControl.pri not found")
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = utTestTelemetrySlot
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+INCLUDEPATH += ../Include
+
+SOURCES += TestTelemetrySlot.cpp
+
+UseLibs(Global DeviceControl)
@@ -9,6 +9,11 @@
  *  null (consisting of null bytes only). Because of CTR mode, no decryption
  *  has to be implemented.
  *
+ *  Besides the reference round functions there are two fast backends for
+ *  the CTR keystream: 32 bit T-tables and, on x86 hosts supporting it,
+ *  AES-NI. The backend is selected at runtime; all backends produce the
+ *  same output as the reference implementation.
+ *
  *  $Version:   $ 1.0
  *  $Date:      $ 2012-11-26
  *  $Author:    $ Raju
@@ -51,6 +56,19 @@ class AES
         static const int AES_SIZE = 16;           ///< AES block and key size
 
     private:
+        /*!
+         * \brief implementation used to encrypt the CTR blocks
+         */
+        enum Backend_t {
+            BACKEND_REFERENCE,          ///< byte wise reference round functions
+            BACKEND_TTABLE,             ///< 32 bit T-tables
+            BACKEND_AESNI               ///< AES-NI instructions
+        };
+
+        static Backend_t DetectBackend();
+        void IncrementCounter();
+        void EncryptBlocks(quint8 *blocks, int count);
+        void EncryptBlocksTable(quint8 *blocks, int count);
         quint8 Mul(quint8 elementone, quint8 elementtwo);
         void KeyAddition(quint8 state[4][4], const quint8 roundkey[4][4]);
         void ShiftRow(quint8 state[4][4]);
@@ -61,8 +79,14 @@ class AES
 
         // data
         static const int ROUNDS = 10;              ///< number of rounds
+        static const int CTR_BATCH_BLOCKS = 64;    ///< CTR blocks encrypted at once
         bool initialized; ///< flag for initialization
+        Backend_t m_backend;                ///< implementation in use
         quint8 m_roundkeys[ROUNDS+1][4][4]; ///< round keys array
+        quint32 m_roundwords[ROUNDS+1][4];  ///< round keys as big endian
+                                            ///< column words, T-table backend
+        quint8 m_roundbytes[ROUNDS+1][AES_SIZE]; ///< round keys stored
+                                            ///< columnwise, AES-NI backend
 
         quint8 m_keystream[AES_SIZE];  ///< the keystream
         quint8 *m_keyptr;               ///< next keystream byte to process
@@ -9,6 +9,10 @@
  *  null (consisting of null bytes only). Because of CTR mode, no decryption
  *  has to be implemented.
  *
+ *  The CTR keystream is generated in batches of counter blocks by a T-table
+ *  or an AES-NI backend, the reference round functions are kept for the
+ *  known answer tests.
+ *
  *  $Version:   $ 1.0
  *  $Date:      $ 2012-11-26
  *  $Author:    $ Raju
@@ -33,19 +37,201 @@
 #include "EncryptionDecryption/AES/Include/Aes.h"
 #include "EncryptionDecryption/AES/Source/BoxesRef.dat"
 
+#include <string.h>
+
+// AES-NI code is compiled with a function target attribute, so no special
+// compiler flags are needed and the binary still runs on CPUs without it
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define AES_WITH_AESNI
+#include <wmmintrin.h>
+#endif
+
 namespace EncryptionDecryption {
 
+namespace {
+
+/****************************************************************************/
+/*!
+ * \brief T-tables combining Substitution, ShiftRow and MixColumn
+ *
+ * Te[row][x] is the column produced by byte x of the given row after
+ * substitution and MixColumn, stored as big endian word (row 0 in the MSB).
+ */
+/****************************************************************************/
+struct TTables
+{
+    quint32 Te[4][256];     ///< round tables
+
+    /*!
+     * \brief build the tables from the S-box of BoxesRef.dat
+     */
+    TTables()
+    {
+        for(int x = 0; x < 256; ++x)
+        {
+            quint32 s1 = Sub[x];
+            quint32 s2 = ((s1 << 1) ^ ((s1 & 0x80) ? 0x1b : 0)) & 0xff;
+            quint32 s3 = s2 ^ s1;
+            quint32 word = (s2 << 24) | (s1 << 16) | (s1 << 8) | s3;
+
+            Te[0][x] = word;
+            Te[1][x] = (word >> 8) | (word << 24);
+            Te[2][x] = (word >> 16) | (word << 16);
+            Te[3][x] = (word >> 24) | (word << 8);
+        }
+    }
+};
+
+/****************************************************************************/
+/*!
+ * \brief the T-tables, built on first use
+ *
+ * \return - the tables
+ */
+/****************************************************************************/
+const TTables &Tables()
+{
+    static const TTables tables;
+    return tables;
+}
+
+/****************************************************************************/
+/*!
+ * \brief read a big endian word
+ *
+ * \iparam p - 4 bytes
+ *
+ * \return - the word
+ */
+/****************************************************************************/
+inline quint32 LoadWord(const quint8 *p)
+{
+    return (quint32(p[0]) << 24) | (quint32(p[1]) << 16) | (quint32(p[2]) << 8) | quint32(p[3]);
+}
+
+/****************************************************************************/
+/*!
+ * \brief write a big endian word
+ *
+ * \oparam p - 4 bytes
+ * \iparam word - the word
+ */
+/****************************************************************************/
+inline void StoreWord(quint8 *p, quint32 word)
+{
+    p[0] = quint8(word >> 24);
+    p[1] = quint8(word >> 16);
+    p[2] = quint8(word >> 8);
+    p[3] = quint8(word);
+}
+
+/****************************************************************************/
+/*!
+ * \brief XOR the keystream into the data, 8 bytes at a time
+ *
+ * \iparam data - the data
+ * \iparam keystream - the keystream
+ * \iparam len - number of bytes, a multiple of 8
+ */
+/****************************************************************************/
+inline void XorWords(quint8 *data, const quint8 *keystream, int len)
+{
+    for(int i = 0; i < len; i += 8)
+    {
+        quint64 d;
+        quint64 k;
+        memcpy(&d, data + i, 8);
+        memcpy(&k, keystream + i, 8);
+        d ^= k;
+        memcpy(data + i, &d, 8);
+    }
+}
+
+#ifdef AES_WITH_AESNI
+/****************************************************************************/
+/*!
+ * \brief encrypt blocks in place with AES-NI, four blocks interleaved
+ *
+ * \iparam roundkeys - rounds+1 round keys stored columnwise
+ * \iparam rounds - number of rounds
+ * \iparam blocks - the blocks
+ * \iparam count - number of blocks
+ */
+/****************************************************************************/
+__attribute__((target("aes,sse2")))
+void EncryptBlocksAesNi(const quint8 *roundkeys, int rounds, quint8 *blocks, int count)
+{
+    __m128i rk[15];
+    for(int r = 0; r <= rounds; ++r)
+    {
+        rk[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(roundkeys + 16*r));
+    }
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i *p = reinterpret_cast<__m128i*>(blocks + 16*i);
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(p), rk[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(p + 1), rk[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(p + 2), rk[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(p + 3), rk[0]);
+        for(int r = 1; r < rounds; ++r)
+        {
+            b0 = _mm_aesenc_si128(b0, rk[r]);
+            b1 = _mm_aesenc_si128(b1, rk[r]);
+            b2 = _mm_aesenc_si128(b2, rk[r]);
+            b3 = _mm_aesenc_si128(b3, rk[r]);
+        }
+        _mm_storeu_si128(p, _mm_aesenclast_si128(b0, rk[rounds]));
+        _mm_storeu_si128(p + 1, _mm_aesenclast_si128(b1, rk[rounds]));
+        _mm_storeu_si128(p + 2, _mm_aesenclast_si128(b2, rk[rounds]));
+        _mm_storeu_si128(p + 3, _mm_aesenclast_si128(b3, rk[rounds]));
+    }
+    for(; i < count; ++i)
+    {
+        __m128i *p = reinterpret_cast<__m128i*>(blocks + 16*i);
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(p), rk[0]);
+        for(int r = 1; r < rounds; ++r)
+        {
+            b = _mm_aesenc_si128(b, rk[r]);
+        }
+        _mm_storeu_si128(p, _mm_aesenclast_si128(b, rk[rounds]));
+    }
+}
+#endif
+
+}       // end anonymous namespace
+
 
 /****************************************************************************/
 /*!
  * \brief default constructor
  */
 /****************************************************************************/
-AES::AES(): initialized(false)
+AES::AES(): initialized(false), m_backend(DetectBackend())
 {
 
 }
 
+/****************************************************************************/
+/*!
+ * \brief select the fastest implementation for this CPU
+ *
+ * \return - the backend
+ */
+/****************************************************************************/
+AES::Backend_t AES::DetectBackend()
+{
+#ifdef AES_WITH_AESNI
+    if(__builtin_cpu_supports("aes"))
+    {
+        return BACKEND_AESNI;
+    }
+#endif
+    return BACKEND_TTABLE;
+}
+
 /****************************************************************************/
 /*!
  * \brief initialize key
@@ -62,6 +248,19 @@ void AES::init(QByteArray& key)
     RijndaelKeySched(reinterpret_cast<quint8*>(key.data()));
     m_streamlen = 0;
     memset(&m_ctrblock[0], 0, AES_SIZE);
+
+    // the same round keys in the layouts of the fast backends
+    for(int round = 0; round <= ROUNDS; ++round)
+    {
+        for(int column = 0; column < 4; ++column)
+        {
+            for(int row = 0; row < 4; ++row)
+            {
+                m_roundbytes[round][(column<<2)+row] = m_roundkeys[round][row][column];
+            }
+            m_roundwords[round][column] = LoadWord(&m_roundbytes[round][column<<2]);
+        }
+    }
 }
 
 /****************************************************************************/
@@ -79,35 +278,135 @@ void AES::AesCtr(QByteArray& data)
     int datlen = data.size();
     quint8 *dp = reinterpret_cast<quint8*>(data.data());
 
-    while(datlen > 0)
+    // use up the keystream left from the last call
+    for(; m_streamlen && datlen; --m_streamlen, --datlen)
     {
-        if(!m_streamlen)        // create new keystream item
+        *dp++ ^= *m_keyptr++;
+    }
+
+    // whole blocks: encrypt a batch of CTR blocks, then XOR word wise
+    quint8 keystream[CTR_BATCH_BLOCKS*AES_SIZE];
+    while(datlen >= AES_SIZE)
+    {
+        int blocks = qMin(datlen / AES_SIZE, CTR_BATCH_BLOCKS);
+        for(int counter = 0; counter < blocks; ++counter)
         {
-            // increment CTR block by 1, first byte is MSB
-            quint8 *ctrptr = &m_ctrblock[AES_SIZE-1];
-            while(!++*ctrptr)
-            {
-                --ctrptr;
-            }
+            IncrementCounter();
+            memcpy(&keystream[counter*AES_SIZE], m_ctrblock, AES_SIZE);
+        }
+        EncryptBlocks(keystream, blocks);
+
+        int processed = blocks*AES_SIZE;
+        XorWords(dp, keystream, processed);
+        dp += processed;
+        datlen -= processed;
+    }
 
-            // encrypt CTR block
-            memcpy(m_keystream, m_ctrblock, AES_SIZE);
-            RijndaelEncrypt(m_keystream);
+    // remaining bytes, the rest of the keystream is kept for the next call
+    if(datlen > 0)
+    {
+        IncrementCounter();
+        memcpy(m_keystream, m_ctrblock, AES_SIZE);
+        EncryptBlocks(m_keystream, 1);
+        m_keyptr = &m_keystream[0];
+        m_streamlen = AES_SIZE;
 
-            m_streamlen = AES_SIZE;
-            m_keyptr = &m_keystream[0];
+        for(; datlen; --m_streamlen, --datlen)
+        {
+            *dp++ ^= *m_keyptr++;
         }
+    }
+}
 
-        int processed = m_streamlen < datlen ? m_streamlen : datlen;
+/****************************************************************************/
+/*!
+ * \brief increment CTR block by 1, first byte is MSB
+ */
+/****************************************************************************/
+void AES::IncrementCounter()
+{
+    quint8 *ctrptr = &m_ctrblock[AES_SIZE-1];
+    while(!++*ctrptr)
+    {
+        --ctrptr;
+    }
+}
 
-        // do the "XOR en/decryption"
-        for(int counter = (processed-1); counter >=0; counter--)
+/****************************************************************************/
+/*!
+ * \brief encrypt blocks in place with the selected backend
+ *
+ * \iparam blocks - count blocks of AES_SIZE bytes
+ * \iparam count - number of blocks
+ */
+/****************************************************************************/
+void AES::EncryptBlocks(quint8 *blocks, int count)
+{
+    switch(m_backend)
+    {
+#ifdef AES_WITH_AESNI
+        case BACKEND_AESNI:
+            EncryptBlocksAesNi(&m_roundbytes[0][0], ROUNDS, blocks, count);
+            break;
+#endif
+        case BACKEND_REFERENCE:
+            for(int counter = 0; counter < count; ++counter)
+            {
+                RijndaelEncrypt(blocks + counter*AES_SIZE);
+            }
+            break;
+        default:
+            EncryptBlocksTable(blocks, count);
+            break;
+    }
+}
+
+/****************************************************************************/
+/*!
+ * \brief encrypt blocks in place with the T-tables
+ *
+ * Each round computes a column as XOR of four table entries, one per row
+ * taken from the column ShiftRow moves there, and the round key word.
+ *
+ * \iparam blocks - count blocks of AES_SIZE bytes
+ * \iparam count - number of blocks
+ */
+/****************************************************************************/
+void AES::EncryptBlocksTable(quint8 *blocks, int count)
+{
+    const quint32 (&te)[4][256] = Tables().Te;
+
+    for(int counter = 0; counter < count; ++counter)
+    {
+        quint8 *block = blocks + counter*AES_SIZE;
+        quint32 s0 = LoadWord(block) ^ m_roundwords[0][0];
+        quint32 s1 = LoadWord(block + 4) ^ m_roundwords[0][1];
+        quint32 s2 = LoadWord(block + 8) ^ m_roundwords[0][2];
+        quint32 s3 = LoadWord(block + 12) ^ m_roundwords[0][3];
+
+        for(int round = 1; round < ROUNDS; ++round)
         {
-            *dp++ ^= *m_keyptr++;
+            const quint32 *rk = m_roundwords[round];
+            quint32 t0 = te[0][s0 >> 24] ^ te[1][(s1 >> 16) & 0xff] ^ te[2][(s2 >> 8) & 0xff] ^ te[3][s3 & 0xff] ^ rk[0];
+            quint32 t1 = te[0][s1 >> 24] ^ te[1][(s2 >> 16) & 0xff] ^ te[2][(s3 >> 8) & 0xff] ^ te[3][s0 & 0xff] ^ rk[1];
+            quint32 t2 = te[0][s2 >> 24] ^ te[1][(s3 >> 16) & 0xff] ^ te[2][(s0 >> 8) & 0xff] ^ te[3][s1 & 0xff] ^ rk[2];
+            quint32 t3 = te[0][s3 >> 24] ^ te[1][(s0 >> 16) & 0xff] ^ te[2][(s1 >> 8) & 0xff] ^ te[3][s2 & 0xff] ^ rk[3];
+            s0 = t0;
+            s1 = t1;
+            s2 = t2;
+            s3 = t3;
         }
 
-        m_streamlen -= processed;
-        datlen -= processed;
+        /* Last round is special: there is no MixColumn */
+        const quint32 *rk = m_roundwords[ROUNDS];
+        StoreWord(block, ((quint32(Sub[s0 >> 24]) << 24) | (quint32(Sub[(s1 >> 16) & 0xff]) << 16) |
+                          (quint32(Sub[(s2 >> 8) & 0xff]) << 8) | quint32(Sub[s3 & 0xff])) ^ rk[0]);
+        StoreWord(block + 4, ((quint32(Sub[s1 >> 24]) << 24) | (quint32(Sub[(s2 >> 16) & 0xff]) << 16) |
+                              (quint32(Sub[(s3 >> 8) & 0xff]) << 8) | quint32(Sub[s0 & 0xff])) ^ rk[1]);
+        StoreWord(block + 8, ((quint32(Sub[s2 >> 24]) << 24) | (quint32(Sub[(s3 >> 16) & 0xff]) << 16) |
+                              (quint32(Sub[(s0 >> 8) & 0xff]) << 8) | quint32(Sub[s1 & 0xff])) ^ rk[2]);
+        StoreWord(block + 12, ((quint32(Sub[s3 >> 24]) << 24) | (quint32(Sub[(s0 >> 16) & 0xff]) << 16) |
+                               (quint32(Sub[(s1 >> 8) & 0xff]) << 8) | quint32(Sub[s2 & 0xff])) ^ rk[3]);
     }
 }
 
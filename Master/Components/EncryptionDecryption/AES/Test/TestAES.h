@@ -58,11 +58,13 @@ class TestAes: public QObject
         TestAes();           // default constructor
 
     private:
+        double MeasureCtr(int backend, int bytes);
 
     private slots:
         void utAesVariableKeyTest();
         void utAesRandomDataTest();
         void utAesCtrSimpleTest();
+        void utAesBackendTest();
         void utAesBenchTest();
 };
 
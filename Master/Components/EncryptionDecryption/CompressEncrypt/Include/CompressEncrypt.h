@@ -23,6 +23,8 @@
 #define ENCRYPTIONDECRYPTION_COMPRESSENCRYPT_H
 
 #include <QByteArray>
+#include <QList>
+#include <QThreadPool>
 #include "EncryptionDecryption/CryptoService/Include/CryptoService.h"
 
 namespace EncryptionDecryption {
@@ -30,6 +32,11 @@ namespace EncryptionDecryption {
 /****************************************************************************/
 /*!
  * \brief compress and optionally encrypt data stream
+ *
+ * The stream is cut into chunks of COMPR_ENCR_BUFSIZE bytes. Chunks are
+ * compressed in parallel on a thread pool and written in stream order, so
+ * the file format is the same as with sequential processing. Encryption
+ * is done in the calling thread since the CTR keystream is sequential.
  */
 /****************************************************************************/
 class CompressEncrypt
@@ -44,7 +51,13 @@ class CompressEncrypt
         void write(const QByteArray& data, bool hmac = true);
 
     private:
-        void writeBuffer(QByteArray data);
+        class CompressJob;
+
+        void writeBuffer(QByteArray& data);
+        void writeCompleted(int keep);
+        void writeChunk(QByteArray& chunk);
+        QByteArray nextBuffer();
+        void recycleBuffer(QByteArray& buffer);
         void close();
 
         // data
@@ -52,7 +65,11 @@ class CompressEncrypt
         CryptoService& m_cs; //!< crypto service
         bool m_encrypt;      //!< flag for encryption
         bool m_compressed;   //!< flag for compression
-        QByteArray m_buffer; //!< buffer to store in the byte array
+        QByteArray m_buffer; //!< chunk being filled
+        int m_fill;          //!< number of bytes in m_buffer
+        QList<QByteArray> m_freeBuffers;  //!< chunk buffers for reuse
+        QList<CompressJob*> m_pending;    //!< chunks being compressed, in stream order
+        QThreadPool m_pool;  //!< compression workers
 };
 
 }       // end namespace EncryptionDecryption
@@ -23,7 +23,54 @@
 
 #include "EncryptionDecryption/CompressEncrypt/Include/CompressEncrypt.h"
 
+#include <QRunnable>
+#include <QSemaphore>
+#include <string.h>
+
 namespace EncryptionDecryption {
+
+/****************************************************************************/
+/*!
+ * \brief compression of one chunk on the thread pool
+ */
+/****************************************************************************/
+class CompressEncrypt::CompressJob : public QRunnable
+{
+    public:
+        /*!
+         * \brief constructor
+         *
+         * \iparam input - the chunk, shared and not modified
+         */
+        explicit CompressJob(const QByteArray& input) : m_input(input)
+        {
+            setAutoDelete(false);
+        }
+
+        /*!
+         * \brief compress the chunk, executed by a pool thread
+         */
+        void run()
+        {
+            m_output = qCompress(m_input);
+            m_done.release();
+        }
+
+        /*!
+         * \brief wait until the chunk is compressed
+         */
+        void wait()
+        {
+            m_done.acquire();
+        }
+
+        QByteArray m_input;     //!< the chunk
+        QByteArray m_output;    //!< the compressed chunk
+
+    private:
+        QSemaphore m_done;      //!< released when m_output is ready
+};
+
 /****************************************************************************/
 /*!
  * \brief constructor
@@ -38,7 +85,7 @@ CompressEncrypt::CompressEncrypt(FailSafeOpen* fd,
                                  CryptoService& cs,
                                  bool encrypt, bool compressed):         //lint !e578 [Rw]
      mp_fd(fd), m_cs(cs), m_encrypt(encrypt), m_compressed(compressed),
-     m_buffer(QByteArray())
+     m_buffer(QByteArray()), m_fill(0)
 {
     if(m_encrypt)
     {
@@ -68,12 +115,16 @@ CompressEncrypt::~CompressEncrypt()
 /****************************************************************************/
 void CompressEncrypt::close()
 {
-    if(!m_buffer.isEmpty())
+    if(m_fill > 0)
     {
+        m_buffer.resize(m_fill);
         writeBuffer(m_buffer);
     }
+    writeCompleted(0);
 
     m_buffer.clear();
+    m_fill = 0;
+    m_freeBuffers.clear();
 }
 
 /****************************************************************************/
@@ -81,7 +132,8 @@ void CompressEncrypt::close()
  * \brief collect data in buffer, compress/encrypt and write if filled
  *
  * All written data are also put to HMAC computation of the
- * CryptoService instance m_cs.
+ * CryptoService instance m_cs. The data is copied once into the chunk
+ * buffer; a filled chunk is handed over as a whole.
  *
  * \iparam data - data to be processed
  * \iparam hmac - update HMAC if true
@@ -94,12 +146,28 @@ void CompressEncrypt::write(const QByteArray& data, bool hmac)
         m_cs.updateHMACs(data);
     }
 
-    m_buffer += data;
+    const char *source = data.constData();
+    int remaining = data.size();
 
-    while(m_buffer.size() >= Constants::COMPR_ENCR_BUFSIZE)
+    while(remaining > 0)
     {
-        writeBuffer(m_buffer.mid(0, Constants::COMPR_ENCR_BUFSIZE));
-        m_buffer = m_buffer.mid(Constants::COMPR_ENCR_BUFSIZE);
+        if(m_fill == 0)
+        {
+            m_buffer = nextBuffer();
+        }
+
+        int count = qMin(remaining, Constants::COMPR_ENCR_BUFSIZE - m_fill);
+        memcpy(m_buffer.data() + m_fill, source, count);
+        m_fill += count;
+        source += count;
+        remaining -= count;
+
+        if(m_fill == Constants::COMPR_ENCR_BUFSIZE)
+        {
+            writeBuffer(m_buffer);
+            m_buffer.clear();
+            m_fill = 0;
+        }
     }
 }
 
@@ -107,31 +175,116 @@ void CompressEncrypt::write(const QByteArray& data, bool hmac)
 /*!
  * \brief compress/encrypt a buffer and write it
  *
+ * With compression the chunk is queued on the thread pool; the number of
+ * queued chunks is limited to twice the number of workers.
+ *
  * \iparam data - possibly cut internal buffer
  */
 /****************************************************************************/
-void CompressEncrypt::writeBuffer(QByteArray data)
+void CompressEncrypt::writeBuffer(QByteArray& data)
 {
     if(data.isEmpty())
-	{	
-		return;
-	}
+    {
+        return;
+    }
 
-    QByteArray compressed(data);
-    // check the compress flag
-    if (m_compressed)
+    if(!m_compressed)
     {
-        compressed = qCompress(data);
+        writeChunk(data);
+        recycleBuffer(data);
+        return;
     }
 
-    compressed = General::int2byte(compressed.size()) + compressed;
+    CompressJob *job = new CompressJob(data);
+    m_pending.append(job);
+    m_pool.start(job);
+
+    writeCompleted(2*m_pool.maxThreadCount() - 1);
+}
+
+/****************************************************************************/
+/*!
+ * \brief write compressed chunks in stream order
+ *
+ * \iparam keep - number of chunks which may stay queued
+ */
+/****************************************************************************/
+void CompressEncrypt::writeCompleted(int keep)
+{
+    while(m_pending.size() > keep)
+    {
+        CompressJob *job = m_pending.takeFirst();
+        job->wait();
+
+        QByteArray compressed;
+        compressed.swap(job->m_output);
+        recycleBuffer(job->m_input);
+        delete job;
+
+        writeChunk(compressed);
+    }
+}
+
+/****************************************************************************/
+/*!
+ * \brief write one chunk with its length, encrypted if requested
+ *
+ * The length is written separately instead of being prepended; since the
+ * CTR keystream continues across calls, the file content is the same.
+ *
+ * \iparam chunk - the chunk, encrypted in place
+ */
+/****************************************************************************/
+void CompressEncrypt::writeChunk(QByteArray& chunk)
+{
+    QByteArray length(General::int2byte(chunk.size()));
 
     if(m_encrypt)
     {
-        m_cs.encrypt(compressed);
+        m_cs.encrypt(length);
+        m_cs.encrypt(chunk);
+    }
+
+    mp_fd->write(length);
+    mp_fd->write(chunk);
+}
+
+/****************************************************************************/
+/*!
+ * \brief get an empty chunk buffer
+ *
+ * \return - buffer of size COMPR_ENCR_BUFSIZE
+ */
+/****************************************************************************/
+QByteArray CompressEncrypt::nextBuffer()
+{
+    if(m_freeBuffers.isEmpty())
+    {
+        return QByteArray(Constants::COMPR_ENCR_BUFSIZE, Qt::Uninitialized);
     }
 
-    mp_fd->write(compressed);
+    QByteArray buffer = m_freeBuffers.takeLast();
+    buffer.resize(Constants::COMPR_ENCR_BUFSIZE);
+    return buffer;
+}
+
+/****************************************************************************/
+/*!
+ * \brief keep a chunk buffer which is no longer needed for reuse
+ *
+ * \iparam buffer - the buffer, cleared
+ */
+/****************************************************************************/
+void CompressEncrypt::recycleBuffer(QByteArray& buffer)
+{
+    QByteArray recycled;
+    recycled.swap(buffer);
+
+    if(m_freeBuffers.size() < 2*m_pool.maxThreadCount() &&
+       recycled.capacity() >= Constants::COMPR_ENCR_BUFSIZE)
+    {
+        m_freeBuffers.append(recycled);
+    }
 }
 
 
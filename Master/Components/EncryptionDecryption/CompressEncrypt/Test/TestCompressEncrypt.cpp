@@ -336,6 +336,50 @@ void TestCompressEncrypt::utTestEncrLong()
     fdi.close();
 }
 
+/****************************************************************************/
+/*!
+ * \brief chunks compressed in parallel are written in stream order
+ *
+ * Every chunk has different content; the output is compared with the
+ * sequential format: length of qCompress output, then qCompress output.
+ */
+/****************************************************************************/
+void TestCompressEncrypt::utTestParallelOrder()
+{
+    const int CHUNKS = 12;
+
+    QByteArray data;
+    for(int i = 0; i < CHUNKS*Constants::COMPR_ENCR_BUFSIZE + 1000; ++i)
+    {
+        data.append(static_cast<char>((i / Constants::COMPR_ENCR_BUFSIZE) * 17 + (i % 251)));
+    }
+
+    QByteArray expected;
+    for(int pos = 0; pos < data.size(); pos += Constants::COMPR_ENCR_BUFSIZE)
+    {
+        QByteArray compressed = qCompress(data.mid(pos, Constants::COMPR_ENCR_BUFSIZE));
+        expected += General::int2byte(compressed.size()) + compressed;
+    }
+
+    FailSafeOpen fdo(OUTFILE, 'w');
+
+    CryptoService cs;
+    cs.initHmacs();
+
+    CompressEncrypt ce(&fdo, cs, false, true);
+    // odd write sizes, so chunks are filled from several writes
+    for(int pos = 0; pos < data.size(); pos += 300007)
+    {
+        ce.write(data.mid(pos, 300007));
+    }
+    ce.close();
+    fdo.close();
+
+    FailSafeOpen fdi(OUTFILE, 'r');
+    QVERIFY(fdi.read() == expected);
+    fdi.close();
+}
+
 /****************************************************************************/
 /*!
  * \brief benchmark encryption without and with compression
@@ -364,6 +408,18 @@ void TestCompressEncrypt::utTestBenchmark()
                bpsec/1024./1024.);
     }
 
+    {
+        CompressEncrypt ce(&fdo, cs, false, true);
+        QByteArray data(STREAMLEN, 'z');
+        t.start();
+        ce.write(data);
+        ce.close();
+
+        double bpsec = STREAMLEN/(t.elapsed()/1000.);
+        qDebug("\nEncryptCompress with compression on %d threads: %.1f MB/sec\n",
+               QThread::idealThreadCount(), bpsec/1024./1024.);
+    }
+
     {
         CompressEncrypt ce(&fdo, cs, true);
         QByteArray data(STREAMLEN, 'z');
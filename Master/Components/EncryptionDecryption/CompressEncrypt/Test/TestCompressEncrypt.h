@@ -47,6 +47,7 @@ class TestCompressEncrypt: public QObject
         void utTestEncrMaxsize();
         void utTestPlainLong();
         void utTestEncrLong();
+        void utTestParallelOrder();
         void utTestBenchmark();
 };
 
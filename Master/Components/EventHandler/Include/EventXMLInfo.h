@@ -24,6 +24,7 @@
 #include <Global/Include/TranslatableString.h>
 #include <Global/Include/LoggingSource.h>
 #include <Global/Include/Utils.h>
+#include <Global/Include/BinaryCatalog.h>
 #include <QStringList>
 #include <QXmlStreamReader>
 #include <QSharedPointer>
@@ -435,6 +436,8 @@ private:
 /****************************************************************************/
 class EventXMLInfo {
 public:
+    static const quint32 CATALOG_FORMAT = 0x45565431;  ///< Format of the event catalog records.
+
     /****************************************************************************/
     /**
      * \brief explicit EventXMLInfo class constructor
@@ -446,6 +449,10 @@ public:
     /****************************************************************************/
     /**
      * \brief Read XML file and parse it into XMLEvent list
+     *
+     * A file is only parsed if there is no up to date event catalog compiled
+     * from it. The catalog is compiled then. Events of a catalog are read
+     * on their first use.
      * 
      * \return true - success, false - failed 
      */
@@ -455,11 +462,13 @@ public:
     /****************************************************************************/
     /**
      * \brief Get XML Event list in the EventXMLInfo object 
+     *
+     * Reads all events of the catalogs.
      * 
      * \return	Const Reference of XMLEvent list 	
      */
     /****************************************************************************/
-    const QHash< quint32, QSharedPointer<XMLEvent> >& GetEventList() const { return m_pXMLEventList; }
+    const QHash< quint32, QSharedPointer<XMLEvent> >& GetEventList() const;
 
     /****************************************************************************/
     /**
@@ -474,16 +483,45 @@ private:
     QString                                         m_ESEXMLFile;       ///< XML file containing event-scenario-error map list
     QSharedPointer<QXmlStreamReader>        		m_pXMLReader;		///< QT XML parser
     bool											m_ParsingStatus;	///< XML Parsing status
-    QHash< quint32, QSharedPointer<XMLEvent> >		m_pXMLEventList;	///< XML Event list
+    mutable QHash< quint32, QSharedPointer<XMLEvent> >	m_pXMLEventList;	///< XML Event list, also events read from the catalogs
+    QList< QSharedPointer<Global::BinaryCatalog> >  m_Catalogs;         ///< Event catalogs of the files not parsed
 
     /****************************************************************************/
     /**
-     * \brief  construct XMLEvent list and sort into m_pXMLEventList
+     * \brief  construct XMLEvent list and sort into rEventList
      * \param[in] strSrcName	Source Name 	
+     * \param[in,out] rEventList	Event list of the file
      * \return true - success, false - failed 
      */
     /****************************************************************************/
-    bool  ConstructXMLEvent(const QString& strSrcName);
+    bool  ConstructXMLEvent(const QString& strSrcName, QHash< quint32, QSharedPointer<XMLEvent> >& rEventList);
+
+    /****************************************************************************/
+    /**
+     * \brief  Read an event from the catalogs into m_pXMLEventList
+     * \param[in] eventId		Event Id
+     * \return		pointer to the XML Event object, NULL if not found
+     */
+    /****************************************************************************/
+    const XMLEvent* ReadCatalogEvent(quint32 eventId) const;
+
+    /****************************************************************************/
+    /**
+     * \brief  Encode an event as catalog record
+     * \param[in] event		XML Event
+     * \return		record
+     */
+    /****************************************************************************/
+    static QByteArray EncodeEvent(const XMLEvent& event);
+
+    /****************************************************************************/
+    /**
+     * \brief  Decode a catalog record
+     * \param[in] record		record of EncodeEvent
+     * \return		XML Event, null if the record is broken
+     */
+    /****************************************************************************/
+    static QSharedPointer<XMLEvent> DecodeEvent(const QByteArray& record);
 private:
     /****************************************************************************/
     /**
@@ -22,6 +22,8 @@
 #include <EventHandler/Include/EventXMLInfo.h>
 #include <Global/Include/GlobalDefines.h>
 #include <QFile>
+#include <QDataStream>
+#include <QDebug>
 using namespace Global;
 
 namespace EventHandler {
@@ -34,6 +36,8 @@ EventXMLInfo::EventXMLInfo(const QStringList& eventXMLFileList)
 {
 }
 
+const quint32 EventXMLInfo::CATALOG_FORMAT;
+
 bool EventXMLInfo::InitXMLInfo()
 {
     m_ParsingStatus = false; // set parsing status false
@@ -42,6 +46,15 @@ bool EventXMLInfo::InitXMLInfo()
     QStringList::iterator iter = m_eventXMLFileList.begin();
     for (; iter !=m_eventXMLFileList.end(); ++iter)
     {
+        // map the compiled events, the XML file is only parsed if it changed
+        QString catalogFile = Global::BinaryCatalog::CatalogFileName(*iter);
+        QSharedPointer<Global::BinaryCatalog> pCatalog(new Global::BinaryCatalog());
+        if (pCatalog->Open(catalogFile, CATALOG_FORMAT, *iter))
+        {
+            m_Catalogs.append(pCatalog);
+            continue;
+        }
+
         QFile xmlFile(*iter);
         if (xmlFile.exists())
         {
@@ -59,6 +72,7 @@ bool EventXMLInfo::InitXMLInfo()
             return false;
         }
 
+        QHash< quint32, QSharedPointer<XMLEvent> > fileEventList;
         while (!m_pXMLReader->atEnd())
         {
             m_pXMLReader->readNextStartElement();
@@ -72,7 +86,7 @@ bool EventXMLInfo::InitXMLInfo()
                 else
                 {
                     QString strSrcName = m_pXMLReader->attributes().value("Name").toString();
-                    if (false == this->ConstructXMLEvent(strSrcName))
+                    if (false == this->ConstructXMLEvent(strSrcName, fileEventList))
                     {
                         return false;
                     }
@@ -80,13 +94,29 @@ bool EventXMLInfo::InitXMLInfo()
 
             }
         }
+
+        QHash<quint32, QByteArray> records;
+        QHash< quint32, QSharedPointer<XMLEvent> >::const_iterator event = fileEventList.constBegin();
+        for (; event != fileEventList.constEnd(); ++event)
+        {
+            records.insert(event.key(), EncodeEvent(*event.value()));
+            // an event of a previous file has precedence
+            if (m_pXMLEventList.find(event.key()) == m_pXMLEventList.end() && ReadCatalogEvent(event.key()) == NULL)
+            {
+                m_pXMLEventList.insert(event.key(), event.value());
+            }
+        }
+        if (!Global::BinaryCatalog::Compile(catalogFile, CATALOG_FORMAT, *iter, records))
+        {
+            qDebug() << "EventXMLInfo: cannot write event catalog" << catalogFile;
+        }
     }
 
     m_ParsingStatus = true;
     return true;
 }
 
-bool EventXMLInfo::ConstructXMLEvent(const QString& strSrcName)
+bool EventXMLInfo::ConstructXMLEvent(const QString& strSrcName, QHash< quint32, QSharedPointer<XMLEvent> >& rEventList)
 {
     QSharedPointer<XMLEvent> pXMLEvent;
 #if !defined(__arm__)
@@ -318,9 +348,9 @@ bool EventXMLInfo::ConstructXMLEvent(const QString& strSrcName)
         else if (m_pXMLReader->name() == "Event" && m_pXMLReader->isEndElement())
         {
             // Check if the event has been in the list
-            if (m_pXMLEventList.find(pXMLEvent->m_ErrorId) == m_pXMLEventList.end())
+            if (rEventList.find(pXMLEvent->m_ErrorId) == rEventList.end())
             {
-                m_pXMLEventList.insert(pXMLEvent->m_ErrorId, pXMLEvent);
+                rEventList.insert(pXMLEvent->m_ErrorId, pXMLEvent);
             }
         }
         else if (m_pXMLReader->name() == "Step"&& !m_pXMLReader->isEndElement()) // For the "Step" elements
@@ -562,12 +592,117 @@ const XMLEvent* EventXMLInfo::GetEvent(quint32 eventId) const
     QHash< quint32, QSharedPointer<XMLEvent> >::const_iterator iter = m_pXMLEventList.find(eventId);
     if (iter == m_pXMLEventList.end())
     {
-        return NULL;
+        return ReadCatalogEvent(eventId);
     }
 
     return iter.value().data();
 }
 
+const QHash< quint32, QSharedPointer<XMLEvent> >& EventXMLInfo::GetEventList() const
+{
+    for (int i = 0; i < m_Catalogs.count(); i++)
+    {
+        QList<quint32> keys = m_Catalogs.at(i)->Keys();
+        for (int k = 0; k < keys.count(); k++)
+        {
+            if (m_pXMLEventList.find(keys.at(k)) == m_pXMLEventList.end())
+            {
+                (void)ReadCatalogEvent(keys.at(k));
+            }
+        }
+    }
+    return m_pXMLEventList;
+}
+
+const XMLEvent* EventXMLInfo::ReadCatalogEvent(quint32 eventId) const
+{
+    // the catalogs are in the order of the files, the first one wins
+    QByteArray record;
+    for (int i = 0; i < m_Catalogs.count(); i++)
+    {
+        if (m_Catalogs.at(i)->Find(eventId, record))
+        {
+            QSharedPointer<XMLEvent> pXMLEvent = DecodeEvent(record);
+            if (pXMLEvent.isNull())
+            {
+                return NULL;
+            }
+            m_pXMLEventList.insert(eventId, pXMLEvent);
+            return pXMLEvent.data();
+        }
+    }
+    return NULL;
+}
+
+QByteArray EventXMLInfo::EncodeEvent(const XMLEvent& event)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(static_cast<int>(QDataStream::Qt_4_0));
+    stream << event.m_ErrorId << event.m_Source << event.m_Code << event.m_EventName
+           << static_cast<qint32>(event.m_ErrorType) << static_cast<qint32>(event.m_AuthType)
+           << static_cast<qint32>(event.m_AlarmType) << event.m_RootStep
+           << static_cast<qint32>(event.m_EventSource) << static_cast<qint32>(event.m_LogLevel)
+           << event.m_UserLog << event.m_ServiceString;
+    stream << static_cast<quint32>(event.m_pEventStepList.count());
+    QHash< quint32, QSharedPointer<EventStep> >::const_iterator iter = event.m_pEventStepList.constBegin();
+    for (; iter != event.m_pEventStepList.constEnd(); ++iter)
+    {
+        const EventStep& step = *iter.value();
+        stream << step.m_Id << step.m_Type << step.m_Action << step.m_NextStepOnFail << step.m_NextStepOnSuccess
+               << step.m_StringId << step.m_TimeOut << static_cast<qint32>(step.m_ButtonType)
+               << step.m_ButtonEnableConditon << step.m_NextStepOnTimeOut << step.m_NextStepOnClickOk
+               << step.m_NextStepOnClickRetry << step.m_NextStepOnClickYES << step.m_NextStepOnClickNO
+               << step.m_NextStepOnClickCancel << step.m_StatusBar;
+    }
+    return record;
+}
+
+QSharedPointer<XMLEvent> EventXMLInfo::DecodeEvent(const QByteArray& record)
+{
+    QDataStream stream(record);
+    stream.setVersion(static_cast<int>(QDataStream::Qt_4_0));
+    quint32 errorId = 0;
+    qint32 errorType = 0;
+    qint32 authType = 0;
+    qint32 alarmType = 0;
+    qint32 eventSource = 0;
+    qint32 logLevel = 0;
+    stream >> errorId;
+    QSharedPointer<XMLEvent> pXMLEvent(new XMLEvent(errorId));
+    stream >> pXMLEvent->m_Source >> pXMLEvent->m_Code >> pXMLEvent->m_EventName
+           >> errorType >> authType >> alarmType >> pXMLEvent->m_RootStep
+           >> eventSource >> logLevel >> pXMLEvent->m_UserLog >> pXMLEvent->m_ServiceString;
+    pXMLEvent->m_ErrorType = static_cast<Global::EventType>(errorType);
+    pXMLEvent->m_AuthType = static_cast<Global::GuiUserLevel>(authType);
+    pXMLEvent->m_AlarmType = static_cast<Global::AlarmPosType>(alarmType);
+    pXMLEvent->m_EventSource = static_cast<Global::EventSourceType>(eventSource);
+    pXMLEvent->m_LogLevel = static_cast<Global::EventLogLevel>(logLevel);
+
+    quint32 stepCount = 0;
+    stream >> stepCount;
+    for (quint32 i = 0; i < stepCount && stream.status() == QDataStream::Ok; i++)
+    {
+        quint32 id = 0;
+        QString type;
+        qint32 buttonType = 0;
+        stream >> id >> type;
+        QSharedPointer<EventStep> pEventStep(new EventStep(id, type));
+        stream >> pEventStep->m_Action >> pEventStep->m_NextStepOnFail >> pEventStep->m_NextStepOnSuccess
+               >> pEventStep->m_StringId >> pEventStep->m_TimeOut >> buttonType
+               >> pEventStep->m_ButtonEnableConditon >> pEventStep->m_NextStepOnTimeOut >> pEventStep->m_NextStepOnClickOk
+               >> pEventStep->m_NextStepOnClickRetry >> pEventStep->m_NextStepOnClickYES >> pEventStep->m_NextStepOnClickNO
+               >> pEventStep->m_NextStepOnClickCancel >> pEventStep->m_StatusBar;
+        pEventStep->m_ButtonType = static_cast<Global::GuiButtonType>(buttonType);
+        pXMLEvent->m_pEventStepList.insert(id, pEventStep);
+    }
+    if (stream.status() != QDataStream::Ok)
+    {
+        return QSharedPointer<XMLEvent>();
+    }
+    return pXMLEvent;
+}
+
 const EventStep* XMLEvent::GetStep(quint32 stepId) const
 {
     QHash< quint32, QSharedPointer<EventStep> >::const_iterator iter = m_pEventStepList.find(stepId);
@@ -81,6 +81,13 @@ public:
     /****************************************************************************/
     qint32 GetGpioFd() { return m_Fd;}
     /****************************************************************************/
+    /**
+     * \brief  Returns the path of the GPIO value file
+     * \return File name
+     */
+    /****************************************************************************/
+    QString GetValueFileName() const { return mp_ValueFile->fileName(); }
+    /****************************************************************************/
     /**
      * \brief  Close GPIO value file
      */
@@ -35,6 +35,7 @@
 #include <QObject>
 #include <QTimer>
 #include <QFile>
+#include <GPIOManager/Include/PowerFailHandler.h>
 namespace GPIOManager {
 
 /****************************************************************************/
@@ -50,7 +51,9 @@ class GpioPoller:public QObject
     Q_OBJECT
     friend class TestGPIOThreadController;
 public:
-    GpioPoller(const qint32 SoftSwitchFileDescriptor, const qint32 PowerGoodFileDescriptor,const bool SkipSoftSwitchAtBoot);
+    GpioPoller(const qint32 SoftSwitchFileDescriptor, const qint32 PowerGoodFileDescriptor,const bool SkipSoftSwitchAtBoot,
+               const QString &PowerGoodFileName = QString());
+    ~GpioPoller();
 
     /****************************************************************************/
     /**
@@ -58,6 +61,13 @@ public:
      */
     /****************************************************************************/
     void QuitPolling() { m_QuitPolling = true; }
+    /****************************************************************************/
+    /**
+     * \brief  Returns the real time power fail handler.
+     * \return Handler, NULL if not running on target.
+     */
+    /****************************************************************************/
+    const PowerFailHandler *GetPowerFailHandler() const { return mp_PowerFailHandler; }
 
 private:
     Q_DISABLE_COPY(GpioPoller)
@@ -71,6 +81,8 @@ private:
     QTimer *mp_PollTimer; //!< Periodic timer to poll GPIOs.
     bool m_DontPollPowerGood; //!< Flag indicating  not to poll power good signal.
     bool m_QuitPolling; //!< If set to true, Poll() function will quit.
+    qint32 m_PowerFailFd; //!< Own file desc of power good GPIO for the power fail handler
+    PowerFailHandler *mp_PowerFailHandler; //!< Commits the power fail journal on the edge
 #if !defined(__arm__)
     QFile m_SoftSwitchFile; //!< SoftSwitch.txt
     QFile m_PowerGoodFile;  //!< PowerGood.txt
@@ -0,0 +1,102 @@
+/****************************************************************************/
+/*! \file PowerFailHandler.h
+ *
+ *  \brief  Definition of class PowerFailHandler.
+ *          Real time thread, which commits the power fail journal as soon
+ *          as the power good GPIO falls.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+#ifndef POWERFAILHANDLER_H
+#define POWERFAILHANDLER_H
+
+#include <pthread.h>
+#include <poll.h>
+
+#include <QAtomicInt>
+#include <QtGlobal>
+
+namespace GPIOManager {
+
+/****************************************************************************/
+/**
+ * \brief  Commits the power fail journal within microseconds of the edge.
+ *
+ *         The GpioPoller routes a power failure through the Qt event loops
+ *         of the GPIO and master threads, which takes milliseconds or more
+ *         under load. This class waits for the edge in its own SCHED_FIFO
+ *         thread instead and commits Global::PowerFailJournal directly. It
+ *         does not allocate, lock or call into Qt on this path, the Qt
+ *         command routing still runs as before.
+ *
+ *         The journal is committed once per falling edge. It is re-armed
+ *         when '1' is read from the file descriptor again.
+ */
+/****************************************************************************/
+class PowerFailHandler
+{
+    friend class TestPowerFailHandler;
+public:
+    PowerFailHandler(const qint32 FileDescriptor, const short Events = POLLPRI);
+    ~PowerFailHandler();
+    bool Start();
+    void Stop();
+
+    /****************************************************************************/
+    /**
+     * \brief  Returns the number of commits done so far.
+     *
+     *         The times of the last commit may be read after this returned
+     *         a new value.
+     *
+     * \return Number of commits
+     */
+    /****************************************************************************/
+    qint32 GetCommitCount() const { return m_CommitCount.loadAcquire(); }
+    /****************************************************************************/
+    /**
+     * \brief  Returns if the last commit succeeded.
+     * \return True if the journal was durable
+     */
+    /****************************************************************************/
+    bool GetCommitResult() const { return m_CommitResult; }
+    /****************************************************************************/
+    /**
+     * \brief  Returns the time from the edge until the journal was durable.
+     * \return Latency of the last commit [us]
+     */
+    /****************************************************************************/
+    qint64 GetLatency() const { return (m_DurableTime - m_EdgeTime) / 1000; }
+
+private:
+    Q_DISABLE_COPY(PowerFailHandler)
+
+    static void *ThreadFunction(void *p_Handler);
+    void Run();
+    static qint64 Now();
+
+    qint32 m_Fd;                //!< File desc of power good GPIO, not owned
+    short m_Events;             //!< Poll events signalling an edge
+    qint32 m_StopPipe[2];       //!< Self pipe to wake up the thread for stopping
+    pthread_t m_Thread;         //!< The real time thread
+    bool m_Running;             //!< True if the thread was started
+    bool m_Committed;           //!< Journal committed, waiting for power good again
+    QAtomicInt m_CommitCount;   //!< Number of commits, published after the times
+    bool m_CommitResult;        //!< Result of the last commit
+    qint64 m_EdgeTime;          //!< Monotonic time the last edge was seen [ns]
+    qint64 m_DurableTime;       //!< Monotonic time the last commit returned [ns]
+};
+
+} // end namespace GPIOManager
+#endif // POWERFAILHANDLER_H
@@ -336,7 +336,8 @@ void GPIOThreadController::StartGPIOPolling()
 #if defined(__arm__)
     m_PowerGoodGPIO.SetEdge("falling");
 #endif
-    mp_GpioPoller = new GpioPoller(m_SoftSwitchManager.GetSoftSwitchFd(), m_PowerGoodGPIO.GetGpioFd(), m_SkipSoftSwitchAtBoot);
+    mp_GpioPoller = new GpioPoller(m_SoftSwitchManager.GetSoftSwitchFd(), m_PowerGoodGPIO.GetGpioFd(), m_SkipSoftSwitchAtBoot,
+                                   m_PowerGoodGPIO.GetValueFileName());
     mp_GpioPoller->moveToThread(mp_PollingThread);
     CONNECTSIGNALSLOT(mp_GpioPoller, SoftSwitchPressed(), &m_SoftSwitchManager, OnSoftSwitchPressed());
     CONNECTSIGNALSLOT(mp_GpioPoller, PowerFailed(), this, SendPowerFailCommand());
@@ -404,6 +405,13 @@ void GPIOThreadController::SendPowerFailStageTwoCmd()
     m_PowerGoodSignalTestTimer.stop();
     const qint32 PowerGoodReadValue = m_PowerGoodGPIO.GetValue();
     Global::EventObject::Instance().RaiseEvent(Global::EVENT_GLOBAL_STRING_ID_DEBUG_MESSAGE, Global::FmtArgs() << QString("Power Good Value %1").arg(PowerGoodReadValue));
+    const PowerFailHandler *p_PowerFailHandler = mp_GpioPoller->GetPowerFailHandler();
+    if (p_PowerFailHandler && p_PowerFailHandler->GetCommitCount() > 0) {
+        Global::EventObject::Instance().RaiseEvent(Global::EVENT_GLOBAL_STRING_ID_DEBUG_MESSAGE, Global::FmtArgs()
+                                                   << QString("Power fail journal %1 %2 us after the edge")
+                                                      .arg(p_PowerFailHandler->GetCommitResult() ? "committed" : "commit failed")
+                                                      .arg(p_PowerFailHandler->GetLatency()));
+    }
     //Check if power was bad for more than or equal to half of the wait time or the current value is zero
     if (m_PowerBadCount >= (POWER_FAIL_WAIT_TIMER/POWER_GOOD_TEST_TIMER_INTERVAL) / 2 || PowerGoodReadValue == 0) {
         mp_GpioPoller->QuitPolling();
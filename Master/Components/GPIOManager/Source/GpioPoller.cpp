@@ -40,10 +40,12 @@ const quint32 POLL_TIMER_INTERVAL = 100; //!< timer value in ms
  *  \iparam SkipSoftSwitchAtBoot     = True - skip softswitch polling at bootup.
  *                                    Set to true for reboot, software update,
  *                                    boot after power failure.
+ *  \iparam PowerGoodFileName = Path of the power good GPIO value file, opened
+ *                              once more for the power fail handler.
  */
 /********************************************************************************/
 GpioPoller::GpioPoller(const qint32 SoftSwitchFileDescriptor, const qint32 PowerGoodFileDescriptor,
-                       const bool SkipSoftSwitchAtBoot)
+                       const bool SkipSoftSwitchAtBoot, const QString &PowerGoodFileName)
     : m_NumbOfFileDesc(2) // 1)Softswitch 2) PowerGood
     , m_Buf('1')
     , m_SoftSwitchFd(SoftSwitchFileDescriptor)
@@ -52,6 +54,8 @@ GpioPoller::GpioPoller(const qint32 SoftSwitchFileDescriptor, const qint32 Power
     , mp_PollTimer(NULL)
     , m_DontPollPowerGood(true)
     , m_QuitPolling(false)
+    , m_PowerFailFd(-1)
+    , mp_PowerFailHandler(NULL)
 {
     memset((void*)Fdset, 0, sizeof(Fdset));
 
@@ -65,7 +69,17 @@ GpioPoller::GpioPoller(const qint32 SoftSwitchFileDescriptor, const qint32 Power
     lseek(m_PowerGoofFd, 0, SEEK_SET); /* Start of file */
     (void)read(m_PowerGoofFd, &m_Buf, 1);
     //We start polling of gpio only on the target
-#if !defined(__arm__)
+#if defined(__arm__)
+    //The power fail handler needs its own open file, a read by Poll() would
+    //clear the edge before the handler sees it.
+    if (!PowerGoodFileName.isEmpty()) {
+        m_PowerFailFd = open(PowerGoodFileName.toLocal8Bit().constData(), O_RDONLY);
+        if (m_PowerFailFd >= 0) {
+            mp_PowerFailHandler = new PowerFailHandler(m_PowerFailFd);
+        }
+    }
+#else
+    Q_UNUSED(PowerGoodFileName)
 
     //ON desktop we simulate polling. We poll text files which simulate
     // sysfs gpio files.
@@ -85,6 +99,19 @@ GpioPoller::GpioPoller(const qint32 SoftSwitchFileDescriptor, const qint32 Power
 
 }
 
+/********************************************************************************/
+/*!
+ *  \brief    Destructor, stops the power fail handler
+ */
+/********************************************************************************/
+GpioPoller::~GpioPoller()
+{
+    delete mp_PowerFailHandler;
+    if (m_PowerFailFd >= 0) {
+        (void)close(m_PowerFailFd);
+    }
+}
+
 /****************************************************************************/
 /*!
  *  \brief  This method is called when GPIO polling thread is started.
@@ -114,6 +141,10 @@ void GpioPoller::Run() {
     // Attempt to set thread real-time priority to the SCHED_IDLE policy
     pthread_setschedparam(this_thread, SCHED_IDLE, &params);
 
+    if (mp_PowerFailHandler && !mp_PowerFailHandler->Start()) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_GPIO_ERROR, Global::FmtArgs() <<"Power fail handler not started");
+    }
+
     // Reboot/Software update/previous power fail, directly boot the software
     if (m_SkipSoftSwitchAtBoot) {
         emit SoftSwitchPressed();
@@ -0,0 +1,211 @@
+/****************************************************************************/
+/*! \file PowerFailHandler.cpp
+ *
+ *  \brief PowerFailHandler Implementation
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 17.10.2026
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+#include <GPIOManager/Include/PowerFailHandler.h>
+#include <Global/Include/PowerFailJournal.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace GPIOManager {
+
+const int POWER_FAIL_PRIORITY = 80; //!< SCHED_FIFO priority of the handler thread
+
+/********************************************************************************/
+/*!
+ *  \brief    Constructor
+ *  \iparam FileDescriptor = File descriptor of the power good GPIO value file.
+ *                           It must not be shared with another poller, since
+ *                           reading it clears the pending edge.
+ *  \iparam Events         = Poll events signalling an edge, POLLPRI for sysfs
+ *                           GPIOs, POLLIN for a pipe simulating the GPIO.
+ */
+/********************************************************************************/
+PowerFailHandler::PowerFailHandler(const qint32 FileDescriptor, const short Events)
+    : m_Fd(FileDescriptor)
+    , m_Events(Events)
+    , m_Running(false)
+    , m_Committed(false)
+    , m_CommitCount(0)
+    , m_CommitResult(false)
+    , m_EdgeTime(0)
+    , m_DurableTime(0)
+{
+    m_StopPipe[0] = -1;
+    m_StopPipe[1] = -1;
+}
+
+/********************************************************************************/
+/*!
+ *  \brief    Destructor, stops the thread
+ */
+/********************************************************************************/
+PowerFailHandler::~PowerFailHandler()
+{
+    Stop();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Starts the real time thread.
+ *
+ *          Falls back to the default scheduling policy, if the process may
+ *          not use SCHED_FIFO.
+ *
+ *  \return True on success
+ */
+/****************************************************************************/
+bool PowerFailHandler::Start()
+{
+    if (m_Running || m_Fd < 0) {
+        return false;
+    }
+    if (pipe(m_StopPipe) != 0) {
+        return false;
+    }
+    //Clear a pending edge, so poll() does not return at once.
+    char Value = '1';
+    (void)lseek(m_Fd, 0, SEEK_SET);
+    if (m_Events & POLLPRI) {
+        (void)read(m_Fd, &Value, 1);
+    }
+
+    pthread_attr_t Attributes;
+    struct sched_param Params;
+    Params.sched_priority = POWER_FAIL_PRIORITY;
+    (void)pthread_attr_init(&Attributes);
+    (void)pthread_attr_setinheritsched(&Attributes, PTHREAD_EXPLICIT_SCHED);
+    (void)pthread_attr_setschedpolicy(&Attributes, SCHED_FIFO);
+    (void)pthread_attr_setschedparam(&Attributes, &Params);
+    int Result = pthread_create(&m_Thread, &Attributes, ThreadFunction, this);
+    if (Result == EPERM) {
+        //Do not inherit the policy, the poller thread runs with SCHED_IDLE.
+        Params.sched_priority = 0;
+        (void)pthread_attr_setschedpolicy(&Attributes, SCHED_OTHER);
+        (void)pthread_attr_setschedparam(&Attributes, &Params);
+        Result = pthread_create(&m_Thread, &Attributes, ThreadFunction, this);
+    }
+    (void)pthread_attr_destroy(&Attributes);
+    if (Result != 0) {
+        (void)close(m_StopPipe[0]);
+        (void)close(m_StopPipe[1]);
+        m_StopPipe[0] = -1;
+        m_StopPipe[1] = -1;
+        return false;
+    }
+    m_Running = true;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Stops the real time thread and waits for it.
+ */
+/****************************************************************************/
+void PowerFailHandler::Stop()
+{
+    if (!m_Running) {
+        return;
+    }
+    char Value = 'q';
+    (void)write(m_StopPipe[1], &Value, 1);
+    (void)pthread_join(m_Thread, NULL);
+    (void)close(m_StopPipe[0]);
+    (void)close(m_StopPipe[1]);
+    m_StopPipe[0] = -1;
+    m_StopPipe[1] = -1;
+    m_Running = false;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Entry function of the real time thread.
+ *  \iparam p_Handler = The handler
+ *  \return NULL
+ */
+/****************************************************************************/
+void *PowerFailHandler::ThreadFunction(void *p_Handler)
+{
+    static_cast<PowerFailHandler *>(p_Handler)->Run();
+    return NULL;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Waits for edges and commits the journal on power failure.
+ */
+/****************************************************************************/
+void PowerFailHandler::Run()
+{
+    struct pollfd Fdset[2];
+    for (;;) {
+        Fdset[0].fd = m_Fd;
+        Fdset[0].events = m_Events;
+        Fdset[0].revents = 0;
+        Fdset[1].fd = m_StopPipe[0];
+        Fdset[1].events = POLLIN;
+        Fdset[1].revents = 0;
+
+        if (poll(Fdset, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (Fdset[1].revents != 0) {
+            return;
+        }
+        if ((Fdset[0].revents & (m_Events | POLLHUP)) == 0) {
+            continue;
+        }
+
+        qint64 EdgeTime = Now();
+        char Value = '1';
+        (void)lseek(m_Fd, 0, SEEK_SET);
+        if (read(m_Fd, &Value, 1) <= 0) {
+            // the simulated GPIO was closed
+            return;
+        }
+        if (Value == '0' && !m_Committed) {
+            m_Committed = true;
+            m_CommitResult = Global::PowerFailJournal::Instance().Commit();
+            m_DurableTime = Now();
+            m_EdgeTime = EdgeTime;
+            (void)m_CommitCount.fetchAndAddRelease(1);
+        }
+        else if (Value == '1') {
+            m_Committed = false;
+        }
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the monotonic time
+ *  \return Time [ns]
+ */
+/****************************************************************************/
+qint64 PowerFailHandler::Now()
+{
+    struct timespec Time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &Time);
+    return static_cast<qint64>(Time.tv_sec) * 1000000000 + Time.tv_nsec;
+}
+
+} // End of namespace GPIOManager
@@ -0,0 +1,214 @@
+/****************************************************************************/
+/*! \file TestPowerFailHandler.cpp
+ *
+ *  \brief Test harness for the real time power fail path. A pipe simulates
+ *         the power good GPIO, the edge to durable latency is reported.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+#include <QtTest/QTest>
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <GPIOManager/Include/PowerFailHandler.h>
+#include <Global/Include/PowerFailJournal.h>
+#include <Global/Include/LatencyHistogram.h>
+#include <unistd.h>
+
+namespace GPIOManager {
+
+static const int EDGE_COUNT = 20;           //!< Number of simulated power failures
+static const int EDGE_TIMEOUT = 2000;       //!< Maximum time until a commit [ms]
+
+/****************************************************************************/
+/**
+ * \brief Test class for PowerFailHandler.
+ */
+/****************************************************************************/
+class TestPowerFailHandler : public QObject {
+    Q_OBJECT
+
+private:
+    QString m_FileName;             //!< Journal file of the test
+    qint32 m_GpioPipe[2];           //!< Simulated power good GPIO
+    PowerFailHandler *mp_Handler;   //!< Handler under test
+
+    /****************************************************************************/
+    /**
+     * \brief Sets the simulated GPIO value.
+     * \iparam Value = '0' for power fail, '1' for power good
+     */
+    /****************************************************************************/
+    void SetGpio(char Value) {
+        QCOMPARE(write(m_GpioPipe[1], &Value, 1), static_cast<ssize_t>(1));
+    }
+    /****************************************************************************/
+    /**
+     * \brief Waits until the handler did a number of commits.
+     * \iparam Count = Expected number of commits
+     * \return True if the commits were done in time
+     */
+    /****************************************************************************/
+    bool WaitForCommits(qint32 Count) {
+        for (int Time = 0; Time < EDGE_TIMEOUT; Time++) {
+            if (mp_Handler->GetCommitCount() >= Count) {
+                return true;
+            }
+            (void)usleep(1000);
+        }
+        return false;
+    }
+
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Test a single power failure and the content of the journal.
+     */
+    /****************************************************************************/
+    void utTestCommit();
+    /****************************************************************************/
+    /**
+     * \brief Test that the journal is committed once per falling edge.
+     */
+    /****************************************************************************/
+    void utTestRearm();
+    /****************************************************************************/
+    /**
+     * \brief Report the edge to durable latency of many power failures.
+     */
+    /****************************************************************************/
+    void utTestLatency();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+};
+
+/****************************************************************************/
+void TestPowerFailHandler::initTestCase()
+{
+    m_FileName = QDir::tempPath() + "/utTestPowerFailHandler.journal";
+    (void)QFile::remove(m_FileName);
+    QVERIFY(Global::PowerFailJournal::Instance().Open(m_FileName));
+}
+
+/****************************************************************************/
+void TestPowerFailHandler::init()
+{
+    QCOMPARE(pipe(m_GpioPipe), 0);
+    mp_Handler = new PowerFailHandler(m_GpioPipe[0], POLLIN);
+    QVERIFY(mp_Handler->Start());
+    QVERIFY(!mp_Handler->Start());
+    QCOMPARE(mp_Handler->GetCommitCount(), 0);
+}
+
+/****************************************************************************/
+void TestPowerFailHandler::utTestCommit()
+{
+    Global::PowerFailJournal &Journal = Global::PowerFailJournal::Instance();
+    QVERIFY(Journal.Stage(Global::PFJ_SLOT_LOG_TAIL, "last entries"));
+
+    SetGpio('0');
+    QVERIFY(WaitForCommits(1));
+    QVERIFY(mp_Handler->GetCommitResult());
+    QVERIFY(mp_Handler->GetLatency() >= 0);
+    qDebug() << "Edge to durable latency" << mp_Handler->GetLatency() << "us";
+
+    // the records are on disk
+    QByteArray Record;
+    Journal.Close();
+    QVERIFY(Journal.Open(m_FileName));
+    QVERIFY(Journal.Load(Global::PFJ_SLOT_LOG_TAIL, Record));
+    QCOMPARE(Record, QByteArray("last entries"));
+}
+
+/****************************************************************************/
+void TestPowerFailHandler::utTestRearm()
+{
+    SetGpio('0');
+    QVERIFY(WaitForCommits(1));
+
+    // power stays bad, no second commit
+    SetGpio('0');
+    SetGpio('0');
+    (void)usleep(50000);
+    QCOMPARE(mp_Handler->GetCommitCount(), 1);
+
+    // power good again, the next edge commits
+    SetGpio('1');
+    SetGpio('0');
+    QVERIFY(WaitForCommits(2));
+    (void)usleep(50000);
+    QCOMPARE(mp_Handler->GetCommitCount(), 2);
+}
+
+/****************************************************************************/
+void TestPowerFailHandler::utTestLatency()
+{
+    Global::LatencyHistogram Histogram;
+    for (int i = 1; i <= EDGE_COUNT; i++) {
+        QVERIFY(Global::PowerFailJournal::Instance().Stage(Global::PFJ_SLOT_LOG_TAIL,
+                                                            QByteArray("Entry ") + QByteArray::number(i)));
+        SetGpio('0');
+        QVERIFY(WaitForCommits(i));
+        QVERIFY(mp_Handler->GetCommitResult());
+        Histogram.Record(mp_Handler->GetLatency());
+        SetGpio('1');
+    }
+    qDebug() << "Edge to durable latency" << Histogram.ToString();
+    QCOMPARE(Histogram.Total(), static_cast<qint64>(EDGE_COUNT));
+}
+
+/****************************************************************************/
+void TestPowerFailHandler::cleanup()
+{
+    mp_Handler->Stop();
+    delete mp_Handler;
+    mp_Handler = NULL;
+    (void)close(m_GpioPipe[0]);
+    (void)close(m_GpioPipe[1]);
+}
+
+/****************************************************************************/
+void TestPowerFailHandler::cleanupTestCase()
+{
+    Global::PowerFailJournal::Instance().Close();
+    (void)QFile::remove(m_FileName);
+}
+
+} // End of namespace GPIOManager
+
+QTEST_MAIN(GPIOManager::TestPowerFailHandler)
+
+#include "TestPowerFailHandler.moc"
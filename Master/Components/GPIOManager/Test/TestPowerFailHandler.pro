@@ -0,0 +1,7 @@
+!include("TestGPIOThreadController.pri") {
+    error("TestGPIOThreadController.pri not found")
+}
+
+TARGET = utTestPowerFailHandler
+
+SOURCES +=  TestPowerFailHandler.cpp
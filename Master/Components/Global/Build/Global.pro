@@ -9,3 +9,9 @@ HEADERS +=  ../Include/*.h \
 
 SOURCES +=  ../Source/*.cpp \
             ../Source/Commands/*.cpp
+
+# the heap profiler replaces malloc and free, so it is built only on request:
+# qmake CONFIG+=heap_profiler
+CONFIG(heap_profiler) {
+    DEFINES += HEAP_PROFILER
+}
@@ -21,15 +21,18 @@
 #define GLOBAL_ALARMPLAYER_H
 
 #include <QObject>
-#include <QProcess>
 #include <QMutex>
 
 #include <Global/Include/GlobalDefines.h>
+#include <Global/Include/AudioEngine.h>
 
 namespace Global {
 /****************************************************************************/
 /**
  * \brief Alarm Player
+ *
+ * The sounds are played by an in process AudioEngine. Sound files are
+ * decoded when they are set, so an alarm only starts a voice of the mixer.
  */
 /****************************************************************************/
 class AlarmPlayer : public QObject
@@ -90,10 +93,9 @@ private:
     quint8 m_volumeError; //!< Error volume
     quint8 m_volumeWarning; //!< Warning volume
     quint8 m_volumeInfo; //!< info volume
-    QProcess* m_processPlay; //!< Process to play tone
-    QProcess* m_processSetVolume; //!< Process to set volume
     QHash<Global::AlarmType, QString> m_soundList; //!< List for storing alarm file names
     QMutex m_Mutex; //!< Lock for thread safety
+    AudioEngine m_Engine; //!< Mixes and plays the alarm sounds
 
     AlarmPlayer();
     /****************************************************************************/
@@ -103,6 +105,13 @@ private:
      */
     /****************************************************************************/
     Q_DISABLE_COPY(AlarmPlayer)
+    /****************************************************************************/
+    /**
+     * \brief Starts the audio engine on the sound device, without a device on
+     *        the null sink.
+     */
+    /****************************************************************************/
+    void StartEngine();
     void emitAlarm (Global::AlarmType alarmType, bool UsePresetValues = true, QString Filename = "", quint8 Volume = 1);
 
 private slots:
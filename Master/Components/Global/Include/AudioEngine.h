@@ -0,0 +1,240 @@
+/****************************************************************************/
+/*! \file Global/Include/AudioEngine.h
+ *
+ *  \brief Definition file for class AudioEngine.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_AUDIOENGINE_H
+#define GLOBAL_AUDIOENGINE_H
+
+#include <Global/Include/AudioSink.h>
+#include <Global/Include/LatencyHistogram.h>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+namespace Global {
+
+class AudioMixerThread;
+
+/****************************************************************************/
+/**
+ * \brief In process player for short sounds like alarms.
+ *
+ * Sounds are decoded once by LoadSound and kept in memory, converted to the
+ * format of the engine. A mixer thread mixes the playing sounds with their
+ * volume and writes them to the sink in periods of a few milliseconds, also
+ * silence while nothing plays. So a sound started by Play is heard after at
+ * most one period plus the buffer of the sink, without starting a process
+ * or reading a file.
+ *
+ * The time from Play to the first sample handed to the sink, plus the delay
+ * the sink reports, is recorded in PlayLatency.
+ *
+ * Start and Stop are not thread safe, the other functions are.
+ */
+/****************************************************************************/
+class AudioEngine {
+    friend class AudioMixerThread;
+    friend class TestAudioEngine;
+
+public:
+    static const int DEFAULT_SAMPLE_RATE = 44100;   ///< Frames per second.
+    static const int DEFAULT_PERIOD_FRAMES = 441;   ///< Frames mixed at once, 10 ms.
+    static const int CHANNELS = 2;                  ///< Samples per frame.
+    static const int MAX_VOICES = 8;                ///< Sounds playing at the same time.
+    static const int MAX_VOLUME = 100;              ///< Volume playing a sound unchanged.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  SampleRate      Frames per second.
+     * \iparam  PeriodFrames    Frames mixed at once.
+     */
+    /****************************************************************************/
+    AudioEngine(int SampleRate = DEFAULT_SAMPLE_RATE, int PeriodFrames = DEFAULT_PERIOD_FRAMES);
+    /****************************************************************************/
+    /**
+     * \brief Destructor, stops the engine.
+     */
+    /****************************************************************************/
+    ~AudioEngine();
+    /****************************************************************************/
+    /**
+     * \brief Opens the sink and starts the mixer thread.
+     *
+     * \iparam  p_Sink  The sink, the engine takes the ownership, also on failure.
+     *
+     * \return  True on success, false if running or the sink cannot be opened.
+     */
+    /****************************************************************************/
+    bool Start(AudioSink *p_Sink);
+    /****************************************************************************/
+    /**
+     * \brief Stops the mixer thread and closes the sink.
+     */
+    /****************************************************************************/
+    void Stop();
+    /****************************************************************************/
+    /**
+     * \brief Returns if the mixer thread is running.
+     *
+     * \return  True if running.
+     */
+    /****************************************************************************/
+    bool IsRunning() const;
+    /****************************************************************************/
+    /**
+     * \brief Decodes a sound file into memory.
+     *
+     * Wave files with 8 or 16 bit PCM are decoded in process. Other files,
+     * e.g. Ogg Vorbis, are converted to wave by oggdec, once per file.
+     *
+     * \iparam  FileName    Path of the sound file.
+     *
+     * \return  True if loaded now or before.
+     */
+    /****************************************************************************/
+    bool LoadSound(const QString &FileName);
+    /****************************************************************************/
+    /**
+     * \brief Returns if a sound file is loaded.
+     *
+     * \iparam  FileName    Path of the sound file.
+     *
+     * \return  True if loaded.
+     */
+    /****************************************************************************/
+    bool IsLoaded(const QString &FileName) const;
+    /****************************************************************************/
+    /**
+     * \brief Starts playing a loaded sound.
+     *
+     * A sound already playing starts again. If MAX_VOICES sounds are
+     * playing, the oldest one stops.
+     *
+     * \iparam  FileName    Path of the sound file.
+     * \iparam  Volume      Volume, 0 to MAX_VOLUME.
+     *
+     * \return  True if the sound is loaded.
+     */
+    /****************************************************************************/
+    bool Play(const QString &FileName, int Volume);
+    /****************************************************************************/
+    /**
+     * \brief Stops all sounds.
+     */
+    /****************************************************************************/
+    void StopAll();
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of sounds playing.
+     *
+     * \return  Number of sounds.
+     */
+    /****************************************************************************/
+    int ActiveVoices() const;
+    /****************************************************************************/
+    /**
+     * \brief Returns the latencies from Play to the first sample played.
+     *
+     * \return  Histogram of the latencies in us.
+     */
+    /****************************************************************************/
+    const LatencyHistogram &PlayLatency() const {
+        return m_PlayLatency;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Decodes a wave file and converts it to the format of the engine.
+     *
+     * \iparam  Data        Content of the wave file.
+     * \iparam  SampleRate  Frames per second of the result.
+     * \oparam  Samples     Interleaved stereo samples.
+     *
+     * \return  True if the file is a supported wave file.
+     */
+    /****************************************************************************/
+    static bool DecodeWave(const QByteArray &Data, int SampleRate, QVector<qint16> &Samples);
+
+private:
+    typedef QSharedPointer<const QVector<qint16> > Sound_t;    ///< A decoded sound.
+
+    /****************************************************************************/
+    /**
+     * \brief A playing sound.
+     */
+    /****************************************************************************/
+    struct Voice {
+        QString FileName;       ///< Path of the sound file.
+        Sound_t Sound;          ///< The samples, NULL if the voice is free.
+        int     Position;       ///< Next sample to mix.
+        qint32  Gain;           ///< Gain, 0x8000 is unity.
+        qint64  PlayTime;       ///< Time of Play [us], -1 once mixed.
+        quint64 Sequence;       ///< Order of Play.
+    };
+
+    /****************************************************************************/
+    /*!
+     *  \brief Disable copy and assignment operator.
+     *
+     */
+    /****************************************************************************/
+    Q_DISABLE_COPY(AudioEngine)
+
+    /****************************************************************************/
+    /**
+     * \brief Mixes the next period, called by the mixer thread.
+     *
+     * \iparam  p_Mix       Buffer of a period for the sums of the samples.
+     * \oparam  p_Output    Interleaved samples of the period.
+     * \oparam  PlayTimes   Play times of the voices started in the period.
+     */
+    /****************************************************************************/
+    void MixPeriod(qint32 *p_Mix, qint16 *p_Output, QVector<qint64> &PlayTimes);
+    /****************************************************************************/
+    /**
+     * \brief Returns the time of the engine's clock.
+     *
+     * \return  Time in us.
+     */
+    /****************************************************************************/
+    qint64 Now() const {
+        return m_Clock.nsecsElapsed() / 1000;
+    }
+
+    int                             m_SampleRate;       ///< Frames per second.
+    int                             m_PeriodFrames;     ///< Frames mixed at once.
+    QElapsedTimer                   m_Clock;            ///< Clock of the latencies.
+    mutable QMutex                  m_Lock;             ///< Protects the sounds and voices.
+    QHash<QString, Sound_t>         m_Sounds;           ///< Loaded sounds by file name.
+    Voice                           m_Voices[MAX_VOICES];   ///< The voices.
+    quint64                         m_Sequence;         ///< Order of the next Play.
+    LatencyHistogram                m_PlayLatency;      ///< Latencies from Play to the sink [us].
+    QScopedPointer<AudioSink>       mp_Sink;            ///< The sink while running.
+    QScopedPointer<AudioMixerThread> mp_Mixer;          ///< The mixer thread while running.
+}; // end class AudioEngine
+
+} // end namespace Global
+
+#endif // GLOBAL_AUDIOENGINE_H
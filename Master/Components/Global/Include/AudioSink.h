@@ -0,0 +1,222 @@
+/****************************************************************************/
+/*! \file Global/Include/AudioSink.h
+ *
+ *  \brief Definition file for the audio sinks of the AudioEngine.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_AUDIOSINK_H
+#define GLOBAL_AUDIOSINK_H
+
+#include <QFile>
+#include <QLibrary>
+#include <QString>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Destination of the samples mixed by the AudioEngine.
+ *
+ * The samples are signed 16 bit, interleaved. A sink is opened and written
+ * by the mixer thread of the engine only.
+ */
+/****************************************************************************/
+class AudioSink {
+public:
+    /****************************************************************************/
+    /**
+     * \brief Destructor.
+     */
+    /****************************************************************************/
+    virtual ~AudioSink() {}
+    /****************************************************************************/
+    /**
+     * \brief Opens the sink.
+     *
+     * \iparam  SampleRate      Frames per second.
+     * \iparam  Channels        Samples per frame.
+     * \iparam  PeriodFrames    Frames written at once.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    virtual bool Open(int SampleRate, int Channels, int PeriodFrames) = 0;
+    /****************************************************************************/
+    /**
+     * \brief Writes frames.
+     *
+     * \iparam  p_Samples   Interleaved samples.
+     * \iparam  Frames      Number of frames.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    virtual bool Write(const qint16 *p_Samples, int Frames) = 0;
+    /****************************************************************************/
+    /**
+     * \brief Closes the sink.
+     */
+    /****************************************************************************/
+    virtual void Close() = 0;
+    /****************************************************************************/
+    /**
+     * \brief Returns if Write blocks until the device has room.
+     *
+     * The engine paces a sink which does not block with its own clock.
+     *
+     * \return  True if paced by the device.
+     */
+    /****************************************************************************/
+    virtual bool IsPaced() const = 0;
+    /****************************************************************************/
+    /**
+     * \brief Returns the time until the next written frame is played.
+     *
+     * \return  Delay in us.
+     */
+    /****************************************************************************/
+    virtual qint64 Delay() {
+        return 0;
+    }
+}; // end class AudioSink
+
+/****************************************************************************/
+/**
+ * \brief Sink discarding the samples, for headless operation.
+ */
+/****************************************************************************/
+class AudioNullSink : public AudioSink {
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    AudioNullSink() : m_Frames(0) {}
+
+    bool Open(int SampleRate, int Channels, int PeriodFrames);
+    bool Write(const qint16 *p_Samples, int Frames);
+    void Close();
+    bool IsPaced() const {
+        return false;
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of frames written.
+     *
+     * \return  Number of frames.
+     */
+    /****************************************************************************/
+    qint64 Frames() const {
+        return m_Frames;
+    }
+
+private:
+    qint64  m_Frames;   ///< Frames written.
+}; // end class AudioNullSink
+
+/****************************************************************************/
+/**
+ * \brief Sink writing a wave file, for tests and diagnosis.
+ */
+/****************************************************************************/
+class AudioFileSink : public AudioSink {
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  FileName    Path of the wave file.
+     */
+    /****************************************************************************/
+    explicit AudioFileSink(const QString &FileName) : m_File(FileName), m_Channels(0) {}
+
+    bool Open(int SampleRate, int Channels, int PeriodFrames);
+    bool Write(const qint16 *p_Samples, int Frames);
+    void Close();
+    bool IsPaced() const {
+        return false;
+    }
+
+private:
+    QFile   m_File;         ///< The wave file.
+    int     m_Channels;     ///< Samples per frame.
+
+    Q_DISABLE_COPY(AudioFileSink)
+}; // end class AudioFileSink
+
+/****************************************************************************/
+/**
+ * \brief Sink playing the samples on an ALSA device.
+ *
+ * libasound is loaded at run time, so neither its headers nor the library
+ * are needed to build. Open fails if it is not installed.
+ */
+/****************************************************************************/
+class AudioDeviceSink : public AudioSink {
+public:
+    static const int DEFAULT_LATENCY = 40000;   ///< Buffer of the device [us].
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  DeviceName  ALSA device name.
+     * \iparam  Latency     Buffer of the device [us], limits the delay of a sound.
+     */
+    /****************************************************************************/
+    explicit AudioDeviceSink(const QString &DeviceName = "default", int Latency = DEFAULT_LATENCY);
+    /****************************************************************************/
+    /**
+     * \brief Destructor.
+     */
+    /****************************************************************************/
+    ~AudioDeviceSink();
+
+    bool Open(int SampleRate, int Channels, int PeriodFrames);
+    bool Write(const qint16 *p_Samples, int Frames);
+    void Close();
+    bool IsPaced() const {
+        return true;
+    }
+    qint64 Delay();
+
+private:
+    typedef int (*PcmOpen_t)(void **, const char *, int, int);                                  ///< snd_pcm_open
+    typedef int (*PcmSetParams_t)(void *, int, int, unsigned int, unsigned int, int, unsigned int); ///< snd_pcm_set_params
+    typedef long (*PcmWritei_t)(void *, const void *, unsigned long);                           ///< snd_pcm_writei
+    typedef int (*PcmRecover_t)(void *, int, int);                                              ///< snd_pcm_recover
+    typedef int (*PcmDelay_t)(void *, long *);                                                  ///< snd_pcm_delay
+    typedef int (*PcmClose_t)(void *);                                                          ///< snd_pcm_close
+
+    QString         m_DeviceName;   ///< ALSA device name.
+    int             m_Latency;      ///< Buffer of the device [us].
+    int             m_SampleRate;   ///< Frames per second.
+    int             m_Channels;     ///< Samples per frame.
+    QLibrary        m_Library;      ///< libasound.
+    void            *mp_Pcm;        ///< The open PCM device.
+    PcmWritei_t     mp_Writei;      ///< snd_pcm_writei.
+    PcmRecover_t    mp_Recover;     ///< snd_pcm_recover.
+    PcmDelay_t      mp_Delay;       ///< snd_pcm_delay.
+    PcmClose_t      mp_Close;       ///< snd_pcm_close.
+
+    Q_DISABLE_COPY(AudioDeviceSink)
+}; // end class AudioDeviceSink
+
+} // end namespace Global
+
+#endif // GLOBAL_AUDIOSINK_H
@@ -0,0 +1,274 @@
+/****************************************************************************/
+/*! \file Global/Include/BinaryCatalog.h
+ *
+ *  \brief Definition file for class BinaryCatalog.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_BINARYCATALOG_H
+#define GLOBAL_BINARYCATALOG_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Memory mapped, precompiled catalog of records with a numeric key.
+ *
+ * A catalog is compiled once from the parsed XML source, e.g. a string or
+ * an event configuration file, and is mapped on the following starts. The
+ * records are found with a perfect hash, so nothing is parsed and no table
+ * is built on the heap at startup. Only the pages of the records looked up
+ * are read from disk.
+ *
+ * The file starts with a header holding the format of the records, the
+ * size and modification time of the source and a checksum. Open refuses a
+ * catalog of another catalog version or format, of a changed source or
+ * with a wrong checksum, so the caller compiles it again from the source.
+ *
+ * The format of the records is up to the user. EncodeStrings and
+ * DecodeStrings provide one for string lists.
+ *
+ * Find is thread safe, Open and Close are not.
+ */
+/****************************************************************************/
+class BinaryCatalog {
+    friend class TestBinaryCatalog;
+
+public:
+    static const quint32 CATALOG_VERSION = 1;           ///< Version of the catalog layout.
+    static const quint32 FORMAT_STRINGS = 0x53545231;   ///< Records are encoded string lists.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    BinaryCatalog();
+    /****************************************************************************/
+    /**
+     * \brief Destructor.
+     */
+    /****************************************************************************/
+    ~BinaryCatalog();
+    /****************************************************************************/
+    /**
+     * \brief Maps a catalog.
+     *
+     * \iparam  FileName        Path of the catalog.
+     * \iparam  Format          Expected format of the records.
+     * \iparam  SourceFileName  Path of the file the catalog was compiled from.
+     *
+     * \return  True if the catalog is intact and up to date.
+     */
+    /****************************************************************************/
+    bool Open(const QString &FileName, quint32 Format, const QString &SourceFileName);
+    /****************************************************************************/
+    /**
+     * \brief Unmaps the catalog.
+     *
+     * Records returned by Find are invalid afterwards.
+     */
+    /****************************************************************************/
+    void Close();
+    /****************************************************************************/
+    /**
+     * \brief Returns if a catalog is mapped.
+     *
+     * \return  True if open.
+     */
+    /****************************************************************************/
+    bool IsOpen() const {
+        return mp_Header != NULL;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Looks up a record.
+     *
+     * The record references the mapping, it is valid until the catalog is
+     * closed. Modifying it makes a copy.
+     *
+     * \iparam  Key     Key of the record.
+     * \oparam  Record  Record.
+     *
+     * \return  True if the record exists.
+     */
+    /****************************************************************************/
+    bool Find(quint32 Key, QByteArray &Record) const;
+    /****************************************************************************/
+    /**
+     * \brief Returns the keys of all records.
+     *
+     * \return  Keys, in no particular order.
+     */
+    /****************************************************************************/
+    QList<quint32> Keys() const;
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of records.
+     *
+     * \return  Number of records, 0 if not open.
+     */
+    /****************************************************************************/
+    int Count() const;
+    /****************************************************************************/
+    /**
+     * \brief Compiles records into a catalog.
+     *
+     * The catalog is written to a temporary file first, so an interrupted
+     * compilation does not leave a broken catalog behind.
+     *
+     * \iparam  FileName        Path of the catalog.
+     * \iparam  Format          Format of the records.
+     * \iparam  SourceFileName  Path of the file the records were read from.
+     * \iparam  Records         Records by key.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    static bool Compile(const QString &FileName, quint32 Format, const QString &SourceFileName,
+                        const QHash<quint32, QByteArray> &Records);
+    /****************************************************************************/
+    /**
+     * \brief Returns the catalog path for a source file.
+     *
+     * The catalog is placed beside the source, with the suffix ".cat".
+     *
+     * \iparam  SourceFileName  Path of the source file.
+     *
+     * \return  Path of the catalog.
+     */
+    /****************************************************************************/
+    static QString CatalogFileName(const QString &SourceFileName);
+    /****************************************************************************/
+    /**
+     * \brief Encodes a string list as record.
+     *
+     * The strings are stored as UTF-16, so decoding only copies them.
+     *
+     * \iparam  Strings     Strings to encode.
+     *
+     * \return  Record.
+     */
+    /****************************************************************************/
+    static QByteArray EncodeStrings(const QStringList &Strings);
+    /****************************************************************************/
+    /**
+     * \brief Decodes a record of EncodeStrings.
+     *
+     * \iparam  Record      Record.
+     * \oparam  Strings     Decoded strings.
+     *
+     * \return  True if the record is intact.
+     */
+    /****************************************************************************/
+    static bool DecodeStrings(const QByteArray &Record, QStringList &Strings);
+
+private:
+    /****************************************************************************/
+    /**
+     * \brief Header of a catalog file.
+     */
+    /****************************************************************************/
+    struct FileHeader {
+        quint32 Magic;          ///< Magic number, also detects another byte order.
+        quint32 Version;        ///< Version of the catalog layout.
+        quint32 Format;         ///< Format of the records.
+        quint32 Count;          ///< Number of records.
+        quint32 BucketCount;    ///< Number of hash buckets.
+        quint32 SlotCount;      ///< Number of slots.
+        quint32 DataSize;       ///< Size of the record data.
+        quint32 Checksum;       ///< Checksum over index and record data.
+        qint64  SourceSize;     ///< Size of the source file.
+        qint64  SourceModified; ///< Modification time of the source file [ms since epoch].
+    };
+    /****************************************************************************/
+    /**
+     * \brief Slot of the hash table.
+     */
+    /****************************************************************************/
+    struct Slot {
+        quint32 Key;        ///< Key of the record.
+        quint32 Offset;     ///< Offset of the record in the record data, EMPTY_SLOT if unused.
+        quint32 Size;       ///< Size of the record.
+    };
+
+    static const quint32 CATALOG_MAGIC = 0x48435442;    ///< Magic number of a catalog.
+    static const quint32 EMPTY_SLOT = 0xFFFFFFFF;       ///< Offset of an unused slot.
+    static const quint32 MAX_SEED = 0x100000;           ///< Seeds tried per bucket before compiling fails.
+
+    /****************************************************************************/
+    /*!
+     *  \brief Disable copy and assignment operator.
+     *
+     */
+    /****************************************************************************/
+    Q_DISABLE_COPY(BinaryCatalog)
+
+    /****************************************************************************/
+    /**
+     * \brief Hashes a key.
+     *
+     * \iparam  Key     Key.
+     * \iparam  Seed    Seed, 0 selects the bucket.
+     *
+     * \return  Hash value.
+     */
+    /****************************************************************************/
+    static quint32 Hash(quint32 Key, quint32 Seed);
+    /****************************************************************************/
+    /**
+     * \brief Computes the checksum over index and record data.
+     *
+     * \iparam  p_Data  Start of the index.
+     * \iparam  Size    Size of index and record data.
+     *
+     * \return  Checksum.
+     */
+    /****************************************************************************/
+    static quint32 Checksum(const char *p_Data, quint32 Size);
+    /****************************************************************************/
+    /**
+     * \brief Computes the seeds placing every key in its own slot.
+     *
+     * \iparam  Keys        Keys.
+     * \iparam  BucketCount Number of buckets.
+     * \iparam  SlotCount   Number of slots.
+     * \oparam  Seeds       Seed of each bucket.
+     * \oparam  SlotKeys    Index of the key in each slot, -1 if unused.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    static bool PlaceKeys(const QList<quint32> &Keys, quint32 BucketCount, quint32 SlotCount,
+                          QVector<quint32> &Seeds, QVector<int> &SlotKeys);
+
+    QFile               m_File;         ///< Catalog file, open while mapped.
+    const FileHeader    *mp_Header;     ///< Header in the mapping.
+    const quint32       *mp_Seeds;      ///< Seeds in the mapping.
+    const Slot          *mp_Slots;      ///< Slots in the mapping.
+    const char          *mp_Data;       ///< Record data in the mapping.
+}; // end class BinaryCatalog
+
+} // end namespace Global
+
+#endif // GLOBAL_BINARYCATALOG_H
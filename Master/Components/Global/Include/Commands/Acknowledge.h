@@ -23,6 +23,7 @@
 
 #include <Global/Include/SharedPointer.h>
 #include <Global/Include/GlobalDefines.h>
+#include <Global/Include/Commands/CommandTypeID.h>
 
 #include <QString>
 #include <QDataStream>
@@ -49,6 +50,8 @@ private:
      */
     /****************************************************************************/
     Q_DISABLE_COPY(Acknowledge)
+
+    mutable QAtomicInt  m_TypeID;   ///< Cached type ID.
 protected:
     /****************************************************************************/
     /**
@@ -94,6 +97,24 @@ public:
      */
     /****************************************************************************/
     virtual QString GetName() const = 0;
+    /****************************************************************************/
+    /**
+     * \brief Get the type ID of the acknowledge.
+     *
+     * The ID is resolved from the name on the first call, later calls
+     * return the cached ID without calling GetName.
+     *
+     * \return  Type ID of the acknowledge.
+     */
+    /****************************************************************************/
+    inline int GetTypeID() const {
+        int TypeID = m_TypeID.loadAcquire();
+        if (TypeID == CommandTypeID::INVALID) {
+            TypeID = CommandTypeID::Register(GetName());
+            m_TypeID.storeRelease(TypeID);
+        }
+        return TypeID;
+    }
 
     Global::tRefType m_Ref;     ///< Reference of command for which acknowledgment is sent
 }; // end class Acknowledge
@@ -22,6 +22,8 @@
 #define GLOBAL_COMMAND_H
 
 #include <Global/Include/SharedPointer.h>
+#include <Global/Include/IntrusivePointer.h>
+#include <Global/Include/Commands/CommandTypeID.h>
 
 #include <QString>
 #include <QDataStream>
@@ -40,10 +42,11 @@ namespace Global {
  * \warning This class is not thread safe!
  */
 /****************************************************************************/
-class Command {
+class Command : public RefCounted {
     friend class TestCommands;
 private:
     int     m_Timeout;  ///< Command timeout [ms]. NOTIMEOUT means that no acknowledge is required for this command!
+    mutable QAtomicInt  m_TypeID;   ///< Cached type ID, not copied.
     /****************************************************************************/
     Command();          ///< Not implemented.
     /****************************************************************************/
@@ -126,6 +129,24 @@ public:
     /****************************************************************************/
     virtual QString GetName() const = 0;
     /****************************************************************************/
+    /**
+     * \brief Get the type ID of the command.
+     *
+     * The ID is resolved from the name on the first call, later calls
+     * return the cached ID without calling GetName.
+     *
+     * \return  Type ID of the command.
+     */
+    /****************************************************************************/
+    inline int GetTypeID() const {
+        int TypeID = m_TypeID.loadAcquire();
+        if (TypeID == CommandTypeID::INVALID) {
+            TypeID = CommandTypeID::Register(GetName());
+            m_TypeID.storeRelease(TypeID);
+        }
+        return TypeID;
+    }
+    /****************************************************************************/
     /**
      * \brief Get command timeout.
      *
@@ -256,7 +277,13 @@ public:
     bool isStateAllowed(QString state);
 }; // end class Command
 
+// Define GLOBAL_INTRUSIVE_COMMAND_POINTER for all projects alike to count the
+// references in the command itself, see IntrusivePointer.
+#ifdef GLOBAL_INTRUSIVE_COMMAND_POINTER
+typedef Global::IntrusivePointer<Global::Command>   CommandShPtr_t;   ///< Typedef for shared pointer of command, counter in the command.
+#else
 typedef Global::SharedPointer<Global::Command>  CommandShPtr_t;   ///< Typedef for shared pointer of command.
+#endif
 
 } // end namespace Global
 
@@ -0,0 +1,183 @@
+/****************************************************************************/
+/*! \file Global/Include/Commands/CommandTypeID.h
+ *
+ *  \brief Definition file for classes CommandTypeID and CommandTypeTable.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_COMMANDTYPEID_H
+#define GLOBAL_COMMANDTYPEID_H
+
+#include <QAtomicInt>
+#include <QString>
+#include <QVector>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Dense integer IDs for command and acknowledge names.
+ *
+ * Every name gets the next free ID when it is registered the first time, so
+ * the IDs can index flat tables. The IDs are only valid within the running
+ * process, the network layer and the log files keep using the names.
+ *
+ * Registering is thread safe. The ID of a class is registered once and then
+ * kept in a function local static.
+ */
+/****************************************************************************/
+class CommandTypeID {
+
+public:
+    static const int INVALID = -1;  ///< ID of no type.
+
+    /****************************************************************************/
+    /**
+     * \brief Get the ID of a name, registers the name if needed.
+     *
+     * \iparam  Name    Command or acknowledge name.
+     *
+     * \return  ID of the name.
+     */
+    /****************************************************************************/
+    static int Register(const QString &Name);
+
+    /****************************************************************************/
+    /**
+     * \brief Get the name of an ID, for diagnostics.
+     *
+     * \iparam  TypeID  ID of the name.
+     *
+     * \return  Name, empty for an unknown ID.
+     */
+    /****************************************************************************/
+    static QString Name(int TypeID);
+
+    /****************************************************************************/
+    /**
+     * \brief Get the number of registered names.
+     *
+     * \return  Number of names, all IDs are below it.
+     */
+    /****************************************************************************/
+    static int Count();
+
+    /****************************************************************************/
+    /**
+     * \brief Get the ID of a command or acknowledge class.
+     *
+     * \return  ID of CmdClass::NAME.
+     */
+    /****************************************************************************/
+    template <class CmdClass>
+    static int Of() {
+        static const int TypeID = Register(CmdClass::NAME);
+        return TypeID;
+    }
+
+private:
+    CommandTypeID();    ///< Not implemented.
+}; // end class CommandTypeID
+
+/****************************************************************************/
+/**
+ * \brief Flat table indexed by command type ID.
+ *
+ * Replaces hashes keyed by command names for the routing and processing of
+ * commands. An entry not inserted returns the default value.
+ * \warning This class is not thread safe!
+ */
+/****************************************************************************/
+template <typename T>
+class CommandTypeTable {
+
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  Default     Value of the entries not inserted.
+     */
+    /****************************************************************************/
+    explicit CommandTypeTable(const T &Default = T()) :
+        m_Default(Default)
+    {
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Check if an entry was inserted.
+     *
+     * \iparam  TypeID  Command type ID.
+     *
+     * \return  True if inserted.
+     */
+    /****************************************************************************/
+    bool Contains(int TypeID) const {
+        return (TypeID >= 0) && (TypeID < m_Used.size()) && m_Used[TypeID];
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Insert or replace an entry.
+     *
+     * \iparam  TypeID  Command type ID.
+     * \iparam  Value   Value of the entry.
+     */
+    /****************************************************************************/
+    void Insert(int TypeID, const T &Value) {
+        if (TypeID < 0) {
+            return;
+        }
+        if (TypeID >= m_Values.size()) {
+            m_Values.resize(TypeID + 1);
+            m_Used.resize(TypeID + 1);
+        }
+        m_Values[TypeID] = Value;
+        m_Used[TypeID] = true;
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Get an entry.
+     *
+     * \iparam  TypeID  Command type ID.
+     *
+     * \return  Value of the entry, the default value if not inserted.
+     */
+    /****************************************************************************/
+    const T &Value(int TypeID) const {
+        return Contains(TypeID) ? m_Values[TypeID] : m_Default;
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Remove all entries.
+     */
+    /****************************************************************************/
+    void Clear() {
+        m_Values.clear();
+        m_Used.clear();
+    }
+
+private:
+    QVector<T>      m_Values;   ///< Values by type ID.
+    QVector<bool>   m_Used;     ///< Entries inserted by type ID.
+    T               m_Default;  ///< Value of the entries not inserted.
+}; // end class CommandTypeTable
+
+} // end namespace Global
+
+#endif // GLOBAL_COMMANDTYPEID_H
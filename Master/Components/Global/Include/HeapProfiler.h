@@ -0,0 +1,165 @@
+/****************************************************************************/
+/*! \file Global/Include/HeapProfiler.h
+ *
+ *  \brief Definition file for class HeapProfiler.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_HEAPPROFILER_H
+#define GLOBAL_HEAPPROFILER_H
+
+#include <QString>
+
+#include <stddef.h>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Sampling heap profiler.
+ *
+ * The profiler wraps malloc, calloc, realloc and free of the process, in
+ * builds with CONFIG+=heap_profiler only. While it is stopped, a wrapper
+ * only forwards the call. While it is running,
+ * every thread counts down the bytes it allocates and samples the
+ * allocation reaching zero, on average one per sample interval. The stack
+ * of a sampled allocation is recorded in a buffer of the thread, without
+ * taking a lock. The sampled address is kept in a lock free table, so the
+ * free of a sampled block is recorded as well.
+ *
+ * A writer thread collects the buffers and keeps the estimated live and
+ * allocated bytes per thread and per call site. It writes them to the
+ * profile file once per dump interval, so a file in the log directory is
+ * exported with the service logs.
+ *
+ * A sample stands for the allocations of its call site since the previous
+ * sample, the estimates are scaled accordingly. Call sites allocating much
+ * less than the sample interval in total may not show up at all.
+ *
+ * Start and Stop are not thread safe. All other functions are.
+ */
+/****************************************************************************/
+class HeapProfiler {
+    friend class TestHeapProfiler;
+
+public:
+    static const quint32 DEFAULT_SAMPLE_INTERVAL = 512 * 1024;  ///< Average bytes allocated between two samples.
+    static const int DEFAULT_DUMP_INTERVAL = 60;                ///< Time between two dumps [s].
+
+    /****************************************************************************/
+    /**
+     * \brief Starts sampling.
+     *
+     * \iparam  FileName        Path of the profile file.
+     * \iparam  SampleInterval  Average bytes allocated between two samples.
+     * \iparam  DumpInterval    Time between two dumps [s], 0 dumps only on
+     *                          request and on Stop.
+     *
+     * \return  True on success, false if running or not supported.
+     */
+    /****************************************************************************/
+    static bool Start(const QString &FileName, quint32 SampleInterval = DEFAULT_SAMPLE_INTERVAL,
+                      int DumpInterval = DEFAULT_DUMP_INTERVAL);
+    /****************************************************************************/
+    /**
+     * \brief Starts sampling if enabled by the environment.
+     *
+     * HEAP_PROFILE_INTERVAL sets the sample interval in bytes and enables
+     * the profiler. HEAP_PROFILE_DUMP_INTERVAL optionally sets the dump
+     * interval in seconds.
+     *
+     * \iparam  FileName    Path of the profile file.
+     *
+     * \return  True if started.
+     */
+    /****************************************************************************/
+    static bool StartFromEnvironment(const QString &FileName);
+    /****************************************************************************/
+    /**
+     * \brief Returns if the profiler is built in.
+     *
+     * Only builds with CONFIG+=heap_profiler on glibc wrap the allocator.
+     *
+     * \return  True if Start can succeed.
+     */
+    /****************************************************************************/
+    static bool IsAvailable();
+    /****************************************************************************/
+    /**
+     * \brief Stops sampling and writes the final profile.
+     */
+    /****************************************************************************/
+    static void Stop();
+    /****************************************************************************/
+    /**
+     * \brief Returns if sampling.
+     *
+     * \return  True if running.
+     */
+    /****************************************************************************/
+    static bool IsActive();
+    /****************************************************************************/
+    /**
+     * \brief Writes the profile file now.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    static bool Dump();
+    /****************************************************************************/
+    /**
+     * \brief Returns the estimated live bytes allocated since Start.
+     *
+     * \return  Estimated live bytes.
+     */
+    /****************************************************************************/
+    static qint64 LiveBytes();
+    /****************************************************************************/
+    /**
+     * \brief Returns the estimated bytes allocated since Start.
+     *
+     * \return  Estimated allocated bytes.
+     */
+    /****************************************************************************/
+    static qint64 AllocatedBytes();
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of samples lost because a buffer was full.
+     *
+     * \return  Number of lost samples.
+     */
+    /****************************************************************************/
+    static int DroppedSamples();
+
+private:
+    /****************************************************************************/
+    /*!
+     *  \brief Only static members, no instances.
+     *
+     */
+    /****************************************************************************/
+    HeapProfiler();
+    /****************************************************************************/
+    /*!
+     *  \brief Disable copy and assignment operator.
+     *
+     */
+    /****************************************************************************/
+    Q_DISABLE_COPY(HeapProfiler)
+}; // end class HeapProfiler
+
+} // end namespace Global
+
+#endif // GLOBAL_HEAPPROFILER_H
@@ -0,0 +1,276 @@
+/****************************************************************************/
+/*! \file Global/Include/IntrusivePointer.h
+ *
+ *  \brief Definition file for classes RefCounted and IntrusivePointer.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_INTRUSIVEPOINTER_H
+#define GLOBAL_INTRUSIVEPOINTER_H
+
+#include "Global/Include/SharedPointer.h"
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Base class for objects which carry their own reference counter.
+ *
+ * Copying an object does not copy its counter, the copy starts unreferenced.
+ */
+/****************************************************************************/
+class RefCounted {
+template<class ClassT> friend class IntrusivePointer;
+friend class TestSharedPointer;
+
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief   Default constructor.
+     *
+     ****************************************************************************/
+    inline RefCounted() : m_RefCounter(0) {}
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Copy constructor, the counter is not copied.
+     *
+     ****************************************************************************/
+    inline RefCounted(const RefCounted &) : m_RefCounter(0) {}
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Assignment operator, the counter is kept.
+     *
+     *  \return  Instance of this
+     *
+     ****************************************************************************/
+    inline const RefCounted & operator = (const RefCounted &) { return *this; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Destructor.
+     *
+     ****************************************************************************/
+    virtual ~RefCounted() {}
+
+private:
+    mutable QAtomicInt  m_RefCounter;   ///< Counter of pointee object users.
+};
+
+/****************************************************************************/
+/**
+ * \brief Reference-counting pointer to a RefCounted object.
+ *
+ * Same interface and thread safety as SharedPointer, but the counter is
+ * part of the object. So creating a pointer does not allocate a separate
+ * counter and a copy touches one cache line less. Two pointers created from
+ * the same raw pointer share the object correctly.
+ */
+/****************************************************************************/
+template<class ClassT> class IntrusivePointer {
+friend class TestSharedPointer;
+
+public:
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Default constructor.
+     *
+     ****************************************************************************/
+    inline IntrusivePointer() :
+        m_PointerToUserData(NULL)
+    {
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Constructor.
+     *
+     *  \param   UdPtr = pointer to user object
+     *
+     ****************************************************************************/
+    inline IntrusivePointer(ClassT* UdPtr) :
+        m_PointerToUserData(UdPtr)
+    {
+        if (m_PointerToUserData != NULL) {
+            (void)m_PointerToUserData->m_RefCounter.ref();
+        }
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Destructor.
+     *
+     *  Decrement refcount and delete pointer if needed.
+     *
+     ****************************************************************************/
+    virtual ~IntrusivePointer()
+    {
+        try {
+            NonsafeClear();
+        }
+        CATCHALL_DTOR();
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Copy Constructor.
+     *
+     *  \param   rOther = reference to other class instance.
+     *
+     ****************************************************************************/
+    inline IntrusivePointer(const IntrusivePointer &rOther) :
+        m_PointerToUserData(NULL)
+    {
+        PointerGuardLocker GetOtherGuard(rOther.m_Guard);
+        if (rOther.m_PointerToUserData != NULL) {
+            (void)rOther.m_PointerToUserData->m_RefCounter.ref();
+        }
+        m_PointerToUserData = rOther.m_PointerToUserData;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Assignment operator.
+     *
+     *  \param   rOther = reference to other class instance.
+     *  \return  Instance of this
+     *
+     ****************************************************************************/
+    const IntrusivePointer & operator = (const IntrusivePointer &rOther)
+    {
+        if(this != &rOther) {
+            ClassT *pTmp = NULL;
+            {
+                PointerGuardLocker GetOtherGuard(rOther.m_Guard);
+                if (rOther.m_PointerToUserData != NULL) {
+                    (void)rOther.m_PointerToUserData->m_RefCounter.ref();
+                }
+                pTmp = rOther.m_PointerToUserData;
+            }
+
+            {
+                PointerGuardLocker GetGuard(m_Guard);
+                NonsafeClear();
+                m_PointerToUserData = pTmp;
+            }
+        }
+
+        return *this;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Operator "->"
+     *  \return  ClassT*
+     *
+     ****************************************************************************/
+    ClassT* operator->() const
+    {
+        return m_PointerToUserData;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Get pointer to the tracked object.
+     * \return   ClassT*
+     *
+     ****************************************************************************/
+    ClassT* GetPointerToUserData() const
+    {
+        return m_PointerToUserData;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Pointer NULL check.
+     *
+     *  \return  True if the pointer is NULL.
+     *
+     ****************************************************************************/
+    bool IsNull() const
+    {
+        PointerGuardLocker GetGuard(m_Guard);
+        return (m_PointerToUserData == NULL);
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Equality operator.
+     *
+     *  \param[in]   rOther      Const reference to other.
+     *  \return                  True if same instance or same pointers.
+     */
+     /***************************************************************************/
+    bool operator == (const IntrusivePointer &rOther) const
+    {
+        if(this == &rOther) {
+            return true;
+        }
+        ClassT *pTmp = NULL;
+        {
+            PointerGuardLocker GetOtherGuard(rOther.m_Guard);
+            pTmp = rOther.m_PointerToUserData;
+        }
+        {
+            PointerGuardLocker GetGuard(m_Guard);
+            return m_PointerToUserData == pTmp;
+        }
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Set contained pointer to NULL.
+     *
+     * Decrement refcount and delete pointer if needed. This method is thread safe.
+     */
+     /***************************************************************************/
+    void Clear()
+    {
+        PointerGuardLocker GetGuard(m_Guard);
+        NonsafeClear();
+    }
+
+private:
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Set contained pointer to NULL.
+     *
+     * Decrement refcount and delete pointer if needed. This method is not thread safe
+     * and should be called only in a safe way.
+     */
+     /***************************************************************************/
+    void NonsafeClear()
+    {
+        if (m_PointerToUserData != NULL) {
+            if (!m_PointerToUserData->m_RefCounter.deref()) {
+                delete m_PointerToUserData;
+            }
+            m_PointerToUserData = NULL;
+        }
+    }
+
+private:
+
+    ClassT              *m_PointerToUserData;   ///< Pointer to user data
+    PointerGuard        m_Guard;                ///< Guard for thread safety.
+
+}; // end class IntrusivePointer
+
+} // end namespace Global
+
+#endif // GLOBAL_INTRUSIVEPOINTER_H
@@ -0,0 +1,178 @@
+/****************************************************************************/
+/*! \file Global/Include/LatencyHistogram.h
+ *
+ *  \brief Definition file for class LatencyHistogram
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_LATENCYHISTOGRAM_H
+#define GLOBAL_LATENCYHISTOGRAM_H
+
+#include <QAtomicInt>
+#include <QString>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Histogram of latencies with logarithmic buckets.
+ *
+ * Bucket 0 counts latencies below 1 us, bucket i the latencies from
+ * 2^(i-1) us up to 2^i us. The last bucket counts everything longer. So the
+ * histogram covers 1 us to more than an hour with a relative resolution of
+ * two.
+ *
+ * Recording is lock free and may be done from several threads. Reading
+ * while samples are recorded gives a consistent count per bucket, but not
+ * necessarily over all buckets.
+ */
+/****************************************************************************/
+class LatencyHistogram {
+
+public:
+    static const int LATENCYHISTOGRAM_BUCKETS = 32;     ///< Number of buckets.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    LatencyHistogram() {
+        Reset();
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Records a latency.
+     *
+     * \iparam  Latency     Latency in us, negative values count as 0.
+     */
+    /****************************************************************************/
+    void Record(qint64 Latency) {
+        int Bucket = 0;
+        while (Bucket < LATENCYHISTOGRAM_BUCKETS - 1 && Latency >= (Q_INT64_C(1) << Bucket)) {
+            Bucket++;
+        }
+        (void)m_Buckets[Bucket].fetchAndAddRelaxed(1);
+
+        int Value = static_cast<int>(qMin<qint64>(Latency, 0x7FFFFFFF));
+        int Max = m_Max.loadAcquire();
+        while (Value > Max && !m_Max.testAndSetOrdered(Max, Value)) {
+            Max = m_Max.loadAcquire();
+        }
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the count of a bucket.
+     *
+     * \iparam  Bucket      Bucket index.
+     *
+     * \return  Number of latencies recorded in the bucket.
+     */
+    /****************************************************************************/
+    int Count(int Bucket) const {
+        if (Bucket < 0 || Bucket >= LATENCYHISTOGRAM_BUCKETS) {
+            return 0;
+        }
+        return m_Buckets[Bucket].loadAcquire();
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of recorded latencies.
+     *
+     * \return  Sum of all buckets.
+     */
+    /****************************************************************************/
+    qint64 Total() const {
+        qint64 Total = 0;
+        for (int i = 0; i < LATENCYHISTOGRAM_BUCKETS; i++) {
+            Total += m_Buckets[i].loadAcquire();
+        }
+        return Total;
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the longest recorded latency.
+     *
+     * \return  Latency in us.
+     */
+    /****************************************************************************/
+    qint64 Max() const {
+        return m_Max.loadAcquire();
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the upper bound of a percentile.
+     *
+     * \iparam  Percent     Percentile, 1 to 100.
+     *
+     * \return  Longest latency of the bucket containing the percentile in us,
+     *          0 if nothing was recorded.
+     */
+    /****************************************************************************/
+    qint64 Percentile(int Percent) const {
+        qint64 Total = this->Total();
+        if (Total == 0) {
+            return 0;
+        }
+        qint64 Limit = (Total * Percent + 99) / 100;
+        qint64 Sum = 0;
+        for (int i = 0; i < LATENCYHISTOGRAM_BUCKETS - 1; i++) {
+            Sum += m_Buckets[i].loadAcquire();
+            if (Sum >= Limit) {
+                return (Q_INT64_C(1) << i) - 1;
+            }
+        }
+        return Max();
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Clears all buckets.
+     */
+    /****************************************************************************/
+    void Reset() {
+        for (int i = 0; i < LATENCYHISTOGRAM_BUCKETS; i++) {
+            (void)m_Buckets[i].fetchAndStoreOrdered(0);
+        }
+        (void)m_Max.fetchAndStoreOrdered(0);
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Summarizes the histogram for the log file.
+     *
+     * \return  Count, median, 99th percentile and maximum.
+     */
+    /****************************************************************************/
+    QString ToString() const {
+        return QString("n=%1 p50<=%2us p99<=%3us max=%4us")
+                .arg(Total()).arg(Percentile(50)).arg(Percentile(99)).arg(Max());
+    }
+
+private:
+    Q_DISABLE_COPY(LatencyHistogram)                        ///< Disable copy construction and assignment operations
+
+    QAtomicInt  m_Buckets[LATENCYHISTOGRAM_BUCKETS];        ///< Number of latencies per bucket.
+    QAtomicInt  m_Max;                                      ///< Longest latency in us.
+}; // end class LatencyHistogram
+
+} // end namespace Global
+
+#endif // GLOBAL_LATENCYHISTOGRAM_H
@@ -0,0 +1,226 @@
+/****************************************************************************/
+/*! \file Global/Include/PowerFailJournal.h
+ *
+ *  \brief Definition file for class PowerFailJournal.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_POWERFAILJOURNAL_H
+#define GLOBAL_POWERFAILJOURNAL_H
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Slots of the power fail journal.
+ */
+/****************************************************************************/
+enum PowerFailJournalSlot_t {
+    PFJ_SLOT_LOG_TAIL = 0,          ///< Latest log entries, which may not be on disk yet.
+    PFJ_SLOT_COUNT                  ///< Number of slots.
+};
+
+/****************************************************************************/
+/**
+ * \brief Memory mapped journal of the state needed after a power failure.
+ *
+ * The owners of the critical state stage it here whenever it changes. A
+ * staged record is only copied into the mapped file, nothing is written to
+ * disk. When the power fails, Commit writes all records to disk with a
+ * single msync. It does not allocate, lock or call into Qt, so it may be
+ * called from a real time thread or a signal handler.
+ *
+ * Every slot has two buffers. A record is staged into the buffer not
+ * holding the latest record, with a checksum and a sequence number. If
+ * the power fails while a record is staged, Load falls back to the
+ * previous record of the slot.
+ *
+ * Stage and Load are thread safe. Commit may run while another thread
+ * closes the journal, Close waits for it before the file is unmapped.
+ */
+/****************************************************************************/
+class PowerFailJournal {
+    friend class TestPowerFailJournal;
+
+public:
+    static const int PFJ_RECORD_SIZE = 4096;                        ///< Size of a record buffer, incl. header [bytes].
+    static const int PFJ_HEADER_SIZE = 16;                          ///< Size of the record header [bytes].
+    static const int PFJ_PAYLOAD_SIZE = PFJ_RECORD_SIZE - PFJ_HEADER_SIZE; ///< Maximum size of a record [bytes].
+
+    /****************************************************************************/
+    /**
+     * \brief Get reference to instance.
+     *
+     * \return      Reference to instance.
+     */
+    /****************************************************************************/
+    static PowerFailJournal &Instance() {
+        static PowerFailJournal     m_Instance;         ///< The instance.
+        return m_Instance;
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Maps the journal file.
+     *
+     * The file is created if it does not exist. Records of a previous run
+     * are kept, so they can be loaded. The mapping is locked into memory,
+     * so staging and committing do not cause page faults.
+     *
+     * \iparam  FileName    Path of the journal file.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    bool Open(const QString &FileName);
+    /****************************************************************************/
+    /**
+     * \brief Unmaps the journal file.
+     *
+     * Waits until a commit running in another thread has finished.
+     */
+    /****************************************************************************/
+    void Close();
+    /****************************************************************************/
+    /**
+     * \brief Returns if the journal file is mapped.
+     *
+     * \return  True if open.
+     */
+    /****************************************************************************/
+    bool IsOpen() const {
+        return mp_Map.load() != NULL;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Stages the latest record of a slot.
+     *
+     * The record only goes to the page cache. It is written to disk with
+     * the next Commit, or whenever the kernel writes back the page.
+     *
+     * \iparam  Slot        Slot of the record.
+     * \iparam  Record      Record, at most PFJ_PAYLOAD_SIZE bytes.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    bool Stage(PowerFailJournalSlot_t Slot, const QByteArray &Record);
+    /****************************************************************************/
+    /**
+     * \brief Writes all staged records to disk.
+     *
+     * Blocks until the journal is durable.
+     *
+     * \return  True on success.
+     */
+    /****************************************************************************/
+    bool Commit();
+    /****************************************************************************/
+    /**
+     * \brief Loads the latest intact record of a slot.
+     *
+     * \iparam  Slot        Slot of the record.
+     * \oparam  Record      Record.
+     *
+     * \return  True if the slot holds an intact record.
+     */
+    /****************************************************************************/
+    bool Load(PowerFailJournalSlot_t Slot, QByteArray &Record) const;
+
+private:
+    /****************************************************************************/
+    /**
+     * \brief Header of a record buffer.
+     */
+    /****************************************************************************/
+    struct RecordHeader {
+        quint32 Sequence;   ///< Sequence number of the record, 0 if unused.
+        quint32 Length;     ///< Length of the payload.
+        quint32 Checksum;   ///< Checksum over sequence, length and payload.
+        quint32 Reserved;   ///< Reserved, 0.
+    };
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    PowerFailJournal();
+    /****************************************************************************/
+    /**
+     * \brief Destructor.
+     */
+    /****************************************************************************/
+    ~PowerFailJournal();
+    /****************************************************************************/
+    /*!
+     *  \brief Disable copy and assignment operator.
+     *
+     */
+    /****************************************************************************/
+    Q_DISABLE_COPY(PowerFailJournal)
+
+    /****************************************************************************/
+    /**
+     * \brief Returns a record buffer.
+     *
+     * \iparam  Slot        Slot index.
+     * \iparam  Half        Buffer of the slot, 0 or 1.
+     *
+     * \return  Start of the buffer in the mapping.
+     */
+    /****************************************************************************/
+    char *Buffer(int Slot, int Half) const {
+        return mp_Map.load() + (Slot * 2 + Half) * PFJ_RECORD_SIZE;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Computes the checksum of a record.
+     *
+     * \iparam  p_Header    Record header.
+     * \iparam  p_Payload   Record payload.
+     *
+     * \return  Checksum.
+     */
+    /****************************************************************************/
+    static quint32 Checksum(const RecordHeader *p_Header, const char *p_Payload);
+    /****************************************************************************/
+    /**
+     * \brief Returns the buffer with the latest intact record of a slot.
+     *
+     * \iparam  Slot        Slot index.
+     *
+     * \return  Buffer index 0 or 1, -1 if there is no intact record.
+     */
+    /****************************************************************************/
+    int Latest(int Slot) const;
+
+    QAtomicPointer<char> mp_Map;                    ///< Mapped journal file.
+    int                 m_MapSize;                  ///< Size of the mapping [bytes].
+    int                 m_Fd;                       ///< File descriptor of the journal file.
+    QAtomicInt          m_Committers;               ///< Number of commits using the mapping.
+    QMutex              m_OpenMutex;                ///< Serializes Open and Close.
+    mutable QMutex      m_Mutex[PFJ_SLOT_COUNT];    ///< Serializes the writers of a slot.
+}; // end class PowerFailJournal
+
+} // end namespace Global
+
+#endif // GLOBAL_POWERFAILJOURNAL_H
@@ -21,54 +21,219 @@
 #ifndef PRIORITYQUEUE_H
 #define PRIORITYQUEUE_H
 
-#include <QMultiMap>
+#include <QVector>
 
 namespace Global {
 
 /****************************************************************************/
 /**
- * \brief A Simple priority Queue template, based on QMultimap
+ * \brief A Simple priority Queue template, based on a binary heap
  * \note Priority is based on Integer value. Higher the value, Higher
  *       the priority. If two (or more) items have same priority then,
- *       the last inserted among the two will be placed at top of queue.
+ *       the first inserted among them will be placed at top of queue.
+ *
+ * Top is O(1), Push, Pop and removing by handle are O(log n). Every Push
+ * returns a handle, which stays valid until the item leaves the queue.
  */
 /****************************************************************************/
 template <typename T>
 class PriorityQueue {
 
+public:
+    typedef quint64 Handle_t;                   //!< Handle of a queued item
+    static const Handle_t INVALID_HANDLE = 0;   //!< Handle never returned by Push
+
 private:
-    QMultiMap <int, T> m_Element;           //!< Queue Element
+    /****************************************************************************/
+    /** \brief Queued item
+     */
+    /****************************************************************************/
+    struct Entry {
+        int     Priority;   //!< Priority of the item
+        quint64 Sequence;   //!< Insertion order, for FIFO order within a priority
+        int     Slot;       //!< Slot of the handle
+        T       Item;       //!< The item
+    };
+
+    /****************************************************************************/
+    /** \brief Maps a handle to the position of its item in the heap
+     */
+    /****************************************************************************/
+    struct Slot {
+        int     Position;   //!< Position in the heap, -1 if free
+        quint32 Generation; //!< Incremented when the slot is freed
+    };
+
+    QVector<Entry> m_Heap;                  //!< Heap of the queued items
+    QVector<Slot> m_Slots;                  //!< Slots of the handles
+    QVector<int> m_FreeSlots;               //!< Free slots
+    quint64 m_Sequence;                     //!< Sequence number of the next item
     Q_DISABLE_COPY(PriorityQueue)          //!< Disable copy construction and assignment operations
 
+    /****************************************************************************/
+    /** \brief Returns true if the first entry has to be popped before the second
+     */
+    /****************************************************************************/
+    static bool IsBefore(const Entry &First, const Entry &Second) {
+        return (First.Priority > Second.Priority) ||
+               ((First.Priority == Second.Priority) && (First.Sequence < Second.Sequence));
+    }
+
+    /****************************************************************************/
+    /** \brief Stores an entry at a heap position
+     */
+    /****************************************************************************/
+    void Place(int Position, const Entry &NewEntry) {
+        m_Heap[Position] = NewEntry;
+        m_Slots[NewEntry.Slot].Position = Position;
+    }
+
+    /****************************************************************************/
+    /** \brief Moves an entry up to its place
+     *  \return Final position of the entry
+     */
+    /****************************************************************************/
+    int SiftUp(int Position) {
+        Entry Moved = m_Heap[Position];
+        while (Position > 0) {
+            int Parent = (Position - 1) / 2;
+            if (!IsBefore(Moved, m_Heap[Parent])) {
+                break;
+            }
+            Place(Position, m_Heap[Parent]);
+            Position = Parent;
+        }
+        Place(Position, Moved);
+        return Position;
+    }
+
+    /****************************************************************************/
+    /** \brief Moves an entry down to its place
+     */
+    /****************************************************************************/
+    void SiftDown(int Position) {
+        Entry Moved = m_Heap[Position];
+        int Count = m_Heap.size();
+        for (;;) {
+            int Child = 2 * Position + 1;
+            if (Child >= Count) {
+                break;
+            }
+            if ((Child + 1 < Count) && IsBefore(m_Heap[Child + 1], m_Heap[Child])) {
+                Child++;
+            }
+            if (!IsBefore(m_Heap[Child], Moved)) {
+                break;
+            }
+            Place(Position, m_Heap[Child]);
+            Position = Child;
+        }
+        Place(Position, Moved);
+    }
+
+    /****************************************************************************/
+    /** \brief Removes the entry at a heap position and frees its handle
+     */
+    /****************************************************************************/
+    void RemoveAt(int Position) {
+        Slot &Freed = m_Slots[m_Heap[Position].Slot];
+        Freed.Position = -1;
+        Freed.Generation++;
+        m_FreeSlots.append(m_Heap[Position].Slot);
+
+        int Last = m_Heap.size() - 1;
+        if (Position != Last) {
+            Place(Position, m_Heap[Last]);
+        }
+        m_Heap.resize(Last);
+        if (Position < Last) {
+            if (SiftUp(Position) == Position) {
+                SiftDown(Position);
+            }
+        }
+    }
+
+    /****************************************************************************/
+    /** \brief Returns the heap position of a handle
+     *  \return Position, -1 if the item is not queued any more
+     */
+    /****************************************************************************/
+    int PositionOf(Handle_t Handle) const {
+        int Index = static_cast<int>(Handle & 0xFFFFFFFF);
+        quint32 Generation = static_cast<quint32>(Handle >> 32);
+        if ((Index < 0) || (Index >= m_Slots.size()) || (m_Slots[Index].Generation != Generation)) {
+            return -1;
+        }
+        return m_Slots[Index].Position;
+    }
+
 public:
     /****************************************************************************/
     /** \brief Constructor. Clears the queue.
      */
     /****************************************************************************/
-    PriorityQueue() {
-        m_Element.clear();
+    PriorityQueue() : m_Sequence(0) {
     }
 
     /****************************************************************************/
     /** \brief Push an item in to the queue
      *  \iparam Priority = Priority of the item
      *  \iparam Item = Item to Insert
+     *  \return Handle of the item
      */
     /****************************************************************************/
-    void Push(int Priority, T &Item) {
-        m_Element.insertMulti(Priority, Item);
+    Handle_t Push(int Priority, const T &Item) {
+        int Index;
+        if (m_FreeSlots.isEmpty()) {
+            Index = m_Slots.size();
+            Slot NewSlot;
+            NewSlot.Position = -1;
+            NewSlot.Generation = 1;
+            m_Slots.append(NewSlot);
+        }
+        else {
+            Index = m_FreeSlots.last();
+            m_FreeSlots.resize(m_FreeSlots.size() - 1);
+        }
+        Entry NewEntry;
+        NewEntry.Priority = Priority;
+        NewEntry.Sequence = m_Sequence++;
+        NewEntry.Slot = Index;
+        NewEntry.Item = Item;
+        m_Heap.append(NewEntry);
+        m_Slots[Index].Position = m_Heap.size() - 1;
+        (void)SiftUp(m_Heap.size() - 1);
+        return (static_cast<Handle_t>(m_Slots[Index].Generation) << 32) | static_cast<Handle_t>(Index);
     }
 
     /****************************************************************************/
     /** \brief Returns the element at the top of the queue
+     *  \note The queue must not be empty
      */
     /****************************************************************************/
     T Top() const {
-        //Keys in Multimap are in ascending order, hence last key is the
-        //one with highest priority
-        int key = m_Element.keys().last();
-        //return m_Element.value(key);
-        return m_Element.values(key).last();
+        Q_ASSERT(!IsEmpty());
+        return m_Heap.first().Item;
+    }
+
+    /****************************************************************************/
+    /** \brief Returns the priority of the element at the top of the queue
+     *  \note The queue must not be empty
+     */
+    /****************************************************************************/
+    int TopPriority() const {
+        Q_ASSERT(!IsEmpty());
+        return m_Heap.first().Priority;
+    }
+
+    /****************************************************************************/
+    /** \brief Removes the element at the top of the queue
+     */
+    /****************************************************************************/
+    void Pop() {
+        if (!IsEmpty()) {
+            RemoveAt(0);
+        }
     }
 
     /****************************************************************************/
@@ -76,18 +241,50 @@ public:
      */
     /****************************************************************************/
     bool IsEmpty() const {
-        return m_Element.isEmpty();
+        return m_Heap.isEmpty();
+    }
+
+    /****************************************************************************/
+    /** \brief Returns True if the item of a handle is still queued
+     *  \iparam Handle = Handle returned by Push
+     */
+    /****************************************************************************/
+    bool Contains(Handle_t Handle) const {
+        return PositionOf(Handle) >= 0;
+    }
+
+    /****************************************************************************/
+    /** \brief Remove an item from the queue by its handle
+     *  \iparam Handle = Handle returned by Push
+     *  \return True if the item was still queued
+     */
+    /****************************************************************************/
+    bool Remove(Handle_t Handle) {
+        int Position = PositionOf(Handle);
+        if (Position < 0) {
+            return false;
+        }
+        RemoveAt(Position);
+        return true;
     }
 
     /****************************************************************************/
     /** \brief Remove an item in from the queue
+     *  \note  Searches the whole queue and needs T::operator==, prefer the
+     *         removal by handle.
      *  \iparam Priority = Priority of the item to remove
      *  \iparam Item = Item to remove
      */
     /****************************************************************************/
-    void Remove(int Priority, T &Item) {
-        if (!IsEmpty()) {
-            m_Element.remove(Priority, Item);
+    void Remove(int Priority, const T &Item) {
+        QVector<int> Matches;
+        for (int Position = 0; Position < m_Heap.size(); Position++) {
+            if ((m_Heap[Position].Priority == Priority) && (m_Heap[Position].Item == Item)) {
+                Matches.append(m_Heap[Position].Slot);
+            }
+        }
+        for (int i = 0; i < Matches.size(); i++) {
+            RemoveAt(m_Slots[Matches[i]].Position);
         }
     }
 
@@ -96,7 +293,7 @@ public:
      */
     /****************************************************************************/
     int Size() const {
-        return m_Element.size();
+        return m_Heap.size();
     }
 
     /****************************************************************************/
@@ -104,11 +301,20 @@ public:
      */
     /****************************************************************************/
     void Clear() {
-        m_Element.clear();
+        for (int Position = 0; Position < m_Heap.size(); Position++) {
+            Slot &Freed = m_Slots[m_Heap[Position].Slot];
+            Freed.Position = -1;
+            Freed.Generation++;
+            m_FreeSlots.append(m_Heap[Position].Slot);
+        }
+        m_Heap.clear();
     }
 
 };
 
+template <typename T>
+const typename PriorityQueue<T>::Handle_t PriorityQueue<T>::INVALID_HANDLE;
+
 } // EONS Global
 
 #endif // PRIORITYQUEUE_H
@@ -26,6 +26,7 @@
 
 #include <QMutex>
 #include <QAtomicInt>
+#include <QThread>
 
 // Inform Lint about cleanup functions:
 //
@@ -35,6 +36,94 @@
 
 namespace Global {
 
+/****************************************************************************/
+/**
+ * \brief Guard of a single pointer instance.
+ *
+ * Protects the few instructions which read or replace the pointer of an
+ * instance while another thread may replace it. Unlike a QMutex it is a
+ * single atomic exchange and a store, without a locker object. It spins
+ * briefly and then sleeps, so a preempted owner can finish.
+ */
+/****************************************************************************/
+class PointerGuard {
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief   Constructor.
+     *
+     ****************************************************************************/
+    inline PointerGuard() : m_Locked(0) {}
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Lock the guard.
+     *
+     ****************************************************************************/
+    inline void Lock() const
+    {
+        int Tries = 0;
+        while (!m_Locked.testAndSetAcquire(0, 1)) {
+            if (++Tries < 100) {
+                QThread::yieldCurrentThread();
+            }
+            else {
+                QThread::usleep(50);
+            }
+        }
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Unlock the guard.
+     *
+     ****************************************************************************/
+    inline void Unlock() const
+    {
+        m_Locked.storeRelease(0);
+    }
+
+private:
+    Q_DISABLE_COPY(PointerGuard)
+
+    mutable QAtomicInt  m_Locked;   ///< 1 while locked.
+};
+
+/****************************************************************************/
+/**
+ * \brief Locks a PointerGuard for the lifetime of the locker.
+ */
+/****************************************************************************/
+class PointerGuardLocker {
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief   Constructor, locks the guard.
+     *
+     *  \param   rGuard = guard to lock
+     *
+     ****************************************************************************/
+    inline explicit PointerGuardLocker(const PointerGuard &rGuard) : m_rGuard(rGuard)
+    {
+        m_rGuard.Lock();
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief   Destructor, unlocks the guard.
+     *
+     ****************************************************************************/
+    inline ~PointerGuardLocker()
+    {
+        m_rGuard.Unlock();
+    }
+
+private:
+    Q_DISABLE_COPY(PointerGuardLocker)
+
+    const PointerGuard  &m_rGuard;  ///< The locked guard.
+};
+
 /****************************************************************************/
 /**
  * \brief Base class for thread-safe reference-counting pointers.
@@ -193,7 +282,7 @@ public:
       m_PointerToRefCounter(NULL)
     {
         // lock other object:
-        QMutexLocker GetOtherGuard(&(rOther.m_GuardMutex));
+        PointerGuardLocker GetOtherGuard(rOther.m_Guard);
         // increment reference count
         if(rOther.m_PointerToRefCounter != NULL) {
             rOther.m_PointerToRefCounter->IncrementRefCounter();
@@ -217,7 +306,7 @@ public:
             PointerRefCounter   *pTmp = NULL;
             {
                 // lock other object:
-                QMutexLocker GetOtherGuard(&(rOther.m_GuardMutex));
+                PointerGuardLocker GetOtherGuard(rOther.m_Guard);
                 // increment reference count
                 if(rOther.m_PointerToRefCounter != NULL) {
                     rOther.m_PointerToRefCounter->IncrementRefCounter();
@@ -227,7 +316,7 @@ public:
             }
 
             {
-                QMutexLocker GetGuard(&m_GuardMutex);
+                PointerGuardLocker GetGuard(m_Guard);
                 // First of all try to clear own instance
                 NonsafeClear();
                 // now copy object
@@ -276,7 +365,7 @@ public:
     bool IsNull() const
     {
         // lock object
-        QMutexLocker GetGuard(&m_GuardMutex);
+        PointerGuardLocker GetGuard(m_Guard);
         if (m_PointerToRefCounter == NULL) {
             return true;
         }
@@ -300,12 +389,12 @@ public:
         }
         PointerRefCounter *pTmp = NULL;
         {
-            QMutexLocker GetOtherGuard(&(rOther.m_GuardMutex));
+            PointerGuardLocker GetOtherGuard(rOther.m_Guard);
             pTmp = rOther.m_PointerToRefCounter;
         }
         // now lock objects
         {
-            QMutexLocker GetGuard(&m_GuardMutex);
+            PointerGuardLocker GetGuard(m_Guard);
             // compare pointers. Comparing pointer to refcounters should be enaugh.
             return m_PointerToRefCounter == pTmp;
         }
@@ -321,7 +410,7 @@ public:
     void Clear()
     {
         // now lock object
-        QMutexLocker GetGuard(&m_GuardMutex);
+        PointerGuardLocker GetGuard(m_Guard);
         // call nonsafe clear
         NonsafeClear();
     }
@@ -355,7 +444,7 @@ private:
 private:
 
     PointerRefCounter   *m_PointerToRefCounter; ///< Pointer to user data
-    mutable QMutex      m_GuardMutex;           ///< Guard Mutex for thread safety.
+    PointerGuard        m_Guard;                ///< Guard for thread safety.
 
 }; // end class SharedPointer
 
@@ -0,0 +1,227 @@
+/****************************************************************************/
+/*! \file Global/Include/TimerWheel.h
+ *
+ *  \brief Definition file for class TimerWheel
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef GLOBAL_TIMERWHEEL_H
+#define GLOBAL_TIMERWHEEL_H
+
+#include <QList>
+#include <QtGlobal>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Hierarchical timing wheel for many deadlines on one timer.
+ *
+ * Items are stored by value with their deadline. The deadlines are rounded
+ * up to the resolution of the wheel. The first level holds the deadlines of
+ * the next TIMERWHEEL_SLOTS ticks, every further level covers
+ * TIMERWHEEL_SLOTS times the range of the level below. When the first level
+ * wraps around, the due slot of the next level is moved down. Scheduling and
+ * expiring an item is O(1), independent of the number of items.
+ *
+ * Items are not removed when they become obsolete. The owner checks an
+ * expired item, e.g. if the command it refers to is still pending, and
+ * ignores it otherwise. So the items should be references like IDs or
+ * handles, not the objects themselves.
+ *
+ * The time is passed in by the caller in ms, the wheel does not read a clock
+ * itself. It is not thread safe.
+ */
+/****************************************************************************/
+template <typename T>
+class TimerWheel {
+
+public:
+    static const int TIMERWHEEL_BITS = 6;                           ///< Bits of a tick per level.
+    static const int TIMERWHEEL_SLOTS = 1 << TIMERWHEEL_BITS;       ///< Slots per level.
+    static const int TIMERWHEEL_LEVELS = 4;                         ///< Number of levels.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  Resolution  Length of a tick in ms.
+     * \iparam  Now         Current time in ms.
+     */
+    /****************************************************************************/
+    TimerWheel(qint64 Resolution, qint64 Now) :
+        m_Resolution(qMax<qint64>(Resolution, 1)),
+        m_Current(Now / m_Resolution),
+        m_Count(0)
+    {
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Schedules an item.
+     *
+     * Deadlines in the past expire with the next tick. Deadlines beyond the
+     * range of the wheel are limited to its range.
+     *
+     * \iparam  Item        Item to schedule.
+     * \iparam  Deadline    Time the item expires in ms.
+     */
+    /****************************************************************************/
+    void Schedule(const T &Item, qint64 Deadline) {
+        qint64 Tick = (Deadline + m_Resolution - 1) / m_Resolution;
+        Insert(Entry(Item, qMax(Tick, m_Current + 1)));
+        m_Count++;
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Advances the wheel to the current time.
+     *
+     * \iparam  Now         Current time in ms.
+     * \oparam  Expired     The expired items are appended.
+     */
+    /****************************************************************************/
+    void Advance(qint64 Now, QList<T> &Expired) {
+        qint64 Target = Now / m_Resolution;
+        if (m_Count == 0) {
+            m_Current = qMax(m_Current, Target);
+            return;
+        }
+        while (m_Current < Target) {
+            m_Current++;
+            // move the due slots of the upper levels down, when a level wraps around
+            for (int Level = 1; Level < TIMERWHEEL_LEVELS; Level++) {
+                if ((m_Current & ((Q_INT64_C(1) << (TIMERWHEEL_BITS * Level)) - 1)) != 0) {
+                    break;
+                }
+                QList<Entry> Cascade;
+                Cascade.swap(m_Slots[Level][SlotIndex(m_Current, Level)]);
+                for (int i = 0; i < Cascade.count(); i++) {
+                    Insert(Cascade[i]);
+                }
+            }
+            QList<Entry> &Slot = m_Slots[0][SlotIndex(m_Current, 0)];
+            for (int i = 0; i < Slot.count(); i++) {
+                Expired.append(Slot[i].Item);
+            }
+            m_Count -= Slot.count();
+            Slot.clear();
+            if (m_Count == 0) {
+                m_Current = Target;
+            }
+        }
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the time until Advance has to be called next.
+     *
+     * \iparam  Now         Current time in ms.
+     *
+     * \return  Time in ms, -1 if no item is scheduled.
+     */
+    /****************************************************************************/
+    qint64 NextTimeout(qint64 Now) const {
+        if (m_Count == 0) {
+            return -1;
+        }
+        qint64 Tick = m_Current + 1;
+        for (; (Tick & (TIMERWHEEL_SLOTS - 1)) != 0; Tick++) {
+            if (!m_Slots[0][SlotIndex(Tick, 0)].isEmpty()) {
+                break;
+            }
+        }
+        // Tick is the next non empty slot or the next cascade of the upper levels
+        return qMax<qint64>(Tick * m_Resolution - Now, 0);
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of scheduled items.
+     *
+     * \return  Number of items, including obsolete ones.
+     */
+    /****************************************************************************/
+    int Count() const {
+        return m_Count;
+    }
+
+private:
+    /****************************************************************************/
+    /**
+     * \brief Scheduled item.
+     */
+    /****************************************************************************/
+    struct Entry {
+        T       Item;       ///< Scheduled item.
+        qint64  Tick;       ///< Deadline in ticks.
+        /****************************************************************************/
+        /**
+         * \brief Constructor.
+         *
+         * \iparam  NewItem     Scheduled item.
+         * \iparam  NewTick     Deadline in ticks.
+         */
+        /****************************************************************************/
+        Entry(const T &NewItem, qint64 NewTick) : Item(NewItem), Tick(NewTick) {}
+    };
+
+    /****************************************************************************/
+    /**
+     * \brief Returns the slot of a tick in a level.
+     *
+     * \iparam  Tick        Tick.
+     * \iparam  Level       Level.
+     *
+     * \return  Slot index.
+     */
+    /****************************************************************************/
+    static int SlotIndex(qint64 Tick, int Level) {
+        return static_cast<int>((Tick >> (TIMERWHEEL_BITS * Level)) & (TIMERWHEEL_SLOTS - 1));
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Inserts an entry into the level covering its deadline.
+     *
+     * \iparam  NewEntry    Entry to insert.
+     */
+    /****************************************************************************/
+    void Insert(const Entry &NewEntry) {
+        qint64 Delta = NewEntry.Tick - m_Current;
+        int Level = 0;
+        while (Level < TIMERWHEEL_LEVELS - 1 && Delta >= (Q_INT64_C(1) << (TIMERWHEEL_BITS * (Level + 1)))) {
+            Level++;
+        }
+        qint64 Tick = NewEntry.Tick;
+        qint64 Range = Q_INT64_C(1) << (TIMERWHEEL_BITS * (Level + 1));
+        if (Delta >= Range) {
+            // beyond the range of the wheel
+            Tick = m_Current + Range - 1;
+        }
+        m_Slots[Level][SlotIndex(Tick, Level)].append(Entry(NewEntry.Item, Tick));
+    }
+
+    Q_DISABLE_COPY(TimerWheel)                              ///< Disable copy construction and assignment operations
+
+    qint64      m_Resolution;                               ///< Length of a tick in ms.
+    qint64      m_Current;                                  ///< Current tick.
+    int         m_Count;                                    ///< Number of scheduled items.
+    QList<Entry> m_Slots[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS]; ///< Slots of all levels.
+}; // end class TimerWheel
+
+} // end namespace Global
+
+#endif // GLOBAL_TIMERWHEEL_H
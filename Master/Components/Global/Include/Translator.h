@@ -23,9 +23,11 @@
 
 #include <Global/Include/GlobalDefines.h>
 #include <Global/Include/TranslatableString.h>
+#include <Global/Include/BinaryCatalog.h>
 
 #include <QHash>
 #include <QReadWriteLock>
+#include <QSharedPointer>
 #include <QLocale>
 #include <QStringList>
 
@@ -33,6 +35,7 @@ namespace Global {
 
 typedef QHash<quint32,  QStringList>            tLanguageData;  ///< Typedef for translations for one language.
 typedef QHash<QLocale::Language, tLanguageData> tTranslations;  ///< Typedef for translations for all data.
+typedef QSharedPointer<const BinaryCatalog>     tLanguageCatalog;   ///< Typedef for a string catalog of one language.
 
 /****************************************************************************/
 /**
@@ -49,6 +52,7 @@ private:
     QLocale::Language       m_DefaultLanguage;      ///< Try to translate to this language by default.
     QLocale::Language       m_FallbackLanguage;     ///< If language for translation not found, try to translate to this language.
     tTranslations           m_Translations;         ///< Translations for all loaded languages.
+    QHash<QLocale::Language, tLanguageCatalog>  m_Catalogs; ///< String catalogs of the languages not in m_Translations.
     mutable QReadWriteLock  m_SyncObject;           ///< Synchronisation object.
     /****************************************************************************/
     /****************************************************************************/
@@ -88,6 +92,26 @@ private:
      */
     /****************************************************************************/
     void InsertArguments(QString &rString, const QStringList &ArgumentList, const bool ChopArguments) const;
+    /****************************************************************************/
+    /**
+     * \brief Check if strings of a language are loaded.
+     *
+     * \iparam   TheLanguage     The language.
+     * \return                      True if loaded as language data or catalog.
+     */
+    /****************************************************************************/
+    bool HasLanguage(QLocale::Language TheLanguage) const;
+    /****************************************************************************/
+    /**
+     * \brief Get the strings of a string ID.
+     *
+     * \iparam   TheLanguage     The language, must be loaded.
+     * \iparam   StringID        ID of the strings.
+     * \oparam   rStrings        The strings.
+     * \return                      True if found.
+     */
+    /****************************************************************************/
+    bool FindStrings(QLocale::Language TheLanguage, quint32 StringID, QStringList &rStrings) const;
 
 protected:
 public:
@@ -127,6 +151,22 @@ public:
     void SetLanguageData(QLocale::Language TheLanguage, const tLanguageData &LanguageData,
                          bool SetAsDefaultLanguage, bool SetAsFallbackLanguage);
     /****************************************************************************/
+    /**
+     * \brief Set a string catalog as language data.
+     *
+     * Same as SetLanguageData, but the strings are looked up in the catalog
+     * (see BinaryCatalog::EncodeStrings) instead of being held in memory.
+     * The catalog may be shared between translators.
+     *
+     * \iparam   TheLanguage             The language to set.
+     * \iparam   Catalog                 Open string catalog for the specific language.
+     * \iparam   SetAsDefaultLanguage    If true, the default language will be set to this language.
+     * \iparam   SetAsFallbackLanguage   If true, the fallback language will be set to this language.
+     */
+    /****************************************************************************/
+    void SetLanguageCatalog(QLocale::Language TheLanguage, const tLanguageCatalog &Catalog,
+                            bool SetAsDefaultLanguage, bool SetAsFallbackLanguage);
+    /****************************************************************************/
     /**
      * \brief Remove specific language data.
      *
@@ -234,6 +274,8 @@ public:
     /**
        * \brief Get Translations.
        *
+       * Languages set as string catalog are not included.
+       *
        * \return  Translations.
        */
     /****************************************************************************/
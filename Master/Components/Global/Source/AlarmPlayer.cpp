@@ -22,18 +22,20 @@
 #include <Global/Include/SystemPaths.h>
 #include <Global/Include/EventObject.h>
 
+#include <QProcess>
+
+#include <math.h>
 
 namespace Global {
 
 const quint32  MAX_VOLUME = 9;       //!< MAX volume of alarm
+const double   MIN_VOLUME_DB = -18.0;   //!< Gain of volume 0, the former 64% of the PCM mixer [dB]
 
 AlarmPlayer::AlarmPlayer()
     : QObject(0)
     , m_volumeError(2)
     , m_volumeWarning(0)
     , m_volumeInfo(0)
-    , m_processPlay(NULL)
-    , m_processSetVolume(NULL)
     , m_Mutex(QMutex::Recursive)
 {
     qRegisterMetaType<Global::AlarmType>("Global::AlarmType");
@@ -87,6 +89,25 @@ void AlarmPlayer::setSoundFile(Global::AlarmType alarmType, QString fileName)
 
     QMutexLocker Lock(&m_Mutex);
     m_soundList.insert(alarmType, fileName);
+    // decode now, not when the alarm is raised
+    StartEngine();
+    if (!m_Engine.LoadSound(fileName)) {
+        qDebug() << "AlarmPlayer cannot load" << fileName;
+    }
+}
+
+void AlarmPlayer::StartEngine()
+{
+    if (m_Engine.IsRunning()) {
+        return;
+    }
+    if (!m_Engine.Start(new AudioDeviceSink())) {
+        qDebug() << "AlarmPlayer: no sound device, alarms are not audible";
+        (void)m_Engine.Start(new AudioNullSink());
+        return;
+    }
+    // the volume of an alarm is applied by the engine
+    (void)QProcess::execute("amixer set PCM 100%");
 }
 
 void AlarmPlayer::setSoundNumber(Global::AlarmType alarmType, int number)
@@ -140,32 +161,22 @@ void AlarmPlayer::emitAlarm(Global::AlarmType alarmType, bool UsePresetValues, Q
     if (volume > MAX_VOLUME)
         volume = MAX_VOLUME;
 
-    double volumeRatio = ((float)volume + 1.0) * 0.04000 + 0.60000;
-    double volumeLevel = volumeRatio * 100.0;
-    //double volumeLevel = ((UsePresetValues) ? (((float)ActiveVolume/(float)MAX_VOLUME) * 100) : ((Volume/(float)MAX_VOLUME ) * 100));
-
-    QString SetVolume= "amixer set PCM " + QString::number(volumeLevel) +"%";
-    if (!m_processSetVolume) {
-        m_processSetVolume = new QProcess();
-    }
-    m_processSetVolume->start(SetVolume);
-    m_processSetVolume->waitForFinished();
+    // equal steps in dB from MIN_VOLUME_DB at volume 0 up to 0 dB at MAX_VOLUME
+    double volumeDb = MIN_VOLUME_DB * (MAX_VOLUME - volume) / MAX_VOLUME;
+    double volumeRatio = pow(10.0, volumeDb / 20.0);
 
     QString soundFile = ((UsePresetValues) ? m_soundList.value(alarmType) : Filename);
 
-    if (!m_processPlay) {
-        m_processPlay = new QProcess();
+    {
+        QMutexLocker Lock(&m_Mutex);
+        StartEngine();
     }
-    else {
-        if (m_processPlay->state() == QProcess::Running) {
-            m_processPlay->kill();
-            m_processPlay->waitForFinished();
-        }
+    if (!m_Engine.LoadSound(soundFile)) {
+        Global::EventObject::Instance().RaiseEvent(EVENT_ALARM_SOUND_MISSING);
+        return;
     }
-
-    QString program = "ogg123 " + soundFile;
-    m_processPlay->start(program);
-    m_processPlay->waitForFinished();
+    // mixed in by the engine, returns at once
+    (void)m_Engine.Play(soundFile, qRound(volumeRatio * AudioEngine::MAX_VOLUME));
 }
 
 void AlarmPlayer::PlayAlarm(Global::AlarmType AlarmTypeVal)
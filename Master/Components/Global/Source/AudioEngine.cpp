@@ -0,0 +1,391 @@
+/****************************************************************************/
+/*! \file Global/Source/AudioEngine.cpp
+ *
+ *  \brief Implementation file for class AudioEngine.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <Global/Include/AudioEngine.h>
+
+#include <QDebug>
+#include <QFile>
+#include <QProcess>
+#include <QThread>
+#include <QtEndian>
+
+#include <string.h>
+
+namespace Global {
+
+const int DECODER_TIMEOUT = 10000;      //!< Longest time to convert a sound file [ms].
+const int SINK_RETRY_MAX_DELAY = 1000;  //!< Longest wait before writing to a failed sink again [ms].
+
+const int AudioEngine::DEFAULT_SAMPLE_RATE;
+const int AudioEngine::DEFAULT_PERIOD_FRAMES;
+const int AudioEngine::CHANNELS;
+const int AudioEngine::MAX_VOICES;
+const int AudioEngine::MAX_VOLUME;
+
+/****************************************************************************/
+/**
+ * \brief Thread mixing the voices of an AudioEngine into its sink.
+ */
+/****************************************************************************/
+class AudioMixerThread : public QThread {
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  Engine  The engine.
+     */
+    /****************************************************************************/
+    explicit AudioMixerThread(AudioEngine &Engine) : m_Engine(Engine), m_Stop(0) {
+        setObjectName("AudioMixer");
+    }
+    /****************************************************************************/
+    /**
+     * \brief Lets the thread finish after the current period.
+     */
+    /****************************************************************************/
+    void Stop() {
+        m_Stop.storeRelease(1);
+    }
+
+protected:
+    void run();
+
+private:
+    AudioEngine &m_Engine;  ///< The engine.
+    QAtomicInt  m_Stop;     ///< Set to stop the thread.
+}; // end class AudioMixerThread
+
+/****************************************************************************/
+void AudioMixerThread::run() {
+    AudioSink *p_Sink = m_Engine.mp_Sink.data();
+    int Frames = m_Engine.m_PeriodFrames;
+    // all buffers are allocated before the first period
+    QVector<qint32> Mix(Frames * AudioEngine::CHANNELS);
+    QVector<qint16> Output(Frames * AudioEngine::CHANNELS);
+    QVector<qint64> PlayTimes;
+    PlayTimes.reserve(AudioEngine::MAX_VOICES);
+    qint64 PeriodTime = static_cast<qint64>(Frames) * 1000000 / m_Engine.m_SampleRate;
+    qint64 Deadline = m_Engine.Now();
+    int Failures = 0;
+
+    while (m_Stop.loadAcquire() == 0) {
+        m_Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+        if (!PlayTimes.isEmpty()) {
+            // the first sample is heard after the samples still in the sink
+            qint64 Played = m_Engine.Now() + p_Sink->Delay();
+            for (int i = 0; i < PlayTimes.count(); i++) {
+                m_Engine.m_PlayLatency.Record(Played - PlayTimes.at(i));
+            }
+        }
+        if (!p_Sink->Write(Output.constData(), Frames)) {
+            if (Failures == 0) {
+                qDebug() << "AudioEngine: writing to the sink failed";
+            }
+            // back off while the device is gone, up to SINK_RETRY_MAX_DELAY
+            qint64 Delay = qMin(qMax(PeriodTime / 1000, Q_INT64_C(1)) << qMin(Failures, 10),
+                                static_cast<qint64>(SINK_RETRY_MAX_DELAY));
+            Failures++;
+            msleep(static_cast<unsigned long>(Delay));
+            continue;
+        }
+        if (Failures > 0) {
+            qDebug() << "AudioEngine: the sink works again after" << Failures << "failed periods";
+            Failures = 0;
+        }
+        if (!p_Sink->IsPaced()) {
+            Deadline += PeriodTime;
+            qint64 Wait = Deadline - m_Engine.Now();
+            if (Wait > 0) {
+                usleep(static_cast<unsigned long>(Wait));
+            } else if (Wait < -10 * PeriodTime) {
+                // do not catch up after a stall
+                Deadline = m_Engine.Now();
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+AudioEngine::AudioEngine(int SampleRate, int PeriodFrames)
+    : m_SampleRate(SampleRate)
+    , m_PeriodFrames(PeriodFrames)
+    , m_Sequence(0)
+{
+    m_Clock.start();
+    for (int i = 0; i < MAX_VOICES; i++) {
+        m_Voices[i].Position = 0;
+        m_Voices[i].Gain = 0;
+        m_Voices[i].PlayTime = -1;
+        m_Voices[i].Sequence = 0;
+    }
+}
+
+/****************************************************************************/
+AudioEngine::~AudioEngine() {
+    Stop();
+}
+
+/****************************************************************************/
+bool AudioEngine::Start(AudioSink *p_Sink) {
+    QScopedPointer<AudioSink> Sink(p_Sink);
+    if (!mp_Mixer.isNull() || Sink.isNull()) {
+        return false;
+    }
+    if (!Sink->Open(m_SampleRate, CHANNELS, m_PeriodFrames)) {
+        return false;
+    }
+    mp_Sink.reset(Sink.take());
+    mp_Mixer.reset(new AudioMixerThread(*this));
+    mp_Mixer->start(QThread::TimeCriticalPriority);
+    return true;
+}
+
+/****************************************************************************/
+void AudioEngine::Stop() {
+    if (mp_Mixer.isNull()) {
+        return;
+    }
+    mp_Mixer->Stop();
+    (void)mp_Mixer->wait();
+    mp_Mixer.reset();
+    mp_Sink->Close();
+    mp_Sink.reset();
+}
+
+/****************************************************************************/
+bool AudioEngine::IsRunning() const {
+    return !mp_Mixer.isNull();
+}
+
+/****************************************************************************/
+bool AudioEngine::LoadSound(const QString &FileName) {
+    if (IsLoaded(FileName)) {
+        return true;
+    }
+    QByteArray Data;
+    if (FileName.endsWith(".wav", Qt::CaseInsensitive)) {
+        QFile File(FileName);
+        if (!File.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        Data = File.readAll();
+    } else {
+        // compressed sounds are converted once, not on every play
+        QProcess Decoder;
+        Decoder.start("oggdec", QStringList() << "-Q" << "-o" << "-" << FileName);
+        if (!Decoder.waitForFinished(DECODER_TIMEOUT) || (Decoder.exitStatus() != QProcess::NormalExit) ||
+            (Decoder.exitCode() != 0)) {
+            qDebug() << "AudioEngine: cannot convert" << FileName;
+            Decoder.kill();
+            return false;
+        }
+        Data = Decoder.readAllStandardOutput();
+    }
+    QVector<qint16> Samples;
+    if (!DecodeWave(Data, m_SampleRate, Samples)) {
+        qDebug() << "AudioEngine: unsupported sound file" << FileName;
+        return false;
+    }
+    QMutexLocker Locker(&m_Lock);
+    m_Sounds.insert(FileName, Sound_t(new QVector<qint16>(Samples)));
+    return true;
+}
+
+/****************************************************************************/
+bool AudioEngine::IsLoaded(const QString &FileName) const {
+    QMutexLocker Locker(&m_Lock);
+    return m_Sounds.contains(FileName);
+}
+
+/****************************************************************************/
+bool AudioEngine::Play(const QString &FileName, int Volume) {
+    qint64 PlayTime = Now();
+    QMutexLocker Locker(&m_Lock);
+    Sound_t Sound = m_Sounds.value(FileName);
+    if (Sound.isNull()) {
+        return false;
+    }
+    // the same sound again, else a free voice, else the oldest one
+    Voice *p_Voice = NULL;
+    for (int i = 0; (i < MAX_VOICES) && (p_Voice == NULL); i++) {
+        if (!m_Voices[i].Sound.isNull() && (m_Voices[i].FileName == FileName)) {
+            p_Voice = &m_Voices[i];
+        }
+    }
+    for (int i = 0; (i < MAX_VOICES) && (p_Voice == NULL); i++) {
+        if (m_Voices[i].Sound.isNull()) {
+            p_Voice = &m_Voices[i];
+        }
+    }
+    if (p_Voice == NULL) {
+        p_Voice = &m_Voices[0];
+        for (int i = 1; i < MAX_VOICES; i++) {
+            if (m_Voices[i].Sequence < p_Voice->Sequence) {
+                p_Voice = &m_Voices[i];
+            }
+        }
+    }
+    p_Voice->FileName = FileName;
+    p_Voice->Sound = Sound;
+    p_Voice->Position = 0;
+    p_Voice->Gain = qBound(0, Volume, MAX_VOLUME) * 0x8000 / MAX_VOLUME;
+    p_Voice->PlayTime = PlayTime;
+    p_Voice->Sequence = m_Sequence++;
+    return true;
+}
+
+/****************************************************************************/
+void AudioEngine::StopAll() {
+    QMutexLocker Locker(&m_Lock);
+    for (int i = 0; i < MAX_VOICES; i++) {
+        m_Voices[i].Sound.clear();
+        m_Voices[i].FileName.clear();
+    }
+}
+
+/****************************************************************************/
+int AudioEngine::ActiveVoices() const {
+    QMutexLocker Locker(&m_Lock);
+    int Count = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (!m_Voices[i].Sound.isNull()) {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+/****************************************************************************/
+void AudioEngine::MixPeriod(qint32 *p_Mix, qint16 *p_Output, QVector<qint64> &PlayTimes) {
+    int Samples = m_PeriodFrames * CHANNELS;
+    PlayTimes.clear();
+    memset(p_Mix, 0, static_cast<size_t>(Samples) * sizeof(qint32));
+    {
+        QMutexLocker Locker(&m_Lock);
+        for (int v = 0; v < MAX_VOICES; v++) {
+            Voice &CurrentVoice = m_Voices[v];
+            if (CurrentVoice.Sound.isNull()) {
+                continue;
+            }
+            const qint16 *p_Sound = CurrentVoice.Sound->constData() + CurrentVoice.Position;
+            int Count = qMin(CurrentVoice.Sound->count() - CurrentVoice.Position, Samples);
+            for (int i = 0; i < Count; i++) {
+                p_Mix[i] += (static_cast<qint32>(p_Sound[i]) * CurrentVoice.Gain) >> 15;
+            }
+            CurrentVoice.Position += Count;
+            if (CurrentVoice.PlayTime >= 0) {
+                PlayTimes.append(CurrentVoice.PlayTime);
+                CurrentVoice.PlayTime = -1;
+            }
+            if (CurrentVoice.Position >= CurrentVoice.Sound->count()) {
+                CurrentVoice.Sound.clear();
+                CurrentVoice.FileName.clear();
+            }
+        }
+    }
+    for (int i = 0; i < Samples; i++) {
+        p_Output[i] = static_cast<qint16>(qBound(-32768, p_Mix[i], 32767));
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns a sample of a wave file as 16 bit.
+ *
+ *  \iparam p_Frame = The frame
+ *  \iparam Channel = Channel of the sample
+ *  \iparam Bits = Bits per sample, 8 or 16
+ *
+ *  \return The sample
+ */
+/****************************************************************************/
+static inline qint32 WaveSample(const uchar *p_Frame, int Channel, int Bits) {
+    if (Bits == 8) {
+        // 8 bit samples are unsigned
+        return (static_cast<qint32>(p_Frame[Channel]) - 128) << 8;
+    }
+    return qFromLittleEndian<qint16>(p_Frame + 2 * Channel);
+}
+
+/****************************************************************************/
+bool AudioEngine::DecodeWave(const QByteArray &Data, int SampleRate, QVector<qint16> &Samples) {
+    Samples.clear();
+    const uchar *p_Data = reinterpret_cast<const uchar *>(Data.constData());
+    qint64 Size = Data.size();
+    if ((Size < 12) || (memcmp(p_Data, "RIFF", 4) != 0) || (memcmp(p_Data + 8, "WAVE", 4) != 0) || (SampleRate <= 0)) {
+        return false;
+    }
+    int Format = 0;
+    int Channels = 0;
+    int Rate = 0;
+    int Bits = 0;
+    const uchar *p_Samples = NULL;
+    qint64 DataSize = 0;
+    qint64 Offset = 12;
+    while (Offset + 8 <= Size) {
+        const uchar *p_Chunk = p_Data + Offset;
+        qint64 ChunkSize = qFromLittleEndian<quint32>(p_Chunk + 4);
+        qint64 Available = Size - Offset - 8;
+        if ((memcmp(p_Chunk, "fmt ", 4) == 0) && (ChunkSize >= 16) && (Available >= 16)) {
+            Format = qFromLittleEndian<quint16>(p_Chunk + 8);
+            Channels = qFromLittleEndian<quint16>(p_Chunk + 10);
+            Rate = static_cast<int>(qFromLittleEndian<quint32>(p_Chunk + 12));
+            Bits = qFromLittleEndian<quint16>(p_Chunk + 22);
+            if ((Format == 0xFFFE) && (ChunkSize >= 26) && (Available >= 26)) {
+                // extensible format, the sub format starts with the format code
+                Format = qFromLittleEndian<quint16>(p_Chunk + 32);
+            }
+        } else if (memcmp(p_Chunk, "data", 4) == 0) {
+            // the size of a stream written before its end may be wrong
+            p_Samples = p_Chunk + 8;
+            DataSize = qMin(ChunkSize, Available);
+            break;
+        }
+        // chunks are padded to an even size
+        Offset += 8 + ChunkSize + (ChunkSize & 1);
+    }
+    if ((Format != 1) || ((Channels != 1) && (Channels != 2)) || ((Bits != 8) && (Bits != 16)) ||
+        (Rate <= 0) || (p_Samples == NULL)) {
+        return false;
+    }
+
+    int FrameSize = Channels * Bits / 8;
+    qint64 Frames = DataSize / FrameSize;
+    qint64 OutputFrames = Frames * SampleRate / Rate;
+    Samples.resize(static_cast<int>(OutputFrames * CHANNELS));
+    qint16 *p_Output = Samples.data();
+    for (qint64 i = 0; i < OutputFrames; i++) {
+        // position in the input in units of 1/SampleRate frames, interpolated linearly
+        qint64 Position = i * Rate;
+        qint64 Index = Position / SampleRate;
+        qint64 Fraction = Position % SampleRate;
+        const uchar *p_Frame = p_Samples + Index * FrameSize;
+        const uchar *p_Next = (Index + 1 < Frames) ? (p_Frame + FrameSize) : p_Frame;
+        for (int c = 0; c < CHANNELS; c++) {
+            int Channel = (Channels == 1) ? 0 : c;
+            qint64 First = WaveSample(p_Frame, Channel, Bits);
+            qint64 Second = WaveSample(p_Next, Channel, Bits);
+            *p_Output++ = static_cast<qint16>(First + (Second - First) * Fraction / SampleRate);
+        }
+    }
+    return true;
+}
+
+} // end namespace Global
@@ -0,0 +1,208 @@
+/****************************************************************************/
+/*! \file Global/Source/AudioSink.cpp
+ *
+ *  \brief Implementation file for the audio sinks of the AudioEngine.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <Global/Include/AudioSink.h>
+
+#include <QDataStream>
+#include <QDebug>
+
+namespace Global {
+
+// ALSA constants, stable parts of its ABI
+const int SND_PCM_STREAM_PLAYBACK = 0;          //!< Playback stream.
+const int SND_PCM_FORMAT_S16_LE = 2;            //!< Signed 16 bit, little endian.
+const int SND_PCM_ACCESS_RW_INTERLEAVED = 3;    //!< Interleaved samples written with snd_pcm_writei.
+
+const int WAVE_HEADER_SIZE = 44;                //!< Size of the header written by AudioFileSink.
+
+/****************************************************************************/
+bool AudioNullSink::Open(int SampleRate, int Channels, int PeriodFrames) {
+    Q_UNUSED(SampleRate);
+    Q_UNUSED(Channels);
+    Q_UNUSED(PeriodFrames);
+    m_Frames = 0;
+    return true;
+}
+
+/****************************************************************************/
+bool AudioNullSink::Write(const qint16 *p_Samples, int Frames) {
+    Q_UNUSED(p_Samples);
+    m_Frames += Frames;
+    return true;
+}
+
+/****************************************************************************/
+void AudioNullSink::Close() {
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Writes the header of a wave file.
+ *
+ *  \iparam File = The file
+ *  \iparam SampleRate = Frames per second
+ *  \iparam Channels = Samples per frame
+ *  \iparam DataSize = Size of the samples
+ */
+/****************************************************************************/
+static void WriteWaveHeader(QFile &File, int SampleRate, int Channels, quint32 DataSize) {
+    QDataStream Stream(&File);
+    Stream.setByteOrder(QDataStream::LittleEndian);
+    (void)Stream.writeRawData("RIFF", 4);
+    Stream << static_cast<quint32>(WAVE_HEADER_SIZE - 8 + DataSize);
+    (void)Stream.writeRawData("WAVEfmt ", 8);
+    Stream << static_cast<quint32>(16) << static_cast<quint16>(1) << static_cast<quint16>(Channels)
+           << static_cast<quint32>(SampleRate) << static_cast<quint32>(SampleRate * Channels * 2)
+           << static_cast<quint16>(Channels * 2) << static_cast<quint16>(16);
+    (void)Stream.writeRawData("data", 4);
+    Stream << DataSize;
+}
+
+/****************************************************************************/
+bool AudioFileSink::Open(int SampleRate, int Channels, int PeriodFrames) {
+    Q_UNUSED(PeriodFrames);
+    if (!m_File.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    m_Channels = Channels;
+    // the sizes are set on close
+    WriteWaveHeader(m_File, SampleRate, Channels, 0);
+    return true;
+}
+
+/****************************************************************************/
+bool AudioFileSink::Write(const qint16 *p_Samples, int Frames) {
+    qint64 Size = static_cast<qint64>(Frames) * m_Channels * static_cast<qint64>(sizeof(qint16));
+    // wave files are little endian, as is the target
+    return m_File.write(reinterpret_cast<const char *>(p_Samples), Size) == Size;
+}
+
+/****************************************************************************/
+void AudioFileSink::Close() {
+    if (!m_File.isOpen()) {
+        return;
+    }
+    quint32 DataSize = static_cast<quint32>(m_File.size() - WAVE_HEADER_SIZE);
+    QFile Header(m_File.fileName());
+    m_File.close();
+    if (Header.open(QIODevice::ReadWrite)) {
+        quint32 SampleRate = 0;
+        QDataStream Stream(&Header);
+        Stream.setByteOrder(QDataStream::LittleEndian);
+        (void)Header.seek(24);
+        Stream >> SampleRate;
+        (void)Header.seek(0);
+        WriteWaveHeader(Header, static_cast<int>(SampleRate), m_Channels, DataSize);
+        Header.close();
+    }
+}
+
+/****************************************************************************/
+AudioDeviceSink::AudioDeviceSink(const QString &DeviceName, int Latency)
+    : m_DeviceName(DeviceName)
+    , m_Latency(Latency)
+    , m_SampleRate(0)
+    , m_Channels(0)
+    , m_Library("asound", 2)
+    , mp_Pcm(NULL)
+    , mp_Writei(NULL)
+    , mp_Recover(NULL)
+    , mp_Delay(NULL)
+    , mp_Close(NULL)
+{
+}
+
+/****************************************************************************/
+AudioDeviceSink::~AudioDeviceSink() {
+    Close();
+}
+
+/****************************************************************************/
+bool AudioDeviceSink::Open(int SampleRate, int Channels, int PeriodFrames) {
+    Q_UNUSED(PeriodFrames);
+    if (!m_Library.load()) {
+        qDebug() << "AudioDeviceSink: cannot load libasound:" << m_Library.errorString();
+        return false;
+    }
+    PcmOpen_t p_Open = reinterpret_cast<PcmOpen_t>(m_Library.resolve("snd_pcm_open"));
+    PcmSetParams_t p_SetParams = reinterpret_cast<PcmSetParams_t>(m_Library.resolve("snd_pcm_set_params"));
+    mp_Writei = reinterpret_cast<PcmWritei_t>(m_Library.resolve("snd_pcm_writei"));
+    mp_Recover = reinterpret_cast<PcmRecover_t>(m_Library.resolve("snd_pcm_recover"));
+    mp_Delay = reinterpret_cast<PcmDelay_t>(m_Library.resolve("snd_pcm_delay"));
+    mp_Close = reinterpret_cast<PcmClose_t>(m_Library.resolve("snd_pcm_close"));
+    if ((p_Open == NULL) || (p_SetParams == NULL) || (mp_Writei == NULL) ||
+        (mp_Recover == NULL) || (mp_Delay == NULL) || (mp_Close == NULL)) {
+        qDebug() << "AudioDeviceSink: libasound incomplete";
+        return false;
+    }
+    if (p_Open(&mp_Pcm, m_DeviceName.toLatin1().constData(), SND_PCM_STREAM_PLAYBACK, 0) < 0) {
+        qDebug() << "AudioDeviceSink: cannot open" << m_DeviceName;
+        mp_Pcm = NULL;
+        return false;
+    }
+    // the buffer of the device bounds the delay of a sound
+    if (p_SetParams(mp_Pcm, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED, static_cast<unsigned int>(Channels),
+                    static_cast<unsigned int>(SampleRate), 1, static_cast<unsigned int>(m_Latency)) < 0) {
+        qDebug() << "AudioDeviceSink: cannot set the parameters of" << m_DeviceName;
+        Close();
+        return false;
+    }
+    m_SampleRate = SampleRate;
+    m_Channels = Channels;
+    return true;
+}
+
+/****************************************************************************/
+bool AudioDeviceSink::Write(const qint16 *p_Samples, int Frames) {
+    if (mp_Pcm == NULL) {
+        return false;
+    }
+    while (Frames > 0) {
+        long Written = mp_Writei(mp_Pcm, p_Samples, static_cast<unsigned long>(Frames));
+        if (Written < 0) {
+            // underrun or suspend, prepare the device again
+            if (mp_Recover(mp_Pcm, static_cast<int>(Written), 1) < 0) {
+                return false;
+            }
+            continue;
+        }
+        p_Samples += Written * m_Channels;
+        Frames -= static_cast<int>(Written);
+    }
+    return true;
+}
+
+/****************************************************************************/
+void AudioDeviceSink::Close() {
+    if (mp_Pcm != NULL) {
+        (void)mp_Close(mp_Pcm);
+        mp_Pcm = NULL;
+    }
+}
+
+/****************************************************************************/
+qint64 AudioDeviceSink::Delay() {
+    long Frames = 0;
+    if ((mp_Pcm == NULL) || (m_SampleRate == 0) || (mp_Delay(mp_Pcm, &Frames) < 0) || (Frames < 0)) {
+        return 0;
+    }
+    return static_cast<qint64>(Frames) * 1000000 / m_SampleRate;
+}
+
+} // end namespace Global
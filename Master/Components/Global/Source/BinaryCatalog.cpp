@@ -0,0 +1,320 @@
+/****************************************************************************/
+/*! \file Global/Source/BinaryCatalog.cpp
+ *
+ *  \brief Implementation file for class BinaryCatalog.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <Global/Include/BinaryCatalog.h>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <string.h>
+
+namespace Global {
+
+const quint32 BinaryCatalog::CATALOG_VERSION;
+const quint32 BinaryCatalog::FORMAT_STRINGS;
+const quint32 BinaryCatalog::CATALOG_MAGIC;
+const quint32 BinaryCatalog::EMPTY_SLOT;
+const quint32 BinaryCatalog::MAX_SEED;
+
+/****************************************************************************/
+BinaryCatalog::BinaryCatalog() :
+    mp_Header(NULL),
+    mp_Seeds(NULL),
+    mp_Slots(NULL),
+    mp_Data(NULL)
+{
+}
+
+/****************************************************************************/
+BinaryCatalog::~BinaryCatalog() {
+    Close();
+}
+
+/****************************************************************************/
+bool BinaryCatalog::Open(const QString &FileName, quint32 Format, const QString &SourceFileName) {
+    if (IsOpen()) {
+        return false;
+    }
+    QFileInfo Source(SourceFileName);
+    m_File.setFileName(FileName);
+    if (!Source.exists() || !m_File.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    qint64 FileSize = m_File.size();
+    const uchar *p_Map = NULL;
+    if (FileSize >= static_cast<qint64>(sizeof(FileHeader))) {
+        p_Map = m_File.map(0, FileSize);
+    }
+    if (p_Map == NULL) {
+        m_File.close();
+        return false;
+    }
+    const FileHeader *p_Header = reinterpret_cast<const FileHeader *>(p_Map);
+    qint64 IndexSize = static_cast<qint64>(p_Header->BucketCount) * sizeof(quint32) +
+                       static_cast<qint64>(p_Header->SlotCount) * sizeof(Slot);
+    // header first, the checksum reads the whole file
+    if ((p_Header->Magic != CATALOG_MAGIC) ||
+        (p_Header->Version != CATALOG_VERSION) ||
+        (p_Header->Format != Format) ||
+        (p_Header->SourceSize != Source.size()) ||
+        (p_Header->SourceModified != Source.lastModified().toMSecsSinceEpoch()) ||
+        (p_Header->BucketCount == 0) || (p_Header->SlotCount == 0) ||
+        (static_cast<qint64>(sizeof(FileHeader)) + IndexSize + p_Header->DataSize != FileSize) ||
+        (p_Header->Checksum != Checksum(reinterpret_cast<const char *>(p_Map) + sizeof(FileHeader),
+                                        static_cast<quint32>(IndexSize) + p_Header->DataSize))) {
+        (void)m_File.unmap(const_cast<uchar *>(p_Map));
+        m_File.close();
+        return false;
+    }
+    mp_Header = p_Header;
+    mp_Seeds = reinterpret_cast<const quint32 *>(p_Map + sizeof(FileHeader));
+    mp_Slots = reinterpret_cast<const Slot *>(mp_Seeds + p_Header->BucketCount);
+    mp_Data = reinterpret_cast<const char *>(mp_Slots + p_Header->SlotCount);
+    return true;
+}
+
+/****************************************************************************/
+void BinaryCatalog::Close() {
+    if (IsOpen()) {
+        (void)m_File.unmap(reinterpret_cast<uchar *>(const_cast<FileHeader *>(mp_Header)));
+    }
+    m_File.close();
+    mp_Header = NULL;
+    mp_Seeds = NULL;
+    mp_Slots = NULL;
+    mp_Data = NULL;
+}
+
+/****************************************************************************/
+bool BinaryCatalog::Find(quint32 Key, QByteArray &Record) const {
+    if (!IsOpen()) {
+        return false;
+    }
+    quint32 Bucket = Hash(Key, 0) % mp_Header->BucketCount;
+    const Slot &TheSlot = mp_Slots[Hash(Key, mp_Seeds[Bucket]) % mp_Header->SlotCount];
+    if ((TheSlot.Offset == EMPTY_SLOT) || (TheSlot.Key != Key)) {
+        return false;
+    }
+    Record = QByteArray::fromRawData(mp_Data + TheSlot.Offset, static_cast<int>(TheSlot.Size));
+    return true;
+}
+
+/****************************************************************************/
+QList<quint32> BinaryCatalog::Keys() const {
+    QList<quint32> Result;
+    if (IsOpen()) {
+        for (quint32 i = 0; i < mp_Header->SlotCount; i++) {
+            if (mp_Slots[i].Offset != EMPTY_SLOT) {
+                Result.append(mp_Slots[i].Key);
+            }
+        }
+    }
+    return Result;
+}
+
+/****************************************************************************/
+int BinaryCatalog::Count() const {
+    return IsOpen() ? static_cast<int>(mp_Header->Count) : 0;
+}
+
+/****************************************************************************/
+bool BinaryCatalog::Compile(const QString &FileName, quint32 Format, const QString &SourceFileName,
+                            const QHash<quint32, QByteArray> &Records) {
+    QFileInfo Source(SourceFileName);
+    if (!Source.exists()) {
+        return false;
+    }
+    // about three keys per bucket and a slot table 80% full find seeds quickly
+    QList<quint32> Keys = Records.keys();
+    quint32 Count = static_cast<quint32>(Keys.count());
+    quint32 BucketCount = Count / 3 + 1;
+    quint32 SlotCount = Count + Count / 4 + 1;
+    QVector<quint32> Seeds;
+    QVector<int> SlotKeys;
+    if (!PlaceKeys(Keys, BucketCount, SlotCount, Seeds, SlotKeys)) {
+        return false;
+    }
+
+    QVector<Slot> Slots(static_cast<int>(SlotCount));
+    QByteArray Data;
+    for (int i = 0; i < Slots.count(); i++) {
+        Slot &TheSlot = Slots[i];
+        if (SlotKeys.at(i) < 0) {
+            TheSlot.Key = 0;
+            TheSlot.Offset = EMPTY_SLOT;
+            TheSlot.Size = 0;
+            continue;
+        }
+        const QByteArray &Record = Records[Keys.at(SlotKeys.at(i))];
+        TheSlot.Key = Keys.at(SlotKeys.at(i));
+        TheSlot.Offset = static_cast<quint32>(Data.size());
+        TheSlot.Size = static_cast<quint32>(Record.size());
+        Data.append(Record);
+        // keep the records aligned
+        Data.append(QByteArray((4 - Data.size() % 4) % 4, '\0'));
+    }
+
+    QByteArray Index;
+    Index.append(reinterpret_cast<const char *>(Seeds.constData()), Seeds.count() * static_cast<int>(sizeof(quint32)));
+    Index.append(reinterpret_cast<const char *>(Slots.constData()), Slots.count() * static_cast<int>(sizeof(Slot)));
+    Index.append(Data);
+
+    FileHeader Header;
+    memset(&Header, 0, sizeof(Header));
+    Header.Magic = CATALOG_MAGIC;
+    Header.Version = CATALOG_VERSION;
+    Header.Format = Format;
+    Header.Count = Count;
+    Header.BucketCount = BucketCount;
+    Header.SlotCount = SlotCount;
+    Header.DataSize = static_cast<quint32>(Data.size());
+    Header.Checksum = Checksum(Index.constData(), static_cast<quint32>(Index.size()));
+    Header.SourceSize = Source.size();
+    Header.SourceModified = Source.lastModified().toMSecsSinceEpoch();
+
+    QSaveFile File(FileName);
+    if (!File.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if ((File.write(reinterpret_cast<const char *>(&Header), sizeof(Header)) != static_cast<qint64>(sizeof(Header))) ||
+        (File.write(Index) != Index.size())) {
+        File.cancelWriting();
+        return false;
+    }
+    return File.commit();
+}
+
+/****************************************************************************/
+QString BinaryCatalog::CatalogFileName(const QString &SourceFileName) {
+    QFileInfo Source(SourceFileName);
+    return Source.path() + "/" + Source.completeBaseName() + ".cat";
+}
+
+/****************************************************************************/
+QByteArray BinaryCatalog::EncodeStrings(const QStringList &Strings) {
+    QByteArray Record;
+    quint32 Count = static_cast<quint32>(Strings.count());
+    Record.append(reinterpret_cast<const char *>(&Count), sizeof(Count));
+    for (int i = 0; i < Strings.count(); i++) {
+        quint32 Length = static_cast<quint32>(Strings.at(i).size());
+        Record.append(reinterpret_cast<const char *>(&Length), sizeof(Length));
+        Record.append(reinterpret_cast<const char *>(Strings.at(i).constData()),
+                      Strings.at(i).size() * static_cast<int>(sizeof(QChar)));
+    }
+    return Record;
+}
+
+/****************************************************************************/
+bool BinaryCatalog::DecodeStrings(const QByteArray &Record, QStringList &Strings) {
+    Strings.clear();
+    const char *p_Read = Record.constData();
+    const char *p_End = p_Read + Record.size();
+    quint32 Count = 0;
+    if (p_End - p_Read < static_cast<int>(sizeof(Count))) {
+        return false;
+    }
+    memcpy(&Count, p_Read, sizeof(Count));
+    p_Read += sizeof(Count);
+    for (quint32 i = 0; i < Count; i++) {
+        quint32 Length = 0;
+        if (p_End - p_Read < static_cast<int>(sizeof(Length))) {
+            return false;
+        }
+        memcpy(&Length, p_Read, sizeof(Length));
+        p_Read += sizeof(Length);
+        if (static_cast<quint32>(p_End - p_Read) / sizeof(QChar) < Length) {
+            return false;
+        }
+        // the records are aligned, so are the characters
+        Strings.append(QString(reinterpret_cast<const QChar *>(p_Read), static_cast<int>(Length)));
+        p_Read += Length * sizeof(QChar);
+    }
+    return true;
+}
+
+/****************************************************************************/
+quint32 BinaryCatalog::Hash(quint32 Key, quint32 Seed) {
+    // finalizer of MurmurHash3
+    quint32 Value = Key ^ (Seed * 0x9E3779B9U);
+    Value ^= Value >> 16;
+    Value *= 0x85EBCA6BU;
+    Value ^= Value >> 13;
+    Value *= 0xC2B2AE35U;
+    Value ^= Value >> 16;
+    return Value;
+}
+
+/****************************************************************************/
+quint32 BinaryCatalog::Checksum(const char *p_Data, quint32 Size) {
+    // FNV-1a
+    quint32 Value = 0x811C9DC5U;
+    for (quint32 i = 0; i < Size; i++) {
+        Value ^= static_cast<quint8>(p_Data[i]);
+        Value *= 0x01000193U;
+    }
+    return Value;
+}
+
+/****************************************************************************/
+bool BinaryCatalog::PlaceKeys(const QList<quint32> &Keys, quint32 BucketCount, quint32 SlotCount,
+                              QVector<quint32> &Seeds, QVector<int> &SlotKeys) {
+    QVector<QList<int> > Buckets(static_cast<int>(BucketCount));
+    int MaxBucketSize = 0;
+    for (int i = 0; i < Keys.count(); i++) {
+        QList<int> &Bucket = Buckets[static_cast<int>(Hash(Keys.at(i), 0) % BucketCount)];
+        Bucket.append(i);
+        MaxBucketSize = qMax(MaxBucketSize, Bucket.count());
+    }
+    Seeds.fill(0, static_cast<int>(BucketCount));
+    SlotKeys.fill(-1, static_cast<int>(SlotCount));
+
+    // the large buckets first, while most slots are free
+    QVector<quint32> Taken;
+    for (int Size = MaxBucketSize; Size > 0; Size--) {
+        for (int b = 0; b < Buckets.count(); b++) {
+            const QList<int> &Bucket = Buckets.at(b);
+            if (Bucket.count() != Size) {
+                continue;
+            }
+            quint32 Seed = 1;
+            for (; Seed < MAX_SEED; Seed++) {
+                Taken.clear();
+                for (int k = 0; k < Bucket.count(); k++) {
+                    quint32 TheSlot = Hash(Keys.at(Bucket.at(k)), Seed) % SlotCount;
+                    if ((SlotKeys.at(static_cast<int>(TheSlot)) >= 0) || Taken.contains(TheSlot)) {
+                        break;
+                    }
+                    Taken.append(TheSlot);
+                }
+                if (Taken.count() == Bucket.count()) {
+                    break;
+                }
+            }
+            if (Seed >= MAX_SEED) {
+                return false;
+            }
+            Seeds[b] = Seed;
+            for (int k = 0; k < Bucket.count(); k++) {
+                SlotKeys[static_cast<int>(Taken.at(k))] = Bucket.at(k);
+            }
+        }
+    }
+    return true;
+}
+
+} // end namespace Global
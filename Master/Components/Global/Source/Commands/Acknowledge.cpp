@@ -26,7 +26,8 @@ const QString Acknowledge::SERIALIZERSTRING = "Acknowledge";
 
 /****************************************************************************/
 Acknowledge::Acknowledge()
-    : m_Ref(0)
+    : m_TypeID(CommandTypeID::INVALID)
+    , m_Ref(0)
 {
 }
 
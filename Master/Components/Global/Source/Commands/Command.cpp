@@ -29,6 +29,7 @@ const int       Command::MAXTIMEOUT    = 0x7FFFFFFF;
 /****************************************************************************/
 Command::Command(int Timeout)
     : m_Timeout(Timeout)
+    , m_TypeID(CommandTypeID::INVALID)
     , m_stateGuard(7, true)
 {
 }
@@ -36,6 +37,7 @@ Command::Command(int Timeout)
 /****************************************************************************/
 Command::Command(const Command &rOther)
     : m_Timeout(0)
+    , m_TypeID(CommandTypeID::INVALID)
     , m_stateGuard(7, true)
 {
     CopyFrom(rOther);
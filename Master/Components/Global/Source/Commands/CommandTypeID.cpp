@@ -0,0 +1,92 @@
+/****************************************************************************/
+/*! \file Global/Source/Commands/CommandTypeID.cpp
+ *
+ *  \brief Implementation file for class CommandTypeID.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <Global/Include/Commands/CommandTypeID.h>
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QStringList>
+
+namespace Global {
+
+const int CommandTypeID::INVALID;
+
+/****************************************************************************/
+/**
+ * \brief Registered names.
+ */
+/****************************************************************************/
+struct CommandTypeRegistry {
+    QReadWriteLock      Lock;   ///< Guard for thread safety.
+    QHash<QString, int> IDs;    ///< IDs by name.
+    QStringList         Names;  ///< Names by ID.
+};
+
+/****************************************************************************/
+/**
+ * \brief Get the registry, created on first use.
+ *
+ * \return  The registry.
+ */
+/****************************************************************************/
+static CommandTypeRegistry &Registry() {
+    static CommandTypeRegistry TheRegistry;
+    return TheRegistry;
+}
+
+/****************************************************************************/
+int CommandTypeID::Register(const QString &Name) {
+    CommandTypeRegistry &Types = Registry();
+    {
+        QReadLocker Lock(&Types.Lock);
+        QHash<QString, int>::const_iterator it = Types.IDs.constFind(Name);
+        if (it != Types.IDs.constEnd()) {
+            return it.value();
+        }
+    }
+    QWriteLocker Lock(&Types.Lock);
+    QHash<QString, int>::const_iterator it = Types.IDs.constFind(Name);
+    if (it != Types.IDs.constEnd()) {
+        // registered by another thread meanwhile
+        return it.value();
+    }
+    int TypeID = Types.Names.count();
+    Types.Names.append(Name);
+    static_cast<void>(Types.IDs.insert(Name, TypeID));
+    return TypeID;
+}
+
+/****************************************************************************/
+QString CommandTypeID::Name(int TypeID) {
+    CommandTypeRegistry &Types = Registry();
+    QReadLocker Lock(&Types.Lock);
+    if ((TypeID < 0) || (TypeID >= Types.Names.count())) {
+        return QString();
+    }
+    return Types.Names.at(TypeID);
+}
+
+/****************************************************************************/
+int CommandTypeID::Count() {
+    CommandTypeRegistry &Types = Registry();
+    QReadLocker Lock(&Types.Lock);
+    return Types.Names.count();
+}
+
+} // end namespace Global
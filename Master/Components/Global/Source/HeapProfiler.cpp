@@ -0,0 +1,1142 @@
+/****************************************************************************/
+/*! \file Global/Source/HeapProfiler.cpp
+ *
+ *  \brief Implementation file for class HeapProfiler.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <Global/Include/HeapProfiler.h>
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QByteArray>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMultiMap>
+#include <QMutex>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+#include <QtAlgorithms>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the allocator is wrapped only in builds with CONFIG+=heap_profiler
+#if defined(HEAP_PROFILER) && defined(__GLIBC__)
+#define HEAP_PROFILER_WRAPPER
+#endif
+
+#ifdef HEAP_PROFILER_WRAPPER
+#include <execinfo.h>
+#include <malloc.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*lint -save -e1548 -e1960 */
+extern "C" {
+    // the allocator of glibc, called by the wrappers below
+    void *__libc_malloc(size_t Size);
+    void *__libc_calloc(size_t Count, size_t Size);
+    void *__libc_realloc(void *p_Memory, size_t Size);
+    void __libc_free(void *p_Memory);
+}
+/*lint -restore */
+#endif
+
+namespace Global {
+
+#ifdef HEAP_PROFILER_WRAPPER
+
+namespace {
+
+const int HEAP_MAX_FRAMES = 16;                 //!< Frames recorded per sample
+const int HEAP_WRAPPER_FRAMES = 4;              //!< Frames of the profiler above the caller, at most
+const int HEAP_THREAD_BUFFER_EVENTS = 256;      //!< Events buffered per thread, a power of two
+const int HEAP_SAMPLE_TABLE_BITS = 14;          //!< Bits of the sampled block table index
+const int HEAP_SAMPLE_TABLE_SIZE = 1 << HEAP_SAMPLE_TABLE_BITS;    //!< Slots of the sampled block table
+const int HEAP_SAMPLE_TABLE_PROBES = 8;         //!< Slots probed per block
+const int HEAP_DRAIN_INTERVAL_MS = 100;         //!< Time between two collections of the thread buffers
+const int HEAP_DUMP_CALL_SITES = 50;            //!< Call sites written to the profile
+
+/****************************************************************************/
+/*!
+ *  \brief  Type of a heap event
+ */
+/****************************************************************************/
+enum HeapEventType_t {
+    HEAP_EVENT_ALLOC,   //!< A block was sampled
+    HEAP_EVENT_FREE     //!< A sampled block was freed
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Event passed from an allocating thread to the writer thread
+ */
+/****************************************************************************/
+struct HeapEvent {
+    quint32 Type;                       //!< HeapEventType_t
+    quint32 Id;                         //!< Id of the sampled block
+    quint64 Size;                       //!< Size of the block
+    quint64 Weight;                     //!< Bytes the sample stands for
+    quint32 Depth;                      //!< Number of frames
+    void    *Frames[HEAP_MAX_FRAMES];   //!< Return addresses, the caller of malloc first
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Event buffer of a thread
+ *
+ *      A ring buffer written by its thread and read by the writer thread,
+ *      without a lock. If it is full, the event is dropped.
+ */
+/****************************************************************************/
+class HeapThreadBuffer
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam ThreadId = Kernel id of the owning thread
+     */
+    /****************************************************************************/
+    explicit HeapThreadBuffer(qint64 ThreadId)
+        : m_Head(0)
+        , m_Tail(0)
+        , m_ThreadId(ThreadId)
+        , mp_Next(NULL)
+    {
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Appends an event, called by the owning thread only
+     *
+     *  \iparam Event = The event
+     *
+     *  \return True if buffered, false if the buffer is full
+     */
+    /****************************************************************************/
+    bool Push(const HeapEvent &Event)
+    {
+        quint32 Head = static_cast<quint32>(m_Head.load());
+        if (Head - static_cast<quint32>(m_Tail.loadAcquire()) >= static_cast<quint32>(HEAP_THREAD_BUFFER_EVENTS)) {
+            return false;
+        }
+        HeapEvent &Slot = m_Events[Head & (HEAP_THREAD_BUFFER_EVENTS - 1)];
+        Slot.Type = Event.Type;
+        Slot.Id = Event.Id;
+        Slot.Size = Event.Size;
+        Slot.Weight = Event.Weight;
+        Slot.Depth = Event.Depth;
+        for (quint32 i = 0; i < Event.Depth; i++) {
+            Slot.Frames[i] = Event.Frames[i];
+        }
+        m_Head.storeRelease(static_cast<int>(Head + 1));
+        return true;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Removes the oldest event, called by the writer thread only
+     *
+     *  \oparam Event = The event
+     *
+     *  \return True if an event was buffered
+     */
+    /****************************************************************************/
+    bool Pop(HeapEvent &Event)
+    {
+        quint32 Tail = static_cast<quint32>(m_Tail.load());
+        if (Tail == static_cast<quint32>(m_Head.loadAcquire())) {
+            return false;
+        }
+        Event = m_Events[Tail & (HEAP_THREAD_BUFFER_EVENTS - 1)];
+        m_Tail.storeRelease(static_cast<int>(Tail + 1));
+        return true;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the kernel id of the owning thread
+     *
+     *  \return Thread id
+     */
+    /****************************************************************************/
+    qint64 ThreadId() const { return m_ThreadId; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the next buffer of the buffer list
+     *
+     *  \return Next buffer or NULL
+     */
+    /****************************************************************************/
+    HeapThreadBuffer *Next() const { return mp_Next; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Links the buffer into the buffer list
+     *
+     *  \iparam pNext = Current head of the list
+     */
+    /****************************************************************************/
+    void SetNext(HeapThreadBuffer *pNext) { mp_Next = pNext; }
+
+private:
+    HeapEvent m_Events[HEAP_THREAD_BUFFER_EVENTS];  //!< Ring storage
+    QAtomicInt m_Head;                              //!< Write position, owning thread
+    QAtomicInt m_Tail;                              //!< Read position, writer thread
+    qint64 m_ThreadId;                              //!< Kernel id of the owning thread
+    HeapThreadBuffer *mp_Next;                      //!< Next buffer in the list
+
+    Q_DISABLE_COPY(HeapThreadBuffer)
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Estimates of a call site
+ */
+/****************************************************************************/
+struct HeapCallSite {
+    QByteArray Frames;      //!< Return addresses, the caller of malloc first
+    qint64 LiveBytes;       //!< Estimated live bytes
+    qint64 LiveSamples;     //!< Live samples
+    qint64 AllocatedBytes;  //!< Estimated allocated bytes
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Estimates of a thread
+ */
+/****************************************************************************/
+struct HeapThread {
+    QString Name;           //!< Name of the thread, as long as it is running
+    qint64 LiveBytes;       //!< Estimated live bytes allocated by the thread
+    qint64 AllocatedBytes;  //!< Estimated bytes allocated by the thread
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  A sampled block which was not freed yet
+ */
+/****************************************************************************/
+struct HeapLiveSample {
+    HeapCallSite *pCallSite;    //!< Call site allocating the block
+    HeapThread *pThread;        //!< Thread allocating the block
+    qint64 Weight;              //!< Bytes the sample stands for
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  The profile built from the events of all threads
+ *
+ *      Used by the writer thread and by the callers of Dump, serialized by
+ *      s_ProfileLock. Its own allocations are made while the calling thread
+ *      is marked busy, so they are not sampled.
+ */
+/****************************************************************************/
+class HeapProfile
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     */
+    /****************************************************************************/
+    HeapProfile() : m_SampleInterval(0), m_LiveBytes(0), m_AllocatedBytes(0) {}
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Destructor
+     */
+    /****************************************************************************/
+    ~HeapProfile() { Clear(); }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Starts a new profile
+     *
+     *  \iparam FileName = Path of the profile file
+     *  \iparam SampleInterval = Average bytes between two samples
+     */
+    /****************************************************************************/
+    void Reset(const QString &FileName, quint32 SampleInterval);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Collects the events of all thread buffers
+     */
+    /****************************************************************************/
+    void Collect();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Writes the profile file
+     *
+     *  \return True on success
+     */
+    /****************************************************************************/
+    bool Write();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the estimated live bytes
+     *
+     *  \return Live bytes
+     */
+    /****************************************************************************/
+    qint64 LiveBytes() const { return m_LiveBytes; }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Returns the estimated allocated bytes
+     *
+     *  \return Allocated bytes
+     */
+    /****************************************************************************/
+    qint64 AllocatedBytes() const { return m_AllocatedBytes; }
+
+private:
+    void Clear();
+    void AddSample(const HeapEvent &Event, qint64 ThreadId);
+    void RemoveSample(quint32 Id);
+    HeapThread *Thread(qint64 ThreadId);
+
+    QString m_FileName;                             //!< Path of the profile file
+    quint32 m_SampleInterval;                       //!< Average bytes between two samples
+    QDateTime m_StartTime;                          //!< Start of the profile
+    qint64 m_LiveBytes;                             //!< Estimated live bytes
+    qint64 m_AllocatedBytes;                        //!< Estimated allocated bytes
+    QHash<QByteArray, HeapCallSite *> m_CallSites;  //!< Call sites by their frames
+    QHash<qint64, HeapThread *> m_Threads;          //!< Threads by kernel id
+    QHash<quint32, HeapLiveSample> m_LiveSamples;   //!< Live samples by id
+    QSet<quint32> m_EarlyFrees;                     //!< Frees collected before their allocation
+
+    Q_DISABLE_COPY(HeapProfile)
+};
+
+/****************************************************************************/
+/*!
+ *  \brief  Thread collecting the thread buffers and writing the profile
+ */
+/****************************************************************************/
+class HeapProfileWriter : public QThread
+{
+public:
+    /****************************************************************************/
+    /*!
+     *  \brief  Constructor
+     *
+     *  \iparam DumpInterval = Time between two dumps [s], 0 for none
+     */
+    /****************************************************************************/
+    explicit HeapProfileWriter(int DumpInterval) : m_Stop(0), m_DumpInterval(DumpInterval) {}
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Request the thread to exit
+     */
+    /****************************************************************************/
+    void Stop()
+    {
+        m_Stop.storeRelease(1);
+    }
+
+private:
+    void run();
+
+    QAtomicInt m_Stop;      //!< Exit request
+    int m_DumpInterval;     //!< Time between two dumps [s]
+};
+
+//! Not 0 while sampling
+QAtomicInt s_Active;
+//! Incremented by every start, makes the threads draw a new sample distance
+QAtomicInt s_Generation;
+//! Id of the next sampled block
+QAtomicInt s_NextId;
+//! Samples lost because a buffer or the block table was full
+QAtomicInt s_DroppedSamples;
+//! Average bytes between two samples
+quint32 s_SampleInterval = HeapProfiler::DEFAULT_SAMPLE_INTERVAL;
+//! List of all thread buffers, new buffers are added at the head
+QAtomicPointer<HeapThreadBuffer> s_BufferList;
+//! Sampled blocks, NULL for a free slot
+QAtomicPointer<void> s_SampleKeys[HEAP_SAMPLE_TABLE_SIZE];
+//! Ids of the sampled blocks
+quint32 s_SampleIds[HEAP_SAMPLE_TABLE_SIZE];
+//! Number of sampled blocks in the table, the table is skipped while empty
+QAtomicInt s_SampleCount;
+//! Serializes the access to the profile
+QMutex s_ProfileLock;
+//! The profile, created by the first start and kept until the process ends
+HeapProfile *s_pProfile = NULL;
+//! The running writer thread or NULL
+HeapProfileWriter *s_pWriter = NULL;
+
+//! Buffer of the calling thread
+__thread HeapThreadBuffer *t_pBuffer = NULL;
+//! Not 0 while the calling thread is inside the profiler, its allocations are not sampled
+__thread int t_Busy = 0;
+//! Start the sample distance of the calling thread was drawn for
+__thread int t_Generation = 0;
+//! Bytes the calling thread allocates until the next sample
+__thread qint64 t_BytesUntilSample = 0;
+//! State of the random generator of the calling thread
+__thread quint32 t_Random = 0;
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the buffer of the calling thread, creates it on first use
+ *
+ *      Buffers are kept until the process ends, so the writer thread never
+ *      reads a deleted buffer.
+ *
+ *  \return Buffer of the calling thread
+ */
+/****************************************************************************/
+HeapThreadBuffer *ThreadBuffer()
+{
+    if (t_pBuffer == NULL) {
+        HeapThreadBuffer *pBuffer = new HeapThreadBuffer(static_cast<qint64>(syscall(SYS_gettid)));
+        HeapThreadBuffer *pHead;
+        do {
+            pHead = s_BufferList.loadAcquire();
+            pBuffer->SetNext(pHead);
+        } while (!s_BufferList.testAndSetOrdered(pHead, pBuffer));
+        t_pBuffer = pBuffer;
+    }
+    return t_pBuffer;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Queues an event in the buffer of the calling thread
+ *
+ *      If the buffer is full, the calling thread collects the buffers
+ *      itself, unless the profile is locked. It does not wait for the lock.
+ *
+ *  \iparam Event = The event
+ *
+ *  \return True if queued, false if dropped
+ */
+/****************************************************************************/
+bool QueueEvent(const HeapEvent &Event)
+{
+    HeapThreadBuffer *pBuffer = ThreadBuffer();
+    if (pBuffer->Push(Event)) {
+        return true;
+    }
+    if (!s_ProfileLock.tryLock()) {
+        return false;
+    }
+    s_pProfile->Collect();
+    s_ProfileLock.unlock();
+    return pBuffer->Push(Event);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Draws the bytes until the next sample
+ *
+ *      The distance is exponentially distributed, so every allocated byte
+ *      is sampled with the same probability, whatever the sizes of the
+ *      blocks are.
+ *
+ *  \return Bytes until the next sample
+ */
+/****************************************************************************/
+qint64 NextSampleDistance()
+{
+    // xorshift
+    t_Random ^= t_Random << 13;
+    t_Random ^= t_Random >> 17;
+    t_Random ^= t_Random << 5;
+    double Uniform = (static_cast<double>(t_Random >> 8) + 1.0) / 16777216.0;
+    return static_cast<qint64>(-log(Uniform) * s_SampleInterval) + 1;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Returns the first slot of a block in the table
+ *
+ *  \iparam pMemory = The block
+ *
+ *  \return Slot index
+ */
+/****************************************************************************/
+inline quint32 SampleSlot(const void *pMemory)
+{
+    quint32 Value = static_cast<quint32>(reinterpret_cast<quintptr>(pMemory) >> 4);
+    return (Value * 0x9E3779B1U) >> (32 - HEAP_SAMPLE_TABLE_BITS);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Adds a sampled block to the table
+ *
+ *      Only HEAP_SAMPLE_TABLE_PROBES slots are tried, so a lookup never
+ *      probes more than these.
+ *
+ *  \iparam pMemory = The block
+ *  \iparam Id = Id of the sample
+ *
+ *  \return True if added, false if the slots are in use
+ */
+/****************************************************************************/
+bool InsertSample(void *pMemory, quint32 Id)
+{
+    quint32 Slot = SampleSlot(pMemory);
+    for (int i = 0; i < HEAP_SAMPLE_TABLE_PROBES; i++) {
+        quint32 Index = (Slot + static_cast<quint32>(i)) & (HEAP_SAMPLE_TABLE_SIZE - 1);
+        if (s_SampleKeys[Index].testAndSetAcquire(NULL, pMemory)) {
+            // nobody frees the block before it is returned by malloc
+            s_SampleIds[Index] = Id;
+            (void)s_SampleCount.ref();
+            return true;
+        }
+    }
+    return false;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Removes a block from the table
+ *
+ *  \iparam pMemory = The block
+ *  \oparam Id = Id of the sample
+ *
+ *  \return True if the block was sampled
+ */
+/****************************************************************************/
+bool RemoveSample(void *pMemory, quint32 &Id)
+{
+    quint32 Slot = SampleSlot(pMemory);
+    for (int i = 0; i < HEAP_SAMPLE_TABLE_PROBES; i++) {
+        quint32 Index = (Slot + static_cast<quint32>(i)) & (HEAP_SAMPLE_TABLE_SIZE - 1);
+        if (s_SampleKeys[Index].load() == pMemory) {
+            // the slot is not reused before it is released
+            Id = s_SampleIds[Index];
+            if (s_SampleKeys[Index].testAndSetRelease(pMemory, NULL)) {
+                (void)s_SampleCount.deref();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Checks if a block is in the table
+ *
+ *  \iparam pMemory = The block, may be NULL
+ *
+ *  \return True if the block is sampled
+ */
+/****************************************************************************/
+bool IsSampled(const void *pMemory)
+{
+    if ((pMemory == NULL) || (s_SampleCount.load() == 0)) {
+        return false;
+    }
+    quint32 Slot = SampleSlot(pMemory);
+    for (int i = 0; i < HEAP_SAMPLE_TABLE_PROBES; i++) {
+        quint32 Index = (Slot + static_cast<quint32>(i)) & (HEAP_SAMPLE_TABLE_SIZE - 1);
+        if (s_SampleKeys[Index].load() == pMemory) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Empties the table of sampled blocks
+ */
+/****************************************************************************/
+void ClearSamples()
+{
+    for (int i = 0; i < HEAP_SAMPLE_TABLE_SIZE; i++) {
+        s_SampleKeys[i].store(NULL);
+    }
+    s_SampleCount.store(0);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Records the stack of the calling thread
+ *
+ *  \iparam pCaller = Return address into the caller of the allocator
+ *  \oparam Frames = Return addresses, starting at the caller
+ *
+ *  \return Number of frames
+ */
+/****************************************************************************/
+quint32 CaptureStack(void *pCaller, void **Frames)
+{
+    void *Stack[HEAP_MAX_FRAMES + HEAP_WRAPPER_FRAMES];
+    int Depth = backtrace(Stack, HEAP_MAX_FRAMES + HEAP_WRAPPER_FRAMES);
+    // skip the frames of the profiler, how many depends on the inlining
+    int First = 0;
+    for (int i = 0; i < qMin(Depth, HEAP_WRAPPER_FRAMES + 1); i++) {
+        if (Stack[i] == pCaller) {
+            First = i;
+            break;
+        }
+    }
+    quint32 Count = static_cast<quint32>(qMin(Depth - First, HEAP_MAX_FRAMES));
+    for (quint32 i = 0; i < Count; i++) {
+        Frames[i] = Stack[First + static_cast<int>(i)];
+    }
+    return Count;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Samples an allocation
+ *
+ *  \iparam pMemory = The block
+ *  \iparam Size = Size of the block
+ *  \iparam pCaller = Return address into the caller of the allocator
+ */
+/****************************************************************************/
+__attribute__((noinline)) void SampleAllocation(void *pMemory, size_t Size, void *pCaller)
+{
+    t_Busy++;
+    t_BytesUntilSample = NextSampleDistance();
+
+    HeapEvent Event;
+    Event.Type = HEAP_EVENT_ALLOC;
+    Event.Id = static_cast<quint32>(s_NextId.fetchAndAddRelaxed(1));
+    Event.Size = Size;
+    // a block of Size bytes is sampled with this probability
+    double Probability = 1.0 - exp(-static_cast<double>(Size) / s_SampleInterval);
+    Event.Weight = static_cast<quint64>(static_cast<double>(Size) / Probability + 0.5);
+    Event.Depth = CaptureStack(pCaller, Event.Frames);
+
+    // nobody frees the block before malloc returns, so the order does not matter
+    if (!InsertSample(pMemory, Event.Id)) {
+        (void)s_DroppedSamples.ref();
+    }
+    else if (!QueueEvent(Event)) {
+        quint32 Id;
+        (void)RemoveSample(pMemory, Id);
+        (void)s_DroppedSamples.ref();
+    }
+    t_Busy--;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Counts an allocation towards the next sample
+ *
+ *  \iparam pMemory = The block, may be NULL
+ *  \iparam Size = Size of the block
+ *  \iparam pCaller = Return address into the caller of the allocator
+ */
+/****************************************************************************/
+inline void RecordAllocation(void *pMemory, size_t Size, void *pCaller)
+{
+    if ((pMemory == NULL) || (s_Active.load() == 0) || (t_Busy != 0)) {
+        return;
+    }
+    int Generation = s_Generation.load();
+    if (t_Generation != Generation) {
+        t_Generation = Generation;
+        t_Random = static_cast<quint32>(reinterpret_cast<quintptr>(&t_Random)) ^
+                   (static_cast<quint32>(Generation) * 0x9E3779B9U) ^ static_cast<quint32>(syscall(SYS_gettid));
+        if (t_Random == 0) {
+            t_Random = 1;
+        }
+        t_BytesUntilSample = NextSampleDistance();
+    }
+    t_BytesUntilSample -= static_cast<qint64>(Size);
+    if (t_BytesUntilSample <= 0) {
+        SampleAllocation(pMemory, Size, pCaller);
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Records the free of a block
+ *
+ *      Called before the block is freed, afterwards it may be returned to
+ *      another thread at once.
+ *
+ *  \iparam pMemory = The block, may be NULL
+ */
+/****************************************************************************/
+inline void RecordFree(void *pMemory)
+{
+    quint32 Id;
+    if ((pMemory == NULL) || (s_SampleCount.load() == 0) || !RemoveSample(pMemory, Id)) {
+        return;
+    }
+    if (s_Active.load() == 0) {
+        return;
+    }
+    t_Busy++;
+    HeapEvent Event;
+    Event.Type = HEAP_EVENT_FREE;
+    Event.Id = Id;
+    Event.Size = 0;
+    Event.Weight = 0;
+    Event.Depth = 0;
+    if (!QueueEvent(Event)) {
+        (void)s_DroppedSamples.ref();
+    }
+    t_Busy--;
+}
+
+/****************************************************************************/
+void HeapProfile::Clear()
+{
+    qDeleteAll(m_CallSites);
+    m_CallSites.clear();
+    qDeleteAll(m_Threads);
+    m_Threads.clear();
+    m_LiveSamples.clear();
+    m_EarlyFrees.clear();
+    m_LiveBytes = 0;
+    m_AllocatedBytes = 0;
+}
+
+/****************************************************************************/
+void HeapProfile::Reset(const QString &FileName, quint32 SampleInterval)
+{
+    // events of a previous start
+    Collect();
+    Clear();
+    m_FileName = FileName;
+    m_SampleInterval = SampleInterval;
+    m_StartTime = QDateTime::currentDateTime();
+}
+
+/****************************************************************************/
+HeapThread *HeapProfile::Thread(qint64 ThreadId)
+{
+    HeapThread *pThread = m_Threads.value(ThreadId, NULL);
+    if (pThread == NULL) {
+        pThread = new HeapThread();
+        pThread->LiveBytes = 0;
+        pThread->AllocatedBytes = 0;
+        m_Threads.insert(ThreadId, pThread);
+    }
+    return pThread;
+}
+
+/****************************************************************************/
+void HeapProfile::AddSample(const HeapEvent &Event, qint64 ThreadId)
+{
+    QByteArray Frames(reinterpret_cast<const char *>(Event.Frames), static_cast<int>(Event.Depth * sizeof(void *)));
+    HeapCallSite *pCallSite = m_CallSites.value(Frames, NULL);
+    if (pCallSite == NULL) {
+        pCallSite = new HeapCallSite();
+        pCallSite->Frames = Frames;
+        pCallSite->LiveBytes = 0;
+        pCallSite->LiveSamples = 0;
+        pCallSite->AllocatedBytes = 0;
+        m_CallSites.insert(Frames, pCallSite);
+    }
+    HeapThread *pThread = Thread(ThreadId);
+    qint64 Weight = static_cast<qint64>(Event.Weight);
+    pCallSite->AllocatedBytes += Weight;
+    pThread->AllocatedBytes += Weight;
+    m_AllocatedBytes += Weight;
+
+    // freed by a thread whose buffer was collected first
+    if (m_EarlyFrees.remove(Event.Id)) {
+        return;
+    }
+    HeapLiveSample Sample;
+    Sample.pCallSite = pCallSite;
+    Sample.pThread = pThread;
+    Sample.Weight = Weight;
+    m_LiveSamples.insert(Event.Id, Sample);
+    pCallSite->LiveBytes += Weight;
+    pCallSite->LiveSamples++;
+    pThread->LiveBytes += Weight;
+    m_LiveBytes += Weight;
+}
+
+/****************************************************************************/
+void HeapProfile::RemoveSample(quint32 Id)
+{
+    QHash<quint32, HeapLiveSample>::iterator it = m_LiveSamples.find(Id);
+    if (it == m_LiveSamples.end()) {
+        m_EarlyFrees.insert(Id);
+        return;
+    }
+    it->pCallSite->LiveBytes -= it->Weight;
+    it->pCallSite->LiveSamples--;
+    it->pThread->LiveBytes -= it->Weight;
+    m_LiveBytes -= it->Weight;
+    (void)m_LiveSamples.erase(it);
+}
+
+/****************************************************************************/
+void HeapProfile::Collect()
+{
+    HeapEvent Event;
+    for (HeapThreadBuffer *pBuffer = s_BufferList.loadAcquire(); pBuffer != NULL; pBuffer = pBuffer->Next()) {
+        while (pBuffer->Pop(Event)) {
+            if (Event.Type == HEAP_EVENT_ALLOC) {
+                AddSample(Event, pBuffer->ThreadId());
+            }
+            else {
+                RemoveSample(Event.Id);
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  Orders call sites by live bytes, the largest first
+ *
+ *  \iparam pFirst = A call site
+ *  \iparam pSecond = Another call site
+ *
+ *  \return True if the first one has more live bytes
+ */
+/****************************************************************************/
+bool MoreLiveBytes(const HeapCallSite *pFirst, const HeapCallSite *pSecond)
+{
+    return pFirst->LiveBytes > pSecond->LiveBytes;
+}
+
+/****************************************************************************/
+bool HeapProfile::Write()
+{
+    if (m_FileName.isEmpty()) {
+        return false;
+    }
+    QSaveFile File(m_FileName);
+    if (!File.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream Stream(&File);
+    struct mallinfo Info = mallinfo();
+    Stream << "Heap profile of process " << getpid() << " at "
+           << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
+    Stream << "Started " << m_StartTime.toString(Qt::ISODate) << ", sample interval " << m_SampleInterval
+           << " bytes, " << s_DroppedSamples.load() << " samples dropped\n";
+    Stream << "Estimated live " << m_LiveBytes << " bytes, allocated " << m_AllocatedBytes << " bytes\n";
+    Stream << "malloc in use " << (static_cast<qint64>(Info.uordblks) + Info.hblkhd) << " bytes\n";
+
+    Stream << "\nThreads by live bytes\n";
+    QList<qint64> ThreadIds = m_Threads.keys();
+    QMultiMap<qint64, qint64> ThreadOrder;
+    foreach (qint64 ThreadId, ThreadIds) {
+        HeapThread *pThread = m_Threads.value(ThreadId);
+        // the name of a finished thread is kept
+        QFile Comm(QString("/proc/self/task/%1/comm").arg(ThreadId));
+        if (Comm.open(QIODevice::ReadOnly)) {
+            pThread->Name = QString::fromLocal8Bit(Comm.readAll()).trimmed();
+        }
+        ThreadOrder.insert(-pThread->LiveBytes, ThreadId);
+    }
+    foreach (qint64 ThreadId, ThreadOrder.values()) {
+        const HeapThread *pThread = m_Threads.value(ThreadId);
+        Stream << "  " << ThreadId << " " << (pThread->Name.isEmpty() ? QString("?") : pThread->Name)
+               << ": live " << pThread->LiveBytes << " bytes, allocated " << pThread->AllocatedBytes << " bytes\n";
+    }
+
+    Stream << "\nCall sites by live bytes\n";
+    QList<HeapCallSite *> CallSites = m_CallSites.values();
+    qSort(CallSites.begin(), CallSites.end(), MoreLiveBytes);
+    for (int i = 0; (i < CallSites.count()) && (i < HEAP_DUMP_CALL_SITES); i++) {
+        const HeapCallSite *pCallSite = CallSites.at(i);
+        Stream << "  live " << pCallSite->LiveBytes << " bytes in " << pCallSite->LiveSamples
+               << " samples, allocated " << pCallSite->AllocatedBytes << " bytes\n";
+        void *const *Frames = reinterpret_cast<void *const *>(pCallSite->Frames.constData());
+        int Depth = pCallSite->Frames.size() / static_cast<int>(sizeof(void *));
+        char **Symbols = backtrace_symbols(Frames, Depth);
+        for (int Frame = 0; Frame < Depth; Frame++) {
+            Stream << "    #" << Frame << " ";
+            if (Symbols != NULL) {
+                Stream << Symbols[Frame] << "\n";
+            }
+            else {
+                Stream << Frames[Frame] << "\n";
+            }
+        }
+        free(Symbols);
+    }
+    Stream.flush();
+    return File.commit();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief  The writer thread's execution function
+ *
+ *      The function collects the thread buffers every
+ *      HEAP_DRAIN_INTERVAL_MS and writes the profile once per dump interval.
+ */
+/****************************************************************************/
+void HeapProfileWriter::run()
+{
+    // the profiler's own allocations are not sampled
+    t_Busy++;
+    QElapsedTimer SinceDump;
+    SinceDump.start();
+    while (m_Stop.loadAcquire() == 0) {
+        QThread::msleep(HEAP_DRAIN_INTERVAL_MS);
+        QMutexLocker Locker(&s_ProfileLock);
+        s_pProfile->Collect();
+        if ((m_DumpInterval > 0) && (SinceDump.elapsed() >= static_cast<qint64>(m_DumpInterval) * 1000)) {
+            if (!s_pProfile->Write()) {
+                qDebug() << "HeapProfiler: cannot write the profile";
+            }
+            SinceDump.restart();
+        }
+    }
+    t_Busy--;
+}
+
+} // end namespace
+
+/****************************************************************************/
+bool HeapProfiler::Start(const QString &FileName, quint32 SampleInterval, int DumpInterval) {
+    if ((s_Active.loadAcquire() != 0) || (SampleInterval == 0)) {
+        return false;
+    }
+    t_Busy++;
+    // the unwinder allocates on its first use
+    void *Frames[2];
+    (void)backtrace(Frames, 2);
+    {
+        QMutexLocker Locker(&s_ProfileLock);
+        if (s_pProfile == NULL) {
+            s_pProfile = new HeapProfile();
+        }
+        ClearSamples();
+        s_pProfile->Reset(FileName, SampleInterval);
+    }
+    s_SampleInterval = SampleInterval;
+    s_DroppedSamples.store(0);
+    (void)s_Generation.ref();
+    s_Active.storeRelease(1);
+    s_pWriter = new HeapProfileWriter(DumpInterval);
+    s_pWriter->start(QThread::LowPriority);
+    t_Busy--;
+    qDebug() << "HeapProfiler: sampling every" << SampleInterval << "bytes, profile" << FileName;
+    return true;
+}
+
+/****************************************************************************/
+void HeapProfiler::Stop() {
+    if (s_Active.loadAcquire() == 0) {
+        return;
+    }
+    s_Active.storeRelease(0);
+    s_pWriter->Stop();
+    (void)s_pWriter->wait();
+    delete s_pWriter;
+    s_pWriter = NULL;
+    if (!Dump()) {
+        qDebug() << "HeapProfiler: cannot write the profile";
+    }
+}
+
+/****************************************************************************/
+bool HeapProfiler::IsActive() {
+    return s_Active.loadAcquire() != 0;
+}
+
+/****************************************************************************/
+bool HeapProfiler::Dump() {
+    t_Busy++;
+    bool Result = false;
+    {
+        QMutexLocker Locker(&s_ProfileLock);
+        if (s_pProfile != NULL) {
+            s_pProfile->Collect();
+            Result = s_pProfile->Write();
+        }
+    }
+    t_Busy--;
+    return Result;
+}
+
+/****************************************************************************/
+qint64 HeapProfiler::LiveBytes() {
+    t_Busy++;
+    qint64 Result = 0;
+    {
+        QMutexLocker Locker(&s_ProfileLock);
+        if (s_pProfile != NULL) {
+            s_pProfile->Collect();
+            Result = s_pProfile->LiveBytes();
+        }
+    }
+    t_Busy--;
+    return Result;
+}
+
+/****************************************************************************/
+qint64 HeapProfiler::AllocatedBytes() {
+    t_Busy++;
+    qint64 Result = 0;
+    {
+        QMutexLocker Locker(&s_ProfileLock);
+        if (s_pProfile != NULL) {
+            s_pProfile->Collect();
+            Result = s_pProfile->AllocatedBytes();
+        }
+    }
+    t_Busy--;
+    return Result;
+}
+
+/****************************************************************************/
+int HeapProfiler::DroppedSamples() {
+    return s_DroppedSamples.load();
+}
+
+#else
+
+/****************************************************************************/
+bool HeapProfiler::Start(const QString &FileName, quint32 SampleInterval, int DumpInterval) {
+    Q_UNUSED(FileName);
+    Q_UNUSED(SampleInterval);
+    Q_UNUSED(DumpInterval);
+    // the allocator is not wrapped in this build
+    return false;
+}
+
+/****************************************************************************/
+void HeapProfiler::Stop() {
+}
+
+/****************************************************************************/
+bool HeapProfiler::IsActive() {
+    return false;
+}
+
+/****************************************************************************/
+bool HeapProfiler::Dump() {
+    return false;
+}
+
+/****************************************************************************/
+qint64 HeapProfiler::LiveBytes() {
+    return 0;
+}
+
+/****************************************************************************/
+qint64 HeapProfiler::AllocatedBytes() {
+    return 0;
+}
+
+/****************************************************************************/
+int HeapProfiler::DroppedSamples() {
+    return 0;
+}
+
+#endif
+
+/****************************************************************************/
+bool HeapProfiler::IsAvailable() {
+#ifdef HEAP_PROFILER_WRAPPER
+    return true;
+#else
+    return false;
+#endif
+}
+
+/****************************************************************************/
+bool HeapProfiler::StartFromEnvironment(const QString &FileName) {
+    bool Ok = false;
+    quint32 SampleInterval = qgetenv("HEAP_PROFILE_INTERVAL").toUInt(&Ok);
+    if (!Ok || (SampleInterval == 0)) {
+        return false;
+    }
+    int DumpInterval = qgetenv("HEAP_PROFILE_DUMP_INTERVAL").toInt(&Ok);
+    if (!Ok || (DumpInterval < 0)) {
+        DumpInterval = DEFAULT_DUMP_INTERVAL;
+    }
+    return Start(FileName, SampleInterval, DumpInterval);
+}
+
+} // end namespace Global
+
+#ifdef HEAP_PROFILER_WRAPPER
+
+/*lint -save -e1548 -e1960 */
+// memalign, posix_memalign and valloc are not wrapped. Their blocks are not
+// sampled, freeing them only probes the table.
+
+/****************************************************************************/
+void *malloc(size_t Size) __THROW
+{
+    void *pMemory = __libc_malloc(Size);
+    Global::RecordAllocation(pMemory, Size, __builtin_return_address(0));
+    return pMemory;
+}
+
+/****************************************************************************/
+void *calloc(size_t Count, size_t Size) __THROW
+{
+    void *pMemory = __libc_calloc(Count, Size);
+    Global::RecordAllocation(pMemory, Count * Size, __builtin_return_address(0));
+    return pMemory;
+}
+
+/****************************************************************************/
+void *realloc(void *pMemory, size_t Size) __THROW
+{
+    if ((pMemory != NULL) && (Size == 0)) {
+        // frees the block
+        Global::RecordFree(pMemory);
+        return __libc_realloc(pMemory, Size);
+    }
+    if (Global::IsSampled(pMemory)) {
+        // the free is recorded before the block is released and only if the
+        // new block exists, so a sampled block is moved here
+        void *pResult = __libc_malloc(Size);
+        if (pResult != NULL) {
+            size_t OldSize = malloc_usable_size(pMemory);
+            memcpy(pResult, pMemory, (OldSize < Size) ? OldSize : Size);
+            Global::RecordFree(pMemory);
+            __libc_free(pMemory);
+            Global::RecordAllocation(pResult, Size, __builtin_return_address(0));
+        }
+        return pResult;
+    }
+    void *pResult = __libc_realloc(pMemory, Size);
+    Global::RecordAllocation(pResult, Size, __builtin_return_address(0));
+    return pResult;
+}
+
+/****************************************************************************/
+void free(void *pMemory) __THROW
+{
+    Global::RecordFree(pMemory);
+    __libc_free(pMemory);
+}
+/*lint -restore */
+
+#endif
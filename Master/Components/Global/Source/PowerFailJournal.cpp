@@ -0,0 +1,183 @@
+/****************************************************************************/
+/*! \file Global/Source/PowerFailJournal.cpp
+ *
+ *  \brief Implementation file for class PowerFailJournal.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <Global/Include/PowerFailJournal.h>
+#include <QMutexLocker>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Global {
+
+/****************************************************************************/
+PowerFailJournal::PowerFailJournal() :
+    mp_Map(NULL),
+    m_MapSize(PFJ_SLOT_COUNT * 2 * PFJ_RECORD_SIZE),
+    m_Fd(-1),
+    m_Committers(0)
+{
+}
+
+/****************************************************************************/
+PowerFailJournal::~PowerFailJournal() {
+    Close();
+}
+
+/****************************************************************************/
+bool PowerFailJournal::Open(const QString &FileName) {
+    QMutexLocker OpenLocker(&m_OpenMutex);
+    if (IsOpen()) {
+        return false;
+    }
+    m_Fd = open(FileName.toLocal8Bit().constData(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (m_Fd < 0) {
+        return false;
+    }
+    struct stat Stat;
+    if ((fstat(m_Fd, &Stat) != 0) ||
+        ((Stat.st_size < m_MapSize) && ((ftruncate(m_Fd, m_MapSize) != 0) || (fsync(m_Fd) != 0)))) {
+        (void)close(m_Fd);
+        m_Fd = -1;
+        return false;
+    }
+    void *p_Map = mmap(NULL, m_MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_Fd, 0);
+    if (p_Map == MAP_FAILED) {
+        (void)close(m_Fd);
+        m_Fd = -1;
+        return false;
+    }
+    // not fatal, the pages are faulted in by the first records then
+    (void)mlock(p_Map, m_MapSize);
+    mp_Map.storeRelease(static_cast<char *>(p_Map));
+    return true;
+}
+
+/****************************************************************************/
+void PowerFailJournal::Close() {
+    QMutexLocker OpenLocker(&m_OpenMutex);
+    if (!IsOpen()) {
+        return;
+    }
+    for (int i = 0; i < PFJ_SLOT_COUNT; i++) {
+        m_Mutex[i].lock();
+    }
+    char *p_Map = mp_Map.fetchAndStoreOrdered(NULL);
+    // a commit which has seen the mapping still uses it
+    while (m_Committers.loadAcquire() != 0) {
+        (void)usleep(100);
+    }
+    (void)msync(p_Map, m_MapSize, MS_SYNC);
+    (void)munmap(p_Map, m_MapSize);
+    (void)close(m_Fd);
+    m_Fd = -1;
+    for (int i = PFJ_SLOT_COUNT - 1; i >= 0; i--) {
+        m_Mutex[i].unlock();
+    }
+}
+
+/****************************************************************************/
+bool PowerFailJournal::Stage(PowerFailJournalSlot_t Slot, const QByteArray &Record) {
+    if ((Slot < 0) || (Slot >= PFJ_SLOT_COUNT) || (Record.size() > PFJ_PAYLOAD_SIZE)) {
+        return false;
+    }
+    QMutexLocker Locker(&m_Mutex[Slot]);
+    if (!IsOpen()) {
+        return false;
+    }
+
+    int Current = Latest(Slot);
+    quint32 Sequence = 1;
+    if (Current >= 0) {
+        Sequence = reinterpret_cast<RecordHeader *>(Buffer(Slot, Current))->Sequence + 1;
+    }
+    // overwrite the older buffer, the latest record stays intact meanwhile
+    int Next = (Current == 0) ? 1 : 0;
+    RecordHeader *p_Header = reinterpret_cast<RecordHeader *>(Buffer(Slot, Next));
+    char *p_Payload = Buffer(Slot, Next) + PFJ_HEADER_SIZE;
+
+    p_Header->Sequence = 0;
+    __sync_synchronize();
+    memcpy(p_Payload, Record.constData(), Record.size());
+    p_Header->Length = Record.size();
+    p_Header->Reserved = 0;
+    p_Header->Checksum = 0;
+    RecordHeader Header = *p_Header;
+    Header.Sequence = Sequence;
+    p_Header->Checksum = Checksum(&Header, p_Payload);
+    __sync_synchronize();
+    p_Header->Sequence = Sequence;
+    return true;
+}
+
+/****************************************************************************/
+bool PowerFailJournal::Commit() {
+    // register before the mapping is read, so Close does not unmap it meanwhile
+    (void)m_Committers.fetchAndAddOrdered(1);
+    char *p_Map = mp_Map.loadAcquire();
+    bool Result = (p_Map != NULL) && (msync(p_Map, m_MapSize, MS_SYNC) == 0);
+    (void)m_Committers.fetchAndAddOrdered(-1);
+    return Result;
+}
+
+/****************************************************************************/
+bool PowerFailJournal::Load(PowerFailJournalSlot_t Slot, QByteArray &Record) const {
+    if ((Slot < 0) || (Slot >= PFJ_SLOT_COUNT)) {
+        return false;
+    }
+    QMutexLocker Locker(&m_Mutex[Slot]);
+    if (!IsOpen()) {
+        return false;
+    }
+    int Current = Latest(Slot);
+    if (Current < 0) {
+        return false;
+    }
+    const RecordHeader *p_Header = reinterpret_cast<const RecordHeader *>(Buffer(Slot, Current));
+    Record = QByteArray(Buffer(Slot, Current) + PFJ_HEADER_SIZE, p_Header->Length);
+    return true;
+}
+
+/****************************************************************************/
+quint32 PowerFailJournal::Checksum(const RecordHeader *p_Header, const char *p_Payload) {
+    quint16 HeaderChecksum = qChecksum(reinterpret_cast<const char *>(p_Header), 2 * sizeof(quint32));
+    quint16 PayloadChecksum = qChecksum(p_Payload, p_Header->Length);
+    return (static_cast<quint32>(HeaderChecksum) << 16) | PayloadChecksum;
+}
+
+/****************************************************************************/
+int PowerFailJournal::Latest(int Slot) const {
+    int Latest = -1;
+    quint32 LatestSequence = 0;
+    for (int Half = 0; Half < 2; Half++) {
+        const RecordHeader *p_Header = reinterpret_cast<const RecordHeader *>(Buffer(Slot, Half));
+        if ((p_Header->Sequence == 0) || (p_Header->Length > static_cast<quint32>(PFJ_PAYLOAD_SIZE)) ||
+            (p_Header->Checksum != Checksum(p_Header, Buffer(Slot, Half) + PFJ_HEADER_SIZE))) {
+            continue;
+        }
+        if ((Latest < 0) || (p_Header->Sequence > LatestSequence)) {
+            Latest = Half;
+            LatestSequence = p_Header->Sequence;
+        }
+    }
+    return Latest;
+}
+
+} // end namespace Global
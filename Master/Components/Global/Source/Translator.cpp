@@ -45,6 +45,7 @@ void Translator::Reset() {
     QWriteLocker WL(&m_SyncObject);
     // free all resources
     m_Translations.clear();
+    m_Catalogs.clear();
     // reset m_FallbackLanguage
     m_DefaultLanguage = QLocale::C;
     m_FallbackLanguage = QLocale::C;
@@ -55,6 +56,21 @@ void Translator::SetLanguageData(QLocale::Language TheLanguage, const tLanguageD
                                  bool SetAsDefaultLanguage, bool SetAsFallbackLanguage) {
     QWriteLocker WL(&m_SyncObject);
     m_Translations.insert(TheLanguage, LanguageData);
+    (void)m_Catalogs.remove(TheLanguage);
+    if(SetAsDefaultLanguage) {
+        m_DefaultLanguage = TheLanguage;
+    }
+    if(SetAsFallbackLanguage) {
+        m_FallbackLanguage = TheLanguage;
+    }
+}
+
+/****************************************************************************/
+void Translator::SetLanguageCatalog(QLocale::Language TheLanguage, const tLanguageCatalog &Catalog,
+                                    bool SetAsDefaultLanguage, bool SetAsFallbackLanguage) {
+    QWriteLocker WL(&m_SyncObject);
+    m_Catalogs.insert(TheLanguage, Catalog);
+    (void)m_Translations.remove(TheLanguage);
     if(SetAsDefaultLanguage) {
         m_DefaultLanguage = TheLanguage;
     }
@@ -68,6 +84,7 @@ void Translator::RemoveLanguageData(QLocale::Language TheLanguage) {
     QWriteLocker WL(&m_SyncObject);
     // remove language data
     m_Translations.remove(TheLanguage);
+    m_Catalogs.remove(TheLanguage);
     // check if it was default language
     if(m_DefaultLanguage == TheLanguage) {
         // set default language to undefined
@@ -84,7 +101,7 @@ void Translator::RemoveLanguageData(QLocale::Language TheLanguage) {
 void Translator::SetDefaultLanguage(QLocale::Language TheLanguage) {
     QWriteLocker WL(&m_SyncObject);
     // check if language exists
-    if(!m_Translations.contains(TheLanguage)) {
+    if(!HasLanguage(TheLanguage)) {
         // Language does not exist. Keep old default language.
         return;
     }
@@ -102,7 +119,7 @@ QLocale::Language Translator::GetDefaultLanguage() const {
 void Translator::SetFallbackLanguage(QLocale::Language TheLanguage) {
     QWriteLocker WL(&m_SyncObject);
     // check if language exists
-    if(!m_Translations.contains(TheLanguage)) {
+    if(!HasLanguage(TheLanguage)) {
         // Language does not exist. Keep old fallback language.
         return;
     }
@@ -162,6 +179,28 @@ void Translator::InsertArguments(QString &rString, const QStringList &ArgumentLi
     }
 }
 
+/****************************************************************************/
+bool Translator::HasLanguage(QLocale::Language TheLanguage) const {
+    return m_Translations.contains(TheLanguage) || m_Catalogs.contains(TheLanguage);
+}
+
+/****************************************************************************/
+bool Translator::FindStrings(QLocale::Language TheLanguage, quint32 StringID, QStringList &rStrings) const {
+    tTranslations::const_iterator it = m_Translations.find(TheLanguage);
+    if(it != m_Translations.constEnd()) {
+        tLanguageData::const_iterator it2 = (*it).find(StringID);
+        if(it2 == (*it).constEnd()) {
+            return false;
+        }
+        rStrings = *it2;
+        return true;
+    }
+    // the record references the catalog, decode it right away
+    QByteArray Record;
+    const tLanguageCatalog Catalog = m_Catalogs.value(TheLanguage);
+    return !Catalog.isNull() && Catalog->Find(StringID, Record) && BinaryCatalog::DecodeStrings(Record, rStrings);
+}
+
 /****************************************************************************/
 QString Translator::GenerateMinimalString(quint32 StringID) const {
     return QString("\"") + QString::number(StringID, 10) + "\":";
@@ -180,8 +219,8 @@ QString Translator::TranslateToLanguage(QLocale::Language TheLanguage, const Tra
     quint32 StringID = String.GetStringID();
     const tTranslatableStringList & ArgumentList = String.GetArgumentList();
     // check if language exists
-    tTranslations::const_iterator it = m_Translations.find(TheLanguage);
-    if(it == m_Translations.constEnd()) {
+    QStringList StringList;
+    if(!HasLanguage(TheLanguage)) {
         // language not found.
         // check if already fallback language or undefined fallback language
         if((TheLanguage == m_FallbackLanguage) || (QLocale::C == m_FallbackLanguage)){
@@ -198,11 +237,9 @@ QString Translator::TranslateToLanguage(QLocale::Language TheLanguage, const Tra
         }
     } else {
         // language found. now get string
-        tLanguageData::const_iterator it2 = (*it).find(StringID);
-        if(it2 == (*it).constEnd()) {
+        if(!FindStrings(TheLanguage, StringID, StringList)) {
             // string not found. Get string for EVENT_GLOBAL_UNKNOWN_STRING_ID
-            it2 = (*it).find(EVENT_GLOBAL_UNKNOWN_STRING_ID);
-            if(it2 == (*it).constEnd()) {
+            if(!FindStrings(TheLanguage, EVENT_GLOBAL_UNKNOWN_STRING_ID, StringList)) {
                 // text for EVENT_GLOBAL_UNKNOWN_STRING_ID also not found.
                 // Take some extremely basic string with only the string id.
                 Result = GenerateMinimalString(StringID);
@@ -210,7 +247,6 @@ QString Translator::TranslateToLanguage(QLocale::Language TheLanguage, const Tra
                 // translation for EVENT_GLOBAL_UNKNOWN_STRING_ID found. Insert StringID
                 QStringList tmp;
                 tmp << QString::number(StringID, 10);
-                QStringList StringList = *it2;
                 if (StringList.size() >= 1) {
                     Result = StringList.at(0);
                 }
@@ -223,7 +259,6 @@ QString Translator::TranslateToLanguage(QLocale::Language TheLanguage, const Tra
             }
         } else {
             // string found
-            QStringList StringList = *it2;
             if (StringList.size() == 2) {
                 if (UseAlternateString) {
                     qDebug()<<"Translator:Alternate String \n\n\n";
@@ -258,7 +293,7 @@ QString Translator::Translate(const TranslatableString &String, const bool UseAl
 
 /****************************************************************************/
 QList<QLocale::Language> Translator::GetLanguages() const {
-    return m_Translations.keys();
+    return m_Translations.keys() + m_Catalogs.keys();
 }
 
 } // end namespace Global
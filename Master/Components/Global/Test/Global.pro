@@ -15,7 +15,13 @@ SUBDIRS = TestAbstractFactory.pro \
           TestTranslatableString.pro \
           TestTranslator.pro \
           TestUtils.pro \
-          TestCommands.pro
+          TestCommands.pro \
+          TestTimerWheel.pro \
+          TestPowerFailJournal.pro \
+          TestPriorityQueue.pro \
+          TestBinaryCatalog.pro \
+          TestHeapProfiler.pro \
+          TestAudioEngine.pro
 
 # Tests for IndexT class
 #
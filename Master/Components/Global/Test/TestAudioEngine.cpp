@@ -0,0 +1,371 @@
+/****************************************************************************/
+/*! \file TestAudioEngine.cpp
+ *
+ *  \brief Implementation file for class TestAudioEngine.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QAtomicInt>
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <Global/Include/AudioEngine.h>
+
+namespace Global {
+
+static const int TEST_SAMPLE_RATE = 22050;  ///< Frames per second of the test sounds.
+static const int TEST_FRAMES = 2205;        ///< Frames of the test sounds, 100 ms.
+static const int TEST_PLAYS = 50;           ///< Plays of the latency test.
+
+/****************************************************************************/
+/**
+ * \brief Creates a wave file with a constant sample value.
+ *
+ * \iparam  SampleRate  Frames per second.
+ * \iparam  Channels    Samples per frame.
+ * \iparam  Bits        Bits per sample.
+ * \iparam  Frames      Number of frames.
+ * \iparam  Value       Raw value of all samples.
+ *
+ * \return  Content of the wave file.
+ */
+/****************************************************************************/
+static QByteArray MakeWave(int SampleRate, int Channels, int Bits, int Frames, int Value) {
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 DataSize = static_cast<quint32>(Frames * Channels * Bits / 8);
+    (void)Stream.writeRawData("RIFF", 4);
+    Stream << static_cast<quint32>(36 + DataSize);
+    (void)Stream.writeRawData("WAVEfmt ", 8);
+    Stream << static_cast<quint32>(16) << static_cast<quint16>(1) << static_cast<quint16>(Channels)
+           << static_cast<quint32>(SampleRate) << static_cast<quint32>(SampleRate * Channels * Bits / 8)
+           << static_cast<quint16>(Channels * Bits / 8) << static_cast<quint16>(Bits);
+    (void)Stream.writeRawData("data", 4);
+    Stream << DataSize;
+    for (int i = 0; i < Frames * Channels; i++) {
+        if (Bits == 8) {
+            Stream << static_cast<quint8>(Value);
+        } else {
+            Stream << static_cast<qint16>(Value);
+        }
+    }
+    return Data;
+}
+
+/****************************************************************************/
+/**
+ * \brief Sink failing to write until it is repaired.
+ */
+/****************************************************************************/
+class FailingSink : public AudioSink {
+public:
+    FailingSink() : m_Writes(0), m_Broken(1) {}
+    bool Open(int SampleRate, int Channels, int PeriodFrames) {
+        Q_UNUSED(SampleRate);
+        Q_UNUSED(Channels);
+        Q_UNUSED(PeriodFrames);
+        return true;
+    }
+    bool Write(const qint16 *p_Samples, int Frames) {
+        Q_UNUSED(p_Samples);
+        Q_UNUSED(Frames);
+        (void)m_Writes.fetchAndAddOrdered(1);
+        return (m_Broken.loadAcquire() == 0);
+    }
+    void Close() {}
+    bool IsPaced() const {
+        return false;
+    }
+
+    QAtomicInt  m_Writes;   ///< Calls of Write.
+    QAtomicInt  m_Broken;   ///< Set while writing fails.
+}; // end class FailingSink
+
+/****************************************************************************/
+/**
+ * \brief Test class for AudioEngine class.
+ */
+/****************************************************************************/
+class TestAudioEngine : public QObject {
+    Q_OBJECT
+private:
+    QString     m_LowSound;     ///< Sound file with the value 10000.
+    QString     m_HighSound;    ///< Sound file with the value 30000.
+    QString     m_OutputFile;   ///< Output of the file sink.
+
+    /****************************************************************************/
+    /**
+     * \brief Writes a file.
+     *
+     * \iparam  FileName    Path of the file.
+     * \iparam  Data        Content.
+     */
+    /****************************************************************************/
+    void WriteFile(const QString &FileName, const QByteArray &Data) {
+        QFile File(FileName);
+        QVERIFY(File.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(File.write(Data), static_cast<qint64>(Data.size()));
+    }
+
+    /****************************************************************************/
+    /**
+     * \brief Waits until no sound is playing.
+     *
+     * \iparam  Engine  The engine.
+     */
+    /****************************************************************************/
+    void WaitSilent(const AudioEngine &Engine) {
+        QElapsedTimer Timer;
+        Timer.start();
+        while ((Engine.ActiveVoices() > 0) && (Timer.elapsed() < 5000)) {
+            QTest::qWait(10);
+        }
+        QCOMPARE(Engine.ActiveVoices(), 0);
+    }
+
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of decoding and converting wave files.
+     */
+    /****************************************************************************/
+    void utTestDecodeWave();
+    /****************************************************************************/
+    /**
+     * \brief Test of mixing with volume and of the voices.
+     */
+    /****************************************************************************/
+    void utTestMix();
+    /****************************************************************************/
+    /**
+     * \brief Test of playing into the file sink.
+     */
+    /****************************************************************************/
+    void utTestFileSink();
+    /****************************************************************************/
+    /**
+     * \brief Measure the latency from Play to the sink.
+     */
+    /****************************************************************************/
+    void utTestLatency();
+    /****************************************************************************/
+    /**
+     * \brief Test of the back off while the sink fails.
+     */
+    /****************************************************************************/
+    void utTestSinkFailure();
+}; // end class TestAudioEngine
+
+/****************************************************************************/
+void TestAudioEngine::initTestCase() {
+    m_LowSound = QDir::tempPath() + "/utTestAudioEngineLow.wav";
+    m_HighSound = QDir::tempPath() + "/utTestAudioEngineHigh.wav";
+    m_OutputFile = QDir::tempPath() + "/utTestAudioEngineOutput.wav";
+    WriteFile(m_LowSound, MakeWave(TEST_SAMPLE_RATE, 1, 16, TEST_FRAMES, 10000));
+    WriteFile(m_HighSound, MakeWave(AudioEngine::DEFAULT_SAMPLE_RATE, 2, 16, TEST_FRAMES, 30000));
+}
+
+/****************************************************************************/
+void TestAudioEngine::init() {
+}
+
+/****************************************************************************/
+void TestAudioEngine::cleanup() {
+    (void)QFile::remove(m_OutputFile);
+}
+
+/****************************************************************************/
+void TestAudioEngine::cleanupTestCase() {
+    (void)QFile::remove(m_LowSound);
+    (void)QFile::remove(m_HighSound);
+}
+
+/****************************************************************************/
+void TestAudioEngine::utTestDecodeWave() {
+    QVector<qint16> Samples;
+
+    // mono is doubled, the rate converted
+    QVERIFY(AudioEngine::DecodeWave(MakeWave(TEST_SAMPLE_RATE, 1, 16, TEST_FRAMES, -1234), 44100, Samples));
+    QCOMPARE(Samples.count(), 2 * TEST_FRAMES * AudioEngine::CHANNELS);
+    QCOMPARE(Samples.first(), static_cast<qint16>(-1234));
+    QCOMPARE(Samples.last(), static_cast<qint16>(-1234));
+
+    // 8 bit samples are unsigned
+    QVERIFY(AudioEngine::DecodeWave(MakeWave(44100, 2, 8, 100, 255), 44100, Samples));
+    QCOMPARE(Samples.count(), 100 * AudioEngine::CHANNELS);
+    QCOMPARE(Samples.at(0), static_cast<qint16>(127 << 8));
+    QVERIFY(AudioEngine::DecodeWave(MakeWave(44100, 1, 8, 100, 0), 44100, Samples));
+    QCOMPARE(Samples.at(1), static_cast<qint16>(-32768));
+
+    // a truncated data chunk is used as far as it goes
+    QByteArray Data = MakeWave(44100, 1, 16, 100, 1);
+    Data.chop(100);
+    QVERIFY(AudioEngine::DecodeWave(Data, 44100, Samples));
+    QCOMPARE(Samples.count(), 50 * AudioEngine::CHANNELS);
+
+    // unsupported files
+    QVERIFY(!AudioEngine::DecodeWave(QByteArray("OggS and more bytes"), 44100, Samples));
+    QVERIFY(Samples.isEmpty());
+    QVERIFY(!AudioEngine::DecodeWave(MakeWave(44100, 1, 16, 100, 1).left(30), 44100, Samples));
+    QVERIFY(!AudioEngine::DecodeWave(MakeWave(44100, 1, 24, 100, 1), 44100, Samples));
+    QVERIFY(!AudioEngine::DecodeWave(MakeWave(44100, 3, 16, 100, 1), 44100, Samples));
+}
+
+/****************************************************************************/
+void TestAudioEngine::utTestMix() {
+    AudioEngine Engine;
+    QVector<qint32> Mix(AudioEngine::DEFAULT_PERIOD_FRAMES * AudioEngine::CHANNELS);
+    QVector<qint16> Output(AudioEngine::DEFAULT_PERIOD_FRAMES * AudioEngine::CHANNELS);
+    QVector<qint64> PlayTimes;
+
+    QVERIFY(!Engine.Play(m_LowSound, 100));
+    QVERIFY(Engine.LoadSound(m_LowSound));
+    QVERIFY(Engine.LoadSound(m_HighSound));
+    QVERIFY(Engine.IsLoaded(m_LowSound));
+    QVERIFY(!Engine.LoadSound(QDir::tempPath() + "/utTestAudioEngineMissing.wav"));
+
+    // silence while nothing plays
+    Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+    QCOMPARE(Output.at(0), static_cast<qint16>(0));
+    QVERIFY(PlayTimes.isEmpty());
+
+    // the volume scales the samples
+    QVERIFY(Engine.Play(m_LowSound, 50));
+    QCOMPARE(Engine.ActiveVoices(), 1);
+    Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+    QCOMPARE(Output.at(0), static_cast<qint16>(5000));
+    QCOMPARE(PlayTimes.count(), 1);
+    Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+    QVERIFY(PlayTimes.isEmpty());
+
+    // the sounds are added and saturated
+    QVERIFY(Engine.Play(m_HighSound, 100));
+    QCOMPARE(Engine.ActiveVoices(), 2);
+    Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+    QCOMPARE(Output.at(0), static_cast<qint16>(32767));
+
+    // a sound playing again uses its voice
+    QVERIFY(Engine.Play(m_HighSound, 10));
+    QCOMPARE(Engine.ActiveVoices(), 2);
+    Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+    QVERIFY(qAbs(Output.at(0) - 8000) <= 1);
+
+    // a voice is freed at the end of its sound
+    for (int i = 0; i < 20; i++) {
+        Engine.MixPeriod(Mix.data(), Output.data(), PlayTimes);
+    }
+    QCOMPARE(Engine.ActiveVoices(), 0);
+    QCOMPARE(Output.at(0), static_cast<qint16>(0));
+
+    QVERIFY(Engine.Play(m_LowSound, 100));
+    Engine.StopAll();
+    QCOMPARE(Engine.ActiveVoices(), 0);
+}
+
+/****************************************************************************/
+void TestAudioEngine::utTestFileSink() {
+    AudioEngine Engine;
+    QVERIFY(Engine.LoadSound(m_HighSound));
+    QVERIFY(!Engine.Start(NULL));
+    QVERIFY(Engine.Start(new AudioFileSink(m_OutputFile)));
+    QVERIFY(Engine.IsRunning());
+    QVERIFY(!Engine.Start(new AudioNullSink()));
+
+    QVERIFY(Engine.Play(m_HighSound, 50));
+    WaitSilent(Engine);
+    Engine.Stop();
+    QVERIFY(!Engine.IsRunning());
+
+    // the written file is a wave file again
+    QFile File(m_OutputFile);
+    QVERIFY(File.open(QIODevice::ReadOnly));
+    QVector<qint16> Samples;
+    QVERIFY(AudioEngine::DecodeWave(File.readAll(), AudioEngine::DEFAULT_SAMPLE_RATE, Samples));
+    QVERIFY(Samples.count() >= TEST_FRAMES * AudioEngine::CHANNELS);
+    QCOMPARE(Samples.count(static_cast<qint16>(15000)), TEST_FRAMES * AudioEngine::CHANNELS);
+}
+
+/****************************************************************************/
+void TestAudioEngine::utTestLatency() {
+    AudioEngine Engine;
+    QVERIFY(Engine.LoadSound(m_LowSound));
+    QVERIFY(Engine.Start(new AudioNullSink()));
+    for (int i = 0; i < TEST_PLAYS; i++) {
+        QVERIFY(Engine.Play(m_LowSound, 100));
+        // longer than a period, so no Play replaces one not mixed yet
+        QTest::qWait(50);
+    }
+    WaitSilent(Engine);
+    Engine.Stop();
+
+    // a sound is mixed within about a period
+    qDebug() << "Play to sink, period" << AudioEngine::DEFAULT_PERIOD_FRAMES << "frames:"
+             << Engine.PlayLatency().ToString();
+    QCOMPARE(Engine.PlayLatency().Total(), static_cast<qint64>(TEST_PLAYS));
+    QVERIFY(Engine.PlayLatency().Percentile(50) < 100000);
+}
+
+/****************************************************************************/
+void TestAudioEngine::utTestSinkFailure() {
+    AudioEngine Engine;
+    FailingSink *p_Sink = new FailingSink();
+    QVERIFY(Engine.Start(p_Sink));
+
+    // about 50 periods, the engine backs off after each failure
+    QTest::qWait(500);
+    int Writes = p_Sink->m_Writes.loadAcquire();
+    QVERIFY(Writes > 0);
+    QVERIFY(Writes < 15);
+
+    // the engine writes again once the sink works
+    p_Sink->m_Broken.storeRelease(0);
+    QTest::qWait(1500);
+    QVERIFY(p_Sink->m_Writes.loadAcquire() > Writes + 10);
+    Engine.Stop();
+}
+
+} // end namespace Global
+
+QTEST_MAIN(Global::TestAudioEngine)
+
+#include "TestAudioEngine.moc"
@@ -0,0 +1,9 @@
+!include("Global.pri") {
+    error("Global.pri not found")
+}
+
+TARGET = utTestAudioEngine
+
+SOURCES += TestAudioEngine.cpp
+
+UseLibs(Global)
@@ -0,0 +1,356 @@
+/****************************************************************************/
+/*! \file TestBinaryCatalog.cpp
+ *
+ *  \brief Implementation file for class TestBinaryCatalog.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <Global/Include/BinaryCatalog.h>
+#include <Global/Include/Translator.h>
+#include <Global/Include/GlobalEventCodes.h>
+
+namespace Global {
+
+static const int STRING_COUNT = 5000;   ///< Strings of a language file, about as many as the application has.
+
+/****************************************************************************/
+/**
+ * \brief Strings of a language as the XML string file holds them.
+ *
+ * \iparam  Count   Number of string IDs.
+ *
+ * \return  Strings by ID.
+ */
+/****************************************************************************/
+static tLanguageData CreateLanguageData(int Count) {
+    tLanguageData Data;
+    for (int i = 0; i < Count; i++) {
+        quint32 ID = 33554432U + static_cast<quint32>(i) * 17U;
+        Data.insert(ID, QStringList() << QString("Text %1 with argument %2").arg(ID).arg("%1")
+                                      << QString::fromUtf8("Alternativer Text \xc3\xa4\xc3\xb6\xc3\xbc %1").arg(ID));
+    }
+    return Data;
+}
+
+/****************************************************************************/
+/**
+ * \brief Encode strings as catalog records.
+ *
+ * \iparam  Data    Strings by ID.
+ *
+ * \return  Records by ID.
+ */
+/****************************************************************************/
+static QHash<quint32, QByteArray> CreateRecords(const tLanguageData &Data) {
+    QHash<quint32, QByteArray> Records;
+    for (tLanguageData::const_iterator it = Data.constBegin(); it != Data.constEnd(); ++it) {
+        Records.insert(it.key(), BinaryCatalog::EncodeStrings(it.value()));
+    }
+    return Records;
+}
+
+/****************************************************************************/
+/**
+ * \brief Test class for BinaryCatalog class.
+ */
+/****************************************************************************/
+class TestBinaryCatalog : public QObject {
+    Q_OBJECT
+private:
+    QString     m_SourceFileName;   ///< Source file of the test catalogs.
+    QString     m_FileName;         ///< Catalog file of the test.
+
+    /****************************************************************************/
+    /**
+     * \brief Write the source file.
+     *
+     * \iparam  Content     Content of the source file.
+     */
+    /****************************************************************************/
+    void WriteSource(const QByteArray &Content) {
+        QFile Source(m_SourceFileName);
+        QVERIFY(Source.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(Source.write(Content), static_cast<qint64>(Content.size()));
+    }
+
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of compiling and looking up records.
+     */
+    /****************************************************************************/
+    void utTestCompileFind();
+    /****************************************************************************/
+    /**
+     * \brief Test of refusing outdated and broken catalogs.
+     */
+    /****************************************************************************/
+    void utTestValidation();
+    /****************************************************************************/
+    /**
+     * \brief Test of encoding and decoding string lists.
+     */
+    /****************************************************************************/
+    void utTestStrings();
+    /****************************************************************************/
+    /**
+     * \brief Test of the translator with a string catalog.
+     */
+    /****************************************************************************/
+    void utTestTranslator();
+    /****************************************************************************/
+    /**
+     * \brief Compare building the string table with mapping the catalog.
+     */
+    /****************************************************************************/
+    void utTestBenchmark();
+}; // end class TestBinaryCatalog
+
+/****************************************************************************/
+void TestBinaryCatalog::initTestCase() {
+    m_SourceFileName = QDir::tempPath() + "/utTestBinaryCatalog.xml";
+    m_FileName = BinaryCatalog::CatalogFileName(m_SourceFileName);
+    QCOMPARE(m_FileName, QDir::tempPath() + "/utTestBinaryCatalog.cat");
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::init() {
+    (void)QFile::remove(m_FileName);
+    WriteSource("<strings/>");
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::cleanup() {
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::cleanupTestCase() {
+    (void)QFile::remove(m_FileName);
+    (void)QFile::remove(m_SourceFileName);
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::utTestCompileFind() {
+    BinaryCatalog Catalog;
+    QByteArray Record;
+    QVERIFY(!Catalog.IsOpen());
+    QVERIFY(!Catalog.Find(1, Record));
+    QCOMPARE(Catalog.Count(), 0);
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+
+    // empty catalog
+    QVERIFY(BinaryCatalog::Compile(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName, QHash<quint32, QByteArray>()));
+    QVERIFY(Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+    QCOMPARE(Catalog.Count(), 0);
+    QVERIFY(!Catalog.Find(0, Record));
+    QVERIFY(Catalog.Keys().isEmpty());
+    Catalog.Close();
+
+    // records of any size, also empty ones
+    QHash<quint32, QByteArray> Records;
+    for (quint32 i = 0; i < 1000; i++) {
+        Records.insert(i * 7919U, QByteArray(static_cast<int>(i % 13), static_cast<char>('a' + i % 26)));
+    }
+    Records.insert(0xFFFFFFFFU, "last");
+    QVERIFY(BinaryCatalog::Compile(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName, Records));
+    QVERIFY(Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+    QCOMPARE(Catalog.Count(), Records.count());
+    for (QHash<quint32, QByteArray>::const_iterator it = Records.constBegin(); it != Records.constEnd(); ++it) {
+        QVERIFY(Catalog.Find(it.key(), Record));
+        QCOMPARE(Record, it.value());
+    }
+    for (quint32 i = 0; i < 1000; i++) {
+        QVERIFY(!Catalog.Find(i * 7919U + 1, Record));
+    }
+    QList<quint32> Keys = Catalog.Keys();
+    qSort(Keys);
+    QList<quint32> Expected = Records.keys();
+    qSort(Expected);
+    QCOMPARE(Keys, Expected);
+
+    // records reference the mapping
+    QVERIFY(Catalog.Find(0xFFFFFFFFU, Record));
+    QVERIFY(Record.constData() > reinterpret_cast<const char *>(Catalog.mp_Header));
+    Catalog.Close();
+    QVERIFY(!Catalog.IsOpen());
+    QVERIFY(!Catalog.Find(0xFFFFFFFFU, Record));
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::utTestValidation() {
+    QHash<quint32, QByteArray> Records;
+    Records.insert(1, "one");
+    Records.insert(2, "two");
+    QVERIFY(BinaryCatalog::Compile(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName, Records));
+
+    BinaryCatalog Catalog;
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS + 1, m_SourceFileName));
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName + ".missing"));
+    QVERIFY(Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+    Catalog.Close();
+
+    // a changed record is detected by the checksum
+    QFile File(m_FileName);
+    QVERIFY(File.open(QIODevice::ReadWrite));
+    QByteArray Content = File.readAll();
+    Content[Content.size() - 1] = static_cast<char>(Content.at(Content.size() - 1) ^ 0x55);
+    QVERIFY(File.seek(0));
+    QCOMPARE(File.write(Content), static_cast<qint64>(Content.size()));
+    File.close();
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+
+    // a truncated catalog
+    QVERIFY(File.open(QIODevice::ReadWrite));
+    QVERIFY(File.resize(Content.size() - 4));
+    File.close();
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+
+    // a changed source
+    QVERIFY(BinaryCatalog::Compile(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName, Records));
+    QVERIFY(Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+    Catalog.Close();
+    WriteSource("<strings version=\"2\"/>");
+    QVERIFY(!Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::utTestStrings() {
+    QStringList Strings;
+    QStringList Decoded;
+    QVERIFY(BinaryCatalog::DecodeStrings(BinaryCatalog::EncodeStrings(Strings), Decoded));
+    QVERIFY(Decoded.isEmpty());
+
+    Strings << "" << "Line %1" << QString::fromUtf8("Zeile \xc3\xa4 %1 \xe2\x82\xac");
+    QByteArray Record = BinaryCatalog::EncodeStrings(Strings);
+    QVERIFY(BinaryCatalog::DecodeStrings(Record, Decoded));
+    QCOMPARE(Decoded, Strings);
+
+    // broken records
+    QVERIFY(!BinaryCatalog::DecodeStrings(QByteArray(), Decoded));
+    QVERIFY(!BinaryCatalog::DecodeStrings(Record.left(Record.size() - 1), Decoded));
+    QVERIFY(!BinaryCatalog::DecodeStrings(Record.left(6), Decoded));
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::utTestTranslator() {
+    tLanguageData Data;
+    Data.insert(2, QStringList() << "Line 2: %1 %2" << "Alternate 2: %1 %2");
+    Data.insert(EVENT_GLOBAL_UNKNOWN_STRING_ID, QStringList() << "Unknown text: %1. Arguments:" << "Unknown text: %1. Arguments:");
+    QVERIFY(BinaryCatalog::Compile(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName, CreateRecords(Data)));
+    QSharedPointer<BinaryCatalog> Catalog(new BinaryCatalog());
+    QVERIFY(Catalog->Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+
+    Translator ByData;
+    Translator ByCatalog;
+    ByData.SetLanguageData(QLocale::English, Data, true, true);
+    ByCatalog.SetLanguageCatalog(QLocale::English, Catalog, true, true);
+    QCOMPARE(ByCatalog.GetLanguages(), QList<QLocale::Language>() << QLocale::English);
+    QCOMPARE(ByCatalog.GetDefaultLanguage(), QLocale::English);
+
+    TranslatableString Known(2, tTranslatableStringList() << "A1" << "A2");
+    TranslatableString Unknown(4, tTranslatableStringList() << "A1");
+    QCOMPARE(ByCatalog.Translate(Known), QString("Line 2: A1 A2"));
+    QCOMPARE(ByCatalog.Translate(Known, true), QString("Alternate 2: A1 A2"));
+    QCOMPARE(ByCatalog.Translate(Known), ByData.Translate(Known));
+    QCOMPARE(ByCatalog.Translate(Unknown), ByData.Translate(Unknown));
+    // not loaded, no fallback to another language
+    QCOMPARE(ByCatalog.TranslateToLanguage(QLocale::German, Known), ByData.TranslateToLanguage(QLocale::German, Known));
+
+    // language data replaces the catalog and the other way round
+    ByCatalog.SetLanguageData(QLocale::English, tLanguageData(), false, false);
+    QCOMPARE(ByCatalog.Translate(Known), QString("\"2\": \"A1\" \"A2\""));
+    ByCatalog.SetLanguageCatalog(QLocale::English, Catalog, false, false);
+    QCOMPARE(ByCatalog.GetLanguages().count(), 1);
+    QCOMPARE(ByCatalog.Translate(Known), QString("Line 2: A1 A2"));
+    ByCatalog.RemoveLanguageData(QLocale::English);
+    QVERIFY(ByCatalog.GetLanguages().isEmpty());
+    QCOMPARE(ByCatalog.GetDefaultLanguage(), QLocale::C);
+}
+
+/****************************************************************************/
+void TestBinaryCatalog::utTestBenchmark() {
+    tLanguageData Data = CreateLanguageData(STRING_COUNT);
+    QHash<quint32, QByteArray> Records = CreateRecords(Data);
+    QVERIFY(BinaryCatalog::Compile(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName, Records));
+    QList<quint32> Keys = Data.keys();
+
+    // the table as the XML reader builds it, without the parsing
+    QElapsedTimer Timer;
+    Timer.start();
+    tLanguageData Table;
+    for (tLanguageData::const_iterator it = Data.constBegin(); it != Data.constEnd(); ++it) {
+        QStringList Strings;
+        Strings << QString(it.value().at(0).constData(), it.value().at(0).size())
+                << QString(it.value().at(1).constData(), it.value().at(1).size());
+        Table.insert(it.key(), Strings);
+    }
+    qint64 TableTime = Timer.nsecsElapsed();
+
+    Timer.restart();
+    BinaryCatalog Catalog;
+    QVERIFY(Catalog.Open(m_FileName, BinaryCatalog::FORMAT_STRINGS, m_SourceFileName));
+    qint64 OpenTime = Timer.nsecsElapsed();
+
+    Timer.restart();
+    QByteArray Record;
+    QStringList Strings;
+    for (int i = 0; i < Keys.count(); i++) {
+        QVERIFY(Catalog.Find(Keys.at(i), Record));
+        QVERIFY(BinaryCatalog::DecodeStrings(Record, Strings));
+    }
+    qint64 LookupTime = Timer.nsecsElapsed();
+    QCOMPARE(Strings, Data.value(Keys.last()));
+
+    qDebug() << STRING_COUNT << "strings: building the table" << static_cast<double>(TableTime) / 1000000 << "ms,"
+             << "opening the catalog" << static_cast<double>(OpenTime) / 1000000 << "ms,"
+             << "catalog size" << QFile(m_FileName).size() / 1024 << "kB,"
+             << "lookup" << static_cast<double>(LookupTime) / Keys.count() << "ns per string";
+}
+
+} // end namespace Global
+
+QTEST_MAIN(Global::TestBinaryCatalog)
+
+#include "TestBinaryCatalog.moc"
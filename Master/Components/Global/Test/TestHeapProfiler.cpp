@@ -0,0 +1,351 @@
+/****************************************************************************/
+/*! \file TestHeapProfiler.cpp
+ *
+ *  \brief Implementation file for class TestHeapProfiler.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QVector>
+#include <QRegExp>
+#include <Global/Include/HeapProfiler.h>
+
+#include <stdlib.h>
+
+namespace Global {
+
+static const quint32 TEST_SAMPLE_INTERVAL = 4096;   ///< Sample interval of the tests, small for exact estimates.
+static const int TEST_BLOCKS = 8000;                ///< Blocks allocated per test, about 8 MB.
+static const int BENCHMARK_CALLS = 1000000;         ///< malloc and free calls of the benchmark.
+
+/****************************************************************************/
+/**
+ * \brief Allocates blocks of different sizes.
+ *
+ * \oparam  Blocks  Allocated blocks.
+ *
+ * \return  Allocated bytes.
+ */
+/****************************************************************************/
+static qint64 AllocateBlocks(QVector<void *> &Blocks) {
+    qint64 Bytes = 0;
+    for (int i = 0; i < TEST_BLOCKS; i++) {
+        size_t Size = 16 + static_cast<size_t>(i * 37) % 2000;
+        Blocks.append(malloc(Size));
+        Bytes += static_cast<qint64>(Size);
+    }
+    return Bytes;
+}
+
+/****************************************************************************/
+/**
+ * \brief Frees the blocks.
+ *
+ * \iparam  Blocks  Blocks to free.
+ */
+/****************************************************************************/
+static void FreeBlocks(const QVector<void *> &Blocks) {
+    for (int i = 0; i < Blocks.count(); i++) {
+        free(Blocks.at(i));
+    }
+}
+
+/****************************************************************************/
+/**
+ * \brief Thread allocating blocks and keeping them.
+ */
+/****************************************************************************/
+class HeapWorker : public QThread {
+public:
+    QVector<void *> m_Blocks;   ///< Allocated blocks.
+    qint64          m_Bytes;    ///< Allocated bytes.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    HeapWorker() : m_Bytes(0) {
+        m_Blocks.reserve(TEST_BLOCKS);
+        setObjectName("utHeapWorker");
+    }
+
+protected:
+    /****************************************************************************/
+    /**
+     * \brief Allocates the blocks.
+     */
+    /****************************************************************************/
+    void run() {
+        m_Bytes = AllocateBlocks(m_Blocks);
+    }
+};
+
+/****************************************************************************/
+/**
+ * \brief Test class for HeapProfiler class.
+ */
+/****************************************************************************/
+class TestHeapProfiler : public QObject {
+    Q_OBJECT
+private:
+    QString     m_FileName;     ///< Profile file of the test.
+
+    /****************************************************************************/
+    /**
+     * \brief Checks an estimate.
+     *
+     * \iparam  Estimate    Estimated bytes.
+     * \iparam  Bytes       Real bytes.
+     */
+    /****************************************************************************/
+    void CheckEstimate(qint64 Estimate, qint64 Bytes) {
+        // about 2000 samples, the standard deviation is about 2%
+        QVERIFY2(qAbs(Estimate - Bytes) < Bytes / 10,
+                 qPrintable(QString("estimate %1, real %2").arg(Estimate).arg(Bytes)));
+    }
+
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of starting and stopping.
+     */
+    /****************************************************************************/
+    void utTestStartStop();
+    /****************************************************************************/
+    /**
+     * \brief Test of the estimated live and allocated bytes.
+     */
+    /****************************************************************************/
+    void utTestEstimate();
+    /****************************************************************************/
+    /**
+     * \brief Test of the profile of another thread.
+     */
+    /****************************************************************************/
+    void utTestThreadProfile();
+    /****************************************************************************/
+    /**
+     * \brief Test of growing, failing and freeing reallocs.
+     */
+    /****************************************************************************/
+    void utTestRealloc();
+    /****************************************************************************/
+    /**
+     * \brief Compare the cost of malloc and free with and without sampling.
+     */
+    /****************************************************************************/
+    void utTestBenchmark();
+}; // end class TestHeapProfiler
+
+/****************************************************************************/
+void TestHeapProfiler::initTestCase() {
+    m_FileName = QDir::tempPath() + "/utTestHeapProfiler.log";
+}
+
+/****************************************************************************/
+void TestHeapProfiler::init() {
+    if (!HeapProfiler::IsAvailable()) {
+        QSKIP("Global is not built with CONFIG+=heap_profiler");
+    }
+    (void)QFile::remove(m_FileName);
+}
+
+/****************************************************************************/
+void TestHeapProfiler::cleanup() {
+    HeapProfiler::Stop();
+}
+
+/****************************************************************************/
+void TestHeapProfiler::cleanupTestCase() {
+    (void)QFile::remove(m_FileName);
+}
+
+/****************************************************************************/
+void TestHeapProfiler::utTestStartStop() {
+    QVERIFY(!HeapProfiler::IsActive());
+    QVERIFY(!HeapProfiler::Start(m_FileName, 0));
+    QVERIFY(!HeapProfiler::IsActive());
+
+    QVERIFY(HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 0));
+    QVERIFY(HeapProfiler::IsActive());
+    QVERIFY(!HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 0));
+    QVERIFY(!QFile::exists(m_FileName));
+
+    // the final profile is written on stop
+    HeapProfiler::Stop();
+    QVERIFY(!HeapProfiler::IsActive());
+    QVERIFY(QFile::exists(m_FileName));
+    HeapProfiler::Stop();
+
+    // the environment enables the profiler
+    qunsetenv("HEAP_PROFILE_INTERVAL");
+    QVERIFY(!HeapProfiler::StartFromEnvironment(m_FileName));
+    qputenv("HEAP_PROFILE_INTERVAL", "65536");
+    QVERIFY(HeapProfiler::StartFromEnvironment(m_FileName));
+    QVERIFY(HeapProfiler::IsActive());
+    qunsetenv("HEAP_PROFILE_INTERVAL");
+}
+
+/****************************************************************************/
+void TestHeapProfiler::utTestEstimate() {
+    QVector<void *> Blocks;
+    Blocks.reserve(TEST_BLOCKS);
+    QVERIFY(HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 0));
+    qint64 LiveBefore = HeapProfiler::LiveBytes();
+    qint64 AllocatedBefore = HeapProfiler::AllocatedBytes();
+
+    qint64 Bytes = AllocateBlocks(Blocks);
+    CheckEstimate(HeapProfiler::LiveBytes() - LiveBefore, Bytes);
+    CheckEstimate(HeapProfiler::AllocatedBytes() - AllocatedBefore, Bytes);
+
+    // the frees are seen as well
+    FreeBlocks(Blocks);
+    QVERIFY(qAbs(HeapProfiler::LiveBytes() - LiveBefore) < Bytes / 10);
+    CheckEstimate(HeapProfiler::AllocatedBytes() - AllocatedBefore, Bytes);
+    QVERIFY(HeapProfiler::DroppedSamples() < TEST_BLOCKS / 100);
+
+    // a new start forgets the previous profile
+    HeapProfiler::Stop();
+    QVERIFY(HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 0));
+    QVERIFY(HeapProfiler::AllocatedBytes() < Bytes / 10);
+}
+
+/****************************************************************************/
+void TestHeapProfiler::utTestThreadProfile() {
+    QVERIFY(HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 0));
+    HeapWorker Worker;
+    Worker.start();
+    QVERIFY(Worker.wait(10000));
+    // the blocks of a finished thread stay live until freed by another one
+    CheckEstimate(HeapProfiler::LiveBytes(), Worker.m_Bytes);
+    QVERIFY(HeapProfiler::Dump());
+
+    QFile File(m_FileName);
+    QVERIFY(File.open(QIODevice::ReadOnly | QIODevice::Text));
+    QString Profile = QString::fromLocal8Bit(File.readAll());
+    File.close();
+    QVERIFY(Profile.startsWith("Heap profile of process"));
+    QVERIFY(Profile.contains("sample interval 4096 bytes"));
+    QVERIFY(Profile.contains("Threads by live bytes"));
+    QVERIFY(Profile.contains("Call sites by live bytes"));
+    QVERIFY(Profile.contains(" #0 "));
+    // the name of the thread was read while it was running or is shown as unknown
+    QVERIFY(Profile.contains(QRegExp(" (utHeapWorker|\\?): live ")));
+
+    FreeBlocks(Worker.m_Blocks);
+    QVERIFY(HeapProfiler::LiveBytes() < Worker.m_Bytes / 10);
+
+    // the periodic dump
+    HeapProfiler::Stop();
+    QVERIFY(QFile::remove(m_FileName));
+    QVERIFY(HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 1));
+    QElapsedTimer Timer;
+    Timer.start();
+    while (!QFile::exists(m_FileName) && (Timer.elapsed() < 5000)) {
+        QTest::qWait(100);
+    }
+    QVERIFY(QFile::exists(m_FileName));
+}
+
+/****************************************************************************/
+void TestHeapProfiler::utTestRealloc() {
+    QVector<void *> Blocks;
+    Blocks.reserve(TEST_BLOCKS);
+    QVERIFY(HeapProfiler::Start(m_FileName, TEST_SAMPLE_INTERVAL, 0));
+    qint64 LiveBefore = HeapProfiler::LiveBytes();
+    qint64 Bytes = AllocateBlocks(Blocks);
+
+    // a failed realloc keeps the block, larger than any possible block
+    const size_t InvalidSize = (static_cast<size_t>(-1) / 4) * 3;
+    for (int i = 0; i < Blocks.count(); i++) {
+        QVERIFY(realloc(Blocks.at(i), InvalidSize) == NULL);
+    }
+    CheckEstimate(HeapProfiler::LiveBytes() - LiveBefore, Bytes);
+
+    // the blocks are grown or moved
+    for (int i = 0; i < Blocks.count(); i++) {
+        size_t Size = 2 * (16 + static_cast<size_t>(i * 37) % 2000);
+        Blocks[i] = realloc(Blocks.at(i), Size);
+        QVERIFY(Blocks.at(i) != NULL);
+    }
+    CheckEstimate(HeapProfiler::LiveBytes() - LiveBefore, 2 * Bytes);
+
+    // a realloc to size 0 frees the block
+    for (int i = 0; i < Blocks.count(); i++) {
+        (void)realloc(Blocks.at(i), 0);
+    }
+    QVERIFY(qAbs(HeapProfiler::LiveBytes() - LiveBefore) < Bytes / 10);
+}
+
+/****************************************************************************/
+void TestHeapProfiler::utTestBenchmark() {
+    void * volatile p_Block = NULL;
+    QElapsedTimer Timer;
+
+    Timer.start();
+    for (int i = 0; i < BENCHMARK_CALLS; i++) {
+        p_Block = malloc(64);
+        free(p_Block);
+    }
+    qint64 StoppedTime = Timer.nsecsElapsed();
+
+    QVERIFY(HeapProfiler::Start(m_FileName));
+    Timer.restart();
+    for (int i = 0; i < BENCHMARK_CALLS; i++) {
+        p_Block = malloc(64);
+        free(p_Block);
+    }
+    qint64 SamplingTime = Timer.nsecsElapsed();
+
+    qDebug() << "malloc and free of 64 bytes: stopped" << static_cast<double>(StoppedTime) / BENCHMARK_CALLS << "ns,"
+             << "sampling every" << HeapProfiler::DEFAULT_SAMPLE_INTERVAL << "bytes"
+             << static_cast<double>(SamplingTime) / BENCHMARK_CALLS << "ns";
+}
+
+} // end namespace Global
+
+QTEST_MAIN(Global::TestHeapProfiler)
+
+#include "TestHeapProfiler.moc"
@@ -0,0 +1,9 @@
+!include("Global.pri") {
+    error("Global.pri not found")
+}
+
+TARGET = utTestHeapProfiler
+
+SOURCES += TestHeapProfiler.cpp
+
+UseLibs(Global)
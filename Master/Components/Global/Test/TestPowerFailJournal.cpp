@@ -0,0 +1,255 @@
+/****************************************************************************/
+/*! \file TestPowerFailJournal.cpp
+ *
+ *  \brief Implementation file for class TestPowerFailJournal.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <Global/Include/PowerFailJournal.h>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Thread committing the journal until it is stopped.
+ */
+/****************************************************************************/
+class CommitThread : public QThread {
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    CommitThread() : m_Stop(0), m_CommitCount(0) {
+    }
+    /****************************************************************************/
+    /**
+     * \brief Stops committing.
+     */
+    /****************************************************************************/
+    void Stop() {
+        m_Stop.storeRelease(1);
+    }
+    /****************************************************************************/
+    /**
+     * \brief Returns the number of successful commits.
+     *
+     * \return  Commit count.
+     */
+    /****************************************************************************/
+    int GetCommitCount() const {
+        return m_CommitCount;
+    }
+
+protected:
+    /****************************************************************************/
+    /**
+     * \brief Commits as often as possible.
+     */
+    /****************************************************************************/
+    void run() {
+        while (m_Stop.loadAcquire() == 0) {
+            if (PowerFailJournal::Instance().Commit()) {
+                m_CommitCount++;
+            }
+        }
+    }
+
+private:
+    QAtomicInt  m_Stop;         ///< Stop request.
+    int         m_CommitCount;  ///< Number of successful commits.
+};
+
+/****************************************************************************/
+/**
+ * \brief Test class for PowerFailJournal class.
+ */
+/****************************************************************************/
+class TestPowerFailJournal : public QObject {
+    Q_OBJECT
+private:
+    QString     m_FileName;     ///< Journal file of the test.
+
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of staging and loading records.
+     */
+    /****************************************************************************/
+    void utTestStageLoad();
+    /****************************************************************************/
+    /**
+     * \brief Test of the fallback to the previous record.
+     */
+    /****************************************************************************/
+    void utTestTornRecord();
+    /****************************************************************************/
+    /**
+     * \brief Test of committing and reopening the journal.
+     */
+    /****************************************************************************/
+    void utTestCommitReopen();
+    /****************************************************************************/
+    /**
+     * \brief Test of closing the journal while another thread commits.
+     */
+    /****************************************************************************/
+    void utTestCommitClose();
+}; // end class TestPowerFailJournal
+
+/****************************************************************************/
+void TestPowerFailJournal::initTestCase() {
+    m_FileName = QDir::tempPath() + "/utTestPowerFailJournal.journal";
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::init() {
+    (void)QFile::remove(m_FileName);
+    QVERIFY(PowerFailJournal::Instance().Open(m_FileName));
+    QVERIFY(PowerFailJournal::Instance().IsOpen());
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::cleanup() {
+    PowerFailJournal::Instance().Close();
+    QVERIFY(!PowerFailJournal::Instance().IsOpen());
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::cleanupTestCase() {
+    (void)QFile::remove(m_FileName);
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::utTestStageLoad() {
+    PowerFailJournal &Journal = PowerFailJournal::Instance();
+    QByteArray Record;
+
+    // empty journal
+    for (int i = 0; i < PFJ_SLOT_COUNT; i++) {
+        QVERIFY(!Journal.Load(static_cast<PowerFailJournalSlot_t>(i), Record));
+    }
+
+    // both buffers of a slot are used alternately
+    for (int i = 1; i < 10; i++) {
+        QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, QByteArray("Entry ") + QByteArray::number(i)));
+        QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+        QCOMPARE(Record, QByteArray("Entry ") + QByteArray::number(i));
+    }
+
+    // empty and maximal records
+    QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, QByteArray()));
+    QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QVERIFY(Record.isEmpty());
+    QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, QByteArray(PowerFailJournal::PFJ_PAYLOAD_SIZE, 'x')));
+    QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QCOMPARE(Record.size(), static_cast<int>(PowerFailJournal::PFJ_PAYLOAD_SIZE));
+    QVERIFY(!Journal.Stage(PFJ_SLOT_LOG_TAIL, QByteArray(PowerFailJournal::PFJ_PAYLOAD_SIZE + 1, 'x')));
+    QVERIFY(!Journal.Stage(PFJ_SLOT_COUNT, "invalid"));
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::utTestTornRecord() {
+    PowerFailJournal &Journal = PowerFailJournal::Instance();
+    QByteArray Record;
+
+    QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, "Entry 1"));
+    QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, "Entry 2"));
+    int Latest = Journal.Latest(PFJ_SLOT_LOG_TAIL);
+    QVERIFY(Latest >= 0);
+
+    // power fails while the latest record is written
+    Journal.Buffer(PFJ_SLOT_LOG_TAIL, Latest)[PowerFailJournal::PFJ_HEADER_SIZE] ^= 0x55;
+    QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QCOMPARE(Record, QByteArray("Entry 1"));
+
+    // the next record replaces the torn one
+    QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, "Entry 3"));
+    QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QCOMPARE(Record, QByteArray("Entry 3"));
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::utTestCommitReopen() {
+    PowerFailJournal &Journal = PowerFailJournal::Instance();
+    QByteArray Record;
+
+    QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, "tail"));
+    QVERIFY(Journal.Commit());
+    QVERIFY(!Journal.Open(m_FileName));
+
+    Journal.Close();
+    QVERIFY(!Journal.Commit());
+    QVERIFY(!Journal.Stage(PFJ_SLOT_LOG_TAIL, "closed"));
+    QVERIFY(!Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QVERIFY(Journal.Open(m_FileName));
+    QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QCOMPARE(Record, QByteArray("tail"));
+}
+
+/****************************************************************************/
+void TestPowerFailJournal::utTestCommitClose() {
+    PowerFailJournal &Journal = PowerFailJournal::Instance();
+    CommitThread Committer;
+
+    Committer.start();
+    for (int i = 0; i < 200; i++) {
+        QVERIFY(Journal.Stage(PFJ_SLOT_LOG_TAIL, QByteArray("Entry ") + QByteArray::number(i)));
+        Journal.Close();
+        QVERIFY(Journal.Open(m_FileName));
+    }
+    Committer.Stop();
+    QVERIFY(Committer.wait(5000));
+    QVERIFY(Committer.GetCommitCount() > 0);
+
+    QByteArray Record;
+    QVERIFY(Journal.Load(PFJ_SLOT_LOG_TAIL, Record));
+    QCOMPARE(Record, QByteArray("Entry 199"));
+}
+
+} // end namespace Global
+
+QTEST_MAIN(Global::TestPowerFailJournal)
+
+#include "TestPowerFailJournal.moc"
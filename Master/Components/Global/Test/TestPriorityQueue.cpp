@@ -0,0 +1,327 @@
+/****************************************************************************/
+/*! \file TestPriorityQueue.cpp
+ *
+ *  \brief Implementation file for class TestPriorityQueue.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QMultiMap>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <Global/Include/PriorityQueue.h>
+
+namespace Global {
+
+static const int PRIORITY_COUNT = 16;   ///< Number of different priorities in the benchmark.
+static const int BENCHMARK_OPS = 1000;  ///< Pop and push pairs measured per queue size.
+
+/****************************************************************************/
+/**
+ * \brief The priority queue as it was before, based on QMultiMap. Only kept
+ *        to compare the implementations.
+ */
+/****************************************************************************/
+template <typename T>
+class MapPriorityQueue {
+private:
+    QMultiMap<int, T> m_Element;    ///< Queue Element.
+public:
+    /****************************************************************************/
+    /**
+     * \brief Push an item in to the queue.
+     *
+     * \iparam  Priority    Priority of the item.
+     * \iparam  Item        Item to insert.
+     */
+    /****************************************************************************/
+    void Push(int Priority, T &Item) { (void)m_Element.insertMulti(Priority, Item); }
+    /****************************************************************************/
+    /**
+     * \brief Returns the element at the top of the queue.
+     *
+     * \return  Top element.
+     */
+    /****************************************************************************/
+    T Top() const { return m_Element.values(m_Element.keys().last()).last(); }
+    /****************************************************************************/
+    /**
+     * \brief Remove an item from the queue.
+     *
+     * \iparam  Priority    Priority of the item.
+     * \iparam  Item        Item to remove.
+     */
+    /****************************************************************************/
+    void Remove(int Priority, T &Item) { (void)m_Element.remove(Priority, Item); }
+}; // end class MapPriorityQueue
+
+/****************************************************************************/
+/**
+ * \brief Remove the top item of the old queue. The priority of an item is
+ *        derived from the item, because the old queue does not return it.
+ *
+ * \iparam  Queue   Queue to pop.
+ */
+/****************************************************************************/
+void PopTop(MapPriorityQueue<int> &Queue) {
+    int Item = Queue.Top();
+    Queue.Remove(Item % PRIORITY_COUNT, Item);
+}
+
+/****************************************************************************/
+/**
+ * \brief Remove the top item of the heap based queue.
+ *
+ * \iparam  Queue   Queue to pop.
+ */
+/****************************************************************************/
+void PopTop(PriorityQueue<int> &Queue) {
+    (void)Queue.Top();
+    Queue.Pop();
+}
+
+/****************************************************************************/
+/**
+ * \brief Fill a queue and measure pop and push pairs at that size.
+ *
+ * \iparam  Queue   Queue to measure.
+ * \iparam  Size    Number of queued items.
+ *
+ * \return  Duration of a pop and push pair [ns].
+ */
+/****************************************************************************/
+template <typename QueueT> double BenchmarkQueue(QueueT &Queue, int Size) {
+    int Next = 0;
+    for (; Next < Size; Next++) {
+        (void)Queue.Push(Next % PRIORITY_COUNT, Next);
+    }
+    QElapsedTimer Timer;
+    Timer.start();
+    for (int i = 0; i < BENCHMARK_OPS; i++, Next++) {
+        PopTop(Queue);
+        (void)Queue.Push(Next % PRIORITY_COUNT, Next);
+    }
+    return static_cast<double>(Timer.nsecsElapsed()) / BENCHMARK_OPS;
+}
+
+/****************************************************************************/
+/**
+ * \brief Test class for PriorityQueue class.
+ */
+/****************************************************************************/
+class TestPriorityQueue : public QObject {
+    Q_OBJECT
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of the order of priorities and of equal priorities.
+     */
+    /****************************************************************************/
+    void utTestOrder();
+    /****************************************************************************/
+    /**
+     * \brief Test of removing items by handle and by value.
+     */
+    /****************************************************************************/
+    void utTestRemove();
+    /****************************************************************************/
+    /**
+     * \brief Test against a sorted reference with random operations.
+     */
+    /****************************************************************************/
+    void utTestRandom();
+    /****************************************************************************/
+    /**
+     * \brief Compare with the QMultiMap based queue.
+     */
+    /****************************************************************************/
+    void utTestBenchmark();
+}; // end class TestPriorityQueue
+
+/****************************************************************************/
+void TestPriorityQueue::initTestCase() {
+}
+
+/****************************************************************************/
+void TestPriorityQueue::init() {
+}
+
+/****************************************************************************/
+void TestPriorityQueue::cleanup() {
+}
+
+/****************************************************************************/
+void TestPriorityQueue::cleanupTestCase() {
+}
+
+/****************************************************************************/
+void TestPriorityQueue::utTestOrder() {
+    PriorityQueue<QString> Queue;
+    QVERIFY(Queue.IsEmpty());
+    Queue.Pop();
+
+    (void)Queue.Push(1, "low 1");
+    (void)Queue.Push(5, "high 1");
+    (void)Queue.Push(1, "low 2");
+    (void)Queue.Push(3, "mid 1");
+    (void)Queue.Push(5, "high 2");
+    (void)Queue.Push(-2, "negative");
+    (void)Queue.Push(5, "high 3");
+    (void)Queue.Push(1, "low 3");
+    QCOMPARE(Queue.Size(), 8);
+
+    const char *Expected[] = {"high 1", "high 2", "high 3", "mid 1", "low 1", "low 2", "low 3", "negative"};
+    const int Priorities[] = {5, 5, 5, 3, 1, 1, 1, -2};
+    for (int i = 0; i < 8; i++) {
+        QCOMPARE(Queue.Top(), QString(Expected[i]));
+        QCOMPARE(Queue.TopPriority(), Priorities[i]);
+        Queue.Pop();
+    }
+    QVERIFY(Queue.IsEmpty());
+
+    // the order stays FIFO when items are pushed in between
+    (void)Queue.Push(2, "a");
+    (void)Queue.Push(2, "b");
+    QCOMPARE(Queue.Top(), QString("a"));
+    Queue.Pop();
+    (void)Queue.Push(2, "c");
+    QCOMPARE(Queue.Top(), QString("b"));
+    Queue.Clear();
+    QVERIFY(Queue.IsEmpty());
+    QCOMPARE(Queue.Size(), 0);
+}
+
+/****************************************************************************/
+void TestPriorityQueue::utTestRemove() {
+    PriorityQueue<int> Queue;
+    PriorityQueue<int>::Handle_t Handles[10];
+    for (int i = 0; i < 10; i++) {
+        Handles[i] = Queue.Push(i % 3, i);
+        QVERIFY(Handles[i] != PriorityQueue<int>::INVALID_HANDLE);
+        QVERIFY(Queue.Contains(Handles[i]));
+    }
+    QVERIFY(!Queue.Contains(PriorityQueue<int>::INVALID_HANDLE));
+
+    // by handle
+    QVERIFY(Queue.Remove(Handles[2]));
+    QVERIFY(!Queue.Contains(Handles[2]));
+    QVERIFY(!Queue.Remove(Handles[2]));
+    QVERIFY(Queue.Remove(Handles[0]));
+    QCOMPARE(Queue.Size(), 8);
+
+    // by value
+    Queue.Remove(1, 4);
+    QVERIFY(!Queue.Contains(Handles[4]));
+    Queue.Remove(1, 3);     // other priority, not removed
+    QCOMPARE(Queue.Size(), 7);
+
+    // a reused slot does not revive an old handle
+    PriorityQueue<int>::Handle_t Reused = Queue.Push(9, 100);
+    QVERIFY(!Queue.Contains(Handles[0]));
+    QVERIFY(!Queue.Contains(Handles[2]));
+    QVERIFY(!Queue.Contains(Handles[4]));
+    QVERIFY(Queue.Contains(Reused));
+
+    const int Expected[] = {100, 5, 8, 1, 7, 3, 6, 9};
+    for (int i = 0; i < 8; i++) {
+        QCOMPARE(Queue.Top(), Expected[i]);
+        Queue.Pop();
+    }
+    QVERIFY(Queue.IsEmpty());
+    QVERIFY(!Queue.Contains(Reused));
+
+    // handles are invalid after clear
+    PriorityQueue<int>::Handle_t Cleared = Queue.Push(1, 1);
+    Queue.Clear();
+    QVERIFY(!Queue.Contains(Cleared));
+    QVERIFY(!Queue.Remove(Cleared));
+}
+
+/****************************************************************************/
+void TestPriorityQueue::utTestRandom() {
+    PriorityQueue<int> Queue;
+    QMap<QPair<int, int>, PriorityQueue<int>::Handle_t> Reference;
+    qsrand(4711);
+    for (int i = 0; i < 20000; i++) {
+        int Operation = qrand() % 4;
+        if (Operation < 2 || Reference.isEmpty()) {
+            int Priority = qrand() % 8;
+            // negated sequence, so the map sorts like the queue
+            Reference.insert(qMakePair(-Priority, i), Queue.Push(Priority, i));
+        }
+        else if (Operation == 2) {
+            QCOMPARE(Queue.Top(), Reference.begin().key().second);
+            QCOMPARE(Queue.TopPriority(), -Reference.begin().key().first);
+            Queue.Pop();
+            Reference.erase(Reference.begin());
+        }
+        else {
+            QMap<QPair<int, int>, PriorityQueue<int>::Handle_t>::iterator Victim =
+                    Reference.begin() + qrand() % Reference.size();
+            QVERIFY(Queue.Remove(Victim.value()));
+            Reference.erase(Victim);
+        }
+        QCOMPARE(Queue.Size(), Reference.size());
+    }
+    while (!Reference.isEmpty()) {
+        QCOMPARE(Queue.Top(), Reference.begin().key().second);
+        Queue.Pop();
+        Reference.erase(Reference.begin());
+    }
+    QVERIFY(Queue.IsEmpty());
+}
+
+/****************************************************************************/
+void TestPriorityQueue::utTestBenchmark() {
+    const int Sizes[] = {10, 1000, 100000};
+    for (int i = 0; i < 3; i++) {
+        MapPriorityQueue<int> OldQueue;
+        PriorityQueue<int> NewQueue;
+        double OldTime = BenchmarkQueue(OldQueue, Sizes[i]);
+        double NewTime = BenchmarkQueue(NewQueue, Sizes[i]);
+        qDebug() << Sizes[i] << "items: QMultiMap" << OldTime << "ns, heap" << NewTime << "ns per pop and push";
+        QCOMPARE(NewQueue.Size(), Sizes[i]);
+    }
+}
+
+} // end namespace Global
+
+QTEST_MAIN(Global::TestPriorityQueue)
+
+#include "TestPriorityQueue.moc"
@@ -20,6 +20,7 @@
 
 #include <QTest>
 #include <Global/Include/SharedPointer.h>
+#include <Global/Include/IntrusivePointer.h>
 
 namespace Global {
 
@@ -69,6 +70,44 @@ public:
 
 typedef SharedPointer<SharedPointerHelper>  tSharedPtr;     ///< Typedef for used shared pointer.
 
+/****************************************************************************/
+/**
+ * \brief Helper class for testing IntrusivePointer class.
+ */
+/****************************************************************************/
+class IntrusivePointerHelper : public RefCounted {
+private:
+    bool    *m_pData;       ///< Pointer to some helper data.
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * Sets helper data to true.
+     *
+     * \param[in]   pData   Pointer to some helper data.
+     */
+    /****************************************************************************/
+    IntrusivePointerHelper(bool *pData) :
+        m_pData(pData)
+    {
+        Q_ASSERT(m_pData != NULL);
+        *m_pData = true;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Destructor.
+     *
+     * Sets helper data to false.
+     */
+    /****************************************************************************/
+    ~IntrusivePointerHelper() {
+        *m_pData = false;
+    }
+}; // end class IntrusivePointerHelper
+
+typedef IntrusivePointer<IntrusivePointerHelper>  tIntrusivePtr;    ///< Typedef for used intrusive pointer.
+
 /****************************************************************************/
 /**
  * \brief Test class for SharedPointer class.
@@ -124,6 +163,12 @@ private slots:
      */
     /****************************************************************************/
     void utTestMethods();
+    /****************************************************************************/
+    /**
+     * \brief Test of the intrusive pointer.
+     */
+    /****************************************************************************/
+    void utTestIntrusivePointer();
 }; // end class TestSharedPointer
 
 /****************************************************************************/
@@ -574,6 +619,58 @@ void TestSharedPointer::utTestMethods() {
 
 }
 
+/****************************************************************************/
+void TestSharedPointer::utTestIntrusivePointer() {
+    QCOMPARE(Data1, false);
+    QCOMPARE(Data2, false);
+    {
+        tIntrusivePtr Ptr0;
+        tIntrusivePtr Ptr1(NULL);
+        QVERIFY(Ptr0.IsNull());
+        QVERIFY(Ptr1.IsNull());
+        QVERIFY(Ptr0 == Ptr1);
+
+        IntrusivePointerHelper *pHelper1 = new IntrusivePointerHelper(&Data1);
+        tIntrusivePtr Ptr2(pHelper1);
+        QCOMPARE(pHelper1->m_RefCounter, QAtomicInt(1));
+        QCOMPARE(Ptr2.GetPointerToUserData(), pHelper1);
+        QVERIFY(!Ptr2.IsNull());
+        {
+            tIntrusivePtr Ptr3(Ptr2);
+            QCOMPARE(pHelper1->m_RefCounter, QAtomicInt(2));
+            QVERIFY(Ptr3 == Ptr2);
+            // a second pointer from the raw pointer shares the counter
+            tIntrusivePtr Ptr4(pHelper1);
+            QCOMPARE(pHelper1->m_RefCounter, QAtomicInt(3));
+        }
+        QCOMPARE(pHelper1->m_RefCounter, QAtomicInt(1));
+        QCOMPARE(Data1, true);
+
+        // assignment
+        IntrusivePointerHelper *pHelper2 = new IntrusivePointerHelper(&Data2);
+        tIntrusivePtr Ptr5(pHelper2);
+        Ptr0 = Ptr2;
+        QCOMPARE(pHelper1->m_RefCounter, QAtomicInt(2));
+        Ptr0 = Ptr5;
+        QCOMPARE(pHelper1->m_RefCounter, QAtomicInt(1));
+        QCOMPARE(pHelper2->m_RefCounter, QAtomicInt(2));
+        Ptr2 = Ptr1;
+        QCOMPARE(Data1, false);
+        QVERIFY(Ptr2.IsNull());
+        Ptr0 = Ptr0;
+        QCOMPARE(pHelper2->m_RefCounter, QAtomicInt(2));
+
+        // clear
+        Ptr0.Clear();
+        QCOMPARE(pHelper2->m_RefCounter, QAtomicInt(1));
+        QCOMPARE(Data2, true);
+        Ptr5.Clear();
+        QCOMPARE(Data2, false);
+    }
+    QCOMPARE(Data1, false);
+    QCOMPARE(Data2, false);
+}
+
 } // end namespace Global
 
 QTEST_MAIN(Global::TestSharedPointer)
@@ -0,0 +1,191 @@
+/****************************************************************************/
+/*! \file TestTimerWheel.cpp
+ *
+ *  \brief Implementation file for class TestTimerWheel.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QVector>
+#include <Global/Include/TimerWheel.h>
+#include <Global/Include/LatencyHistogram.h>
+
+namespace Global {
+
+/****************************************************************************/
+/**
+ * \brief Test class for TimerWheel and LatencyHistogram classes.
+ */
+/****************************************************************************/
+class TestTimerWheel : public QObject {
+    Q_OBJECT
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called before each testfunction is executed.
+     */
+    /****************************************************************************/
+    void init();
+    /****************************************************************************/
+    /**
+     * \brief Called after each testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanup();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of deadlines within the first level.
+     */
+    /****************************************************************************/
+    void utTestShortDeadlines();
+    /****************************************************************************/
+    /**
+     * \brief Test of deadlines cascading from the upper levels.
+     */
+    /****************************************************************************/
+    void utTestCascade();
+    /****************************************************************************/
+    /**
+     * \brief Test of the latency histogram.
+     */
+    /****************************************************************************/
+    void utTestHistogram();
+}; // end class TestTimerWheel
+
+/****************************************************************************/
+void TestTimerWheel::initTestCase() {
+}
+
+/****************************************************************************/
+void TestTimerWheel::init() {
+}
+
+/****************************************************************************/
+void TestTimerWheel::cleanup() {
+}
+
+/****************************************************************************/
+void TestTimerWheel::cleanupTestCase() {
+}
+
+/****************************************************************************/
+void TestTimerWheel::utTestShortDeadlines() {
+    TimerWheel<int> Wheel(10, 1000);
+    QList<int> Expired;
+
+    QCOMPARE(Wheel.NextTimeout(1000), Q_INT64_C(-1));
+
+    Wheel.Schedule(1, 1035);
+    Wheel.Schedule(2, 1010);
+    // deadlines in the past expire with the next tick
+    Wheel.Schedule(3, 500);
+    QCOMPARE(Wheel.Count(), 3);
+    QCOMPARE(Wheel.NextTimeout(1000), Q_INT64_C(10));
+
+    Wheel.Advance(1005, Expired);
+    QCOMPARE(Expired.count(), 0);
+    Wheel.Advance(1010, Expired);
+    QCOMPARE(Expired.count(), 2);
+    QVERIFY(Expired.contains(2));
+    QVERIFY(Expired.contains(3));
+
+    // rounded up to the next tick
+    QCOMPARE(Wheel.NextTimeout(1010), Q_INT64_C(30));
+    Expired.clear();
+    Wheel.Advance(1039, Expired);
+    QCOMPARE(Expired.count(), 0);
+    Wheel.Advance(1040, Expired);
+    QCOMPARE(Expired.count(), 1);
+    QCOMPARE(Expired[0], 1);
+    QCOMPARE(Wheel.Count(), 0);
+}
+
+/****************************************************************************/
+void TestTimerWheel::utTestCascade() {
+    TimerWheel<int> Wheel(1, 0);
+    QVector<qint64> Deadlines;
+    QList<int> Expired;
+
+    // deadlines in all levels, in a pseudo random order
+    quint32 Random = 12345;
+    for (int i = 0; i < 2000; i++) {
+        Random = Random * 1103515245 + 12345;
+        qint64 Deadline = 1 + (Random >> 8) % 300000;
+        Deadlines.append(Deadline);
+        Wheel.Schedule(i, Deadline);
+    }
+
+    qint64 Now = 0;
+    while (Wheel.Count() > 0) {
+        qint64 Timeout = Wheel.NextTimeout(Now);
+        QVERIFY(Timeout >= 0);
+        Now += qMax<qint64>(Timeout, 1);
+        Expired.clear();
+        Wheel.Advance(Now, Expired);
+        for (int i = 0; i < Expired.count(); i++) {
+            // never early and never missed
+            QVERIFY(Deadlines[Expired[i]] <= Now);
+            QVERIFY(Deadlines[Expired[i]] > Now - qMax<qint64>(Timeout, 1));
+            Deadlines[Expired[i]] = -1;
+        }
+    }
+    for (int i = 0; i < Deadlines.count(); i++) {
+        QCOMPARE(Deadlines[i], Q_INT64_C(-1));
+    }
+}
+
+/****************************************************************************/
+void TestTimerWheel::utTestHistogram() {
+    LatencyHistogram Histogram;
+
+    QCOMPARE(Histogram.Total(), Q_INT64_C(0));
+    QCOMPARE(Histogram.Percentile(50), Q_INT64_C(0));
+
+    Histogram.Record(0);
+    Histogram.Record(1);
+    Histogram.Record(100);
+    Histogram.Record(100);
+    Histogram.Record(5000);
+    QCOMPARE(Histogram.Total(), Q_INT64_C(5));
+    QCOMPARE(Histogram.Count(0), 1);
+    QCOMPARE(Histogram.Count(1), 1);
+    // 64 .. 127 us
+    QCOMPARE(Histogram.Count(7), 2);
+    QCOMPARE(Histogram.Percentile(50), Q_INT64_C(127));
+    QCOMPARE(Histogram.Percentile(100), Q_INT64_C(8191));
+    QCOMPARE(Histogram.Max(), Q_INT64_C(5000));
+
+    Histogram.Reset();
+    QCOMPARE(Histogram.Total(), Q_INT64_C(0));
+    QCOMPARE(Histogram.Max(), Q_INT64_C(0));
+}
+
+} // end namespace Global
+
+QTEST_MAIN(Global::TestTimerWheel)
+
+#include "TestTimerWheel.moc"
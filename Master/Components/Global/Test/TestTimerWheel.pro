@@ -0,0 +1,9 @@
+!include("Global.pri") {
+    error("Global.pri not found")
+}
+
+TARGET = utTestTimerWheel
+
+SOURCES += TestTimerWheel.cpp
+
+UseLibs(Global)
@@ -0,0 +1,51 @@
+/****************************************************************************/
+/*! \file BinaryFrame.h
+ *
+ *  \brief Header of the binary application and Ack messages.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef NETWORKBASE_BINARYFRAME_H
+#define NETWORKBASE_BINARYFRAME_H
+
+#include <QString>
+#include <QByteArray>
+
+namespace NetworkBase {
+
+/****************************************************************************/
+/**
+ * \brief Encoding of the header which replaces the XML header of application
+ *        messages and the XML Ack when the binary wire protocol is used.
+ *
+ * Layout, big endian: quint32 reference, quint16 length of the command
+ * name, the command name in UTF-8, then the payload unchanged.
+ */
+/****************************************************************************/
+class BinaryFrame
+{
+public:
+    static const int HEADER_SIZE = 6;   ///< Size of the header without the command name.
+
+    static QByteArray Encode(const QString &CmdName, quint32 Ref, const QByteArray &Payload);
+    static bool Decode(QByteArray &Frame, QString &CmdName, quint32 &Ref);
+
+private:
+    BinaryFrame();                      ///< Not implemented.
+}; // end class BinaryFrame
+
+} // end namespace NetworkBase
+
+#endif // NETWORKBASE_BINARYFRAME_H
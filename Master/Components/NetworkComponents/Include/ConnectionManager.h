@@ -33,6 +33,7 @@
 #include <QtXml>
 
 #include <NetworkComponents/Include/NetworkServer.h>
+#include <NetworkComponents/Include/FrameReader.h>
 
 namespace NetworkBase {
 
@@ -76,6 +77,55 @@ public:
     quint32 GetRefNumber();
     QString GetClientName();
     void ForwardMessage(const QString &str);
+    void ConfirmConnection();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Set the most efficient wire protocol accepted from the Client.
+     *
+     *  \iparam  Limit - wire protocol limit, binary by default
+     */
+    /****************************************************************************/
+    inline void SetWireProtocolLimit(NetWireProtocol_t Limit)
+    {
+        m_WireLimit = Limit;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Get the wire protocol negotiated with the Client.
+     *
+     *  \return  wire protocol, XML until the Client is authenticated
+     */
+    /****************************************************************************/
+    inline NetWireProtocol_t GetWireProtocol() const
+    {
+        return m_WireProtocol;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Hand the received messages to the handler without copying them.
+     *
+     *  \iparam  ZeroCopy - true if the handler processes them synchronously
+     */
+    /****************************************************************************/
+    inline void SetZeroCopyReceive(bool ZeroCopy)
+    {
+        m_Reader.SetZeroCopy(ZeroCopy);
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Get the receive counters of the connection.
+     *
+     *  \return counters since the last reset
+     */
+    /****************************************************************************/
+    inline FrameReaderStatistics GetReceiveStatistics() const
+    {
+        return m_Reader.GetStatistics();
+    }
 
 signals:
 
@@ -182,8 +232,14 @@ private:
     QDomElement m_replySection;
     /*! State of connection: authenticated or not */
     ServerConnectionStateType_t m_connectionState;
-    /*! Block size of the data */
-    quint32 m_BlockSize;
+    /*! Receive buffer, splits the socket data into messages */
+    FrameReader m_Reader;
+    /*! True while the received messages are handled */
+    bool m_Reading;
+    /*! Most efficient wire protocol accepted from the Client */
+    NetWireProtocol_t m_WireLimit;
+    /*! Wire protocol negotiated with the Client */
+    NetWireProtocol_t m_WireProtocol;
 };
 
 } // end namespace NetworkBase
@@ -0,0 +1,160 @@
+/****************************************************************************/
+/*! \file FrameReader.h
+ *
+ *  \brief Receive buffer which splits the socket data into messages.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef NETWORKBASE_FRAMEREADER_H
+#define NETWORKBASE_FRAMEREADER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+namespace NetworkBase {
+
+/****************************************************************************/
+/**
+ * \brief Receive counters of a FrameReader.
+ */
+/****************************************************************************/
+struct FrameReaderStatistics {
+    quint64 Bytes;          ///< bytes read from the socket
+    quint64 Messages;       ///< complete messages handed out
+    quint64 Reads;          ///< socket reads, each one wakeup with data
+    quint64 Allocations;    ///< receive buffer allocations and message copies
+    qint64  Elapsed;        ///< time since the counters were reset [ns]
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Received bytes per second.
+     *
+     *  \return bytes/s, 0 if no time elapsed
+     */
+    /****************************************************************************/
+    double BytesPerSecond() const
+    {
+        return (Elapsed > 0) ? (static_cast<double>(Bytes) * 1e9 / Elapsed) : 0.0;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Received messages per second.
+     *
+     *  \return messages/s, 0 if no time elapsed
+     */
+    /****************************************************************************/
+    double MessagesPerSecond() const
+    {
+        return (Elapsed > 0) ? (static_cast<double>(Messages) * 1e9 / Elapsed) : 0.0;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Payload allocations per received message.
+     *
+     *  \return allocations per message, 0 if no message was received
+     */
+    /****************************************************************************/
+    double AllocationsPerMessage() const
+    {
+        return (Messages > 0) ? (static_cast<double>(Allocations) / Messages) : 0.0;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Messages handled per socket read.
+     *
+     *  \return messages per read, 0 if nothing was read
+     */
+    /****************************************************************************/
+    double MessagesPerRead() const
+    {
+        return (Reads > 0) ? (static_cast<double>(Messages) / Reads) : 0.0;
+    }
+};
+
+/****************************************************************************/
+/**
+ * \brief Receive buffer which splits the socket data into messages.
+ *
+ * Each message on the wire is a qint32 payload size, the marker byte and
+ * the payload, as written by QDataStream (big endian). Read fetches all
+ * available socket data with one call, NextFrame then hands out all
+ * complete messages of it. Only an incomplete message at the end of the
+ * buffer is moved to its start before the next read.
+ *
+ * In zero copy mode the payloads are slices referencing the receive
+ * buffer (QByteArray::fromRawData). A slice is valid till the next call
+ * of Read or Clear, so the receiver must process it synchronously.
+ * Modifying a slice makes an own copy of it. Otherwise each payload is
+ * copied into its own QByteArray, which may be passed on to other threads.
+ */
+/****************************************************************************/
+class FrameReader
+{
+    /// test classes are all friends:
+    friend class TestFrameReader;
+
+public:
+    static const int HEADER_SIZE = 5;       ///< size of payload size and marker byte
+    static const int INITIAL_SIZE = 4096;   ///< initial size of the receive buffer
+
+    FrameReader();
+    bool Read(QIODevice &Device);
+    bool NextFrame(quint8 &Type, QByteArray &Payload);
+    void Clear();
+    FrameReaderStatistics GetStatistics() const;
+    void ResetStatistics();
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Select slices or copies for the payloads.
+     *
+     *  \iparam  ZeroCopy - true if all receivers process the payload synchronously
+     */
+    /****************************************************************************/
+    inline void SetZeroCopy(bool ZeroCopy)
+    {
+        m_ZeroCopy = ZeroCopy;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Check if the buffer holds no part of a message.
+     *
+     *  \return true if all received data was handed out
+     */
+    /****************************************************************************/
+    inline bool IsEmpty() const
+    {
+        return (m_Begin == m_End);
+    }
+
+private:
+    void Reserve(int Size);
+
+    QByteArray              m_Buffer;       ///< receive buffer, never shared
+    int                     m_Begin;        ///< start of the unprocessed data
+    int                     m_End;          ///< end of the received data
+    bool                    m_ZeroCopy;     ///< hand out slices instead of copies
+    FrameReaderStatistics   m_Statistics;   ///< receive counters
+    QElapsedTimer           m_Clock;        ///< time base of the counters
+}; // end class FrameReader
+
+} // end namespace NetworkBase
+
+#endif // NETWORKBASE_FRAMEREADER_H
@@ -26,6 +26,7 @@
 #include <QtXml>
 #include <QTcpSocket>
 #include <NetworkComponents/Include/NetworkDevice.h>
+#include <NetworkComponents/Include/FrameReader.h>
 
 namespace NetworkBase {
 
@@ -99,6 +100,7 @@ class NetworkClient : public QObject
     /// test classes are all friends:
     friend class TestNetworkClient;
     friend class TestNetworkClientDevice;
+    friend class TestWireProtocol;
 
 public:
 
@@ -107,6 +109,32 @@ public:
     bool Initialize();
     bool RegisterMessageHandler(NetworkDevice *pH);
 
+    /****************************************************************************/
+    /*!
+     *  \brief  Set the most efficient wire protocol offered to the Server.
+     *
+     *      Takes effect with the next authentication.
+     *
+     *  \iparam  Limit - wire protocol limit, binary by default
+     */
+    /****************************************************************************/
+    inline void SetWireProtocolLimit(NetWireProtocol_t Limit)
+    {
+        m_WireLimit = Limit;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Get the receive counters of the connection.
+     *
+     *  \return counters since the last reset
+     */
+    /****************************************************************************/
+    inline FrameReaderStatistics GetReceiveStatistics() const
+    {
+        return m_Reader.GetStatistics();
+    }
+
 signals:
    /****************************************************************************/
    /*!
@@ -217,6 +245,7 @@ private:
    void AckConnection();
    void HandleInitAction(const QByteArray &msg);
    void HandleAuthAction(const QByteArray &msg);
+   bool ParseConfirmation(const QByteArray &msg, NetWireProtocol_t &Wire);
    NetworkClientType_t SetConfigParameters();
    void EmitConnectionFailed(NetworkClientErrorType_t err);
 
@@ -240,10 +269,14 @@ private:
     ClientConnectionStateType_t m_authStage;
     /*!  Internal timer */
     QTimer m_timer;
-    /*! Block size of incomming mesg */
-    qint32 m_BlockSize;
+    /*! Receive buffer, splits the socket data into messages */
+    FrameReader m_Reader;
+    /*! True while the received messages are handled */
+    bool m_Reading;
     /*!  Internal timer for Connection establishment*/
     QTimer *mp_Connectiontimer;
+    /*!  Most efficient wire protocol offered to the Server */
+    NetWireProtocol_t m_WireLimit;
 };
 
 } // end namespace NetworkBase
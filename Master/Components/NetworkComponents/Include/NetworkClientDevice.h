@@ -46,6 +46,7 @@ class NetworkClientDevice : public NetworkDevice
     /// all test classes are friends:
    friend class TestNetworkServerDevice;
    friend class TestNetworkClientDevice;
+   friend class TestWireProtocol;
 
 public:
 
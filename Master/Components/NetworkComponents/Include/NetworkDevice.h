@@ -61,6 +61,8 @@ const QString CMH_MSG_OFF_TAG         = "</message>"; ///< Message closing tag
 
 const QString CMH_AUTHENTICATION_REQ  = "<msg>Authenticate</msg>";  ///< Authentication request message
 const QString CMH_AUTHENTICATION_CONF = "<msg>Welcome</msg>";       ///< Authentication confirmation message
+const QString CMH_AUTHENTICATION_CONF_WIRE = "<msg wire=\"%1\">Welcome</msg>";  ///< Confirmation with negotiated wire protocol
+const QString CMH_WIRE_TAG_NAME       = "wire";       ///< Identifier of the wire protocol in the handshake
 
 const QString CMH_MSG_SENDING_OK      = "ok";         ///< Universal OK status for message sending
 const QString CMH_MSG_SENDING_FAILED  = "failed";     ///< Universal NACK status for message sending
@@ -71,9 +73,17 @@ const QString CMH_MSG_SENDING_TIMEOUT = "timeout";    ///< Universal TIMEOUT sta
 /// all existing Types of messages
 typedef enum {
     NET_NETLAYER_MESSAGE = 0x10,    ///< 100% XML text message used internally by network layer
-    NET_APPLICATION_MESSAGE         ///< Message with XML header and QByteArray payload used by application
+    NET_APPLICATION_MESSAGE,        ///< Message with XML header and QByteArray payload used by application
+    NET_BINARY_APPLICATION_MESSAGE, ///< Message with binary header and QByteArray payload used by application
+    NET_BINARY_ACK_MESSAGE          ///< Ack with binary header, the status is the payload
 } NetMessageType_t;
 
+/// Framing of application messages and Acks, negotiated during authentication
+typedef enum {
+    NET_WIRE_PROTOCOL_XML = 0,      ///< XML headers only, understood by every peer
+    NET_WIRE_PROTOCOL_BINARY = 1    ///< Binary headers, see BinaryFrame
+} NetWireProtocol_t;
+
 /// internally used Date and Time format (for conversions)
 const QString DATEANDTIME_FORMAT = "dd.MM.yyyy hh:mm:ss";
 
@@ -95,6 +105,7 @@ class NetworkDevice : public QObject
     friend class TestNetworkServerDevice;
     friend class TestNetworkClientDevice;
     friend class TestProtocolTxCommand;
+    friend class TestWireProtocol;
 
     /// all base netlayer commands are friends
     friend class Ack;
@@ -114,6 +125,31 @@ public:
     virtual bool InitializeDevice();
     virtual void DisconnectPeer();
     void MessageSendingResult(Global::tRefType, const QString &);
+    bool SendApplicationMessage(const QString &CmdName, quint32 Ref, const QByteArray &Payload);
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Set the wire protocol negotiated with the connected peer.
+     *
+     *  \iparam  Protocol - wire protocol
+     */
+    /****************************************************************************/
+    inline void SetWireProtocol(NetWireProtocol_t Protocol)
+    {
+        m_WireProtocol = Protocol;
+    }
+
+    /****************************************************************************/
+    /*!
+     *  \brief  Get the wire protocol used with the connected peer.
+     *
+     *  \return  wire protocol
+     */
+    /****************************************************************************/
+    inline NetWireProtocol_t GetWireProtocol() const
+    {
+        return m_WireProtocol;
+    }
 
     /****************************************************************************/
     /*!
@@ -366,6 +402,8 @@ private:
     quint32 GetNewCmdReference();
     void ParseNetLayerMessage(const QByteArray &ba);
     void ParseApplicationMessage(QByteArray &ba);
+    void ParseBinaryApplicationMessage(QByteArray &ba);
+    void ParseBinaryAcknowledge(QByteArray &ba);
     QString ExtractCommandName(QDomDocument *domD);
     QString ExtractCommandReference(QDomDocument *domD);
     bool ExtractProtocolMessage(QByteArray *ba, QDomDocument *message);
@@ -388,6 +426,8 @@ private:
     int                   m_HBDelay;
     /// Periodic HeartBeat timer
     QTimer                m_HeartBeatTimer;
+    /// wire protocol negotiated with the connected peer
+    NetWireProtocol_t     m_WireProtocol;
 };
 
 } // end namespace NetworkBase
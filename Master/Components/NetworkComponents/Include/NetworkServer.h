@@ -30,11 +30,11 @@
 #include <QtXml>
 
 #include <DataLogging/Include/DayEventEntry.h>
+#include <NetworkComponents/Include/NetworkDevice.h>
 
 namespace NetworkBase {
 
 class ConnectionManager;
-class NetworkDevice;
 
 const QString NSS_TYPE_AXEDA      = "axeda";         ///< server for communication with Axeda client
 const QString NSS_TYPE_GUI        = "gui";           ///< server for communication with normal GUI
@@ -123,6 +123,7 @@ class NetworkServer : public QTcpServer
     /// all test cases are friends:
     friend class TestNetworkServer;
     friend class TestNetworkServerDevice;
+    friend class TestWireProtocol;
 
 public:
 
@@ -134,6 +135,20 @@ public:
     NetworkServerType_t GetServerType();
     void DestroyAllConnections();
 
+    /****************************************************************************/
+    /*!
+     *  \brief  Set the most efficient wire protocol accepted from Clients.
+     *
+     *      Takes effect for Clients connecting afterwards.
+     *
+     *  \iparam  Limit - wire protocol limit, binary by default
+     */
+    /****************************************************************************/
+    inline void SetWireProtocolLimit(NetWireProtocol_t Limit)
+    {
+        m_WireLimit = Limit;
+    }
+
 protected:
     virtual void incomingConnection(qintptr sktDescriptor);
 
@@ -243,6 +258,8 @@ private:
     QString m_authConf;
     /*!  authentication reply XML Element */
     QDomElement m_authReply;
+    /*!  most efficient wire protocol accepted from Clients */
+    NetWireProtocol_t m_WireLimit;
 
 //    bool m_started;
 };
@@ -58,6 +58,7 @@ public:
     ~Ack();
     bool Execute();
     static bool SendAcknowledge(NetworkDevice *pNd, const QString &Ref, const QString &CmdName, const QString &Status);
+    static bool HandleAcknowledge(NetworkDevice *pNd, quint32 Ref, const QString &CmdName, const QString &Status);
 
 }; // command
 
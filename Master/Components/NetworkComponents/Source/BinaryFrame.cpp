@@ -0,0 +1,82 @@
+/****************************************************************************/
+/*! \file BinaryFrame.cpp
+ *
+ *  \brief BinaryFrame implementation.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QtEndian>
+#include <QDebug>
+#include <NetworkComponents/Include/BinaryFrame.h>
+
+namespace NetworkBase {
+
+/****************************************************************************/
+/*!
+ *  \brief    Builds a binary message from command name, reference and payload
+ *
+ *  \iparam   CmdName = name of the command
+ *  \iparam   Ref = net message reference
+ *  \iparam   Payload = message payload
+ *
+ *  \return   the message, empty if the command name is too long
+ *
+ ****************************************************************************/
+QByteArray BinaryFrame::Encode(const QString &CmdName, quint32 Ref, const QByteArray &Payload)
+{
+    QByteArray Name = CmdName.toUtf8();
+    if (Name.isEmpty() || (Name.size() > 0xFFFF)) {
+        qDebug() << "BinaryFrame: invalid command name" << CmdName;
+        return QByteArray();
+    }
+    QByteArray Frame(HEADER_SIZE + Name.size() + Payload.size(), Qt::Uninitialized);
+    uchar *p_Data = reinterpret_cast<uchar *>(Frame.data());
+    qToBigEndian<quint32>(Ref, p_Data);
+    qToBigEndian<quint16>(static_cast<quint16>(Name.size()), p_Data + 4);
+    memcpy(p_Data + HEADER_SIZE, Name.constData(), Name.size());
+    memcpy(p_Data + HEADER_SIZE + Name.size(), Payload.constData(), Payload.size());
+    return Frame;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Reads and removes the header of a binary message
+ *
+ *  \param[in,out] Frame = incoming message, payload only on return
+ *  \param[out]    CmdName = name of the command
+ *  \param[out]    Ref = net message reference
+ *
+ *  \return   true if the header is complete, false otherwise
+ *
+ ****************************************************************************/
+bool BinaryFrame::Decode(QByteArray &Frame, QString &CmdName, quint32 &Ref)
+{
+    if (Frame.size() < HEADER_SIZE) {
+        qDebug() << "BinaryFrame: incoming message is too short !";
+        return false;
+    }
+    const uchar *p_Data = reinterpret_cast<const uchar *>(Frame.constData());
+    int NameSize = qFromBigEndian<quint16>(p_Data + 4);
+    if ((NameSize == 0) || (Frame.size() < HEADER_SIZE + NameSize)) {
+        qDebug() << "BinaryFrame: incoming message is broken !";
+        return false;
+    }
+    Ref = qFromBigEndian<quint32>(p_Data);
+    CmdName = QString::fromUtf8(Frame.constData() + HEADER_SIZE, NameSize);
+    Frame.remove(0, HEADER_SIZE + NameSize);
+    return true;
+}
+
+} // end namespace NetworkBase
@@ -57,7 +57,9 @@ ConnectionManager::ConnectionManager(QHash<QString, QString> hash,
                                      m_authConfirm(conf),
                                      m_replySection(d),
                                      m_connectionState(CM_NOT_AUTHENTICATED),
-                                     m_BlockSize(0)
+                                     m_Reading(false),
+                                     m_WireLimit(NET_WIRE_PROTOCOL_BINARY),
+                                     m_WireProtocol(NET_WIRE_PROTOCOL_XML)
 
 {
 }
@@ -152,10 +154,14 @@ void ConnectionManager::HandleTimeout()
  ****************************************************************************/
 void ConnectionManager::ReadSocket()
 {
-    QDataStream in;
-    in.setDevice(&m_TcpSocket);
-    in.setVersion(static_cast<int>(QDataStream::Qt_4_0));
+    // a handler processing events must not read into the buffer
+    // while it still works on a message of it:
+    if (m_Reading) {
+        return;
+    }
+    m_Reading = true;
     quint8 MarkerByte = 0;
+    QByteArray incoming_data;
 
     // The TcpSocket's readyRead signal will only be emitted one time if new
     // data is available. This means if we are too slow to fetch data, any
@@ -165,44 +171,36 @@ void ConnectionManager::ReadSocket()
     // the next readyRead signal:
     do {  // while -->
 
-        if (m_BlockSize == 0) {
-            if (m_TcpSocket.bytesAvailable() < (int)sizeof(quint32)) {
-                return;
-            }
-            in >> m_BlockSize;
+        if (!m_Reader.Read(m_TcpSocket)) {
+            break;
         }
 
-        // make sure message came with marker byte (therefore "+ 1"):
-        if (m_TcpSocket.bytesAvailable() < (m_BlockSize + 1)) {
-            //qDebug() << "CMANAGER: message not yet complete...";
-            Global::EventObject::Instance().RaiseEvent(EVENT_CM_ERROR_MSG_INCOMPLETE,
-                                                       Global::tTranslatableStringList() << m_myClient);
-            return;
-        }
-
-        // get the MarkerByte value
-        in >> MarkerByte;
-        // read payload data
-        QByteArray incoming_data = m_TcpSocket.read(m_BlockSize);
-
-        // if the connection is already authenticated, data shall be
-        // forwarded to the Protocol Handler:
-        if (m_connectionState == CM_AUTHENTICATED) {
-            //qDebug() << "CMANAGER: about to emit SIGNAL msgReceived() to ProtocolHandler !";
-            emit MsgReceived(MarkerByte, incoming_data);
-        }
-        else {
-        // The only Client data this object should process is the authentication response.
-        // Any other response is an error. There will be no message parsing here, it will be
-        // done by the MessageHandler.
-            if (!CheckAuthenticationResponse(&incoming_data)) {
-                // error logging is done by the Server
-                DestroyConnection(AUTHENTICATION_FAILED);
+        // handle all complete messages of this read:
+        while (m_Reader.NextFrame(MarkerByte, incoming_data)) {
+            // if the connection is already authenticated, data shall be
+            // forwarded to the Protocol Handler:
+            if (m_connectionState == CM_AUTHENTICATED) {
+                //qDebug() << "CMANAGER: about to emit SIGNAL msgReceived() to ProtocolHandler !";
+                emit MsgReceived(MarkerByte, incoming_data);
+            }
+            else {
+            // The only Client data this object should process is the authentication response.
+            // Any other response is an error. There will be no message parsing here, it will be
+            // done by the MessageHandler.
+                if (!CheckAuthenticationResponse(&incoming_data)) {
+                    // error logging is done by the Server
+                    DestroyConnection(AUTHENTICATION_FAILED);
+                }
             }
         }
-        MarkerByte = 0;
-        m_BlockSize = 0;
     } while (m_TcpSocket.bytesAvailable());
+
+    if (!m_Reader.IsEmpty()) {
+        //qDebug() << "CMANAGER: message not yet complete...";
+        Global::EventObject::Instance().RaiseEvent(EVENT_CM_ERROR_MSG_INCOMPLETE,
+                                                   Global::tTranslatableStringList() << m_myClient);
+    }
+    m_Reading = false;
 }
 /****************************************************************************/
 /*!
@@ -287,6 +285,9 @@ bool ConnectionManager::ParseAuthenticationResponse(QDomDocument *d)
     QString name = elmt.text();
     elmt = elmt.nextSiblingElement();
     QString version = elmt.text();
+    // optional wire protocol offered by the Client, older Clients do not send it
+    bool ok = false;
+    int offered = root.firstChildElement(CMH_WIRE_TAG_NAME).text().toInt(&ok);
 
     // instantiate new ProtocolHandler if correct authentication string is found.
     if (m_authenticationStringsList.contains(name) &&
@@ -295,6 +296,14 @@ bool ConnectionManager::ParseAuthenticationResponse(QDomDocument *d)
         m_myClient = name;
         // change state to AUTHENTICATED
         m_connectionState = CM_AUTHENTICATED;
+        // use binary framing only if both sides support it
+        if (ok && (offered >= static_cast<int>(NET_WIRE_PROTOCOL_BINARY)) &&
+                (m_WireLimit == NET_WIRE_PROTOCOL_BINARY)) {
+            m_WireProtocol = NET_WIRE_PROTOCOL_BINARY;
+        }
+        else {
+            m_WireProtocol = NET_WIRE_PROTOCOL_XML;
+        }
         // inform TcpServer about successful connection:
         qDebug() << (QString)("Client connected! \nClient Name: " + name + "\nClient Version: " + version);
         Global::EventObject::Instance().RaiseEvent(EVENT_CM_CLIENT_CONNECTED,
@@ -351,6 +360,24 @@ void ConnectionManager::ForwardMessage(const QString &str)
     ForwardMessage(static_cast<quint8>(NET_NETLAYER_MESSAGE), ba);
 }
 
+/****************************************************************************/
+/*!
+ *  \brief    This function confirms the authentication to Client.
+ *
+ *      The negotiated wire protocol is added only if it is not XML, so
+ *      older Clients get the confirmation they expect.
+ *
+ ****************************************************************************/
+void ConnectionManager::ConfirmConnection()
+{
+    if (m_WireProtocol == NET_WIRE_PROTOCOL_XML) {
+        ForwardMessage(CMH_AUTHENTICATION_CONF);
+    }
+    else {
+        ForwardMessage(CMH_AUTHENTICATION_CONF_WIRE.arg(static_cast<int>(m_WireProtocol)));
+    }
+}
+
 /****************************************************************************/
 /*!
  *  \brief    This SLOT forwards message to connected Client.
@@ -0,0 +1,179 @@
+/****************************************************************************/
+/*! \file FrameReader.cpp
+ *
+ *  \brief FrameReader implementation.
+ *
+ *   $Version: $ 0.1
+ *   $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <cstring>
+#include <QtEndian>
+#include <NetworkComponents/Include/FrameReader.h>
+
+namespace NetworkBase {
+
+const int FrameReader::HEADER_SIZE;
+const int FrameReader::INITIAL_SIZE;
+
+/****************************************************************************/
+/*!
+ *  \brief    Constructor
+ *
+ ****************************************************************************/
+FrameReader::FrameReader() :
+    m_Begin(0),
+    m_End(0),
+    m_ZeroCopy(false)
+{
+    ResetStatistics();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Reads all available data of the device into the buffer
+ *
+ *      Invalidates the slices handed out before.
+ *
+ *  \param    Device = socket to read from
+ *
+ *  \return   false if the device reported a read error, true otherwise
+ *
+ ****************************************************************************/
+bool FrameReader::Read(QIODevice &Device)
+{
+    qint64 Available = Device.bytesAvailable();
+    if (Available <= 0) {
+        return true;
+    }
+    Reserve(static_cast<int>(Available));
+    qint64 Count = Device.read(m_Buffer.data() + m_End, Available);
+    if (Count < 0) {
+        return false;
+    }
+    m_End += static_cast<int>(Count);
+    m_Statistics.Bytes += static_cast<quint64>(Count);
+    m_Statistics.Reads++;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Hands out the next complete message of the buffer
+ *
+ *  \param[out]   Type = marker byte of the message
+ *  \param[out]   Payload = payload of the message, a slice in zero copy mode
+ *
+ *  \return   true if a complete message was found, false otherwise
+ *
+ ****************************************************************************/
+bool FrameReader::NextFrame(quint8 &Type, QByteArray &Payload)
+{
+    if (m_End - m_Begin < HEADER_SIZE) {
+        return false;
+    }
+    const uchar *p_Header = reinterpret_cast<const uchar *>(m_Buffer.constData() + m_Begin);
+    quint32 Size = qFromBigEndian<quint32>(p_Header);
+    if (static_cast<quint32>(m_End - m_Begin - HEADER_SIZE) < Size) {
+        // message not yet complete
+        return false;
+    }
+    Type = p_Header[4];
+    const char *p_Payload = m_Buffer.constData() + m_Begin + HEADER_SIZE;
+    if (m_ZeroCopy) {
+        Payload = QByteArray::fromRawData(p_Payload, static_cast<int>(Size));
+    }
+    else {
+        Payload = QByteArray(p_Payload, static_cast<int>(Size));
+        m_Statistics.Allocations++;
+    }
+    m_Begin += HEADER_SIZE + static_cast<int>(Size);
+    if (m_Begin == m_End) {
+        // everything processed, the next read starts at the beginning
+        m_Begin = 0;
+        m_End = 0;
+    }
+    m_Statistics.Messages++;
+    return true;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Drops all buffered data, e.g. after a disconnect
+ *
+ *      The buffer itself is kept, so slices handed out stay readable
+ *      till the next read.
+ *
+ ****************************************************************************/
+void FrameReader::Clear()
+{
+    m_Begin = 0;
+    m_End = 0;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Returns the receive counters
+ *
+ *  \return   counters since the last reset
+ *
+ ****************************************************************************/
+FrameReaderStatistics FrameReader::GetStatistics() const
+{
+    FrameReaderStatistics Statistics = m_Statistics;
+    Statistics.Elapsed = m_Clock.nsecsElapsed();
+    return Statistics;
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Resets the receive counters
+ *
+ ****************************************************************************/
+void FrameReader::ResetStatistics()
+{
+    m_Statistics.Bytes = 0;
+    m_Statistics.Messages = 0;
+    m_Statistics.Reads = 0;
+    m_Statistics.Allocations = 0;
+    m_Statistics.Elapsed = 0;
+    m_Clock.start();
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    Makes room for more data behind the received data
+ *
+ *      An incomplete message is moved to the start of the buffer first.
+ *      The buffer grows only if that is not enough.
+ *
+ *  \param    Size = number of bytes to read
+ *
+ ****************************************************************************/
+void FrameReader::Reserve(int Size)
+{
+    if (m_End + Size <= m_Buffer.size()) {
+        return;
+    }
+    if (m_Begin > 0) {
+        memmove(m_Buffer.data(), m_Buffer.constData() + m_Begin, static_cast<size_t>(m_End - m_Begin));
+        m_End -= m_Begin;
+        m_Begin = 0;
+    }
+    if (m_End + Size > m_Buffer.size()) {
+        m_Buffer.resize(qMax(qMax(m_Buffer.size() * 2, INITIAL_SIZE), m_End + Size));
+        m_Statistics.Allocations++;
+    }
+}
+
+} // end namespace NetworkBase
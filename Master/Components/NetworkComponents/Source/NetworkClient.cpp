@@ -50,8 +50,9 @@ NetworkClient::NetworkClient(NetworkClientType_t type, const QString &ip, const
       m_Ip(ip),
       m_port(port),
       m_authStage(NC_INIT),
-      m_BlockSize(0),
-      mp_Connectiontimer(NULL)
+      m_Reading(false),
+      mp_Connectiontimer(NULL),
+      m_WireLimit(NET_WIRE_PROTOCOL_BINARY)
 {
 }
 
@@ -65,6 +66,7 @@ NetworkClient::NetworkClient(NetworkClientType_t type, const QString &ip, const
 void NetworkClient::ConnectToServer()
 {
     m_tcpSocket.abort();
+    m_Reader.Clear();
     m_tcpSocket.connectToHost(m_Ip, m_port.toUInt());
     qDebug() << "NetworkClient: connecting to server " << m_Ip << "/" << m_port;
 
@@ -169,52 +171,45 @@ void NetworkClient::HandleAuthTimeout()
  ****************************************************************************/
 void NetworkClient::ReadRawSocket()
 {
- //  Incoming data TCP Socket stream
-  QDataStream in;
-  in.setDevice(&m_tcpSocket);
-  in.setVersion(static_cast<int>(QDataStream::Qt_4_0));
-  quint8 MarkerByte = 0;
-
-  // The TcpSocket's readyRead signal will only be emitted one time if new
-  // data is available. This means if we are too slow to fetch data, any
-  // new incoming message will not generate the readyRead signal. Therefore
-  // we have to keep fetching data from Socket till we get it all. Otherwise
-  // the data will wait in the queue till next message arrives and generates
-  // the next readyRead signal:
-  do { // while() -->
-    if (m_BlockSize == 0) {
-        if (m_tcpSocket.bytesAvailable() < (int)sizeof(quint32)) {
-            return;
-        }
-        in >> m_BlockSize;
-    }
-    // make sure message came with marker byte (therefore BlockSize + 1):
-    if (m_tcpSocket.bytesAvailable() < (m_BlockSize + 1)) {
-        qDebug()<<"\n\n Marker byte not available";
+    // a handler processing events must not read into the buffer
+    // while it still works on a message of it:
+    if (m_Reading) {
         return;
     }
-    in >> MarkerByte;
-    QByteArray response = m_tcpSocket.read(m_BlockSize);
-    switch (m_authStage) {
-    case NC_INIT:
-        HandleInitAction(response);
-        break;
-    case NC_NOT_AUTHENTICATED:
-        HandleAuthAction(response);
-        break;
-    case NC_AUTHENTICATED:
-        // Connection is established at this point --> forward msg to the MessageHandler
-        emit ForwardToMessageHandler(MarkerByte, response);
-        break;
-    default:
-        /// \todo: what here?
-        break;
-    }
-
-    MarkerByte = 0;
-    m_BlockSize = 0;
-
-  } while (m_tcpSocket.bytesAvailable());
+    m_Reading = true;
+    quint8 MarkerByte = 0;
+    QByteArray response;
+
+    // The TcpSocket's readyRead signal will only be emitted one time if new
+    // data is available. This means if we are too slow to fetch data, any
+    // new incoming message will not generate the readyRead signal. Therefore
+    // we have to keep fetching data from Socket till we get it all. Otherwise
+    // the data will wait in the queue till next message arrives and generates
+    // the next readyRead signal:
+    do { // while() -->
+        if (!m_Reader.Read(m_tcpSocket)) {
+            break;
+        }
+        // handle all complete messages of this read:
+        while (m_Reader.NextFrame(MarkerByte, response)) {
+            switch (m_authStage) {
+            case NC_INIT:
+                HandleInitAction(response);
+                break;
+            case NC_NOT_AUTHENTICATED:
+                HandleAuthAction(response);
+                break;
+            case NC_AUTHENTICATED:
+                // Connection is established at this point --> forward msg to the MessageHandler
+                emit ForwardToMessageHandler(MarkerByte, response);
+                break;
+            default:
+                /// \todo: what here?
+                break;
+            }
+        }
+    } while (m_tcpSocket.bytesAvailable());
+    m_Reading = false;
 }
 
 /****************************************************************************/
@@ -261,7 +256,6 @@ void NetworkClient::HandleInitAction(const QByteArray &msg)
 void NetworkClient::HandleAuthAction(const QByteArray &msg)
 {
     qDebug() << "xxxxx NetworkClient::HandleAuthAction";
-    static int SignalsConnected = 0;
     // stop the authentication timer:
     static_cast<void>(
             // cannot use return value here anyway
@@ -269,9 +263,9 @@ void NetworkClient::HandleAuthAction(const QByteArray &msg)
     );
     m_timer.stop();
 
-    QString in(msg);
+    NetWireProtocol_t Wire = NET_WIRE_PROTOCOL_XML;
 
-    if (in == CMH_AUTHENTICATION_CONF) {
+    if (ParseConfirmation(msg, Wire)) {
 
         m_authStage = NC_AUTHENTICATED;
         if (m_msgHdlr == 0) {
@@ -284,13 +278,12 @@ void NetworkClient::HandleAuthAction(const QByteArray &msg)
 
         try {
             try {
-                if (SignalsConnected == 0) {
-                    CONNECTSIGNALSLOT(this, ForwardToMessageHandler(quint8, QByteArray &),
-                                      m_msgHdlr, GetIncomingMsg(quint8, QByteArray &));
-                    CONNECTSIGNALSLOT(m_msgHdlr, SendMessage(quint8, const QByteArray &),
-                                      this, SendMessage(quint8, const QByteArray &));
-                    SignalsConnected++;
-                }
+                // DisconnectFromServer disconnects them, so connect on every authentication.
+                // CONNECTSIGNALSLOT drops an existing connection first.
+                CONNECTSIGNALSLOT(this, ForwardToMessageHandler(quint8, QByteArray &),
+                                  m_msgHdlr, GetIncomingMsg(quint8, QByteArray &));
+                CONNECTSIGNALSLOT(m_msgHdlr, SendMessage(quint8, const QByteArray &),
+                                  this, SendMessage(quint8, const QByteArray &));
             }
             CATCHALL_RETHROW();
         }
@@ -299,6 +292,11 @@ void NetworkClient::HandleAuthAction(const QByteArray &msg)
             EmitConnectionFailed(NC_SIGNAL_CONNECT_FAILED);
             return;
         }
+        // frame application messages as negotiated with the Server
+        m_msgHdlr->SetWireProtocol(Wire);
+        // the client devices forward the messages to the upper layers by queued
+        // signals, so the payload must not point into the receive buffer
+        m_Reader.SetZeroCopy(false);
         // inform users about successful connection
         emit ConnectionEstablished(m_myName);
         if (mp_Connectiontimer) {
@@ -317,6 +315,48 @@ void NetworkClient::HandleAuthAction(const QByteArray &msg)
 
 }
 
+/****************************************************************************/
+/*!
+ *  \brief    This function checks the Server authentication confirmation
+ *
+ *      Older Servers confirm with the plain confirmation and use XML.
+ *      Servers supporting the binary wire protocol add the negotiated
+ *      wire protocol as attribute.
+ *
+ *  \param    msg = Server message
+ *  \param    Wire = negotiated wire protocol
+ *
+ *  \return   true if the message is a valid confirmation, false otherwise
+ *
+ ****************************************************************************/
+bool NetworkClient::ParseConfirmation(const QByteArray &msg, NetWireProtocol_t &Wire)
+{
+    Wire = NET_WIRE_PROTOCOL_XML;
+    if (QString(msg) == CMH_AUTHENTICATION_CONF) {
+        return true;
+    }
+    QDomDocument domD;
+    QDomDocument conf;
+    if (!domD.setContent(msg) || !conf.setContent(CMH_AUTHENTICATION_CONF)) {
+        return false;
+    }
+    QDomElement root = domD.documentElement();
+    if ((root.tagName() != conf.documentElement().tagName()) ||
+        (root.text() != conf.documentElement().text())) {
+        return false;
+    }
+    bool ok = false;
+    int offered = root.attribute(CMH_WIRE_TAG_NAME).toInt(&ok);
+    if (!ok) {
+        return false;
+    }
+    // never use more than offered, whatever the Server replies
+    if ((offered == static_cast<int>(NET_WIRE_PROTOCOL_BINARY)) && (m_WireLimit == NET_WIRE_PROTOCOL_BINARY)) {
+        Wire = NET_WIRE_PROTOCOL_BINARY;
+    }
+    return true;
+}
+
 /****************************************************************************/
 /*!
  *  \brief    Register a Message Handler for certain Client type.
@@ -356,7 +396,13 @@ void NetworkClient::AckConnection()
 {
     QString str = NC_MSG_ON_TAG + "<cmd>Authentication</cmd><name>" + m_myName +
                                   "</name><version>" + m_myVersion +
-                                  "</version>" + NC_MSG_OFF_TAG;
+                                  "</version>";
+    // offer the binary wire protocol, older Servers ignore this element
+    if (m_WireLimit != NET_WIRE_PROTOCOL_XML) {
+        str += "<" + CMH_WIRE_TAG_NAME + ">" + QString::number(static_cast<int>(m_WireLimit)) +
+               "</" + CMH_WIRE_TAG_NAME + ">";
+    }
+    str += NC_MSG_OFF_TAG;
 
     //<msg><cmd>CONTENTS</cmd><name>CONTENTS</name><version>CONTENTS</version></msg>
 
@@ -439,6 +485,8 @@ void NetworkClient::DisconnectFromServer()
     m_authStage = NC_INIT;
     m_tcpSocket.disconnectFromHost();
     m_tcpSocket.close();
+    // drop the rest of a message of this connection
+    m_Reader.Clear();
 }
 
 /****************************************************************************/
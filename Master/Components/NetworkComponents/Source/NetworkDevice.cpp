@@ -21,6 +21,8 @@
 #include <NetworkComponents/Include/ProtocolTxCommand.h>
 #include <NetworkComponents/Include/ProtocolRxCommand.h>
 #include <NetworkComponents/Include/NetworkDevice.h>
+#include <NetworkComponents/Include/BinaryFrame.h>
+#include <NetworkComponents/Include/ProtocolRxCommands/Ack.h>
 #include <Global/Include/TranslatableString.h>
 #include <Global/Include/GlobalEventCodes.h>
 #include <Global/Include/Exception.h>
@@ -49,7 +51,8 @@ NetworkDevice::NetworkDevice(MessageLoaderType_t ptype, const QString &path, QOb
         m_myMessageChecker(NULL),
         m_myType(ptype),
         m_myPath(path),
-        m_cmdRef(0)
+        m_cmdRef(0),
+        m_WireProtocol(NET_WIRE_PROTOCOL_XML)
 {
     RunningCommands.clear();
     switch (ptype) {
@@ -367,6 +370,8 @@ void NetworkDevice::PeerDisconnected(const QString &name)
 
     m_HeartBeatTimer.stop();
     qDebug() << "NetworkDevice: HeartBeat Timer stopped.";
+    // the next peer negotiates its wire protocol again
+    m_WireProtocol = NET_WIRE_PROTOCOL_XML;
 
     // inform whoever is interested in this event
     emit SigPeerDisconnected(name);
@@ -413,6 +418,12 @@ void NetworkDevice::GetIncomingMsg(quint8 type, QByteArray &ba)
     case NET_APPLICATION_MESSAGE:
         ParseApplicationMessage(ba);
         break;
+    case NET_BINARY_APPLICATION_MESSAGE:
+        ParseBinaryApplicationMessage(ba);
+        break;
+    case NET_BINARY_ACK_MESSAGE:
+        ParseBinaryAcknowledge(ba);
+        break;
     default:
         /// \todo: handle error?
         // unknown message type: reply with error?
@@ -497,6 +508,60 @@ void NetworkDevice::ParseApplicationMessage(QByteArray &ba)
     );
 }
 
+/****************************************************************************/
+/*!
+ *  \brief    This function parses an incoming message with binary header
+ *
+ *            The binary header replaces the XML header of an application
+ *            message, so neither DOM parsing nor schema check is needed.
+ *
+ *  \param    ba = incoming message's payload
+ *
+ *  \warning  ba is consciously non-const
+ *
+ ****************************************************************************/
+void NetworkDevice::ParseBinaryApplicationMessage(QByteArray &ba)
+{
+    QString cmdname = "";
+    quint32 ref = 0;
+    if (!BinaryFrame::Decode(ba, cmdname, ref)) {
+        emit MessageParsingFailed();
+        Global::EventObject::Instance().RaiseEvent(EVENT_ND_MSG_PARSING_ERROR,
+                                                   Global::tTranslatableStringList() << "binary header broken");
+        return;
+    }
+    // call corresponding message handler (in the derived class)
+    static_cast<void> (
+        // no use for the return value here: application shall handle errors in this case.
+        ProcessIncomingMessage(cmdname, QString::number(ref, 10), ba)
+    );
+}
+
+/****************************************************************************/
+/*!
+ *  \brief    This function parses an incoming Ack with binary header
+ *
+ *  \param    ba = incoming Ack, the payload is the status
+ *
+ *  \warning  ba is consciously non-const
+ *
+ ****************************************************************************/
+void NetworkDevice::ParseBinaryAcknowledge(QByteArray &ba)
+{
+    QString cmdname = "";
+    quint32 ref = 0;
+    // the status must follow the header
+    if (!BinaryFrame::Decode(ba, cmdname, ref) || ba.isEmpty()) {
+        emit MessageParsingFailed();
+        Global::EventObject::Instance().RaiseEvent(EVENT_ND_MSG_PARSING_ERROR,
+                                                   Global::tTranslatableStringList() << "binary header broken");
+        return;
+    }
+    if (!Ack::HandleAcknowledge(this, ref, cmdname, QString::fromUtf8(ba.constData(), ba.size()))) {
+        emit MessageParsingFailed();
+    }
+}
+
 /****************************************************************************/
 /*!
  *  \brief  This method processes an incomig from peer device message.
@@ -677,7 +742,7 @@ bool NetworkDevice::ExtractProtocolMessage(QByteArray *ba, QDomDocument *message
     }
     // read protocol message to string
     Index = Index + checkstring.size();
-    QByteArray batemp(ba->data(), Index);
+    QByteArray batemp(ba->constData(), Index);
     QString msg(batemp);
 
     // remove the protocol message from array
@@ -753,6 +818,37 @@ bool NetworkDevice::SendCommand(NetMessageType_t cmdtype, const QByteArray &ba)
     return true;
 }
 
+/****************************************************************************/
+/*!
+ *  \brief    This function sends an application message to peer
+ *
+ *            The header is XML or binary, depending on the wire protocol
+ *            negotiated with the peer.
+ *
+ *  \iparam   CmdName = name of the command
+ *  \iparam   Ref = net message reference
+ *  \iparam   Payload = message payload
+ *
+ *  \return   True if the message was sent, False otherwise
+ *
+ ****************************************************************************/
+bool NetworkDevice::SendApplicationMessage(const QString &CmdName, quint32 Ref, const QByteArray &Payload)
+{
+    if (m_WireProtocol == NET_WIRE_PROTOCOL_BINARY) {
+        QByteArray Frame = BinaryFrame::Encode(CmdName, Ref, Payload);
+        if (Frame.isEmpty()) {
+            return false;
+        }
+        return SendCommand(NET_BINARY_APPLICATION_MESSAGE, Frame);
+    }
+    // construct the message:
+    QString msg = "<message><cmd name=\"" + CmdName + "\" ref=\"" + QString::number(Ref, 10) + "\" /></message>";
+    QByteArray Frame = msg.toUtf8();
+    // append the payload to the text header:
+    Frame.append(Payload);
+    return SendCommand(NET_APPLICATION_MESSAGE, Frame);
+}
+
 /****************************************************************************/
 /*!
  *  \brief  This method creates and sends a new outgoing protocol command.
@@ -58,7 +58,8 @@ NetworkServer::NetworkServer(NetworkServerType_t type, QObject *pParent)
                     m_myPort(""),
                     m_myType(type),
                     m_authReq(""),
-                    m_authConf("")
+                    m_authConf(""),
+                    m_WireLimit(NET_WIRE_PROTOCOL_BINARY)
 //                    m_started(false)
 {
     m_connectionsList.clear();
@@ -150,6 +151,7 @@ void NetworkServer::incomingConnection(qintptr sktDescriptor)
         try {
             // create connection manager:
             ConnectionManager* cManager = new ConnectionManager(m_availableConnections, m_connectionCounter, m_authReq, m_authConf, m_authReply, this);
+            cManager->SetWireProtocolLimit(m_WireLimit);
 
             // connect all needed signals/slots:
             try {
@@ -358,10 +360,15 @@ void NetworkServer::RegisterConnection(quint32 number, const QString &client)
         m_takenConnections.insert(client, m_availableConnections.value(client));
         m_availableConnections.remove(client);
 
+        // frame application messages as negotiated with the client
+        pHandler->SetWireProtocol(cManager->GetWireProtocol());
+        // a handler in another thread gets the messages queued, so it needs copies
+        cManager->SetZeroCopyReceive(pHandler->thread() == cManager->thread());
+
         // confirm client's connection
         /// \todo: do we need flexibility with this?
         m_authConf = CMH_AUTHENTICATION_CONF;
-        cManager->ForwardMessage(m_authConf);
+        cManager->ConfirmConnection();
 
         // inform controlling entity about new client connection
         emit ClientConnected(client);
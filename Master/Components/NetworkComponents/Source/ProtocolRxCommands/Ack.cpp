@@ -20,6 +20,7 @@
 
 #include <NetworkComponents/Include/ProtocolRxCommands/Ack.h>
 #include <NetworkComponents/Include/ProtocolTxCommand.h>
+#include <NetworkComponents/Include/BinaryFrame.h>
 #include <Global/Include/Utils.h>
 #include <NetworkComponents/Include/NetworkComponentEventCodes.h>
 #include <Global/Include/EventObject.h>
@@ -62,6 +63,13 @@ bool Ack::SendAcknowledge(NetworkDevice *pNd, const QString &Ref, const QString
     if ((pNd == NULL) || Ref.isEmpty() || CmdName.isEmpty() ) {
         return false;
     }
+    if (pNd->GetWireProtocol() == NET_WIRE_PROTOCOL_BINARY) {
+        QByteArray Frame = BinaryFrame::Encode(CmdName, Ref.toUInt(), Status.toUtf8());
+        if (Frame.isEmpty()) {
+            return false;
+        }
+        return pNd->SendCommand(NET_BINARY_ACK_MESSAGE, Frame);
+    }
     // Construct Ack:
     QString msg = "<message><cmd name=\"Ack\" ref=\"" + Ref +
                   "\" /><dataitems cmd=\"" + CmdName + "\" status=\"" + Status + "\" /></message>";
@@ -104,36 +112,56 @@ bool Ack::Execute()
         return false;
     }
 
+    QString status = (emt.firstChildElement("dataitems")).attribute("status", "NULL");
+    if ((status.isEmpty()) || (status == "NULL")) {
+        // ack is not complete - do not know what to do with it
+        qDebug() << (QString)"Ack: ERROR -> status empty !";
+        Global::EventObject::Instance().RaiseEvent(EVENT_NL_COMMAND_NOT_COMPLETE,
+                                                   Global::tTranslatableStringList() << status << FILE_LINE);
+        return false;
+    }
+
+    return HandleAcknowledge(m_myDevice, m_myRef.toULong(), cmd, status);
+}
+
+/****************************************************************************/
+/*!
+ *  \brief   Pass an Ack to the acknowledged running command
+ *
+ *      Called for XML Acks by Execute and for binary Acks directly by
+ *      the NetworkDevice.
+ *
+ *  \iparam  pNd = pointer to the NetworkDevice
+ *  \iparam  Ref = protocol message reference
+ *  \iparam  CmdName = name of acknowledged command
+ *  \iparam  Status = status of command execution
+ *
+ *  \return  TRUE if the command was found, FALSE otherwise
+ *
+ ****************************************************************************/
+bool Ack::HandleAcknowledge(NetworkDevice *pNd, quint32 Ref, const QString &CmdName, const QString &Status)
+{
     // fetch the command we are supposed to ack:
-    ProtocolTxCommand*  scmd = m_myDevice->FetchRunningCommand(m_myRef.toULong());
+    ProtocolTxCommand*  scmd = pNd->FetchRunningCommand(Ref);
     if (scmd == NULL) {
         // no such command running - do not know what to do with it
         qDebug() << (QString)"Ack: ERROR -> cannot fetch running command !";
         Global::EventObject::Instance().RaiseEvent(EVENT_NL_COMMAND_NOT_RUNNING,
-                                                   Global::tTranslatableStringList() << m_myRef << FILE_LINE);
+                                                   Global::tTranslatableStringList() << QString::number(Ref) << FILE_LINE);
         return false;
     }
 
     // check if this is a correct command:
-    if (cmd != scmd->GetName()) {
+    if (CmdName != scmd->GetName()) {
         // cmd name does not correspond to reference - do not know what to do with it
-        qDebug() << (QString)"Ack: ERROR -> ackCmdName (" << cmd << ") != fetchedCmdName (" << scmd->GetName() << ") !";
+        qDebug() << (QString)"Ack: ERROR -> ackCmdName (" << CmdName << ") != fetchedCmdName (" << scmd->GetName() << ") !";
         Global::EventObject::Instance().RaiseEvent(EVENT_NL_COMMAND_INVALID_REFERENCE,
-                                                   Global::tTranslatableStringList() << cmd << FILE_LINE);
-        return false;
-    }
-
-    QString status = (emt.firstChildElement("dataitems")).attribute("status", "NULL");
-    if ((status.isEmpty()) || (status == "NULL")) {
-        // ack is not complete - do not know what to do with it
-        qDebug() << (QString)"Ack: ERROR -> status empty !";
-        Global::EventObject::Instance().RaiseEvent(EVENT_NL_COMMAND_NOT_COMPLETE,
-                                                   Global::tTranslatableStringList() << status << FILE_LINE);
+                                                   Global::tTranslatableStringList() << CmdName << FILE_LINE);
         return false;
     }
 
     // all OK, call corresponding Ack function:
-    scmd->HandleAck(status);
+    scmd->HandleAck(Status);
 
     return true;
 }
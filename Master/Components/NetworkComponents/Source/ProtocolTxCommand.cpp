@@ -256,12 +256,8 @@ bool ProtocolTxCommand::Execute()
 {
     // register command with Device:
     m_myDevice->RegisterRunningCommand(m_myRef, this);
-    // construct the message:
-    QString msg = "<message><cmd name=\"" + m_myName + "\" ref=\"" + QString::number(m_myRef, 10) + "\" /></message>";
-    // prepend text header to the payload:
-    m_myPayloadArray.prepend(msg.toUtf8());
-    // send message to Recipient:
-    bool result = m_myDevice->SendCommand(NetworkBase::NET_APPLICATION_MESSAGE, m_myPayloadArray);
+    // send message to Recipient, the device adds the header of its wire protocol:
+    bool result = m_myDevice->SendApplicationMessage(m_myName, m_myRef, m_myPayloadArray);
     // set timer for Ack timeout!
     m_myTimer.start(NetworkBase::ACK_TIMEOUT);
 
@@ -11,6 +11,8 @@ SUBDIRS += TestNetworkServer.pro \
            TestConnectionManager.pro \
            TestProtocolRxCommand.pro \
            TestProtocolTxCommand.pro \
-           TestCreatorFunctor.pro
+           TestCreatorFunctor.pro \
+           TestWireProtocol.pro \
+           TestFrameReader.pro
 
 CONFIG += ordered
@@ -0,0 +1,486 @@
+/****************************************************************************/
+/*! \file TestFrameReader.cpp
+ *
+ *  \brief Implementation file for class TestFrameReader.
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <NetworkComponents/Test/TestFrameReader.h>
+
+namespace NetworkBase {
+
+static const int FRAME_COUNT = 100;         ///< Number of frames of the functional tests.
+static const int BENCHMARK_FRAMES = 100000; ///< Number of frames of the benchmark.
+static const int SEGMENT_SIZE = 1460;       ///< Data per wakeup in the benchmark, one TCP segment.
+
+/****************************************************************************/
+/**
+ * \brief Frame a message as NetworkClient::SendMessage does.
+ *
+ * \iparam  Type = marker byte
+ * \iparam  Payload = message payload
+ *
+ * \return  Framed message.
+ */
+/****************************************************************************/
+static QByteArray CreateFrame(quint8 Type, const QByteArray &Payload)
+{
+    QByteArray Frame;
+    QDataStream Stream(&Frame, QIODevice::WriteOnly);
+    Stream.setVersion(static_cast<int>(QDataStream::Qt_4_0));
+    Stream << static_cast<qint32>(Payload.size()) << Type;
+    static_cast<void>(Stream.writeRawData(Payload.constData(), Payload.size()));
+    return Frame;
+}
+
+/****************************************************************************/
+/**
+ * \brief Payload of the i-th test message, of varying size.
+ *
+ * \iparam  Index = message index
+ *
+ * \return  Payload.
+ */
+/****************************************************************************/
+static QByteArray CreatePayload(int Index)
+{
+    return QByteArray("<msg><cmd name=\"CmdTest\" ref=\"") + QByteArray::number(Index) + "\"/></msg>"
+            + QByteArray(Index % 50, 'x');
+}
+
+/****************************************************************************/
+/**
+ * \brief Read the frames as ReadRawSocket did before the FrameReader.
+ *
+ * \iparam  Device = device to read from
+ * \iparam  BlockSize = size of a pending message, kept between the calls
+ * \iparam  Messages = number of read messages
+ * \iparam  Allocations = number of payload allocations
+ */
+/****************************************************************************/
+static void LegacyRead(QIODevice &Device, qint32 &BlockSize, int &Messages, int &Allocations)
+{
+    QDataStream in;
+    in.setDevice(&Device);
+    in.setVersion(static_cast<int>(QDataStream::Qt_4_0));
+    quint8 MarkerByte = 0;
+    do {
+        if (BlockSize == 0) {
+            if (Device.bytesAvailable() < (int)sizeof(quint32)) {
+                return;
+            }
+            in >> BlockSize;
+        }
+        if (Device.bytesAvailable() < (BlockSize + 1)) {
+            return;
+        }
+        in >> MarkerByte;
+        QByteArray response = Device.read(BlockSize);
+        Messages++;
+        Allocations++;
+        BlockSize = 0;
+    } while (Device.bytesAvailable());
+}
+
+/****************************************************************************/
+/**
+ * \brief Constructor.
+ */
+/****************************************************************************/
+ChunkedDevice::ChunkedDevice() :
+    m_Pos(0),
+    m_Limit(0)
+{
+    static_cast<void>(open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+}
+
+/****************************************************************************/
+/**
+ * \brief Append data, it is readable after its release.
+ *
+ * \iparam  Data = data to append
+ */
+/****************************************************************************/
+void ChunkedDevice::Append(const QByteArray &Data)
+{
+    m_Data.append(Data);
+}
+
+/****************************************************************************/
+/**
+ * \brief Make more data readable.
+ *
+ * \iparam  Count = number of bytes
+ */
+/****************************************************************************/
+void ChunkedDevice::Release(qint64 Count)
+{
+    m_Limit = qMin(m_Limit + Count, static_cast<qint64>(m_Data.size()));
+}
+
+/****************************************************************************/
+/**
+ * \brief Check if all data is released.
+ *
+ * \return  true if nothing is left to release
+ */
+/****************************************************************************/
+bool ChunkedDevice::AtEnd() const
+{
+    return m_Limit == m_Data.size();
+}
+
+/****************************************************************************/
+/**
+ * \brief Released data not yet read.
+ *
+ * \return  Number of bytes.
+ */
+/****************************************************************************/
+qint64 ChunkedDevice::bytesAvailable() const
+{
+    return m_Limit - m_Pos + QIODevice::bytesAvailable();
+}
+
+/****************************************************************************/
+/**
+ * \brief The device is a stream like a socket.
+ *
+ * \return  true
+ */
+/****************************************************************************/
+bool ChunkedDevice::isSequential() const
+{
+    return true;
+}
+
+/****************************************************************************/
+/**
+ * \brief Read released data.
+ *
+ * \iparam  pData = destination
+ * \iparam  MaxSize = size of the destination
+ *
+ * \return  Number of read bytes.
+ */
+/****************************************************************************/
+qint64 ChunkedDevice::readData(char *pData, qint64 MaxSize)
+{
+    qint64 Count = qMin(MaxSize, m_Limit - m_Pos);
+    memcpy(pData, m_Data.constData() + m_Pos, static_cast<size_t>(Count));
+    m_Pos += Count;
+    return Count;
+}
+
+/****************************************************************************/
+/**
+ * \brief Writing is not supported.
+ *
+ * \iparam  pData = not used
+ * \iparam  MaxSize = not used
+ *
+ * \return  -1
+ */
+/****************************************************************************/
+qint64 ChunkedDevice::writeData(const char *pData, qint64 MaxSize)
+{
+    Q_UNUSED(pData)
+    Q_UNUSED(MaxSize)
+    return -1;
+}
+
+/****************************************************************************/
+/**
+ * \brief Called before each testfunction is executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestFrameReader::init()
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Called after each testfunction was executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestFrameReader::cleanup()
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Called before the first testfunction is executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestFrameReader::initTestCase()
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Called after last testfunction was executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestFrameReader::cleanupTestCase()
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Frames arriving byte by byte are reassembled.
+ */
+/****************************************************************************/
+void TestFrameReader::utTestSplitFrames()
+{
+    ChunkedDevice Device;
+    int Size = 0;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        QByteArray Frame = CreateFrame(static_cast<quint8>(i), CreatePayload(i));
+        Device.Append(Frame);
+        Size += Frame.size();
+    }
+    FrameReader Reader;
+    quint8 Type = 0;
+    QByteArray Payload;
+    int Received = 0;
+    while (!Device.AtEnd()) {
+        Device.Release(1);
+        QVERIFY(Reader.Read(Device));
+        while (Reader.NextFrame(Type, Payload)) {
+            QCOMPARE(Type, static_cast<quint8>(Received));
+            QCOMPARE(Payload, CreatePayload(Received));
+            Received++;
+        }
+    }
+    QCOMPARE(Received, FRAME_COUNT);
+    QVERIFY(Reader.IsEmpty());
+
+    FrameReaderStatistics Statistics = Reader.GetStatistics();
+    QCOMPARE(Statistics.Messages, static_cast<quint64>(FRAME_COUNT));
+    QCOMPARE(Statistics.Bytes, static_cast<quint64>(Size));
+    QCOMPARE(Statistics.Reads, static_cast<quint64>(Size));
+    QVERIFY(Statistics.MessagesPerRead() < 1.0);
+}
+
+/****************************************************************************/
+/**
+ * \brief Many frames of one wakeup are handled with one read.
+ */
+/****************************************************************************/
+void TestFrameReader::utTestCoalescedFrames()
+{
+    ChunkedDevice Device;
+    QByteArray Data;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        Data.append(CreateFrame(1, CreatePayload(i)));
+    }
+    Device.Append(Data);
+    Device.Release(Data.size());
+
+    FrameReader Reader;
+    QVERIFY(Reader.Read(Device));
+    QCOMPARE(Device.bytesAvailable(), Q_INT64_C(0));
+    quint8 Type = 0;
+    QByteArray Payload;
+    int Received = 0;
+    while (Reader.NextFrame(Type, Payload)) {
+        QCOMPARE(Payload, CreatePayload(Received));
+        Received++;
+    }
+    QCOMPARE(Received, FRAME_COUNT);
+
+    FrameReaderStatistics Statistics = Reader.GetStatistics();
+    QCOMPARE(Statistics.Reads, Q_UINT64_C(1));
+    QCOMPARE(Statistics.Bytes, static_cast<quint64>(Data.size()));
+    QCOMPARE(Statistics.MessagesPerRead(), static_cast<double>(FRAME_COUNT));
+    QVERIFY(Statistics.BytesPerSecond() > 0.0);
+    QVERIFY(Statistics.MessagesPerSecond() > 0.0);
+
+    Reader.ResetStatistics();
+    Statistics = Reader.GetStatistics();
+    QCOMPARE(Statistics.Messages, Q_UINT64_C(0));
+    QVERIFY(Statistics.AllocationsPerMessage() == 0.0);
+}
+
+/****************************************************************************/
+/**
+ * \brief Zero copy payloads reference the receive buffer, otherwise
+ *        each payload is an own copy.
+ */
+/****************************************************************************/
+void TestFrameReader::utTestZeroCopy()
+{
+    QByteArray Data;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        Data.append(CreateFrame(1, CreatePayload(i)));
+    }
+
+    for (int Mode = 0; Mode < 2; Mode++) {
+        bool ZeroCopy = (Mode == 1);
+        ChunkedDevice Device;
+        Device.Append(Data);
+        Device.Release(Data.size());
+        FrameReader Reader;
+        Reader.SetZeroCopy(ZeroCopy);
+        QVERIFY(Reader.Read(Device));
+        const char *p_Begin = Reader.m_Buffer.constData();
+        const char *p_End = p_Begin + Reader.m_Buffer.size();
+
+        quint8 Type = 0;
+        QByteArray Payload;
+        int Received = 0;
+        while (Reader.NextFrame(Type, Payload)) {
+            bool InBuffer = (Payload.constData() >= p_Begin) && (Payload.constData() < p_End);
+            QCOMPARE(InBuffer, ZeroCopy);
+            QCOMPARE(Payload, CreatePayload(Received));
+            Received++;
+        }
+        QCOMPARE(Received, FRAME_COUNT);
+
+        // the buffer is the only allocation in zero copy mode
+        FrameReaderStatistics Statistics = Reader.GetStatistics();
+        QCOMPARE(Statistics.Allocations, static_cast<quint64>(ZeroCopy ? 1 : 1 + FRAME_COUNT));
+    }
+
+    // modifying a slice copies it and leaves the buffer untouched
+    ChunkedDevice Device;
+    Device.Append(CreateFrame(1, "abcdef"));
+    Device.Release(100);
+    FrameReader Reader;
+    Reader.SetZeroCopy(true);
+    QVERIFY(Reader.Read(Device));
+    quint8 Type = 0;
+    QByteArray Payload;
+    QVERIFY(Reader.NextFrame(Type, Payload));
+    static_cast<void>(Payload.remove(0, 3));
+    QCOMPARE(Payload, QByteArray("def"));
+    QCOMPARE(QByteArray(Reader.m_Buffer.constData() + FrameReader::HEADER_SIZE, 6), QByteArray("abcdef"));
+}
+
+/****************************************************************************/
+/**
+ * \brief The buffer keeps incomplete frames, grows only for large frames
+ *        and drops its data on Clear.
+ */
+/****************************************************************************/
+void TestFrameReader::utTestBuffer()
+{
+    FrameReader Reader;
+    quint8 Type = 0;
+    QByteArray Payload;
+
+    // an incomplete frame at the end is moved to the start of the buffer
+    ChunkedDevice Device;
+    QByteArray Small = CreateFrame(1, QByteArray(1000, 's'));
+    for (int i = 0; i < 20; i++) {
+        Device.Append(Small);
+    }
+    while (!Device.AtEnd()) {
+        Device.Release(FrameReader::INITIAL_SIZE - Small.size());
+        QVERIFY(Reader.Read(Device));
+        while (Reader.NextFrame(Type, Payload)) {
+            QCOMPARE(Payload.size(), 1000);
+        }
+    }
+    QVERIFY(Reader.IsEmpty());
+    QCOMPARE(Reader.GetStatistics().Messages, Q_UINT64_C(20));
+    QCOMPARE(Reader.m_Buffer.size(), static_cast<int>(FrameReader::INITIAL_SIZE));
+
+    // a large frame grows the buffer
+    QByteArray Large(3 * FrameReader::INITIAL_SIZE, 'l');
+    Device.Append(CreateFrame(2, Large));
+    Device.Release(Large.size() + FrameReader::HEADER_SIZE);
+    QVERIFY(Reader.Read(Device));
+    QVERIFY(Reader.NextFrame(Type, Payload));
+    QCOMPARE(Type, static_cast<quint8>(2));
+    QCOMPARE(Payload, Large);
+    QVERIFY(Reader.m_Buffer.size() >= Large.size() + FrameReader::HEADER_SIZE);
+
+    // a size not yet satisfied just waits for more data
+    Device.Append(CreateFrame(3, "abc").left(6));
+    Device.Release(6);
+    QVERIFY(Reader.Read(Device));
+    QVERIFY(!Reader.NextFrame(Type, Payload));
+    QVERIFY(!Reader.IsEmpty());
+    Reader.Clear();
+    QVERIFY(Reader.IsEmpty());
+    QVERIFY(!Reader.NextFrame(Type, Payload));
+}
+
+/****************************************************************************/
+/**
+ * \brief Compare the FrameReader with the reading as it was before.
+ */
+/****************************************************************************/
+void TestFrameReader::utTestBenchmark()
+{
+    QByteArray Data;
+    for (int i = 0; i < BENCHMARK_FRAMES; i++) {
+        Data.append(CreateFrame(1, CreatePayload(i)));
+    }
+
+    ChunkedDevice LegacyDevice;
+    LegacyDevice.Append(Data);
+    qint32 BlockSize = 0;
+    int LegacyMessages = 0;
+    int LegacyAllocations = 0;
+    QElapsedTimer Timer;
+    Timer.start();
+    while (!LegacyDevice.AtEnd()) {
+        LegacyDevice.Release(SEGMENT_SIZE);
+        LegacyRead(LegacyDevice, BlockSize, LegacyMessages, LegacyAllocations);
+    }
+    qint64 LegacyTime = Timer.nsecsElapsed();
+    QCOMPARE(LegacyMessages, BENCHMARK_FRAMES);
+
+    ChunkedDevice Device;
+    Device.Append(Data);
+    FrameReader Reader;
+    Reader.SetZeroCopy(true);
+    quint8 Type = 0;
+    QByteArray Payload;
+    int Messages = 0;
+    Timer.restart();
+    while (!Device.AtEnd()) {
+        Device.Release(SEGMENT_SIZE);
+        QVERIFY(Reader.Read(Device));
+        while (Reader.NextFrame(Type, Payload)) {
+            Messages++;
+        }
+    }
+    qint64 Time = Timer.nsecsElapsed();
+    QCOMPARE(Messages, BENCHMARK_FRAMES);
+
+    FrameReaderStatistics Statistics = Reader.GetStatistics();
+    QVERIFY(Statistics.AllocationsPerMessage() < 0.01);
+    qDebug() << BENCHMARK_FRAMES << "frames in" << SEGMENT_SIZE << "byte segments:"
+             << "QDataStream" << static_cast<double>(BENCHMARK_FRAMES) * 1e9 / LegacyTime << "msg/s,"
+             << static_cast<double>(LegacyAllocations) / LegacyMessages << "allocations/msg;"
+             << "FrameReader" << static_cast<double>(BENCHMARK_FRAMES) * 1e9 / Time << "msg/s,"
+             << Statistics.AllocationsPerMessage() << "allocations/msg,"
+             << Statistics.MessagesPerRead() << "msg/read";
+}
+
+} // end namespace
+
+QTEST_MAIN(NetworkBase::TestFrameReader)
@@ -0,0 +1,82 @@
+/****************************************************************************/
+/*! \file TestFrameReader.h
+ *
+ *  \brief Definition file for class TestFrameReader.
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef NETWORKBASE_TESTFRAMEREADER_H
+#define NETWORKBASE_TESTFRAMEREADER_H
+
+#include <QObject>
+#include <NetworkComponents/Include/FrameReader.h>
+
+namespace NetworkBase {
+
+/****************************************************************************/
+/**
+ * \brief Sequential device which releases its data in chunks, as a socket
+ *        does with each readyRead.
+ */
+/****************************************************************************/
+class ChunkedDevice : public QIODevice
+{
+public:
+
+    ChunkedDevice();
+    void Append(const QByteArray &Data);
+    void Release(qint64 Count);
+    bool AtEnd() const;
+    qint64 bytesAvailable() const;
+    bool isSequential() const;
+
+protected:
+
+    qint64 readData(char *pData, qint64 MaxSize);
+    qint64 writeData(const char *pData, qint64 MaxSize);
+
+private:
+
+    QByteArray  m_Data;     ///< all data of the device
+    qint64      m_Pos;      ///< read position
+    qint64      m_Limit;    ///< end of the released data
+};
+
+/****************************************************************************/
+/**
+ * \brief Test class for the FrameReader.
+ */
+/****************************************************************************/
+class TestFrameReader: public QObject
+{
+  Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void init();
+    void cleanup();
+    void cleanupTestCase();
+
+    void utTestSplitFrames();                 ///< Test F1
+    void utTestCoalescedFrames();             ///< Test F2
+    void utTestZeroCopy();                    ///< Test F3
+    void utTestBuffer();                      ///< Test F4
+    void utTestBenchmark();                   ///< Test F5
+};
+
+} // end namespace
+
+#endif // NETWORKBASE_TESTFRAMEREADER_H
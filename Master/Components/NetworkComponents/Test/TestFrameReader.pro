@@ -0,0 +1,16 @@
+!include("NetworkComponentsTest.pri") {
+    error("NetworkComponentsTest.pri not found")
+}
+
+QT += xml \
+      xmlpatterns \
+      network
+
+TARGET = utTestFrameReader
+
+HEADERS += TestFrameReader.h
+
+SOURCES += TestFrameReader.cpp
+
+
+UseLibs(Global DataLogging NetworkComponents)
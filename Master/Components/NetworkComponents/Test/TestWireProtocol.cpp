@@ -0,0 +1,344 @@
+/****************************************************************************/
+/*! \file TestWireProtocol.cpp
+ *
+ *  \brief Implementation file for class TestWireProtocol.
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <NetworkComponents/Test/TestWireProtocol.h>
+#include <NetworkComponents/Include/BinaryFrame.h>
+#include <Global/Include/SystemPaths.h>
+
+namespace NetworkBase {
+
+static const int WAIT_TIMEOUT = 5000;       ///< Maximum time to wait for a connection or an Ack [ms].
+static const int ROUND_TRIPS = 2000;        ///< Number of measured round trips per wire protocol.
+
+/****************************************************************************/
+/**
+ * \brief Build a payload as the application serializes its commands.
+ *
+ * \return  Payload.
+ */
+/****************************************************************************/
+static QByteArray CreatePayload()
+{
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(static_cast<int>(QDataStream::Qt_4_0));
+    Stream << QString("Station") << static_cast<quint32>(42) << QString("Reagent 7") << static_cast<qint64>(-1);
+    return Payload;
+}
+
+/****************************************************************************/
+/**
+ * \brief Constructor.
+ */
+/****************************************************************************/
+TestWireProtocol::TestWireProtocol() :
+            mp_Server(NULL),
+            mp_ServerDevice(NULL),
+            mp_ClientDevice(NULL),
+            m_Results(0)
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Destructor.
+ */
+/****************************************************************************/
+TestWireProtocol::~TestWireProtocol()
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Called before each testfunction is executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestWireProtocol::init()
+{
+    m_ReceivedName = "";
+    m_ReceivedPayload.clear();
+    m_Status = "";
+    m_Results = 0;
+}
+
+/****************************************************************************/
+/**
+ * \brief Called after each testfunction was executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestWireProtocol::cleanup()
+{
+}
+
+/****************************************************************************/
+/**
+ * \brief Called before the first testfunction is executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestWireProtocol::initTestCase()
+{
+    // initialize settings path:
+    Global::SystemPaths::Instance().SetSettingsPath("../Settings");
+    QString path =  Global::SystemPaths::Instance().GetSettingsPath() + "/Communication";
+
+    // server on a free loopback port:
+    mp_Server = new NetworkServer(NSE_TYPE_NORMAL_GUI, this);
+    QCOMPARE(mp_Server->InitializeServer(), (NetworkServerErrorType_t)NS_ALL_OK);
+    mp_Server->m_myIp = UT_WIRE_IP;
+    mp_Server->m_myPort = "0";
+    QCOMPARE(mp_Server->StartServer(), (NetworkServerErrorType_t)NS_ALL_OK);
+    mp_Server->m_availableConnections.insert(UT_WIRE_CLIENT, "1.0");
+
+    // only the messaging of the server device, the test provides the server:
+    mp_ServerDevice = new NetworkServerDevice(NSE_TYPE_NORMAL_GUI, UT_WIRE_CLIENT, path, this);
+    QCOMPARE(mp_ServerDevice->NetworkDevice::InitializeDevice(), true);
+    QCOMPARE(mp_Server->RegisterMessageHandler(mp_ServerDevice, UT_WIRE_CLIENT), true);
+    if (!QObject::connect(mp_ServerDevice, SIGNAL(SigMsgSendingResult(Global::tRefType, const QString &)),
+                          this, SLOT(TestMsgSendingResult(Global::tRefType, const QString &)))) {
+        QFAIL("TestWireProtocol: cannot connect SigMsgSendingResult signal !");
+    }
+
+    mp_ClientDevice = new NetworkClientDevice(NCE_TYPE_HIMALAYA_GUI, UT_WIRE_IP,
+                                              QString::number(mp_Server->serverPort()), path, this);
+    QCOMPARE(mp_ClientDevice->InitializeDevice(), true);
+    QCOMPARE(mp_ClientDevice->m_myNetworkClient->m_myName, UT_WIRE_CLIENT);
+    if (!QObject::connect(mp_ClientDevice, SIGNAL(ForwardMessageToUpperLayer(const QString &, const QByteArray &)),
+                          this, SLOT(TestMessageReceived(const QString &, const QByteArray &)))) {
+        QFAIL("TestWireProtocol: cannot connect ForwardMessageToUpperLayer signal !");
+    }
+}
+
+/****************************************************************************/
+/**
+ * \brief Called after last testfunction was executed.
+ *        (Qt Test framework standard function)
+ */
+/****************************************************************************/
+void TestWireProtocol::cleanupTestCase()
+{
+    delete mp_ClientDevice;
+    delete mp_ServerDevice;
+    delete mp_Server;
+}
+
+/****************************************************************************/
+/**
+ * \brief Test the negotiation of the wire protocol.
+ */
+/****************************************************************************/
+void TestWireProtocol::utTestNegotiation()
+{
+    // the binary header round trip:
+    QByteArray Frame = BinaryFrame::Encode(UT_WIRE_COMMAND, 0x01020304, CreatePayload());
+    QCOMPARE(Frame.size(), BinaryFrame::HEADER_SIZE + UT_WIRE_COMMAND.size() + CreatePayload().size());
+    QString Name = "";
+    quint32 Ref = 0;
+    QCOMPARE(BinaryFrame::Decode(Frame, Name, Ref), true);
+    QCOMPARE(Name, UT_WIRE_COMMAND);
+    QCOMPARE(Ref, (quint32)0x01020304);
+    QCOMPARE(Frame, CreatePayload());
+    // broken headers:
+    QCOMPARE(BinaryFrame::Encode("", 1, CreatePayload()).isEmpty(), true);
+    Frame = BinaryFrame::Encode(UT_WIRE_COMMAND, 1, QByteArray());
+    Frame.chop(1);
+    QCOMPARE(BinaryFrame::Decode(Frame, Name, Ref), false);
+
+    // both sides support binary:
+    QVERIFY(Connect(NET_WIRE_PROTOCOL_BINARY, NET_WIRE_PROTOCOL_BINARY));
+    QCOMPARE(mp_ServerDevice->GetWireProtocol(), NET_WIRE_PROTOCOL_BINARY);
+    QCOMPARE(mp_ClientDevice->GetWireProtocol(), NET_WIRE_PROTOCOL_BINARY);
+    QVERIFY(SendAndWait(CreatePayload()));
+    QCOMPARE(m_ReceivedName, UT_WIRE_COMMAND);
+    QCOMPARE(m_ReceivedPayload, CreatePayload());
+    // an empty payload is allowed as well:
+    QVERIFY(SendAndWait(QByteArray()));
+    QCOMPARE(m_ReceivedPayload.isEmpty(), true);
+    QVERIFY(Disconnect());
+}
+
+/****************************************************************************/
+/**
+ * \brief Test the fallback to XML for peers not supporting binary.
+ */
+/****************************************************************************/
+void TestWireProtocol::utTestFallback()
+{
+    // server limited to XML confirms like an older server:
+    QVERIFY(Connect(NET_WIRE_PROTOCOL_XML, NET_WIRE_PROTOCOL_BINARY));
+    QCOMPARE(mp_ServerDevice->GetWireProtocol(), NET_WIRE_PROTOCOL_XML);
+    QCOMPARE(mp_ClientDevice->GetWireProtocol(), NET_WIRE_PROTOCOL_XML);
+    QVERIFY(SendAndWait(CreatePayload()));
+    QCOMPARE(m_ReceivedPayload, CreatePayload());
+    QVERIFY(Disconnect());
+
+    // client limited to XML authenticates like an older client:
+    QVERIFY(Connect(NET_WIRE_PROTOCOL_BINARY, NET_WIRE_PROTOCOL_XML));
+    QCOMPARE(mp_ServerDevice->GetWireProtocol(), NET_WIRE_PROTOCOL_XML);
+    QCOMPARE(mp_ClientDevice->GetWireProtocol(), NET_WIRE_PROTOCOL_XML);
+    QVERIFY(SendAndWait(CreatePayload()));
+    QCOMPARE(m_ReceivedPayload, CreatePayload());
+    QVERIFY(Disconnect());
+}
+
+/****************************************************************************/
+/**
+ * \brief Compare the round trip time of both wire protocols.
+ */
+/****************************************************************************/
+void TestWireProtocol::utTestRoundTrip()
+{
+    QVERIFY(Connect(NET_WIRE_PROTOCOL_BINARY, NET_WIRE_PROTOCOL_XML));
+    qint64 XmlTime = MeasureRoundTrip(ROUND_TRIPS);
+    QVERIFY(XmlTime >= 0);
+    QVERIFY(Disconnect());
+
+    QVERIFY(Connect(NET_WIRE_PROTOCOL_BINARY, NET_WIRE_PROTOCOL_BINARY));
+    qint64 BinaryTime = MeasureRoundTrip(ROUND_TRIPS);
+    QVERIFY(BinaryTime >= 0);
+    FrameReaderStatistics Statistics = mp_ClientDevice->m_myNetworkClient->GetReceiveStatistics();
+    QVERIFY(Statistics.Messages >= static_cast<quint64>(2 * ROUND_TRIPS));
+    QVERIFY(Disconnect());
+
+    qDebug() << ROUND_TRIPS << "round trips: XML" << static_cast<double>(XmlTime) / ROUND_TRIPS / 1000 << "us,"
+             << "binary" << static_cast<double>(BinaryTime) / ROUND_TRIPS / 1000 << "us per message and Ack";
+    qDebug() << "Client receive:" << Statistics.MessagesPerSecond() << "msg/s," << Statistics.BytesPerSecond() << "bytes/s,"
+             << Statistics.AllocationsPerMessage() << "allocations/msg," << Statistics.MessagesPerRead() << "msg/read";
+}
+
+/****************************************************************************/
+/**
+ * \brief Connect the client to the server.
+ *
+ * \iparam  ServerLimit = wire protocol limit of the server
+ * \iparam  ClientLimit = wire protocol limit of the client
+ *
+ * \return  true if the client is authenticated
+ */
+/****************************************************************************/
+bool TestWireProtocol::Connect(NetWireProtocol_t ServerLimit, NetWireProtocol_t ClientLimit)
+{
+    mp_Server->SetWireProtocolLimit(ServerLimit);
+    mp_ClientDevice->m_myNetworkClient->SetWireProtocolLimit(ClientLimit);
+    QSignalSpy Spy(mp_ClientDevice->m_myNetworkClient, SIGNAL(ConnectionEstablished(const QString &)));
+    if (!mp_ClientDevice->StartDevice()) {
+        return false;
+    }
+    return Spy.wait(WAIT_TIMEOUT);
+}
+
+/****************************************************************************/
+/**
+ * \brief Disconnect the client and wait till the server released the client.
+ *
+ * \return  true if the server released the client
+ */
+/****************************************************************************/
+bool TestWireProtocol::Disconnect()
+{
+    QSignalSpy Spy(mp_Server, SIGNAL(ClientDisconnected(const QString &)));
+    mp_ClientDevice->m_myNetworkClient->DisconnectFromServer();
+    return Spy.wait(WAIT_TIMEOUT) && mp_Server->m_availableConnections.contains(UT_WIRE_CLIENT);
+}
+
+/****************************************************************************/
+/**
+ * \brief Send an application message and wait for its Ack.
+ *
+ * \iparam  Payload = payload of the message
+ *
+ * \return  true if the message was acked
+ */
+/****************************************************************************/
+bool TestWireProtocol::SendAndWait(const QByteArray &Payload)
+{
+    int Results = m_Results;
+    mp_ServerDevice->SendOutgoingCommand(UT_WIRE_COMMAND, Payload, 1);
+    QElapsedTimer Timer;
+    Timer.start();
+    while ((m_Results == Results) && (Timer.elapsed() < WAIT_TIMEOUT)) {
+        // the Ack timeout of the command wakes us up at the latest
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    return (m_Results > Results) && (m_Status == CMH_MSG_SENDING_ACK);
+}
+
+/****************************************************************************/
+/**
+ * \brief Send application messages one after the other, each after the Ack
+ *        of the previous one.
+ *
+ * \iparam  Count = number of messages
+ *
+ * \return  duration of all round trips [ns], -1 if a message was not acked
+ */
+/****************************************************************************/
+qint64 TestWireProtocol::MeasureRoundTrip(int Count)
+{
+    QByteArray Payload = CreatePayload();
+    QElapsedTimer Timer;
+    Timer.start();
+    for (int i = 0; i < Count; i++) {
+        if (!SendAndWait(Payload)) {
+            return -1;
+        }
+    }
+    return Timer.nsecsElapsed();
+}
+
+/****************************************************************************/
+/**
+ *  \brief Test slot for the application messages received by the client.
+ *
+ *  \param  name = command name
+ *  \param  payload = command payload
+ */
+/****************************************************************************/
+void TestWireProtocol::TestMessageReceived(const QString &name, const QByteArray &payload)
+{
+    m_ReceivedName = name;
+    m_ReceivedPayload = payload;
+}
+
+/****************************************************************************/
+/**
+ *  \brief Test slot for the delivery results of the server device.
+ *
+ *  \param  Ref = application reference
+ *  \param  status = delivery status
+ */
+/****************************************************************************/
+void TestWireProtocol::TestMsgSendingResult(Global::tRefType Ref, const QString &status)
+{
+    Q_UNUSED(Ref)
+    // "ok" only confirms the sending, wait for the Ack
+    if (status != CMH_MSG_SENDING_OK) {
+        m_Status = status;
+        m_Results++;
+    }
+}
+
+} // end namespace
+
+QTEST_MAIN(NetworkBase::TestWireProtocol)
@@ -0,0 +1,84 @@
+/****************************************************************************/
+/*! \file TestWireProtocol.h
+ *
+ *  \brief Definition file for class TestWireProtocol.
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#ifndef NETWORKBASE_TESTWIREPROTOCOL_H
+#define NETWORKBASE_TESTWIREPROTOCOL_H
+
+#include <NetworkComponents/Include/NetworkServer.h>
+#include <NetworkComponents/Include/NetworkServerDevice.h>
+#include <NetworkComponents/Include/NetworkClientDevice.h>
+
+namespace NetworkBase {
+
+const QString UT_WIRE_IP = "127.0.0.1";             ///< loopback ip of the test server
+const QString UT_WIRE_CLIENT = "Skyline Device GUI"; ///< name of the NCE_TYPE_HIMALAYA_GUI client
+const QString UT_WIRE_COMMAND = "CmdWireTest";      ///< name of the application command
+
+/****************************************************************************/
+/**
+ * \brief Test class for the negotiation and the round trip time of the
+ *        XML and the binary wire protocol over loopback.
+ */
+/****************************************************************************/
+class TestWireProtocol: public QObject
+{
+  Q_OBJECT
+
+public:
+
+    TestWireProtocol();
+    ~TestWireProtocol();
+
+public slots:
+
+    void TestMessageReceived(const QString &name, const QByteArray &payload);
+    void TestMsgSendingResult(Global::tRefType Ref, const QString &status);
+
+private slots:
+
+    void initTestCase();
+    void init();
+    void cleanup();
+    void cleanupTestCase();
+
+    void utTestNegotiation();                 ///< Test N1
+    void utTestFallback();                    ///< Test N2
+    void utTestRoundTrip();                   ///< Test N3
+
+private:
+
+    bool Connect(NetWireProtocol_t ServerLimit, NetWireProtocol_t ClientLimit);
+    bool Disconnect();
+    bool SendAndWait(const QByteArray &Payload);
+    qint64 MeasureRoundTrip(int Count);
+
+private:
+
+    NetworkServer           *mp_Server;         ///< server of the test
+    NetworkServerDevice     *mp_ServerDevice;   ///< device sending the application messages
+    NetworkClientDevice     *mp_ClientDevice;   ///< device receiving and acking them
+    QString                 m_ReceivedName;     ///< name of the last received command
+    QByteArray              m_ReceivedPayload;  ///< payload of the last received command
+    QString                 m_Status;           ///< last delivery status
+    int                     m_Results;          ///< number of delivery results
+};
+
+} // end namespace
+
+#endif // NETWORKBASE_TESTWIREPROTOCOL_H
@@ -0,0 +1,16 @@
+!include("NetworkComponentsTest.pri") {
+    error("NetworkComponentsTest.pri not found")
+}
+
+QT += xml \
+      xmlpatterns \
+      network
+
+TARGET = utTestWireProtocol
+
+HEADERS += TestWireProtocol.h
+
+SOURCES += TestWireProtocol.cpp
+
+
+UseLibs(Global DataLogging NetworkComponents)
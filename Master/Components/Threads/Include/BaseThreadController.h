@@ -24,9 +24,14 @@
 #include <Global/Include/RefManager.h>
 #include <Global/Include/Commands/CmdDataChanged.h>
 #include <Global/Include/Commands/CmdPowerFail.h>
-#include <Global/Include/Commands/PendingCmdDescriptor.h>
+#include <Global/Include/Commands/CommandTypeID.h>
+#include <Global/Include/LatencyHistogram.h>
+#include <Global/Include/TimerWheel.h>
 #include <Threads/Include/CommandFunctors.h>
 #include <QSet>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include <QThread>
 
@@ -47,8 +52,8 @@ typedef Global::SharedPointer<AcknowledgeProcessorFunctor>      AcknowledgeProce
 typedef Global::SharedPointer<TimeoutProcessorFunctor>          TimeoutProcessorFunctorShPtr_t;     ///< Typedef or a shared pointer of TimeoutProcessorFunctor.
 typedef Global::SharedPointer<Global::CmdDataChangedFunctor>    CmdDataChangedFunctorShPtr_t;       ///< Typedef or a shared pointer of CmdDataChangedFunctor.
 
-typedef QHash<QString, AcknowledgeProcessorFunctorShPtr_t>  AcknowledgeProcessorFunctorHash_t;  ///< Typedef for the AcknowledgeProcessorFunctorShPtr_t functor hash.
-typedef QHash<QString, TimeoutProcessorFunctorShPtr_t>      TimeoutProcessorFunctorHash_t;      ///< Typedef for the TimeoutProcessorFunctorShPtr_t functor hash.
+typedef Global::CommandTypeTable<AcknowledgeProcessorFunctorShPtr_t>    AcknowledgeProcessorFunctorTable_t; ///< Typedef for the AcknowledgeProcessorFunctorShPtr_t functor table by acknowledge type ID.
+typedef Global::CommandTypeTable<TimeoutProcessorFunctorShPtr_t>        TimeoutProcessorFunctorTable_t;     ///< Typedef for the TimeoutProcessorFunctorShPtr_t functor table by command type ID.
 typedef QHash<QString, CmdDataChangedFunctorShPtr_t>        CmdDataChangedFunctorHash_t;        ///< Typedef for the CmdDataChangedFunctorShPtr_t functor hash.
 
 
@@ -74,12 +79,33 @@ class BaseThreadController:public QObject {
 friend void CommandChannel::CommandChannelRx(Global::tRefType, const Global::CommandShPtr_t &);         ///< For calling \ref OnExecuteCommand.
 friend void CommandChannel::CommandChannelTxAck(Global::tRefType, const Global::AcknowledgeShPtr_t &);  ///< For calling \ref OnProcessAcknowledge.
 private:
+    /****************************************************************************/
+    /**
+     * \brief Command waiting for acknowledge.
+     */
+    /****************************************************************************/
+    struct PendingCommand_t {
+        QString     Name;       ///< Name of command.
+        int         TypeID;     ///< Type ID of command.
+        qint64      SendTime;   ///< Time the command was sent [us].
+        qint64      Deadline;   ///< Time the command times out [ms].
+    };
+    typedef QHash<Global::tRefType, PendingCommand_t>   PendingCommandHash_t;   ///< Pending commands by reference.
+
     int                                     m_HeartbeatTimeout;             ///< Timeout for heartbeat functionality. Default = 0 ms = off.
     QTimer                                  *mp_HeartbeatTimer;               ///< Timer for heartbeat functionality.
     Global::RefManager<Global::tRefType>    m_RefManager;                   ///< Manager for command references.
-    Global::PendingCmdDescriptorPtrHash_t   m_PendingCommands;              ///< Commands waiting for acknowledge.
-    AcknowledgeProcessorFunctorHash_t       m_AcknowledgeProcessorFunctors; ///< Functors of supported acknowledges.
-    TimeoutProcessorFunctorHash_t           m_TimeoutProcessorFunctors;     ///< Functors of supported command timeouts.
+    PendingCommandHash_t                    m_PendingCommands;              ///< Commands waiting for acknowledge.
+    QElapsedTimer                           m_PendingClock;                 ///< Clock of the command deadlines.
+    QTimer                                  m_PendingTimer;                 ///< Single timer for the deadlines of all pending commands.
+    qint64                                  m_PendingTimerDue;              ///< Time the pending timer expires [ms], -1 if stopped.
+    Global::TimerWheel<Global::tRefType>    m_PendingDeadlines;             ///< Deadlines by command reference, obsolete ones are skipped.
+    Global::LatencyHistogram                m_AcknowledgeLatency;           ///< Time from sending a command until its acknowledge [us].
+    Global::LatencyHistogram                m_TimeoutDelay;                 ///< Time from a deadline until its timeout is processed [us].
+    int                                     m_MaxPendingCommands;           ///< Most pending commands since the last statistics.
+    qint64                                  m_LastPendingStatistics;        ///< Time the last statistics were logged [ms].
+    AcknowledgeProcessorFunctorTable_t      m_AcknowledgeProcessorFunctors; ///< Functors of supported acknowledges.
+    TimeoutProcessorFunctorTable_t          m_TimeoutProcessorFunctors;     ///< Functors of supported command timeouts.
     CmdDataChangedFunctorHash_t             m_DataChangedFunctors;          ///< Functors of supported CmdDataChanged commands.
     quint32                                 m_ThreadID;                     ///< Unique Thread ID
     QString                                 m_ThreadName;                   ///< Thread name ->usually cmd channel name
@@ -95,6 +121,24 @@ private:
     /****************************************************************************/
     Q_DISABLE_COPY(BaseThreadController)
 
+    /****************************************************************************/
+    /**
+     * \brief Arm the pending timer for the next deadline.
+     *
+     * The timer is only restarted if the next deadline is earlier than the
+     * time it is already armed for.
+     */
+    /****************************************************************************/
+    void ArmPendingTimer();
+    /****************************************************************************/
+    /**
+     * \brief Log the statistics of the pending commands and reset them.
+     *
+     * Nothing is logged if no command was pending.
+     */
+    /****************************************************************************/
+    void LogPendingStatistics();
+
     /****************************************************************************/
     /**
      * \brief Send a data changed command.
@@ -138,20 +182,33 @@ private slots:
     void HeartbeatTimer();
     /****************************************************************************/
     /**
-     * \brief An timeout for an send command was received.
+     * \brief The pending timer expired.
      *
-     * Is called when an command timeout has to be processed.
+     * Processes the timeouts of all commands whose deadline expired and arms
+     * the timer for the next deadline.
+     */
+    /****************************************************************************/
+    void OnPendingTimer();
+    /****************************************************************************/
+    /**
+     * \brief Add a command to the pending commands and schedule its deadline.
      *
-     * \iparam       Ref         The command reference.
-     * \iparam       CmdName     Name of command.
+     * Runs in the thread of the controller, which owns the pending commands
+     * and the pending timer.
+     *
+     * \iparam   Ref         Command reference.
+     * \iparam   Name        Name of command.
+     * \iparam   TypeID      Type ID of command.
+     * \iparam   SendTime    Time the command was sent [us].
+     * \iparam   Timeout     Command timeout [ms].
      */
     /****************************************************************************/
-    void OnProcessTimeoutSlot(Global::tRefType Ref, QString CmdName);
+    void AddPendingCommand(Global::tRefType Ref, const QString &Name, int TypeID, qint64 SendTime, int Timeout);
 
 
 protected:
 
-    QStringList m_ListOfAcksToRouteAndProcess;  ///< List of Acks to route and process.
+    Global::CommandTypeTable<bool> m_AcksToRouteAndProcess;    ///< Acks to route and process, by type ID.
 
     QMutex      m_StopMutex;    //!< used to synchronise OnStopReceived (called within own thread) and CleanupAndDestroyObjects (called by master thread)
     QMutex      m_Lock;         //!< use for locking/synchronising in general
@@ -161,9 +218,9 @@ protected:
     /**
      * \brief Send a command over a specific command channel.
      *
-     * After the command was send, the descriptor is created and its timeout signal
-     * connected (if timeout > 0). After that, the descriptor is added to the list
-     * of pending commands.
+     * If the command has a timeout, it is added to the list of pending commands
+     * and its deadline is scheduled in the timer wheel of this thread. All
+     * deadlines share one timer, expired ones are processed in a batch.
      *
      * \iparam   Ref         The command reference.
      * \iparam   Cmd         The command.
@@ -269,57 +326,55 @@ protected:
     /**
      * \brief Remove a command from Pending commands.
      *
-     * \iparam   Ref     Command refe)rence.
+     * If the deadline of the command did not expire yet, the time since it
+     * was sent is recorded as acknowledge latency.
+     *
+     * \iparam   Ref     Command reference.
      */
     /****************************************************************************/
-    inline void RemoveFromPendingCommands(Global::tRefType Ref)
-    {
-//        qDebug() << "BaseThreadController::RemoveFromPendingCommands" << Ref;
-        // remove from list of pending commands
-        m_PendingCommands.remove(Ref);
-    }
+    void RemoveFromPendingCommands(Global::tRefType Ref);
     /****************************************************************************/
     /**
      * \brief Register a acknowledge processor functor.
      *
-     * \iparam   AckName         Name of acknowledge.
+     * \iparam   AckTypeID       Type ID of acknowledge.
      * \iparam   Functor         Shared pointer of functor to register.
      */
     /****************************************************************************/
-    void RegisterAcknowledgeProcessorFunctor(const QString &AckName, const AcknowledgeProcessorFunctorShPtr_t &Functor);
+    void RegisterAcknowledgeProcessorFunctor(int AckTypeID, const AcknowledgeProcessorFunctorShPtr_t &Functor);
     /****************************************************************************/
     /**
-     * \brief Get acknowledge processor functor by name.
+     * \brief Get acknowledge processor functor by type ID.
      *
-     * Get acknowledge processor functor by name. If functor is not found
+     * Get acknowledge processor functor by type ID. If functor is not found
      * NullAcknowledgeProcessorFunctor will be returned.
      *
-     * \iparam   AckName     Name of acknowledge.
+     * \iparam   AckTypeID   Type ID of acknowledge.
      * \return   The functor or NullAcknowledgeProcessorFunctor.
      */
     /****************************************************************************/
-    AcknowledgeProcessorFunctorShPtr_t GetAcknowledgeProcessorFunctor(const QString &AckName) const;
+    AcknowledgeProcessorFunctorShPtr_t GetAcknowledgeProcessorFunctor(int AckTypeID) const;
     /****************************************************************************/
     /**
      * \brief Register a command timeout functor.
      *
-     * \iparam   CmdName         Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \iparam   Functor         Shared pointer of functor to register.
      */
     /****************************************************************************/
-    void RegisterTimeoutProcessingFunctor(const QString &CmdName, const TimeoutProcessorFunctorShPtr_t &Functor);
+    void RegisterTimeoutProcessingFunctor(int CmdTypeID, const TimeoutProcessorFunctorShPtr_t &Functor);
     /****************************************************************************/
     /**
-     * \brief Get timeout processor functor by name.
+     * \brief Get timeout processor functor by type ID.
      *
-     * Get timeout processor functor by name. If functor is not found
+     * Get timeout processor functor by type ID. If functor is not found
      * NullTimeoutProcessorFunctor will be returned.
      *
-     * \iparam   CmdName     Name of command.
+     * \iparam   CmdTypeID   Type ID of command.
      * \return                  The functor or NullTimeoutProcessorFunctor.
      */
     /****************************************************************************/
-    TimeoutProcessorFunctorShPtr_t GetTimeoutProcessorFunctor(const QString &CmdName) const;
+    TimeoutProcessorFunctorShPtr_t GetTimeoutProcessorFunctor(int CmdTypeID) const;
     /****************************************************************************/
     /**
      * \brief Register a functor for processing DataChanged command for a specific data container.
@@ -355,7 +410,7 @@ protected:
         // create functor
         AcknowledgeProcessorFunctorShPtr_t Functor(new TemplateAcknowledgeProcessorFunctor<AcknowledgeProcessorClass, AckClass> (pAcknowledgeProcessor, FunctionPointer));
         // register functor
-        RegisterAcknowledgeProcessorFunctor(AckClass::NAME, Functor);
+        RegisterAcknowledgeProcessorFunctor(Global::CommandTypeID::Of<AckClass>(), Functor);
     }
     /****************************************************************************/
     /**
@@ -372,8 +427,8 @@ protected:
         // create functor
         AcknowledgeProcessorFunctorShPtr_t Functor(new TemplateAcknowledgeProcessorFunctor<AcknowledgeProcessorClass, AckClass> (pAcknowledgeProcessor, FunctionPointer));
         // register functor
-        RegisterAcknowledgeProcessorFunctor(AckClass::NAME, Functor);
-        m_ListOfAcksToRouteAndProcess.append(AckClass::NAME);
+        RegisterAcknowledgeProcessorFunctor(Global::CommandTypeID::Of<AckClass>(), Functor);
+        m_AcksToRouteAndProcess.Insert(Global::CommandTypeID::Of<AckClass>(), true);
     }
     /****************************************************************************/
     /**
@@ -390,7 +445,7 @@ protected:
         // create functor
         TimeoutProcessorFunctorShPtr_t Functor(new TemplateTimeoutProcessorFunctor<TimeoutProcessorClass> (pTimeoutProcessor, FunctionPointer));
         // and register
-        RegisterTimeoutProcessingFunctor(CmdClass::NAME, Functor);
+        RegisterTimeoutProcessingFunctor(Global::CommandTypeID::Of<CmdClass>(), Functor);
     }
     /****************************************************************************/
     /**
@@ -477,6 +532,17 @@ public:
         return m_ThreadID;
     }
     /****************************************************************************/
+    /**
+     * \brief Get the number of commands waiting for acknowledge.
+     *
+     * \return   Number of pending commands.
+     */
+    /****************************************************************************/
+    int GetPendingCommandCount() const
+    {
+        return m_PendingCommands.count();
+    }
+    /****************************************************************************/
     /**
      * \brief Constructor.
      *
@@ -88,11 +88,11 @@ enum CommandChannelSelector_t {
     UNDEFINED = 100
 };
 typedef Global::SharedPointer<CommandExecuteFunctorAck>     CommandExecuteFunctorAckShPtr_t;    ///< Typedef or a shared pointer of CommandExecuteFunctor.
-typedef QHash<QString, CommandExecuteFunctorAckShPtr_t>     CommandExecuteFunctorAckHash_t;     ///< Typedef for the CommandExecuteFunctorShPtr_t functor hash.
+typedef Global::CommandTypeTable<CommandExecuteFunctorAckShPtr_t> CommandExecuteFunctorAckTable_t; ///< Typedef for the CommandExecuteFunctorAckShPtr_t functor table by command type ID.
 
 typedef QPair<ThreadController *, QThread *>        tControllerPair;            ///< Typedef for a pair consisting of a thread controller and a thread. Both as pointers.
 typedef QMap<quint32, tControllerPair>                  tControllerMap;             ///< Map of tControllerPair and controller number
-typedef QHash<QString, CommandChannel *>            tTCCommandChannelHash;      ///< Typedef for the TCCommandRouteFunctor functor hash.
+typedef Global::CommandTypeTable<CommandChannel *> tTCCommandChannelTable;     ///< Typedef for the routing channel table by command type ID.
 typedef QPair<Global::tRefType, CommandChannel *>   tRefChannelPair;            ///< Typedef for pair of tRefType and CommandChannel *
 typedef QHash<Global::tRefType, tRefChannelPair >   tTCAckChannelHash;          ///< Typedef for the TCCommandRouteFunctor functor hash.
 typedef QVector<CommandChannel *>                   tCommandChannelVector;      ///< Typedef for command channel vector.
@@ -124,10 +124,10 @@ private:
     HeartBeatManager::HeartBeatThreadController *mp_HeartBeatThreadController;      ///< Pointer to HeartBeatThreadController
     quint32                                     m_ThreadIDHeartBeat;                ///< Heart Beat thread ID.
     // command executing stuff
-    CommandExecuteFunctorAckHash_t              m_CommandExecuteFunctors;           ///< Functors of supported commands.
-    CommandExecuteFunctorHash_t                 m_CommandExecuteWithoutAckFunctors; ///< Functors of commands without Ack.
+    CommandExecuteFunctorAckTable_t             m_CommandExecuteFunctors;           ///< Functors of supported commands.
+    CommandExecuteFunctorTable_t                m_CommandExecuteWithoutAckFunctors; ///< Functors of commands without Ack.
     // command routing stuff
-    tTCCommandChannelHash                       m_TCCommandRoutes;                  ///< Supported routing commands.
+    tTCCommandChannelTable                      m_TCCommandRoutes;                  ///< Supported routing commands.
     tTCAckChannelHash                           m_TCAcknowledgeRoutes;              ///< Acknowledge routing.
     // command broadcasting stuff
     tCommandChannelVector                       m_BroadcastChannels;                ///< Vector of channels for broadcasting commands.
@@ -176,14 +176,14 @@ private:
     void WaitForThreads(bool BasicThreadController = false);
     /****************************************************************************/
     /**
-     * \brief Get command channel for routing by command name.
+     * \brief Get command channel for routing by command type ID.
      *
      * Returns NULL if functor not found.
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \return                      The command channels.
      */
     /****************************************************************************/
-    CommandChannel *GetCommandRouteChannel(const QString &CommandName) const;
+    CommandChannel *GetCommandRouteChannel(int CmdTypeID) const;
     /****************************************************************************/
     /**
      * \brief Get command channel for routing by component type.
@@ -667,32 +667,32 @@ protected:
     /**
      * \brief Register a command execution functor.
      *
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \iparam   Functor         Shared pointer of functor to register.
      */
     /****************************************************************************/
-    void RegisterCommandExecuteFunctor(const QString &CommandName, const CommandExecuteFunctorAckShPtr_t &Functor);
+    void RegisterCommandExecuteFunctor(int CmdTypeID, const CommandExecuteFunctorAckShPtr_t &Functor);
     /****************************************************************************/
     /**
      * \brief Register a command execution functor without Ack.
      *
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \iparam   Functor         Shared pointer of functor to register.
      */
     /****************************************************************************/
-    void RegisterCommandExecuteFunctor(const QString &CommandName, const CommandExecuteFunctorShPtr_t &Functor);
+    void RegisterCommandExecuteFunctor(int CmdTypeID, const CommandExecuteFunctorShPtr_t &Functor);
     /****************************************************************************/
     /**
-     * \brief Get command execute functor by name.
+     * \brief Get command execute functor by type ID.
      *
-     * Get command execute functor by name. If functor is not found
+     * Get command execute functor by type ID. If functor is not found
      * NullCommandExecuteFunctor will be returned.
      *
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \return                      The functor or NullCommandExecuteFunctor.
      */
     /****************************************************************************/
-    CommandExecuteFunctorAckShPtr_t GetCommandExecuteFunctor(const QString &CommandName) const;
+    CommandExecuteFunctorAckShPtr_t GetCommandExecuteFunctor(int CmdTypeID) const;
     /****************************************************************************/
     /**
      * \brief Get command execute functor by name.
@@ -700,20 +700,20 @@ protected:
      * Get command execute functor by name. If functor is not found
      * NullCommandExecuteFunctor will be returned.
      *
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \return                      The functor or NullCommandExecuteFunctor.
      */
     /****************************************************************************/
-    CommandExecuteFunctorShPtr_t GetCommandExecuteFunctorWithoutAck(const QString &CommandName) const;
+    CommandExecuteFunctorShPtr_t GetCommandExecuteFunctorWithoutAck(int CmdTypeID) const;
     /****************************************************************************/
     /**
      * \brief Register a command route functor.
      *
-     * \iparam   CommandName             Name of command.
+     * \iparam   CmdTypeID               Type ID of command.
      * \iparam   pTargetCommandChannel   The target command channel.
      */
     /****************************************************************************/
-    void RegisterCommandRoutingChannel(const QString &CommandName, CommandChannel *pTargetCommandChannel);
+    void RegisterCommandRoutingChannel(int CmdTypeID, CommandChannel *pTargetCommandChannel);
     /****************************************************************************/
     /**
      * \brief Register a command for routing.
@@ -724,7 +724,7 @@ protected:
     template<class TCCmdClass>
     void RegisterCommandForRouting(CommandChannel *pTargetCommandChannel) {
         // register
-        RegisterCommandRoutingChannel(TCCmdClass::NAME, pTargetCommandChannel);
+        RegisterCommandRoutingChannel(Global::CommandTypeID::Of<TCCmdClass>(), pTargetCommandChannel);
     }
     /****************************************************************************/
     /**
@@ -741,8 +741,8 @@ protected:
                                             CommandProcessorClass *pCommandProcessor, CommandChannel *pTargetCommandChannel) {
         //Functor without Ack , Ack will be sent by the processor class in the target channel
         CommandExecuteFunctorShPtr_t Functor(new TemplateCommandExecuteFunctor<CommandProcessorClass, TCCmdClass>(pCommandProcessor, FunctionPointer));
-        RegisterCommandExecuteFunctor(TCCmdClass::NAME, Functor);
-        RegisterCommandRoutingChannel(TCCmdClass::NAME, pTargetCommandChannel);
+        RegisterCommandExecuteFunctor(Global::CommandTypeID::Of<TCCmdClass>(), Functor);
+        RegisterCommandRoutingChannel(Global::CommandTypeID::Of<TCCmdClass>(), pTargetCommandChannel);
     }
     /****************************************************************************/
     /**
@@ -1068,7 +1068,7 @@ public:
         // create functor
         CommandExecuteFunctorAckShPtr_t Functor(new TemplateCommandExecuteFunctorAck<CommandProcessorClass, CmdClass> (pCommandProcessor, FunctionPointer));
         // and register
-        RegisterCommandExecuteFunctor(CmdClass::NAME, Functor);
+        RegisterCommandExecuteFunctor(Global::CommandTypeID::Of<CmdClass>(), Functor);
     }
     /****************************************************************************/
     /**
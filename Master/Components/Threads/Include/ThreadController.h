@@ -26,7 +26,7 @@
 namespace Threads {
 
 typedef Global::SharedPointer<CommandExecuteFunctor>    CommandExecuteFunctorShPtr_t;   ///< Typedef or a shared pointer of CommandExecuteFunctor.
-typedef QHash<QString, CommandExecuteFunctorShPtr_t>    CommandExecuteFunctorHash_t;    ///< Typedef for the CommandExecuteFunctorShPtr_t functor hash.
+typedef Global::CommandTypeTable<CommandExecuteFunctorShPtr_t> CommandExecuteFunctorTable_t;   ///< Typedef for the CommandExecuteFunctorShPtr_t functor table by command type ID.
 
 /****************************************************************************/
 /**
@@ -41,7 +41,7 @@ typedef QHash<QString, CommandExecuteFunctorShPtr_t>    CommandExecuteFunctorHas
 class ThreadController : public BaseThreadController {
     Q_OBJECT
 private:
-    CommandExecuteFunctorHash_t     m_CommandExecuteFunctors;   ///< Functors of supported commands.
+    CommandExecuteFunctorTable_t    m_CommandExecuteFunctors;   ///< Functors of supported commands.
 
     /****************************************************************************/
     ThreadController();                                             ///< Not implemented.
@@ -102,23 +102,23 @@ protected:
     /**
      * \brief Register a command execution functor.
      *
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \iparam   Functor         Shared pointer of functor to register.
      */
     /****************************************************************************/
-    void RegisterCommandExecuteFunctor(const QString &CommandName, const CommandExecuteFunctorShPtr_t &Functor);
+    void RegisterCommandExecuteFunctor(int CmdTypeID, const CommandExecuteFunctorShPtr_t &Functor);
     /****************************************************************************/
     /**
-     * \brief Get command execute functor by name.
+     * \brief Get command execute functor by type ID.
      *
-     * Get command execute functor by name. If functor is not found
+     * Get command execute functor by type ID. If functor is not found
      * NullCommandExecuteFunctor will be returned.
      *
-     * \iparam   CommandName     Name of command.
+     * \iparam   CmdTypeID       Type ID of command.
      * \return  The functor or NullCommandExecuteFunctor.
      */
     /****************************************************************************/
-    CommandExecuteFunctorShPtr_t GetCommandExecuteFunctor(const QString &CommandName) const;
+    CommandExecuteFunctorShPtr_t GetCommandExecuteFunctor(int CmdTypeID) const;
     /****************************************************************************/
     /**
      * \brief Register a command for processing.
@@ -134,7 +134,7 @@ protected:
         // create functor
         CommandExecuteFunctorShPtr_t Functor(new TemplateCommandExecuteFunctor<CommandProcessorClass, CmdClass> (pCommandProcessor, FunctionPointer));
         // and register
-        RegisterCommandExecuteFunctor(CmdClass::NAME, Functor);
+        RegisterCommandExecuteFunctor(Global::CommandTypeID::Of<CmdClass>(), Functor);
     }
     /****************************************************************************/
     /**
@@ -46,10 +46,18 @@ const CmdDataChangedFunctorShPtr_t          NullDataChangedFunctor(NULL);
 */
 const int STOP_TIMEOUT(1000);         ///< time to wait if thread get's stuck in OnStopReceived()
 
+const qint64 PENDING_TIMER_RESOLUTION = 10;             ///< Resolution of the command deadlines [ms].
+const qint64 PENDING_STATISTICS_INTERVAL = 600000;      ///< Interval for logging the pending command statistics [ms].
+
 /****************************************************************************/
 BaseThreadController::BaseThreadController(const quint32 ThreadID, const QString ThreadName) :
     m_HeartbeatTimeout(0),
     mp_HeartbeatTimer(NULL),
+    m_PendingTimer(this),
+    m_PendingTimerDue(-1),
+    m_PendingDeadlines(PENDING_TIMER_RESOLUTION, 0),
+    m_MaxPendingCommands(0),
+    m_LastPendingStatistics(0),
     m_ThreadID(ThreadID),
     m_ThreadName(ThreadName)
 
@@ -59,6 +67,9 @@ BaseThreadController::BaseThreadController(const quint32 ThreadID, const QString
     qRegisterMetaType<Global::CommandShPtr_t>("Global::CommandShPtr_t");
     qRegisterMetaType<Global::AcknowledgeShPtr_t>("Global::AcknowledgeShPtr_t");
     // connect timer
+    m_PendingClock.start();
+    m_PendingTimer.setSingleShot(true);
+    CONNECTSIGNALSLOT(&m_PendingTimer, timeout(), this, OnPendingTimer());
 
     // disable error forwarding because we do not have a parent
     //DisableErrorForwarding();
@@ -86,6 +97,9 @@ void BaseThreadController::StopHeartbeatTimer() {
 /****************************************************************************/
 void BaseThreadController::HeartbeatTimer() {
     emit HeartbeatSignal(GetThreadID());
+    if (m_PendingClock.elapsed() - m_LastPendingStatistics >= PENDING_STATISTICS_INTERVAL) {
+        LogPendingStatistics();
+    }
 }
 
 /****************************************************************************/
@@ -109,6 +123,7 @@ void BaseThreadController::Stop() {
         OnStopReceived();
         // stop heartbeat timer
         StopHeartbeatTimer();
+        LogPendingStatistics();
     }
     CATCHALL();
 
@@ -139,25 +154,20 @@ void BaseThreadController::DoSendCommand(Global::tRefType Ref, const Global::Com
         // try to send the command over the according transmit channel
 //        qDebug() << "BaseThreadController::DoSendCommand" << Ref << Cmd.GetPointerToUserData()->GetName() << "Channel" << CmdChannel.m_channelName;
         if(Cmd->GetTimeout() != Global::Command::NOTIMEOUT) {
-            // create descriptor
-            Global::PendingCmdDescriptorShP_t PCDShP(new Global::PendingCmdDescriptor(this, Ref, Cmd->GetName(), Cmd->GetTimeout()));
-
-            if (this->thread() != PCDShP.GetPointerToUserData()->thread())
-            {
-                qDebug() << "BaseThreadController::DoSendCommand, mismatch of threads" << Cmd.GetPointerToUserData()->GetName() << "current thread" << this->thread() << "PCDShP thread" << PCDShP.GetPointerToUserData()->thread();
-            }
-
-            // connect descriptor to timeout slot
-            CONNECTSIGNALSLOT(PCDShP.GetPointerToUserData(), TimeoutOccured(Global::tRefType, QString),
-                              this, OnProcessTimeoutSlot(Global::tRefType, QString));
-            // connect and start descriptor timeouts
-            PCDShP->ConnectAndStartTimer();
-            // now add to list of pending commands.
+            // add to list of pending commands and schedule the deadline.
 //            qDebug() << "BaseThreadController::DoSendCommand, add to pending commands" << Ref;
-            static_cast<void>(
-                // we DO NOT NEED the return value of insert
-                m_PendingCommands.insert(Ref, PCDShP)
-            );
+            qint64 SendTime = m_PendingClock.nsecsElapsed() / 1000;
+            if (this->thread() == QThread::currentThread()) {
+                AddPendingCommand(Ref, Cmd->GetName(), Cmd->GetTypeID(), SendTime, Cmd->GetTimeout());
+            }
+            else {
+                // the pending commands belong to the controller thread. The call is queued
+                // before the command is sent, so it is processed before the acknowledge.
+                static_cast<void>(QMetaObject::invokeMethod(this, "AddPendingCommand", Qt::QueuedConnection,
+                                                            Q_ARG(Global::tRefType, Ref), Q_ARG(QString, Cmd->GetName()),
+                                                            Q_ARG(int, Cmd->GetTypeID()), Q_ARG(qint64, SendTime),
+                                                            Q_ARG(int, Cmd->GetTimeout())));
+            }
         }
         CmdChannel.EmitCommand(Ref, Cmd);
         // everything OK
@@ -166,6 +176,20 @@ void BaseThreadController::DoSendCommand(Global::tRefType Ref, const Global::Com
     CATCHALL();
 }
 
+/****************************************************************************/
+void BaseThreadController::AddPendingCommand(Global::tRefType Ref, const QString &Name, int TypeID, qint64 SendTime,
+                                             int Timeout) {
+    PendingCommand_t &Pending = m_PendingCommands[Ref];
+    Pending.Name = Name;
+    Pending.TypeID = TypeID;
+    Pending.SendTime = SendTime;
+    // round up, so the command never times out early
+    Pending.Deadline = (SendTime + 999) / 1000 + Timeout;
+    m_PendingDeadlines.Schedule(Ref, Pending.Deadline);
+    m_MaxPendingCommands = qMax(m_MaxPendingCommands, m_PendingCommands.count());
+    ArmPendingTimer();
+}
+
 /****************************************************************************/
 void BaseThreadController::DoSendAcknowledge(Global::tRefType Ref, const Global::AcknowledgeShPtr_t &Ack, CommandChannel &CmdChannel)
 {
@@ -188,57 +212,48 @@ void BaseThreadController::DoSendAcknowledge(Global::tRefType Ref, const Global:
 }
 
 /****************************************************************************/
-void BaseThreadController::RegisterAcknowledgeProcessorFunctor(const QString &AckName, const AcknowledgeProcessorFunctorShPtr_t &Functor) {
+void BaseThreadController::RegisterAcknowledgeProcessorFunctor(int AckTypeID, const AcknowledgeProcessorFunctorShPtr_t &Functor) {
     // check if already registered
-    if(m_AcknowledgeProcessorFunctors.contains(AckName)) {
-        LOGANDTHROWARGS(EVENT_THREADS_ERROR_ACKNOWLEDGE_FUNCTOR_ALREADY_REGISTERED, AckName)
+    if(m_AcknowledgeProcessorFunctors.Contains(AckTypeID)) {
+        LOGANDTHROWARGS(EVENT_THREADS_ERROR_ACKNOWLEDGE_FUNCTOR_ALREADY_REGISTERED, Global::CommandTypeID::Name(AckTypeID))
     }
     // everything OK
-    static_cast<void>(
-        // we DO NOT NEED the return value of insert
-        m_AcknowledgeProcessorFunctors.insert(AckName, Functor)
-    );
+    m_AcknowledgeProcessorFunctors.Insert(AckTypeID, Functor);
 }
 
 /****************************************************************************/
-AcknowledgeProcessorFunctorShPtr_t BaseThreadController::GetAcknowledgeProcessorFunctor(const QString &AckName) const
+AcknowledgeProcessorFunctorShPtr_t BaseThreadController::GetAcknowledgeProcessorFunctor(int AckTypeID) const
 {
-//    qDebug() << "BaseThreadController::GetAcknowledgeProcessorFunctor" << AckName;
-    AcknowledgeProcessorFunctorHash_t::const_iterator it = m_AcknowledgeProcessorFunctors.find(AckName);
-    if(it == m_AcknowledgeProcessorFunctors.constEnd())
+    if(!m_AcknowledgeProcessorFunctors.Contains(AckTypeID))
     {
-        qDebug() << "BaseThreadController::GetAcknowledgeProcessorFunctor, no functor found for" << AckName;
+        qDebug() << "BaseThreadController::GetAcknowledgeProcessorFunctor, no functor found for" << Global::CommandTypeID::Name(AckTypeID);
         // functor not found
         // return NULL functor
         return NullAcknowledgeProcessorFunctor;
     }
     // return functor
-    return it.value();
+    return m_AcknowledgeProcessorFunctors.Value(AckTypeID);
 }
 
 /****************************************************************************/
-void BaseThreadController::RegisterTimeoutProcessingFunctor(const QString &CmdName, const TimeoutProcessorFunctorShPtr_t &Functor) {
+void BaseThreadController::RegisterTimeoutProcessingFunctor(int CmdTypeID, const TimeoutProcessorFunctorShPtr_t &Functor) {
     // check if already registered
-    if(m_TimeoutProcessorFunctors.contains(CmdName)) {
-        LOGANDTHROWARGS(EVENT_THREADS_ERROR_TIMEOUT_FUNCTOR_ALREADY_REGISTERED, CmdName)
+    if(m_TimeoutProcessorFunctors.Contains(CmdTypeID)) {
+        LOGANDTHROWARGS(EVENT_THREADS_ERROR_TIMEOUT_FUNCTOR_ALREADY_REGISTERED, Global::CommandTypeID::Name(CmdTypeID))
     }
     // everything OK
-    static_cast<void>(
-        // we DO NOT NEED the return value of insert
-        m_TimeoutProcessorFunctors.insert(CmdName, Functor)
-    );
+    m_TimeoutProcessorFunctors.Insert(CmdTypeID, Functor);
 }
 
 /****************************************************************************/
-TimeoutProcessorFunctorShPtr_t BaseThreadController::GetTimeoutProcessorFunctor(const QString &CmdName) const {
-    TimeoutProcessorFunctorHash_t::const_iterator it = m_TimeoutProcessorFunctors.find(CmdName);
-    if(it == m_TimeoutProcessorFunctors.constEnd()) {
+TimeoutProcessorFunctorShPtr_t BaseThreadController::GetTimeoutProcessorFunctor(int CmdTypeID) const {
+    if(!m_TimeoutProcessorFunctors.Contains(CmdTypeID)) {
         // functor not found
         // return NULL functor
         return NullTimeoutProcessorFunctor;
     }
     // return functor
-    return it.value();
+    return m_TimeoutProcessorFunctors.Value(CmdTypeID);
 }
 
 /****************************************************************************/
@@ -290,7 +305,7 @@ void BaseThreadController::OnProcessAcknowledge(Global::tRefType Ref, const Glob
         // remove from list of pending commands
         RemoveFromPendingCommands(Ref);
         // OK, now get functor and execute
-        AcknowledgeProcessorFunctorShPtr_t Functor = GetAcknowledgeProcessorFunctor(Ack->GetName());
+        AcknowledgeProcessorFunctorShPtr_t Functor = GetAcknowledgeProcessorFunctor(Ack->GetTypeID());
         if(Functor == NullAcknowledgeProcessorFunctor) {
 //            qDebug() << "BaseThreadController::OnProcessAcknowledge, NullAcknowledgeProcessorFunctor" << Ref;
             Global::EventObject::Instance().RaiseEvent(EVENT_THREADS_ERROR_UNSUPPORTED_ACKNOWLEDGE, Global::FmtArgs() << Ack->GetName() << m_ThreadID, true);
@@ -305,9 +320,71 @@ void BaseThreadController::OnProcessAcknowledge(Global::tRefType Ref, const Glob
 }
 
 /****************************************************************************/
-void BaseThreadController::OnProcessTimeoutSlot(Global::tRefType Ref, QString CmdName) {
-    // call processing routine
-    OnProcessTimeout(Ref, CmdName);
+void BaseThreadController::RemoveFromPendingCommands(Global::tRefType Ref) {
+//    qDebug() << "BaseThreadController::RemoveFromPendingCommands" << Ref;
+    PendingCommandHash_t::iterator it = m_PendingCommands.find(Ref);
+    if (it == m_PendingCommands.end()) {
+        return;
+    }
+    qint64 Now = m_PendingClock.nsecsElapsed() / 1000;
+    if (Now / 1000 < it.value().Deadline) {
+        m_AcknowledgeLatency.Record(Now - it.value().SendTime);
+    }
+    // remove from list of pending commands, the deadline stays in the wheel and is skipped
+    static_cast<void>(m_PendingCommands.erase(it));
+}
+
+/****************************************************************************/
+void BaseThreadController::ArmPendingTimer() {
+    qint64 Now = m_PendingClock.elapsed();
+    qint64 Timeout = m_PendingDeadlines.NextTimeout(Now);
+    if (Timeout < 0) {
+        m_PendingTimer.stop();
+        m_PendingTimerDue = -1;
+        return;
+    }
+    if ((m_PendingTimerDue >= 0) && (m_PendingTimerDue <= Now + Timeout)) {
+        // already armed early enough
+        return;
+    }
+    m_PendingTimerDue = Now + Timeout;
+    m_PendingTimer.start(static_cast<int>(Timeout));
+}
+
+/****************************************************************************/
+void BaseThreadController::OnPendingTimer() {
+    m_PendingTimerDue = -1;
+    qint64 Now = m_PendingClock.elapsed();
+    QList<Global::tRefType> Expired;
+    m_PendingDeadlines.Advance(Now, Expired);
+    for (int i = 0; i < Expired.count(); i++) {
+        PendingCommandHash_t::const_iterator it = m_PendingCommands.constFind(Expired[i]);
+        // skip acknowledged commands and references reused by a later command
+        if ((it == m_PendingCommands.constEnd()) || (it.value().Deadline > Now)) {
+            continue;
+        }
+        m_TimeoutDelay.Record((Now - it.value().Deadline) * 1000);
+        // copy the name, processing removes the command
+        QString CmdName = it.value().Name;
+        // call processing routine
+        OnProcessTimeout(Expired[i], CmdName);
+    }
+    ArmPendingTimer();
+}
+
+/****************************************************************************/
+void BaseThreadController::LogPendingStatistics() {
+    m_LastPendingStatistics = m_PendingClock.elapsed();
+    if (m_MaxPendingCommands == 0) {
+        return;
+    }
+    Global::EventObject::Instance().RaiseEvent(Global::EVENT_GLOBAL_STRING_ID_DEBUG_MESSAGE, Global::FmtArgs()
+        << QString("%1 pending commands: %2, max %3, acknowledge %4, timeouts %5")
+           .arg(m_ThreadName).arg(m_PendingCommands.count()).arg(m_MaxPendingCommands)
+           .arg(m_AcknowledgeLatency.ToString()).arg(m_TimeoutDelay.ToString()));
+    m_AcknowledgeLatency.Reset();
+    m_TimeoutDelay.Reset();
+    m_MaxPendingCommands = m_PendingCommands.count();
 }
 
 /****************************************************************************/
@@ -315,7 +392,8 @@ void BaseThreadController::OnProcessTimeout(Global::tRefType Ref, const QString
 //    SEND_DEBUG(WHEREAMI + " " +
 //               QString("Ref = ") + QString::number(Ref, 10) +
 //               QString("Name = ") + CmdName);
-    if(!m_PendingCommands.contains(Ref)) {
+    PendingCommandHash_t::const_iterator it = m_PendingCommands.constFind(Ref);
+    if(it == m_PendingCommands.constEnd()) {
         // unknown command reference. maybe already processed?.
         qDebug() << "BaseThreadController::OnProcessTimeout, unknown command ref" << Ref;
         Global::EventObject::Instance().RaiseEvent(EVENT_THREADS_ERROR_UNKNOWN_COMMAND_REF, Global::FmtArgs() << Ref << m_ThreadID << CmdName, true);
@@ -327,11 +405,12 @@ void BaseThreadController::OnProcessTimeout(Global::tRefType Ref, const QString
     Global::EventObject::Instance().RaiseEvent(EVENT_THREADS_ERROR_COMMAND_TIMEOUT, Global::FmtArgs() << CmdName << Ref, true);
 //    LOG_EVENT(Global::EVTTYPE_FATAL_ERROR, Global::LOG_ENABLED, EVENT_THREADS_ERROR_COMMAND_TIMEOUT, Global::tTranslatableStringList() << CmdName << QString::number(Ref, 10)
 //              , Global::NO_NUMERIC_DATA, false);
+    int CmdTypeID = it.value().TypeID;
     // remove from list of pending commands
 
     RemoveFromPendingCommands(Ref);
     // OK, now get functor and execute
-    TimeoutProcessorFunctorShPtr_t Functor = GetTimeoutProcessorFunctor(CmdName);
+    TimeoutProcessorFunctorShPtr_t Functor = GetTimeoutProcessorFunctor(CmdTypeID);
     if(Functor == NullTimeoutProcessorFunctor)
     {
         // take default OnCmdTimeout function
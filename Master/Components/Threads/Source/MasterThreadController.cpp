@@ -28,6 +28,7 @@
 #include <Global/Include/Commands/AckOKNOK.h>
 #include <Global/Include/Commands/CmdSoftSwitchPressed.h>
 #include <Global/Include/AlarmPlayer.h>
+#include <Global/Include/HeapProfiler.h>
 
 #include <DataManager/Include/DataManagerBase.h>
 #include <DataManager/Containers/UserSettings/Include/UserSettingsInterface.h>
@@ -138,7 +139,7 @@ MasterThreadController::MasterThreadController(const QString &ShutdownSharedMemN
 MasterThreadController::~MasterThreadController() {
     try {
         mp_EventThreadController = NULL;
-        m_TCCommandRoutes.clear();
+        m_TCCommandRoutes.Clear();
     }
     CATCHALL_DTOR();
 }
@@ -146,6 +147,8 @@ MasterThreadController::~MasterThreadController() {
 /****************************************************************************/
 void MasterThreadController::CreateAndInitializeObjects() {
     CHECKPTR(mp_DataManagerBase);
+    // the profile is exported with the log files
+    (void)Global::HeapProfiler::StartFromEnvironment(Global::SystemPaths::Instance().GetLogfilesPath() + "/HeapProfile.log");
     Global::CreateSymbolicLinkToFonts();
     //Update serial number read from Device configuration xml
     //Serial number will be present in Log files.
@@ -490,76 +493,61 @@ void MasterThreadController::WaitForThreads(bool BasicThreadController) {
 }
 
 /****************************************************************************/
-void MasterThreadController::RegisterCommandExecuteFunctor(const QString &CommandName, const CommandExecuteFunctorAckShPtr_t &Functor) {
+void MasterThreadController::RegisterCommandExecuteFunctor(int CmdTypeID, const CommandExecuteFunctorAckShPtr_t &Functor) {
     // check if already registered
-    if(m_CommandExecuteFunctors.contains(CommandName)) {
-        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, CommandName)
+    if(m_CommandExecuteFunctors.Contains(CmdTypeID)) {
+        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, Global::CommandTypeID::Name(CmdTypeID))
     }
     // everything OK
-    static_cast<void>(
-                // we DO NOT NEED the return value of insert
-                m_CommandExecuteFunctors.insert(CommandName, Functor)
-                );
+    m_CommandExecuteFunctors.Insert(CmdTypeID, Functor);
 }
 
 /****************************************************************************/
-void MasterThreadController::RegisterCommandExecuteFunctor(const QString &CommandName, const CommandExecuteFunctorShPtr_t &Functor) {
+void MasterThreadController::RegisterCommandExecuteFunctor(int CmdTypeID, const CommandExecuteFunctorShPtr_t &Functor) {
     // check if already registered
-    if(m_CommandExecuteWithoutAckFunctors.contains(CommandName)) {
-        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, CommandName)
+    if(m_CommandExecuteWithoutAckFunctors.Contains(CmdTypeID)) {
+        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, Global::CommandTypeID::Name(CmdTypeID))
     }
     // everything OK
-    static_cast<void>(
-                // we DO NOT NEED the return value of insert
-                m_CommandExecuteWithoutAckFunctors.insert(CommandName, Functor)
-                );
+    m_CommandExecuteWithoutAckFunctors.Insert(CmdTypeID, Functor);
 }
 
 /****************************************************************************/
-CommandExecuteFunctorAckShPtr_t MasterThreadController::GetCommandExecuteFunctor(const QString &CommandName) const {
-    CommandExecuteFunctorAckHash_t::const_iterator it = m_CommandExecuteFunctors.find(CommandName);
-    if(it == m_CommandExecuteFunctors.constEnd()) {
+CommandExecuteFunctorAckShPtr_t MasterThreadController::GetCommandExecuteFunctor(int CmdTypeID) const {
+    if(!m_CommandExecuteFunctors.Contains(CmdTypeID)) {
         // functor not found
         // return NULL functor
         return NullCommandExecuteFunctor;
     }
     // return functor
-    return it.value();
+    return m_CommandExecuteFunctors.Value(CmdTypeID);
 }
 
 /****************************************************************************/
-CommandExecuteFunctorShPtr_t MasterThreadController::GetCommandExecuteFunctorWithoutAck(const QString &CommandName) const {
-    CommandExecuteFunctorHash_t::const_iterator it = m_CommandExecuteWithoutAckFunctors.find(CommandName);
-    if(it == m_CommandExecuteWithoutAckFunctors.constEnd()) {
+CommandExecuteFunctorShPtr_t MasterThreadController::GetCommandExecuteFunctorWithoutAck(int CmdTypeID) const {
+    if(!m_CommandExecuteWithoutAckFunctors.Contains(CmdTypeID)) {
         // functor not found
         // return NULL functor
         return NullCommandExecuteFunctorWithouAck;
     }
     // return functor
-    return it.value();
+    return m_CommandExecuteWithoutAckFunctors.Value(CmdTypeID);
 }
 /****************************************************************************/
-void MasterThreadController::RegisterCommandRoutingChannel(const QString &CommandName, CommandChannel *pTargetCommandChannel) {
+void MasterThreadController::RegisterCommandRoutingChannel(int CmdTypeID, CommandChannel *pTargetCommandChannel) {
     CHECKPTR(pTargetCommandChannel);
     // check if already registered
-    if(m_TCCommandRoutes.contains(CommandName)) {
-        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, CommandName)
+    if(m_TCCommandRoutes.Contains(CmdTypeID)) {
+        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, Global::CommandTypeID::Name(CmdTypeID))
     }
     // everything OK
-    static_cast<void>(
-                // we DO NOT NEED the return value of insert
-                m_TCCommandRoutes.insert(CommandName, pTargetCommandChannel)
-                );
+    m_TCCommandRoutes.Insert(CmdTypeID, pTargetCommandChannel);
 }
 
 /****************************************************************************/
-CommandChannel *MasterThreadController::GetCommandRouteChannel(const QString &CommandName) const {
-    if(!m_TCCommandRoutes.contains(CommandName)) {
-        // functor not found
-        return NULL;
-    }
-    // return command channel
-    return m_TCCommandRoutes.value(CommandName);
+CommandChannel *MasterThreadController::GetCommandRouteChannel(int CmdTypeID) const {
+    // the table returns NULL for commands which are not routed
+    return m_TCCommandRoutes.Value(CmdTypeID);
 }
 
 CommandChannel *MasterThreadController::GetComponentRouteChannel(Global::EventSourceType component) const {
@@ -600,14 +588,15 @@ void MasterThreadController::OnExecuteCommand(Global::tRefType Ref, const Global
         //                   QString("Name = ") + Cmd->GetName());
         // check if this command should be routed
         CommandChannel *pChannel;
-        if (Cmd->GetName().contains("CmdSystemAction"))
+        const int CmdTypeID = Cmd->GetTypeID();
+        if (CmdTypeID == Global::CommandTypeID::Of<NetCommands::CmdSystemAction>())
         {
             NetCommands::CmdSystemAction *actionCommand = (NetCommands::CmdSystemAction*)Cmd.GetPointerToUserData();
             pChannel = GetComponentRouteChannel(actionCommand->GetSource());
         }
         else
         {
-            pChannel = GetCommandRouteChannel(Cmd->GetName());
+            pChannel = GetCommandRouteChannel(CmdTypeID);
         }
         if(pChannel != NULL) {
             // yes, we must route it
@@ -625,7 +614,7 @@ void MasterThreadController::OnExecuteCommand(Global::tRefType Ref, const Global
                             );
             }
             //Check if some processing must be done before sending it to the target channel
-            CommandExecuteFunctorShPtr_t Functor = GetCommandExecuteFunctorWithoutAck(Cmd->GetName());
+            CommandExecuteFunctorShPtr_t Functor = GetCommandExecuteFunctorWithoutAck(CmdTypeID);
             if (Functor == NullCommandExecuteFunctorWithouAck) {
                 // and send command
                 DoSendCommand(NewRef, Cmd, *pChannel);
@@ -640,7 +629,7 @@ void MasterThreadController::OnExecuteCommand(Global::tRefType Ref, const Global
         } else {
             // no routing, try to execute
             // Get functor and execute
-            CommandExecuteFunctorAckShPtr_t Functor = GetCommandExecuteFunctor(Cmd->GetName());
+            CommandExecuteFunctorAckShPtr_t Functor = GetCommandExecuteFunctor(CmdTypeID);
             if(Functor == NullCommandExecuteFunctor) {
                 // throw exception
                 qDebug() << "MasterThreadController::OnExecuteCommand, no command functor for" << Cmd->GetName();
@@ -686,9 +675,9 @@ void MasterThreadController::OnProcessAcknowledge(Global::tRefType Ref, const Gl
                         m_TCAcknowledgeRoutes.remove(Ref)
                         );
             CHECKPTR(pAckChannel);
-            if (m_ListOfAcksToRouteAndProcess.contains(Ack->GetName())) {
+            if (m_AcksToRouteAndProcess.Value(Ack->GetTypeID())) {
                 // Check if main needs to process Acknowledge
-                AcknowledgeProcessorFunctorShPtr_t Functor = GetAcknowledgeProcessorFunctor(Ack->GetName());
+                AcknowledgeProcessorFunctorShPtr_t Functor = GetAcknowledgeProcessorFunctor(Ack->GetTypeID());
                 if(Functor == NullAcknowledgeProcessorFunctor) {
                     Global::EventObject::Instance().RaiseEvent(EVENT_THREADS_ERROR_UNSUPPORTED_ACKNOWLEDGE, Global::FmtArgs() << Ack->GetName() << GetThreadID(), true);
                 }
@@ -798,10 +787,15 @@ void MasterThreadController::ReadEventTranslations(QLocale::Language Language, Q
         QString FileName = Global::SystemPaths::Instance().GetTranslationsPath() + "/EventStrings_" +
                 Global::LanguageToLanguageCode(*itl) + ".xml";
         try {
-            // read strings for specified language
+            // map the compiled strings, the XML file is only parsed if it changed
             DataManager::XmlConfigFileStrings TranslatorDataFile;
-            TranslatorDataFile.ReadStrings(FileName, QSet<QLocale::Language>() << *itl);
-            // now configure translator with read languages.
+            QSharedPointer<Global::BinaryCatalog> Catalog(new Global::BinaryCatalog());
+            if (TranslatorDataFile.ReadStringCatalog(FileName, *itl, *Catalog)) {
+                // Set language catalog. No default no fallback.
+                Global::EventTranslator::TranslatorInstance().SetLanguageCatalog(*itl, Catalog, false, false);
+                continue;
+            }
+            // catalog not writable: configure translator with read languages.
             for(Global::tTranslations::const_iterator itt = TranslatorDataFile.Data().constBegin();
                 itt != TranslatorDataFile.Data().constEnd(); ++itt) {
                 // Set language data. No default no fallback.
@@ -846,10 +840,15 @@ void MasterThreadController::ReadUITranslations(QLocale::Language UserLanguage,
         QString FileName = Global::SystemPaths::Instance().GetTranslationsPath() + "/EventStrings_" +
                 Global::LanguageToLanguageCode(*itl) + ".xml";
         try {
-            // read strings for specified language
+            // map the compiled strings, the XML file is only parsed if it changed
             DataManager::XmlConfigFileStrings TranslatorDataFile;
-            TranslatorDataFile.ReadStrings(FileName, QSet<QLocale::Language>() << *itl);
-            // now configure translator with read languages.
+            QSharedPointer<Global::BinaryCatalog> Catalog(new Global::BinaryCatalog());
+            if (TranslatorDataFile.ReadStringCatalog(FileName, *itl, *Catalog)) {
+                // Set language catalog. No default no fallback.
+                Global::UITranslator::TranslatorInstance().SetLanguageCatalog(*itl, Catalog, false, false);
+                continue;
+            }
+            // catalog not writable: configure translator with read languages.
             for(Global::tTranslations::const_iterator itt = TranslatorDataFile.Data().constBegin();
                 itt != TranslatorDataFile.Data().constEnd(); ++itt) {
                 // Set language data. No default no fallback.
@@ -1003,6 +1002,7 @@ void MasterThreadController::Shutdown()
     CleanupControllers();
     // destroy controllers and threads
     DestroyControllersAndThreads();
+    Global::HeapProfiler::Stop();
 
     // call own Stop method
 //    Stop();
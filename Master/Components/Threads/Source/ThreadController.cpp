@@ -123,34 +123,30 @@ void ThreadController::SendAcknowledge(Global::tRefType Ref, const Global::Ackno
 }
 
 /****************************************************************************/
-void ThreadController::RegisterCommandExecuteFunctor(const QString &CommandName, const CommandExecuteFunctorShPtr_t &Functor)
+void ThreadController::RegisterCommandExecuteFunctor(int CmdTypeID, const CommandExecuteFunctorShPtr_t &Functor)
 {
     // check if already registered
-    if(m_CommandExecuteFunctors.contains(CommandName)) {
-        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, CommandName)
+    if(m_CommandExecuteFunctors.Contains(CmdTypeID)) {
+        LOGANDTHROWARGS(EVENT_THREADS_ERROR_COMMAND_FUNCTOR_ALREADY_REGISTERED, Global::CommandTypeID::Name(CmdTypeID))
     }
 
-    qDebug() << "ThreadController::RegisterCommandExecuteFunctor" << CommandName;
+    qDebug() << "ThreadController::RegisterCommandExecuteFunctor" << Global::CommandTypeID::Name(CmdTypeID);
 
     // everything OK
-    static_cast<void>(
-        // we DO NOT NEED the return value of insert
-        m_CommandExecuteFunctors.insert(CommandName, Functor)
-    );
+    m_CommandExecuteFunctors.Insert(CmdTypeID, Functor);
 }
 
 /****************************************************************************/
-CommandExecuteFunctorShPtr_t ThreadController::GetCommandExecuteFunctor(const QString &CommandName) const
+CommandExecuteFunctorShPtr_t ThreadController::GetCommandExecuteFunctor(int CmdTypeID) const
 {
-    //qDebug() << "ThreadController::GetCommandExecuteFunctor" << CommandName;
-    CommandExecuteFunctorHash_t::const_iterator it = m_CommandExecuteFunctors.find(CommandName);
-    if(it == m_CommandExecuteFunctors.constEnd()) {
+    //qDebug() << "ThreadController::GetCommandExecuteFunctor" << Global::CommandTypeID::Name(CmdTypeID);
+    if(!m_CommandExecuteFunctors.Contains(CmdTypeID)) {
         // functor not found
         // return NULL functor
         return NullCommandExecuteFunctor;
     }
     // return functor
-    return it.value();
+    return m_CommandExecuteFunctors.Value(CmdTypeID);
 }
 
 //lint -efunc(613, Threads::ThreadController::OnExecuteCommand)
@@ -172,7 +168,7 @@ void ThreadController::OnExecuteCommand(Global::tRefType Ref, const Global::Comm
 //                       QString("Ref = ") + QString::number(Ref, 10) +
 //                       QString("Name = ") + Cmd->GetName());
             // OK, now get functor and execute
-            CommandExecuteFunctorShPtr_t Functor = GetCommandExecuteFunctor(Cmd->GetName());
+            CommandExecuteFunctorShPtr_t Functor = GetCommandExecuteFunctor(Cmd->GetTypeID());
             if(Functor == NullCommandExecuteFunctor) {
                 qDebug()<<"ThreadController" << Cmd->GetName();
                 // throw exception
@@ -0,0 +1,296 @@
+/****************************************************************************/
+/*! \file TestCommandRouting.cpp
+ *
+ *  \brief Test of the command type IDs and benchmark of the command dispatch
+ *         by type ID compared to the dispatch by command name.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <Threads/Include/ThreadController.h>
+
+namespace Threads {
+
+static const int COMMAND_TYPES  = 300;      ///< Registered command types, about as many as the application has.
+static const int LOOKUP_COUNT   = 1000000;  ///< Number of dispatched commands.
+
+static const CommandExecuteFunctorShPtr_t FillerFunctor(NULL);  ///< Functor of the command types never dispatched.
+
+/****************************************************************************/
+/**
+ * \brief Command dispatched by the test.
+ */
+/****************************************************************************/
+class CmdRouted : public Global::Command {
+public:
+    static QString NAME;    ///< Command name.
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    CmdRouted() : Global::Command(Global::Command::NOTIMEOUT) {}
+    /****************************************************************************/
+    /**
+     * \brief Get command name.
+     *
+     * \return  Command name.
+     */
+    /****************************************************************************/
+    virtual QString GetName() const { return NAME; }
+}; // end class CmdRouted
+
+QString CmdRouted::NAME = "Threads::CmdRouted";
+
+/****************************************************************************/
+/**
+ * \brief Command not registered anywhere.
+ */
+/****************************************************************************/
+class CmdUnknown : public Global::Command {
+public:
+    static QString NAME;    ///< Command name.
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    CmdUnknown() : Global::Command(Global::Command::NOTIMEOUT) {}
+    /****************************************************************************/
+    /**
+     * \brief Get command name.
+     *
+     * \return  Command name.
+     */
+    /****************************************************************************/
+    virtual QString GetName() const { return NAME; }
+}; // end class CmdUnknown
+
+QString CmdUnknown::NAME = "Threads::CmdUnknown";
+
+/****************************************************************************/
+/**
+ * \brief Thread controller counting the dispatched commands.
+ */
+/****************************************************************************/
+class RoutingController : public ThreadController {
+    Q_OBJECT
+public:
+    int m_Executed;     ///< Commands executed.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    RoutingController() : ThreadController(1, "Routing"), m_Executed(0) {}
+    /****************************************************************************/
+    /**
+     * \brief Register the test command and many other command types.
+     */
+    /****************************************************************************/
+    virtual void CreateAndInitializeObjects() {
+        for (int i = 0; i < COMMAND_TYPES; i++) {
+            RegisterCommandExecuteFunctor(Global::CommandTypeID::Register(QString("Threads::CmdOther%1").arg(i)),
+                                          FillerFunctor);
+        }
+        RegisterCommandForProcessing<CmdRouted, RoutingController>(&RoutingController::OnCmdRouted, this);
+    }
+    /****************************************************************************/
+    /**
+     * \brief Nothing to clean up.
+     */
+    /****************************************************************************/
+    virtual void CleanupAndDestroyObjects() {}
+    /****************************************************************************/
+    /**
+     * \brief Dispatch a command as the command channel does.
+     *
+     * \iparam  Cmd     Command.
+     */
+    /****************************************************************************/
+    void Dispatch(const Global::CommandShPtr_t &Cmd) {
+        OnExecuteCommand(1, Cmd, m_CommandChannel);
+    }
+    /****************************************************************************/
+    /**
+     * \brief Count an executed command.
+     *
+     * \iparam  Ref     Command reference.
+     * \iparam  Cmd     Command.
+     */
+    /****************************************************************************/
+    void OnCmdRouted(Global::tRefType Ref, const CmdRouted &Cmd) {
+        Q_UNUSED(Ref)
+        Q_UNUSED(Cmd)
+        m_Executed++;
+    }
+
+protected:
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnGoReceived() {}
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnStopReceived() {}
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnPowerFail(const Global::PowerFailStages) {}
+}; // end class RoutingController
+
+/****************************************************************************/
+/**
+ * \brief Test class for the command routing.
+ */
+/****************************************************************************/
+class TestCommandRouting : public QObject {
+    Q_OBJECT
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Test of the type ID registry and the type ID table.
+     */
+    /****************************************************************************/
+    void utTestTypeIDs();
+    /****************************************************************************/
+    /**
+     * \brief Test of the command dispatch by type ID.
+     */
+    /****************************************************************************/
+    void utTestDispatch();
+    /****************************************************************************/
+    /**
+     * \brief Compare the lookup by type ID with the lookup by name.
+     */
+    /****************************************************************************/
+    void utTestBenchmark();
+}; // end class TestCommandRouting
+
+/****************************************************************************/
+void TestCommandRouting::initTestCase() {
+}
+
+/****************************************************************************/
+void TestCommandRouting::cleanupTestCase() {
+}
+
+/****************************************************************************/
+void TestCommandRouting::utTestTypeIDs() {
+    int TypeID = Global::CommandTypeID::Of<CmdRouted>();
+    QVERIFY(TypeID != Global::CommandTypeID::INVALID);
+    QCOMPARE(Global::CommandTypeID::Register(CmdRouted::NAME), TypeID);
+    QCOMPARE(Global::CommandTypeID::Name(TypeID), CmdRouted::NAME);
+    QVERIFY(Global::CommandTypeID::Of<CmdUnknown>() != TypeID);
+    QVERIFY(TypeID < Global::CommandTypeID::Count());
+    QVERIFY(Global::CommandTypeID::Name(Global::CommandTypeID::INVALID).isEmpty());
+
+    // the instance ID is the class ID, also for copies
+    CmdRouted Cmd;
+    QCOMPARE(Cmd.GetTypeID(), TypeID);
+    CmdRouted Copy(Cmd);
+    QCOMPARE(Copy.GetTypeID(), TypeID);
+
+    Global::CommandTypeTable<int> Table(-1);
+    QVERIFY(!Table.Contains(TypeID));
+    QCOMPARE(Table.Value(TypeID), -1);
+    QCOMPARE(Table.Value(Global::CommandTypeID::INVALID), -1);
+    Table.Insert(TypeID, 7);
+    QVERIFY(Table.Contains(TypeID));
+    QCOMPARE(Table.Value(TypeID), 7);
+    QVERIFY(!Table.Contains(Global::CommandTypeID::Of<CmdUnknown>()));
+    Table.Clear();
+    QVERIFY(!Table.Contains(TypeID));
+}
+
+/****************************************************************************/
+void TestCommandRouting::utTestDispatch() {
+    RoutingController Controller;
+    Controller.CreateAndInitializeObjects();
+    Controller.Dispatch(Global::CommandShPtr_t(new CmdRouted()));
+    QCOMPARE(Controller.m_Executed, 1);
+    // not registered, ignored
+    Controller.Dispatch(Global::CommandShPtr_t(new CmdUnknown()));
+    QCOMPARE(Controller.m_Executed, 1);
+}
+
+/****************************************************************************/
+void TestCommandRouting::utTestBenchmark() {
+    // the functor hash as it was before, keyed by command name
+    QHash<QString, CommandExecuteFunctorShPtr_t> NameHash;
+    Global::CommandTypeTable<CommandExecuteFunctorShPtr_t> TypeTable(FillerFunctor);
+    for (int i = 0; i < COMMAND_TYPES; i++) {
+        QString Name = QString("Threads::CmdOther%1").arg(i);
+        NameHash.insert(Name, FillerFunctor);
+        TypeTable.Insert(Global::CommandTypeID::Register(Name), FillerFunctor);
+    }
+    NameHash.insert(CmdRouted::NAME, FillerFunctor);
+    TypeTable.Insert(Global::CommandTypeID::Of<CmdRouted>(), FillerFunctor);
+
+    Global::CommandShPtr_t Cmd(new CmdRouted());
+    int Found = 0;
+    QElapsedTimer Timer;
+    Timer.start();
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        Found += NameHash.contains(Cmd->GetName()) ? 1 : 0;
+    }
+    qint64 NameTime = Timer.nsecsElapsed();
+    Timer.restart();
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        Found += TypeTable.Contains(Cmd->GetTypeID()) ? 1 : 0;
+    }
+    qint64 TypeTime = Timer.nsecsElapsed();
+    QCOMPARE(Found, 2 * LOOKUP_COUNT);
+    qDebug() << "Lookup by name:" << static_cast<double>(NameTime) / LOOKUP_COUNT << "ns,"
+             << "by type ID:" << static_cast<double>(TypeTime) / LOOKUP_COUNT << "ns per command";
+
+    // the whole dispatch in the controller
+    RoutingController Controller;
+    Controller.CreateAndInitializeObjects();
+    Timer.restart();
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        Controller.Dispatch(Cmd);
+    }
+    qDebug() << "Dispatch by type ID:" << static_cast<double>(Timer.nsecsElapsed()) / LOOKUP_COUNT << "ns per command";
+    QCOMPARE(Controller.m_Executed, LOOKUP_COUNT);
+}
+
+} // end namespace Threads
+
+QTEST_MAIN(Threads::TestCommandRouting)
+
+#include "TestCommandRouting.moc"
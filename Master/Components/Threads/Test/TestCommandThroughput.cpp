@@ -0,0 +1,372 @@
+/****************************************************************************/
+/*! \file TestCommandThroughput.cpp
+ *
+ *  \brief Benchmark of the command transfer between two thread controllers
+ *         and of the shared pointer types used for it.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QMutex>
+#include <Threads/Include/ThreadController.h>
+#include <Global/Include/IntrusivePointer.h>
+
+namespace Threads {
+
+static const int COMMAND_COUNT  = 1000000;  ///< Number of commands sent.
+static const int COMMAND_WINDOW = 10000;    ///< Maximum number of commands in the queue.
+static const int BENCHMARK_TIMEOUT = 300000; ///< Maximum duration of the transfer [ms].
+
+/****************************************************************************/
+/**
+ * \brief Command sent by the benchmark.
+ */
+/****************************************************************************/
+class CmdThroughput : public Global::Command {
+public:
+    static QString NAME;    ///< Command name.
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    CmdThroughput() : Global::Command(Global::Command::NOTIMEOUT) {}
+    /****************************************************************************/
+    /**
+     * \brief Get command name.
+     *
+     * \return  Command name.
+     */
+    /****************************************************************************/
+    virtual QString GetName() const { return NAME; }
+}; // end class CmdThroughput
+
+QString CmdThroughput::NAME = "Threads::CmdThroughput";
+
+/****************************************************************************/
+/**
+ * \brief Shared pointer guarded by a mutex per instance, as SharedPointer
+ *        was before. Only kept to compare the pointer types.
+ */
+/****************************************************************************/
+template<class ClassT> class MutexSharedPointer {
+private:
+    /****************************************************************************/
+    /**
+     * \brief Separately allocated reference counter.
+     */
+    /****************************************************************************/
+    struct RefCounter {
+        ClassT      *m_pData;   ///< Pointer to user data.
+        QAtomicInt  m_Count;    ///< Counter of users.
+    };
+    RefCounter      *m_pRefCounter;     ///< Pointer to the counter.
+    mutable QMutex  m_GuardMutex;       ///< Guard for thread safety.
+
+    /****************************************************************************/
+    /**
+     * \brief Decrement the counter and delete the object if needed.
+     */
+    /****************************************************************************/
+    void NonsafeClear() {
+        if ((m_pRefCounter != NULL) && !m_pRefCounter->m_Count.deref()) {
+            delete m_pRefCounter->m_pData;
+            delete m_pRefCounter;
+        }
+        m_pRefCounter = NULL;
+    }
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  pData   Pointer to user object.
+     */
+    /****************************************************************************/
+    MutexSharedPointer(ClassT *pData) : m_pRefCounter(new RefCounter) {
+        m_pRefCounter->m_pData = pData;
+        m_pRefCounter->m_Count = 1;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Copy constructor.
+     *
+     * \iparam  rOther  Instance to copy from.
+     */
+    /****************************************************************************/
+    MutexSharedPointer(const MutexSharedPointer &rOther) : m_pRefCounter(NULL) {
+        QMutexLocker GetOtherGuard(&rOther.m_GuardMutex);
+        (void)rOther.m_pRefCounter->m_Count.ref();
+        m_pRefCounter = rOther.m_pRefCounter;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Assignment operator.
+     *
+     * \iparam  rOther  Instance to copy from.
+     *
+     * \return  Instance of this.
+     */
+    /****************************************************************************/
+    const MutexSharedPointer & operator = (const MutexSharedPointer &rOther) {
+        if (this != &rOther) {
+            RefCounter *pTmp = NULL;
+            {
+                QMutexLocker GetOtherGuard(&rOther.m_GuardMutex);
+                (void)rOther.m_pRefCounter->m_Count.ref();
+                pTmp = rOther.m_pRefCounter;
+            }
+            QMutexLocker GetGuard(&m_GuardMutex);
+            NonsafeClear();
+            m_pRefCounter = pTmp;
+        }
+        return *this;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Destructor.
+     */
+    /****************************************************************************/
+    ~MutexSharedPointer() {
+        NonsafeClear();
+    }
+}; // end class MutexSharedPointer
+
+/****************************************************************************/
+/**
+ * \brief Thread controller sending or receiving the benchmark commands.
+ */
+/****************************************************************************/
+class ThroughputController : public ThreadController {
+    Q_OBJECT
+private:
+    const QAtomicInt    *mp_Received;   ///< Commands received by the peer.
+public:
+    QAtomicInt          m_Received;     ///< Commands received.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  ThreadID    Thread ID.
+     * \iparam  Name        Thread name.
+     */
+    /****************************************************************************/
+    ThroughputController(quint32 ThreadID, const QString &Name) :
+        ThreadController(ThreadID, Name),
+        mp_Received(NULL),
+        m_Received(0)
+    {
+    }
+    /****************************************************************************/
+    /**
+     * \brief Register the benchmark command.
+     */
+    /****************************************************************************/
+    virtual void CreateAndInitializeObjects() {
+        RegisterCommandForProcessing<CmdThroughput, ThroughputController>(&ThroughputController::OnCmdThroughput, this);
+    }
+    /****************************************************************************/
+    /**
+     * \brief Nothing to clean up.
+     */
+    /****************************************************************************/
+    virtual void CleanupAndDestroyObjects() {}
+    /****************************************************************************/
+    /**
+     * \brief Connect the command channels of both controllers.
+     *
+     * \iparam  rPeer   Controller receiving the commands.
+     */
+    /****************************************************************************/
+    void ConnectToPeer(ThroughputController &rPeer) {
+        ConnectToOtherCommandChannel(&rPeer.m_CommandChannel);
+        mp_Received = &rPeer.m_Received;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Count a received command.
+     *
+     * \iparam  Ref     Command reference.
+     * \iparam  Cmd     Command.
+     */
+    /****************************************************************************/
+    void OnCmdThroughput(Global::tRefType Ref, const CmdThroughput &Cmd) {
+        Q_UNUSED(Ref)
+        Q_UNUSED(Cmd)
+        if (m_Received.fetchAndAddRelease(1) + 1 == COMMAND_COUNT) {
+            emit AllReceived();
+        }
+    }
+
+protected:
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnGoReceived() {}
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnStopReceived() {}
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnPowerFail(const Global::PowerFailStages) {}
+
+public slots:
+    /****************************************************************************/
+    /**
+     * \brief Send all benchmark commands to the peer.
+     *
+     * At most COMMAND_WINDOW commands are queued at the peer.
+     */
+    /****************************************************************************/
+    void SendCommands() {
+        for (int i = 0; i < COMMAND_COUNT; i++) {
+            while (i - mp_Received->loadAcquire() > COMMAND_WINDOW) {
+                QThread::yieldCurrentThread();
+            }
+            DoSendCommand(i + 1, Global::CommandShPtr_t(new CmdThroughput()), m_CommandChannel);
+        }
+    }
+
+signals:
+    /****************************************************************************/
+    /**
+     * \brief All commands were received.
+     */
+    /****************************************************************************/
+    void AllReceived();
+}; // end class ThroughputController
+
+/****************************************************************************/
+/**
+ * \brief Copies a pointer as a command is copied on its way to the peer:
+ *        into the queued signal, into the handler and back out.
+ *
+ * \iparam  Name    Name of the pointer type for the report.
+ */
+/****************************************************************************/
+template<class PointerT> void BenchmarkPointer(const char *Name) {
+    QElapsedTimer Timer;
+    Timer.start();
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        PointerT Cmd(new CmdThroughput());
+        PointerT Queued(Cmd);
+        PointerT Handler(Queued);
+        Handler = Cmd;
+    }
+    qDebug() << Name << static_cast<double>(Timer.nsecsElapsed()) / COMMAND_COUNT << "ns per command";
+}
+
+/****************************************************************************/
+/**
+ * \brief Test class for the command throughput.
+ */
+/****************************************************************************/
+class TestCommandThroughput : public QObject {
+    Q_OBJECT
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Compare the pointer types in a single thread.
+     */
+    /****************************************************************************/
+    void utTestPointerCopies();
+    /****************************************************************************/
+    /**
+     * \brief Send a million commands between two thread controllers.
+     */
+    /****************************************************************************/
+    void utTestCommandTransfer();
+}; // end class TestCommandThroughput
+
+/****************************************************************************/
+void TestCommandThroughput::initTestCase() {
+}
+
+/****************************************************************************/
+void TestCommandThroughput::cleanupTestCase() {
+}
+
+/****************************************************************************/
+void TestCommandThroughput::utTestPointerCopies() {
+    BenchmarkPointer<MutexSharedPointer<Global::Command> >("Mutex guarded pointer:");
+    BenchmarkPointer<Global::SharedPointer<Global::Command> >("SharedPointer:");
+    BenchmarkPointer<Global::IntrusivePointer<Global::Command> >("IntrusivePointer:");
+}
+
+/****************************************************************************/
+void TestCommandThroughput::utTestCommandTransfer() {
+    QThread SenderThread;
+    QThread ReceiverThread;
+    ThroughputController *p_Sender = new ThroughputController(1, "Sender");
+    ThroughputController *p_Receiver = new ThroughputController(2, "Receiver");
+    p_Receiver->CreateAndInitializeObjects();
+    p_Sender->ConnectToPeer(*p_Receiver);
+    p_Sender->moveToThread(&SenderThread);
+    p_Receiver->moveToThread(&ReceiverThread);
+    QSignalSpy Spy(p_Receiver, SIGNAL(AllReceived()));
+    SenderThread.start();
+    ReceiverThread.start();
+
+    QElapsedTimer Timer;
+    Timer.start();
+    QVERIFY(QMetaObject::invokeMethod(p_Sender, "SendCommands", Qt::QueuedConnection));
+    QVERIFY(Spy.wait(BENCHMARK_TIMEOUT));
+    qint64 Elapsed = Timer.nsecsElapsed();
+    QCOMPARE(p_Receiver->m_Received.loadAcquire(), COMMAND_COUNT);
+#ifdef GLOBAL_INTRUSIVE_COMMAND_POINTER
+    qDebug() << "IntrusivePointer commands:";
+#else
+    qDebug() << "SharedPointer commands:";
+#endif
+    qDebug() << COMMAND_COUNT << "commands in" << Elapsed / 1000000 << "ms,"
+             << static_cast<double>(Elapsed) / COMMAND_COUNT << "ns per command";
+
+    SenderThread.quit();
+    ReceiverThread.quit();
+    QVERIFY(SenderThread.wait());
+    QVERIFY(ReceiverThread.wait());
+    delete p_Sender;
+    delete p_Receiver;
+}
+
+} // end namespace Threads
+
+QTEST_MAIN(Threads::TestCommandThroughput)
+
+#include "TestCommandThroughput.moc"
@@ -0,0 +1,324 @@
+/****************************************************************************/
+/*! \file TestPendingCommands.cpp
+ *
+ *  \brief Test of the command timeouts of the thread controllers.
+ *
+ *  $Version:   $ 0.1
+ *  $Date:      $ 2026-10-17
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ *
+ */
+/****************************************************************************/
+
+#include <QTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <Threads/Include/ThreadController.h>
+
+namespace Threads {
+
+static const int COMMAND_COUNT  = 1000;     ///< Number of commands sent.
+static const int TIMEOUT_MIN    = 20;       ///< Shortest command timeout [ms].
+static const int TIMEOUT_STEPS  = 10;       ///< Number of different command timeouts.
+static const int TIMEOUT_STEP   = 15;       ///< Difference between the command timeouts [ms].
+static const int WAIT_TIMEOUT   = 2000;     ///< Maximum time to wait for all timeouts [ms].
+
+/****************************************************************************/
+/**
+ * \brief Command with a timeout.
+ */
+/****************************************************************************/
+class CmdTimed : public Global::Command {
+public:
+    static QString NAME;    ///< Command name.
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  Timeout     Timeout [ms].
+     */
+    /****************************************************************************/
+    CmdTimed(int Timeout) : Global::Command(Timeout) {}
+    /****************************************************************************/
+    /**
+     * \brief Get command name.
+     *
+     * \return  Command name.
+     */
+    /****************************************************************************/
+    virtual QString GetName() const { return NAME; }
+}; // end class CmdTimed
+
+QString CmdTimed::NAME = "Threads::CmdTimed";
+
+/****************************************************************************/
+/**
+ * \brief Thread controller recording the command timeouts.
+ */
+/****************************************************************************/
+class TimeoutController : public ThreadController {
+    Q_OBJECT
+public:
+    QElapsedTimer                   m_Clock;        ///< Clock for the send and timeout times.
+    QHash<Global::tRefType, qint64> m_Deadlines;    ///< Earliest timeout time of each command [ns].
+    QList<Global::tRefType>         m_TimedOut;     ///< Commands timed out.
+    int                             m_Early;        ///< Commands timed out before their deadline.
+
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     */
+    /****************************************************************************/
+    TimeoutController() : ThreadController(1, "Timeouts"), m_Early(0) {
+        m_Clock.start();
+    }
+    /****************************************************************************/
+    /**
+     * \brief Nothing to create.
+     */
+    /****************************************************************************/
+    virtual void CreateAndInitializeObjects() {}
+    /****************************************************************************/
+    /**
+     * \brief Nothing to clean up.
+     */
+    /****************************************************************************/
+    virtual void CleanupAndDestroyObjects() {}
+    /****************************************************************************/
+    /**
+     * \brief Send a command with a timeout.
+     *
+     * \iparam  Timeout     Timeout [ms].
+     *
+     * \return  Command reference.
+     */
+    /****************************************************************************/
+    Global::tRefType Send(int Timeout) {
+        Global::tRefType Ref = GetNewCommandRef();
+        Send(Ref, Timeout);
+        return Ref;
+    }
+    /****************************************************************************/
+    /**
+     * \brief Send a command with a timeout and a given reference.
+     *
+     * \iparam  Ref         Command reference.
+     * \iparam  Timeout     Timeout [ms].
+     */
+    /****************************************************************************/
+    void Send(Global::tRefType Ref, int Timeout) {
+        m_Deadlines.insert(Ref, m_Clock.nsecsElapsed() + Timeout * Q_INT64_C(1000000));
+        DoSendCommand(Ref, Global::CommandShPtr_t(new CmdTimed(Timeout)), m_CommandChannel);
+    }
+    /****************************************************************************/
+    /**
+     * \brief Acknowledge a command.
+     *
+     * \iparam  Ref     Command reference.
+     */
+    /****************************************************************************/
+    void Acknowledge(Global::tRefType Ref) {
+        UnblockCommandRef(Ref);
+        RemoveFromPendingCommands(Ref);
+    }
+
+protected:
+    /****************************************************************************/
+    /**
+     * \brief Record a command timeout.
+     *
+     * \iparam  Ref         Command reference.
+     * \iparam  CmdName     Command name.
+     */
+    /****************************************************************************/
+    virtual void OnCmdTimeout(Global::tRefType Ref, const QString &CmdName) {
+        Q_UNUSED(CmdName)
+        if (m_Clock.nsecsElapsed() < m_Deadlines.value(Ref)) {
+            m_Early++;
+        }
+        m_TimedOut.append(Ref);
+    }
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnGoReceived() {}
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnStopReceived() {}
+    /****************************************************************************/
+    /**
+     * \brief Not used.
+     */
+    /****************************************************************************/
+    virtual void OnPowerFail(const Global::PowerFailStages) {}
+}; // end class TimeoutController
+
+/****************************************************************************/
+/**
+ * \brief Thread sending a command over a controller of another thread.
+ */
+/****************************************************************************/
+class SendThread : public QThread {
+public:
+    /****************************************************************************/
+    /**
+     * \brief Constructor.
+     *
+     * \iparam  rController     Controller sending the command.
+     * \iparam  Timeout         Command timeout [ms].
+     */
+    /****************************************************************************/
+    SendThread(TimeoutController &rController, int Timeout) :
+        m_rController(rController), m_Timeout(Timeout) {
+    }
+
+protected:
+    /****************************************************************************/
+    /**
+     * \brief Send the command.
+     */
+    /****************************************************************************/
+    void run() {
+        (void)m_rController.Send(m_Timeout);
+    }
+
+private:
+    TimeoutController   &m_rController; ///< Controller sending the command.
+    int                 m_Timeout;      ///< Command timeout [ms].
+}; // end class SendThread
+
+/****************************************************************************/
+/**
+ * \brief Test class for the command timeouts.
+ */
+/****************************************************************************/
+class TestPendingCommands : public QObject {
+    Q_OBJECT
+private:
+    /****************************************************************************/
+    /**
+     * \brief Wait until the controller has no pending commands.
+     *
+     * \iparam  Controller  Controller to wait for.
+     *
+     * \return  True if no command is pending.
+     */
+    /****************************************************************************/
+    bool WaitForPendingCommands(const TimeoutController &Controller) {
+        for (int Time = 0; Time < WAIT_TIMEOUT && Controller.GetPendingCommandCount() > 0; Time += 10) {
+            QTest::qWait(10);
+        }
+        return Controller.GetPendingCommandCount() == 0;
+    }
+private slots:
+    /****************************************************************************/
+    /**
+     * \brief Called before the first testfunction is executed.
+     */
+    /****************************************************************************/
+    void initTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Called after last testfunction was executed.
+     */
+    /****************************************************************************/
+    void cleanupTestCase();
+    /****************************************************************************/
+    /**
+     * \brief Commands not acknowledged time out, never before their deadline.
+     */
+    /****************************************************************************/
+    void utTestTimeouts();
+    /****************************************************************************/
+    /**
+     * \brief A reused reference does not time out with the old deadline.
+     */
+    /****************************************************************************/
+    void utTestReusedReference();
+    /****************************************************************************/
+    /**
+     * \brief A command sent from another thread times out in the controller thread.
+     */
+    /****************************************************************************/
+    void utTestForeignThread();
+}; // end class TestPendingCommands
+
+/****************************************************************************/
+void TestPendingCommands::initTestCase() {
+}
+
+/****************************************************************************/
+void TestPendingCommands::cleanupTestCase() {
+}
+
+/****************************************************************************/
+void TestPendingCommands::utTestTimeouts() {
+    TimeoutController Controller;
+    QSet<Global::tRefType> Expected;
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        Global::tRefType Ref = Controller.Send(TIMEOUT_MIN + (i % TIMEOUT_STEPS) * TIMEOUT_STEP);
+        if (i % 2 == 0) {
+            Controller.Acknowledge(Ref);
+        }
+        else {
+            Expected.insert(Ref);
+        }
+    }
+    QCOMPARE(Controller.GetPendingCommandCount(), COMMAND_COUNT / 2);
+
+    QVERIFY(WaitForPendingCommands(Controller));
+    QCOMPARE(Controller.m_TimedOut.count(), Expected.count());
+    QCOMPARE(Controller.m_TimedOut.toSet(), Expected);
+    QCOMPARE(Controller.m_Early, 0);
+}
+
+/****************************************************************************/
+void TestPendingCommands::utTestReusedReference() {
+    TimeoutController Controller;
+    Global::tRefType Ref = Controller.Send(TIMEOUT_MIN);
+    Controller.Acknowledge(Ref);
+    // the old deadline stays in the wheel
+    Controller.Send(Ref, TIMEOUT_MIN * 10);
+    QTest::qWait(TIMEOUT_MIN * 3);
+    QVERIFY(Controller.m_TimedOut.isEmpty());
+    QCOMPARE(Controller.GetPendingCommandCount(), 1);
+
+    QVERIFY(WaitForPendingCommands(Controller));
+    QCOMPARE(Controller.m_TimedOut.count(), 1);
+    QCOMPARE(Controller.m_TimedOut.first(), Ref);
+    QCOMPARE(Controller.m_Early, 0);
+}
+
+/****************************************************************************/
+void TestPendingCommands::utTestForeignThread() {
+    TimeoutController Controller;
+    SendThread Sender(Controller, TIMEOUT_MIN);
+    Sender.start();
+    QVERIFY(Sender.wait(WAIT_TIMEOUT));
+    // the command is added by the event loop of the controller thread
+    QCOMPARE(Controller.GetPendingCommandCount(), 0);
+    QCoreApplication::processEvents();
+    QCOMPARE(Controller.GetPendingCommandCount(), 1);
+
+    QVERIFY(WaitForPendingCommands(Controller));
+    QCOMPARE(Controller.m_TimedOut.count(), 1);
+    QCOMPARE(Controller.m_Early, 0);
+}
+
+} // end namespace Threads
+
+QTEST_MAIN(Threads::TestPendingCommands)
+
+#include "TestPendingCommands.moc"
@@ -0,0 +1,9 @@
+!include("Threads.pri") {
+    error("Threads.pri not found")
+}
+
+TARGET = utTestPendingCommands
+
+SOURCES += TestPendingCommands.cpp
+
+UseLibs(Threads Global EventHandler DataLogging NetCommands)
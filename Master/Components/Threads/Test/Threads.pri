@@ -0,0 +1,5 @@
+# include pri file from Master/Test
+
+!include("../../../Test/Platform.pri") {
+    error("../../../Test/Platform.pri not found")
+}
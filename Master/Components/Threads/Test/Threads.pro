@@ -0,0 +1,11 @@
+!include("Threads.pri") {
+    error("Threads.pri not found")
+}
+
+TEMPLATE = subdirs
+
+SUBDIRS = TestCommandThroughput.pro \
+          TestCommandRouting.pro \
+          TestPendingCommands.pro
+
+CONFIG += ordered
@@ -0,0 +1,145 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Generates the linearization tables (bmLinearTable_t, see bmLinearize.h) of
+# the conversion tables in a source file of a function module.
+#
+# usage: genLinearTables.py [-p POINTS] [-s STEP] FILE
+#
+# All tables "static const Int16 <Name>[...] = { ... };" before the generated
+# section of FILE are converted, at most POINTS sampling points of each. The
+# output changes by STEP from one sampling point to the next. The generated
+# section of FILE is replaced by a table <Name>Linear for each of them.
+#
+# bmLinearize searches the segment containing an input value by a binary
+# search on the search keys. The keys are the monotonic envelope of the
+# points, so they are the points themselves for a monotonic table. For each
+# possible input value, the generator checks that the result is the same as
+# the one of a search from the start of the table, which takes the first
+# segment containing the input value.
+
+from __future__ import print_function
+
+import re, sys
+from optparse import OptionParser
+
+BEGIN = '// Linearization Tables (generated by genLinearTables.py, do not edit)'
+END = '// End of Linearization Tables'
+RULER = '//****************************************************************************/'
+
+TABLE = re.compile(r'^static const Int16 (\w+)\[\w*\] = \{(.*?)\};', re.M | re.S)
+GUARD = re.compile(r'^#(ifdef (\w+)|endif)', re.M)
+
+
+def parse(Text):
+    """ Returns name, #ifdef guard and points of each table in Text """
+    Tables = []
+    for Match in TABLE.finditer(Text):
+        Name, Body = Match.groups()
+        # the table is inside an #ifdef block, if it is not closed before
+        Guard = None
+        for Directive in GUARD.finditer(Text, 0, Match.start()):
+            Guard = Directive.group(2)
+        Body = re.sub(r'//.*', '', Body)
+        Points = [int(Value) for Value in Body.split(',') if Value.strip()]
+        Tables.append((Name, Guard, Points))
+    return Tables
+
+
+def scan(Points, Step, Input):
+    """ Conversion by searching from the start of the table """
+    for i in range(len(Points) - 1):
+        Low, High = min(Points[i], Points[i + 1]), max(Points[i], Points[i + 1])
+        if Low <= Input <= High:
+            if Low == High:
+                raise ValueError('segment %d is empty' % i)
+            return Step * i + Step * abs(Input - Points[i]) // (High - Low)
+    return None
+
+
+def search(Points, Keys, Step, Input):
+    """ Conversion as done by bmLinearize """
+    Falling = Points[0] > Points[-1]
+    Lower, Upper = 0, len(Points) - 1
+    while Lower < Upper:
+        Middle = (Lower + Upper) // 2
+        if (Keys[Middle + 1] <= Input) if Falling else (Keys[Middle + 1] >= Input):
+            Upper = Middle
+        else:
+            Lower = Middle + 1
+    if Lower >= len(Points) - 1:
+        return None
+    Offset, Width = Input - Points[Lower], Points[Lower + 1] - Points[Lower]
+    if Falling:
+        Offset, Width = -Offset, -Width
+    if Offset < 0 or Offset > Width:
+        return None
+    return Step * Lower + (Step * Offset // Width if Width else 0)
+
+
+def envelope(Points):
+    """ Returns the search keys of a table """
+    Keys, Limit = [], Points[0]
+    for Point in Points:
+        Limit = min(Limit, Point) if Points[0] > Points[-1] else max(Limit, Point)
+        Keys.append(Limit)
+    return Keys
+
+
+def generate(Name, Guard, Points, Step):
+    """ Returns the source code of a linearization table """
+    Keys = envelope(Points)
+    for Input in range(min(Points) - 1, max(Points) + 2):
+        if scan(Points, Step, Input) != search(Points, Keys, Step, Input):
+            raise ValueError('%s: binary search fails at input %d' % (Name, Input))
+
+    Lines = []
+    if Guard:
+        Lines += ['#ifdef %s' % Guard]
+    if Keys != Points:
+        Lines += ['/*! Search keys of %s, monotonic envelope of the points */' % Name,
+                  'static const Int16 %sKeys[%d] = {' % (Name, len(Keys))]
+        for i in range(0, len(Keys), 10):
+            Row = ', '.join('%5d' % Key for Key in Keys[i:i + 10])
+            Lines += ['    %s%s' % (Row, ',' if i + 10 < len(Keys) else '')]
+        Lines += ['};', '']
+        KeyName = Name + 'Keys'
+    else:
+        KeyName = Name
+    Lines += ['/*! Linearization of %s */' % Name,
+              'static const bmLinearTable_t %sLinear = {' % Name,
+              '    %s, %s, %d, %d' % (Name, KeyName, len(Points), Step),
+              '};']
+    if Guard:
+        Lines += ['#endif']
+    return Lines
+
+
+def main():
+    Parser = OptionParser(usage='%prog [-p POINTS] [-s STEP] FILE')
+    Parser.add_option('-p', '--points', type='int', default=0xFFFF, help='max. number of sampling points used')
+    Parser.add_option('-s', '--step', type='int', default=100, help='output change between two sampling points')
+    Options, Args = Parser.parse_args()
+    if len(Args) != 1:
+        Parser.error('no source file given')
+
+    Data = open(Args[0], 'rb').read().decode('ascii')
+    Newline = '\r\n' if '\r\n' in Data else '\n'
+    Text = Data.replace('\r\n', '\n')
+    Begin = Text.index(BEGIN + '\n' + RULER + '\n') + len(BEGIN) + len(RULER) + 2
+    End = Text.rindex(RULER + '\n' + END)
+
+    Lines = ['']
+    for Name, Guard, Points in parse(Text[:Begin]):
+        Lines += generate(Name, Guard, Points[:Options.points], Options.step) + ['']
+        print('%s: %d points' % (Name, min(len(Points), Options.points)))
+
+    Text = Text[:Begin] + '\n'.join(Lines) + '\n' + Text[End:]
+    open(Args[0], 'wb').write(Text.replace('\n', Newline).encode('ascii'))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except ValueError as Error:
+        sys.exit('error: %s' % Error)
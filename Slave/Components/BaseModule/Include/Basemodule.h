@@ -38,6 +38,7 @@
 #include "bmCan.h"
 #include "bmDebug.h"
 #include "bmStorage.h"
+#include "bmLinearize.h"
 #include "bmMain.h"
 #include "ModuleIDs.h"
 
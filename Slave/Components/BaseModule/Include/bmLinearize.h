@@ -0,0 +1,77 @@
+/****************************************************************************/
+/*! \file bmLinearize.h
+ *
+ *  \brief Sensor linearization and sample filter
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *         This module converts sensor readings using a table of sampling
+ *         points with linear interpolation between them, and filters a
+ *         number of samples read from an analog input. It is shared by
+ *         all function modules reading sensors.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ */
+/****************************************************************************/
+
+#ifndef BM_LINEARIZE_H
+#define BM_LINEARIZE_H
+
+//****************************************************************************/
+// Public Constants and Macros
+//****************************************************************************/
+
+#define FILTER_MAX_SAMPLES      16  //!< Max. number of samples per filtered value
+
+//****************************************************************************/
+// Public Type Definitions
+//****************************************************************************/
+
+//! Filter applied to the samples of an analog input
+typedef enum {
+    FILTER_MEDIAN,      //!< Median of the samples
+    FILTER_MEAN         //!< Mean value of the samples (oversampling)
+} bmFilterMode_t;
+
+//! Filter settings
+typedef struct {
+    UInt8 Samples;          //!< Number of samples, 1 to FILTER_MAX_SAMPLES
+    bmFilterMode_t Mode;    //!< Filter applied to the samples
+} bmFilter_t;
+
+//! Function reading a single sample, e.g. halAnalogRead
+typedef Error_t (*bmSampleRead_t) (Handle_t Handle, Int16 *Value);
+
+/*! Linearization table, generated by Slave/Build/genLinearTables.py
+ *
+ *  The output changes by Step from one sampling point to the next. Keys is
+ *  the monotonic envelope of the points, the binary search runs on it. It
+ *  differs from Points only where the points are not monotonic.
+ */
+typedef struct {
+    const Int16 *Points;    //!< Input value at each sampling point
+    const Int16 *Keys;      //!< Search key of each sampling point
+    UInt16 Count;           //!< Number of sampling points
+    Int16 Step;             //!< Output change between two sampling points
+} bmLinearTable_t;
+
+//****************************************************************************/
+// Public Function Prototypes
+//****************************************************************************/
+
+Bool bmLinearize (const bmLinearTable_t *Table, Int32 Input, Int32 *Output);
+Int16 bmFilterSamples (Int16 *Samples, UInt8 Count, bmFilterMode_t Mode);
+Error_t bmReadFiltered (bmSampleRead_t Read, Handle_t Handle, const bmFilter_t *Filter, Int16 *Value);
+
+//****************************************************************************/
+
+#endif /*BM_LINEARIZE_H*/
@@ -0,0 +1,62 @@
+/****************************************************************************/
+/*! \file bmTransfer.h
+ *
+ *  \brief Image transfer flow control
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *         This module contains the flow control of the update data
+ *         messages, which is shared by the boot loader update and the
+ *         firmware update in the boot loader. It filters double CAN frames,
+ *         calculates a running CRC of the received image and decides when
+ *         the received data has to be acknowledged.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ */
+/****************************************************************************/
+
+#ifndef BM_TRANSFER_H
+#define BM_TRANSFER_H
+
+//****************************************************************************/
+// Public Constants and Macros
+//****************************************************************************/
+
+#define TRANSFER_FRAME_SIZE     8   //!< Image bytes per data message
+#define TRANSFER_MAX_WINDOW     16  //!< Max. unacknowledged data messages
+
+//****************************************************************************/
+// Public Type Definitions
+//****************************************************************************/
+
+//! State of an image transfer
+typedef struct {
+    UInt32 Length;      //!< Length of the image
+    UInt32 Count;       //!< Amount of image data received
+    UInt32 Crc;         //!< Running CRC32 remainder of the received data
+    UInt8 Window;       //!< Window size in messages, 0 = acknowledge each message
+    UInt8 Pending;      //!< Messages received since the last acknowledge
+} bmTransfer_t;
+
+//****************************************************************************/
+// Public Function Prototypes
+//****************************************************************************/
+
+void bmTransferInit (bmTransfer_t *Transfer, UInt32 Length, UInt8 Window);
+Error_t bmTransferAccept (bmTransfer_t *Transfer, UInt8 Length, UInt8 Count);
+Bool bmTransferCommit (bmTransfer_t *Transfer, const UInt8 *Data, UInt8 Length);
+UInt32 bmTransferCrc (const bmTransfer_t *Transfer);
+UInt32 bmCrc32Update (UInt32 Crc, const UInt8 *Data, UInt32 Length);
+
+//****************************************************************************/
+
+#endif /*BM_TRANSFER_H*/
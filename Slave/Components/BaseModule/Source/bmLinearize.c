@@ -0,0 +1,178 @@
+/****************************************************************************/
+/*! \file bmLinearize.c
+ *
+ *  \brief Sensor linearization and sample filter
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *         This module converts sensor readings using a table of sampling
+ *         points with linear interpolation between them. The segment
+ *         containing the input is found by a binary search, so a conversion
+ *         takes about log2(Count) table accesses instead of walking the
+ *         table from its start.
+ *
+ *         The tables are generated offline by Slave/Build/genLinearTables.py
+ *         from the sampling points of the sensor data sheet. The generator
+ *         checks that the binary search results in the same segment as a
+ *         search from the start of the table for each input value.
+ *
+ *         Furthermore, the module reads a number of samples from an analog
+ *         input and returns their median or mean value.
+ *
+ *         The module does not access the hardware, it can also be used in a
+ *         host based simulation.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ */
+/****************************************************************************/
+
+#include "Global.h"
+#include "bmError.h"
+#include "bmLinearize.h"
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Converts a sensor reading using a linearization table
+ *
+ *      Searches the segment between two sampling points containing the
+ *      input value and interpolates the output linearly. Tables with
+ *      falling input values are supported. If the input value is on a
+ *      sampling point, the segment ending at this point is used.
+ *
+ *  \iparam  Table = Linearization table
+ *  \iparam  Input = Sensor reading
+ *  \oparam  Output = Converted value, Step * index of the sampling point
+ *
+ *  \return  TRUE if converted, FALSE if the input is out of range
+ *
+ ****************************************************************************/
+
+Bool bmLinearize (const bmLinearTable_t *Table, Int32 Input, Int32 *Output)
+{
+    const Int16 *Points = Table->Points;
+    const Int16 *Keys = Table->Keys;
+    Bool Falling = (Points[0] > Points[Table->Count - 1]);
+    UInt16 Lower = 0;
+    UInt16 Upper = Table->Count - 1;
+    UInt16 Middle;
+    Int32 Offset;
+    Int32 Width;
+
+    // find the first segment, whose end is not below (above) the input
+    while (Lower < Upper) {
+        Middle = (Lower + Upper) / 2;
+        if (Falling ? (Keys[Middle + 1] <= Input) : (Keys[Middle + 1] >= Input)) {
+            Upper = Middle;
+        }
+        else {
+            Lower = Middle + 1;
+        }
+    }
+    if (Lower >= Table->Count - 1) {
+        return (FALSE);
+    }
+
+    Offset = Input - Points[Lower];
+    Width  = Points[Lower + 1] - Points[Lower];
+    if (Falling) {
+        Offset = -Offset;
+        Width  = -Width;
+    }
+    if (Offset < 0 || Offset > Width) {
+        return (FALSE);
+    }
+    *Output = Table->Step * Lower;
+    if (Width != 0) {
+        *Output += (Table->Step * Offset) / Width;
+    }
+    return (TRUE);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Filters a number of samples
+ *
+ *      Returns the median or the mean value of the samples. The median of
+ *      an even number of samples is the upper one of the two middle values.
+ *      The samples are sorted in place for the median.
+ *
+ *  \xparam  Samples = Samples to filter
+ *  \iparam  Count = Number of samples, at least 1
+ *  \iparam  Mode = Filter applied to the samples
+ *
+ *  \return  Filtered value
+ *
+ ****************************************************************************/
+
+Int16 bmFilterSamples (Int16 *Samples, UInt8 Count, bmFilterMode_t Mode)
+{
+    Int32 Sum = 0;
+    Int16 Sample;
+    UInt8 i, k;
+
+    if (Mode == FILTER_MEAN) {
+        for (i = 0; i < Count; i++) {
+            Sum += Samples[i];
+        }
+        return ((Int16) (Sum / Count));
+    }
+
+    // insertion sort, fast for the few samples used
+    for (i = 1; i < Count; i++) {
+        Sample = Samples[i];
+        for (k = i; k > 0 && Samples[k - 1] > Sample; k--) {
+            Samples[k] = Samples[k - 1];
+        }
+        Samples[k] = Sample;
+    }
+    return (Samples[Count / 2]);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Reads a filtered value from an analog input
+ *
+ *      Reads the number of samples given by the filter settings using the
+ *      passed read function and returns the filtered value.
+ *
+ *  \iparam  Read = Function reading a single sample
+ *  \iparam  Handle = Handle of the analog input
+ *  \iparam  Filter = Filter settings
+ *  \oparam  Value = Filtered value
+ *
+ *  \return  NO_ERROR or (negative) error code
+ *
+ ****************************************************************************/
+
+Error_t bmReadFiltered (bmSampleRead_t Read, Handle_t Handle, const bmFilter_t *Filter, Int16 *Value)
+{
+    Int16 Samples[FILTER_MAX_SAMPLES];
+    Error_t Error;
+    UInt8 i;
+
+    if (Filter->Samples == 0 || Filter->Samples > FILTER_MAX_SAMPLES) {
+        return (E_PARAMETER_OUT_OF_RANGE);
+    }
+    for (i = 0; i < Filter->Samples; i++) {
+        if ((Error = Read (Handle, &Samples[i])) < 0) {
+            return (Error);
+        }
+    }
+    *Value = bmFilterSamples (Samples, Filter->Samples, Filter->Mode);
+
+    return (NO_ERROR);
+}
+
+//****************************************************************************/
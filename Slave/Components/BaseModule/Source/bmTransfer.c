@@ -0,0 +1,189 @@
+/****************************************************************************/
+/*! \file bmTransfer.c
+ *
+ *  \brief Image transfer flow control
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *         This module contains the flow control of the update data
+ *         messages, which is shared by the boot loader update and the
+ *         firmware update in the boot loader.
+ *
+ *         The master alternates the update data messages 0 and 1, so the
+ *         parity of the message number is known for each message. A message
+ *         with the wrong parity is a double CAN frame and is dropped.
+ *
+ *         Without a window every message is acknowledged. With a window, the
+ *         master sends up to Window messages without waiting. They are
+ *         acknowledged in blocks of half the window, the acknowledge carries
+ *         the number of bytes received and the CRC over these bytes. The
+ *         CRC is calculated while the data is received, so a transmission
+ *         error is detected without reading back the flash memory. The
+ *         programmed image is still read back at the end of the transfer.
+ *
+ *         The module does not access the hardware, it can also be used in a
+ *         host based simulation.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ */
+/****************************************************************************/
+
+#include "Global.h"
+#include "bmError.h"
+#include "bmTransfer.h"
+
+
+//****************************************************************************/
+// Private Constants and Macros
+//****************************************************************************/
+
+#define CRC32_POLYNOMIAL     0x04C11DB7u   //!< CRC32 polynomial
+#define CRC32_INITIAL_VALUE  0xFFFFFFFFu   //!< CRC32 start value
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Starts a new transfer
+ *
+ *      Resets the received data counter and the running CRC. The window
+ *      size is limited to TRANSFER_MAX_WINDOW.
+ *
+ *  \oparam  Transfer = Transfer state
+ *  \iparam  Length = Length of the image
+ *  \iparam  Window = Window size in messages, 0 = acknowledge each message
+ *
+ ****************************************************************************/
+
+void bmTransferInit (bmTransfer_t *Transfer, UInt32 Length, UInt8 Window)
+{
+    Transfer->Length  = Length;
+    Transfer->Count   = 0;
+    Transfer->Crc     = CRC32_INITIAL_VALUE;
+    Transfer->Window  = MIN(Window, TRANSFER_MAX_WINDOW);
+    Transfer->Pending = 0;
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Checks if a received data message is to be stored
+ *
+ *      Messages with the wrong flow control count are double CAN frames.
+ *      They are dropped without an acknowledge.
+ *
+ *  \iparam  Transfer = Transfer state
+ *  \iparam  Length = Number of data bytes in the message
+ *  \iparam  Count = Flow control count of the message (0 or 1)
+ *
+ *  \return  1 to store the data, 0 to drop it or (negative) error code
+ *
+ ****************************************************************************/
+
+Error_t bmTransferAccept (bmTransfer_t *Transfer, UInt8 Length, UInt8 Count)
+{
+    if (Transfer->Count + Length > Transfer->Length) {
+        return (E_PARAMETER_OUT_OF_RANGE);
+    }
+    if ((Transfer->Count / TRANSFER_FRAME_SIZE) % 2 != Count) {
+        return (0);
+    }
+    return (1);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Adds stored data to the transfer
+ *
+ *      Must be called after the data of an accepted message was stored.
+ *      Updates the running CRC and returns if the master waits for an
+ *      acknowledge.
+ *
+ *  \iparam  Transfer = Transfer state
+ *  \iparam  Data = Data of the message
+ *  \iparam  Length = Number of data bytes in the message
+ *
+ *  \return  TRUE if an acknowledge must be sent
+ *
+ ****************************************************************************/
+
+Bool bmTransferCommit (bmTransfer_t *Transfer, const UInt8 *Data, UInt8 Length)
+{
+    Transfer->Crc = bmCrc32Update (Transfer->Crc, Data, Length);
+    Transfer->Count += Length;
+    Transfer->Pending++;
+
+    if (Transfer->Pending >= MAX(Transfer->Window / 2, 1) || Transfer->Count == Transfer->Length) {
+        Transfer->Pending = 0;
+        return (TRUE);
+    }
+    return (FALSE);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Returns the CRC of the data received so far
+ *
+ *  \iparam  Transfer = Transfer state
+ *
+ *  \return  CRC32 value, as calculated by bmFlashCrc
+ *
+ ****************************************************************************/
+
+UInt32 bmTransferCrc (const bmTransfer_t *Transfer)
+{
+    return (Transfer->Crc ^ CRC32_INITIAL_VALUE);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Adds a data block to a CRC32 remainder
+ *
+ *      Performs the modulo-2 division of the CRC32 for the data block. The
+ *      polynomial used is:
+ *
+ *          x32+x26+x23+x22+x16+x12+x11+x10+x8+x7+x5+x4+x2+x+1
+ *
+ *      Start with 0xFFFFFFFF and complement the final remainder.
+ *
+ *  \iparam  Crc = CRC32 remainder
+ *  \iparam  Data = Data block
+ *  \iparam  Length = Size of data block (in bytes)
+ *
+ *  \return  New CRC32 remainder
+ *
+ ****************************************************************************/
+
+UInt32 bmCrc32Update (UInt32 Crc, const UInt8 *Data, UInt32 Length)
+{
+    UInt32 i, k;
+
+    // Perform modulo-2 division for each byte
+    for (i=0; i < Length; i++) {
+        Crc ^= (UInt32)Data[i] << (32 - 8);
+
+        // Perform modulo-2 division for each bit in byte
+        for (k=0; k < 8; k++) {
+            if (Crc & BIT(31)) {
+                Crc = ((Crc << 1) ^ CRC32_POLYNOMIAL) & MAX_UINT32;
+            }
+            else {
+                Crc = (Crc << 1) & MAX_UINT32;
+            }
+        }
+    }
+    return (Crc);
+}
+
+//****************************************************************************/
@@ -28,6 +28,7 @@
 #include "bmCommon.h"
 #include "bmDispatch.h"
 #include "bmError.h"
+#include "bmTransfer.h"
 #include "bmUpdate.h"
 #include "bmUtilities.h"
 #include "halStorage.h"
@@ -37,8 +38,11 @@
 // Private Constants and Macros
 //****************************************************************************/
 
-#define CRC32_POLYNOMIAL     0x04C11DB7u   //!< CRC32 polynomial
 #define CRC32_INITIAL_VALUE  0xFFFFFFFFu   //!< CRC32 start value
+#define CRC32_READ_SIZE      32            //!< Flash bytes read at once for the CRC
+
+//! Max. window size, the firmware receives other messages during the update
+#define UPDATE_MAX_WINDOW    (TRANSFER_MAX_WINDOW / 2)
 
 
 //****************************************************************************/
@@ -58,9 +62,8 @@ typedef enum {
 
 static Handle_t bmHandleFlash;  //!< Handle for the flash memory
 static bmUpdateState_t bmUpdateState = UPDATE_STATE_INITIALIZED;  //!< Update State
-static UInt32 bmImageLength;    //!< Length of the boot loader image
 static UInt32 bmImageOffset;    //!< Offset to start within the image flash memory area
-static UInt32 bmImageCount;     //!< Amount of data already programmed to flash memory
+static bmTransfer_t bmImageTransfer;    //!< Flow control and CRC of the image transfer
 
 static const UInt32 blSectorSize = 0x6000;  //!< The size of the flash sector used by the boot loader
 
@@ -80,12 +83,14 @@ static Error_t bmUpdateTrailer (UInt16 Channel, CanMessage_t *Message);
  *  \brief   Handles update header messages
  *
  *      This function is called, when a update header message is received from
- *      the master. The message contains two parameters, the length of the
- *      image and the starting offset within the target area of the flash
- *      memory. The function erases the required area in the flash memory. It
- *      also returns an acknowledgement message to the master. This message
- *      indicates, if the update is possible or if the image can not fit into
- *      flash. It also changes the update state to started.
+ *      the master. The message contains three parameters, the length of the
+ *      image, the requested window size and the starting offset within the
+ *      target area of the flash memory. The function erases the required area
+ *      in the flash memory. It also returns an acknowledgement message to the
+ *      master. This message indicates, if the update is possible or if the
+ *      image can not fit into flash. If the master requested a window, the
+ *      granted window size is added. It also changes the update state to
+ *      started.
  *
  *  \iparam  Channel = Logical channel number
  *  \iparam  Message = Received CAN message
@@ -98,26 +103,29 @@ static Error_t bmUpdateHeader (UInt16 Channel, CanMessage_t *Message)
 {
     Error_t Status;
     UInt8 State = 0;
+    UInt8 Window;
+    UInt32 ImageLength;
     CanMessage_t Response;
 
     if (Message->Length < 8) {
         return (E_MISSING_PARAMETERS);
     }
 
-    bmImageLength = bmGetMessageItem (Message, 0, 4);
-    bmImageOffset = bmGetMessageItem (Message, 4, 4);
-    bmImageCount = 0;
+    ImageLength   = bmGetMessageItem (Message, 0, 4);
+    Window        = bmGetMessageItem (Message, 4, 1);
+    bmImageOffset = bmGetMessageItem (Message, 5, 3);
+    bmTransferInit (&bmImageTransfer, ImageLength, MIN(Window, UPDATE_MAX_WINDOW));
 
-    if (bmGetBootLoaderSize() < bmImageLength) {
+    if (bmGetBootLoaderSize() < ImageLength) {
         State = 1;
     }
-    else if (bmGetBootLoaderSize() < bmImageOffset + bmImageLength) {
+    else if (bmGetBootLoaderSize() < bmImageOffset + ImageLength) {
         State = 2;
     }
 
     if (State == 0) {
         if (bmImageOffset == 0) {
-            if ((Status = halStorageErase(bmHandleFlash, 0, bmImageLength)) < NO_ERROR) {
+            if ((Status = halStorageErase(bmHandleFlash, 0, ImageLength)) < NO_ERROR) {
                 return (Status);
             }
         }
@@ -128,6 +136,10 @@ static Error_t bmUpdateHeader (UInt16 Channel, CanMessage_t *Message)
     Response.CanID = MSG_ASM_UPDATE_HEADER_ACK;
     bmSetMessageItem (&Response, State, 0, 1);
     Response.Length = 1;
+    if (Window != 0) {
+        bmSetMessageItem (&Response, bmImageTransfer.Window, 1, 1);
+        Response.Length = 2;
+    }
 
     return (canWriteMessage (Channel, &Response));
 }
@@ -142,7 +154,8 @@ static Error_t bmUpdateHeader (UInt16 Channel, CanMessage_t *Message)
  *      The message is only processed, when the update process is in the
  *      started state. The data messages implement a simple flow control
  *      mechanism to recognize double CAN frames. The function also returns an
- *      acknowledgement message to the master. This message indicates, if the
+ *      acknowledgement message to the master, for each message or for each
+ *      block of messages if a window is used. This message indicates, if the
  *      data has been successfully written.
  *
  *  \iparam  Channel = Logical channel number
@@ -162,11 +175,8 @@ static Error_t bmUpdateData (UInt16 Channel, CanMessage_t *Message, UInt8 Count)
     if (bmUpdateState != UPDATE_STATE_STARTED) {
         return (NO_ERROR);
     }
-    if (bmImageCount + Message->Length > bmImageLength) {
-        return (E_PARAMETER_OUT_OF_RANGE);
-    }
-    if ((bmImageCount / 8) % 2 != Count) {
-        return (NO_ERROR);
+    if ((Status = bmTransferAccept (&bmImageTransfer, Message->Length, Count)) <= NO_ERROR) {
+        return (Status);
     }
 
     if (Message->Length % 2 == 1) {
@@ -175,10 +185,13 @@ static Error_t bmUpdateData (UInt16 Channel, CanMessage_t *Message, UInt8 Count)
     else {
         Length = Message->Length;
     }
-    if ((Status = halStorageWrite (bmHandleFlash, bmImageOffset + bmImageCount, Message->Data, Length)) < NO_ERROR) {
+    if ((Status = halStorageWrite (bmHandleFlash, bmImageOffset + bmImageTransfer.Count,
+            Message->Data, Length)) < NO_ERROR) {
         return (Status);
     }
-    bmImageCount += Message->Length;
+    if (!bmTransferCommit (&bmImageTransfer, Message->Data, Message->Length)) {
+        return (NO_ERROR);
+    }
 
     if (Count == 0) {
         Response.CanID = MSG_ASM_UPDATE_ACK_0;
@@ -187,6 +200,11 @@ static Error_t bmUpdateData (UInt16 Channel, CanMessage_t *Message, UInt8 Count)
         Response.CanID = MSG_ASM_UPDATE_ACK_1;
     }
     Response.Length = 0;
+    if (bmImageTransfer.Window != 0) {
+        bmSetMessageItem (&Response, bmImageTransfer.Count, 0, 4);
+        bmSetMessageItem (&Response, bmTransferCrc (&bmImageTransfer), 4, 4);
+        Response.Length = 8;
+    }
     return (canWriteMessage (Channel, &Response));
 }
 
@@ -234,8 +252,9 @@ static Error_t bmUpdateData1 (UInt16 Channel, CanMessage_t *Message)
  *      This function is called, when a update trailer message is received
  *      from the master. The message contains the CRC checksum of the image.
  *      It is only processed, when the boot loader is in the started state.
- *      The function calculates the CRC checksum of the data written to flash
- *      memory. It also returns an acknowledgement message to the master.
+ *      The function compares it to the CRC checksum of the received data and
+ *      to the CRC checksum of the data written to flash memory. It also
+ *      returns an acknowledgement message to the master.
  *      This message indicates, if the update has been successful or if the
  *      calculated checksum deviates from the intended checksum. It also
  *      changes the boot loader state to initialized.
@@ -260,15 +279,20 @@ static Error_t bmUpdateTrailer (UInt16 Channel, CanMessage_t *Message)
         return (NO_ERROR);
     }
 
-    if (bmImageCount != bmImageLength) {
+    if (bmImageTransfer.Count != bmImageTransfer.Length) {
         State = 2;
     }
     else {
-        UInt32 ActualCrc;
+        UInt32 ActualCrc = bmTransferCrc (&bmImageTransfer);
         UInt32 DesiredCrc = bmGetMessageItem (Message, 0, 4);
 
-        if ((Status = bmFlashCrc (&ActualCrc, bmHandleFlash, 0, bmImageOffset + bmImageLength)) < NO_ERROR) {
-            return (Status);
+        // The running CRC only covers the received data of this transfer,
+        // the programmed image is read back before it is acknowledged
+        if (bmImageOffset != 0 || ActualCrc == DesiredCrc) {
+            if ((Status = bmFlashCrc (&ActualCrc, bmHandleFlash, 0, bmImageOffset + bmImageTransfer.Length)) <
+                    NO_ERROR) {
+                return (Status);
+            }
         }
         if (ActualCrc != DesiredCrc) {
             State = 1;
@@ -304,27 +328,18 @@ static Error_t bmUpdateTrailer (UInt16 Channel, CanMessage_t *Message)
 
 Error_t bmFlashCrc (UInt32 *Crc, Handle_t Handle, UInt32 Address, UInt32 Length)
 {
-    UInt8 Data;
+    UInt8 Data[CRC32_READ_SIZE];
     Error_t Status;
     UInt32 Crc32 = CRC32_INITIAL_VALUE;
-    UInt32 i, k;
+    UInt32 Size;
+    UInt32 i;
 
-    // Perform modulo-2 division for each byte
-    for (i=0; i < Length; i++) {
-        if ((Status = halStorageRead (Handle, Address + i, &Data, 1)) < NO_ERROR) {
+    for (i=0; i < Length; i += Size) {
+        Size = MIN(Length - i, CRC32_READ_SIZE);
+        if ((Status = halStorageRead (Handle, Address + i, Data, Size)) < NO_ERROR) {
             return Status;
         }
-        Crc32 ^= Data << (32 - 8);
-
-        // Perform modulo-2 division for each bit in byte
-        for (k=0; k < 8; k++) {
-            if (Crc32 & BIT(31)) {
-                Crc32 = (Crc32 << 1) ^ CRC32_POLYNOMIAL;
-            }
-            else {
-                Crc32 = (Crc32 << 1);
-            }
-        }
+        Crc32 = bmCrc32Update (Crc32, Data, Size);
     }
     *Crc = (Crc32 ^ MAX_UINT32);
     return NO_ERROR;
@@ -36,6 +36,7 @@
 #include "bmCommon.h"
 #include "bmError.h"
 #include "bmTime.h"
+#include "bmTransfer.h"
 #include "bmUpdate.h"
 #include "bmUtilities.h"
 #include "halCan.h"
@@ -67,9 +68,8 @@ typedef enum {
 static Handle_t blHandleLed[3]; //!< Handle for the three board LEDs
 static Handle_t blHandleFlash;  //!< Handle for the flash memory
 static blUpdateState_t blUpdateState = UPDATE_STATE_UNINITIALIZED;  //!< Update State
-static UInt32 blImageLength;    //!< Length of the firmware image
 static UInt32 blImageOffset;    //!< Offset to start within the image flash memory area
-static UInt32 blImageCount;     //!< Amount of data already programmed to flash memory
+static bmTransfer_t blImageTransfer;    //!< Flow control and CRC of the firmware transfer
 static UInt8 blFirmwareState;   //!< State of the firmware image (valid (0), invalid (1), not found (2))
 static UInt32 blSectorStart;    //!< Beginning of the firmware image area in flash
 static UInt32 blSectorSize;     //!< The size of the flash sector used by the firmware
@@ -308,14 +308,16 @@ static Error_t blUpdateModeRequest (CanMessage_t *Message)
  *  \brief   Handles update header messages
  *
  *      This function is called, when a update header message is received from
- *      the master. The message contains two parameters, the length of the
- *      firmware image and the starting offset within the target area of the
- *      flash memory. The message is only processed, when the boot loader is
- *      at least in the initialized state. The function also erases the
- *      required area in the flash memory. The function also returns an
- *      acknowledgement message to the master. This message indicates, if the
- *      firmware update is possible or if the firmware can not fit into flash.
- *      It also changes the boot loader state to started.
+ *      the master. The message contains three parameters, the length of the
+ *      firmware image, the requested window size and the starting offset
+ *      within the target area of the flash memory. The message is only
+ *      processed, when the boot loader is at least in the initialized state.
+ *      The function also erases the required area in the flash memory. The
+ *      function also returns an acknowledgement message to the master. This
+ *      message indicates, if the firmware update is possible or if the
+ *      firmware can not fit into flash. If the master requested a window, the
+ *      granted window size is added. It also changes the boot loader state to
+ *      started.
  *
  *  \iparam  Message = Received CAN message
  *
@@ -327,6 +329,8 @@ static Error_t blUpdateHeader (CanMessage_t *Message)
 {
     Error_t Status;
     UInt8 State = 0;
+    UInt8 Window;
+    UInt32 ImageLength;
     CanMessage_t Response;
 
     if (Message->Length < 8) {
@@ -336,25 +340,26 @@ static Error_t blUpdateHeader (CanMessage_t *Message)
         return (NO_ERROR);
     }
 
-    blImageLength = bmGetMessageItem (Message, 0, 4);
-    blImageOffset = bmGetMessageItem (Message, 4, 4);
-    blImageCount = 0;
+    ImageLength   = bmGetMessageItem (Message, 0, 4);
+    Window        = bmGetMessageItem (Message, 4, 1);
+    blImageOffset = bmGetMessageItem (Message, 5, 3);
+    bmTransferInit (&blImageTransfer, ImageLength, Window);
 
-    if (blSectorSize < blImageLength) {
+    if (blSectorSize < ImageLength) {
         State = 1;
     }
-    else if (blSectorSize < blImageOffset + blImageLength) {
+    else if (blSectorSize < blImageOffset + ImageLength) {
         State = 2;
     }
 
     if (State == 0) {
         if (blImageOffset == 0) {
             if ((Status = halStorageErase(blHandleFlash, blSectorStart - 2 * sizeof(UInt32),
-                    blImageLength + 2 * sizeof(UInt32))) < NO_ERROR) {
+                    ImageLength + 2 * sizeof(UInt32))) < NO_ERROR) {
                 return (Status);
             }
             if ((Status = halStorageWrite (blHandleFlash, blSectorStart - 2 * sizeof(UInt32),
-                    &blImageLength, sizeof(UInt32))) < NO_ERROR) {
+                    &ImageLength, sizeof(UInt32))) < NO_ERROR) {
                 return (Status);
             }
         }
@@ -368,6 +373,10 @@ static Error_t blUpdateHeader (CanMessage_t *Message)
     Response.CanID = MSG_ASM_UPDATE_HEADER_ACK;
     bmSetMessageItem (&Response, State, 0, 1);
     Response.Length = 1;
+    if (Window != 0) {
+        bmSetMessageItem (&Response, blImageTransfer.Window, 1, 1);
+        Response.Length = 2;
+    }
 
     return (canWriteMessage (BASEMODULE_CHANNEL, &Response));
 }
@@ -382,7 +391,8 @@ static Error_t blUpdateHeader (CanMessage_t *Message)
  *      The message is only processed, when the boot loader is in the started
  *      state. The data messages implement a simple flow control mechanism to
  *      recognize double CAN frames. The function also returns an
- *      acknowledgement message to the master. This message indicates, if the
+ *      acknowledgement message to the master, for each message or for each
+ *      block of messages if a window is used. This message indicates, if the
  *      data has been successfully written.
  *
  *  \iparam  Message = Received CAN message
@@ -401,11 +411,8 @@ static Error_t blUpdateData (CanMessage_t *Message, UInt8 Count)
     if (blUpdateState != UPDATE_STATE_STARTED) {
         return (NO_ERROR);
     }
-    if (blImageCount + Message->Length > blImageLength) {
-        return (E_PARAMETER_OUT_OF_RANGE);
-    }
-    if ((blImageCount / 8) % 2 != Count) {
-        return (NO_ERROR);
+    if ((Status = bmTransferAccept (&blImageTransfer, Message->Length, Count)) <= NO_ERROR) {
+        return (Status);
     }
 
     if (Message->Length % 2 == 1) {
@@ -414,11 +421,13 @@ static Error_t blUpdateData (CanMessage_t *Message, UInt8 Count)
     else {
         Length = Message->Length;
     }
-    if ((Status = halStorageWrite (blHandleFlash, blSectorStart + blImageOffset + blImageCount,
+    if ((Status = halStorageWrite (blHandleFlash, blSectorStart + blImageOffset + blImageTransfer.Count,
             Message->Data, Length)) < NO_ERROR) {
         return (Status);
     }
-    blImageCount += Message->Length;
+    if (!bmTransferCommit (&blImageTransfer, Message->Data, Message->Length)) {
+        return (NO_ERROR);
+    }
 
     if (Count == 0) {
         Response.CanID = MSG_ASM_UPDATE_ACK_0;
@@ -427,6 +436,11 @@ static Error_t blUpdateData (CanMessage_t *Message, UInt8 Count)
         Response.CanID = MSG_ASM_UPDATE_ACK_1;
     }
     Response.Length = 0;
+    if (blImageTransfer.Window != 0) {
+        bmSetMessageItem (&Response, blImageTransfer.Count, 0, 4);
+        bmSetMessageItem (&Response, bmTransferCrc (&blImageTransfer), 4, 4);
+        Response.Length = 8;
+    }
     return (canWriteMessage (BASEMODULE_CHANNEL, &Response));
 }
 
@@ -438,11 +452,13 @@ static Error_t blUpdateData (CanMessage_t *Message, UInt8 Count)
  *      This function is called, when a update trailer message is received
  *      from the master. The message contains the CRC checksum of the firmware
  *      image. It is only processed, when the boot loader is in the started
- *      state. The function calculates the CRC checksum of the data written to
- *      flash memory. It also returns an acknowledgement message to the
- *      master. This message indicates, if the firmware update has been
- *      successful or if the calculated checksum deviates from the intended
- *      checksum. It also changes the boot loader state to uninitialized.
+ *      state. The function compares it to the CRC checksum of the received
+ *      data and to the CRC checksum of the data written to flash memory. The
+ *      checksum is only stored, if both match. It also returns an
+ *      acknowledgement message to the master. This message indicates, if the
+ *      firmware update has been successful or if the calculated checksum
+ *      deviates from the intended checksum. It also changes the boot loader
+ *      state to uninitialized.
  *
  *  \iparam  Message = Received CAN message
  *
@@ -463,17 +479,21 @@ static Error_t blUpdateTrailer (CanMessage_t *Message)
         return (NO_ERROR);
     }
 
-    if (blImageCount != blImageLength) {
+    if (blImageTransfer.Count != blImageTransfer.Length) {
         State = 2;
         blFirmwareState = 1;
     }
     else {
-        UInt32 ActualCrc;
+        UInt32 ActualCrc = bmTransferCrc (&blImageTransfer);
         UInt32 DesiredCrc = bmGetMessageItem (Message, 0, 4);
 
-        if ((Status = bmFlashCrc (&ActualCrc, blHandleFlash, blSectorStart, blImageOffset + blImageLength)) <
-                NO_ERROR) {
-            return (Status);
+        // The running CRC only covers the received data of this transfer,
+        // the programmed image is read back before its checksum is stored
+        if (blImageOffset != 0 || ActualCrc == DesiredCrc) {
+            if ((Status = bmFlashCrc (&ActualCrc, blHandleFlash, blSectorStart,
+                    blImageOffset + blImageTransfer.Length)) < NO_ERROR) {
+                return (Status);
+            }
         }
         if (ActualCrc != DesiredCrc) {
             State = 1;
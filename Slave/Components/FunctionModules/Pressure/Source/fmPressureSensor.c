@@ -31,8 +31,6 @@
 //****************************************************************************/
 // Private Constants and Macros 
 //****************************************************************************/
-#define SWAP(X,Y) {X=X^Y;Y=X^Y;X=X^Y;}    //!< Swap the value of two variables
-
 #define TEMP_SENSOR_MAX 120 //!< Maximal sensor pressure in degree Celsius 
 
 #define PRESS_SENSOR_VOLTAGE_LOW     500  //!< The lowest voltage allowed for pressure sensor 
@@ -47,6 +45,9 @@
 // Private Variables 
 //****************************************************************************/
 
+//! Filter applied to the analog input of a sensor (median of 3 samples)
+static const bmFilter_t pressSensorFilter = { 3, FILTER_MEDIAN };
+
 //****************************************************************************/
 // Private Function Prototypes 
 //****************************************************************************/
@@ -73,40 +74,10 @@ Error_t pressSensorRead (Handle_t Handle, PressSensorType_t Type, UInt16 Compens
 {
     Error_t Error;
     Int16 AdcValue;
-    Int16 AdcValue1, AdcValue2, AdcValue3;
        
-#if 0
-    if ((Error = halAnalogRead (Handle, &AdcValue)) < 0) {
-        return (Error);
-    }
-#endif
- 
-#if 1    
-    // Median filtering
-    if ((Error = halAnalogRead (Handle, &AdcValue1)) < 0) {
-        return (Error);
-    }
-    if ((Error = halAnalogRead (Handle, &AdcValue2)) < 0) {
+    if ((Error = bmReadFiltered (halAnalogRead, Handle, &pressSensorFilter, &AdcValue)) < 0) {
         return (Error);
     }
-    if ((Error = halAnalogRead (Handle, &AdcValue3)) < 0) {
-        return (Error);
-    }
-
-    if (AdcValue1>AdcValue2) {
-        SWAP(AdcValue1,AdcValue2);
-    }
-    if (AdcValue1>AdcValue3) {
-        SWAP(AdcValue1,AdcValue3);
-    }
-    if (AdcValue2>AdcValue3) {
-        SWAP(AdcValue2,AdcValue3);
-    }
-    
-    AdcValue = AdcValue2;
-    
-    //printf("AD:%d\n", AdcValue);
-#endif
     
     // Voltage: 1-6V ==> 0.5-3V
     //*Pressure = 103.42-40.944*(6-AdcValue*2);
@@ -98,11 +98,22 @@ typedef struct {
 } smParamSwitch_t;
 
 
+//! constants for the division free step calculation of the ISR, prepared with the parameter set
+typedef struct {
+    Bool                    Enabled;        //!< set if ISR can use the division free calculation for this set
+    Int32                   Reciprocal;     //!< reciprocal of step width * ISR_TIMEBASE, scaled by 2^ISR_RECIPROCAL_SHIFT
+    Int32                   StartInterval;  //!< step interval (in usec) at start of the sets first phase
+} smStepCalc_t;
+
+
 //! data for movement parameter set
 typedef struct {
 //! parameters for each single phase
     smPhaseParam_t          Ph[NUM_OF_MOTION_PHASES];
 
+//! constants for the division free step calculation
+    smStepCalc_t            StepCalc;
+
 //! step width used to increase step count at each interrupt (in micro-steps)
     Int8                    dSteps;
 
@@ -137,6 +148,15 @@ typedef struct {
 } smNominalData_t;
 
 
+//! state of the division free speed calculation (digital differential analyzer) within actual phase
+typedef struct {
+    Int64   v;          //!< velocity, in microsteps/s scaled by 2^ISR_DDA_SHIFT
+    Int64   a;          //!< acceleration, in microsteps/s per usec scaled by 2^ISR_DDA_SHIFT
+    Int64   j;          //!< jerk, in microsteps/s per usec^2 scaled by 2^(ISR_DDA_SHIFT+ISR_DDA_JERK_SHIFT)
+    Int64   t;          //!< phase time (in usec) up to which velocity is calculated
+} smStepDda_t;
+
+
 //! CCR data
 typedef struct {
     UInt16  Unit;       //!< Capture compare unit no
@@ -179,6 +199,7 @@ typedef struct {
 #else
     Int32                   dt;                 //!< interval time for next step
 #endif
+    smStepDda_t             Dda;                //!< division free speed calculation within actual phase
 
 //! motors motion state, idle or moving to target speed/position
     volatile smMotionState_t    State;
@@ -223,6 +244,9 @@ void smInitMotion (Motion_t *Motion, UInt16 Instance);
 //! determine next phase
 smPhase_t smNextPhase(smPhaseParam_t *Param, Int8 Phase);
 
+//! restart speed calculation of ISR at begin of a phase
+void smStartStepDda (Motion_t *Motion);
+
 //! move to target position
 Error_t smPositionRequest (UInt16 Instance, Int32 Position, UInt8 ProfileIndex);
 
@@ -40,6 +40,21 @@
 #define ISR_ENCODER_TIME_LIMIT              100
 
 
+// The ISR calculates the speed of the ramp phases incrementally (digital differential analyzer)
+// and the interval to the next step from the previous one by Newton iteration of the reciprocal.
+// Both need only multiplications, shifts and additions. The velocity and acceleration are scaled
+// by 2^ISR_DDA_SHIFT, the jerk by another 2^ISR_DDA_JERK_SHIFT.
+#define ISR_DDA_SHIFT                       32      //!< fraction bits of DDA velocity and acceleration
+#define ISR_DDA_JERK_SHIFT                  20      //!< additional fraction bits of DDA jerk
+#define ISR_DDA_ACC_FACTOR                  281474977LL     //!< 2^(ISR_DDA_SHIFT+16) / ISR_TIMEBASE
+#define ISR_DDA_JERK_FACTOR                 295147905LL     //!< 2^(ISR_DDA_SHIFT+ISR_DDA_JERK_SHIFT+16) / ISR_TIMEBASE^2
+#define ISR_DDA_LIMIT                       (1L << 29)      //!< max. acceleration/jerk value which can be used for DDA
+#define ISR_DDA_MAX_INTERVAL                (1L << 20)      //!< max. step interval (in sec) which can be used for DDA
+
+#define ISR_RECIPROCAL_SHIFT                40      //!< fraction bits of reciprocal step width
+#define ISR_RECIPROCAL_LOOPS                8       //!< max. iterations for step interval, then division is used
+
+
 //****************************************************************************/
 // Public Function Prototypes
 //****************************************************************************/
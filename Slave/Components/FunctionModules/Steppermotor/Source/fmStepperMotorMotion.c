@@ -494,6 +494,47 @@ void smSetupMoveParam (Int32 Distance, smProfile_t *Profile, smParamSet_t *Param
 }
 
 
+/*****************************************************************************/
+/*!
+ *  \brief   Setup constants for the division free step calculation
+ *
+ *      The ISR calculates velocity of ramp phases and interval to next step
+ *      without division (\sa smMotionISR). The reciprocal of the step width
+ *      and the step interval at start of the first phase are calculated here.
+ *
+ *      The division free calculation is only enabled for the parameter set,
+ *      if the scaled values of all used phases fit into their data types.
+ *      Otherwise the ISR uses the direct calculation with divisions.
+ *
+ *  \iparam  Param      = Pointer to parameter set
+ *  \iparam  StartPhase = first phase of parameter set which will be used
+ *
+ *****************************************************************************/
+void smSetupStepCalc (smParamSet_t *Param, smPhase_t StartPhase) {
+
+    Int32           Distance = Param->dSteps * ISR_TIMEBASE;            // step width scaled by time base
+    Int32           vMin = Distance / ISR_DDA_MAX_INTERVAL;             // velocity below this is too slow
+    smPhaseParam_t  *Ph;
+    Int8            ph;
+
+    Param->StepCalc.Reciprocal = (1LL << ISR_RECIPROCAL_SHIFT) / Distance;
+    Param->StepCalc.StartInterval = Distance / Param->Ph[StartPhase].v;
+
+    Param->StepCalc.Enabled = TRUE;
+    for (ph = StartPhase; ph < NUM_OF_MOTION_PHASES; ph++) {
+        Ph = &Param->Ph[ph];
+        if (0 != Ph->dt) {
+            if (  (Ph->a >= ISR_DDA_LIMIT) || (Ph->a <= -ISR_DDA_LIMIT)
+                ||(Ph->j >= ISR_DDA_LIMIT) || (Ph->j <= -ISR_DDA_LIMIT)
+                ||(Ph->v >= ISR_DDA_LIMIT) || (Ph->vE >= ISR_DDA_LIMIT)
+                ||(Ph->v <= vMin) || (Ph->vE <= vMin)) {
+                Param->StepCalc.Enabled = FALSE;
+            }
+        }
+    }
+}
+
+
 /*****************************************************************************/
 /*!
  *  \brief   Request to start movement to target position
@@ -565,12 +606,15 @@ Error_t smNewPositionRequest (smData_t *Data, Int32 Position, Int8 ProfileIndex)
         Data->Motion.Phase = smNextPhase(Data->Motion.Param[Data->Motion.ActSet].Ph, Data->Motion.Phase);
     }
     PtrParam->OffsetPhase = Data->Motion.Phase;
+    smSetupStepCalc(PtrParam, Data->Motion.Phase);
 
     Data->Motion.s = 0;
     Data->Motion.v0 = PtrParam->Ph[Data->Motion.Phase].v;
     Data->Motion.a0 = PtrParam->Ph[Data->Motion.Phase].a;
     Data->Motion.j = PtrParam->Ph[Data->Motion.Phase].j;
     Data->Motion.t = 0;
+    Data->Motion.dt = PtrParam->StepCalc.StartInterval;
+    smStartStepDda(&Data->Motion);
 
     Data->Motion.Nominal.s = 0;
     Data->Motion.Nominal.v = Data->Motion.v0;
@@ -816,6 +860,7 @@ UInt32 smSetupNewSpeedParamSet (Int32 Speed, smProfile_t *Profile, smParamSet_t
     if (0 == NewParam->Ph[Param->SwitchSet.NewPhase].dt) {
         Param->SwitchSet.NewPhase = smNextPhase(NewParam->Ph, Param->SwitchSet.NewPhase);
     }
+    smSetupStepCalc(NewParam, Param->SwitchSet.NewPhase);
 
     return Distance;
 }
@@ -1099,12 +1144,15 @@ Error_t smNewSpeedRequest (smData_t *Data, Int32 Speed, Int8 ProfileIndex) {
         Data->Motion.Phase = smNextPhase(Param->Ph, Data->Motion.Phase);
     }
     Param->OffsetPhase = Data->Motion.Phase;
+    smSetupStepCalc(Param, Data->Motion.Phase);
 
     Data->Motion.s = 0;
     Data->Motion.v0 = Param->Ph[Data->Motion.Phase].v;
     Data->Motion.a0 = Param->Ph[Data->Motion.Phase].a;
     Data->Motion.j = Param->Ph[Data->Motion.Phase].j;
     Data->Motion.t = 0;
+    Data->Motion.dt = Param->StepCalc.StartInterval;
+    smStartStepDda(&Data->Motion);
 
     Data->Motion.Nominal.s = 0;
     Data->Motion.Nominal.v = Data->Motion.v0;
@@ -124,6 +124,103 @@ extern FILE* posLog;
 #endif
 
 
+/******************************************************************************/
+/*! 
+ *  \brief  Restart speed calculation at begin of a phase
+ *
+ *      The digital differential analyzer used for the speed calculation of
+ *      the ramp phases is set to start velocity, start acceleration and jerk
+ *      of actual phase (Motion->v0, a0, j) at phase time 0. 
+ * 
+ *  \iparam  Motion = pointer to motion data
+ * 
+ ******************************************************************************/
+void smStartStepDda (Motion_t *Motion) {
+
+    Motion->Dda.v = Motion->v0 << ISR_DDA_SHIFT;
+    Motion->Dda.a = (Motion->a0 * ISR_DDA_ACC_FACTOR) >> 16;
+    Motion->Dda.j = (Motion->j * ISR_DDA_JERK_FACTOR) >> 16;
+    Motion->Dda.t = 0;
+}
+
+
+/******************************************************************************/
+/*! 
+ *  \brief  Calculate velocity of ramp phase without division
+ *
+ *      The velocity v0 + a0*t + j*t^2/2 of actual phase is advanced from the
+ *      phase time of the last calculation to the actual phase time.
+ *      Velocity and acceleration are integrated exactly over this time,
+ *      which needs only multiplications, shifts and additions. Like the
+ *      direct calculation, the result is rounded towards the start velocity.
+ * 
+ *  \iparam  Motion = pointer to motion data
+ *
+ *  \return  velocity (in microsteps/s)
+ * 
+ ******************************************************************************/
+static inline Int64 smStepDdaVelocity (Motion_t *Motion) {
+
+    smStepDda_t *Dda = &Motion->Dda;
+    Int64       dt = Motion->t - Dda->t;                    // time since last calculation
+    Int64       da = (Dda->j * dt) >> ISR_DDA_JERK_SHIFT;   // change of acceleration within this time
+
+    Dda->v += Dda->a * dt + ((da * dt) >> 1);
+    Dda->a += da;
+    Dda->t  = Motion->t;
+
+    if (Motion->Phase > PH_4_VEL_CONST) {                  // decelerating
+        return (Dda->v + (1LL << ISR_DDA_SHIFT) - 1) >> ISR_DDA_SHIFT;
+    }
+    return Dda->v >> ISR_DDA_SHIFT;
+}
+
+
+/******************************************************************************/
+/*! 
+ *  \brief  Calculate step interval without division
+ *
+ *      The interval to perform the next step is step width * ISR_TIMEBASE
+ *      divided by velocity. As velocity changes only slightly from step to
+ *      step, the previous interval is a good estimation of the quotient. It
+ *      is improved by Newton iteration, using the reciprocal of the step width
+ *      prepared with the parameter set, until it's the exact (truncated)
+ *      quotient. A division is only done if the estimation is out of range,
+ *      e.g. after a parameter set switch to another step width.
+ * 
+ *  \iparam  Interval = previous step interval (in s)
+ *  \iparam  Velocity = actual velocity (in microsteps/s)
+ *  \iparam  Param    = pointer to actual parameter set
+ *
+ *  \return  step interval (in s)
+ * 
+ ******************************************************************************/
+static inline Int32 smStepInterval (Int32 Interval, Int64 Velocity, smParamSet_t *Param) {
+
+    Int64   Distance = Param->dSteps * ISR_TIMEBASE;    // step width scaled by time base
+    Int64   Rest;
+    Int64   Change;
+    UInt8   Loops;
+
+    for (Loops = 0; Loops < ISR_RECIPROCAL_LOOPS; Loops++) {
+        Rest = Distance - Interval * Velocity;
+        if ((Rest >= 0) && (Rest < Velocity)) {
+            return Interval;                            // interval is the exact quotient
+        }
+        if ((Interval <= 0) || (Rest <= -Distance)) {
+            break;                                      // estimation is out of convergence range
+        }
+        Change = (Rest * Interval * Param->StepCalc.Reciprocal) >> ISR_RECIPROCAL_SHIFT;
+        if (0 == Change) {
+            Change = 1;                                 // reciprocal is rounded down, so rest was positive
+        }
+        Interval += Change;
+    }
+
+    return Distance / Velocity;
+}
+
+
 /******************************************************************************/
 /*! 
  *  \brief  Stepper motor interrupt service routine
@@ -195,7 +292,12 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
     // timer interval is calculated from actual speed
     // each tick has a period from 1.000.000.000 nano seconds per second / 72.000.000 tick per second
     // the prescaler was set to 6
-    Motion->dt = Param->dSteps * ISR_TIMEBASE / Motion->Nominal.v;  // elapsed s to perform step
+    if (Param->StepCalc.Enabled) {
+        Motion->dt = smStepInterval(Motion->dt, Motion->Nominal.v, Param);  // elapsed s to perform step
+    }
+    else {
+        Motion->dt = Param->dSteps * ISR_TIMEBASE / Motion->Nominal.v;      // elapsed s to perform step
+    }
     CCROffset = (Motion->dt * 12);                                  // processor clock divided by pre-scaler = 72Mhz / 6 = 12 
 
     // The current CCR value has been stored
@@ -552,8 +654,9 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
                             Motion->s = 0;
 
                             Motion->j = Param->Ph[Motion->Phase].j;
-                            Motion->t = Param->dSteps * ISR_TIMEBASE / Motion->Nominal.v;   // elapsed s
+                            Motion->t = Param->StepCalc.StartInterval;  // elapsed s (= dSteps * ISR_TIMEBASE / Nominal.v)
                             //todo is it ok to use "Motion->t = Motion->dt;" instead of above line ?
+                            smStartStepDda(Motion);
 
                             // update direction change counter (life cycle data)
                             if ((Param->CCWRotDir) != (Motor->LifeCycle.DirChanges.CCWRotDir)) {
@@ -610,6 +713,7 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
                             Motion->j = Param->Ph[Motion->Phase].j;
             //              Motion->t = Param->dSteps * ISR_TIMEBASE / Motion->Nominal.v;    // elapsed s
                             Motion->t = Motion->dt;   // elapsed s
+                            smStartStepDda(Motion);
 
                             Motion->s = 0;
                         }
@@ -682,8 +786,13 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
         break;
 
     case PH_1_ACC_JERK_UP:
-        Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
-//      Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        if (Param->StepCalc.Enabled) {
+            Motion->Nominal.v = smStepDdaVelocity(Motion);
+        }
+        else {
+            Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
+//          Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        }
         if (Motion->Nominal.v > Param->Ph[PH_1_ACC_JERK_UP].vE) {
             Motion->Nominal.v = Param->Ph[PH_1_ACC_JERK_UP].vE;
         }
@@ -696,15 +805,25 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
         break;
 
     case PH_2_ACC_CONST:
-        Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE;
+        if (Param->StepCalc.Enabled) {
+            Motion->Nominal.v = smStepDdaVelocity(Motion);
+        }
+        else {
+            Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE;
+        }
         if (Motion->Nominal.v > Param->Ph[PH_2_ACC_CONST].vE) {
             Motion->Nominal.v = Param->Ph[PH_2_ACC_CONST].vE;
         }
         break;
 
     case PH_3_ACC_JERK_DOWN:
-        Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
-//      Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        if (Param->StepCalc.Enabled) {
+            Motion->Nominal.v = smStepDdaVelocity(Motion);
+        }
+        else {
+            Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
+//          Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        }
         if (Motion->Nominal.v > Param->Ph[PH_3_ACC_JERK_DOWN].vE) {
             Motion->Nominal.v = Param->Ph[PH_3_ACC_JERK_DOWN].vE;
         }
@@ -726,8 +845,13 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
         break;
 
     case PH_5_DEC_JERK_UP:
-        Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
-//      Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        if (Param->StepCalc.Enabled) {
+            Motion->Nominal.v = smStepDdaVelocity(Motion);
+        }
+        else {
+            Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
+//          Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        }
         if (Motion->Nominal.v < Param->Ph[PH_5_DEC_JERK_UP].vE) {
             Motion->Nominal.v = Param->Ph[PH_5_DEC_JERK_UP].vE;
         }
@@ -740,15 +864,25 @@ void smMotionISR (UInt32 UserTag, UInt32 IntrFlags) {
         break;
 
     case PH_6_DEC_CONST:
-        Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE;
+        if (Param->StepCalc.Enabled) {
+            Motion->Nominal.v = smStepDdaVelocity(Motion);
+        }
+        else {
+            Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE;
+        }
         if (Motion->Nominal.v < Param->Ph[PH_6_DEC_CONST].vE) {
             Motion->Nominal.v = Param->Ph[PH_6_DEC_CONST].vE;
         }
         break;
 
     case PH_7_DEC_JERK_DOWN:
-        Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
-//      Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        if (Param->StepCalc.Enabled) {
+            Motion->Nominal.v = smStepDdaVelocity(Motion);
+        }
+        else {
+            Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2000000000000;
+//          Motion->Nominal.v = Motion->v0 + Motion->a0*Motion->t/ISR_TIMEBASE + Motion->j*Motion->t*Motion->t/2/ISR_TIMEBASE/ISR_TIMEBASE;
+        }
         if (Motion->Nominal.v < Param->Ph[PH_7_DEC_JERK_DOWN].vE) {
             Motion->Nominal.v = Param->Ph[PH_7_DEC_JERK_DOWN].vE;
         }
@@ -29,6 +29,8 @@
 // Public Constants and Macros 
 //****************************************************************************/
 
+#define TEMP_SENSOR_MAX 200           //!< Maximal sensor temperature in degree Celsius 
+
 //****************************************************************************/
 // Public Type Definitions 
 //****************************************************************************/
@@ -48,6 +50,8 @@ typedef enum {
 //****************************************************************************/
 
 Error_t tempSensorRead (Handle_t Handle, TempSensorType_t Type, UInt16 ColdJunction, UInt16* Temperature);
+Error_t tempSensorConvert (TempSensorType_t Type, Int32 AdcValue, UInt16 ColdJunction, UInt16* Temperature);
+const bmLinearTable_t* tempSensorGetTable (TempSensorType_t Type);
 
 //****************************************************************************/
 
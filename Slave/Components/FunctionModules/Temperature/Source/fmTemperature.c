@@ -125,6 +125,9 @@ typedef struct {
     UInt8   TempArrayIndex;      //!< Current index of temp. array for writing
     UInt8   SamplesPerSec;       //!< Number of temperature samples per second
     UInt32* SensorErrTimestamp;  //!< Time stamp for trigeering sensor error reporting
+
+    UInt16  TelemetryInterval;   //!< Interval of the sensor telemetry in ms, 0 = off
+    UInt32  TelemetryTimestamp;  //!< Time the sensor telemetry was sent last
     
 } InstanceData_t;
 
@@ -177,6 +180,7 @@ static Error_t tempReadOptions (InstanceData_t *Data, UInt16 ModuleID, UInt16 In
 static Error_t tempDeviceAlloc (InstanceData_t *Data);
 static Error_t tempHandleOpen  (InstanceData_t *Data, UInt16 Instance);
 static Error_t tempNotifySlope (InstanceData_t *Data, UInt8 TempChangeDir);
+static Error_t tempNotifySensors (InstanceData_t *Data);
 
 static Error_t tempSetTemperature         (UInt16 Channel, CanMessage_t* Message);
 static Error_t tempSetFanWatchdog         (UInt16 Channel, CanMessage_t* Message);
@@ -239,6 +243,7 @@ static Error_t tempModuleControl (UInt16 Instance, bmModuleControlID_t ControlID
 
         case MODULE_CONTROL_RESET:
             Data->Flags &= ~MODE_MODULE_ENABLE;
+            Data->TelemetryInterval = 0;
             break;
                                 
         case MODULE_CONTROL_FLUSH_DATA:
@@ -395,7 +400,12 @@ static Error_t tempModuleTask (UInt16 Instance)
                 Data->Flags &= ~(MODE_MODULE_ENABLE);
                 return ((Error_t) Data->ModuleState);
             }
-            
+
+            // Push the fresh samples, if subscribed by the master
+            Error = tempNotifySensors(Data);
+            if (Error < NO_ERROR) {
+                return (Error);
+            }
         }              
     
     }
@@ -1452,6 +1462,11 @@ static Error_t tempGetHeaterTime (UInt16 Channel, CanMessage_t* Message)
  *      - Number of the temperature sensor
  *      - Temperature from the sensor (in hundredth of degree Celsius)
  *
+ *      If the message contains a telemetry interval in milliseconds, the
+ *      master subscribes to the temperatures of all sensors instead. They
+ *      are then sent after the sampling of the sensors, at most once per
+ *      interval. An interval of 0 ends the subscription.
+ *
  *  \iparam  Channel = Logical channel number
  *  \iparam  Message = Received CAN message
  *
@@ -1466,6 +1481,11 @@ static Error_t tempGetServiceSensor (UInt16 Channel, CanMessage_t* Message)
 
     InstanceData_t* Data = &DataTable[bmGetInstance(Channel)];
 
+    if (Message->Length == 3) {
+        Data->TelemetryInterval = bmGetMessageItem(Message, 1, 2);
+        Data->TelemetryTimestamp = bmGetTime() - Data->TelemetryInterval;
+        return (NO_ERROR);
+    }
     if (Message->Length == 1) {
         Number = bmGetMessageItem(Message, 0, 1);
         if(Number < Data->NumberSensors) {
@@ -1481,6 +1501,51 @@ static Error_t tempGetServiceSensor (UInt16 Channel, CanMessage_t* Message)
 }
 
 
+/*****************************************************************************/
+/*!
+ *  \brief   Sends the sensor telemetry to the master
+ *
+ *      This function is called after each sampling of the sensors. If the
+ *      master subscribed to the sensor telemetry and the telemetry interval
+ *      expired, the temperatures of all sensors are sent to the master, each
+ *      in a service sensor response message. So the master always has recent
+ *      temperatures without requesting them.
+ *
+ *  \iparam  Data = Pointer to the instance data
+ *
+ *  \return  NO_ERROR or (negative) error code
+ *
+ ****************************************************************************/
+
+static Error_t tempNotifySensors (InstanceData_t *Data)
+{
+    CanMessage_t Message;
+    Error_t Error;
+    UInt8 i;
+
+    if (Data->TelemetryInterval == 0) {
+        return (NO_ERROR);
+    }
+    if (bmTimeExpired (Data->TelemetryTimestamp) < Data->TelemetryInterval) {
+        return (NO_ERROR);
+    }
+    Data->TelemetryTimestamp = bmGetTime();
+
+    Message.CanID = MSG_TEMP_RESP_SERVICE_SENSOR;
+    Message.Length = 3;
+    for (i = 0; i < Data->NumberSensors; i++) {
+        bmSetMessageItem (&Message, i, 0, 1);
+        bmSetMessageItem (&Message, Data->ServiceTemp[i], 1, 2);
+
+        Error = canWriteMessage(Data->Channel, &Message);
+        if (Error < NO_ERROR) {
+            return (Error);
+        }
+    }
+    return (NO_ERROR);
+}
+
+
 /*****************************************************************************/
 /*!
  *  \brief   Requests the speed of a single ventilation fan
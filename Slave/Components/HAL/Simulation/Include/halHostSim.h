@@ -0,0 +1,59 @@
+/****************************************************************************/
+/*! \file halHostSim.h
+ *
+ *  \brief  Host based simulation of flash memory and CAN bus timing
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module implements the logical memory functions of the HAL on
+ *       the host, using RAM as flash memory. It also provides a timing model
+ *       of the flash memory and the CAN bus, which allows to run the base
+ *       module protocols in unit tests on a development host and to measure
+ *       the simulated throughput.
+ *
+ *       The simulated memories are addressed by the handle returned from
+ *       simFlashOpen, the device ID of halStorageOpen is not used.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ */
+/****************************************************************************/
+
+#ifndef HAL_HOSTSIM_H
+#define HAL_HOSTSIM_H
+
+//****************************************************************************/
+// Public Constants and Macros
+//****************************************************************************/
+
+#define SIM_MAX_FLASH           8         //!< Max. number of simulated memories
+#define SIM_FLASH_ERASED        0xFF      //!< Value of erased flash memory
+#define SIM_FLASH_WRITE_TIME    52        //!< Time to program a half word (us)
+#define SIM_CAN_BITRATE         1000000   //!< Simulated CAN bit rate (bit/s)
+
+//****************************************************************************/
+// Public Function Prototypes
+//****************************************************************************/
+
+Handle_t simFlashOpen  (UInt32 Size);
+void     simFlashClose (void);
+UInt8   *simFlashData  (Handle_t Handle);
+UInt32   simFlashTime  (Handle_t Handle);
+UInt32   simCanFrameTime (UInt8 Length);
+
+Error_t halStorageRead  (Handle_t Handle, UInt32 Address, void *Buffer, UInt32 Size);
+Error_t halStorageWrite (Handle_t Handle, UInt32 Address, void *Buffer, UInt32 Size);
+Error_t halStorageErase (Handle_t Handle, UInt32 Address, UInt32 Size);
+UInt32  halStorageSize  (Handle_t Handle);
+
+//****************************************************************************/
+
+#endif /*HAL_HOSTSIM_H*/
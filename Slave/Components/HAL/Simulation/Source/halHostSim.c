@@ -0,0 +1,292 @@
+/****************************************************************************/
+/*! \file halHostSim.c
+ *
+ *  \brief  Host based simulation of flash memory and CAN bus timing
+ *
+ *  $Version: $ 0.1
+ *  $Date:    $ 17.10.2026
+ *
+ *  \b Description:
+ *
+ *       This module implements the logical memory functions of the HAL on
+ *       the host, using RAM as flash memory. Like the real flash memory, the
+ *       simulated memory can only be programmed after it was erased, and it
+ *       is programmed in half words. The time needed to program the memory
+ *       is accumulated, so a test can add it to its simulated time.
+ *
+ *       The CAN frame time is calculated for standard frames, including the
+ *       worst case of bit stuffing.
+ *
+ *  \b Company:
+ *
+ *       Leica Biosystems Nussloch GmbH.
+ *
+ *  (C) Copyright 2010 by Leica Biosystems Nussloch GmbH. All rights reserved.
+ *  This is unpublished proprietary source code of Leica. The copyright notice
+ *  does not evidence any actual or intended publication.
+ */
+/****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "Global.h"
+#include "halError.h"
+#include "halHostSim.h"
+
+
+//****************************************************************************/
+// Private Constants and Macros
+//****************************************************************************/
+
+#define CAN_FRAME_OVERHEAD      47    //!< Bits of a standard frame without data
+#define CAN_STUFFED_BITS        34    //!< Bits of a frame subject to stuffing
+
+//****************************************************************************/
+// Private Type Definitions
+//****************************************************************************/
+
+//! Simulated flash memory
+typedef struct {
+    UInt8 *Data;        //!< Memory content
+    UInt32 Size;        //!< Memory size in bytes
+    UInt32 Time;        //!< Accumulated programming time (us)
+} simFlash_t;
+
+//****************************************************************************/
+// Private Variables
+//****************************************************************************/
+
+static simFlash_t simFlash[SIM_MAX_FLASH];  //!< Simulated memories
+static UInt32 simFlashCount = 0;            //!< Number of simulated memories
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Creates a simulated flash memory
+ *
+ *      Allocates a memory of the requested size, which is initially erased.
+ *
+ *  \iparam  Size = Size of the memory in bytes
+ *
+ *  \return  Handle of the memory or (negative) error code
+ *
+ ****************************************************************************/
+
+Handle_t simFlashOpen (UInt32 Size)
+{
+    simFlash_t *Flash;
+
+    if (simFlashCount >= SIM_MAX_FLASH) {
+        return (E_DEVICE_HANDLE_INVALID);
+    }
+    Flash = &simFlash[simFlashCount];
+
+    if ((Flash->Data = malloc(Size)) == NULL) {
+        return (E_DEVICE_HANDLE_INVALID);
+    }
+    memset (Flash->Data, SIM_FLASH_ERASED, Size);
+    Flash->Size = Size;
+    Flash->Time = 0;
+
+    return (simFlashCount++);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Deletes all simulated flash memories
+ *
+ ****************************************************************************/
+
+void simFlashClose (void)
+{
+    UInt32 i;
+
+    for (i=0; i < simFlashCount; i++) {
+        free (simFlash[i].Data);
+        simFlash[i].Data = NULL;
+    }
+    simFlashCount = 0;
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Returns the content of a simulated flash memory
+ *
+ *  \iparam  Handle = Handle of the memory
+ *
+ *  \return  Pointer to the memory content or NULL
+ *
+ ****************************************************************************/
+
+UInt8 *simFlashData (Handle_t Handle)
+{
+    if (Handle < 0 || (UInt32)Handle >= simFlashCount) {
+        return (NULL);
+    }
+    return (simFlash[Handle].Data);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Returns and resets the accumulated programming time
+ *
+ *  \iparam  Handle = Handle of the memory
+ *
+ *  \return  Programming time since the last call (us)
+ *
+ ****************************************************************************/
+
+UInt32 simFlashTime (Handle_t Handle)
+{
+    UInt32 Time;
+
+    if (Handle < 0 || (UInt32)Handle >= simFlashCount) {
+        return (0);
+    }
+    Time = simFlash[Handle].Time;
+    simFlash[Handle].Time = 0;
+
+    return (Time);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Returns the transmission time of a CAN frame
+ *
+ *      The time includes the interframe space and the worst case number of
+ *      stuff bits.
+ *
+ *  \iparam  Length = Number of data bytes of the frame
+ *
+ *  \return  Transmission time (ns)
+ *
+ ****************************************************************************/
+
+UInt32 simCanFrameTime (UInt8 Length)
+{
+    UInt32 Bits = CAN_FRAME_OVERHEAD + 8 * Length + (CAN_STUFFED_BITS + 8 * Length - 1) / 4;
+
+    return (Bits * (1000000000 / SIM_CAN_BITRATE));
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Reads from a simulated flash memory
+ *
+ *  \iparam  Handle = Handle of the memory
+ *  \iparam  Address = Address within the memory
+ *  \oparam  Buffer = Buffer to read into
+ *  \iparam  Size = Number of bytes to read
+ *
+ *  \return  NO_ERROR or (negative) error code
+ *
+ ****************************************************************************/
+
+Error_t halStorageRead (Handle_t Handle, UInt32 Address, void *Buffer, UInt32 Size)
+{
+    if (Handle < 0 || (UInt32)Handle >= simFlashCount) {
+        return (E_DEVICE_HANDLE_INVALID);
+    }
+    if (Address + Size > simFlash[Handle].Size) {
+        return (E_STORAGE_ADDRESS);
+    }
+    memcpy (Buffer, &simFlash[Handle].Data[Address], Size);
+
+    return (NO_ERROR);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Programs a simulated flash memory
+ *
+ *      Like the real flash memory, the address and size must be half word
+ *      aligned and the memory must be erased.
+ *
+ *  \iparam  Handle = Handle of the memory
+ *  \iparam  Address = Address within the memory
+ *  \iparam  Buffer = Data to write
+ *  \iparam  Size = Number of bytes to write
+ *
+ *  \return  NO_ERROR or (negative) error code
+ *
+ ****************************************************************************/
+
+Error_t halStorageWrite (Handle_t Handle, UInt32 Address, void *Buffer, UInt32 Size)
+{
+    simFlash_t *Flash;
+    UInt32 i;
+
+    if (Handle < 0 || (UInt32)Handle >= simFlashCount) {
+        return (E_DEVICE_HANDLE_INVALID);
+    }
+    Flash = &simFlash[Handle];
+
+    if (Address + Size > Flash->Size) {
+        return (E_STORAGE_ADDRESS);
+    }
+    if (Address % 2 || Size % 2) {
+        return (E_FLASH_ALIGNMENT);
+    }
+    for (i=0; i < Size; i++) {
+        if (Flash->Data[Address + i] != SIM_FLASH_ERASED) {
+            return (E_STORAGE_WRITE_ERROR);
+        }
+    }
+    memcpy (&Flash->Data[Address], Buffer, Size);
+    Flash->Time += Size / 2 * SIM_FLASH_WRITE_TIME;
+
+    return (NO_ERROR);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Erases a simulated flash memory
+ *
+ *  \iparam  Handle = Handle of the memory
+ *  \iparam  Address = Address within the memory
+ *  \iparam  Size = Number of bytes to erase
+ *
+ *  \return  NO_ERROR or (negative) error code
+ *
+ ****************************************************************************/
+
+Error_t halStorageErase (Handle_t Handle, UInt32 Address, UInt32 Size)
+{
+    if (Handle < 0 || (UInt32)Handle >= simFlashCount) {
+        return (E_DEVICE_HANDLE_INVALID);
+    }
+    if (Address + Size > simFlash[Handle].Size) {
+        return (E_STORAGE_ADDRESS);
+    }
+    memset (&simFlash[Handle].Data[Address], SIM_FLASH_ERASED, Size);
+
+    return (NO_ERROR);
+}
+
+
+/*****************************************************************************/
+/*!
+ *  \brief   Returns the size of a simulated flash memory
+ *
+ *  \iparam  Handle = Handle of the memory
+ *
+ *  \return  Size of the memory in bytes
+ *
+ ****************************************************************************/
+
+UInt32 halStorageSize (Handle_t Handle)
+{
+    if (Handle < 0 || (UInt32)Handle >= simFlashCount) {
+        return (0);
+    }
+    return (simFlash[Handle].Size);
+}
+
+//****************************************************************************/